@@ -21,10 +21,20 @@
 
 /* Global variables */
 uint8 ancsFlag = 0u; /* ANCS specific flags */
-uint8 nsCnt = 0u; /* Count of the notifications */
-CYBLE_ANCS_NS_T ns[CYBLE_ANCS_NS_CNT]; /* array of the recieved notifications */
+CYBLE_ANCS_NS_T ns; /* Notification in process */
 CYBLE_ANCS_CP_T cp; /* Control point value */
-CYBLE_ANCS_DS_T ds; /* Data source value */
+ANCS_DS_T ds; /* Data source parser */
+
+/* Attribute values of the Notification in process */
+uint8 ancsTtl[CYBLE_ANCS_TTL_LENGTH];
+uint8 ancsMsg[CYBLE_ANCS_MSG_LENGTH];
+uint8 ancsSbt[CYBLE_ANCS_SBT_LENGTH];
+ANCS_DS_SINK_T ancsSink[CYBLE_ANCS_SINK_CNT] =
+{
+    {CYBLE_ANCS_CP_ATT_ID_TTL, 0u, ancsTtl, CYBLE_ANCS_TTL_LENGTH, 0u},
+    {CYBLE_ANCS_CP_ATT_ID_MSG, 0u, ancsMsg, CYBLE_ANCS_MSG_LENGTH, 0u},
+    {CYBLE_ANCS_CP_ATT_ID_SBT, 0u, ancsSbt, CYBLE_ANCS_SBT_LENGTH, 0u}
+};
 
 
 /*******************************************************************************
@@ -83,14 +93,45 @@ void AncsPrintCharName(CYBLE_ANCS_CHAR_INDEX_T charIndex)
 void AncsInit(void)
 {
     CyBle_AncsRegisterAttrCallback(AncsCallBack);
+    AncsNtfInit();
+    AncsDsCancel(&ds);
+}
+
+/*******************************************************************************
+* Function Name: AncsPrintAtt
+********************************************************************************
+*
+* Summary:
+*   Prints the received attribute value.
+*
+* Parameters:
+*  sinkIndex - The attribute sink index.
+*
+* Return:
+*   None.
+*
+*******************************************************************************/
+void AncsPrintAtt(uint8 sinkIndex)
+{
+    for(i = 0u; i < ancsSink[sinkIndex].length; i++)
+    {
+        UART_DEB_UartPutChar(ancsSink[sinkIndex].data[i]); /* Print data */
+    }
+    
+    if(ancsSink[sinkIndex].truncated != 0u)
+    {
+        printf("...");
+    }
 }
 
+
 /*******************************************************************************
 * Function Name: AncsNextAct
 ********************************************************************************
 *
 * Summary:
-*   Initiates the next action processing.
+*   Prints the Notification attributes once all of them are received and
+*   initiates the next action processing.
 *
 * Parameters:
 *   None.
@@ -101,67 +142,57 @@ void AncsInit(void)
 *******************************************************************************/
 void AncsNextAct(void)
 {
-    printf("\r\n\n");
-    
-    switch(cp.attId)
+    switch(cp.ctgId)
     {
-        case CYBLE_ANCS_CP_ATT_ID_TTL: /* If previous Attribute ID is "Title" */
-            switch(cp.ctgId)
-            {
-                case CYBLE_ANCS_NS_CAT_ID_EML: /* If Category ID is "Email" */
-                    cp.attId = CYBLE_ANCS_CP_ATT_ID_SBT; /* Next Attribute ID is "Subtitle" */
-                    ancsFlag |= CYBLE_ANCS_FLG_CMD; /* Trig control point command write */
-                    break;
-                
-                case CYBLE_ANCS_NS_CAT_ID_SOC: /* If Category ID is "Social" */
-                    cp.attId = CYBLE_ANCS_CP_ATT_ID_MSG; /* Next Attribute ID is "Message" */
-                    ancsFlag |= CYBLE_ANCS_FLG_CMD; /* Trig control point command write */
-                    break;
-                
-                case CYBLE_ANCS_NS_CAT_ID_INC: /* If Category ID is "Incoming Call" */
-                    if(((ns[nsCnt].evtFlg & CYBLE_ANCS_NS_FLG_PA) != 0u) &&
-                       ((ns[nsCnt].evtFlg & CYBLE_ANCS_NS_FLG_NA) != 0u))
-                    { /* If "Positive Action" and "Negative Action" flags are set */
-                        printf("User Action: Accept  (two pressing SW2 per second)\r\n");
-                        printf("             Decline (one pressing SW2 per second)? : ");
-                        ancsFlag |= CYBLE_ANCS_FLG_ACT; /* Trig polling/waiting for user action */
-                    }
-                    break;
-                
-                default:
-                    break;
-            }
+        case CYBLE_ANCS_NS_CAT_ID_EML: /* If Category ID is "Email" */
+            printf("\r\nEmail from: \n");
+            AncsPrintAtt(CYBLE_ANCS_SINK_TTL);
+            printf("\r\n\nSubject: \n");
+            AncsPrintAtt(CYBLE_ANCS_SINK_SBT);
+            printf("\r\n\nMessage: \n");
+            AncsPrintAtt(CYBLE_ANCS_SINK_MSG);
+            printf("\r\n\n");
+            ancsFlag &= (uint8)~CYBLE_ANCS_FLG_NTF; /* Stop to process current Notification */
             break;
         
-        case CYBLE_ANCS_CP_ATT_ID_SBT: /* If previous Attribute ID is "Subtitle" */
-            if(cp.ctgId == CYBLE_ANCS_NS_CAT_ID_EML) /* If Category ID is "Email" */
+        case CYBLE_ANCS_NS_CAT_ID_INC: /* If Category ID is "Incoming Call" */
+            printf("\r\nIncoming Call from: ");
+            AncsPrintAtt(CYBLE_ANCS_SINK_TTL);
+            printf("\r\n\n");
+            if(((ns.evtFlg & CYBLE_ANCS_NS_FLG_PA) != 0u) &&
+               ((ns.evtFlg & CYBLE_ANCS_NS_FLG_NA) != 0u))
+            { /* If "Positive Action" and "Negative Action" flags are set */
+                printf("User Action: Accept  (two pressing SW2 per second)\r\n");
+                printf("             Decline (one pressing SW2 per second)? : ");
+                ancsFlag |= CYBLE_ANCS_FLG_ACT; /* Trig polling/waiting for user action */
+            }
+            else
             {
-                cp.attId = CYBLE_ANCS_CP_ATT_ID_MSG; /* Next Attribute ID is "Message" */
-                ancsFlag |= CYBLE_ANCS_FLG_CMD; /* Trig control point command write */
+                ancsFlag &= (uint8)~CYBLE_ANCS_FLG_NTF; /* Stop to process current Notification */
             }
             break;
-            
-        case CYBLE_ANCS_CP_ATT_ID_MSG: /* If previous Attribute ID is "Message" */
-            switch(cp.ctgId)
+        
+        case CYBLE_ANCS_NS_CAT_ID_SOC: /* If Category ID is "Social" */
+            printf("\r\nApp: \n");
+            AncsPrintAtt(CYBLE_ANCS_SINK_TTL);
+            printf("\r\n\nMessage: \n");
+            AncsPrintAtt(CYBLE_ANCS_SINK_MSG);
+            printf("\r\n\n");
+            if((ns.evtFlg & CYBLE_ANCS_NS_FLG_NA) != 0u)
+            { /* If "negative action" flag is set */
+                printf("User Action: Decline (one pressing SW2 per second)? : ");
+                ancsFlag |= CYBLE_ANCS_FLG_ACT; /* Trig polling/waiting for user action */
+            }
+            else
             {
-                case CYBLE_ANCS_NS_CAT_ID_EML: /* If Category ID is "Email" */
-                    ancsFlag &= (uint8)~CYBLE_ANCS_FLG_NTF; /* Stop to process current Notification */
-                    break;
-                
-                case CYBLE_ANCS_NS_CAT_ID_SOC: /* If Category ID is "social" */
-                    if((ns[nsCnt].evtFlg & CYBLE_ANCS_NS_FLG_NA) != 0u)
-                    { /* If "negative action" flag is set */
-                        printf("User Action: Decline (one pressing SW2 per second)? : ");
-                        ancsFlag |= CYBLE_ANCS_FLG_ACT; /* Trig polling/waiting for user action */
-                    }
-                    break;
-                
-                default:
-                    break;
+                ancsFlag &= (uint8)~CYBLE_ANCS_FLG_NTF; /* Stop to process current Notification */
             }
             break;
             
         default:
+            printf("\r\nTitle: \n");
+            AncsPrintAtt(CYBLE_ANCS_SINK_TTL);
+            printf("\r\n\n");
             ancsFlag &= (uint8)~CYBLE_ANCS_FLG_NTF; /* Stop to process current Notification */
             break;
     }
@@ -193,7 +224,8 @@ void AncsCallBack(uint32 event, void* eventParam)
             {
                 case CYBLE_ANCS_NS:
                     {
-                        uint8 locFlag = 0u;
+                        CYBLE_ANCS_NS_T locNs;
+                        uint8 locQueue = 0u; /* Attributes of this category are read */
                         
                         /* Unpack the Notification ID */
                         uint32 locNtfUid = ((uint32)((CYBLE_ANCS_CHAR_VALUE_T *)eventParam)->value->val[4u]) +
@@ -201,156 +233,163 @@ void AncsCallBack(uint32 event, void* eventParam)
                                          ((uint32)((CYBLE_ANCS_CHAR_VALUE_T *)eventParam)->value->val[6u] << 16u) +
                                          ((uint32)((CYBLE_ANCS_CHAR_VALUE_T *)eventParam)->value->val[7u] << 24u);
                                       
-                        if((ancsFlag & CYBLE_ANCS_FLG_ACT) != 0u)
+                        /* Unpack all Notification Source characteristic fields */
+                        locNs.evtId = (CYBLE_ANCS_NS_EVT_ID_T)((CYBLE_ANCS_CHAR_VALUE_T *)eventParam)->value->val[0u];
+                        locNs.evtFlg = ((CYBLE_ANCS_CHAR_VALUE_T *)eventParam)->value->val[1u];
+                        locNs.ctgId = (CYBLE_ANCS_NS_CAT_ID_T)((CYBLE_ANCS_CHAR_VALUE_T *)eventParam)->value->val[2u];
+                        locNs.ctgCnt = ((CYBLE_ANCS_CHAR_VALUE_T *)eventParam)->value->val[3u];
+                        locNs.ntfUid = locNtfUid;
+                        
+                        /* Print all details of Notification */
+                        printf("\r\nEventID: ");
+                        switch(locNs.evtId)
                         {
-                            /* Discard pending User Action and current notification processing */
-                            ancsFlag &= (uint8)~(CYBLE_ANCS_FLG_ACT | CYBLE_ANCS_FLG_NTF);
-                            printf("User Action is discarded \r\n");
+                            case CYBLE_ANCS_NS_EVT_ID_ADD:
+                                printf("Notification Added\r\n");
+                                break;
+                            
+                            case CYBLE_ANCS_NS_EVT_ID_MOD:
+                                printf("Notification Modified\r\n");
+                                break;
+                            
+                            case CYBLE_ANCS_NS_EVT_ID_REM:
+                                printf("Notification Removed\r\n");
+                                break;
+                            
+                            default:
+                                printf("Unsupported\r\n");
+                                break;
                         }
                         
-                        /* Check if this Notification ID is already stored */
-                        for(i = 0u; i < nsCnt; i++)
+                        printf("EventFlags: ");
+                        if((locNs.evtFlg & CYBLE_ANCS_NS_FLG_SL) != 0u)
                         {
-                            if(locNtfUid == ns[i].ntfUid)
-                            {
-                                locFlag = 1u;
-                            }
+                            printf("Silent, ");
                         }
                         
-                        if(locFlag == 0u) /* If it is "new" Notification */
-                        {   
-                            /* Unpack all Notification Source characteristic fields */
-                            ns[nsCnt].evtId = (CYBLE_ANCS_NS_EVT_ID_T)((CYBLE_ANCS_CHAR_VALUE_T *)eventParam)->value->val[0u];
-                            ns[nsCnt].evtFlg = ((CYBLE_ANCS_CHAR_VALUE_T *)eventParam)->value->val[1u];
-                            ns[nsCnt].ctgId = (CYBLE_ANCS_NS_CAT_ID_T)((CYBLE_ANCS_CHAR_VALUE_T *)eventParam)->value->val[2u];
-                            ns[nsCnt].ctgCnt = ((CYBLE_ANCS_CHAR_VALUE_T *)eventParam)->value->val[3u];
-                            ns[nsCnt].ntfUid = locNtfUid;
-                            
-                            /* Print all details of Notification */
-                            printf("\r\nEventID: ");
-                            switch(ns[nsCnt].evtId)
-                            {
-                                case CYBLE_ANCS_NS_EVT_ID_ADD:
-                                    printf("Notification Added\r\n");
-                                    break;
-                                
-                                case CYBLE_ANCS_NS_EVT_ID_MOD:
-                                    printf("Notification Modified\r\n");
-                                    break;
-                                
-                                case CYBLE_ANCS_NS_EVT_ID_REM:
-                                    printf("Notification Removed\r\n");
-                                    break;
+                        if((locNs.evtFlg & CYBLE_ANCS_NS_FLG_IM) != 0u)
+                        {
+                            printf("Important, ");
+                        }
+                        
+                        if((locNs.evtFlg & CYBLE_ANCS_NS_FLG_PE) != 0u)
+                        {
+                            printf("Pre-existing, ");
+                        }
+                        
+                        if((locNs.evtFlg & CYBLE_ANCS_NS_FLG_PA) != 0u)
+                        {
+                            printf("Positive Action, ");
+                        }
+                        
+                        if((locNs.evtFlg & CYBLE_ANCS_NS_FLG_NA) != 0u)
+                        {
+                            printf("Negative Action, ");
+                        }
+                        printf("\r\n");
+                        
+                        printf("CategoryCount: %d\r\n", locNs.ctgCnt);
+                        printf("NotificationUID: 0x%8.8lx\r\n", locNs.ntfUid);
+                        
+                        printf("CategoryID: ");
+                        switch(locNs.ctgId)
+                        {
+                            case CYBLE_ANCS_NS_CAT_ID_OTH: /* If Category ID is "Other" */
+                                printf("Other\r\n");
+                                break;
                                 
-                                default:
-                                    printf("Unsupported\r\n");
-                                    break;
-                            }
+                            case CYBLE_ANCS_NS_CAT_ID_INC: /* If Category ID is "Incoming Call" */
+                                printf("Incoming Call\r\n");
+                                locQueue = 1u;
+                                break;
                             
-                            printf("EventFlags: ");
-                            if((ns[nsCnt].evtFlg & CYBLE_ANCS_NS_FLG_SL) != 0u)
-                            {
-                                printf("Silent, ");
-                            }
+                            case CYBLE_ANCS_NS_CAT_ID_MIS: /* If Category ID is "Missed Call" */
+                                printf("Missed Call\r\n");
+                                break;
                             
-                            if((ns[nsCnt].evtFlg & CYBLE_ANCS_NS_FLG_IM) != 0u)
-                            {
-                                printf("Important, ");
-                            }
+                            case CYBLE_ANCS_NS_CAT_ID_VML: /* If Category ID is "Voice mail" */
+                                printf("Voicemail\r\n");
+                                break;
                             
-                            if((ns[nsCnt].evtFlg & CYBLE_ANCS_NS_FLG_PE) != 0u)
-                            {
-                                printf("Pre-existing, ");
-                            }
+                            case CYBLE_ANCS_NS_CAT_ID_SOC: /* If Category ID is "Social" */
+                                printf("Social\r\n");
+                                locQueue = 1u;
+                                break;
                             
-                            if((ns[nsCnt].evtFlg & CYBLE_ANCS_NS_FLG_PA) != 0u)
-                            {
-                                printf("Positive Action, ");
-                            }
+                            case CYBLE_ANCS_NS_CAT_ID_SCH: /* If the Category ID is "Schedule" */
+                                printf("Schedule\r\n");
+                                break;
                             
-                            if((ns[nsCnt].evtFlg & CYBLE_ANCS_NS_FLG_NA) != 0u)
-                            {
-                                printf("Negative Action, ");
-                            }
-                            printf("\r\n");
+                            case CYBLE_ANCS_NS_CAT_ID_EML: /* If Category ID is "Email" */
+                                printf("Email\r\n");
+                                locQueue = 1u;
+                                break;
+                            
+                            case CYBLE_ANCS_NS_CAT_ID_NWS: /* If Category ID is "News" */
+                                printf("News\r\n");
+                                break;
+                            
+                            case CYBLE_ANCS_NS_CAT_ID_HNF: /* If Category ID is "Health and Fitness" */
+                                printf("Health and Fitness\r\n");
+                                break;
+                            
+                            case CYBLE_ANCS_NS_CAT_ID_BNF: /* If Category ID is "Business and Finance" */
+                                printf("Business and Finance\r\n");
+                                break;
                             
-                            printf("CategoryCount: %d\r\n", ns[nsCnt].ctgCnt);
-                            printf("NotificationUID: 0x%8.8lx\r\n", ns[nsCnt].ntfUid);
+                            case CYBLE_ANCS_NS_CAT_ID_LOC: /* If Category ID is "Location" */
+                                printf("Location\r\n");
+                                break;
                             
-                            printf("CategoryID: ");
-                            switch(ns[nsCnt].ctgId)
+                            case CYBLE_ANCS_NS_CAT_ID_ENT: /* If Category ID is "Entertainment" */
+                                printf("Entertainment\r\n");
+                                break;
+                            
+                            default:
+                                printf("Unsupported\r\n");
+                                break;
+                        }
+                        
+                        if(((ancsFlag & CYBLE_ANCS_FLG_NTF) != 0u) && (locNs.ntfUid == ns.ntfUid))
+                        { /* If it is the Notification in process */
+                            if(locNs.evtId == CYBLE_ANCS_NS_EVT_ID_REM)
+                            { /* Stop to process it, e.g. the call is answered on the phone */
+                                ancsFlag &= (uint8)~(CYBLE_ANCS_FLG_ACT | CYBLE_ANCS_FLG_NTF | CYBLE_ANCS_FLG_CMD);
+                                AncsDsCancel(&ds); /* Skip the rest of its attributes */
+                                Ringing_LED_Write(LED_OFF);
+                                printf("Notification in process is removed\r\n");
+                            }
+                            else
                             {
-                                case CYBLE_ANCS_NS_CAT_ID_OTH: /* If Category ID is "Other" */
-                                    printf("Other\r\n");
-                                    break;
-                                    
-                                case CYBLE_ANCS_NS_CAT_ID_INC: /* If Category ID is "Incoming Call" */
-                                    printf("Incoming Call\r\n");
-                                    if(ns[nsCnt].evtId == CYBLE_ANCS_NS_EVT_ID_ADD) /* If Event ID is "Notification Added" */
-                                    { 
-                                        if(nsCnt < (CYBLE_ANCS_NS_CNT - 1)) /* If notification queue is not full */
-                                        {
-                                            nsCnt++; /* Increment notification counter */
-                                        }
-                                    }
-                                    break;
-                                
-                                case CYBLE_ANCS_NS_CAT_ID_MIS: /* If Category ID is "Missed Call" */
-                                    printf("Missed Call\r\n");
-                                    break;
-                                
-                                case CYBLE_ANCS_NS_CAT_ID_VML: /* If Category ID is "Voice mail" */
-                                    printf("Voicemail\r\n");
-                                    break;
-                                
-                                case CYBLE_ANCS_NS_CAT_ID_SOC: /* If Category ID is "Social" */
-                                    printf("Social\r\n");
-                                    if(ns[nsCnt].evtId == CYBLE_ANCS_NS_EVT_ID_ADD) /* If Event ID is "Notification Added" */
+                                ns.evtFlg = locNs.evtFlg;
+                            }
+                        }
+                        else
+                        { /* Update the pending Notifications, the events may come in any order */
+                            switch(locNs.evtId)
+                            {
+                                case CYBLE_ANCS_NS_EVT_ID_ADD:
+                                    if(locQueue != 0u)
                                     {
-                                        if(nsCnt < (CYBLE_ANCS_NS_CNT - 1)) /* If notification queue is not full */
+                                        if(AncsNtfPut(locNs.ntfUid, locNs.evtFlg, (uint8)locNs.ctgId) == ANCS_NTF_NONE)
                                         {
-                                            nsCnt++; /* Increment notification counter */
+                                            printf("Notification queue is full, the Notification is dropped\r\n");
                                         }
                                     }
                                     break;
                                 
-                                case CYBLE_ANCS_NS_CAT_ID_SCH: /* If the Category ID is "Schedule" */
-                                    printf("Schedule\r\n");
-                                    break;
-                                
-                                case CYBLE_ANCS_NS_CAT_ID_EML: /* If Category ID is "Email" */
-                                    printf("Email\r\n");
-                                    if(ns[nsCnt].evtId == CYBLE_ANCS_NS_EVT_ID_ADD) /* If Event ID is "Notification Added" */
+                                case CYBLE_ANCS_NS_EVT_ID_MOD:
+                                    if(AncsNtfFind(locNs.ntfUid) != ANCS_NTF_NONE) /* If it is pending */
                                     {
-                                        if(nsCnt < (CYBLE_ANCS_NS_CNT - 1)) /* If notification queue is not full */
-                                        {
-                                            nsCnt++; /* Increment notification counter */
-                                        }
+                                        (void) AncsNtfPut(locNs.ntfUid, locNs.evtFlg, (uint8)locNs.ctgId);
                                     }
                                     break;
                                 
-                                case CYBLE_ANCS_NS_CAT_ID_NWS: /* If Category ID is "News" */
-                                    printf("News\r\n");
-                                    break;
-                                
-                                case CYBLE_ANCS_NS_CAT_ID_HNF: /* If Category ID is "Health and Fitness" */
-                                    printf("Health and Fitness\r\n");
-                                    break;
-                                
-                                case CYBLE_ANCS_NS_CAT_ID_BNF: /* If Category ID is "Business and Finance" */
-                                    printf("Business and Finance\r\n");
-                                    break;
-                                
-                                case CYBLE_ANCS_NS_CAT_ID_LOC: /* If Category ID is "Location" */
-                                    printf("Location\r\n");
-                                    break;
-                                
-                                case CYBLE_ANCS_NS_CAT_ID_ENT: /* If Category ID is "Entertainment" */
-                                    printf("Entertainment\r\n");
+                                case CYBLE_ANCS_NS_EVT_ID_REM:
+                                    (void) AncsNtfRemove(locNs.ntfUid);
                                     break;
                                 
                                 default:
-                                    printf("Unsupported\r\n");
                                     break;
                             }
                         }
@@ -358,106 +397,12 @@ void AncsCallBack(uint32 event, void* eventParam)
                     break;
             
                 case CYBLE_ANCS_DS:
-                    {
-                        uint8 locLength = ((CYBLE_ANCS_CHAR_VALUE_T *)eventParam)->value->len;
-                        uint8* locData = ((CYBLE_ANCS_CHAR_VALUE_T *)eventParam)->value->val;
-                        
-                        if((ancsFlag & CYBLE_ANCS_FLG_STR) != 0u) /* If there is unfinished string */
-                        {
-                            for(i = 0u; i < locLength; i++)
-                            {
-                                UART_DEB_UartPutChar(locData[i]); /* Print data */
-                            }
-                            
-                            ds.currLength += (uint16)locLength; /* Update current length */
-                            
-                            if(ds.currLength == ds.length) /* If data is complete */
-                            {
-                                ancsFlag &= (uint8)~CYBLE_ANCS_FLG_STR; /* Finish the string */
-                                AncsNextAct(); /* Perform next action */
-                            }
-                        }
-                        else 
-                        {
-                            locLength -= 8u; /* Take into account only data length */
-                            
-                            ds.cmdId = (CYBLE_ANCS_CP_CMD_ID_T)locData[0u]; /* Unpack Command ID */
-                            /* Unpack Notification UID */
-                            ds.ntfUid = ((uint32)locData[1u]) +
-                                        ((uint32)locData[2u] << 8u) +
-                                        ((uint32)locData[3u] << 16u) +
-                                        ((uint32)locData[4u] << 24u);
-                            ds.attId = (CYBLE_ANCS_CP_ATT_ID_T)locData[5u]; /* Unpack Attribute ID */
-                             
-                            CyBle_Set16ByPtr((uint8*)&ds.length,
-                            CyBle_Get16ByPtr(&locData[6u])); /* Unpack data length */
-                            
-                            ds.data = &locData[8u]; /* Extract data pointer */
-                            
-                            if((ds.cmdId == CYBLE_ANCS_CP_CMD_ID_GNA) && (memcmp(&ds.ntfUid, &cp.ntfUid, 4u) == 0))
-                            { /* If Command ID is "Get Notification Attributes" and Notification UID matches */
-                                switch(ds.attId)
-                                {
-                                    case CYBLE_ANCS_CP_ATT_ID_TTL: /* If Attribute ID is "Title" */
-                                        switch(cp.ctgId)
-                                        {
-                                            case CYBLE_ANCS_NS_CAT_ID_EML: /* If Category ID is "Email" */
-                                                printf("\r\nEmail from: \n");
-                                                break;
-                                                
-                                            case CYBLE_ANCS_NS_CAT_ID_INC: /* If Category ID is "Incoming Call" */
-                                                printf("\r\nIncoming Call from: ");
-                                                break;
-                                                
-                                            case CYBLE_ANCS_NS_CAT_ID_SOC: /* If Category ID is "Social" */
-                                                printf("\r\nApp: \n");
-                                                break;
-                                                
-                                            default:
-                                                printf("\r\nTitle: \n");
-                                                break;
-                                        }
-                                        break;
-                                        
-                                    case CYBLE_ANCS_CP_ATT_ID_SBT: /* If Attribute ID is "Subtitle" */
-                                        printf("Subject: \n");
-                                        break;
-                                        
-                                    case CYBLE_ANCS_CP_ATT_ID_MSG: /* If Attribute ID is "Message" */
-                                        printf("Message: \n");
-                                        break;
-                                        
-                                    default:
-                                        break;
-                                }
-                                
-                                switch(ds.attId)
-                                {
-                                    case CYBLE_ANCS_CP_ATT_ID_TTL: /* If Attribute ID is "Title" */
-                                    case CYBLE_ANCS_CP_ATT_ID_SBT: /* If Attribute ID is "Subtitle" */
-                                    case CYBLE_ANCS_CP_ATT_ID_MSG: /* If Attribute ID is "Message" */
-                                        for(i = 0u; i < locLength; i++)
-                                        {
-                                            UART_DEB_UartPutChar(ds.data[i]); /* Print data */
-                                        }
-                                        
-                                        if(ds.length > locLength)
-                                        { /* Indicate that data is not full, 
-                                            waiting for next notification with rest of data */
-                                            ancsFlag |= CYBLE_ANCS_FLG_STR; 
-                                            ds.currLength = locLength; /* Initialise current length */
-                                        }
-                                        else
-                                        { /* Otherwise perform next action */
-                                            AncsNextAct();
-                                        }
-                                        break;
-                                    
-                                    default:
-                                        break;
-                                
-                                }
-                            }   
+                    if((ancsFlag & CYBLE_ANCS_FLG_NTF) != 0u)
+                    { /* Parse the response fragment, the attributes are kept as they come */
+                        if(AncsDsParse(&ds, ((CYBLE_ANCS_CHAR_VALUE_T *)eventParam)->value->val,
+                                            ((CYBLE_ANCS_CHAR_VALUE_T *)eventParam)->value->len) != 0u)
+                        { /* If all the requested attributes are received */
+                            AncsNextAct(); /* Perform next action */
                         }
                     }
                     break;
@@ -486,6 +431,12 @@ void AncsCallBack(uint32 event, void* eventParam)
             
         case CYBLE_EVT_ANCSC_ERROR_RESPONSE:
             ancsFlag &= (uint8)~CYBLE_ANCS_FLG_RSP;
+            if(((ancsFlag & CYBLE_ANCS_FLG_NTF) != 0u) && ((ancsFlag & CYBLE_ANCS_FLG_ACT) == 0u))
+            { /* If the attributes are not available, e.g. the Notification is already removed */
+                ancsFlag &= (uint8)~CYBLE_ANCS_FLG_NTF; /* Stop to process current Notification */
+                AncsDsCancel(&ds);
+                printf("Get Notification Attributes error\r\n");
+            }
             break;
         
 		default: /* Print unknown event number */
@@ -511,8 +462,8 @@ void AncsCallBack(uint32 event, void* eventParam)
 *******************************************************************************/
 void AncsAct(CYBLE_ANCS_CP_ACT_ID_T actId)
 {
-    cp.ntfUid = ns[nsCnt].ntfUid; /* Initialize control point Notification UID */
-    cp.ctgId = ns[nsCnt].ctgId; /* Initialize control point Category ID */
+    cp.ntfUid = ns.ntfUid; /* Initialize control point Notification UID */
+    cp.ctgId = ns.ctgId; /* Initialize control point Category ID */
     cp.cmdId = CYBLE_ANCS_CP_CMD_ID_PNA; /* Set control point Command ID to "Perform Notification Action" */
     cp.actId = actId; /* Initialize control point Action ID */
     ancsFlag |= CYBLE_ANCS_FLG_CMD; /* Trig control point command write */
@@ -545,6 +496,8 @@ void AncsAct(CYBLE_ANCS_CP_ACT_ID_T actId)
 *******************************************************************************/
 void AncsProcess(void)
 {
+    ANCS_NTF_T locNtf;
+    
     if(CyBle_GattGetBusyStatus() != CYBLE_STACK_STATE_BUSY)
     {
         if((ancsFlag & CYBLE_ANCS_FLG_ACT) != 0u)
@@ -558,14 +511,14 @@ void AncsProcess(void)
                 switch(button)
                 {
                     case SW2_ONE_PRESSING:
-                        if((ns[nsCnt].evtFlg & CYBLE_ANCS_NS_FLG_NA) != 0u)
+                        if((ns.evtFlg & CYBLE_ANCS_NS_FLG_NA) != 0u)
                         {
                             AncsAct(CYBLE_ANCS_CP_ACT_ID_NEG); /* Trig negative action */
                         }
                         break;
                         
                     case SW2_TWO_PRESSING:
-                        if((ns[nsCnt].evtFlg & CYBLE_ANCS_NS_FLG_PA) != 0u)
+                        if((ns.evtFlg & CYBLE_ANCS_NS_FLG_PA) != 0u)
                         {
                             AncsAct(CYBLE_ANCS_CP_ACT_ID_POS); /* Trig positive action */
                         }
@@ -578,13 +531,29 @@ void AncsProcess(void)
                 button = SW2_ZERO_PRESSING;
             }
         }
-        else if((nsCnt > 0u) && ((ancsFlag & CYBLE_ANCS_FLG_NTF) == 0u))
-        { /* If there are pending Notifications and current Notification is already processed */
-            nsCnt--; /* Decrement Notification counter */
-            cp.ntfUid = ns[nsCnt].ntfUid; /* Initialize control point Notification UID */
-            cp.ctgId = ns[nsCnt].ctgId; /* Initialize control point Category ID */
+        else if(((ancsFlag & CYBLE_ANCS_FLG_NTF) == 0u) && (AncsNtfPop(&locNtf) != 0u))
+        { /* If current Notification is already processed and there are pending Notifications,
+             take the oldest Important one, else the oldest one */
+            ns.ntfUid = locNtf.ntfUid;
+            ns.evtFlg = locNtf.evtFlg;
+            ns.ctgId = (CYBLE_ANCS_NS_CAT_ID_T)locNtf.ctgId;
+            cp.ntfUid = ns.ntfUid; /* Initialize control point Notification UID */
+            cp.ctgId = ns.ctgId; /* Initialize control point Category ID */
             cp.cmdId = CYBLE_ANCS_CP_CMD_ID_GNA; /* Set control point Command ID to "Get Notification Attributes" */
-            cp.attId = CYBLE_ANCS_CP_ATT_ID_TTL; /* Set control point Attribute ID to "Title" */
+            switch(cp.ctgId)
+            { /* Set the attributes to get, all of them are requested by one command */
+                case CYBLE_ANCS_NS_CAT_ID_EML: /* If Category ID is "Email" */
+                    cp.attNum = CYBLE_ANCS_SINK_CNT; /* Title, Message and Subtitle */
+                    break;
+                
+                case CYBLE_ANCS_NS_CAT_ID_SOC: /* If Category ID is "Social" */
+                    cp.attNum = CYBLE_ANCS_SINK_MSG + 1u; /* Title and Message */
+                    break;
+                
+                default:
+                    cp.attNum = CYBLE_ANCS_SINK_TTL + 1u; /* Title */
+                    break;
+            }
             ancsFlag |= CYBLE_ANCS_FLG_NTF | CYBLE_ANCS_FLG_CMD; /* Trig next Notification process */
         }
         else if((ancsFlag & CYBLE_ANCS_FLG_START) != 0u)
@@ -622,7 +591,7 @@ void AncsProcess(void)
         
         if(((ancsFlag & CYBLE_ANCS_FLG_CMD) != 0u) && ((ancsFlag & CYBLE_ANCS_FLG_RSP) == 0u))
         { /* If there is pending command */
-            uint8 attr[8u];
+            uint8 attr[ANCS_DS_CMD_MAX];
             uint8 length = 0u;
             
             ancsFlag &= (uint8)~CYBLE_ANCS_FLG_CMD;
@@ -636,9 +605,8 @@ void AncsProcess(void)
             switch(cp.cmdId)
             {
                 case CYBLE_ANCS_CP_CMD_ID_GNA: /* If Command ID is "Get Notification Attributes" */
-                    attr[5u] = (uint8)cp.attId; /* Pack Attribute ID */
-                    CyBle_Set16ByPtr(&attr[6u], CYBLE_ANCS_MAX_STR_LENGTH); /* Pack maximum string length */
-                    length = 8u; /* Length of this command */
+                    /* Pack Attribute IDs with the maximum lengths of their sinks */
+                    length = AncsDsRequest(&ds, cp.ntfUid, ancsSink, cp.attNum, attr);
                     break;
                 
                 case CYBLE_ANCS_CP_CMD_ID_PNA: /* If Command ID is "Perform Notification Action" */
@@ -18,18 +18,25 @@
 #define CGMSS_H
 
 #include "main.h"
+#include "ancsntf.h"
+#include "ancsds.h"
 
-#define CYBLE_ANCS_MAX_STR_LENGTH (300u)
+#define CYBLE_ANCS_TTL_LENGTH     (32u) /* Kept length of the Title */
+#define CYBLE_ANCS_SBT_LENGTH     (32u) /* Kept length of the Subtitle */
+#define CYBLE_ANCS_MSG_LENGTH     (64u) /* Kept length of the Message */
+    
+/* Sinks of the attributes, the first ones are requested for every category */
+#define CYBLE_ANCS_SINK_TTL       (0u) /* Title */
+#define CYBLE_ANCS_SINK_MSG       (1u) /* Message */
+#define CYBLE_ANCS_SINK_SBT       (2u) /* Subtitle */
+#define CYBLE_ANCS_SINK_CNT       (3u)
     
 #define CYBLE_ANCS_FLG_START      (0x01u) /* Start ANCS operation */
 #define CYBLE_ANCS_FLG_CMD        (0x02u) /* Command */
 #define CYBLE_ANCS_FLG_NTF        (0x04u) /* Notification */
-#define CYBLE_ANCS_FLG_STR        (0x08u) /* String */
 #define CYBLE_ANCS_FLG_ACT        (0x10u) /* Action */
 #define CYBLE_ANCS_FLG_RSP        (0x20u) /* Response */
 
-#define CYBLE_ANCS_NS_CNT         (10u)
-    
 #define CYBLE_ANCS_NS_FLG_SL      (0x01u) /* Silent */
 #define CYBLE_ANCS_NS_FLG_IM      (0x02u) /* Important */
 #define CYBLE_ANCS_NS_FLG_PE      (0x04u) /* Pre-existing */
@@ -98,21 +105,11 @@ typedef struct
     CYBLE_ANCS_CP_CMD_ID_T cmdId;  /* Command ID */
     uint32                 ntfUid; /* Notification UID */
     uint32                 appId;  /* App Identifier */
-    CYBLE_ANCS_CP_ATT_ID_T attId;  /* Attribute ID */
+    uint8                  attNum; /* Number of the attribute sinks to get */
     CYBLE_ANCS_CP_ACT_ID_T actId;  /* Action ID */
     CYBLE_ANCS_NS_CAT_ID_T ctgId;  /* Auxiliary field to store Category ID */
 }CYBLE_ANCS_CP_T;                  /* Control Point characteristic structure */
 
-typedef struct
-{
-    CYBLE_ANCS_CP_CMD_ID_T cmdId;  /* Command ID */
-    uint32                 ntfUid; /* Notification UID */
-    CYBLE_ANCS_CP_ATT_ID_T attId;  /* Attribute ID */
-    uint16                 length; /* Length of data */
-    uint8*                 data;   /* Pointer to data buffer */
-    uint16                 currLength; /* Auxiliary field to store current length */
-}CYBLE_ANCS_DS_T;                  /* Data Source characteristic structure */
-
 /***************************************
 *      External Function Prototypes
 ***************************************/
@@ -0,0 +1,281 @@
+/*******************************************************************************
+* File Name: ancsds.c
+*
+* Version 1.0
+*
+* Description:
+*  This file contains the Get Notification Attributes request and the
+*  parser of its response. All the attributes of a notification are
+*  requested by one command and the response is parsed as it comes:
+*
+*   - the Title, Subtitle and Message are requested with the size of their
+*     sinks as maximum length, so the phone sends no more than is kept;
+*   - the response is parsed byte by byte, so the header and the attribute
+*     values may be split anywhere between the Data Source notifications,
+*     and the values are copied straight to the sinks, a value longer than
+*     its sink is truncated;
+*   - a fragment that does not start the response of the request, such as
+*     the rest of a response that has been cancelled, is skipped.
+*
+*  The parser only depends on cytypes.h, so it is also built on the host.
+*
+* Hardware Dependency:
+*  CY8CKIT-042 BLE
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include "ancsds.h"
+
+
+/*******************************************************************************
+* Function Name: AncsDsAttDone
+********************************************************************************
+*
+* Summary:
+*   Completes the attribute received.
+*
+* Parameters:
+*   ds - the parser.
+*
+* Return:
+*   Non-zero when all the requested attributes are complete.
+*
+*******************************************************************************/
+static uint8 AncsDsAttDone(ANCS_DS_T *ds)
+{
+    if(ANCS_DS_NONE != ds->cur)
+    {
+        ds->pending &= (uint8)~(1u << ds->cur);
+    }
+    ds->state = (0u != ds->pending) ? ANCS_DS_ST_ATT : ANCS_DS_ST_IDLE;
+
+    return((0u != ds->pending) ? 0u : 1u);
+}
+
+
+/*******************************************************************************
+* Function Name: AncsDsRequest
+********************************************************************************
+*
+* Summary:
+*   Packs the Get Notification Attributes command of the attributes of the
+*   sinks, empties the sinks and makes the parser wait for the response.
+*
+* Parameters:
+*   ds - the parser.
+*   ntfUid - the Notification UID.
+*   sink - the sinks of the attributes, in the order they are requested.
+*   sinkNum - the number of the sinks, at most ANCS_DS_SINK_MAX.
+*   cmd - returns the command, ANCS_DS_CMD_MAX bytes.
+*
+* Return:
+*   The length of the command.
+*
+*******************************************************************************/
+uint8 AncsDsRequest(ANCS_DS_T *ds, uint32 ntfUid, ANCS_DS_SINK_T sink[], uint8 sinkNum, uint8 cmd[])
+{
+    uint8 length = 0u;
+    uint8 i;
+
+    if(sinkNum > ANCS_DS_SINK_MAX)
+    {
+        sinkNum = ANCS_DS_SINK_MAX;
+    }
+
+    cmd[length++] = ANCS_DS_CMD_ID_GNA;
+    for(i = 0u; i < 4u; i++)
+    {
+        cmd[length++] = (uint8)(ntfUid >> (i << 3u));
+    }
+
+    for(i = 0u; i < sinkNum; i++)
+    {
+        sink[i].length = 0u;
+        sink[i].truncated = 0u;
+        cmd[length++] = sink[i].attId;
+        if(ANCS_DS_ATT_HAS_MAX(sink[i].attId))
+        {
+            cmd[length++] = (uint8)sink[i].size;
+            cmd[length++] = (uint8)(sink[i].size >> 8u);
+        }
+    }
+
+    ds->sink = sink;
+    ds->sinkNum = sinkNum;
+    ds->pending = (uint8)((1u << sinkNum) - 1u);
+    ds->ntfUid = ntfUid;
+    ds->state = (0u != sinkNum) ? ANCS_DS_ST_CMD : ANCS_DS_ST_IDLE;
+
+    return(length);
+}
+
+
+/*******************************************************************************
+* Function Name: AncsDsCancel
+********************************************************************************
+*
+* Summary:
+*   Stops waiting for the response, the fragments received later are
+*   skipped.
+*
+* Parameters:
+*   ds - the parser.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void AncsDsCancel(ANCS_DS_T *ds)
+{
+    ds->state = ANCS_DS_ST_IDLE;
+}
+
+
+/*******************************************************************************
+* Function Name: AncsDsParse
+********************************************************************************
+*
+* Summary:
+*   Parses a Data Source notification, the attribute values are appended
+*   to their sinks.
+*
+* Parameters:
+*   ds - the parser.
+*   data - the value of the notification.
+*   length - the length of the value.
+*
+* Return:
+*   Non-zero when the last requested attribute has been completed.
+*
+*******************************************************************************/
+uint8 AncsDsParse(ANCS_DS_T *ds, const uint8 data[], uint16 length)
+{
+    ANCS_DS_SINK_T *sink;
+    uint16 pos = 0u;
+    uint16 n;
+    uint16 room;
+    uint16 j;
+    uint8 done = 0u;
+    uint8 i;
+
+    while(pos < length)
+    {
+        switch(ds->state)
+        {
+            case ANCS_DS_ST_CMD:
+                if(ANCS_DS_CMD_ID_GNA == data[pos])
+                {
+                    ds->state = ANCS_DS_ST_UID;
+                    ds->count = 0u;
+                    ds->field = 0u;
+                    pos++;
+                }
+                else
+                { /* Not the start of the response */
+                    pos = length;
+                }
+                break;
+
+            case ANCS_DS_ST_UID:
+                ds->field |= (uint32)data[pos] << (ds->count << 3u);
+                ds->count++;
+                pos++;
+                if(4u == ds->count)
+                {
+                    if(ds->field == ds->ntfUid)
+                    {
+                        ds->state = ANCS_DS_ST_ATT;
+                    }
+                    else
+                    { /* The response of another notification */
+                        ds->state = ANCS_DS_ST_CMD;
+                        pos = length;
+                    }
+                }
+                break;
+
+            case ANCS_DS_ST_ATT:
+                /* An attribute that is not requested is skipped */
+                ds->cur = ANCS_DS_NONE;
+                for(i = 0u; i < ds->sinkNum; i++)
+                {
+                    if((ANCS_DS_NONE == ds->cur) && (ds->sink[i].attId == data[pos]))
+                    {
+                        ds->cur = i;
+                    }
+                }
+                ds->state = ANCS_DS_ST_LEN;
+                ds->count = 0u;
+                ds->field = 0u;
+                pos++;
+                break;
+
+            case ANCS_DS_ST_LEN:
+                ds->field |= (uint32)data[pos] << (ds->count << 3u);
+                ds->count++;
+                pos++;
+                if(2u == ds->count)
+                {
+                    ds->remain = (uint16)ds->field;
+                    if(0u == ds->remain)
+                    {
+                        done |= AncsDsAttDone(ds);
+                    }
+                    else
+                    {
+                        ds->state = ANCS_DS_ST_DATA;
+                    }
+                }
+                break;
+
+            case ANCS_DS_ST_DATA:
+                n = length - pos;
+                if(n > ds->remain)
+                {
+                    n = ds->remain;
+                }
+
+                if(ANCS_DS_NONE != ds->cur)
+                {
+                    sink = &ds->sink[ds->cur];
+                    room = sink->size - sink->length;
+                    if(n > room)
+                    {
+                        sink->truncated = 1u;
+                    }
+                    else
+                    {
+                        room = n;
+                    }
+                    for(j = 0u; j < room; j++)
+                    {
+                        sink->data[sink->length + j] = data[pos + j];
+                    }
+                    sink->length += room;
+                }
+
+                pos += n;
+                ds->remain -= n;
+                if(0u == ds->remain)
+                {
+                    done |= AncsDsAttDone(ds);
+                }
+                break;
+
+            default:
+                /* No response is expected */
+                pos = length;
+                break;
+        }
+    }
+
+    return(done);
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,86 @@
+/*******************************************************************************
+* File Name: ancsds.h
+*
+* Version 1.0
+*
+* Description:
+*  Contains the function prototypes and constants of the Get Notification
+*  Attributes request and of the parser of its Data Source response.
+*
+* Hardware Dependency:
+*  CY8CKIT-042 BLE
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(ANCSDS_H)
+#define ANCSDS_H
+
+#include "cytypes.h"
+
+
+/***************************************
+*        Constants
+***************************************/
+#define ANCS_DS_SINK_MAX            (4u)        /* Attributes of one request */
+#define ANCS_DS_CMD_MAX             (5u + (3u * ANCS_DS_SINK_MAX)) /* Bytes of the longest request */
+#define ANCS_DS_NONE                (0xFFu)     /* No sink */
+
+/* Command ID of Get Notification Attributes, same as CYBLE_ANCS_CP_CMD_ID_GNA */
+#define ANCS_DS_CMD_ID_GNA          (0x00u)
+
+/* The Title, Subtitle and Message attributes are requested with a maximum length */
+#define ANCS_DS_ATT_ID_TTL          (0x01u)
+#define ANCS_DS_ATT_ID_MSG          (0x03u)
+#define ANCS_DS_ATT_HAS_MAX(attId)  (((attId) >= ANCS_DS_ATT_ID_TTL) && ((attId) <= ANCS_DS_ATT_ID_MSG))
+
+/* States of the parser */
+#define ANCS_DS_ST_IDLE             (0u)        /* No response is expected */
+#define ANCS_DS_ST_CMD              (1u)        /* Command ID */
+#define ANCS_DS_ST_UID              (2u)        /* Notification UID */
+#define ANCS_DS_ST_ATT              (3u)        /* Attribute ID */
+#define ANCS_DS_ST_LEN              (4u)        /* Attribute length */
+#define ANCS_DS_ST_DATA             (5u)        /* Attribute value */
+
+
+/***************************************
+*        Data Struct Definition
+***************************************/
+typedef struct
+{
+    uint8  attId;               /* Attribute ID */
+    uint8  truncated;           /* Non-zero when the value did not fit in data */
+    uint8* data;                /* Buffer of the value */
+    uint16 size;                /* Size of the buffer, also the requested maximum length */
+    uint16 length;              /* Bytes of the value in data */
+} ANCS_DS_SINK_T;
+
+typedef struct
+{
+    ANCS_DS_SINK_T* sink;       /* Sinks of the requested attributes */
+    uint8  sinkNum;             /* Requested attributes */
+    uint8  pending;             /* Mask of the sinks not complete yet */
+    uint8  state;               /* ANCS_DS_ST_ */
+    uint8  cur;                 /* Sink of the attribute received or ANCS_DS_NONE */
+    uint8  count;               /* Bytes of the field received */
+    uint32 field;               /* Value of the field received */
+    uint32 ntfUid;              /* Notification UID of the request */
+    uint16 remain;              /* Bytes of the attribute value left */
+} ANCS_DS_T;
+
+
+/***************************************
+*      API Function Prototypes
+***************************************/
+uint8 AncsDsRequest(ANCS_DS_T *ds, uint32 ntfUid, ANCS_DS_SINK_T sink[], uint8 sinkNum, uint8 cmd[]);
+void AncsDsCancel(ANCS_DS_T *ds);
+uint8 AncsDsParse(ANCS_DS_T *ds, const uint8 data[], uint16 length);
+
+
+#endif /* ANCSDS_H */
+
+/* [] END OF FILE */
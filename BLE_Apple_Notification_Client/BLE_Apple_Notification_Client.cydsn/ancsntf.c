@@ -0,0 +1,401 @@
+/*******************************************************************************
+* File Name: ancsntf.c
+*
+* Version 1.0
+*
+* Description:
+*  This file contains the table of the notifications that wait for their
+*  attributes to be read. A Notification Source event is handled in a
+*  constant time whatever the order the events come in:
+*
+*   - the notifications are found by their UID through an open addressing
+*     index with linear probing, a removed UID shifts the following ones
+*     back, so the index has no deleted slots to skip;
+*   - the notifications wait in two FIFO queues, the Important ones are
+*     served first, a modification that changes the Important flag moves
+*     the notification to the other queue and a removal unlinks it;
+*   - when the table is full the oldest notification of the lowest
+*     priority is dropped, a new notification that is not Important is
+*     dropped when all the pending ones are Important.
+*
+*  The table only depends on cytypes.h, so it is also built on the host.
+*
+* Hardware Dependency:
+*  CY8CKIT-042 BLE
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include "ancsntf.h"
+
+
+ANCS_NTF_T ancsNtf[ANCS_NTF_MAX];
+uint8 ancsNtfCount = 0u;
+uint32 ancsNtfDropped = 0u;
+
+static uint8 ancsNtfIndex[ANCS_NTF_INDEX_SIZE];     /* Notification of every slot */
+static uint8 ancsNtfHead[ANCS_NTF_Q_NUM];           /* Oldest notification of every queue */
+static uint8 ancsNtfTail[ANCS_NTF_Q_NUM];           /* Newest notification of every queue */
+static uint8 ancsNtfFree = ANCS_NTF_NONE;           /* First free notification */
+
+
+/*******************************************************************************
+* Function Name: AncsNtfHome
+********************************************************************************
+*
+* Summary:
+*   Hashes the UID to its home slot of the index. The UIDs are usually
+*   consecutive, the multiplicative hash spreads them over the slots.
+*
+* Parameters:
+*   ntfUid - the Notification UID.
+*
+* Return:
+*   The home slot.
+*
+*******************************************************************************/
+static uint8 AncsNtfHome(uint32 ntfUid)
+{
+    return((uint8)((ntfUid * 0x9E3779B1u) >> (32u - ANCS_NTF_INDEX_BITS)));
+}
+
+
+/*******************************************************************************
+* Function Name: AncsNtfSlot
+********************************************************************************
+*
+* Summary:
+*   Probes the index for the UID.
+*
+* Parameters:
+*   ntfUid - the Notification UID.
+*
+* Return:
+*   The slot of the UID or the free slot where it would be inserted.
+*
+*******************************************************************************/
+static uint8 AncsNtfSlot(uint32 ntfUid)
+{
+    uint8 slot = AncsNtfHome(ntfUid);
+
+    while((ANCS_NTF_NONE != ancsNtfIndex[slot]) && (ancsNtf[ancsNtfIndex[slot]].ntfUid != ntfUid))
+    {
+        slot = (uint8)((slot + 1u) & ANCS_NTF_INDEX_MASK);
+    }
+
+    return(slot);
+}
+
+
+/*******************************************************************************
+* Function Name: AncsNtfAppend
+********************************************************************************
+*
+* Summary:
+*   Appends the notification to the queue.
+*
+* Parameters:
+*   ntf - the notification.
+*   queue - the queue, ANCS_NTF_Q_.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+static void AncsNtfAppend(uint8 ntf, uint8 queue)
+{
+    ancsNtf[ntf].queue = queue;
+    ancsNtf[ntf].prev = ancsNtfTail[queue];
+    ancsNtf[ntf].next = ANCS_NTF_NONE;
+
+    if(ANCS_NTF_NONE != ancsNtfTail[queue])
+    {
+        ancsNtf[ancsNtfTail[queue]].next = ntf;
+    }
+    else
+    {
+        ancsNtfHead[queue] = ntf;
+    }
+    ancsNtfTail[queue] = ntf;
+}
+
+
+/*******************************************************************************
+* Function Name: AncsNtfUnlink
+********************************************************************************
+*
+* Summary:
+*   Removes the notification from its queue.
+*
+* Parameters:
+*   ntf - the notification.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+static void AncsNtfUnlink(uint8 ntf)
+{
+    uint8 queue = ancsNtf[ntf].queue;
+
+    if(ANCS_NTF_NONE != ancsNtf[ntf].prev)
+    {
+        ancsNtf[ancsNtf[ntf].prev].next = ancsNtf[ntf].next;
+    }
+    else
+    {
+        ancsNtfHead[queue] = ancsNtf[ntf].next;
+    }
+
+    if(ANCS_NTF_NONE != ancsNtf[ntf].next)
+    {
+        ancsNtf[ancsNtf[ntf].next].prev = ancsNtf[ntf].prev;
+    }
+    else
+    {
+        ancsNtfTail[queue] = ancsNtf[ntf].prev;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: AncsNtfRelease
+********************************************************************************
+*
+* Summary:
+*   Takes the notification out of the index and of its queue and frees it.
+*   The notifications probed past its slot are shifted back, so every one
+*   stays reachable from its home slot.
+*
+* Parameters:
+*   ntf - the notification.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+static void AncsNtfRelease(uint8 ntf)
+{
+    uint8 hole = AncsNtfSlot(ancsNtf[ntf].ntfUid);
+    uint8 slot = (uint8)((hole + 1u) & ANCS_NTF_INDEX_MASK);
+    uint8 home;
+
+    ancsNtfIndex[hole] = ANCS_NTF_NONE;
+    while(ANCS_NTF_NONE != ancsNtfIndex[slot])
+    {
+        home = AncsNtfHome(ancsNtf[ancsNtfIndex[slot]].ntfUid);
+
+        /* Shift back unless its home is between the hole and the slot */
+        if(((uint8)(slot - home) & ANCS_NTF_INDEX_MASK) >= ((uint8)(slot - hole) & ANCS_NTF_INDEX_MASK))
+        {
+            ancsNtfIndex[hole] = ancsNtfIndex[slot];
+            ancsNtfIndex[slot] = ANCS_NTF_NONE;
+            hole = slot;
+        }
+        slot = (uint8)((slot + 1u) & ANCS_NTF_INDEX_MASK);
+    }
+
+    AncsNtfUnlink(ntf);
+    ancsNtf[ntf].queue = ANCS_NTF_NONE;
+    ancsNtf[ntf].next = ancsNtfFree;
+    ancsNtfFree = ntf;
+    ancsNtfCount--;
+}
+
+
+/*******************************************************************************
+* Function Name: AncsNtfInit
+********************************************************************************
+*
+* Summary:
+*   Empties the table.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void AncsNtfInit(void)
+{
+    uint32 i;
+
+    for(i = 0u; i < ANCS_NTF_INDEX_SIZE; i++)
+    {
+        ancsNtfIndex[i] = ANCS_NTF_NONE;
+    }
+    for(i = 0u; i < ANCS_NTF_Q_NUM; i++)
+    {
+        ancsNtfHead[i] = ANCS_NTF_NONE;
+        ancsNtfTail[i] = ANCS_NTF_NONE;
+    }
+    for(i = 0u; i < ANCS_NTF_MAX; i++)
+    {
+        ancsNtf[i].queue = ANCS_NTF_NONE;
+        ancsNtf[i].next = (uint8)((i < (ANCS_NTF_MAX - 1u)) ? (i + 1u) : ANCS_NTF_NONE);
+    }
+    ancsNtfFree = 0u;
+    ancsNtfCount = 0u;
+    ancsNtfDropped = 0u;
+}
+
+
+/*******************************************************************************
+* Function Name: AncsNtfFind
+********************************************************************************
+*
+* Summary:
+*   Finds the pending notification.
+*
+* Parameters:
+*   ntfUid - the Notification UID.
+*
+* Return:
+*   The notification or ANCS_NTF_NONE when it is not pending.
+*
+*******************************************************************************/
+uint8 AncsNtfFind(uint32 ntfUid)
+{
+    return(ancsNtfIndex[AncsNtfSlot(ntfUid)]);
+}
+
+
+/*******************************************************************************
+* Function Name: AncsNtfPut
+********************************************************************************
+*
+* Summary:
+*   Queues the notification, a pending notification is updated in place
+*   and keeps its turn unless its Important flag has changed.
+*
+* Parameters:
+*   ntfUid - the Notification UID.
+*   evtFlg - the Event Flags.
+*   ctgId - the Category ID.
+*
+* Return:
+*   The notification or ANCS_NTF_NONE when it has been dropped.
+*
+*******************************************************************************/
+uint8 AncsNtfPut(uint32 ntfUid, uint8 evtFlg, uint8 ctgId)
+{
+    uint8 queue = ((evtFlg & ANCS_NTF_FLG_IM) != 0u) ? ANCS_NTF_Q_IMPORTANT : ANCS_NTF_Q_OTHER;
+    uint8 slot = AncsNtfSlot(ntfUid);
+    uint8 ntf = ancsNtfIndex[slot];
+    uint8 victim;
+
+    if(ANCS_NTF_NONE == ntf)
+    {
+        if(ANCS_NTF_NONE == ancsNtfFree)
+        {
+            /* Full, drop the oldest notification of the lowest priority */
+            victim = ancsNtfHead[ANCS_NTF_Q_OTHER];
+            if((ANCS_NTF_NONE == victim) && (ANCS_NTF_Q_IMPORTANT == queue))
+            {
+                victim = ancsNtfHead[ANCS_NTF_Q_IMPORTANT];
+            }
+            if(ANCS_NTF_NONE != victim)
+            {
+                AncsNtfRelease(victim);
+                /* The release may have shifted the probe sequence */
+                slot = AncsNtfSlot(ntfUid);
+            }
+            ancsNtfDropped++;
+        }
+
+        if(ANCS_NTF_NONE != ancsNtfFree)
+        {
+            ntf = ancsNtfFree;
+            ancsNtfFree = ancsNtf[ntf].next;
+            ancsNtf[ntf].ntfUid = ntfUid;
+            ancsNtfIndex[slot] = ntf;
+            AncsNtfAppend(ntf, queue);
+            ancsNtfCount++;
+        }
+    }
+    else if(ancsNtf[ntf].queue != queue)
+    {
+        AncsNtfUnlink(ntf);
+        AncsNtfAppend(ntf, queue);
+    }
+    else
+    {
+    }
+
+    if(ANCS_NTF_NONE != ntf)
+    {
+        ancsNtf[ntf].evtFlg = evtFlg;
+        ancsNtf[ntf].ctgId = ctgId;
+    }
+
+    return(ntf);
+}
+
+
+/*******************************************************************************
+* Function Name: AncsNtfRemove
+********************************************************************************
+*
+* Summary:
+*   Removes the pending notification.
+*
+* Parameters:
+*   ntfUid - the Notification UID.
+*
+* Return:
+*   Non-zero when the notification was pending.
+*
+*******************************************************************************/
+uint8 AncsNtfRemove(uint32 ntfUid)
+{
+    uint8 ntf = AncsNtfFind(ntfUid);
+
+    if(ANCS_NTF_NONE != ntf)
+    {
+        AncsNtfRelease(ntf);
+    }
+
+    return((ANCS_NTF_NONE != ntf) ? 1u : 0u);
+}
+
+
+/*******************************************************************************
+* Function Name: AncsNtfPop
+********************************************************************************
+*
+* Summary:
+*   Takes the next notification to process out of the table, the oldest
+*   Important one, else the oldest one.
+*
+* Parameters:
+*   ntf - returns the notification.
+*
+* Return:
+*   Non-zero when a notification has been taken, 0 when none is pending.
+*
+*******************************************************************************/
+uint8 AncsNtfPop(ANCS_NTF_T *ntf)
+{
+    uint8 next = ancsNtfHead[ANCS_NTF_Q_IMPORTANT];
+
+    if(ANCS_NTF_NONE == next)
+    {
+        next = ancsNtfHead[ANCS_NTF_Q_OTHER];
+    }
+
+    if(ANCS_NTF_NONE != next)
+    {
+        *ntf = ancsNtf[next];
+        AncsNtfRelease(next);
+    }
+
+    return((ANCS_NTF_NONE != next) ? 1u : 0u);
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,79 @@
+/*******************************************************************************
+* File Name: ancsntf.h
+*
+* Version 1.0
+*
+* Description:
+*  Contains the function prototypes and constants of the table of the
+*  pending notifications of the Apple Notification Center Service client.
+*
+* Hardware Dependency:
+*  CY8CKIT-042 BLE
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(ANCSNTF_H)
+#define ANCSNTF_H
+
+#include "cytypes.h"
+
+
+/***************************************
+*        Constants
+***************************************/
+#define ANCS_NTF_MAX                (16u)       /* Pending notifications, below ANCS_NTF_NONE */
+#define ANCS_NTF_INDEX_BITS         (5u)
+#define ANCS_NTF_INDEX_SIZE         (1u << ANCS_NTF_INDEX_BITS) /* Slots of the UID index, at least
+                                                                 * twice ANCS_NTF_MAX */
+#define ANCS_NTF_INDEX_MASK         (ANCS_NTF_INDEX_SIZE - 1u)
+#define ANCS_NTF_NONE               (0xFFu)     /* No notification */
+
+/* The Important flag of the EventFlags, same as CYBLE_ANCS_NS_FLG_IM */
+#define ANCS_NTF_FLG_IM             (0x02u)
+
+/* Queues of the pending notifications, the Important one is served first */
+#define ANCS_NTF_Q_IMPORTANT        (0u)
+#define ANCS_NTF_Q_OTHER            (1u)
+#define ANCS_NTF_Q_NUM              (2u)
+
+
+/***************************************
+*        Data Struct Definition
+***************************************/
+typedef struct
+{
+    uint32 ntfUid;              /* Notification UID */
+    uint8  evtFlg;              /* Event Flags */
+    uint8  ctgId;               /* Category ID */
+    uint8  queue;               /* ANCS_NTF_Q_ of the notification or ANCS_NTF_NONE when free */
+    uint8  prev;                /* Previous notification of the queue or ANCS_NTF_NONE */
+    uint8  next;                /* Next notification of the queue or of the free list */
+} ANCS_NTF_T;
+
+
+/***************************************
+*      API Function Prototypes
+***************************************/
+void AncsNtfInit(void);
+uint8 AncsNtfFind(uint32 ntfUid);
+uint8 AncsNtfPut(uint32 ntfUid, uint8 evtFlg, uint8 ctgId);
+uint8 AncsNtfRemove(uint32 ntfUid);
+uint8 AncsNtfPop(ANCS_NTF_T *ntf);
+
+
+/***************************************
+*      External data references
+***************************************/
+extern ANCS_NTF_T ancsNtf[ANCS_NTF_MAX];
+extern uint8 ancsNtfCount;          /* Pending notifications */
+extern uint32 ancsNtfDropped;       /* Notifications dropped as the table was full */
+
+
+#endif /* ANCSNTF_H */
+
+/* [] END OF FILE */
@@ -130,6 +130,7 @@ void AppCallBack(uint32 event, void* eventParam)
         case CYBLE_EVT_GAP_DEVICE_CONNECTED:
             DBG_PRINTF("CYBLE_EVT_GAP_DEVICE_CONNECTED: 0x%2.2x\r\n", cyBle_connHandle.bdHandle);
             ancsFlag = 0u;
+            AncsNtfInit();
             Advertising_LED_Write(LED_OFF);
             apiResult = CyBle_GapAuthReq(cyBle_connHandle.bdHandle, &cyBle_authInfo);
             if(apiResult == CYBLE_ERROR_OK)
@@ -20,7 +20,7 @@
 
 
 uint8 cgmsFlag = 0u;
-uint8 recCnt = 1u;
+uint16 recCnt = 0u;
 uint8 racpOpCode = 0u;
 uint8 racpOperator = 0u;
 uint8 racpOperand[3u];
@@ -82,8 +82,7 @@ const CYBLE_TIME_ZONE_T timeZone[CYBLE_TIME_ZONE_VAL_NUM] =
     CYBLE_TIME_ZONE_P1400  /* UTC+14:00 */
 };
 
-uint8 recStatus[REC_NUM] = {REC_STATUS_OK, REC_STATUS_OK, REC_STATUS_OK};
-
+/* Simulated records, stored to the record log when it is empty */
 CYBLE_CGMS_CGMT_T cgmt[REC_NUM] =
 {
     {   CYBLE_CGMS_GLMT_FLG_TI | 
@@ -175,28 +174,7 @@ Return:
 ******************************************************************************/
 uint16 CgmsCrc(uint8 length, uint8 *dataPtr)
 {
-    uint8  bit, byte;
-    uint16 data, crc = CYBLE_CGMS_CRC_SEED;
-    
-    for(byte = 0; byte < length; byte++)
-    {
-        data = (uint16) dataPtr[byte];
-        for(bit = 0u; bit < 8u; bit++)
-        {
-            if(0u != ((crc ^ data) & 0x0001u))
-            {
-                crc = (crc >> 1u) ^ CYBLE_CGMS_CRC_POLY;
-            }
-            else
-            {
-                crc >>= 1u;
-            }
-            
-            data >>= 1u;
-        }
-    }
-
-    return(crc);
+    return(Crc16Update(CYBLE_CGMS_CRC_SEED, dataPtr, length));
 }
 
 
@@ -292,14 +270,26 @@ CYBLE_GATT_ERR_CODE_T CgmsCrcCheck(uint16 attrSize, CYBLE_GATT_VALUE_T *gattValu
 Summary:
   Does the initialization of the CGM Service.
   Registers CGMS CallBack and reads the initial CGM feature characteristic.
+  Restores the CGM records from the record log.
 
 ******************************************************************************/
 void CgmsInit(void)
 {
     uint8 acgft[6u];
+    uint8 i;
     
     CyBle_CgmsRegisterAttrCallback(CgmsCallBack);
     
+    RecLogInit();
+    if(recLogHead == recLogTail)
+    {
+        for(i = 0u; i < REC_NUM; i++)
+        {
+            (void)RecLogAppend(&cgmt[i]);
+        }
+    }
+    DBG_PRINTF("CGM records in the log: %ld \r\n", recLogHead - recLogTail);
+    
     apiResult = CyBle_CgmssGetCharacteristicValue(CYBLE_CGMS_CGFT, 6u, acgft);
     if(apiResult != CYBLE_ERROR_OK)
 	{
@@ -821,7 +811,9 @@ void CgmsSendCgmtNtf(CYBLE_CGMS_CGMT_T cgmt)
 {
     uint8 pdu[sizeof(CYBLE_CGMS_CGMT_T)];
     uint8 ptr, b;
-    
+
+    NTF_STAT_BUILD_START();
+
     /* "Flags" octet goes second */
 	pdu[1u] = cgmt.flags;
     
@@ -878,14 +870,18 @@ void CgmsSendCgmtNtf(CYBLE_CGMS_CGMT_T cgmt)
     {
         pdu[0u] = ptr;
     }
-        
+
+    NTF_STAT_BUILD_END();
+
     do
     {
         CyBle_ProcessEvents();
+        NTF_STAT_BUSY_POLL();
     }
     while(CyBle_GattGetBusyStatus() == CYBLE_STACK_STATE_BUSY);
     
     apiResult = CyBle_CgmssSendNotification(cyBle_connHandle, CYBLE_CGMS_CGMT, ptr, pdu);
+    NTF_STAT_SENT(apiResult, ptr);
 	if(apiResult != CYBLE_ERROR_OK)
 	{
 		DBG_PRINTF("CgmsSendCgmtNtf API Error: ");
@@ -911,20 +907,21 @@ Summary:
   Processes the CGM record depending on RACP OpCode.
 
 Parameters:
-  uint8 recNum: the number of the CGM record.
+  uint32 pos: the position of the CGM record in the record log.
+  CYBLE_CGMS_CGMT_T *rec: the CGM record.
 
 Return:
   None. 
 
 ******************************************************************************/
-void CgmsRacpOpCodeProcess(uint8 recNum)
+void CgmsRacpOpCodeProcess(uint32 pos, CYBLE_CGMS_CGMT_T *rec)
 {
     attr[3u] = CYBLE_CGMS_RACP_RSP_SUCCESS;
     
     switch(racpOpCode)
     {
         case CYBLE_CGMS_RACP_OPC_REPORT_REC:
-            CgmsSendCgmtNtf(cgmt[recNum]);
+            CgmsSendCgmtNtf(*rec);
             break;
             
         case CYBLE_CGMS_RACP_OPC_REPORT_NUM_REC:
@@ -932,7 +929,7 @@ void CgmsRacpOpCodeProcess(uint8 recNum)
             break;
             
         case CYBLE_CGMS_RACP_OPC_DELETE_REC:
-            recStatus[recNum] = REC_STATUS_DELETED;
+            RecLogDelete(pos);
             break;
             
         default:
@@ -942,6 +939,43 @@ void CgmsRacpOpCodeProcess(uint8 recNum)
 }
 
 
+/******************************************************************************
+##Function Name: CgmsRacpProcessRange
+*******************************************************************************
+
+Summary:
+  Processes all the stored CGM records with the Time Offset within
+  the range (inclusive), from the oldest to the most recent one.
+
+Parameters:
+  uint16 minOffset: the lowest Time Offset.
+  uint16 maxOffset: the highest Time Offset.
+
+Return:
+  None. 
+
+******************************************************************************/
+void CgmsRacpProcessRange(uint16 minOffset, uint16 maxOffset)
+{
+    CYBLE_CGMS_CGMT_T rec;
+    uint32 pos;
+    
+    attr[3u] = CYBLE_CGMS_RACP_RSP_NO_REC;
+    recCnt = 0u;
+    for(pos = recLogTail; pos < recLogHead; pos++)
+    {
+        if(0u == RecLogIsDeleted(pos))
+        {
+            RecLogRead(pos, &rec);
+            if((rec.timeOffset >= minOffset) && (rec.timeOffset <= maxOffset))
+            {
+                CgmsRacpOpCodeProcess(pos, &rec);
+            }
+        }
+    }
+}
+
+
 /******************************************************************************
 ##Function Name: CgmsProcess
 *******************************************************************************
@@ -952,7 +986,8 @@ Summary:
 ******************************************************************************/
 void CgmsProcess(void)
 {
-    uint8 recNum;
+    CYBLE_CGMS_CGMT_T rec;
+    uint32 pos;
             
     if((cgmsFlag & CGMS_FLAG_RACP) != 0u)
     {
@@ -975,47 +1010,50 @@ void CgmsProcess(void)
             case CYBLE_CGMS_RACP_OPR_LAST:
                 if(CYBLE_CGMS_RACP_RSP_SUCCESS == attr[3u])
                 {
-                    CgmsRacpOpCodeProcess(REC_NUM - 1u);
+                    attr[3u] = CYBLE_CGMS_RACP_RSP_NO_REC;
+                    recCnt = 0u;
+                    pos = recLogHead;
+                    while((pos > recLogTail) && (CYBLE_CGMS_RACP_RSP_NO_REC == attr[3u]))
+                    {
+                        pos--;
+                        if(0u == RecLogIsDeleted(pos))
+                        {
+                            RecLogRead(pos, &rec);
+                            CgmsRacpOpCodeProcess(pos, &rec);
+                        }
+                    }
                 }
                 break;
                 
             case CYBLE_CGMS_RACP_OPR_FIRST:
                 if(CYBLE_CGMS_RACP_RSP_SUCCESS == attr[3u])
                 {
-                    CgmsRacpOpCodeProcess(0u);
+                    attr[3u] = CYBLE_CGMS_RACP_RSP_NO_REC;
+                    recCnt = 0u;
+                    for(pos = recLogTail; (pos < recLogHead) && (CYBLE_CGMS_RACP_RSP_NO_REC == attr[3u]); pos++)
+                    {
+                        if(0u == RecLogIsDeleted(pos))
+                        {
+                            RecLogRead(pos, &rec);
+                            CgmsRacpOpCodeProcess(pos, &rec);
+                        }
+                    }
                 }
                 break;
                 
             case CYBLE_CGMS_RACP_OPR_ALL:
                 if(CYBLE_CGMS_RACP_RSP_SUCCESS == attr[3u])
                 {
-                    attr[3u] = CYBLE_CGMS_RACP_RSP_NO_REC;
-                    recCnt = 0u;
-                    for(recNum = 0u; recNum < REC_NUM; recNum++)
-                    {  
-                        if(REC_STATUS_OK == recStatus[recNum])
-                        {
-                            CgmsRacpOpCodeProcess(recNum);
-                        } 
-                    }
+                    CgmsRacpProcessRange(0u, 0xFFFFu);
                 }
                 break;
                 
             case CYBLE_CGMS_RACP_OPR_LESS:
                 if(CYBLE_CGMS_RACP_RSP_SUCCESS == attr[3u])
                 {
-                    attr[3] = CYBLE_CGMS_RACP_RSP_NO_REC;
-                    
                     if(CYBLE_CGMS_RACP_OPD_1 == racpOperand[0u])
                     {
-                        recCnt = 0u;
-                        for(recNum = 0; recNum < REC_NUM; recNum++)
-                        {
-                            if((cgmt[recNum].timeOffset <= racpOperand[1u]) && (REC_STATUS_OK == recStatus[recNum]))
-                            {
-                                CgmsRacpOpCodeProcess(recNum);
-                            }    
-                        }
+                        CgmsRacpProcessRange(0u, racpOperand[1u]);
                     }
                     else
                     {
@@ -1027,18 +1065,9 @@ void CgmsProcess(void)
             case CYBLE_CGMS_RACP_OPR_GREAT:
                 if(CYBLE_CGMS_RACP_RSP_SUCCESS == attr[3u])
                 {
-                    attr[3u] = CYBLE_CGMS_RACP_RSP_NO_REC;
-                    
                     if(CYBLE_CGMS_RACP_OPD_1 == racpOperand[0u])
                     {
-                        recCnt = 0u;
-                        for(recNum = 0; recNum < REC_NUM; recNum++)
-                        {
-                            if((cgmt[recNum].timeOffset >= racpOperand[1u]) && (REC_STATUS_OK == recStatus[recNum]))
-                            {
-                                CgmsRacpOpCodeProcess(recNum);
-                            }    
-                        }
+                        CgmsRacpProcessRange(racpOperand[1u], 0xFFFFu);
                     }
                     else
                     {
@@ -1050,8 +1079,6 @@ void CgmsProcess(void)
             case CYBLE_CGMS_RACP_OPR_WITHIN:
                 if(CYBLE_CGMS_RACP_RSP_SUCCESS == attr[3u])
                 {
-                    attr[3u] = CYBLE_CGMS_RACP_RSP_NO_REC;
-                    
                     if(CYBLE_CGMS_RACP_OPD_1 == racpOperand[0u])
                     {
                         if(racpOperand[1] > racpOperand[2u])
@@ -1060,15 +1087,7 @@ void CgmsProcess(void)
                         }
                         else
                         {
-                            for(recNum = 0; recNum < REC_NUM; recNum++)
-                            {
-                                if((cgmt[recNum].timeOffset >= racpOperand[1u]) &&
-                                    (cgmt[recNum].timeOffset <= racpOperand[2u]) &&
-                                        (REC_STATUS_OK == recStatus[recNum]))
-                                {
-                                    CgmsRacpOpCodeProcess(recNum);    
-                                }
-                            }
+                            CgmsRacpProcessRange(racpOperand[1u], racpOperand[2u]);
                         }
                     }
                     else
@@ -1089,8 +1108,8 @@ void CgmsProcess(void)
         if(CYBLE_CGMS_RACP_OPC_REPORT_NUM_REC == racpOpCode)
         {
             attr[0u] = CYBLE_CGMS_RACP_OPC_NUM_REC_RSP;
-            attr[2u] = recCnt;
-            attr[3u] = 0u;
+            attr[2u] = LO8(recCnt);
+            attr[3u] = HI8(recCnt);
         }
         else
         {
@@ -1101,10 +1120,12 @@ void CgmsProcess(void)
         do
         {
             CyBle_ProcessEvents();
+            NTF_STAT_BUSY_POLL();
         }
         while(CyBle_GattGetBusyStatus() == CYBLE_STACK_STATE_BUSY);
         
         apiResult = CyBle_CgmssSendIndication(cyBle_connHandle, CYBLE_CGMS_RACP, length, attr);
+        NTF_STAT_SENT(apiResult, length);
         if(apiResult != CYBLE_ERROR_OK)
     	{
     		DBG_PRINTF("CyBle_CgmssSendIndication API Error: ");
@@ -1176,11 +1197,13 @@ void CgmsProcess(void)
         do
         {
             CyBle_ProcessEvents();
+            NTF_STAT_BUSY_POLL();
         }
         while(CyBle_GattGetBusyStatus() == CYBLE_STACK_STATE_BUSY);
         
         socpLength = CgmsCrcLength(socpLength, socp);
         apiResult = CyBle_CgmssSendIndication(cyBle_connHandle, CYBLE_CGMS_SOCP, socpLength, socp);
+        NTF_STAT_SENT(apiResult, socpLength);
         if(apiResult != CYBLE_ERROR_OK)
     	{
     		DBG_PRINTF("CyBle_CgmssSendIndication API Error: ");
@@ -26,9 +26,7 @@ typedef uint16 sfloat;
 #define SFLOAT_NINF (0x0802u) /* - infinity */
 #define SFLOAT_RSRV (0x0801u) /* reserved for future use */
 
-#define REC_STATUS_OK      (0u)
-#define REC_STATUS_DELETED (1u)
-#define REC_NUM            (3u)
+#define REC_NUM            (3u) /* Number of simulated records */
 
 #define CGMS_FLAG_SOCP (0x01u)
 #define CGMS_FLAG_RACP (0x02u)
@@ -371,6 +369,8 @@ void CgmsPrintCharName(CYBLE_CGMS_CHAR_INDEX_T charIndex);
 void CgmsInit(void);
 void CgmsCallBack(uint32 event, void* eventParam);
 void CgmsProcess(void);
+void CgmsRacpOpCodeProcess(uint32 pos, CYBLE_CGMS_CGMT_T *rec);
+void CgmsRacpProcessRange(uint16 minOffset, uint16 maxOffset);
 void CgmsSendCgmtNtf(CYBLE_CGMS_CGMT_T cgmt);
 
 
@@ -0,0 +1,304 @@
+/*******************************************************************************
+* File Name: crc16.c
+*
+* Version 1.0
+*
+* Description:
+*  This file contains the table driven CRC-CCITT (seed 0xFFFF, polynomial
+*  D16+D12+D5+1, LSB first) used by the Bluetooth profiles and by the
+*  bootloader packet checksum. The lookup table size is selected at compile
+*  time by CRC16_METHOD. All the methods give the same result as the bitwise
+*  calculation.
+*
+*  Crc16Update() can be called for consecutive parts of a message, so the
+*  CRC is calculated while the message arrives.
+*
+* Hardware Dependency:
+*  CY8CKIT-042 BLE
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include "main.h"
+
+
+#if(CRC16_METHOD == CRC16_METHOD_NIBBLE)
+
+/* CRC of the 4-bit values */
+static const uint16 crc16Table[16u] =
+{
+    0x0000u, 0x1081u, 0x2102u, 0x3183u, 0x4204u, 0x5285u, 0x6306u, 0x7387u,
+    0x8408u, 0x9489u, 0xa50au, 0xb58bu, 0xc60cu, 0xd68du, 0xe70eu, 0xf78fu
+};
+
+#elif(CRC16_METHOD == CRC16_METHOD_BYTE)
+
+/* CRC of the 8-bit values */
+static const uint16 crc16Table[256u] =
+{
+    0x0000u, 0x1189u, 0x2312u, 0x329bu, 0x4624u, 0x57adu, 0x6536u, 0x74bfu,
+    0x8c48u, 0x9dc1u, 0xaf5au, 0xbed3u, 0xca6cu, 0xdbe5u, 0xe97eu, 0xf8f7u,
+    0x1081u, 0x0108u, 0x3393u, 0x221au, 0x56a5u, 0x472cu, 0x75b7u, 0x643eu,
+    0x9cc9u, 0x8d40u, 0xbfdbu, 0xae52u, 0xdaedu, 0xcb64u, 0xf9ffu, 0xe876u,
+    0x2102u, 0x308bu, 0x0210u, 0x1399u, 0x6726u, 0x76afu, 0x4434u, 0x55bdu,
+    0xad4au, 0xbcc3u, 0x8e58u, 0x9fd1u, 0xeb6eu, 0xfae7u, 0xc87cu, 0xd9f5u,
+    0x3183u, 0x200au, 0x1291u, 0x0318u, 0x77a7u, 0x662eu, 0x54b5u, 0x453cu,
+    0xbdcbu, 0xac42u, 0x9ed9u, 0x8f50u, 0xfbefu, 0xea66u, 0xd8fdu, 0xc974u,
+    0x4204u, 0x538du, 0x6116u, 0x709fu, 0x0420u, 0x15a9u, 0x2732u, 0x36bbu,
+    0xce4cu, 0xdfc5u, 0xed5eu, 0xfcd7u, 0x8868u, 0x99e1u, 0xab7au, 0xbaf3u,
+    0x5285u, 0x430cu, 0x7197u, 0x601eu, 0x14a1u, 0x0528u, 0x37b3u, 0x263au,
+    0xdecdu, 0xcf44u, 0xfddfu, 0xec56u, 0x98e9u, 0x8960u, 0xbbfbu, 0xaa72u,
+    0x6306u, 0x728fu, 0x4014u, 0x519du, 0x2522u, 0x34abu, 0x0630u, 0x17b9u,
+    0xef4eu, 0xfec7u, 0xcc5cu, 0xddd5u, 0xa96au, 0xb8e3u, 0x8a78u, 0x9bf1u,
+    0x7387u, 0x620eu, 0x5095u, 0x411cu, 0x35a3u, 0x242au, 0x16b1u, 0x0738u,
+    0xffcfu, 0xee46u, 0xdcddu, 0xcd54u, 0xb9ebu, 0xa862u, 0x9af9u, 0x8b70u,
+    0x8408u, 0x9581u, 0xa71au, 0xb693u, 0xc22cu, 0xd3a5u, 0xe13eu, 0xf0b7u,
+    0x0840u, 0x19c9u, 0x2b52u, 0x3adbu, 0x4e64u, 0x5fedu, 0x6d76u, 0x7cffu,
+    0x9489u, 0x8500u, 0xb79bu, 0xa612u, 0xd2adu, 0xc324u, 0xf1bfu, 0xe036u,
+    0x18c1u, 0x0948u, 0x3bd3u, 0x2a5au, 0x5ee5u, 0x4f6cu, 0x7df7u, 0x6c7eu,
+    0xa50au, 0xb483u, 0x8618u, 0x9791u, 0xe32eu, 0xf2a7u, 0xc03cu, 0xd1b5u,
+    0x2942u, 0x38cbu, 0x0a50u, 0x1bd9u, 0x6f66u, 0x7eefu, 0x4c74u, 0x5dfdu,
+    0xb58bu, 0xa402u, 0x9699u, 0x8710u, 0xf3afu, 0xe226u, 0xd0bdu, 0xc134u,
+    0x39c3u, 0x284au, 0x1ad1u, 0x0b58u, 0x7fe7u, 0x6e6eu, 0x5cf5u, 0x4d7cu,
+    0xc60cu, 0xd785u, 0xe51eu, 0xf497u, 0x8028u, 0x91a1u, 0xa33au, 0xb2b3u,
+    0x4a44u, 0x5bcdu, 0x6956u, 0x78dfu, 0x0c60u, 0x1de9u, 0x2f72u, 0x3efbu,
+    0xd68du, 0xc704u, 0xf59fu, 0xe416u, 0x90a9u, 0x8120u, 0xb3bbu, 0xa232u,
+    0x5ac5u, 0x4b4cu, 0x79d7u, 0x685eu, 0x1ce1u, 0x0d68u, 0x3ff3u, 0x2e7au,
+    0xe70eu, 0xf687u, 0xc41cu, 0xd595u, 0xa12au, 0xb0a3u, 0x8238u, 0x93b1u,
+    0x6b46u, 0x7acfu, 0x4854u, 0x59ddu, 0x2d62u, 0x3cebu, 0x0e70u, 0x1ff9u,
+    0xf78fu, 0xe606u, 0xd49du, 0xc514u, 0xb1abu, 0xa022u, 0x92b9u, 0x8330u,
+    0x7bc7u, 0x6a4eu, 0x58d5u, 0x495cu, 0x3de3u, 0x2c6au, 0x1ef1u, 0x0f78u
+};
+
+#else
+
+/* crc16Table[0] is the CRC of the 8-bit values, crc16Table[k] is the CRC of
+*  the 8-bit values followed by k zero bytes.
+*/
+static const uint16 crc16Table[4u][256u] =
+{
+    {
+        0x0000u, 0x1189u, 0x2312u, 0x329bu, 0x4624u, 0x57adu, 0x6536u, 0x74bfu,
+        0x8c48u, 0x9dc1u, 0xaf5au, 0xbed3u, 0xca6cu, 0xdbe5u, 0xe97eu, 0xf8f7u,
+        0x1081u, 0x0108u, 0x3393u, 0x221au, 0x56a5u, 0x472cu, 0x75b7u, 0x643eu,
+        0x9cc9u, 0x8d40u, 0xbfdbu, 0xae52u, 0xdaedu, 0xcb64u, 0xf9ffu, 0xe876u,
+        0x2102u, 0x308bu, 0x0210u, 0x1399u, 0x6726u, 0x76afu, 0x4434u, 0x55bdu,
+        0xad4au, 0xbcc3u, 0x8e58u, 0x9fd1u, 0xeb6eu, 0xfae7u, 0xc87cu, 0xd9f5u,
+        0x3183u, 0x200au, 0x1291u, 0x0318u, 0x77a7u, 0x662eu, 0x54b5u, 0x453cu,
+        0xbdcbu, 0xac42u, 0x9ed9u, 0x8f50u, 0xfbefu, 0xea66u, 0xd8fdu, 0xc974u,
+        0x4204u, 0x538du, 0x6116u, 0x709fu, 0x0420u, 0x15a9u, 0x2732u, 0x36bbu,
+        0xce4cu, 0xdfc5u, 0xed5eu, 0xfcd7u, 0x8868u, 0x99e1u, 0xab7au, 0xbaf3u,
+        0x5285u, 0x430cu, 0x7197u, 0x601eu, 0x14a1u, 0x0528u, 0x37b3u, 0x263au,
+        0xdecdu, 0xcf44u, 0xfddfu, 0xec56u, 0x98e9u, 0x8960u, 0xbbfbu, 0xaa72u,
+        0x6306u, 0x728fu, 0x4014u, 0x519du, 0x2522u, 0x34abu, 0x0630u, 0x17b9u,
+        0xef4eu, 0xfec7u, 0xcc5cu, 0xddd5u, 0xa96au, 0xb8e3u, 0x8a78u, 0x9bf1u,
+        0x7387u, 0x620eu, 0x5095u, 0x411cu, 0x35a3u, 0x242au, 0x16b1u, 0x0738u,
+        0xffcfu, 0xee46u, 0xdcddu, 0xcd54u, 0xb9ebu, 0xa862u, 0x9af9u, 0x8b70u,
+        0x8408u, 0x9581u, 0xa71au, 0xb693u, 0xc22cu, 0xd3a5u, 0xe13eu, 0xf0b7u,
+        0x0840u, 0x19c9u, 0x2b52u, 0x3adbu, 0x4e64u, 0x5fedu, 0x6d76u, 0x7cffu,
+        0x9489u, 0x8500u, 0xb79bu, 0xa612u, 0xd2adu, 0xc324u, 0xf1bfu, 0xe036u,
+        0x18c1u, 0x0948u, 0x3bd3u, 0x2a5au, 0x5ee5u, 0x4f6cu, 0x7df7u, 0x6c7eu,
+        0xa50au, 0xb483u, 0x8618u, 0x9791u, 0xe32eu, 0xf2a7u, 0xc03cu, 0xd1b5u,
+        0x2942u, 0x38cbu, 0x0a50u, 0x1bd9u, 0x6f66u, 0x7eefu, 0x4c74u, 0x5dfdu,
+        0xb58bu, 0xa402u, 0x9699u, 0x8710u, 0xf3afu, 0xe226u, 0xd0bdu, 0xc134u,
+        0x39c3u, 0x284au, 0x1ad1u, 0x0b58u, 0x7fe7u, 0x6e6eu, 0x5cf5u, 0x4d7cu,
+        0xc60cu, 0xd785u, 0xe51eu, 0xf497u, 0x8028u, 0x91a1u, 0xa33au, 0xb2b3u,
+        0x4a44u, 0x5bcdu, 0x6956u, 0x78dfu, 0x0c60u, 0x1de9u, 0x2f72u, 0x3efbu,
+        0xd68du, 0xc704u, 0xf59fu, 0xe416u, 0x90a9u, 0x8120u, 0xb3bbu, 0xa232u,
+        0x5ac5u, 0x4b4cu, 0x79d7u, 0x685eu, 0x1ce1u, 0x0d68u, 0x3ff3u, 0x2e7au,
+        0xe70eu, 0xf687u, 0xc41cu, 0xd595u, 0xa12au, 0xb0a3u, 0x8238u, 0x93b1u,
+        0x6b46u, 0x7acfu, 0x4854u, 0x59ddu, 0x2d62u, 0x3cebu, 0x0e70u, 0x1ff9u,
+        0xf78fu, 0xe606u, 0xd49du, 0xc514u, 0xb1abu, 0xa022u, 0x92b9u, 0x8330u,
+        0x7bc7u, 0x6a4eu, 0x58d5u, 0x495cu, 0x3de3u, 0x2c6au, 0x1ef1u, 0x0f78u
+    },
+    {
+        0x0000u, 0x19d8u, 0x33b0u, 0x2a68u, 0x6760u, 0x7eb8u, 0x54d0u, 0x4d08u,
+        0xcec0u, 0xd718u, 0xfd70u, 0xe4a8u, 0xa9a0u, 0xb078u, 0x9a10u, 0x83c8u,
+        0x9591u, 0x8c49u, 0xa621u, 0xbff9u, 0xf2f1u, 0xeb29u, 0xc141u, 0xd899u,
+        0x5b51u, 0x4289u, 0x68e1u, 0x7139u, 0x3c31u, 0x25e9u, 0x0f81u, 0x1659u,
+        0x2333u, 0x3aebu, 0x1083u, 0x095bu, 0x4453u, 0x5d8bu, 0x77e3u, 0x6e3bu,
+        0xedf3u, 0xf42bu, 0xde43u, 0xc79bu, 0x8a93u, 0x934bu, 0xb923u, 0xa0fbu,
+        0xb6a2u, 0xaf7au, 0x8512u, 0x9ccau, 0xd1c2u, 0xc81au, 0xe272u, 0xfbaau,
+        0x7862u, 0x61bau, 0x4bd2u, 0x520au, 0x1f02u, 0x06dau, 0x2cb2u, 0x356au,
+        0x4666u, 0x5fbeu, 0x75d6u, 0x6c0eu, 0x2106u, 0x38deu, 0x12b6u, 0x0b6eu,
+        0x88a6u, 0x917eu, 0xbb16u, 0xa2ceu, 0xefc6u, 0xf61eu, 0xdc76u, 0xc5aeu,
+        0xd3f7u, 0xca2fu, 0xe047u, 0xf99fu, 0xb497u, 0xad4fu, 0x8727u, 0x9effu,
+        0x1d37u, 0x04efu, 0x2e87u, 0x375fu, 0x7a57u, 0x638fu, 0x49e7u, 0x503fu,
+        0x6555u, 0x7c8du, 0x56e5u, 0x4f3du, 0x0235u, 0x1bedu, 0x3185u, 0x285du,
+        0xab95u, 0xb24du, 0x9825u, 0x81fdu, 0xccf5u, 0xd52du, 0xff45u, 0xe69du,
+        0xf0c4u, 0xe91cu, 0xc374u, 0xdaacu, 0x97a4u, 0x8e7cu, 0xa414u, 0xbdccu,
+        0x3e04u, 0x27dcu, 0x0db4u, 0x146cu, 0x5964u, 0x40bcu, 0x6ad4u, 0x730cu,
+        0x8cccu, 0x9514u, 0xbf7cu, 0xa6a4u, 0xebacu, 0xf274u, 0xd81cu, 0xc1c4u,
+        0x420cu, 0x5bd4u, 0x71bcu, 0x6864u, 0x256cu, 0x3cb4u, 0x16dcu, 0x0f04u,
+        0x195du, 0x0085u, 0x2aedu, 0x3335u, 0x7e3du, 0x67e5u, 0x4d8du, 0x5455u,
+        0xd79du, 0xce45u, 0xe42du, 0xfdf5u, 0xb0fdu, 0xa925u, 0x834du, 0x9a95u,
+        0xafffu, 0xb627u, 0x9c4fu, 0x8597u, 0xc89fu, 0xd147u, 0xfb2fu, 0xe2f7u,
+        0x613fu, 0x78e7u, 0x528fu, 0x4b57u, 0x065fu, 0x1f87u, 0x35efu, 0x2c37u,
+        0x3a6eu, 0x23b6u, 0x09deu, 0x1006u, 0x5d0eu, 0x44d6u, 0x6ebeu, 0x7766u,
+        0xf4aeu, 0xed76u, 0xc71eu, 0xdec6u, 0x93ceu, 0x8a16u, 0xa07eu, 0xb9a6u,
+        0xcaaau, 0xd372u, 0xf91au, 0xe0c2u, 0xadcau, 0xb412u, 0x9e7au, 0x87a2u,
+        0x046au, 0x1db2u, 0x37dau, 0x2e02u, 0x630au, 0x7ad2u, 0x50bau, 0x4962u,
+        0x5f3bu, 0x46e3u, 0x6c8bu, 0x7553u, 0x385bu, 0x2183u, 0x0bebu, 0x1233u,
+        0x91fbu, 0x8823u, 0xa24bu, 0xbb93u, 0xf69bu, 0xef43u, 0xc52bu, 0xdcf3u,
+        0xe999u, 0xf041u, 0xda29u, 0xc3f1u, 0x8ef9u, 0x9721u, 0xbd49u, 0xa491u,
+        0x2759u, 0x3e81u, 0x14e9u, 0x0d31u, 0x4039u, 0x59e1u, 0x7389u, 0x6a51u,
+        0x7c08u, 0x65d0u, 0x4fb8u, 0x5660u, 0x1b68u, 0x02b0u, 0x28d8u, 0x3100u,
+        0xb2c8u, 0xab10u, 0x8178u, 0x98a0u, 0xd5a8u, 0xcc70u, 0xe618u, 0xffc0u
+    },
+    {
+        0x0000u, 0x5adcu, 0xb5b8u, 0xef64u, 0x6361u, 0x39bdu, 0xd6d9u, 0x8c05u,
+        0xc6c2u, 0x9c1eu, 0x737au, 0x29a6u, 0xa5a3u, 0xff7fu, 0x101bu, 0x4ac7u,
+        0x8595u, 0xdf49u, 0x302du, 0x6af1u, 0xe6f4u, 0xbc28u, 0x534cu, 0x0990u,
+        0x4357u, 0x198bu, 0xf6efu, 0xac33u, 0x2036u, 0x7aeau, 0x958eu, 0xcf52u,
+        0x033bu, 0x59e7u, 0xb683u, 0xec5fu, 0x605au, 0x3a86u, 0xd5e2u, 0x8f3eu,
+        0xc5f9u, 0x9f25u, 0x7041u, 0x2a9du, 0xa698u, 0xfc44u, 0x1320u, 0x49fcu,
+        0x86aeu, 0xdc72u, 0x3316u, 0x69cau, 0xe5cfu, 0xbf13u, 0x5077u, 0x0aabu,
+        0x406cu, 0x1ab0u, 0xf5d4u, 0xaf08u, 0x230du, 0x79d1u, 0x96b5u, 0xcc69u,
+        0x0676u, 0x5caau, 0xb3ceu, 0xe912u, 0x6517u, 0x3fcbu, 0xd0afu, 0x8a73u,
+        0xc0b4u, 0x9a68u, 0x750cu, 0x2fd0u, 0xa3d5u, 0xf909u, 0x166du, 0x4cb1u,
+        0x83e3u, 0xd93fu, 0x365bu, 0x6c87u, 0xe082u, 0xba5eu, 0x553au, 0x0fe6u,
+        0x4521u, 0x1ffdu, 0xf099u, 0xaa45u, 0x2640u, 0x7c9cu, 0x93f8u, 0xc924u,
+        0x054du, 0x5f91u, 0xb0f5u, 0xea29u, 0x662cu, 0x3cf0u, 0xd394u, 0x8948u,
+        0xc38fu, 0x9953u, 0x7637u, 0x2cebu, 0xa0eeu, 0xfa32u, 0x1556u, 0x4f8au,
+        0x80d8u, 0xda04u, 0x3560u, 0x6fbcu, 0xe3b9u, 0xb965u, 0x5601u, 0x0cddu,
+        0x461au, 0x1cc6u, 0xf3a2u, 0xa97eu, 0x257bu, 0x7fa7u, 0x90c3u, 0xca1fu,
+        0x0cecu, 0x5630u, 0xb954u, 0xe388u, 0x6f8du, 0x3551u, 0xda35u, 0x80e9u,
+        0xca2eu, 0x90f2u, 0x7f96u, 0x254au, 0xa94fu, 0xf393u, 0x1cf7u, 0x462bu,
+        0x8979u, 0xd3a5u, 0x3cc1u, 0x661du, 0xea18u, 0xb0c4u, 0x5fa0u, 0x057cu,
+        0x4fbbu, 0x1567u, 0xfa03u, 0xa0dfu, 0x2cdau, 0x7606u, 0x9962u, 0xc3beu,
+        0x0fd7u, 0x550bu, 0xba6fu, 0xe0b3u, 0x6cb6u, 0x366au, 0xd90eu, 0x83d2u,
+        0xc915u, 0x93c9u, 0x7cadu, 0x2671u, 0xaa74u, 0xf0a8u, 0x1fccu, 0x4510u,
+        0x8a42u, 0xd09eu, 0x3ffau, 0x6526u, 0xe923u, 0xb3ffu, 0x5c9bu, 0x0647u,
+        0x4c80u, 0x165cu, 0xf938u, 0xa3e4u, 0x2fe1u, 0x753du, 0x9a59u, 0xc085u,
+        0x0a9au, 0x5046u, 0xbf22u, 0xe5feu, 0x69fbu, 0x3327u, 0xdc43u, 0x869fu,
+        0xcc58u, 0x9684u, 0x79e0u, 0x233cu, 0xaf39u, 0xf5e5u, 0x1a81u, 0x405du,
+        0x8f0fu, 0xd5d3u, 0x3ab7u, 0x606bu, 0xec6eu, 0xb6b2u, 0x59d6u, 0x030au,
+        0x49cdu, 0x1311u, 0xfc75u, 0xa6a9u, 0x2aacu, 0x7070u, 0x9f14u, 0xc5c8u,
+        0x09a1u, 0x537du, 0xbc19u, 0xe6c5u, 0x6ac0u, 0x301cu, 0xdf78u, 0x85a4u,
+        0xcf63u, 0x95bfu, 0x7adbu, 0x2007u, 0xac02u, 0xf6deu, 0x19bau, 0x4366u,
+        0x8c34u, 0xd6e8u, 0x398cu, 0x6350u, 0xef55u, 0xb589u, 0x5aedu, 0x0031u,
+        0x4af6u, 0x102au, 0xff4eu, 0xa592u, 0x2997u, 0x734bu, 0x9c2fu, 0xc6f3u
+    },
+    {
+        0x0000u, 0x1cbbu, 0x3976u, 0x25cdu, 0x72ecu, 0x6e57u, 0x4b9au, 0x5721u,
+        0xe5d8u, 0xf963u, 0xdcaeu, 0xc015u, 0x9734u, 0x8b8fu, 0xae42u, 0xb2f9u,
+        0xc3a1u, 0xdf1au, 0xfad7u, 0xe66cu, 0xb14du, 0xadf6u, 0x883bu, 0x9480u,
+        0x2679u, 0x3ac2u, 0x1f0fu, 0x03b4u, 0x5495u, 0x482eu, 0x6de3u, 0x7158u,
+        0x8f53u, 0x93e8u, 0xb625u, 0xaa9eu, 0xfdbfu, 0xe104u, 0xc4c9u, 0xd872u,
+        0x6a8bu, 0x7630u, 0x53fdu, 0x4f46u, 0x1867u, 0x04dcu, 0x2111u, 0x3daau,
+        0x4cf2u, 0x5049u, 0x7584u, 0x693fu, 0x3e1eu, 0x22a5u, 0x0768u, 0x1bd3u,
+        0xa92au, 0xb591u, 0x905cu, 0x8ce7u, 0xdbc6u, 0xc77du, 0xe2b0u, 0xfe0bu,
+        0x16b7u, 0x0a0cu, 0x2fc1u, 0x337au, 0x645bu, 0x78e0u, 0x5d2du, 0x4196u,
+        0xf36fu, 0xefd4u, 0xca19u, 0xd6a2u, 0x8183u, 0x9d38u, 0xb8f5u, 0xa44eu,
+        0xd516u, 0xc9adu, 0xec60u, 0xf0dbu, 0xa7fau, 0xbb41u, 0x9e8cu, 0x8237u,
+        0x30ceu, 0x2c75u, 0x09b8u, 0x1503u, 0x4222u, 0x5e99u, 0x7b54u, 0x67efu,
+        0x99e4u, 0x855fu, 0xa092u, 0xbc29u, 0xeb08u, 0xf7b3u, 0xd27eu, 0xcec5u,
+        0x7c3cu, 0x6087u, 0x454au, 0x59f1u, 0x0ed0u, 0x126bu, 0x37a6u, 0x2b1du,
+        0x5a45u, 0x46feu, 0x6333u, 0x7f88u, 0x28a9u, 0x3412u, 0x11dfu, 0x0d64u,
+        0xbf9du, 0xa326u, 0x86ebu, 0x9a50u, 0xcd71u, 0xd1cau, 0xf407u, 0xe8bcu,
+        0x2d6eu, 0x31d5u, 0x1418u, 0x08a3u, 0x5f82u, 0x4339u, 0x66f4u, 0x7a4fu,
+        0xc8b6u, 0xd40du, 0xf1c0u, 0xed7bu, 0xba5au, 0xa6e1u, 0x832cu, 0x9f97u,
+        0xeecfu, 0xf274u, 0xd7b9u, 0xcb02u, 0x9c23u, 0x8098u, 0xa555u, 0xb9eeu,
+        0x0b17u, 0x17acu, 0x3261u, 0x2edau, 0x79fbu, 0x6540u, 0x408du, 0x5c36u,
+        0xa23du, 0xbe86u, 0x9b4bu, 0x87f0u, 0xd0d1u, 0xcc6au, 0xe9a7u, 0xf51cu,
+        0x47e5u, 0x5b5eu, 0x7e93u, 0x6228u, 0x3509u, 0x29b2u, 0x0c7fu, 0x10c4u,
+        0x619cu, 0x7d27u, 0x58eau, 0x4451u, 0x1370u, 0x0fcbu, 0x2a06u, 0x36bdu,
+        0x8444u, 0x98ffu, 0xbd32u, 0xa189u, 0xf6a8u, 0xea13u, 0xcfdeu, 0xd365u,
+        0x3bd9u, 0x2762u, 0x02afu, 0x1e14u, 0x4935u, 0x558eu, 0x7043u, 0x6cf8u,
+        0xde01u, 0xc2bau, 0xe777u, 0xfbccu, 0xacedu, 0xb056u, 0x959bu, 0x8920u,
+        0xf878u, 0xe4c3u, 0xc10eu, 0xddb5u, 0x8a94u, 0x962fu, 0xb3e2u, 0xaf59u,
+        0x1da0u, 0x011bu, 0x24d6u, 0x386du, 0x6f4cu, 0x73f7u, 0x563au, 0x4a81u,
+        0xb48au, 0xa831u, 0x8dfcu, 0x9147u, 0xc666u, 0xdaddu, 0xff10u, 0xe3abu,
+        0x5152u, 0x4de9u, 0x6824u, 0x749fu, 0x23beu, 0x3f05u, 0x1ac8u, 0x0673u,
+        0x772bu, 0x6b90u, 0x4e5du, 0x52e6u, 0x05c7u, 0x197cu, 0x3cb1u, 0x200au,
+        0x92f3u, 0x8e48u, 0xab85u, 0xb73eu, 0xe01fu, 0xfca4u, 0xd969u, 0xc5d2u
+    }
+};
+
+#endif /* (CRC16_METHOD == CRC16_METHOD_NIBBLE) */
+
+
+/*******************************************************************************
+* Function Name: Crc16Update
+********************************************************************************
+*
+* Summary:
+*   Continues the CRC calculation over the next part of a message.
+*
+* Parameters:
+*   crc    - CRC16_CCITT_SEED for the first part of a message or the value
+*            returned for the previous part.
+*   buffer - the data.
+*   size   - the number of bytes in the buffer.
+*
+* Return:
+*   uint16 - the CRC of the message up to the end of the buffer.
+*
+*******************************************************************************/
+uint16 Crc16Update(uint16 crc, const uint8 buffer[], uint32 size)
+{
+    uint32 i = 0u;
+
+#if(CRC16_METHOD == CRC16_METHOD_NIBBLE)
+
+    for(; i < size; i++)
+    {
+        crc ^= buffer[i];
+        crc = (crc >> 4u) ^ crc16Table[crc & 0x0fu];
+        crc = (crc >> 4u) ^ crc16Table[crc & 0x0fu];
+    }
+
+#elif(CRC16_METHOD == CRC16_METHOD_BYTE)
+
+    for(; i < size; i++)
+    {
+        crc = (crc >> 8u) ^ crc16Table[(crc ^ buffer[i]) & 0xffu];
+    }
+
+#else
+
+    /* Bytes are read one by one, the buffer does not have to be aligned */
+    for(; (i + 4u) <= size; i += 4u)
+    {
+        crc ^= (uint16)buffer[i] | (uint16)((uint16)buffer[i + 1u] << 8u);
+        crc = crc16Table[3u][crc & 0xffu] ^ crc16Table[2u][crc >> 8u] ^
+              crc16Table[1u][buffer[i + 2u]] ^ crc16Table[0u][buffer[i + 3u]];
+    }
+
+    for(; i < size; i++)
+    {
+        crc = (crc >> 8u) ^ crc16Table[0u][(crc ^ buffer[i]) & 0xffu];
+    }
+
+#endif /* (CRC16_METHOD == CRC16_METHOD_NIBBLE) */
+
+    return(crc);
+}
+
+
+/*******************************************************************************
+* Function Name: Crc16
+********************************************************************************
+*
+* Summary:
+*   Calculates the CRC of a message.
+*
+* Parameters:
+*   buffer - the message.
+*   size   - the number of bytes in the message.
+*
+* Return:
+*   uint16 - the CRC.
+*
+*******************************************************************************/
+uint16 Crc16(const uint8 buffer[], uint32 size)
+{
+    return(Crc16Update(CRC16_CCITT_SEED, buffer, size));
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,50 @@
+/*******************************************************************************
+* File Name: crc16.h
+*
+* Version 1.0
+*
+* Description:
+*  Contains the function prototypes and constants of the CRC-CCITT module.
+*
+* Hardware Dependency:
+*  CY8CKIT-042 BLE
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(CRC16_H)
+#define CRC16_H
+
+#include "cytypes.h"
+
+
+/***************************************
+*        Constants
+***************************************/
+#define CRC16_CCITT_SEED            (0xffffu)   /* CRC-CCITT initial seed value */
+#define CRC16_CCITT_POLY            (0x8408u)   /* D16+D12+D5+1 in reverse order */
+
+/* Table lookup methods, selected by CRC16_METHOD */
+#define CRC16_METHOD_NIBBLE         (0u)        /* 16-entry table, two lookups per byte, 32 bytes of flash */
+#define CRC16_METHOD_BYTE           (1u)        /* 256-entry table, one lookup per byte, 512 bytes of flash */
+#define CRC16_METHOD_SLICE4         (2u)        /* 4 x 256-entry tables, four bytes per step, 2 KB of flash */
+
+#if !defined(CRC16_METHOD)
+    #define CRC16_METHOD            (CRC16_METHOD_BYTE)
+#endif /* !defined(CRC16_METHOD) */
+
+
+/***************************************
+*      API Function Prototypes
+***************************************/
+uint16 Crc16Update(uint16 crc, const uint8 buffer[], uint32 size);
+uint16 Crc16(const uint8 buffer[], uint32 size);
+
+
+#endif /* CRC16_H */
+
+/* [] END OF FILE */
@@ -27,7 +27,9 @@
 /***************************************
 * Conditional Compilation Parameters
 ***************************************/
-#define DEBUG_UART_ENABLED                  ENABLED
+#if !defined(DEBUG_UART_ENABLED)
+    #define DEBUG_UART_ENABLED              ENABLED
+#endif /* !defined(DEBUG_UART_ENABLED) */
 
 /***************************************
 * Conditional Compilation Parameters
@@ -380,6 +380,8 @@ CY_ISR(Timer_Interrupt)
         led ^= LED_OFF;
         Advertising_LED_Write(led);
     }
+
+    NTF_STAT_TICK();
 }
 
 /*******************************************************************************
@@ -622,6 +624,7 @@ int main()
         {   
             /* Process CGMS actions when device in connection */
             CgmsProcess();
+            NTF_STAT_PROCESS();
             
 		/*******************************************************************
         *  Authentication procdure handling
@@ -643,6 +646,12 @@ int main()
             /* Process BMS actions when device is disconnected */
 			BmsProcess();
         }
+        
+        /* Write the deleted record marks to flash one row at a time */
+        if(CyBle_GattGetBusyStatus() == CYBLE_STACK_STATE_FREE)
+        {
+            (void)RecLogSync();
+        }
     }
 }
 
@@ -25,6 +25,9 @@
 /* Profile specific includes */
 #include "cgmss.h"
 #include "bmss.h"
+#include "crc16.h"
+#include "reclog.h"
+#include "ntfstat.h"
 
 /*******************************************************************************
 * Enumerations
@@ -33,6 +33,11 @@
 ***************************************/
 #define DEBUG_UART_ENABLED          ENABLED
 
+/* Sends the debug output as binary trace records, see trace.h. The output
+*  is decoded on the host with trace_decode.py.
+*/
+#define DEBUG_TRACE_ENABLED         DISABLED
+
 
 /***************************************
 *           API Constants
@@ -71,11 +76,14 @@ void Set32ByPtr(uint8 ptr[], uint32 value);
     #define DBG_PRINTF(...)
 #endif /* (DEBUG_UART_ENABLED == ENABLED) */
 
+#include "trace.h"
+
 
 /***************************************
 * External data references
 ***************************************/
 extern CYBLE_CONN_HANDLE_T connHandle;
 extern volatile uint32 mainTimer;
+extern uint16 attMtu;
 
 /* [] END OF FILE */
@@ -30,6 +30,22 @@ CYBLE_CPS_POWER_VECTOP_T powerVector;
 */
 uint8 powerCPData[CYBLE_GATT_DEFAULT_MTU - 2u] = {3, CYBLE_CPS_CP_OC_RC, CYBLE_CPS_CP_OC_SCV, CYBLE_CPS_CP_RC_SUCCESS};
 
+/* uint8 CpsPackPowerMeasure(uint8 pdu[], const CYBLE_CPS_POWER_MEASURE_T *value, uint32 flags) */
+PDU_DEFINE_PACK(CpsPackPowerMeasure, CYBLE_CPS_POWER_MEASURE_T, CPS_POWER_MEASURE_FIELDS)
+
+/* uint8 CpsPackPowerVector(uint8 pdu[], const CYBLE_CPS_POWER_VECTOP_T *value, uint32 flags) */
+PDU_DEFINE_PACK(CpsPackPowerVector, CYBLE_CPS_POWER_VECTOP_T, CPS_POWER_VECTOR_FIELDS)
+
+/* Presence flags of the optional Power Measurement fields the simulation supports, in the PDU order */
+static const uint16 cpsPowerMeasureParts[] =
+{
+    CYBLE_CPS_CPM_TORQUE_PRESENT_BIT,
+    CYBLE_CPS_CPM_WHEEL_BIT,
+    CYBLE_CPS_CPM_ENERGY_BIT
+};
+
+#define CPS_POWER_MEASURE_PARTS     (sizeof(cpsPowerMeasureParts) / sizeof(cpsPowerMeasureParts[0u]))
+
 
 /*******************************************************************************
 * Function Name: CpsCallBack()
@@ -461,6 +477,63 @@ void CpsInit(void)
 }
 
 
+/*******************************************************************************
+* Function Name: CpsNotifyPowerMeasure()
+********************************************************************************
+*
+* Summary:
+*   Notifies the Cycling Power Measurement. A measurement longer than the
+*   exchanged ATT MTU - 3 is split in several notifications: every one
+*   carries the flags and the Instantaneous Power, and its flags tell which
+*   of the optional fields follow. Any optional field fits the default MTU
+*   together with the mandatory ones.
+*
+* Return:
+*   The result of the last CyBle_CpssSendNotification() call.
+*
+*******************************************************************************/
+static CYBLE_API_RESULT_T CpsNotifyPowerMeasure(void)
+{
+    CYBLE_API_RESULT_T apiResult = CYBLE_ERROR_OK;
+    uint8 powerMeasureData[CPS_POWER_MEASURE_DATA_MAX_SIZE];
+    uint16 flags = powerMeasure.flags & CPS_POWER_MEASURE_FLAGS_MASK;
+    uint16 base = flags;        /* The flags that select no field */
+    uint16 part;
+    uint8 length;
+    uint8 i;
+
+    for(i = 0u; i < CPS_POWER_MEASURE_PARTS; i++)
+    {
+        base &= (uint16)~cpsPowerMeasureParts[i];
+    }
+
+    part = base;
+    for(i = 0u; (i < CPS_POWER_MEASURE_PARTS) && (apiResult == CYBLE_ERROR_OK); i++)
+    {
+        if((flags & cpsPowerMeasureParts[i]) != 0u)
+        {
+            /* Send the fields collected so far when the next one does not fit */
+            if((part != base) && 
+               (CpsPackPowerMeasure(powerMeasureData, &powerMeasure, part | cpsPowerMeasureParts[i]) > (attMtu - 3u)))
+            {
+                length = CpsPackPowerMeasure(powerMeasureData, &powerMeasure, part);
+                apiResult = CyBle_CpssSendNotification(cyBle_connHandle, CYBLE_CPS_POWER_MEASURE, length, powerMeasureData);
+                part = base;
+            }
+            part |= cpsPowerMeasureParts[i];
+        }
+    }
+
+    if(apiResult == CYBLE_ERROR_OK)
+    {
+        length = CpsPackPowerMeasure(powerMeasureData, &powerMeasure, part);
+        apiResult = CyBle_CpssSendNotification(cyBle_connHandle, CYBLE_CPS_POWER_MEASURE, length, powerMeasureData);
+    }
+
+    return(apiResult);
+}
+
+
 /*******************************************************************************
 * Function Name: SimulateCyclingPower()
 ********************************************************************************
@@ -475,46 +548,21 @@ void SimulateCyclingPower(void)
     
     if(CyBle_GattGetBusyStatus() == CYBLE_STACK_STATE_FREE)
     {
-        uint8 powerMeasureData[CYBLE_GATT_DEFAULT_MTU - 3];
-        uint8 length = 0;
+        uint8 powerMeasureData[CPS_POWER_MEASURE_DATA_MAX_SIZE];
+        uint8 length;
         
-        /* Prepare data array */
-        CyBle_Set16ByPtr(powerMeasureData, (CYBLE_CPS_CPM_TORQUE_PRESENT_BIT |
-                                            CYBLE_CPS_CPM_TORQUE_SOURCE_BIT |
-                                            CYBLE_CPS_CPM_WHEEL_BIT |
-                                            CYBLE_CPS_CPM_ENERGY_BIT) & powerMeasure.flags);
-        length += sizeof(powerMeasure.flags);
-        CyBle_Set16ByPtr(powerMeasureData + length, powerMeasure.instantaneousPower);
-        length += sizeof(powerMeasure.instantaneousPower);
-        if((CYBLE_CPS_CPM_TORQUE_PRESENT_BIT & powerMeasure.flags) != 0u)
-        {
-            CyBle_Set16ByPtr(powerMeasureData + length, powerMeasure.accumulatedTorque);
-            length += sizeof(uint16);
-            CyBle_Set16ByPtr(powerMeasureData + length, (uint16)powerMeasure.cumulativeWheelRevolutions);
-            CyBle_Set16ByPtr(powerMeasureData + length+2, (uint16)(powerMeasure.cumulativeWheelRevolutions >> 16u));
-            length += sizeof(powerMeasure.cumulativeWheelRevolutions);
-            CyBle_Set16ByPtr(powerMeasureData + length, powerMeasure.lastWheelEventTime);
-            length += sizeof(powerMeasure.lastWheelEventTime);
-        }
-        if((CYBLE_CPS_CPM_ENERGY_BIT & powerMeasure.flags) != 0u)
-        {
-            CyBle_Set16ByPtr(powerMeasureData + length, powerMeasure.accumulatedEnergy);
-            length += sizeof(uint16);
-        }
-            
         /* Send data */
         if((powerSimulation & CPS_NOTIFICATION_MEASURE_ENABLE) != 0u)
         {
-            apiResult = CyBle_CpssSendNotification(cyBle_connHandle, CYBLE_CPS_POWER_MEASURE, length, powerMeasureData);
-            DBG_PRINTF("CpssSendNotification POWER_MEASURE, Power: %d W, ", powerMeasure.instantaneousPower);
-            DBG_PRINTF("Torque: %ld, Wheel Revolution: %ld, Time: %d s, Speed: %3.2f km/h, ", 
+            apiResult = CpsNotifyPowerMeasure();
+            DBG_TRACE(TRACE_CPS_MEASURE, powerMeasure.instantaneousPower,
                 powerMeasure.accumulatedTorque / 32u,
                 powerMeasure.cumulativeWheelRevolutions,
                 powerMeasure.lastWheelEventTime / CPS_WHEEL_EVENT_TIME_PER_SEC,
-                (float)CPS_SIM_CUMULATIVE_WHEEL_REVOLUTION_INCREMENT * CPS_WHEEL_CIRCUMFERENCE /
-                CPS_SIM_WHEEL_EVENT_TIME_INCREMENT * CPS_WHEEL_EVENT_TIME_PER_SEC * CPS_SEC_IN_HOUR
+                TRACE_FLOAT((float)CPS_SIM_CUMULATIVE_WHEEL_REVOLUTION_INCREMENT * CPS_WHEEL_CIRCUMFERENCE /
+                CPS_SIM_WHEEL_EVENT_TIME_INCREMENT * CPS_WHEEL_EVENT_TIME_PER_SEC * CPS_SEC_IN_HOUR),
+                powerMeasure.accumulatedEnergy
             );
-            DBG_PRINTF("Energy: %ld kJ \r\n", powerMeasure.accumulatedEnergy);
             
             if((apiResult != CYBLE_ERROR_OK))
             {
@@ -524,6 +572,7 @@ void SimulateCyclingPower(void)
         
         if((powerSimulation & CPS_BROADCAST_ENABLE) != 0u)
         {
+            length = CpsPackPowerMeasure(powerMeasureData, &powerMeasure, powerMeasure.flags & CPS_POWER_MEASURE_FLAGS_MASK);
             apiResult = CyBle_CpssStartBroadcast(CYBLE_GAP_ADV_ADVERT_INTERVAL_NONCON_MIN, length, powerMeasureData);
             DBG_PRINTF("CyBle_CpssStartBroadcast, API result: %x \r\n", apiResult);
         }
@@ -531,18 +580,11 @@ void SimulateCyclingPower(void)
         if((powerSimulation & CPS_NOTIFICATION_VECTOR_ENABLE) != 0u)
         {
             uint8 powerVectorData[CPS_POWER_VECTOR_DATA_MAX_SIZE];
-            length = 0;
-            
-            CyBle_Set16ByPtr(powerVectorData,  powerVector.flags);
-            length += sizeof(powerVector.flags);
-            CyBle_Set16ByPtr(powerVectorData + length, powerVector.cumulativeCrankRevolutions);
-            length += sizeof(powerVector.cumulativeCrankRevolutions);
-            CyBle_Set16ByPtr(powerVectorData + length, powerVector.lastCrankEventTime);
-            length += sizeof(powerVector.lastCrankEventTime);
+            length = CpsPackPowerVector(powerVectorData, &powerVector, powerVector.flags);
 
             apiResult = CyBle_CpssSendNotification(cyBle_connHandle, CYBLE_CPS_POWER_VECTOR, length , powerVectorData);
-            DBG_PRINTF("CpssSendNotification POWER_VECTOR, Crank Revolution: %d W, ", powerVector.cumulativeCrankRevolutions);
-            DBG_PRINTF("Time: %d s, Cadence: %d rpm \r\n", powerVector.lastCrankEventTime / CPS_CRANK_EVENT_TIME_PER_SEC,
+            DBG_TRACE(TRACE_CPS_VECTOR, powerVector.cumulativeCrankRevolutions,
+                powerVector.lastCrankEventTime / CPS_CRANK_EVENT_TIME_PER_SEC,
                 CPS_SIM_CUMULATIVE_CRANK_REVOLUTION_INCREMENT / (CPS_SIM_CRANK_EVENT_TIME_INCREMENT / CPS_CRANK_EVENT_TIME_PER_SEC)
             );
             if((apiResult != CYBLE_ERROR_OK))
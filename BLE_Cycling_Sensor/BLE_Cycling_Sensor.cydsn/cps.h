@@ -15,6 +15,7 @@
 *******************************************************************************/
 
 #include <project.h>
+#include "pdu.h"
 
 
 /***************************************
@@ -38,6 +39,27 @@ CYBLE_CYPACKED typedef struct
     uint16 lastCrankEventTime;          /* Unit is in seconds with a resolution of 1/1024 */
 }CYBLE_CYPACKED_ATTR CYBLE_CPS_POWER_VECTOP_T;
 
+/* Fields of the Cycling Power Measurement, see pdu.h */
+#define CPS_POWER_MEASURE_FIELDS(FIELD) \
+    FIELD(0u,                               0u,                                 FLAGS16,    flags) \
+    FIELD(0u,                               0u,                                 U16,        instantaneousPower) \
+    FIELD(CYBLE_CPS_CPM_TORQUE_PRESENT_BIT, CYBLE_CPS_CPM_TORQUE_PRESENT_BIT,   U16,        accumulatedTorque) \
+    FIELD(CYBLE_CPS_CPM_WHEEL_BIT,          CYBLE_CPS_CPM_WHEEL_BIT,            U32,        cumulativeWheelRevolutions) \
+    FIELD(CYBLE_CPS_CPM_WHEEL_BIT,          CYBLE_CPS_CPM_WHEEL_BIT,            U16,        lastWheelEventTime) \
+    FIELD(CYBLE_CPS_CPM_ENERGY_BIT,         CYBLE_CPS_CPM_ENERGY_BIT,           U16,        accumulatedEnergy)
+
+/* Flags of the Cycling Power Measurement that the simulation supports */
+#define CPS_POWER_MEASURE_FLAGS_MASK                (CYBLE_CPS_CPM_TORQUE_PRESENT_BIT | \
+                                                     CYBLE_CPS_CPM_TORQUE_SOURCE_BIT | \
+                                                     CYBLE_CPS_CPM_WHEEL_BIT | \
+                                                     CYBLE_CPS_CPM_ENERGY_BIT)
+
+/* Fields of the Cycling Power Vector, see pdu.h */
+#define CPS_POWER_VECTOR_FIELDS(FIELD) \
+    FIELD(0u,                               0u,                                 FLAGS8,     flags) \
+    FIELD(0u,                               0u,                                 U16,        cumulativeCrankRevolutions) \
+    FIELD(0u,                               0u,                                 U16,        lastCrankEventTime)
+
 
 /***************************************
 *          Constants
@@ -51,6 +73,14 @@ CYBLE_CYPACKED typedef struct
 #define CPS_POWER_MEASURE_DATA_MAX_SIZE             (35u)
 #define CPS_POWER_VECTOR_DATA_MAX_SIZE              (12u)
 
+/* The MtuSize of the BLE component fits the longest Power Measurement in one notification.
+*  A client that exchanges a smaller MTU gets the measurement split in several
+*  notifications, see CpsNotifyPowerMeasure().
+*/
+#if (CYBLE_GATT_MTU < (CPS_POWER_MEASURE_DATA_MAX_SIZE + 3u))
+    #error "The MtuSize of the BLE component is too small for the Cycling Power Measurement"
+#endif /* (CYBLE_GATT_MTU < (CPS_POWER_MEASURE_DATA_MAX_SIZE + 3u)) */
+
 #define CPS_SIMULATION_DISABLE                      (0u)
 #define CPS_NOTIFICATION_MEASURE_ENABLE             (1u)
 #define CPS_NOTIFICATION_VECTOR_ENABLE              (2u)
@@ -392,13 +392,9 @@ void SimulateCyclingSpeed(void)
 
         if(CYBLE_ERROR_OK == apiResult)
         {
-            DBG_PRINTF("CscssSendNotification, ");
-            DBG_PRINTF("Wheel Revolution: %ld, ", wheelRev);
-            DBG_PRINTF("Wheel Time: %ld s, ", lastWheelEvTime / CSC_TIME_PER_SEC);
-            DBG_PRINTF("Crank Revolution: %ld, ", crankRev);
-            DBG_PRINTF("Crank Time: %ld s, ", lastCrankEvTime / CSC_TIME_PER_SEC);
-            DBG_PRINTF("Speed: %d.%2.2d km/h, ", cscSpeed/100u, cscSpeed%100u);
-            DBG_PRINTF("Cadence: %d rpm\r\n", cscCadenceRpm);
+            DBG_TRACE(TRACE_CSCS_MEASURE, wheelRev, lastWheelEvTime / CSC_TIME_PER_SEC,
+                crankRev, lastCrankEvTime / CSC_TIME_PER_SEC,
+                cscSpeed/100u, cscSpeed%100u, cscCadenceRpm);
         }
         else
         {
@@ -21,6 +21,13 @@
 
 #if (DEBUG_UART_ENABLED == ENABLED)
 
+/* The output goes to the trace buffer instead of the UART in trace mode */
+#if (DEBUG_TRACE_ENABLED == ENABLED)
+    #define DEBUG_PUT_CHAR(ch)      (TracePutChar((uint8)(ch)))
+#else
+    #define DEBUG_PUT_CHAR(ch)      (UART_DEB_UartPutChar(ch))
+#endif /* (DEBUG_TRACE_ENABLED == ENABLED) */
+
 #if defined(__ARMCC_VERSION)
     
 /* For MDK/RVDS compiler revise fputc function for printf functionality */
@@ -47,7 +54,7 @@ int fputc(int ch, FILE *file)
     switch( file->handle )
     {
         case STDOUT_HANDLE:
-            UART_DEB_UartPutChar(ch);
+            DEBUG_PUT_CHAR(ch);
             ret = ch ;
             break ;
 
@@ -81,7 +88,7 @@ size_t __write(int handle, const unsigned char * buffer, size_t size)
 
     for (/* Empty */; size != 0; --size)
     {
-        UART_DEB_UartPutChar(*buffer++);
+        DEBUG_PUT_CHAR(*buffer++);
         ++nChars;
     }
 
@@ -97,7 +104,7 @@ int _write(int file, char *ptr, int len)
     file = file;
     for (i = 0; i < len; i++)
     {
-        UART_DEB_UartPutChar(*ptr++);
+        DEBUG_PUT_CHAR(*ptr++);
     }
     return len;
 }
@@ -28,6 +28,7 @@
 #include "cscs.h"
 
 volatile uint32 mainTimer = 0;
+uint16 attMtu = CYBLE_GATT_DEFAULT_MTU;     /* ATT MTU of the connection */
 
 
 /*******************************************************************************
@@ -115,9 +116,12 @@ void AppCallback(uint32 event, void* eventParam)
                 DBG_PRINTF("Hibernate \r\n");
                 Advertising_LED_Write(LED_OFF);
                 Disconnect_LED_Write(LED_ON);
-            #if (DEBUG_UART_ENABLED == ENABLED)
+            #if (DEBUG_UART_ENABLED == ENABLED) && (DEBUG_TRACE_ENABLED == ENABLED)
+                /* The RAM of the trace is not retained in Hibernate mode */
+                TraceFlush();
+            #elif (DEBUG_UART_ENABLED == ENABLED)
                 while((UART_DEB_SpiUartGetTxBufferSize() + UART_DEB_GET_TX_FIFO_SR_VALID) != 0);
-            #endif /* (DEBUG_UART_ENABLED == ENABLED) */
+            #endif /* (DEBUG_UART_ENABLED == ENABLED) && (DEBUG_TRACE_ENABLED == ENABLED) */
                 SW2_ClearInterrupt();
                 Wakeup_Interrupt_ClearPending();
                 Wakeup_Interrupt_Start();
@@ -152,6 +156,8 @@ void AppCallback(uint32 event, void* eventParam)
         ***********************************************************/
         case CYBLE_EVT_GATT_CONNECT_IND:
             DBG_PRINTF("CYBLE_EVT_GATT_CONNECT_IND: %x, %x \r\n", cyBle_connHandle.attId, cyBle_connHandle.bdHandle);
+            /* Every connection starts with the default MTU until the client exchanges it */
+            attMtu = CYBLE_GATT_DEFAULT_MTU;
             break;
         case CYBLE_EVT_GATT_DISCONNECT_IND:
             DBG_PRINTF("CYBLE_EVT_GATT_DISCONNECT_IND \r\n");
@@ -161,6 +167,14 @@ void AppCallback(uint32 event, void* eventParam)
             ShowValue(&((CYBLE_GATTS_WRITE_REQ_PARAM_T *)eventParam)->handleValPair.value);
             (void)CyBle_GattsWriteRsp(((CYBLE_GATTS_WRITE_REQ_PARAM_T *)eventParam)->connHandle);
             break;
+        case CYBLE_EVT_GATTS_XCNHG_MTU_REQ:
+            /* The stack has responded with the MTU of the component, the smaller one is used */
+            if(CYBLE_ERROR_OK != CyBle_GattGetMtuSize(&attMtu))
+            {
+                attMtu = CYBLE_GATT_DEFAULT_MTU;
+            }
+            DBG_PRINTF("CYBLE_EVT_GATTS_XCNHG_MTU_REQ, mtu: %d \r\n", attMtu);
+            break;
         case CYBLE_EVT_GATTS_INDICATION_ENABLED:
             DBG_PRINTF("CYBLE_EVT_GATTS_INDICATION_ENABLED \r\n");
             break;
@@ -217,6 +231,10 @@ CY_ISR(Timer_Interrupt)
         
         /* Indicate that timer is raised to the main loop */
         mainTimer++;
+
+    #if (DEBUG_UART_ENABLED == ENABLED) && (DEBUG_TRACE_ENABLED == ENABLED)
+        TraceTick();
+    #endif /* (DEBUG_UART_ENABLED == ENABLED) && (DEBUG_TRACE_ENABLED == ENABLED) */
         
         /* Clears interrupt request  */
         CySysWdtClearInterrupt(WDT_INTERRUPT_SOURCE);
@@ -392,6 +410,11 @@ int main()
         /* To achieve low power in the device */
         LowPowerImplementation();
 
+    #if (DEBUG_UART_ENABLED == ENABLED) && (DEBUG_TRACE_ENABLED == ENABLED)
+        /* Send the buffered debug output in batches */
+        TraceProcess();
+    #endif /* (DEBUG_UART_ENABLED == ENABLED) && (DEBUG_TRACE_ENABLED == ENABLED) */
+
         /***********************************************************************
         * Wait for connection established with Central device
         ***********************************************************************/
@@ -0,0 +1,353 @@
+/*******************************************************************************
+* File Name: trace.c
+*
+* Version 1.0
+*
+* Description:
+*  This file contains the deferred binary trace. Messages and the printf()
+*  text are appended to a ring buffer as records and sent over the debug UART
+*  in batches, so the UART is idle most of the time and the device can enter
+*  Deep-Sleep between the batches. A message takes a few microseconds to
+*  store, no matter how long its formatted text is.
+*
+*  Consecutive printf() characters are merged into one text record while
+*  the record is not being sent.
+*
+* Hardware Dependency:
+*  CY8CKIT-042 BLE
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include "common.h"
+#include <stdarg.h>
+
+#if (DEBUG_UART_ENABLED == ENABLED) && (DEBUG_TRACE_ENABLED == ENABLED)
+
+#define TRACE_MASK                  (TRACE_BUF_SIZE - 1u)
+#define TRACE_USED                  ((uint16)(traceHead - traceTail))
+
+#define TRACE_TEXT_CLOSED           (0u)
+#define TRACE_TEXT_OPEN             (1u)        /* Characters are appended to the record */
+#define TRACE_TEXT_DROP             (2u)        /* Characters are dropped, counted as one record */
+
+static uint8 traceBuf[TRACE_BUF_SIZE];
+static uint16 traceHead = 0u;               /* Free-running write index */
+static uint16 traceTail = 0u;               /* Free-running read index */
+static uint16 traceText = 0u;               /* Start of the open text record */
+static uint8 traceTextState = TRACE_TEXT_CLOSED;
+static uint8 traceDump = 0u;                /* Drain until the buffer is empty */
+static uint32 traceLost = 0u;               /* Records dropped since the last stored one */
+static volatile uint32 traceTime = 0u;      /* LFCLK ticks at the last WDT period */
+
+
+/*******************************************************************************
+* Function Name: TracePut32
+********************************************************************************
+*
+* Summary:
+*   Stores a 32-bit word to the ring buffer. The caller checks for room.
+*
+* Parameters:
+*   value - the word to store.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+static void TracePut32(uint32 value)
+{
+    traceBuf[traceHead & TRACE_MASK] = (uint8)value;
+    traceBuf[(traceHead + 1u) & TRACE_MASK] = (uint8)(value >> ONE_BYTE_SHIFT);
+    traceBuf[(traceHead + 2u) & TRACE_MASK] = (uint8)(value >> TWO_BYTES_SHIFT);
+    traceBuf[(traceHead + 3u) & TRACE_MASK] = (uint8)(value >> THREE_BYTES_SHIFT);
+    traceHead += 4u;
+}
+
+
+/*******************************************************************************
+* Function Name: TraceReserve
+********************************************************************************
+*
+* Summary:
+*   Checks that a record fits into the ring buffer and starts it. If records
+*   were dropped before, a TRACE_LOST message is stored first. The caller
+*   counts the record as lost if it does not fit.
+*   Must be called within a critical section.
+*
+* Parameters:
+*   id   - the record ID.
+*   size - the record size, including the header.
+*
+* Return:
+*   Non-zero if the record is started.
+*
+*******************************************************************************/
+static uint8 TraceReserve(uint8 id, uint16 size)
+{
+    uint16 lostSize = (0u != traceLost) ? (TRACE_HDR_SIZE + TRACE_TIME_SIZE + 4u) : 0u;
+    uint8 fit = 0u;
+
+    if((TRACE_USED + lostSize + size) <= TRACE_BUF_SIZE)
+    {
+        if(0u != traceLost)
+        {
+            traceBuf[traceHead++ & TRACE_MASK] = TRACE_SYNC;
+            traceBuf[traceHead++ & TRACE_MASK] = TRACE_LOST;
+            traceBuf[traceHead++ & TRACE_MASK] = 1u;
+            TracePut32(traceTime);
+            TracePut32(traceLost);
+            traceLost = 0u;
+        }
+
+        traceBuf[traceHead++ & TRACE_MASK] = TRACE_SYNC;
+        traceBuf[traceHead++ & TRACE_MASK] = id;
+        fit = 1u;
+    }
+
+    return(fit);
+}
+
+
+/*******************************************************************************
+* Function Name: TraceWrite
+********************************************************************************
+*
+* Summary:
+*   Stores a message with its arguments. Use the DBG_TRACE() macro instead of
+*   calling it directly. If the ring buffer is full, the message is dropped.
+*
+* Parameters:
+*   id   - the message ID.
+*   argc - the number of arguments, up to TRACE_ARGS_MAX.
+*   ...  - the arguments, each no wider than 32 bits.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void TraceWrite(uint8 id, uint8 argc, ...)
+{
+    va_list args;
+    uint32 now;
+    uint8 interruptStatus;
+    uint8 i;
+
+    interruptStatus = CyEnterCriticalSection();
+
+    /* The counter is cleared on match before the interrupt updates traceTime */
+    now = traceTime + CySysWdtReadCount(WDT_COUNTER);
+    if(0u != (CySysWdtGetInterruptSource() & WDT_INTERRUPT_SOURCE))
+    {
+        now += (uint32)WDT_1SEC + 1u;
+    }
+
+    if(0u != TraceReserve(id, TRACE_HDR_SIZE + TRACE_TIME_SIZE + ((uint16)argc * 4u)))
+    {
+        traceBuf[traceHead++ & TRACE_MASK] = argc;
+        TracePut32(now);
+
+        va_start(args, argc);
+        for(i = 0u; i < argc; i++)
+        {
+            TracePut32(va_arg(args, uint32));
+        }
+        va_end(args);
+
+        traceTextState = TRACE_TEXT_CLOSED;
+    }
+    else
+    {
+        traceLost++;
+    }
+
+    CyExitCriticalSection(interruptStatus);
+}
+
+
+/*******************************************************************************
+* Function Name: TracePutChar
+********************************************************************************
+*
+* Summary:
+*   Stores a character of the printf() output.
+*
+* Parameters:
+*   ch - the character.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void TracePutChar(uint8 ch)
+{
+    uint8 interruptStatus;
+
+    interruptStatus = CyEnterCriticalSection();
+
+    if((TRACE_TEXT_OPEN == traceTextState) && (traceBuf[(traceText + 2u) & TRACE_MASK] < TRACE_TEXT_MAX) &&
+       (TRACE_USED < TRACE_BUF_SIZE))
+    {
+        traceBuf[(traceText + 2u) & TRACE_MASK]++;
+        traceBuf[traceHead++ & TRACE_MASK] = ch;
+    }
+    else if(0u != TraceReserve(TRACE_TEXT, TRACE_HDR_SIZE + 1u))
+    {
+        traceText = traceHead - 2u;
+        traceTextState = TRACE_TEXT_OPEN;
+        traceBuf[traceHead++ & TRACE_MASK] = 1u;
+        traceBuf[traceHead++ & TRACE_MASK] = ch;
+    }
+    else if(TRACE_TEXT_DROP != traceTextState)
+    {
+        traceTextState = TRACE_TEXT_DROP;
+        traceLost++;
+    }
+    else
+    {
+        /* The text is already counted as lost */
+    }
+
+    CyExitCriticalSection(interruptStatus);
+}
+
+
+/*******************************************************************************
+* Function Name: TraceFloat
+********************************************************************************
+*
+* Summary:
+*   Converts a floating point argument to the 32-bit word that is stored.
+*
+* Parameters:
+*   value - the argument.
+*
+* Return:
+*   uint32 - the IEEE 754 single precision bits of the value.
+*
+*******************************************************************************/
+uint32 TraceFloat(float value)
+{
+    uint32 bits;
+
+    (void)memcpy(&bits, &value, sizeof(bits));
+
+    return(bits);
+}
+
+
+/*******************************************************************************
+* Function Name: TraceTick
+********************************************************************************
+*
+* Summary:
+*   Advances the time stamp base. Called from the WDT interrupt once every
+*   WDT period.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void TraceTick(void)
+{
+    traceTime += (uint32)WDT_1SEC + 1u;
+}
+
+
+/*******************************************************************************
+* Function Name: TraceProcess
+********************************************************************************
+*
+* Summary:
+*   Sends buffered records over the debug UART without waiting. Draining
+*   starts when TRACE_DRAIN_LEVEL bytes are buffered or, with
+*   TRACE_DRAIN_ON_RX, when any character is received from the host, and
+*   stops when the buffer is empty. The received characters are discarded.
+*   Should be called from the main loop.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void TraceProcess(void)
+{
+    uint8 interruptStatus;
+
+#if (0u != TRACE_DRAIN_ON_RX)
+    if(0u != UART_DEB_UartGetChar())
+    {
+        traceDump = 1u;
+    }
+#endif /* (0u != TRACE_DRAIN_ON_RX) */
+
+    if(TRACE_USED >= TRACE_DRAIN_LEVEL)
+    {
+        traceDump = 1u;
+    }
+
+    while((0u != traceDump) && (UART_DEB_SpiUartGetTxBufferSize() < UART_DEB_SPI_UART_FIFO_SIZE))
+    {
+        interruptStatus = CyEnterCriticalSection();
+
+        if(traceHead == traceTail)
+        {
+            traceDump = 0u;
+        }
+        else
+        {
+            /* A text record can't grow once its sending has started */
+            if((TRACE_TEXT_OPEN == traceTextState) && (traceTail == traceText))
+            {
+                traceTextState = TRACE_TEXT_CLOSED;
+            }
+            UART_DEB_SpiUartWriteTxData(traceBuf[traceTail & TRACE_MASK]);
+            traceTail++;
+        }
+
+        CyExitCriticalSection(interruptStatus);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: TraceFlush
+********************************************************************************
+*
+* Summary:
+*   Sends all the buffered records and waits until they are transmitted.
+*   Used before a reset or when the output is needed at once.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void TraceFlush(void)
+{
+    traceDump = 1u;
+    while(traceHead != traceTail)
+    {
+        TraceProcess();
+    }
+
+    while((UART_DEB_SpiUartGetTxBufferSize() + UART_DEB_GET_TX_FIFO_SR_VALID) != 0u)
+    {
+    }
+}
+
+#endif /* (DEBUG_UART_ENABLED == ENABLED) && (DEBUG_TRACE_ENABLED == ENABLED) */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,108 @@
+/*******************************************************************************
+* File Name: trace.h
+*
+* Version 1.0
+*
+* Description:
+*  Contains the function prototypes, message IDs and constants of the deferred
+*  binary trace.
+*
+*  A DBG_TRACE() message stores its ID and raw arguments in a RAM ring buffer,
+*  which is sent over the debug UART later by TraceProcess(). The format
+*  strings are not stored on the device: trace_decode.py reads them from the
+*  TRACE_<name>_FMT macros of this file. With DEBUG_TRACE_ENABLED disabled,
+*  DBG_TRACE() prints the same format string with printf().
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(TRACE_H)
+#define TRACE_H
+
+#include <project.h>
+
+
+/***************************************
+*        Constants
+***************************************/
+#define TRACE_BUF_SIZE              (512u)      /* Ring buffer size, a power of 2 */
+#define TRACE_DRAIN_LEVEL           (256u)      /* Buffered bytes that start draining */
+
+/* A character received over the debug UART starts draining. TraceProcess()
+*  takes the characters out of the RX FIFO, so disable this when the
+*  application reads the debug UART.
+*/
+#define TRACE_DRAIN_ON_RX           (1u)
+#define TRACE_ARGS_MAX              (8u)
+
+/* Record layout: sync, ID, count, then for a message a 32-bit time stamp in
+*  LFCLK ticks and count 32-bit arguments, or for text count characters.
+*  All the fields are little-endian.
+*/
+#define TRACE_SYNC                  (0xA5u)
+#define TRACE_HDR_SIZE              (3u)
+#define TRACE_TIME_SIZE             (4u)
+#define TRACE_TEXT_MAX              (255u)
+
+
+/***************************************
+*        Message IDs
+***************************************/
+/* The IDs must not be reused: the decoder finds the format by the ID */
+#define TRACE_TEXT                  (0u)        /* Text written by printf() */
+
+#define TRACE_LOST                  (1u)
+#define TRACE_LOST_FMT              "Trace: %lu records lost\r\n"
+
+#define TRACE_CPS_MEASURE           (16u)
+#define TRACE_CPS_MEASURE_FMT       "CpssSendNotification POWER_MEASURE, Power: %d W, Torque: %ld, " \
+                                    "Wheel Revolution: %ld, Time: %d s, Speed: %3.2f km/h, Energy: %ld kJ \r\n"
+#define TRACE_CPS_VECTOR            (17u)
+#define TRACE_CPS_VECTOR_FMT        "CpssSendNotification POWER_VECTOR, Crank Revolution: %d W, " \
+                                    "Time: %d s, Cadence: %d rpm \r\n"
+
+#define TRACE_CSCS_MEASURE          (32u)
+#define TRACE_CSCS_MEASURE_FMT      "CscssSendNotification, Wheel Revolution: %ld, Wheel Time: %ld s, " \
+                                    "Crank Revolution: %ld, Crank Time: %ld s, Speed: %d.%2.2d km/h, " \
+                                    "Cadence: %d rpm\r\n"
+
+
+/***************************************
+*      API Function Prototypes
+***************************************/
+void TraceWrite(uint8 id, uint8 argc, ...);
+void TracePutChar(uint8 ch);
+uint32 TraceFloat(float value);
+void TraceTick(void);
+void TraceProcess(void);
+void TraceFlush(void);
+
+
+/***************************************
+*        Macros
+***************************************/
+#define TRACE_NARGS(...)            TRACE_NARGS_(__VA_ARGS__, 8u, 7u, 6u, 5u, 4u, 3u, 2u, 1u, 0u)
+#define TRACE_NARGS_(a1, a2, a3, a4, a5, a6, a7, a8, n, ...)    (n)
+
+/* Arguments are stored as 32-bit words, so floating point ones are passed
+*  through TRACE_FLOAT().
+*/
+#if (DEBUG_UART_ENABLED == ENABLED) && (DEBUG_TRACE_ENABLED == ENABLED)
+    #define DBG_TRACE(id, ...)      (TraceWrite((id), TRACE_NARGS(__VA_ARGS__), __VA_ARGS__))
+    #define TRACE_FLOAT(x)          (TraceFloat((float)(x)))
+#elif (DEBUG_UART_ENABLED == ENABLED)
+    #define DBG_TRACE(id, ...)      (printf(id##_FMT, __VA_ARGS__))
+    #define TRACE_FLOAT(x)          ((double)(x))
+#else
+    #define DBG_TRACE(id, ...)
+    #define TRACE_FLOAT(x)          (0u)
+#endif /* (DEBUG_UART_ENABLED == ENABLED) && (DEBUG_TRACE_ENABLED == ENABLED) */
+
+
+#endif /* TRACE_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,114 @@
+#!/usr/bin/env python3
+#
+# Decodes the binary trace sent over the debug UART when DEBUG_TRACE_ENABLED
+# is enabled in common.h. The message formats are read from trace.h.
+#
+# Usage:
+#   trace_decode.py [capture.bin] [-f trace.h]
+#
+# The capture is a raw binary log of the UART (115200 8N1), for example
+# saved by a terminal program. Without a file name the log is read from
+# the standard input.
+#
+# Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+# You may use this file only in accordance with the license, terms, conditions,
+# disclaimers, and limitations in the end user license agreement accompanying
+# the software package with which this file was provided.
+
+import argparse
+import os
+import re
+import struct
+import sys
+
+TRACE_SYNC = 0xA5
+TRACE_TEXT = 0
+LFCLK_HZ = 32768.0
+
+CONVERSION = re.compile(r'%[-+ #0]*\d*(?:\.\d+)?[hlLqjzt]*([diouxXeEfFgGcs%])')
+
+
+def load_formats(path):
+    """Returns a dictionary of message ID to the format string."""
+    text = open(path).read()
+    # Join the continued lines of the macros
+    text = re.sub(r'\\\s*\n', ' ', text)
+    ids = dict(re.findall(r'#define\s+(TRACE_\w+)\s+\((\d+)u\)', text))
+    formats = {}
+    for name, body in re.findall(r'#define\s+(TRACE_\w+)_FMT\s+((?:"(?:[^"\\]|\\.)*"\s*)+)', text):
+        if name in ids:
+            parts = re.findall(r'"((?:[^"\\]|\\.)*)"', body)
+            fmt = ''.join(parts).encode().decode('unicode_escape')
+            formats[int(ids[name])] = fmt
+    return formats
+
+
+def format_message(fmt, args):
+    """Formats the raw 32-bit arguments the way printf() would."""
+    values = []
+    pos = 0
+    for conv in CONVERSION.finditer(fmt):
+        kind = conv.group(1)
+        if kind == '%':
+            continue
+        raw = args[pos] if pos < len(args) else 0
+        pos += 1
+        if kind in 'di':
+            values.append(raw - (1 << 32) if raw & 0x80000000 else raw)
+        elif kind in 'eEfFgG':
+            values.append(struct.unpack('<f', struct.pack('<I', raw))[0])
+        elif kind == 'c':
+            values.append(chr(raw & 0xFF))
+        elif kind == 's':
+            values.append('<string>')
+        else:
+            values.append(raw)
+    # Python ignores the length modifiers, but not all of them
+    pyfmt = re.sub(r'(%[-+ #0]*\d*(?:\.\d+)?)[qjzt]', r'\1', fmt)
+    return pyfmt % tuple(values)
+
+
+def decode(data, formats, out):
+    i = 0
+    while i < len(data):
+        if data[i] != TRACE_SYNC or i + 3 > len(data):
+            # Output that was sent before the trace was enabled
+            out.write(chr(data[i]))
+            i += 1
+            continue
+        ident, count = data[i + 1], data[i + 2]
+        if ident == TRACE_TEXT:
+            out.write(data[i + 3:i + 3 + count].decode('latin-1'))
+            i += 3 + count
+            continue
+        end = i + 7 + 4 * count
+        if end > len(data):
+            break
+        stamp = struct.unpack_from('<I', data, i + 3)[0]
+        args = struct.unpack_from('<%dI' % count, data, i + 7)
+        fmt = formats.get(ident)
+        out.write('[%10.4f] ' % (stamp / LFCLK_HZ))
+        if fmt is None:
+            out.write('Unknown message %d: %s\n' % (ident, ' '.join('%08x' % a for a in args)))
+        else:
+            out.write(format_message(fmt, args))
+        i = end
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Decodes the binary debug trace.')
+    parser.add_argument('capture', nargs='?', help='raw UART log, the standard input by default')
+    parser.add_argument('-f', '--formats', default=os.path.join(os.path.dirname(os.path.abspath(__file__)), 'trace.h'),
+                        help='header with the message formats')
+    opts = parser.parse_args()
+
+    formats = load_formats(opts.formats)
+    if opts.capture:
+        data = open(opts.capture, 'rb').read()
+    else:
+        data = sys.stdin.buffer.read()
+    decode(data, formats, sys.stdout)
+
+
+if __name__ == '__main__':
+    main()
@@ -13,6 +13,9 @@
 
 #include <project.h>
 #include <stdio.h>
+#include "esstrig.h"
+#include "esssched.h"
+#include "esshist.h"
 #include "ess.h"
 
 
@@ -22,7 +25,9 @@
 #define YES                                 (1u)
 #define NO                                  (0u)
 
-#define DEBUG_UART_ENABLED                  (YES)
+#if !defined(DEBUG_UART_ENABLED)
+    #define DEBUG_UART_ENABLED              (YES)
+#endif /* !defined(DEBUG_UART_ENABLED) */
 
 
 /***************************************
@@ -64,6 +69,8 @@ CY_ISR_PROTO(Timer_Interrupt);
     #define DBG_PRINTF(...)
 #endif /* (DEBUG_UART_ENABLED == YES) */
 
+#include "ntfstat.h"
+
 
 /***************************************
 * External data references
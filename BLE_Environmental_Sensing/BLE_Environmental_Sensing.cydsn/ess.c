@@ -23,6 +23,7 @@
 ***************************************/
 uint8 isIndicationEnabled = NO;
 uint8 isIndicationPending = NO;
+uint8 isNtfCheckPending = NO;
 uint8 isEssInitDone = NO;
 uint16 indicationValue;
 
@@ -32,6 +33,17 @@ const uint8 defaultSensorCond[NUMBER_OF_TRIGGERS] =
 extern CYBLE_ESS_CHARACTERISTIC_DATA_T humidity;
 extern CYBLE_ESS_CHARACTERISTIC_DATA_T windSpeed[SIZE_2_BYTES];
 
+/* The sensors served by the scheduler */
+CYBLE_ESS_CHARACTERISTIC_DATA_T * const essSensor[ESS_SENSOR_NUM] = {&windSpeed[0], &windSpeed[1], &humidity};
+
+/* The records of the History characteristic: the sensor selected by the
+* Client, the first record of the next chunk and whether the chunks are
+* notified.
+*/
+static uint8 essHistSensor = 0u;
+static ESS_HIST_CURSOR_T essHistCursor;
+static uint8 essHistIsStreaming = NO;
+
 /*******************************************************************************
 * Function Name: EssInit
 ********************************************************************************
@@ -41,6 +53,8 @@ extern CYBLE_ESS_CHARACTERISTIC_DATA_T windSpeed[SIZE_2_BYTES];
 *******************************************************************************/
 void EssInit(void)
 {
+    uint8 i;
+
     windSpeed[0].EssChrIndex = CYBLE_ESS_TRUE_WIND_SPEED;
     windSpeed[0].chrInstance = CHARACTERISTIC_INSTANCE_1;
     EssInitCharacteristic(&windSpeed[0]);
@@ -52,6 +66,14 @@ void EssInit(void)
     humidity.EssChrIndex = CYBLE_ESS_HUMIDITY;
     humidity.chrInstance = CHARACTERISTIC_INSTANCE_1;
     EssInitCharacteristic(&humidity);
+
+    /* The first update of every sensor is at the end of its measurement period */
+    EssSchedInit(mainTimer);
+    for(i = 0u; i < ESS_SENSOR_NUM; i++)
+    {
+        essSensor[i]->timerBase = i * ESS_TIMER_NUM;
+        EssSchedArm(essSensor[i]->timerBase + ESS_TIMER_MEASUREMENT, mainTimer + essSensor[i]->measurementPeriod, 0u);
+    }
 }
 
 /*******************************************************************************
@@ -89,10 +111,12 @@ void EssCallBack(uint32 event, void *eventParam)
             {   
             case CYBLE_ESS_TRUE_WIND_SPEED :
                 windSpeed[charValPtr->charInstance].isNotificationEnabled = YES;
+                isNtfCheckPending = YES;
                 break;
             
             case CYBLE_ESS_HUMIDITY :
                 humidity.isNotificationEnabled = YES;
+                isNtfCheckPending = YES;
                 break;
                 
             default : 
@@ -256,6 +280,7 @@ void EssInitCharacteristic(CYBLE_ESS_CHARACTERISTIC_DATA_T *sensorPtr)
 {
     uint8 i;
     uint8 buff[SIZE_2_BYTES];
+    uint32 histRatio;
     ESS_MEASUREMENT_VALUE_T esMeasurementDescrVal;
     
      /* A temporary store for trigger settings descriptor values. The trigger settings
@@ -305,6 +330,7 @@ void EssInitCharacteristic(CYBLE_ESS_CHARACTERISTIC_DATA_T *sensorPtr)
     sensorPtr->sensorNewDataReady = NO;
     sensorPtr->isMeasurementPeriodElapsed = NO;
     sensorPtr->isNotificationEnabled = NO;
+    sensorPtr->isNtfTimeoutElapsed = YES;
     sensorPtr->prevValue = sensorPtr->value;
     
    
@@ -352,12 +378,9 @@ void EssInitCharacteristic(CYBLE_ESS_CHARACTERISTIC_DATA_T *sensorPtr)
             {    /* Pack notification timeout value to buffer to be set to GATT database */
                 GetUint24(&sensorPtr->ntfTimeoutVal, &esTrigSettingsVal[TRIG_OPERAND_OFFSET]);
             }
-            else
-            {
-                sensorPtr->ntfTimeoutVal = NTF_INIT_TIMEOUT_VAL;
-            }
         }
     }    
+    EssCompileTriggers(sensorPtr);
 
     /* Get the value of ES measurement Descriptor */
     (void) CyBle_EsssGetCharacteristicDescriptor(sensorPtr->EssChrIndex, 
@@ -370,6 +393,17 @@ void EssInitCharacteristic(CYBLE_ESS_CHARACTERISTIC_DATA_T *sensorPtr)
     /* Store the update interval value into uint32 for easy access to it */
     GetUint24(&sensorPtr->updateIntervalValue, &esMeasurementDescrVal.updateInterval[0u]);
     
+    /* A history record summarizes the updates of one measurement period
+    * with the sampling function.
+    */
+    histRatio = (sensorPtr->updateIntervalValue != 0u) ?
+                (sensorPtr->measurementPeriod / sensorPtr->updateIntervalValue) : 1u;
+    if(histRatio > ESS_HIST_RATIO_MAX)
+    {
+        histRatio = ESS_HIST_RATIO_MAX;
+    }
+    EssHistInit(&sensorPtr->hist, esMeasurementDescrVal.samplingFunction, (uint8)histRatio);
+    
     DBG_PRINTF("\r\n* The initialised Charakteristic - %s instance #%d\r\n", CharIndexToText(sensorPtr->EssChrIndex),sensorPtr->chrInstance+1); 
     DBG_PRINTF("* Value of imitated parameter          - %d\r\n", sensorPtr->value); 
     DBG_PRINTF("* Maximum value of imitated parameter  - %d\r\n", sensorPtr->valueMax); 
@@ -384,7 +418,8 @@ void EssInitCharacteristic(CYBLE_ESS_CHARACTERISTIC_DATA_T *sensorPtr)
     }
     
     DBG_PRINTF("* Measurement period in seconds        - %ld\r\n", sensorPtr->measurementPeriod); 
-    DBG_PRINTF("* Update Interval in seconds           - %ld\r\n\n", sensorPtr->updateIntervalValue); 
+    DBG_PRINTF("* Update Interval in seconds           - %ld\r\n", sensorPtr->updateIntervalValue); 
+    DBG_PRINTF("* Sampling function, updates of record - %d, %d\r\n\n", sensorPtr->hist.fn, sensorPtr->hist.ratio); 
 }
 
 
@@ -410,6 +445,8 @@ void HandleButtonPress(CYBLE_ESS_CHARACTERISTIC_DATA_T *sensorPtr)
     {
         sensorPtr->esConfig= CYBLE_ESS_CONF_BOOLEAN_AND;
     }
+    EssCompileTriggers(sensorPtr);
+    isNtfCheckPending = YES;
 
     /* ... and set it to GATT database */
     (void) CyBle_EsssSetCharacteristicDescriptor(   sensorPtr->EssChrIndex,
@@ -465,6 +502,7 @@ void HandleDescriptorWriteOp(CYBLE_ESS_DESCR_VALUE_T *descrValPtr)
                         windSpeed[descrValPtr->charInstance].ntfTimeoutVal = 
                                                 windSpeed[descrValPtr->charInstance].cmpValue[descrValPtr->descrIndex-CYBLE_ESS_ES_TRIGGER_SETTINGS_DESCR1];                   
                     }
+                    EssCompileTriggers(&windSpeed[descrValPtr->charInstance]);
                     
                     break;
                 
@@ -482,6 +520,7 @@ void HandleDescriptorWriteOp(CYBLE_ESS_DESCR_VALUE_T *descrValPtr)
                     {   /* Update notification timer variables with new value */
                         humidity.ntfTimeoutVal = humidity.cmpValue[descrValPtr->descrIndex-CYBLE_ESS_ES_TRIGGER_SETTINGS_DESCR1];                   
                     }
+                    EssCompileTriggers(&humidity);
                     
                     break;
                                                 
@@ -498,6 +537,7 @@ void HandleDescriptorWriteOp(CYBLE_ESS_DESCR_VALUE_T *descrValPtr)
             }
             DBG_PRINTF("\r\n");
             isIndicationPending = YES;
+            isNtfCheckPending = YES;
             indicationValue = CYBLE_ESS_VALUE_CHANGE_SOURCE_CLIENT | CYBLE_ESS_VALUE_CHANGE_ES_TRIGGER;
             break;
         
@@ -506,10 +546,12 @@ void HandleDescriptorWriteOp(CYBLE_ESS_DESCR_VALUE_T *descrValPtr)
             {   
             case CYBLE_ESS_TRUE_WIND_SPEED :
                 windSpeed[descrValPtr->charInstance].esConfig = descrValPtr->value->val[0u];
+                EssCompileTriggers(&windSpeed[descrValPtr->charInstance]);
                 break;
             
             case CYBLE_ESS_HUMIDITY :
                 humidity.esConfig = descrValPtr->value->val[0u];
+                EssCompileTriggers(&humidity);
                 break;
             
             default : 
@@ -519,6 +561,7 @@ void HandleDescriptorWriteOp(CYBLE_ESS_DESCR_VALUE_T *descrValPtr)
                     
             DBG_PRINTF("Received value is: 0x%2.2x\r\n", descrValPtr->value->val[0u]);
             isIndicationPending = YES;
+            isNtfCheckPending = YES;
             indicationValue = CYBLE_ESS_VALUE_CHANGE_SOURCE_CLIENT | CYBLE_ESS_VALUE_CHANGE_ES_CONFIG;
             break;
         case CYBLE_ESS_CHAR_USER_DESCRIPTION_DESCR:
@@ -541,8 +584,8 @@ void HandleDescriptorWriteOp(CYBLE_ESS_DESCR_VALUE_T *descrValPtr)
 ********************************************************************************
 *
 * Summary:
-*  Simulates a wind measurement based on the time periods specified in the ES 
-*  Measurement descriptor. 
+*  Simulates a wind measurement at the end of the update interval specified
+*  in the ES Measurement descriptor.
 *
 * Parameters:  
 *   *sensorPtr: A pointer to the sensor characteristic structure.
@@ -550,14 +593,6 @@ void HandleDescriptorWriteOp(CYBLE_ESS_DESCR_VALUE_T *descrValPtr)
 *******************************************************************************/
 void SimulateProfile(CYBLE_ESS_CHARACTERISTIC_DATA_T *sensorPtr)
 {
-    /* Following two condition checks are required for measurement period simulation */
-    if((sensorPtr->isMeasurementPeriodElapsed == NO) && (sensorPtr->measurementPeriod <= mainTimer))
-    {
-        sensorPtr->isMeasurementPeriodElapsed = YES;
-        DBG_PRINTF("Measurement Period for %s sensor#%d (%d s) has elapsed.\r\n",
-            CharIndexToText(sensorPtr->EssChrIndex), sensorPtr->chrInstance + 1u, LO16(sensorPtr->measurementPeriod));
-    }
-
     /* The first sensor simulates an increase in the wind speed by 1.2 m/s each
     * 15 seconds until it reaches the maximum of 80 m/s. Then the wind speed
     * falls down to the minimum of 10 m/s, and then again it is
@@ -566,33 +601,90 @@ void SimulateProfile(CYBLE_ESS_CHARACTERISTIC_DATA_T *sensorPtr)
     * 20 seconds until, it reaches the maximum of ~90 m/s. After that the speed 
     * is not updated any more holding the maximum wind speed.
     */
-    if(sensorPtr->isMeasurementPeriodElapsed == YES)
+    sensorPtr->prevValue = sensorPtr->value;
+    
+    if(sensorPtr->valueMax > sensorPtr->value)
+    {
+        sensorPtr->value += sensorPtr->valueUpdateStep;
+    }
+    else if(sensorPtr->chrInstance == CHARACTERISTIC_INSTANCE_1)
+    {
+        sensorPtr->value = sensorPtr->valueMin;
+    }
+    else
     {
-        if(sensorPtr->updateIntervalTimer == 0u)
-        {   
-            sensorPtr->prevValue = sensorPtr->value;
+        /*  Value of CHARACTERISTIC_INSTANCE_2 is not changed */
+    }
+    sensorPtr->sensorNewDataReady = YES;
+    
+    /* Record the value, the Client reads the records from the ESS History
+    * service.
+    */
+    EssHistUpdate(sensorPtr);
+    
+    /* Updated Change Index value as new data is available */
+    essChangeIndex++;
+    CyBle_EsssSetChangeIndex(essChangeIndex);
+    
+    DBG_PRINTF("Update Interval for %s sensor#%d (%d s) has elapsed.\r\n",
+               CharIndexToText(sensorPtr->EssChrIndex),sensorPtr->chrInstance + 1u, LO16(sensorPtr->updateIntervalValue));
+}
+
+
+/*******************************************************************************
+* Function Name: EssProcessTimers()
+********************************************************************************
+*
+* Summary:
+*  Serves the expired sensor deadlines: the end of the measurement period,
+*  the update interval and the notification timeout. The deadlines of all
+*  the sensors are kept in one timer wheel, so the sensors are only visited
+*  when one of their deadlines expires and close deadlines are served
+*  together. The update intervals are timed from the nominal deadlines, so
+*  they do not drift by the ticks a deadline has waited to join another.
+*
+* Parameters:  
+*   now: The value of mainTimer.
+*
+*******************************************************************************/
+void EssProcessTimers(uint32 now)
+{
+    CYBLE_ESS_CHARACTERISTIC_DATA_T *sensorPtr;
+    uint32 period;
+    uint8 timer = EssSchedExpired(now);
+
+    while(timer != ESS_SCHED_NONE)
+    {
+        sensorPtr = essSensor[timer / ESS_TIMER_NUM];
+        
+        /* An update interval of 0 is served every second */
+        period = (sensorPtr->updateIntervalValue != 0u) ? sensorPtr->updateIntervalValue : 1u;
+        
+        switch(timer % ESS_TIMER_NUM)
+        {
+            case ESS_TIMER_MEASUREMENT:
+                sensorPtr->isMeasurementPeriodElapsed = YES;
+                DBG_PRINTF("Measurement Period for %s sensor#%d (%d s) has elapsed.\r\n",
+                    CharIndexToText(sensorPtr->EssChrIndex), sensorPtr->chrInstance + 1u, LO16(sensorPtr->measurementPeriod));
+                SimulateProfile(sensorPtr);
+                /* The update intervals follow the end of the measurement period */
+                EssSchedArm(sensorPtr->timerBase + ESS_TIMER_UPDATE, essSchedTimer[timer].deadline + period,
+                            ESS_SCHED_SLACK(sensorPtr->updateIntervalValue));
+                break;
             
-            if(sensorPtr->valueMax > sensorPtr->value)
-            {
-                sensorPtr->value += sensorPtr->valueUpdateStep;
-            }
-            else if(sensorPtr->chrInstance == CHARACTERISTIC_INSTANCE_1)
-            {
-                sensorPtr->value = sensorPtr->valueMin;
-            }
-            else
-            {
-                /*  Value of CHARACTERISTIC_INSTANCE_2 is not changed */
-            }
-            sensorPtr->updateIntervalTimer = sensorPtr->updateIntervalValue;
-            sensorPtr->sensorNewDataReady = YES;
-            /* Updated Change Index value as new data is available */
-            essChangeIndex++;
-            CyBle_EsssSetChangeIndex(essChangeIndex);
+            case ESS_TIMER_UPDATE:
+                SimulateProfile(sensorPtr);
+                EssSchedRearm(timer, now, period, ESS_SCHED_SLACK(sensorPtr->updateIntervalValue));
+                break;
             
-            DBG_PRINTF("Update Interval for %s sensor#%d (%d s) has elapsed.\r\n",
-                       CharIndexToText(sensorPtr->EssChrIndex),sensorPtr->chrInstance + 1u, LO16(sensorPtr->updateIntervalTimer));
+            default:
+                sensorPtr->isNtfTimeoutElapsed = YES;
+                break;
         }
+        
+        /* The notification conditions of the sensor may have become true */
+        isNtfCheckPending = YES;
+        timer = EssSchedExpired(now);
     }
 }
 
@@ -613,25 +705,263 @@ void HandleNotificaion(CYBLE_ESS_CHARACTERISTIC_DATA_T *sensorPtr)
     CYBLE_API_RESULT_T apiResult;
     uint8 tmpBuff[CYBLE_ESS_2BYTES_LENGTH];
 
+    NTF_STAT_BUILD_START();
+
     /* Pack data to BLE compatible format ... */
     CyBle_Set16ByPtr(tmpBuff, sensorPtr->value);
 
+    NTF_STAT_BUILD_END();
+
     /* ... and send it */
     apiResult = CyBle_EsssSendNotification(connectionHandle,
                                            sensorPtr->EssChrIndex,
                                            sensorPtr->chrInstance,
                                            SIZE_2_BYTES,
                                            tmpBuff);
+    NTF_STAT_SENT(apiResult, SIZE_2_BYTES);
 
     if(apiResult != CYBLE_ERROR_OK)
     {
         DBG_PRINTF("Send notification is failed: %d \r\n", apiResult);
+        /* Retry at the next second */
+        isNtfCheckPending = YES;
     }
     else
     {   DBG_PRINTF("Notification for %s #%d was sent successfully. ", CharIndexToText(sensorPtr->EssChrIndex), sensorPtr->chrInstance + 1u);
         DBG_PRINTF("Notified value is: %d.%d m/s.\r\n", sensorPtr->value/100u, sensorPtr->value%100u);
         sensorPtr->sensorNewDataReady = NO;
-        sensorPtr->ntfTimer = sensorPtr->ntfTimeoutVal;
+        
+        /* Time the notification interval of the interval triggers, from the
+        * deadline of the last interval when it has elapsed
+        */
+        if(sensorPtr->trig.interval != 0u)
+        {
+            sensorPtr->isNtfTimeoutElapsed = NO;
+            EssSchedRearm(sensorPtr->timerBase + ESS_TIMER_NTF, mainTimer, sensorPtr->ntfTimeoutVal,
+                          ESS_SCHED_SLACK(sensorPtr->ntfTimeoutVal));
+        }
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: EssHistChunk()
+********************************************************************************
+*
+* Summary:
+*  Packs the records at the cursor into a chunk of the History
+*  characteristic: the sensor index, the number of the records, the sequence
+*  number of the first record and the records, little-endian.
+*
+* Parameters:  
+*   *cursor: The first record, returns the record after the chunk.
+*   chunk[]: Returns the chunk, zero padded to len bytes.
+*   len: The length of the chunk, at least ESS_HIST_CHUNK_HDR_LEN.
+*
+* Return: 
+*  The number of the records in the chunk.
+*
+*******************************************************************************/
+static uint8 EssHistChunk(ESS_HIST_CURSOR_T *cursor, uint8 chunk[], uint8 len)
+{
+    const ESS_HIST_T *hist = &essSensor[essHistSensor]->hist;
+    uint32 first = cursor->next;
+    uint16 value;
+    uint8 count = 0u;
+    uint8 pos = ESS_HIST_CHUNK_HDR_LEN;
+
+    while(((pos + SIZE_2_BYTES) <= len) && (EssHistNext(hist, cursor, &value) != 0u))
+    {
+        if(count == 0u)
+        {
+            /* The records before it may have been dropped */
+            first = cursor->next - 1u;
+        }
+        CyBle_Set16ByPtr(&chunk[pos], value);
+        pos += SIZE_2_BYTES;
+        count++;
+    }
+    while(pos < len)
+    {
+        chunk[pos] = 0u;
+        pos++;
+    }
+
+    chunk[ESS_HIST_CHUNK_SENSOR_OFFSET] = essHistSensor;
+    chunk[ESS_HIST_CHUNK_COUNT_OFFSET] = count;
+    CyBle_Set16ByPtr(&chunk[ESS_HIST_CHUNK_SEQ_OFFSET], LO16(first));
+    CyBle_Set16ByPtr(&chunk[ESS_HIST_CHUNK_SEQ_OFFSET + SIZE_2_BYTES], HI16(first));
+
+    return(count);
+}
+
+
+/*******************************************************************************
+* Function Name: EssHistLoad()
+********************************************************************************
+*
+* Summary:
+*  Writes the chunk at the cursor of the History characteristic to the GATT
+*  database, where the Client reads it.
+*
+*******************************************************************************/
+static void EssHistLoad(void)
+{
+    CYBLE_GATT_HANDLE_VALUE_PAIR_T handleValuePair;
+    ESS_HIST_CURSOR_T cursor = essHistCursor;
+    uint8 chunk[ESS_HIST_CHUNK_MAX];
+
+    (void)EssHistChunk(&cursor, chunk, ESS_HIST_CHUNK_MAX);
+
+    handleValuePair.attrHandle = ESS_HIST_CHAR_HANDLE;
+    handleValuePair.value.val = chunk;
+    handleValuePair.value.len = ESS_HIST_CHUNK_MAX;
+    (void)CyBle_GattsWriteAttributeValue(&handleValuePair, 0u, NULL, CYBLE_GATT_DB_LOCALLY_INITIATED);
+}
+
+
+/*******************************************************************************
+* Function Name: EssHistWriteReq()
+********************************************************************************
+*
+* Summary:
+*  Handles the Write Requests of the ESS History service. A write of the
+*  History characteristic selects the sensor and the sequence number of the
+*  first record to read, the chunk of the records is then read from the
+*  characteristic, or notified chunk by chunk up to the newest record when
+*  the notifications of the characteristic are enabled. A record that has
+*  been dropped is replaced by the oldest one, the Client finds the gap by
+*  the sequence number of the chunk.
+*
+* Parameters:  
+*   *wrReqParam: The parameter of the CYBLE_EVT_GATTS_WRITE_REQ event.
+*
+*******************************************************************************/
+void EssHistWriteReq(CYBLE_GATTS_WRITE_REQ_PARAM_T *wrReqParam)
+{
+    CYBLE_GATTS_ERR_PARAM_T errParam;
+    CYBLE_GATT_ERR_CODE_T gattErr = CYBLE_GATT_ERR_NONE;
+    uint8 *val = wrReqParam->handleValPair.value.val;
+    uint32 seq;
+
+    errParam.attrHandle = wrReqParam->handleValPair.attrHandle;
+    if(errParam.attrHandle == ESS_HIST_CCCD_HANDLE)
+    {
+        gattErr = CyBle_GattsWriteAttributeValue(&wrReqParam->handleValPair, 0u, &wrReqParam->connHandle,
+                                                 CYBLE_GATT_DB_PEER_INITIATED);
+    }
+    else if(errParam.attrHandle == ESS_HIST_CHAR_HANDLE)
+    {
+        if(wrReqParam->handleValPair.value.len != ESS_HIST_REQ_LEN)
+        {
+            gattErr = CYBLE_GATT_ERR_INVALID_ATTRIBUTE_LEN;
+        }
+        else if(val[ESS_HIST_REQ_SENSOR_OFFSET] >= ESS_SENSOR_NUM)
+        {
+            gattErr = CYBLE_GATT_ERR_OUT_OF_RANGE;
+        }
+        else
+        {
+            essHistSensor = val[ESS_HIST_REQ_SENSOR_OFFSET];
+            seq = ((uint32)CyBle_Get16ByPtr(&val[ESS_HIST_REQ_SEQ_OFFSET + SIZE_2_BYTES]) << 16u) |
+                  CyBle_Get16ByPtr(&val[ESS_HIST_REQ_SEQ_OFFSET]);
+            EssHistSeek(&essSensor[essHistSensor]->hist, &essHistCursor, seq);
+            essHistIsStreaming = YES;
+            EssHistLoad();
+            DBG_PRINTF("History of sensor #%d from record %ld requested.\r\n", essHistSensor, seq);
+        }
+    }
+    else
+    {
+        /* Not an attribute of the ESS History service */
+        errParam.attrHandle = CYBLE_GATT_INVALID_ATTR_HANDLE_VALUE;
+    }
+
+    if(errParam.attrHandle != CYBLE_GATT_INVALID_ATTR_HANDLE_VALUE)
+    {
+        if(gattErr == CYBLE_GATT_ERR_NONE)
+        {
+            (void)CyBle_GattsWriteRsp(wrReqParam->connHandle);
+        }
+        else
+        {
+            errParam.opcode = (uint8)CYBLE_GATT_WRITE_REQ;
+            errParam.errorCode = gattErr;
+            (void)CyBle_GattsErrorRsp(wrReqParam->connHandle, &errParam);
+        }
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: EssHistUpdate()
+********************************************************************************
+*
+* Summary:
+*  Stores the value of the sensor in its history and updates the chunk of
+*  the History characteristic when the sensor is the one selected.
+*
+* Parameters:  
+*   *sensorPtr: A pointer to the sensor characteristic structure.
+*
+*******************************************************************************/
+void EssHistUpdate(CYBLE_ESS_CHARACTERISTIC_DATA_T *sensorPtr)
+{
+    if((EssHistSample(&sensorPtr->hist, sensorPtr->value) != 0u) && (sensorPtr == essSensor[essHistSensor]))
+    {
+        EssHistLoad();
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: EssHistStream()
+********************************************************************************
+*
+* Summary:
+*  Notifies the chunks of the History characteristic requested by the
+*  Client, up to the newest record. As many chunks are sent as the stack
+*  accepts, the rest is sent on the next calls. A chunk is at most the
+*  negotiated MTU less the notification header.
+*
+*******************************************************************************/
+void EssHistStream(void)
+{
+    CYBLE_API_RESULT_T apiResult = CYBLE_ERROR_OK;
+    CYBLE_GATTS_HANDLE_VALUE_NTF_T ntfParam;
+    ESS_HIST_CURSOR_T cursor;
+    uint8 chunk[ESS_HIST_CHUNK_MAX];
+    uint16 mtu = CYBLE_GATT_DEFAULT_MTU;
+    uint8 len;
+
+    (void)CyBle_GattGetMtuSize(&mtu);
+    len = ((mtu - ESS_HIST_NTF_HDR_LEN) < ESS_HIST_CHUNK_MAX) ? (uint8)(mtu - ESS_HIST_NTF_HDR_LEN) : ESS_HIST_CHUNK_MAX;
+
+    while((essHistIsStreaming == YES) && (apiResult != CYBLE_ERROR_MEMORY_ALLOCATION_FAILED) &&
+          (CYBLE_IS_NOTIFICATION_ENABLED(ESS_HIST_CCCD_HANDLE)) &&
+          (CyBle_GattGetBusyStatus() == CYBLE_STACK_STATE_FREE))
+    {
+        cursor = essHistCursor;
+        if(EssHistChunk(&cursor, chunk, len) != 0u)
+        {
+            ntfParam.attrHandle = ESS_HIST_CHAR_HANDLE;
+            ntfParam.value.val = chunk;
+            ntfParam.value.len = ESS_HIST_CHUNK_HDR_LEN + ((uint16)chunk[ESS_HIST_CHUNK_COUNT_OFFSET] * SIZE_2_BYTES);
+            apiResult = CyBle_GattsNotification(connectionHandle, &ntfParam);
+            NTF_STAT_SENT(apiResult, ntfParam.value.len);
+
+            /* On an error other than the TX buffer overflow the chunk is skipped */
+            if(apiResult != CYBLE_ERROR_MEMORY_ALLOCATION_FAILED)
+            {
+                essHistCursor = cursor;
+                EssHistLoad();
+            }
+        }
+        else
+        {
+            /* The Client writes the characteristic again for the later records */
+            essHistIsStreaming = NO;
+        }
     }
 }
 
@@ -658,111 +988,39 @@ void HandleNotificaion(CYBLE_ESS_CHARACTERISTIC_DATA_T *sensorPtr)
 uint8 HandleNtfConditions(CYBLE_ESS_CHARACTERISTIC_DATA_T *sensorPtr)
 {
     uint8 result = NO;
-    uint8 isCondTrue[NUMBER_OF_TRIGGERS] = {NO, NO, NO};
-    uint8 isCondInactive[NUMBER_OF_TRIGGERS] = {NO, NO, NO};
-    uint8 i;
 
     if(sensorPtr->sensorNewDataReady == YES)
     {
-        for (i = 0; i < NUMBER_OF_TRIGGERS; i++)
-        {   
-            switch (sensorPtr->valueCond[i])
-            {
-                case CYBLE_ESS_TRIG_USE_FIXED_TIME_INTERVAL:  /* FIXED_TIME work same as NO_LESS_THEN_TIME_INTERVAL  */ 
-                case CYBLE_ESS_TRIG_NO_LESS_THEN_TIME_INTERVAL:
-                    if((sensorPtr->ntfTimer == 0u) && (sensorPtr->sensorNewDataReady == YES))
-                    {
-                        isCondTrue[i] = YES;
-                    }
-                    break;
-                    
-                case CYBLE_ESS_TRIG_WHEN_CHANGED:
-                    if(sensorPtr->value != sensorPtr->prevValue)
-                    {
-                        isCondTrue[i] = YES;
-                    }
-                    break;
-                    
-                case CYBLE_ESS_TRIG_WHILE_LESS_THAN:
-                    if(sensorPtr->value < sensorPtr->cmpValue[i])
-                    {
-                        isCondTrue[i] = YES;
-                    }
-                    break;
-                    
-                case CYBLE_ESS_TRIG_WHILE_LESS_OR_EQUAL:
-                    if(sensorPtr->value <= sensorPtr->cmpValue[i])
-                    {
-                        isCondTrue[i] = YES;
-                    }
-                    break;
-                    
-                case CYBLE_ESS_TRIG_WHILE_GREATER_THAN:
-                    if(sensorPtr->value > sensorPtr->cmpValue[i])
-                    {
-                        isCondTrue[i] = YES;
-                    }
-                    break;
-                    
-                case CYBLE_ESS_TRIG_WHILE_GREATER_OR_EQUAL:
-                    if(sensorPtr->value >= sensorPtr->cmpValue[i])
-                    {
-                        isCondTrue[i] = YES;
-                    }
-                    break;
-                    
-                case CYBLE_ESS_TRIG_WHILE_EQUAL_TO:
-                    if(sensorPtr->value == sensorPtr->cmpValue[i])
-                    {
-                        isCondTrue[i] = YES;
-                    }
-                    break;
-                    
-                case CYBLE_ESS_TRIG_WHILE_EQUAL_NOT_TO:
-                    if(sensorPtr->value != sensorPtr->cmpValue[i])
-                    {
-                        isCondTrue[i] = YES;
-                    }
-                    break;
-                
-                default:
-                    isCondInactive[i] = YES;
-                    break;    
-            }
-        }
-    }
-
-    /* All condition inactive or not present */
-    if ( (isCondInactive[0] == YES)
-      && (isCondInactive[1] == YES)  
-      && (isCondInactive[2] == YES) )
-    { 
-        result = YES;
-    }
-    else        /* Condition connected wich boolean AND */
-    {   if( sensorPtr->esConfig == CYBLE_ESS_CONF_BOOLEAN_AND )
-        {   
-           if( ((isCondInactive[0] == YES) || (isCondTrue[0] == YES))
-            && ((isCondInactive[1] == YES) || (isCondTrue[1] == YES))
-            && ((isCondInactive[2] == YES) || (isCondTrue[2] == YES)) ) 
-            {
-                result = YES;
-            }
-        }
-        else 
-        {   /* Condition connected wich boolean OR */
-            if(  (isCondTrue[0] == YES)
-              || (isCondTrue[1] == YES)
-              || (isCondTrue[2] == YES) ) 
-            {
-                result = YES;
-            }
+        if(EssTrigEval(&sensorPtr->trig, sensorPtr->value, sensorPtr->prevValue,
+                       sensorPtr->isNtfTimeoutElapsed) != 0u)
+        {
+            result = YES;
         }
     }
 
     return(result);
 }
 
+
+/*******************************************************************************
+* Function Name: EssCompileTriggers()
+********************************************************************************
+*
+* Summary:
+*  Compiles the conditions of the ES Trigger Setting descriptors and the ES
+*  Configuration descriptor, so HandleNtfConditions() does not decode them
+*  for every sample. Called whenever one of the descriptors changes.
+*
+* Parameters:  
+*   *sensorPtr: A pointer to the sensor characteristic structure.
+*
+*******************************************************************************/
+void EssCompileTriggers(CYBLE_ESS_CHARACTERISTIC_DATA_T *sensorPtr)
+{
+    EssTrigCompile(&sensorPtr->trig, sensorPtr->valueCond, sensorPtr->cmpValue, NUMBER_OF_TRIGGERS,
+                   (sensorPtr->esConfig == CYBLE_ESS_CONF_BOOLEAN_AND) ? YES : NO);
+}
+
 /*******************************************************************************
 * Function Name: HandleIndication()
 ********************************************************************************
@@ -789,6 +1047,7 @@ void HandleIndication(uint16 flags)
                                          0u,
                                          SIZE_4_BYTES,
                                          (uint8 *)&essValChanged);
+    NTF_STAT_SENT(apiResult, SIZE_4_BYTES);
 
     if(apiResult != CYBLE_ERROR_OK)
     {
@@ -33,7 +33,32 @@
 #define HUMIDITY_VLUE_LENGTH                (2u)
 #define INIT_HUMIDITY                       (200u)
 
-#define NTF_INIT_TIMEOUT_VAL                (10u)
+/* Sensors of the scheduler, windSpeed[0], windSpeed[1] and humidity */
+#define ESS_SENSOR_NUM                      (3u)
+
+/* Scheduler timers of a sensor, ESS_SENSOR_NUM * ESS_TIMER_NUM timers
+* are at most ESS_SCHED_TIMERS_MAX.
+*/
+#define ESS_TIMER_MEASUREMENT               (0u)
+#define ESS_TIMER_UPDATE                    (1u)
+#define ESS_TIMER_NTF                       (2u)
+#define ESS_TIMER_NUM                       (3u)
+
+/* ESS History service, a custom service of the sensor records. The Client
+* writes the sensor index and the sequence number of the first record, then
+* reads the chunk of the records or gets them notified.
+*/
+#define ESS_HIST_CHAR_HANDLE                (CYBLE_ESS_HISTORY_HISTORY_CHAR_HANDLE)
+#define ESS_HIST_CCCD_HANDLE                (CYBLE_ESS_HISTORY_HISTORY_CLIENT_CHARACTERISTIC_CONFIGURATION_DESC_HANDLE)
+#define ESS_HIST_REQ_LEN                    (5u)
+#define ESS_HIST_REQ_SENSOR_OFFSET          (0u)
+#define ESS_HIST_REQ_SEQ_OFFSET             (1u)
+#define ESS_HIST_CHUNK_HDR_LEN              (6u)
+#define ESS_HIST_CHUNK_SENSOR_OFFSET        (0u)
+#define ESS_HIST_CHUNK_COUNT_OFFSET         (1u)
+#define ESS_HIST_CHUNK_SEQ_OFFSET           (2u)
+#define ESS_HIST_NTF_HDR_LEN                (3u)    /* Opcode and handle of a notification */
+#define ESS_HIST_CHUNK_MAX                  (CYBLE_GATT_MTU - ESS_HIST_NTF_HDR_LEN)
 
 /* Characteristic/Descriptor sizes */
 #define SIZE_1_BYTE                         (1u)
@@ -147,8 +172,8 @@ typedef struct
     /* Notification timeout value */
     uint32  ntfTimeoutVal;
     
-    /* Notification timer value */
-    uint32  ntfTimer;
+    /* The notification timeout has elapsed since the last notification */
+    uint8   isNtfTimeoutElapsed;
     
     /* Value condition */
     uint8   valueCond[NUMBER_OF_TRIGGERS];
@@ -156,6 +181,9 @@ typedef struct
     /* Comparison value for parameter */
     uint32  cmpValue[NUMBER_OF_TRIGGERS];    
 
+    /* Trigger conditions compiled from valueCond, cmpValue and esConfig */
+    ESS_TRIG_T trig;
+
     uint8   sensorNewDataReady;
     
     uint8   isMeasurementPeriodElapsed;
@@ -168,8 +196,11 @@ typedef struct
     /* Update Interval in seconds. */
     uint32  updateIntervalValue;
     
-    /* Update Interval Timer. */
-    uint32  updateIntervalTimer;
+    /* The first scheduler timer of the sensor */
+    uint8   timerBase;
+    
+    /* History of the samples, downsampled by the ES Measurement descriptor */
+    ESS_HIST_T hist;
     
 } CYBLE_ESS_CHARACTERISTIC_DATA_T;
 
@@ -183,8 +214,13 @@ void HandleIndication(uint16 flags);
 void HandleNotificaion(CYBLE_ESS_CHARACTERISTIC_DATA_T *sensorPtr);
 void HandleDescriptorWriteOp(CYBLE_ESS_DESCR_VALUE_T *descrValPtr);
 uint8 HandleNtfConditions(CYBLE_ESS_CHARACTERISTIC_DATA_T *sensorPtr);
+void EssCompileTriggers(CYBLE_ESS_CHARACTERISTIC_DATA_T *sensorPtr);
 void SimulateProfile(CYBLE_ESS_CHARACTERISTIC_DATA_T *sensorPtr);
 void ChkNtfAndSendData(CYBLE_ESS_CHARACTERISTIC_DATA_T *sensorPtr);
+void EssProcessTimers(uint32 now);
+void EssHistUpdate(CYBLE_ESS_CHARACTERISTIC_DATA_T *sensorPtr);
+void EssHistWriteReq(CYBLE_GATTS_WRITE_REQ_PARAM_T *wrReqParam);
+void EssHistStream(void);
 void EssCallBack(uint32 event, void *eventParam);
 void GetUint24(uint32 *u32, uint8 u24Ptr[]);
 char *CharIndexToText(CYBLE_ESS_CHAR_INDEX_T EssChrIndex);
@@ -195,7 +231,9 @@ char *CharIndexToText(CYBLE_ESS_CHAR_INDEX_T EssChrIndex);
 ***************************************/
 extern uint8 isIndicationEnabled;
 extern uint8 isIndicationPending;
+extern uint8 isNtfCheckPending;
 extern uint16 indicationValue;
+extern CYBLE_ESS_CHARACTERISTIC_DATA_T * const essSensor[ESS_SENSOR_NUM];
 
 
 /* [] END OF FILE */
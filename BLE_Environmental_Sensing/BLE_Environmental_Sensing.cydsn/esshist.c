@@ -0,0 +1,422 @@
+/*******************************************************************************
+* File Name: esshist.c
+*
+* Version 1.0
+*
+* Description:
+*  This file contains the measurement history of the ESS characteristics.
+*  The samples are summarized to records by the sampling function of the
+*  ES Measurement descriptor and the records are kept in a ring of
+*  variable length codes:
+*
+*   - ratio samples make one record: their last value, arithmetic mean,
+*     RMS, maximum, minimum, saturated sum or count, in the fixed point
+*     units of the characteristic. The sum of the squares of RMS is scaled
+*     down only when it would overflow, so small values stay exact;
+*   - the oldest record is kept as a value and every later record as its
+*     difference to the previous one in 1 or 2 bytes, or as a value in 3
+*     bytes when the difference does not fit, so a slowly changing
+*     characteristic keeps about one record per byte;
+*   - when the ring is full the oldest record is dropped by applying the
+*     code of the next one to the kept value;
+*   - a cursor reads the records in order by their sequence number, a
+*     cursor whose record has been dropped continues at the oldest one.
+*
+*  The history only depends on cytypes.h, so it is also built on the host.
+*
+* Hardware Dependency:
+*  CY8CKIT-042 BLE
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include "esshist.h"
+
+
+/*******************************************************************************
+* Function Name: EssHistDecode
+********************************************************************************
+*
+* Summary:
+*   Applies the record code to the value of the previous record.
+*
+* Parameters:
+*   hist - the history.
+*   pos - the offset of the code.
+*   value - the value of the previous record, returns the value of the
+*           record.
+*
+* Return:
+*   The length of the code.
+*
+*******************************************************************************/
+static uint8 EssHistDecode(const ESS_HIST_T *hist, uint8 pos, uint16 *value)
+{
+    uint32 code = hist->data[pos];
+    uint32 zigzag;
+    uint8 len;
+
+    if(ESS_HIST_CODE_ABSOLUTE == code)
+    {
+        *value = (uint16)((uint32)hist->data[(pos + 1u) & ESS_HIST_MASK] |
+                          ((uint32)hist->data[(pos + 2u) & ESS_HIST_MASK] << 8u));
+        len = 3u;
+    }
+    else
+    {
+        if(0u == (code & ESS_HIST_CODE_DELTA14))
+        {
+            zigzag = code;
+            len = 1u;
+        }
+        else
+        {
+            zigzag = ((code & 0x3Fu) << 8u) | hist->data[(pos + 1u) & ESS_HIST_MASK];
+            len = 2u;
+        }
+        *value = (uint16)((uint32)*value + ((zigzag >> 1u) ^ (0u - (zigzag & 1u))));
+    }
+
+    return(len);
+}
+
+
+/*******************************************************************************
+* Function Name: EssHistInit
+********************************************************************************
+*
+* Summary:
+*   Empties the history.
+*
+* Parameters:
+*   hist - the history.
+*   fn - the sampling function, ESS_HIST_FN_.
+*   ratio - the samples summarized by one record, 0 is taken as 1.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void EssHistInit(ESS_HIST_T *hist, uint8 fn, uint8 ratio)
+{
+    hist->head = 0u;
+    hist->used = 0u;
+    hist->count = 0u;
+    hist->first = 0u;
+    hist->last = 0u;
+    hist->seq = 0u;
+    hist->fn = fn;
+    hist->ratio = (0u != ratio) ? ratio : 1u;
+    hist->samples = 0u;
+    hist->extreme = 0u;
+    hist->accShift = 0u;
+    hist->acc = 0u;
+}
+
+
+/*******************************************************************************
+* Function Name: EssHistSample
+********************************************************************************
+*
+* Summary:
+*   Adds the sample to the record in progress and stores the record once it
+*   summarizes ratio samples.
+*
+* Parameters:
+*   hist - the history.
+*   value - the sample.
+*
+* Return:
+*   Non-zero when a record has been stored.
+*
+*******************************************************************************/
+uint8 EssHistSample(ESS_HIST_T *hist, uint16 value)
+{
+    uint32 record;
+    uint32 square;
+    uint32 root;
+    uint32 bit;
+    uint8 stored = 0u;
+
+    switch(hist->fn)
+    {
+        case ESS_HIST_FN_MEAN:
+        case ESS_HIST_FN_ACCUMULATED:
+            hist->acc += value;
+            break;
+
+        case ESS_HIST_FN_RMS:
+            square = (uint32)value * value;
+            while((hist->acc + (square >> hist->accShift)) < hist->acc)
+            {
+                hist->acc >>= 2u;
+                hist->accShift += 2u;
+            }
+            hist->acc += square >> hist->accShift;
+            break;
+
+        case ESS_HIST_FN_MAXIMUM:
+            if((0u == hist->samples) || (value > hist->extreme))
+            {
+                hist->extreme = value;
+            }
+            break;
+
+        case ESS_HIST_FN_MINIMUM:
+            if((0u == hist->samples) || (value < hist->extreme))
+            {
+                hist->extreme = value;
+            }
+            break;
+
+        case ESS_HIST_FN_COUNT:
+            break;
+
+        default:
+            /* Instantaneous, unspecified and reserved functions keep the last sample */
+            hist->extreme = value;
+            break;
+    }
+    hist->samples++;
+
+    if(hist->samples >= hist->ratio)
+    {
+        switch(hist->fn)
+        {
+            case ESS_HIST_FN_MEAN:
+                record = (hist->acc + (hist->samples >> 1u)) / hist->samples;
+                break;
+
+            case ESS_HIST_FN_ACCUMULATED:
+                record = (hist->acc < 0xFFFFu) ? hist->acc : 0xFFFFu;
+                break;
+
+            case ESS_HIST_FN_RMS:
+                /* Integer square root of the mean square */
+                record = (hist->acc + (hist->samples >> 1u)) / hist->samples;
+                root = 0u;
+                bit = 1uL << 30u;
+                while(0u != bit)
+                {
+                    if(record >= (root + bit))
+                    {
+                        record -= root + bit;
+                        root = (root >> 1u) + bit;
+                    }
+                    else
+                    {
+                        root >>= 1u;
+                    }
+                    bit >>= 2u;
+                }
+                /* Rounded to nearest */
+                record = (root + ((record > root) ? 1u : 0u)) << (hist->accShift >> 1u);
+                if(record > 0xFFFFu)
+                {
+                    record = 0xFFFFu;
+                }
+                break;
+
+            case ESS_HIST_FN_COUNT:
+                record = hist->samples;
+                break;
+
+            default:
+                record = hist->extreme;
+                break;
+        }
+
+        EssHistStore(hist, (uint16)record);
+        hist->samples = 0u;
+        hist->accShift = 0u;
+        hist->acc = 0u;
+        stored = 1u;
+    }
+
+    return(stored);
+}
+
+
+/*******************************************************************************
+* Function Name: EssHistStore
+********************************************************************************
+*
+* Summary:
+*   Appends the record, the oldest records are dropped to make room for it.
+*
+* Parameters:
+*   hist - the history.
+*   value - the value of the record.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void EssHistStore(ESS_HIST_T *hist, uint16 value)
+{
+    int32 delta = (int32)value - (int32)hist->last;
+    uint32 zigzag = ((uint32)delta << 1u) ^ (uint32)(delta >> 31u);
+    uint8 code[3u];
+    uint8 len;
+    uint8 i;
+
+    if(0u == hist->count)
+    {
+        hist->first = value;
+        hist->count = 1u;
+    }
+    else
+    {
+        if((delta >= ESS_HIST_DELTA7_MIN) && (delta <= ESS_HIST_DELTA7_MAX))
+        {
+            code[0u] = (uint8)zigzag;
+            len = 1u;
+        }
+        else if((delta >= ESS_HIST_DELTA14_MIN) && (delta <= ESS_HIST_DELTA14_MAX))
+        {
+            code[0u] = (uint8)(ESS_HIST_CODE_DELTA14 | (zigzag >> 8u));
+            code[1u] = (uint8)zigzag;
+            len = 2u;
+        }
+        else
+        {
+            code[0u] = ESS_HIST_CODE_ABSOLUTE;
+            code[1u] = (uint8)value;
+            code[2u] = (uint8)(value >> 8u);
+            len = 3u;
+        }
+
+        /* Drop the oldest records, the next one becomes the kept value */
+        while(((uint32)hist->used + len) > ESS_HIST_SIZE)
+        {
+            i = EssHistDecode(hist, hist->head, &hist->first);
+            hist->head = (uint8)((hist->head + i) & ESS_HIST_MASK);
+            hist->used -= i;
+            hist->count--;
+        }
+
+        for(i = 0u; i < len; i++)
+        {
+            hist->data[(hist->head + hist->used + i) & ESS_HIST_MASK] = code[i];
+        }
+        hist->used += len;
+        hist->count++;
+    }
+
+    hist->last = value;
+    hist->seq++;
+}
+
+
+/*******************************************************************************
+* Function Name: EssHistSeekEnd
+********************************************************************************
+*
+* Summary:
+*   Moves the cursor past the newest record, it reads the records stored
+*   from now on.
+*
+* Parameters:
+*   hist - the history.
+*   cursor - the cursor.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void EssHistSeekEnd(const ESS_HIST_T *hist, ESS_HIST_CURSOR_T *cursor)
+{
+    cursor->next = hist->seq;
+    cursor->pos = (uint8)((hist->head + hist->used) & ESS_HIST_MASK);
+    cursor->value = hist->last;
+}
+
+
+/*******************************************************************************
+* Function Name: EssHistSeek
+********************************************************************************
+*
+* Summary:
+*   Moves the cursor to the record of the sequence number. A record that
+*   has been dropped is replaced by the oldest one, a record that has not
+*   been stored yet by the end of the history.
+*
+* Parameters:
+*   hist - the history.
+*   cursor - the cursor.
+*   seq - the sequence number of the record.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void EssHistSeek(const ESS_HIST_T *hist, ESS_HIST_CURSOR_T *cursor, uint32 seq)
+{
+    uint16 value;
+
+    if((int32)(seq - hist->seq) >= 0)
+    {
+        EssHistSeekEnd(hist, cursor);
+    }
+    else
+    {
+        /* The codes are decoded from the oldest record up to seq */
+        cursor->next = hist->seq - hist->count;
+        while((int32)(cursor->next - seq) < 0)
+        {
+            (void)EssHistNext(hist, cursor, &value);
+        }
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: EssHistNext
+********************************************************************************
+*
+* Summary:
+*   Reads the record at the cursor and moves the cursor to the next one. A
+*   cursor whose record has been dropped continues at the oldest record.
+*
+* Parameters:
+*   hist - the history.
+*   cursor - the cursor.
+*   value - returns the value of the record.
+*
+* Return:
+*   Non-zero when a record has been read, 0 past the newest record.
+*
+*******************************************************************************/
+uint8 EssHistNext(const ESS_HIST_T *hist, ESS_HIST_CURSOR_T *cursor, uint16 *value)
+{
+    uint32 oldest = hist->seq - hist->count;
+    uint8 valid = 0u;
+
+    if((int32)(cursor->next - hist->seq) < 0)
+    {
+        if((int32)(cursor->next - oldest) <= 0)
+        {
+            /* The oldest record is kept as a value */
+            cursor->next = oldest;
+            cursor->pos = hist->head;
+            cursor->value = hist->first;
+        }
+        else
+        {
+            cursor->pos = (uint8)((cursor->pos + EssHistDecode(hist, cursor->pos, &cursor->value)) &
+                                  ESS_HIST_MASK);
+        }
+        cursor->next++;
+        *value = cursor->value;
+        valid = 1u;
+    }
+
+    return(valid);
+}
+
+
+/* [] END OF FILE */
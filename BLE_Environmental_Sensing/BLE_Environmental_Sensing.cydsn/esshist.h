@@ -0,0 +1,97 @@
+/*******************************************************************************
+* File Name: esshist.h
+*
+* Version 1.0
+*
+* Description:
+*  Contains the function prototypes and constants of the measurement
+*  history of the Environmental Sensing Service characteristics.
+*
+* Hardware Dependency:
+*  CY8CKIT-042 BLE
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(ESSHIST_H)
+#define ESSHIST_H
+
+#include "cytypes.h"
+
+
+/***************************************
+*        Constants
+***************************************/
+#define ESS_HIST_SIZE               (64u)       /* Bytes of encoded records, a power of two */
+#define ESS_HIST_MASK               (ESS_HIST_SIZE - 1u)
+#define ESS_HIST_RATIO_MAX          (255u)      /* Samples summarized by one record */
+
+/* Sampling functions of the ES Measurement descriptor, section 3.1.1 of ESS spec */
+#define ESS_HIST_FN_UNSPECIFIED     (0x00u)
+#define ESS_HIST_FN_INSTANTANEOUS   (0x01u)
+#define ESS_HIST_FN_MEAN            (0x02u)
+#define ESS_HIST_FN_RMS             (0x03u)
+#define ESS_HIST_FN_MAXIMUM         (0x04u)
+#define ESS_HIST_FN_MINIMUM         (0x05u)
+#define ESS_HIST_FN_ACCUMULATED     (0x06u)
+#define ESS_HIST_FN_COUNT           (0x07u)
+
+/* Record codes: the difference to the previous record in 1 or 2 bytes,
+*  zigzag encoded, or the record value in 3 bytes.
+*/
+#define ESS_HIST_CODE_DELTA14       (0x80u)     /* 10xxxxxx xxxxxxxx */
+#define ESS_HIST_CODE_ABSOLUTE      (0xC0u)     /* 11000000 then the value, little-endian */
+#define ESS_HIST_DELTA7_MIN         (-64)
+#define ESS_HIST_DELTA7_MAX         (63)
+#define ESS_HIST_DELTA14_MIN        (-8192)
+#define ESS_HIST_DELTA14_MAX        (8191)
+
+
+/***************************************
+*        Data Struct Definition
+***************************************/
+typedef struct
+{
+    uint8  data[ESS_HIST_SIZE]; /* Codes of the records after the oldest one */
+    uint8  head;                /* Offset of the code of the second oldest record */
+    uint8  used;                /* Bytes of codes */
+    uint16 count;               /* Records kept */
+    uint16 first;               /* Value of the oldest record */
+    uint16 last;                /* Value of the newest record */
+    uint32 seq;                 /* Records stored, the newest is seq - 1 */
+
+    /* Downsampling of the samples to one record */
+    uint8  fn;                  /* Sampling function, ESS_HIST_FN_ */
+    uint8  ratio;               /* Samples of one record */
+    uint8  samples;             /* Samples of the record in progress */
+    uint16 extreme;             /* Last, maximum or minimum sample */
+    uint8  accShift;            /* The squares in acc are shifted right by it, even */
+    uint32 acc;                 /* Sum of the samples or of their squares */
+} ESS_HIST_T;
+
+typedef struct
+{
+    uint32 next;                /* Sequence of the next record to read */
+    uint8  pos;                 /* Offset of its code */
+    uint16 value;               /* Value of the record before it */
+} ESS_HIST_CURSOR_T;
+
+
+/***************************************
+*      API Function Prototypes
+***************************************/
+void EssHistInit(ESS_HIST_T *hist, uint8 fn, uint8 ratio);
+uint8 EssHistSample(ESS_HIST_T *hist, uint16 value);
+void EssHistStore(ESS_HIST_T *hist, uint16 value);
+void EssHistSeekEnd(const ESS_HIST_T *hist, ESS_HIST_CURSOR_T *cursor);
+void EssHistSeek(const ESS_HIST_T *hist, ESS_HIST_CURSOR_T *cursor, uint32 seq);
+uint8 EssHistNext(const ESS_HIST_T *hist, ESS_HIST_CURSOR_T *cursor, uint16 *value);
+
+
+#endif /* ESSHIST_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,348 @@
+/*******************************************************************************
+* File Name: esssched.c
+*
+* Version 1.0
+*
+* Description:
+*  This file contains the timer wheel of the sensor deadlines: the
+*  measurement periods, the update intervals and the notification
+*  intervals of all the ESS characteristics. The timers are hashed to the
+*  slots of the wheel by their expiry tick, so serving a tick only walks
+*  the timers of one slot:
+*
+*   - a timer fires at its deadline, unless another timer already fires
+*     within its slack after the deadline, then it joins that tick, so close
+*     deadlines share one wakeup and a timer never fires early;
+*   - a periodic timer is re-armed from its nominal deadline, not from the
+*     tick it has fired at, so the joined ticks do not make it drift;
+*   - the earliest expiry is kept, EssSchedDue() tells in one comparison
+*     whether any timer has expired and the ticks without an expiry are
+*     skipped at once.
+*
+*  The scheduler only depends on cytypes.h, so it is also built on the host.
+*
+* Hardware Dependency:
+*  CY8CKIT-042 BLE
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include "esssched.h"
+
+
+ESS_SCHED_TIMER_T essSchedTimer[ESS_SCHED_TIMERS_MAX];
+uint32 essSchedWakeups = 0u;
+
+static uint8  essSchedSlot[ESS_SCHED_WHEEL_SIZE];   /* First timer of every slot */
+static uint8  essSchedArmed = 0u;                   /* Timers in the wheel */
+static uint8  essSchedFired = 0u;                   /* A timer has fired at essSchedTick */
+static uint32 essSchedTick = 0u;                    /* The next tick to serve */
+static uint32 essSchedNext = 0u;                    /* No timer expires before this tick */
+
+
+/*******************************************************************************
+* Function Name: EssSchedSlotHas
+********************************************************************************
+*
+* Summary:
+*   Checks whether a timer fires at the tick.
+*
+* Parameters:
+*   tick - the tick.
+*
+* Return:
+*   Non-zero when a timer fires at the tick.
+*
+*******************************************************************************/
+static uint8 EssSchedSlotHas(uint32 tick)
+{
+    uint8 timer = essSchedSlot[tick & ESS_SCHED_WHEEL_MASK];
+
+    while((ESS_SCHED_NONE != timer) && (essSchedTimer[timer].expiry != tick))
+    {
+        timer = essSchedTimer[timer].next;
+    }
+
+    return((ESS_SCHED_NONE != timer) ? 1u : 0u);
+}
+
+
+/*******************************************************************************
+* Function Name: EssSchedUnlink
+********************************************************************************
+*
+* Summary:
+*   Removes the armed timer from its slot.
+*
+* Parameters:
+*   timer - the timer.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+static void EssSchedUnlink(uint8 timer)
+{
+    uint8 *link = &essSchedSlot[essSchedTimer[timer].expiry & ESS_SCHED_WHEEL_MASK];
+
+    while(*link != timer)
+    {
+        link = &essSchedTimer[*link].next;
+    }
+    *link = essSchedTimer[timer].next;
+    essSchedTimer[timer].armed = 0u;
+    essSchedArmed--;
+}
+
+
+/*******************************************************************************
+* Function Name: EssSchedInit
+********************************************************************************
+*
+* Summary:
+*   Empties the wheel.
+*
+* Parameters:
+*   now - the current tick, the first tick to serve.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void EssSchedInit(uint32 now)
+{
+    uint32 i;
+
+    for(i = 0u; i < ESS_SCHED_WHEEL_SIZE; i++)
+    {
+        essSchedSlot[i] = ESS_SCHED_NONE;
+    }
+    for(i = 0u; i < ESS_SCHED_TIMERS_MAX; i++)
+    {
+        essSchedTimer[i].armed = 0u;
+        essSchedTimer[i].fired = 0u;
+    }
+    essSchedArmed = 0u;
+    essSchedFired = 0u;
+    essSchedTick = now;
+    essSchedNext = now;
+    essSchedWakeups = 0u;
+}
+
+
+/*******************************************************************************
+* Function Name: EssSchedArm
+********************************************************************************
+*
+* Summary:
+*   Arms the timer, an armed timer is moved to the new deadline. The timer
+*   fires at the first tick of the slack window at which another timer
+*   fires, else at the deadline itself.
+*
+* Parameters:
+*   timer - the timer, below ESS_SCHED_TIMERS_MAX.
+*   deadline - the tick of the deadline. A deadline that has been served
+*              fires at the next tick served.
+*   slack - the ticks the timer may fire late to join another timer, at
+*           most ESS_SCHED_WHEEL_SIZE - 1.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void EssSchedArm(uint8 timer, uint32 deadline, uint32 slack)
+{
+    uint32 expiry = deadline;
+    uint32 i;
+    uint8 found = 0u;
+
+    EssSchedCancel(timer);
+    essSchedTimer[timer].deadline = deadline;
+    essSchedTimer[timer].fired = 0u;
+
+    if((int32)(expiry - essSchedTick) < 0)
+    {
+        expiry = essSchedTick;
+    }
+    if(slack >= ESS_SCHED_WHEEL_SIZE)
+    {
+        slack = ESS_SCHED_WHEEL_SIZE - 1u;
+    }
+
+    for(i = 0u; (i <= slack) && (0u == found); i++)
+    {
+        found = EssSchedSlotHas(expiry + i);
+    }
+    if(0u != found)
+    {
+        /* i is past the joined tick */
+        expiry += i - 1u;
+    }
+
+    essSchedTimer[timer].expiry = expiry;
+    essSchedTimer[timer].next = essSchedSlot[expiry & ESS_SCHED_WHEEL_MASK];
+    essSchedTimer[timer].armed = 1u;
+    essSchedSlot[expiry & ESS_SCHED_WHEEL_MASK] = timer;
+
+    if((0u == essSchedArmed) || ((int32)(expiry - essSchedNext) < 0))
+    {
+        essSchedNext = expiry;
+    }
+    essSchedArmed++;
+}
+
+
+/*******************************************************************************
+* Function Name: EssSchedRearm
+********************************************************************************
+*
+* Summary:
+*   Arms a periodic timer for its next period. A timer that has fired is
+*   re-armed one period after its nominal deadline, whole periods that have
+*   been missed are skipped, so the phase is kept. Any other timer starts a
+*   period from now.
+*
+* Parameters:
+*   timer - the timer, below ESS_SCHED_TIMERS_MAX.
+*   now - the current tick.
+*   period - the ticks of the period.
+*   slack - the ticks the timer may fire late to join another timer, at
+*           most ESS_SCHED_WHEEL_SIZE - 1.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void EssSchedRearm(uint8 timer, uint32 now, uint32 period, uint32 slack)
+{
+    uint32 deadline = now + period;
+
+    if(0u != essSchedTimer[timer].fired)
+    {
+        deadline = essSchedTimer[timer].deadline + period;
+        if((0u != period) && ((int32)(deadline - essSchedTick) < 0))
+        {
+            deadline += (((essSchedTick - deadline) + period - 1u) / period) * period;
+        }
+    }
+
+    EssSchedArm(timer, deadline, slack);
+}
+
+
+/*******************************************************************************
+* Function Name: EssSchedCancel
+********************************************************************************
+*
+* Summary:
+*   Removes the timer from the wheel, a timer that is not armed is ignored.
+*
+* Parameters:
+*   timer - the timer.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void EssSchedCancel(uint8 timer)
+{
+    if(0u != essSchedTimer[timer].armed)
+    {
+        EssSchedUnlink(timer);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: EssSchedDue
+********************************************************************************
+*
+* Summary:
+*   Checks whether a timer may have expired.
+*
+* Parameters:
+*   now - the current tick.
+*
+* Return:
+*   Non-zero when EssSchedExpired() is to be called.
+*
+*******************************************************************************/
+uint8 EssSchedDue(uint32 now)
+{
+    return(((0u != essSchedArmed) && ((int32)(now - essSchedNext) >= 0)) ? 1u : 0u);
+}
+
+
+/*******************************************************************************
+* Function Name: EssSchedExpired
+********************************************************************************
+*
+* Summary:
+*   Takes the next expired timer out of the wheel. The ticks up to now are
+*   served in order, so the timers fire in the order of their expiry.
+*
+* Parameters:
+*   now - the current tick.
+*
+* Return:
+*   The expired timer or ESS_SCHED_NONE when no timer has expired.
+*
+*******************************************************************************/
+uint8 EssSchedExpired(uint32 now)
+{
+    uint8 timer = ESS_SCHED_NONE;
+    uint8 found;
+    uint8 i;
+
+    while((ESS_SCHED_NONE == timer) && (0u != EssSchedDue(now)))
+    {
+        if((int32)(essSchedNext - essSchedTick) > 0)
+        {
+            /* No timer expires before essSchedNext */
+            essSchedTick = essSchedNext;
+            essSchedFired = 0u;
+        }
+
+        timer = essSchedSlot[essSchedTick & ESS_SCHED_WHEEL_MASK];
+        while((ESS_SCHED_NONE != timer) && (essSchedTimer[timer].expiry != essSchedTick))
+        {
+            timer = essSchedTimer[timer].next;
+        }
+
+        if(ESS_SCHED_NONE != timer)
+        {
+            EssSchedUnlink(timer);
+            essSchedTimer[timer].fired = 1u;
+            if(0u == essSchedFired)
+            {
+                essSchedFired = 1u;
+                essSchedWakeups++;
+            }
+        }
+        else
+        {
+            /* The tick has been served, find the earliest expiry left */
+            essSchedTick++;
+            essSchedFired = 0u;
+            found = 0u;
+            for(i = 0u; i < ESS_SCHED_TIMERS_MAX; i++)
+            {
+                if((0u != essSchedTimer[i].armed) &&
+                   ((0u == found) || ((int32)(essSchedTimer[i].expiry - essSchedNext) < 0)))
+                {
+                    essSchedNext = essSchedTimer[i].expiry;
+                    found = 1u;
+                }
+            }
+        }
+    }
+
+    return(timer);
+}
+
+
+/* [] END OF FILE */
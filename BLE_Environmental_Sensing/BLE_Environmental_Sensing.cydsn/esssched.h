@@ -0,0 +1,74 @@
+/*******************************************************************************
+* File Name: esssched.h
+*
+* Version 1.0
+*
+* Description:
+*  Contains the function prototypes and constants of the timer wheel that
+*  schedules the sensor deadlines of Environmental Sensing Service.
+*
+* Hardware Dependency:
+*  CY8CKIT-042 BLE
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(ESSSCHED_H)
+#define ESSSCHED_H
+
+#include "cytypes.h"
+
+
+/***************************************
+*        Constants
+***************************************/
+#define ESS_SCHED_TIMERS_MAX        (16u)       /* Timers of the wheel */
+#define ESS_SCHED_WHEEL_SIZE        (32u)       /* Slots of the wheel, ticks, a power of two */
+#define ESS_SCHED_WHEEL_MASK        (ESS_SCHED_WHEEL_SIZE - 1u)
+#define ESS_SCHED_NONE              (0xFFu)     /* No timer */
+
+/* The slack of a periodic timer, its period >> ESS_SCHED_SLACK_SHIFT */
+#define ESS_SCHED_SLACK_SHIFT       (3u)
+
+/* The slack of the timer with the period */
+#define ESS_SCHED_SLACK(period)     ((uint32)(period) >> ESS_SCHED_SLACK_SHIFT)
+
+
+/***************************************
+*        Data Struct Definition
+***************************************/
+typedef struct
+{
+    uint32 deadline;            /* Nominal deadline, a periodic timer is re-armed from it */
+    uint32 expiry;              /* Tick the timer fires at */
+    uint8  next;                /* Next timer of the slot or ESS_SCHED_NONE */
+    uint8  armed;               /* Non-zero while the timer is in the wheel */
+    uint8  fired;               /* Non-zero once the timer has fired at its deadline */
+} ESS_SCHED_TIMER_T;
+
+
+/***************************************
+*      API Function Prototypes
+***************************************/
+void EssSchedInit(uint32 now);
+void EssSchedArm(uint8 timer, uint32 deadline, uint32 slack);
+void EssSchedRearm(uint8 timer, uint32 now, uint32 period, uint32 slack);
+void EssSchedCancel(uint8 timer);
+uint8 EssSchedDue(uint32 now);
+uint8 EssSchedExpired(uint32 now);
+
+
+/***************************************
+*      External data references
+***************************************/
+extern ESS_SCHED_TIMER_T essSchedTimer[ESS_SCHED_TIMERS_MAX];
+extern uint32 essSchedWakeups;      /* Ticks at which timers have fired */
+
+
+#endif /* ESSSCHED_H */
+
+/* [] END OF FILE */
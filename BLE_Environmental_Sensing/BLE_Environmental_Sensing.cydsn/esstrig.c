@@ -0,0 +1,230 @@
+/*******************************************************************************
+* File Name: esstrig.c
+*
+* Version 1.0
+*
+* Description:
+*  This file contains the compiled ES Trigger Setting conditions. The
+*  conditions are translated once, when the trigger descriptors or the ES
+*  Configuration descriptor are written, so a sample is checked without
+*  decoding them again:
+*
+*   - every value condition becomes a range of the 16-bit value with the
+*     operand bounds precomputed, the NOT EQUAL condition an inverted range,
+*     and a condition that holds for every value or for none is resolved
+*     at compile time;
+*   - the time interval and the value change conditions are masks that
+*     are set from one comparison each;
+*   - the AND and OR of the ES Configuration become the masks of the
+*     triggers that must all be true and of those of which one must be.
+*
+*  The evaluator only depends on cytypes.h, so it is also built on the host.
+*
+* Hardware Dependency:
+*  CY8CKIT-042 BLE
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include "esstrig.h"
+
+
+/*******************************************************************************
+* Function Name: EssTrigCompile
+********************************************************************************
+*
+* Summary:
+*   Compiles the trigger conditions of one characteristic. A condition past
+*   ESS_TRIG_NOT_EQUAL is inactive.
+*
+* Parameters:
+*   trig - returns the compiled conditions.
+*   cond - the conditions of the triggers.
+*   operand - the operands of the triggers.
+*   count - the number of the triggers, at most ESS_TRIG_MAX are compiled.
+*   isAnd - non-zero when the ES Configuration combines the triggers with
+*           AND, else with OR.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void EssTrigCompile(ESS_TRIG_T *trig, const uint8 cond[], const uint32 operand[], uint8 count, uint8 isAnd)
+{
+    uint32 i;
+    uint32 lo;
+    uint32 hi;
+    uint8 bit;
+    uint8 isRange;
+
+    trig->active = 0u;
+    trig->always = 0u;
+    trig->range = 0u;
+    trig->invert = 0u;
+    trig->changed = 0u;
+    trig->interval = 0u;
+    for(i = 0u; i < ESS_TRIG_MAX; i++)
+    {
+        trig->lo[i] = 0u;
+        trig->span[i] = 0u;
+    }
+
+    if(count > ESS_TRIG_MAX)
+    {
+        count = ESS_TRIG_MAX;
+    }
+
+    for(i = 0u; i < count; i++)
+    {
+        bit = (uint8)(1u << i);
+        lo = 0u;
+        hi = ESS_TRIG_VALUE_MAX;
+        isRange = 0u;
+
+        if((cond[i] > ESS_TRIG_INACTIVE) && (cond[i] <= ESS_TRIG_NOT_EQUAL))
+        {
+            trig->active |= bit;
+        }
+
+        switch(cond[i])
+        {
+            case ESS_TRIG_FIXED_INTERVAL:       /* FIXED_INTERVAL works same as MIN_INTERVAL */
+            case ESS_TRIG_MIN_INTERVAL:
+                trig->interval |= bit;
+                break;
+
+            case ESS_TRIG_CHANGED:
+                trig->changed |= bit;
+                break;
+
+            case ESS_TRIG_LESS:
+                /* Never true with the operand 0 */
+                if(0u != operand[i])
+                {
+                    hi = operand[i] - 1u;
+                    isRange = 1u;
+                }
+                break;
+
+            case ESS_TRIG_LESS_OR_EQUAL:
+                hi = operand[i];
+                isRange = 1u;
+                break;
+
+            case ESS_TRIG_GREATER:
+                if(operand[i] < ESS_TRIG_VALUE_MAX)
+                {
+                    lo = operand[i] + 1u;
+                    isRange = 1u;
+                }
+                break;
+
+            case ESS_TRIG_GREATER_OR_EQUAL:
+                if(operand[i] <= ESS_TRIG_VALUE_MAX)
+                {
+                    lo = operand[i];
+                    isRange = 1u;
+                }
+                break;
+
+            case ESS_TRIG_EQUAL:
+                if(operand[i] <= ESS_TRIG_VALUE_MAX)
+                {
+                    lo = operand[i];
+                    hi = operand[i];
+                    isRange = 1u;
+                }
+                break;
+
+            case ESS_TRIG_NOT_EQUAL:
+                if(operand[i] <= ESS_TRIG_VALUE_MAX)
+                {
+                    lo = operand[i];
+                    hi = operand[i];
+                    trig->invert |= bit;
+                    isRange = 1u;
+                }
+                else
+                {
+                    trig->always |= bit;
+                }
+                break;
+
+            default:
+                break;
+        }
+
+        if(0u != isRange)
+        {
+            if(hi > ESS_TRIG_VALUE_MAX)
+            {
+                hi = ESS_TRIG_VALUE_MAX;
+            }
+
+            if((0u == lo) && (ESS_TRIG_VALUE_MAX == hi))
+            {
+                trig->always |= bit;
+            }
+            else
+            {
+                trig->range |= bit;
+                trig->lo[i] = (uint16)lo;
+                trig->span[i] = (uint16)(hi - lo);
+            }
+        }
+    }
+
+    trig->all = (0u != isAnd) ? trig->active : 0u;
+    trig->any = (0u != isAnd) ? 0u : trig->active;
+}
+
+
+/*******************************************************************************
+* Function Name: EssTrigEval
+********************************************************************************
+*
+* Summary:
+*   Checks the sample against the compiled trigger conditions.
+*
+* Parameters:
+*   trig - the compiled conditions.
+*   value - the new value of the characteristic.
+*   prevValue - the previous value.
+*   intervalElapsed - non-zero when the notification interval has elapsed.
+*
+* Return:
+*   Non-zero when the notification is to be sent: no trigger is active,
+*   or all the active triggers are true with AND, or one of them with OR.
+*
+*******************************************************************************/
+uint8 EssTrigEval(const ESS_TRIG_T *trig, uint16 value, uint16 prevValue, uint8 intervalElapsed)
+{
+    uint32 i;
+    uint32 inside = 0u;
+    uint32 hits;
+
+    /* The unsigned distance from lo is within span only inside the range */
+    for(i = 0u; 0u != ((uint32)trig->range >> i); i++)
+    {
+        inside |= ((uint32)((uint16)(value - trig->lo[i]) <= trig->span[i])) << i;
+    }
+
+    hits = (uint32)trig->always | ((inside ^ trig->invert) & trig->range);
+    if(value != prevValue)
+    {
+        hits |= trig->changed;
+    }
+    if(0u != intervalElapsed)
+    {
+        hits |= trig->interval;
+    }
+
+    return((((hits & trig->all) == trig->all) && ((0u == trig->any) || (0u != (hits & trig->any)))) ? 1u : 0u);
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,77 @@
+/*******************************************************************************
+* File Name: esstrig.h
+*
+* Version 1.0
+*
+* Description:
+*  Contains the function prototypes and constants of the compiled ES Trigger
+*  Setting conditions.
+*
+* Hardware Dependency:
+*  CY8CKIT-042 BLE
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(ESSTRIG_H)
+#define ESSTRIG_H
+
+#include "cytypes.h"
+
+
+/***************************************
+*        Constants
+***************************************/
+#define ESS_TRIG_MAX                (8u)        /* Triggers of one characteristic, bits of the masks */
+
+/* ES Trigger Setting conditions, section 3.1.2.2 of ESS spec */
+#define ESS_TRIG_INACTIVE           (0x00u)
+#define ESS_TRIG_FIXED_INTERVAL     (0x01u)
+#define ESS_TRIG_MIN_INTERVAL       (0x02u)
+#define ESS_TRIG_CHANGED            (0x03u)
+#define ESS_TRIG_LESS               (0x04u)
+#define ESS_TRIG_LESS_OR_EQUAL      (0x05u)
+#define ESS_TRIG_GREATER            (0x06u)
+#define ESS_TRIG_GREATER_OR_EQUAL   (0x07u)
+#define ESS_TRIG_EQUAL              (0x08u)
+#define ESS_TRIG_NOT_EQUAL          (0x09u)
+
+#define ESS_TRIG_VALUE_MAX          (0xFFFFu)   /* The largest characteristic value */
+
+
+/***************************************
+*        Data Struct Definition
+***************************************/
+/* The trigger conditions compiled to masks, bit n stands for trigger n. A
+*  value condition is the range lo..lo + span, the NOT EQUAL condition is
+*  the inverted range of one value.
+*/
+typedef struct
+{
+    uint8  active;              /* Active triggers */
+    uint8  always;              /* Value conditions true for every value */
+    uint8  range;               /* Value conditions checked against their range */
+    uint8  invert;              /* Ranges that are true outside */
+    uint8  changed;             /* The value changes */
+    uint8  interval;            /* The notification interval elapses */
+    uint8  all;                 /* Triggers that must all be true */
+    uint8  any;                 /* Triggers of which one must be true */
+    uint16 lo[ESS_TRIG_MAX];
+    uint16 span[ESS_TRIG_MAX];
+} ESS_TRIG_T;
+
+
+/***************************************
+*      API Function Prototypes
+***************************************/
+void EssTrigCompile(ESS_TRIG_T *trig, const uint8 cond[], const uint32 operand[], uint8 count, uint8 isAnd);
+uint8 EssTrigEval(const ESS_TRIG_T *trig, uint16 value, uint16 prevValue, uint8 intervalElapsed);
+
+
+#endif /* ESSTRIG_H */
+
+/* [] END OF FILE */
@@ -202,6 +202,7 @@ void AppCallBack(uint32 event, void *eventParam)
             break;
         case CYBLE_EVT_GATTS_WRITE_REQ:
             DBG_PRINTF("CYBLE_EVT_GATTS_WRITE_REQ:\r\n");
+            EssHistWriteReq((CYBLE_GATTS_WRITE_REQ_PARAM_T *)eventParam);
             break;
 
         /**********************************************************
@@ -228,34 +229,7 @@ CY_ISR(WDT_Interrupt)
     {
         /* Indicate that timer is raised to main loop */
         mainTimer++;
-        
-        if(windSpeed[CHARACTERISTIC_INSTANCE_1].isMeasurementPeriodElapsed == YES)
-        {
-            windSpeed[CHARACTERISTIC_INSTANCE_1].updateIntervalTimer--;
-        }
-        if(windSpeed[CHARACTERISTIC_INSTANCE_2].isMeasurementPeriodElapsed == YES)
-        {
-            windSpeed[CHARACTERISTIC_INSTANCE_2].updateIntervalTimer--;
-        }
-        if(humidity.isMeasurementPeriodElapsed == YES)
-        {
-            humidity.updateIntervalTimer--;
-        }
-
-        if(windSpeed[CHARACTERISTIC_INSTANCE_1].ntfTimer != 0u)
-        {
-            windSpeed[CHARACTERISTIC_INSTANCE_1].ntfTimer--;
-        }
-        if(windSpeed[CHARACTERISTIC_INSTANCE_2].ntfTimer != 0u)
-        {   
-            windSpeed[CHARACTERISTIC_INSTANCE_2].ntfTimer--;
-            
-        }
-        if(humidity.ntfTimer != 0u)
-        {   
-            humidity.ntfTimer--;
-            
-        }
+        NTF_STAT_TICK();
         
         /* Update state of Advertising LED */
         advLedState ^= LED_OFF;
@@ -476,6 +450,7 @@ static void LowPowerImplementation(void)
 int main()
 {
     CYBLE_API_RESULT_T apiResult;
+    uint8 i;
     
     CyGlobalIntEnable;
     
@@ -506,16 +481,17 @@ int main()
         /* Handle advertising LED blinking */
         HandleLeds();
 
-        /* Check if there is updated data */
-        SimulateProfile(&windSpeed[0]);
-        SimulateProfile(&windSpeed[1]);
-        SimulateProfile(&humidity);
+        /* Serve the sensor deadlines that have expired */
+        EssProcessTimers(mainTimer);
 
         /* In connection state check if there is data that
         * should be sent to remote Client.
         */
         if(CyBle_GetState() == CYBLE_STATE_CONNECTED)
         {
+            /* Notify the history records the Client has requested */
+            EssHistStream();
+
             if(prevMainTimer != mainTimer)
             {
                 if(isButtonPressed == YES)
@@ -530,14 +506,17 @@ int main()
                     isButtonPressed = NO;
                 }
 
-                /* Check if there are notifications for True Wind Speed #1 and send them */
-                ChkNtfAndSendData(&windSpeed[0]);
-
-                /* Check if there are notifications for True Wind Speed #2 and send them */
-                ChkNtfAndSendData(&windSpeed[1]);                
-                
-                /* Check if there are notifications for Humidity and send them */
-                ChkNtfAndSendData(&humidity);                
+                /* Check if there are notifications for the sensors and send
+                * them, once a sensor deadline or a descriptor has changed.
+                */
+                if(isNtfCheckPending == YES)
+                {
+                    isNtfCheckPending = NO;
+                    for(i = 0u; i < ESS_SENSOR_NUM; i++)
+                    {
+                        ChkNtfAndSendData(essSensor[i]);
+                    }
+                }
 
                 /* Check if there are indications need to send to remote Client
                 * and send them.
@@ -548,7 +527,8 @@ int main()
                     isIndicationPending = NO;
                     CyBle_ProcessEvents();
                 }
-                
+
+                NTF_STAT_PROCESS();
             }
             prevMainTimer = mainTimer;
         }
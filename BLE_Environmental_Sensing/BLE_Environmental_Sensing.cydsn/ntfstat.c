@@ -0,0 +1,243 @@
+/*******************************************************************************
+* File Name: ntfstat.c
+*
+* Version 1.0
+*
+* Description:
+*  This file contains the notification throughput statistics: the number of
+*  notifications and bytes accepted by the stack per second, the time spent
+*  waiting for a free TX buffer and the CPU cycles spent building PDUs.
+*
+* Hardware Dependency:
+*  CY8CKIT-042 BLE
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include "common.h"
+
+
+NTF_STAT_T ntfStat;
+
+static volatile uint32 ntfStatSeconds = 0u;
+static uint32 ntfStatBuildStart = 0u;
+static uint8 ntfStatSysTickRun = 0u;
+
+
+/*******************************************************************************
+* Function Name: NtfStatSysTickStart
+********************************************************************************
+*
+* Summary:
+*   Configures the SysTick as a free running 24-bit down counter clocked by
+*   SYSCLK. The SysTick interrupt is not used.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+static void NtfStatSysTickStart(void)
+{
+    CySysTickStop();
+    CySysTickSetClockSource(CY_SYS_SYST_CSR_CLK_SRC_SYSCLK);
+    CySysTickSetReload(CY_SYS_SYST_RVR_CNT_MASK);
+    CySysTickClear();
+    CySysTickEnable();
+    CySysTickDisableInterrupt();
+    ntfStatSysTickRun = 1u;
+}
+
+
+/*******************************************************************************
+* Function Name: NtfStatReset
+********************************************************************************
+*
+* Summary:
+*   Clears all the accumulated counters.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void NtfStatReset(void)
+{
+    (void)memset(&ntfStat, 0, sizeof(ntfStat));
+}
+
+
+/*******************************************************************************
+* Function Name: NtfStatBuildStart
+********************************************************************************
+*
+* Summary:
+*   Marks the beginning of a PDU build.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void NtfStatBuildStart(void)
+{
+    if(0u == ntfStatSysTickRun)
+    {
+        NtfStatSysTickStart();
+    }
+    ntfStatBuildStart = CySysTickGetValue();
+}
+
+
+/*******************************************************************************
+* Function Name: NtfStatBuildEnd
+********************************************************************************
+*
+* Summary:
+*   Marks the end of a PDU build and accumulates the elapsed cycles.
+*   The SysTick counts down, so the elapsed time is start - end modulo 2^24.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void NtfStatBuildEnd(void)
+{
+    uint32 cycles = (ntfStatBuildStart - CySysTickGetValue()) & CY_SYS_SYST_CVR_CNT_MASK;
+
+    ntfStat.buildCount++;
+    ntfStat.buildCycles += cycles;
+    if(cycles > ntfStat.buildCyclesMax)
+    {
+        ntfStat.buildCyclesMax = cycles;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: NtfStatBusyPoll
+********************************************************************************
+*
+* Summary:
+*   Counts one iteration of the "wait while the stack is busy" loop.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void NtfStatBusyPoll(void)
+{
+    ntfStat.busyPolls++;
+}
+
+
+/*******************************************************************************
+* Function Name: NtfStatSent
+********************************************************************************
+*
+* Summary:
+*   Accounts the result of a CyBle_*SendNotification() or
+*   CyBle_*SendIndication() call.
+*
+* Parameters:
+*   result - the value returned by the send API.
+*   length - the length of the PDU.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void NtfStatSent(CYBLE_API_RESULT_T result, uint16 length)
+{
+    if(CYBLE_ERROR_OK == result)
+    {
+        ntfStat.ntfCount++;
+        ntfStat.ntfBytes += length;
+    }
+    else
+    {
+        ntfStat.ntfErrors++;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: NtfStatTick
+********************************************************************************
+*
+* Summary:
+*   Advances the statistics time base. Must be called every second from the
+*   WDT interrupt.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void NtfStatTick(void)
+{
+    ntfStatSeconds++;
+}
+
+
+/*******************************************************************************
+* Function Name: NtfStatProcess
+********************************************************************************
+*
+* Summary:
+*   Prints the averaged statistics every NTF_STAT_REPORT_PERIOD seconds and
+*   restarts the accumulation. Called from the main loop.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void NtfStatProcess(void)
+{
+    uint32 seconds;
+    uint8 interruptStatus;
+
+    interruptStatus = CyEnterCriticalSection();
+    seconds = ntfStatSeconds;
+    if(seconds >= NTF_STAT_REPORT_PERIOD)
+    {
+        ntfStatSeconds = 0u;
+    }
+    CyExitCriticalSection(interruptStatus);
+
+    if(seconds >= NTF_STAT_REPORT_PERIOD)
+    {
+        DBG_PRINTF("Ntf stat: %ld ntf/s, %ld B/s, errors: %ld, busy polls: %ld \r\n",
+            ntfStat.ntfCount / seconds, ntfStat.ntfBytes / seconds, ntfStat.ntfErrors, ntfStat.busyPolls);
+        if(0u != ntfStat.buildCount)
+        {
+            DBG_PRINTF("PDU build: avg %ld, max %ld cycles \r\n",
+                ntfStat.buildCycles / ntfStat.buildCount, ntfStat.buildCyclesMax);
+        }
+        NtfStatReset();
+    }
+}
+
+
+/* [] END OF FILE */
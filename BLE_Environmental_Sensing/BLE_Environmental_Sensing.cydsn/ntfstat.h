@@ -0,0 +1,95 @@
+/*******************************************************************************
+* File Name: ntfstat.h
+*
+* Version 1.0
+*
+* Description:
+*  Contains the function prototypes and constants of the notification
+*  throughput statistics.
+*
+* Hardware Dependency:
+*  CY8CKIT-042 BLE
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(NTFSTAT_H)
+#define NTFSTAT_H
+
+#include <project.h>
+
+
+/***************************************
+* Conditional Compilation Parameters
+***************************************/
+#if !defined(NTF_STAT_ENABLED)
+    #define NTF_STAT_ENABLED                (NO)
+#endif /* !defined(NTF_STAT_ENABLED) */
+
+
+/***************************************
+*        Constants
+***************************************/
+#define NTF_STAT_REPORT_PERIOD              (10u)   /* Seconds between two reports */
+
+
+/***************************************
+*        Data Struct Definition
+***************************************/
+typedef struct
+{
+    uint32 ntfCount;        /* Notifications and indications accepted by the stack */
+    uint32 ntfBytes;        /* Sum of the accepted PDU lengths */
+    uint32 ntfErrors;       /* Send API calls that returned an error */
+    uint32 busyPolls;       /* CyBle_ProcessEvents() calls spent waiting for a free TX buffer */
+    uint32 buildCount;      /* Number of measured PDU builds */
+    uint32 buildCycles;     /* SysTick cycles spent building PDUs */
+    uint32 buildCyclesMax;  /* Longest PDU build */
+} NTF_STAT_T;
+
+
+/***************************************
+*      API Function Prototypes
+***************************************/
+void NtfStatReset(void);
+void NtfStatBuildStart(void);
+void NtfStatBuildEnd(void);
+void NtfStatBusyPoll(void);
+void NtfStatSent(CYBLE_API_RESULT_T result, uint16 length);
+void NtfStatTick(void);
+void NtfStatProcess(void);
+
+
+/***************************************
+*        Macros
+***************************************/
+#if (NTF_STAT_ENABLED == YES)
+    #define NTF_STAT_BUILD_START()          NtfStatBuildStart()
+    #define NTF_STAT_BUILD_END()            NtfStatBuildEnd()
+    #define NTF_STAT_BUSY_POLL()            NtfStatBusyPoll()
+    #define NTF_STAT_SENT(result, length)   NtfStatSent((result), (length))
+    #define NTF_STAT_TICK()                 NtfStatTick()
+    #define NTF_STAT_PROCESS()              NtfStatProcess()
+#else
+    #define NTF_STAT_BUILD_START()
+    #define NTF_STAT_BUILD_END()
+    #define NTF_STAT_BUSY_POLL()
+    #define NTF_STAT_SENT(result, length)
+    #define NTF_STAT_TICK()
+    #define NTF_STAT_PROCESS()
+#endif /* (NTF_STAT_ENABLED == YES) */
+
+
+/***************************************
+*      External data references
+***************************************/
+extern NTF_STAT_T ntfStat;
+
+
+#endif /* NTFSTAT_H */
+
+/* [] END OF FILE */
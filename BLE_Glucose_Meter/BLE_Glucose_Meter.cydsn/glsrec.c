@@ -0,0 +1,505 @@
+/*******************************************************************************
+* File Name: glsrec.c
+*
+* Version 1.0
+*
+* Description:
+*  This file contains the Glucose record store. Every record gets a 32-bit
+*  time key (seconds since GLS_REC_EPOCH_YEAR) and a place in the time index,
+*  which is kept sorted by the key. The time filters of the RACP are
+*  resolved by a binary search.
+*
+*  The records themselves are only stored in the flash record log. A record
+*  is addressed by its position in the log, and its sequence number is the
+*  low 16 bits of the position. RAM only holds the time keys and the time
+*  index of all the records of the log, [recLogTail, recLogHead).
+*
+*  The sequence numbers wrap after 65535, so they are ordered by their
+*  offset from the sequence number of the oldest record, see
+*  GLS_REC_SEQ_OFFSET(). The sequence number filters of the RACP map to the
+*  positions directly.
+*
+*  When the log drops its oldest row, the records of the row stay in the
+*  time index and the lookups skip them until the index is full. Then all
+*  the dropped records are removed in one pass, which is done once per
+*  GLS_REC_KEYS - REC_LOG_ROWS * REC_LOG_REC_PER_ROW new records.
+*
+* Hardware Dependency:
+*  CY8CKIT-042 BLE
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include "main.h"
+
+
+uint32 glsRecKey[GLS_REC_KEYS];                 /* Time keys by GLS_REC_KEY_SLOT() */
+
+static uint16 glsRecTimeIdx[GLS_REC_KEYS];      /* Key slots sorted by the time key */
+static uint16 glsRecTimeNum = 0u;               /* Entries of the time index, dropped records included */
+
+/* The time index holds every record of the log. REC_LOG_REC_PER_ROW depends
+*  on sizeof(GLS_REC_LOG_T), so the build fails on a negative array size
+*  rather than on #error.
+*/
+typedef uint8 GLS_REC_KEYS_CHECK_T[((REC_LOG_ROWS * REC_LOG_REC_PER_ROW) < GLS_REC_KEYS) ? 1 : -1];
+
+static const uint16 glsRecDaysBeforeMonth[12u] =
+{
+    0u, 31u, 59u, 90u, 120u, 151u, 181u, 212u, 243u, 273u, 304u, 334u
+};
+
+
+/*******************************************************************************
+* Function Name: GlsRecTimeToKey
+********************************************************************************
+*
+* Summary:
+*   Converts the date and time to the number of seconds elapsed since
+*   1 Jan of GLS_REC_EPOCH_YEAR. Comparing two keys gives the same result
+*   as comparing the dates field by field. The "unknown" month and day
+*   (value 0) are treated as the first month and the first day.
+*
+* Parameters:
+*   time - the date and time to convert.
+*
+* Return:
+*   uint32 - the time key.
+*
+*******************************************************************************/
+uint32 GlsRecTimeToKey(const CYBLE_DATE_TIME_T *time)
+{
+    uint32 days = 0u;
+    uint32 years;
+    uint8 month = time->month;
+
+    if(time->year > GLS_REC_EPOCH_YEAR)
+    {
+        years = (uint32)time->year - GLS_REC_EPOCH_YEAR;
+
+        /* The epoch year is a leap year, so count the leap years in [epoch, year) */
+        days = (years * 365u) + ((years + 3u) / 4u) - ((years + 99u) / 100u) + ((years + 399u) / 400u);
+    }
+
+    if(month > 12u)
+    {
+        month = 12u;
+    }
+
+    if(month > 0u)
+    {
+        days += glsRecDaysBeforeMonth[month - 1u];
+
+        if((month > 2u) && ((time->year % 4u) == 0u) &&
+           (((time->year % 100u) != 0u) || ((time->year % 400u) == 0u)))
+        {
+            days++;
+        }
+    }
+
+    if(time->day > 0u)
+    {
+        days += (uint32)time->day - 1u;
+    }
+
+    return((((((days * 24u) + time->hours) * 60u) + time->minutes) * 60u) + time->seconds);
+}
+
+
+/*******************************************************************************
+* Function Name: GlsRecKeyToTime
+********************************************************************************
+*
+* Summary:
+*   Converts the time key back to the date and time.
+*
+* Parameters:
+*   key  - the time key.
+*   time - returns the date and time.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void GlsRecKeyToTime(uint32 key, CYBLE_DATE_TIME_T *time)
+{
+    uint32 days = key / 86400u;
+    uint32 secs = key % 86400u;
+    uint16 year = GLS_REC_EPOCH_YEAR;
+    uint16 yearDays = 366u;     /* The epoch year is a leap year */
+    uint8 month = 1u;
+    uint8 leap;
+
+    while(days >= yearDays)
+    {
+        days -= yearDays;
+        year++;
+        yearDays = (((year % 4u) == 0u) && (((year % 100u) != 0u) || ((year % 400u) == 0u))) ? 366u : 365u;
+    }
+    leap = (366u == yearDays) ? 1u : 0u;
+
+    /* The leap day only counts for the months after February */
+    while((month < 12u) && (days >= (glsRecDaysBeforeMonth[month] + ((month >= 2u) ? leap : 0u))))
+    {
+        month++;
+    }
+    days -= glsRecDaysBeforeMonth[month - 1u] + ((month > 2u) ? leap : 0u);
+
+    time->year = year;
+    time->month = month;
+    time->day = (uint8)(days + 1u);
+    time->hours = (uint8)(secs / 3600u);
+    time->minutes = (uint8)((secs / 60u) % 60u);
+    time->seconds = (uint8)(secs % 60u);
+}
+
+
+/*******************************************************************************
+* Function Name: GlsRecKeyPos
+********************************************************************************
+*
+* Summary:
+*   Returns the log position of the record of the key slot. The time index
+*   only holds the records of the last GLS_REC_KEYS positions, so the
+*   position is the most recent one that maps to the slot.
+*
+* Parameters:
+*   slot - the key slot.
+*
+* Return:
+*   uint32 - the log position.
+*
+*******************************************************************************/
+static uint32 GlsRecKeyPos(uint16 slot)
+{
+    return(recLogHead - 1u - ((recLogHead - 1u - slot) & (GLS_REC_KEYS - 1u)));
+}
+
+
+/*******************************************************************************
+* Function Name: GlsRecCompact
+********************************************************************************
+*
+* Summary:
+*   Removes the dropped records from the time index.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+static void GlsRecCompact(void)
+{
+    uint16 i;
+    uint16 num = 0u;
+
+    for(i = 0u; i < glsRecTimeNum; i++)
+    {
+        if(GlsRecKeyPos(glsRecTimeIdx[i]) >= recLogTail)
+        {
+            glsRecTimeIdx[num] = glsRecTimeIdx[i];
+            num++;
+        }
+    }
+
+    glsRecTimeNum = num;
+}
+
+
+/*******************************************************************************
+* Function Name: GlsRecIndex
+********************************************************************************
+*
+* Summary:
+*   Inserts a record into the time index. The records are inserted in the
+*   order of their positions, and records with equal keys keep that order.
+*   When the index is full, the dropped records are removed first, so the
+*   key slot of the new record is not in use.
+*
+* Parameters:
+*   pos  - the position of the record, following the indexed ones.
+*   time - the base time of the record.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+static void GlsRecIndex(uint32 pos, const CYBLE_DATE_TIME_T *time)
+{
+    uint16 lo = 0u;
+    uint16 hi;
+    uint16 mid;
+    uint32 key = GlsRecTimeToKey(time);
+
+    /* The index holds the GLS_REC_KEYS - 1 positions before pos */
+    if((GLS_REC_KEYS - 1u) == glsRecTimeNum)
+    {
+        GlsRecCompact();
+    }
+    glsRecKey[GLS_REC_KEY_SLOT(pos)] = key;
+
+    /* Upper bound of the key, the new record is usually the latest one */
+    hi = glsRecTimeNum;
+    while(lo < hi)
+    {
+        mid = lo + ((hi - lo) >> 1u);
+        if(glsRecKey[glsRecTimeIdx[mid]] <= key)
+        {
+            lo = mid + 1u;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+
+    (void)memmove(&glsRecTimeIdx[lo + 1u], &glsRecTimeIdx[lo], (glsRecTimeNum - lo) * sizeof(glsRecTimeIdx[0u]));
+    glsRecTimeIdx[lo] = (uint16)GLS_REC_KEY_SLOT(pos);
+    glsRecTimeNum++;
+}
+
+
+/*******************************************************************************
+* Function Name: GlsRecInit
+********************************************************************************
+*
+* Summary:
+*   Builds the time index of the records of the flash record log. If the
+*   log is empty, the simulated records are stored to it.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void GlsRecInit(void)
+{
+    GLS_REC_LOG_T logRec;
+    uint32 pos;
+    uint16 i;
+
+    RecLogInit();
+    glsRecTimeNum = 0u;
+
+    if(recLogHead == recLogTail)
+    {
+        for(i = 0u; i < CYBLE_GLS_REC_NUM; i++)
+        {
+            (void)GlsRecAdd(&glsSimGlucose[i], &glsSimGluCont[i]);
+        }
+    }
+    else
+    {
+        for(pos = recLogTail; pos < recLogHead; pos++)
+        {
+            RecLogRead(pos, &logRec);
+            GlsRecIndex(pos, &logRec.glmt.baseTime);
+        }
+        DBG_PRINTF("Glucose records restored: %ld \r\n", recLogHead - recLogTail);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: GlsRecAdd
+********************************************************************************
+*
+* Summary:
+*   Appends a new record to the flash record log and to the time index. The
+*   sequence number of the record is set from its position. When the log is
+*   full, its oldest row is dropped.
+*
+* Parameters:
+*   glmt - the Glucose Measurement value.
+*   glmc - the Glucose Measurement Context value, used when the
+*          CYBLE_GLS_GLMT_FLG_CIF flag is set.
+*
+* Return:
+*   uint32 - the position of the new record or GLS_REC_INVALID if the flash
+*            write failed.
+*
+*******************************************************************************/
+uint32 GlsRecAdd(const CYBLE_GLS_GLMT_T *glmt, const CYBLE_GLS_GLMC_T *glmc)
+{
+    GLS_REC_LOG_T logRec;
+    uint32 pos = GLS_REC_INVALID;
+
+    logRec.glmt = *glmt;
+    logRec.glmt.seqNum = LO16(recLogHead);
+    logRec.glmc = *glmc;
+    logRec.glmc.seqNum = LO16(recLogHead);
+
+    if(CYRET_SUCCESS == RecLogAppend(&logRec))
+    {
+        pos = recLogHead - 1u;
+        GlsRecIndex(pos, &logRec.glmt.baseTime);
+    }
+
+    return(pos);
+}
+
+
+/*******************************************************************************
+* Function Name: GlsRecDelete
+********************************************************************************
+*
+* Summary:
+*   Marks the record as deleted in the flash record log.
+*
+* Parameters:
+*   pos - the position of the record.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void GlsRecDelete(uint32 pos)
+{
+    if((pos >= recLogTail) && (pos < recLogHead))
+    {
+        RecLogDelete(pos);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: GlsRecIsValid
+********************************************************************************
+*
+* Summary:
+*   Checks whether the record is in the log and not deleted.
+*
+* Parameters:
+*   pos - the position of the record.
+*
+* Return:
+*   Non-zero if the record is valid.
+*
+*******************************************************************************/
+uint8 GlsRecIsValid(uint32 pos)
+{
+    uint8 valid = 0u;
+
+    if((pos >= recLogTail) && (pos < recLogHead) && (0u == RecLogIsDeleted(pos)))
+    {
+        valid = 1u;
+    }
+
+    return(valid);
+}
+
+
+/*******************************************************************************
+* Function Name: GlsRecFindSeq
+********************************************************************************
+*
+* Summary:
+*   Finds the records with the sequence numbers within the range (inclusive).
+*   The sequence numbers are ordered by GLS_REC_SEQ_OFFSET(), so the range
+*   may cross the wrap of the sequence numbers. The range may include
+*   deleted records.
+*
+* Parameters:
+*   minSeqNum - the lowest sequence number.
+*   maxSeqNum - the highest sequence number.
+*   last      - returns the position of the last matching record.
+*
+* Return:
+*   uint32 - the position of the first matching record or GLS_REC_INVALID
+*            if no record matches.
+*
+*******************************************************************************/
+uint32 GlsRecFindSeq(uint16 minSeqNum, uint16 maxSeqNum, uint32 *last)
+{
+    int32 minOffset = GLS_REC_SEQ_OFFSET(minSeqNum);
+    int32 maxOffset = GLS_REC_SEQ_OFFSET(maxSeqNum);
+    int32 count = (int32)(recLogHead - recLogTail);
+    uint32 first = GLS_REC_INVALID;
+
+    /* The sequence numbers before the oldest record or after the newest one */
+    if(minOffset < 0)
+    {
+        minOffset = 0;
+    }
+    if(maxOffset >= count)
+    {
+        maxOffset = count - 1;
+    }
+
+    if(minOffset <= maxOffset)
+    {
+        first = recLogTail + (uint32)minOffset;
+        *last = recLogTail + (uint32)maxOffset;
+    }
+
+    return(first);
+}
+
+
+/*******************************************************************************
+* Function Name: GlsRecFindTime
+********************************************************************************
+*
+* Summary:
+*   Finds the first valid record, in the chronological order, with the time
+*   key within the range (inclusive). Of the records with the key equal to
+*   minKey, only the ones at minPos and after are taken. So the records of
+*   a range are iterated by passing the key and the position + 1 of the
+*   previous one.
+*
+* Parameters:
+*   minKey - the lowest time key.
+*   minPos - the lowest position of a record with the key equal to minKey.
+*   maxKey - the highest time key.
+*
+* Return:
+*   uint32 - the position of the record or GLS_REC_INVALID if no record
+*            matches.
+*
+*******************************************************************************/
+uint32 GlsRecFindTime(uint32 minKey, uint32 minPos, uint32 maxKey)
+{
+    uint16 lo = 0u;
+    uint16 hi = glsRecTimeNum;
+    uint16 mid;
+    uint32 key;
+    uint32 pos = GLS_REC_INVALID;
+
+    /* Lower bound of (minKey, minPos) */
+    while(lo < hi)
+    {
+        mid = lo + ((hi - lo) >> 1u);
+        key = glsRecKey[glsRecTimeIdx[mid]];
+        if((key < minKey) || ((key == minKey) && (GlsRecKeyPos(glsRecTimeIdx[mid]) < minPos)))
+        {
+            lo = mid + 1u;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+
+    /* The dropped and the deleted records are skipped */
+    while((GLS_REC_INVALID == pos) && (lo < glsRecTimeNum) && (glsRecKey[glsRecTimeIdx[lo]] <= maxKey))
+    {
+        if(0u != GlsRecIsValid(GlsRecKeyPos(glsRecTimeIdx[lo])))
+        {
+            pos = GlsRecKeyPos(glsRecTimeIdx[lo]);
+        }
+        lo++;
+    }
+
+    return(pos);
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,80 @@
+/*******************************************************************************
+* File Name: glsrec.h
+*
+* Version 1.0
+*
+* Description:
+*  Contains the function prototypes and constants of the Glucose record store.
+*
+* Hardware Dependency:
+*  CY8CKIT-042 BLE
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(GLSREC_H)
+#define GLSREC_H
+
+#include "main.h"
+
+
+/***************************************
+*        Constants
+***************************************/
+#define GLS_REC_EPOCH_YEAR          (2000u)     /* Time keys count seconds from 1 Jan of this year */
+#define GLS_REC_INVALID             (0xFFFFFFFFu)   /* Returned when no record matches */
+
+/* Time keys kept in RAM, a power of 2 greater than the number of records of
+ * the log, REC_LOG_ROWS * REC_LOG_REC_PER_ROW, which glsrec.c checks. The
+ * time index keeps the dropped records until it is full.
+ */
+#define GLS_REC_KEYS                (512u)
+
+/* Key slot and sequence number of the record at the log position pos */
+#define GLS_REC_KEY_SLOT(pos)       ((pos) & (GLS_REC_KEYS - 1u))
+#define GLS_REC_SEQ_NUM(pos)        LO16(pos)
+
+/* Order of a sequence number across the wrap after 65535: its offset from the
+ * oldest record of the log. The numbers up to half of the sequence space
+ * behind the oldest record are before the log, the others after it.
+ */
+#define GLS_REC_SEQ_OFFSET(seqNum)  ((int32)(int16)(uint16)((uint16)(seqNum) - GLS_REC_SEQ_NUM(recLogTail)))
+
+
+/***************************************
+*        Data Struct Definition
+***************************************/
+/* The record as it is stored in the flash log */
+typedef struct
+{
+    CYBLE_GLS_GLMT_T glmt;
+    CYBLE_GLS_GLMC_T glmc;
+} GLS_REC_LOG_T;
+
+
+/***************************************
+*      API Function Prototypes
+***************************************/
+void GlsRecInit(void);
+uint32 GlsRecAdd(const CYBLE_GLS_GLMT_T *glmt, const CYBLE_GLS_GLMC_T *glmc);
+void GlsRecDelete(uint32 pos);
+uint8 GlsRecIsValid(uint32 pos);
+uint32 GlsRecTimeToKey(const CYBLE_DATE_TIME_T *time);
+void GlsRecKeyToTime(uint32 key, CYBLE_DATE_TIME_T *time);
+uint32 GlsRecFindSeq(uint16 minSeqNum, uint16 maxSeqNum, uint32 *last);
+uint32 GlsRecFindTime(uint32 minKey, uint32 minPos, uint32 maxKey);
+
+
+/***************************************
+*      External data references
+***************************************/
+extern uint32 glsRecKey[GLS_REC_KEYS];
+
+
+#endif /* GLSREC_H */
+
+/* [] END OF FILE */
@@ -29,28 +29,33 @@ uint16 seqNum2;
 CYBLE_DATE_TIME_T userFacingTime1;
 CYBLE_DATE_TIME_T userFacingTime2;
 uint8 racpInd[4u];
-uint8 recCnt = 1u;
-
-
-/* Record Status array */
-uint8 recStat[CYBLE_GLS_REC_NUM] =
-{
-    CYBLE_GLS_REC_STAT_OK,
-    CYBLE_GLS_REC_STAT_OK,
-    CYBLE_GLS_REC_STAT_OK,
-    CYBLE_GLS_REC_STAT_OK,
-    CYBLE_GLS_REC_STAT_OK,
-    CYBLE_GLS_REC_STAT_OK,
-    CYBLE_GLS_REC_STAT_OK,
-    CYBLE_GLS_REC_STAT_OK,
-    CYBLE_GLS_REC_STAT_OK,
-    CYBLE_GLS_REC_STAT_OK,
-    CYBLE_GLS_REC_STAT_OK
-};
-
-
-/* Glucose Measurement records */
-CYBLE_GLS_GLMT_T glsGlucose[CYBLE_GLS_REC_NUM] =
+uint16 recCnt = 1u;
+
+/* Records selected by the RACP request, either the positions [rptPos, rptEnd)
+ * or the time keys [rptKey, rptKeyMax) from the position rptPos. The report
+ * is sent from the main loop, one record at a time.
+ */
+uint8 rptByTime = 0u;       /* Records are selected by the time keys */
+uint32 rptPos = 0u;         /* Position of the next record to check */
+uint32 rptEnd = 0u;         /* Position following the selected ones */
+uint32 rptKey = 0u;         /* Time key of the next record to check */
+uint32 rptKeyMax = 0u;      /* Highest selected time key */
+uint32 rptCur = GLS_REC_INVALID;    /* Position of the record being sent */
+GLS_REC_LOG_T rptRec;       /* The record being sent */
+uint8 rptGlmcPending = 0u;  /* Measurement of rptRec is sent, its context is not */
+uint8 racpIndPending = 0u;  /* RACP indication is sent when the report is complete */
+
+/* uint8 GlsPackGlmt(uint8 pdu[], const CYBLE_GLS_GLMT_T *value, uint32 flags) */
+PDU_DEFINE_PACK(GlsPackGlmt, CYBLE_GLS_GLMT_T, GLS_GLMT_FIELDS)
+
+/* uint8 GlsPackGlmc(uint8 pdu[], const CYBLE_GLS_GLMC_T *value, uint32 flags) */
+PDU_DEFINE_PACK(GlsPackGlmc, CYBLE_GLS_GLMC_T, GLS_GLMC_FIELDS)
+
+
+/* Simulated Glucose Measurement records, they seed an empty record log and
+ * are the values of the new measurements
+ */
+const CYBLE_GLS_GLMT_T glsSimGlucose[CYBLE_GLS_REC_NUM] =
 {
     {CYBLE_GLS_GLMT_FLG_TOP | CYBLE_GLS_GLMT_FLG_SSA,
         0u, {2014u, 7u, 27, 20u, 30u, 40u}, 0, 0xb032u /* 50 mg/dL */,
@@ -88,8 +93,8 @@ CYBLE_GLS_GLMT_T glsGlucose[CYBLE_GLS_REC_NUM] =
 };
 
 
-/* Glucose Measurement Context records */
-CYBLE_GLS_GLMC_T glsGluCont[CYBLE_GLS_REC_NUM] =
+/* Simulated Glucose Measurement Context records */
+const CYBLE_GLS_GLMC_T glsSimGluCont[CYBLE_GLS_REC_NUM] =
 {
     {CYBLE_GLS_GLMC_FLG_EXT, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u},
     {CYBLE_GLS_GLMC_FLG_CBID | CYBLE_GLS_GLMC_FLG_MEAL | CYBLE_GLS_GLMC_FLG_TNH |
@@ -159,7 +164,7 @@ void Operand(uint8* val)
         }
         DBG_PRINTF("\r\n");
     }
-    else if(CYBLE_GLS_RACP_OPD_1 == racpFilterType)
+    else if(CYBLE_GLS_RACP_OPD_2 == racpFilterType)
     {
         DBG_PRINTF("User Facing Time \r\n");
         userFacingTime1.year = CyBle_Get16ByPtr(&val[3u]);
@@ -205,12 +210,13 @@ void Operand(uint8* val)
 *******************************************************************************
 
 Summary:
-  Registers the GlS CallBack.
+  Registers the GlS CallBack and builds the record time index.
 
 ******************************************************************************/
 void GlsInit(void)
 {
     CyBle_GlsRegisterAttrCallback(GlsCallBack);
+    GlsRecInit();
 }
 
 
@@ -412,152 +418,82 @@ void GlsCallBack(uint32 event, void* eventParam)
 ********************************************************************************
 *
 * Summary:
-*   Sends the Glucose Measurement notification and the Glucose Measurement
-*   Context notification (if the appropriate bit is set).
+*   Sends the Glucose Measurement notification.
 *
 * Parameters:
-*   uint8 num - number of record to notify.
+*   const CYBLE_GLS_GLMT_T *glmt - the measurement to notify.
 *
 * Return:
-*   None
+*   CYBLE_API_RESULT_T - the result of CyBle_GlssSendNotification().
 *
 *******************************************************************************/
-void GlsNtf(uint8 num)
+CYBLE_API_RESULT_T GlsNtf(const CYBLE_GLS_GLMT_T *glmt)
 {
     uint8 pdu[sizeof(CYBLE_GLS_GLMT_T)]; /* GLMC size is also 17 bytes */
     uint8 ptr;
 
-    /* flags field is always the first byte */
-    pdu[0u] = glsGlucose[num].flags;
-
-    /* Sequence number is always the second and third bytes */
-    CyBle_Set16ByPtr(&pdu[1u], glsGlucose[num].seqNum);
-
-    /* Base Time consumes the next seven bytes */
-    (void)memcpy(&pdu[3u], &glsGlucose[num].baseTime, sizeof(glsGlucose[num].baseTime));
+    NTF_STAT_BUILD_START();
 
-    ptr = 10u; /* 3 + 7 (size of baseTime) */
-
-    /* if the Time Offset Present flag is set */
-    if(0u != (glsGlucose[num].flags & CYBLE_GLS_GLMT_FLG_TOP))
-    {
-        /* and set the full 2-bytes Time Offset value */
-        (void)memcpy(&pdu[ptr], &glsGlucose[num].timeOffset, sizeof(glsGlucose[num].timeOffset));
-        /* the next data will be located beginning from 3rd byte */
-        ptr += sizeof(glsGlucose[num].timeOffset);
-    }
+    ptr = GlsPackGlmt(pdu, glmt, glmt->flags);
 
+    NTF_STAT_BUILD_END();
 
-    if(0u != (glsGlucose[num].flags & CYBLE_GLS_GLMT_FLG_GLC))
-    {
-        (void)memcpy(&pdu[ptr], &glsGlucose[num].gluConc, sizeof(glsGlucose[num].gluConc));
-        ptr += sizeof(glsGlucose[num].gluConc);
-        pdu[ptr] = glsGlucose[num].tnsl;
-        ptr += 1u; /* uint8 tnsl */
-    }
-
-    if(0u != (glsGlucose[num].flags & CYBLE_GLS_GLMT_FLG_SSA))
-    {
-        (void)memcpy(&pdu[ptr], &glsGlucose[num].ssa, sizeof(glsGlucose[num].ssa));
-        ptr += 2u; /* uint16 ssa */
-    }
-    
-    do
-    {
-        CyBle_ProcessEvents();
-    }
-    while(CyBle_GattGetBusyStatus() == CYBLE_STACK_STATE_BUSY);
+    apiResult = CyBle_GlssSendNotification(cyBle_connHandle, CYBLE_GLS_GLMT, ptr, pdu);
+    NTF_STAT_SENT(apiResult, ptr);
 
-    if(CYBLE_ERROR_OK != (apiResult = CyBle_GlssSendNotification(cyBle_connHandle, CYBLE_GLS_GLMT, ptr, pdu)))
+    if(CYBLE_ERROR_OK != apiResult)
     {
         DBG_PRINTF("CyBle_GlssSendNotification API Error: ");
         PrintApiResult();
     }
     else
     {
-        DBG_PRINTF("Glucose Ntf: %d \r\n", glsGlucose[num].seqNum);
-        racpInd[3] = CYBLE_GLS_RACP_RSP_SUCCESS;
+        DBG_PRINTF("Glucose Ntf: %d \r\n", glmt->seqNum);
     }
 
-    if(0u != (glsGlucose[num].flags & CYBLE_GLS_GLMT_FLG_CIF))
-    {
-        /* flags field is always the first byte */
-        pdu[0u] = glsGluCont[num].flags;
-
-        /* Sequence number is always the second and third bytes */
-        CyBle_Set16ByPtr(&pdu[1u], glsGluCont[num].seqNum);
+    return(apiResult);
+}
 
-        /* if the Time Offset Present flag is set */
-        if(0u != (glsGluCont[num].flags & CYBLE_GLS_GLMC_FLG_EXT))
-        {
-            /* and set the 1-byte Extended Flags */
-            pdu[3u] = glsGluCont[num].exFlags;
-            /* the next data will be located beginning from 3rd byte */
-            ptr = 4u;
-        }
-        else
-        {
-            ptr = 3u; /* otherwise the next data will be located beginning from 2nd byte */
-        }
 
-        if(0u != (glsGluCont[num].flags & CYBLE_GLS_GLMC_FLG_CBID))
-        {
-            pdu[ptr] = glsGluCont[num].cbId;
-            ptr += 1u; /* uint8 cbId */
-            (void)memcpy(&pdu[ptr], &glsGluCont[num].cbhdr, sizeof(glsGluCont[num].cbhdr));
-            ptr += sizeof(glsGluCont[num].cbhdr);
-        }
+/*******************************************************************************
+* Function Name: GlsNtfCont
+********************************************************************************
+*
+* Summary:
+*   Sends the Glucose Measurement Context notification.
+*
+* Parameters:
+*   const CYBLE_GLS_GLMC_T *glmc - the measurement context to notify.
+*
+* Return:
+*   CYBLE_API_RESULT_T - the result of CyBle_GlssSendNotification().
+*
+*******************************************************************************/
+CYBLE_API_RESULT_T GlsNtfCont(const CYBLE_GLS_GLMC_T *glmc)
+{
+    uint8 pdu[sizeof(CYBLE_GLS_GLMC_T)];
+    uint8 ptr;
 
-        if(0u != (glsGluCont[num].flags & CYBLE_GLS_GLMC_FLG_MEAL))
-        {
-            pdu[ptr] = glsGluCont[num].meal;
-            ptr += 1u; /* uint8 meal */
-        }
+    NTF_STAT_BUILD_START();
 
-        if(0u != (glsGluCont[num].flags & CYBLE_GLS_GLMC_FLG_TNH))
-        {
-            pdu[ptr] = glsGluCont[num].tnh;
-            ptr += 1u; /* uint8 tnh */
-        }
+    ptr = GlsPackGlmc(pdu, glmc, glmc->flags);
 
-        if(0u != (glsGluCont[num].flags & CYBLE_GLS_GLMC_FLG_EXR))
-        {
-            CyBle_Set16ByPtr(&pdu[ptr], glsGluCont[num].exDur);
-            ptr += 2u; /* uint16 exDur */
-            pdu[ptr] = glsGluCont[num].exInt;
-            ptr += 1u; /* uint8 exInt */
-        }
+    NTF_STAT_BUILD_END();
 
-        if(0u != (glsGluCont[num].flags & CYBLE_GLS_GLMC_FLG_MED))
-        {
-            pdu[ptr] = glsGluCont[num].medId;
-            ptr += 1u; /* uint8 medId */
-            (void)memcpy(&pdu[ptr], &glsGluCont[num].medic, sizeof(glsGluCont[num].medic));
-            ptr += sizeof(glsGluCont[num].medic);
-        }
+    apiResult = CyBle_GlssSendNotification(cyBle_connHandle, CYBLE_GLS_GLMC, ptr, pdu);
+    NTF_STAT_SENT(apiResult, ptr);
 
-        if(0u != (glsGluCont[num].flags & CYBLE_GLS_GLMC_FLG_A1C))
-        {
-            (void)memcpy(&pdu[ptr], &glsGluCont[num].hba1c, sizeof(glsGluCont[num].hba1c));
-            ptr += sizeof(glsGluCont[num].hba1c);
-        }
-        
-        do
-        {
-            CyBle_ProcessEvents();
-        }
-        while(CyBle_GattGetBusyStatus() == CYBLE_STACK_STATE_BUSY);
-        
-        if(CYBLE_ERROR_OK != (apiResult = CyBle_GlssSendNotification(cyBle_connHandle, CYBLE_GLS_GLMC, ptr, pdu)))
-        {
-            DBG_PRINTF("CyBle_GlssSendNotification API Error: ");
+    if(CYBLE_ERROR_OK != apiResult)
+    {
+        DBG_PRINTF("CyBle_GlssSendNotification API Error: ");
         PrintApiResult();
-        }
-        else
-        {
-            DBG_PRINTF("Glucose Context Ntf: %d \r\n", glsGlucose[num].seqNum);
-        }
     }
+    else
+    {
+        DBG_PRINTF("Glucose Context Ntf: %d \r\n", glmc->seqNum);
+    }
+
+    return(apiResult);
 }
 
 
@@ -572,32 +508,29 @@ void GlsNtf(uint8 num)
 *   None
 *
 * Return:
-*   None
+*   CYBLE_API_RESULT_T - the result of CyBle_GlssSendIndication().
 *
 *******************************************************************************/
-void GlsInd(void)
+CYBLE_API_RESULT_T GlsInd(void)
 {
     racpInd[1] = CYBLE_GLS_RACP_OPR_NULL;
 
     if(CYBLE_GLS_RACP_OPC_REPORT_NUM_REC == racpOpCode)
     {
         racpInd[0] = CYBLE_GLS_RACP_OPC_NUM_REC_RSP;
-        racpInd[2] = recCnt;
-        racpInd[3] = 0;
+        racpInd[2] = LO8(recCnt);
+        racpInd[3] = HI8(recCnt);
     }
     else
     {
         racpInd[0] = CYBLE_GLS_RACP_OPC_RSP_CODE;
         racpInd[2] = racpOpCode;
     }
-    
-    do
-    {
-        CyBle_ProcessEvents();
-    }
-    while(CyBle_GattGetBusyStatus() == CYBLE_STACK_STATE_BUSY);
 
-    if(CYBLE_ERROR_OK != (apiResult = CyBle_GlssSendIndication(cyBle_connHandle, CYBLE_GLS_RACP, 4, racpInd)))
+    apiResult = CyBle_GlssSendIndication(cyBle_connHandle, CYBLE_GLS_RACP, 4, racpInd);
+    NTF_STAT_SENT(apiResult, 4u);
+
+    if(CYBLE_ERROR_OK != apiResult)
     {
         DBG_PRINTF("CyBle_GlssSendIndication API Error: ");
         PrintApiResult();
@@ -606,131 +539,218 @@ void GlsInd(void)
     {
         DBG_PRINTF("RACP Ind: %d %d %d %d \r\n", racpInd[0], racpInd[1], racpInd[2], racpInd[3]);
     }
+
+    return(apiResult);
+}
+
+
+/*******************************************************************************
+* Function Name: GlsRptReset
+********************************************************************************
+*
+* Summary:
+*   Completes the RACP request in progress and drops the records report.
+*   Called when the connection is closed.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void GlsRptReset(void)
+{
+    rptCur = GLS_REC_INVALID;
+    rptGlmcPending = 0u;
+    racpIndPending = 0u;
+    racpCommand = 0u;
+}
+
+
+/*******************************************************************************
+* Function Name: GlsRptNext
+********************************************************************************
+*
+* Summary:
+*   Returns the next valid record selected by the RACP request. The records
+*   selected by the positions come in the order of the sequence numbers, the
+*   ones selected by the time keys in the chronological order.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   uint32 - the position of the record or GLS_REC_INVALID if there are no
+*            more selected records.
+*
+*******************************************************************************/
+uint32 GlsRptNext(void)
+{
+    uint32 pos = GLS_REC_INVALID;
+
+    if(0u != rptByTime)
+    {
+        pos = GlsRecFindTime(rptKey, rptPos, rptKeyMax);
+        if(GLS_REC_INVALID != pos)
+        {
+            rptKey = glsRecKey[GLS_REC_KEY_SLOT(pos)];
+            rptPos = pos + 1u;
+        }
+    }
+    else
+    {
+        while((GLS_REC_INVALID == pos) && (rptPos < rptEnd))
+        {
+            if(0u != GlsRecIsValid(rptPos))
+            {
+                pos = rptPos;
+            }
+            rptPos++;
+        }
+    }
+
+    return(pos);
+}
+
+
+/*******************************************************************************
+* Function Name: GlsRptFetch
+********************************************************************************
+*
+* Summary:
+*   Reads the next record of the report from the flash record log.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void GlsRptFetch(void)
+{
+    rptCur = GlsRptNext();
+    if(GLS_REC_INVALID != rptCur)
+    {
+        RecLogRead(rptCur, &rptRec);
+    }
 }
 
 
 /*******************************************************************************
-* Function Name: TimeComparison
+* Function Name: GlsRptSend
 ********************************************************************************
 *
 * Summary:
-*   Compares the user facing time with time specified in
-*   Glucose measurement record.
+*   Sends the records report without waiting for the stack. As many
+*   notifications are sent as the stack accepts, the rest is sent on the next
+*   calls. When the report is complete, the RACP indication is sent and the
+*   request is completed.
 *
 * Parameters:
-*   CYBLE_DATE_TIME_T glmtTime - Time specified in Glucose measurement record.
-*   CYBLE_DATE_TIME_T userFacingTime - User facing time.
+*   None
 *
 * Return:
-*   CYBLE_DATE_TIME_COMP_T retVal - result of time comparison.
+*   None
 *
 *******************************************************************************/
-CYBLE_DATE_TIME_COMP_T TimeComparison(CYBLE_DATE_TIME_T glmtTime, CYBLE_DATE_TIME_T userFacingTime)
+void GlsRptSend(void)
 {
-    CYBLE_DATE_TIME_COMP_T retVal = CYBLE_TIME_LESS;
+    CYBLE_API_RESULT_T result = CYBLE_ERROR_OK;
 
-    if(glmtTime.year == userFacingTime.year)
+    while((CYBLE_ERROR_MEMORY_ALLOCATION_FAILED != result) && (0u != racpIndPending) &&
+          (CyBle_GattGetBusyStatus() == CYBLE_STACK_STATE_FREE))
     {
-        if(glmtTime.month == userFacingTime.month)
+        if(GLS_REC_INVALID != rptCur)
         {
-            if(glmtTime.day == userFacingTime.day)
+            /* On an error other than the TX buffer overflow the notification is skipped */
+            if(0u == rptGlmcPending)
             {
-                if(glmtTime.hours == userFacingTime.hours)
+                result = GlsNtf(&rptRec.glmt);
+                if(CYBLE_ERROR_MEMORY_ALLOCATION_FAILED != result)
                 {
-                    if(glmtTime.minutes == userFacingTime.minutes)
-                    {
-                        if(glmtTime.seconds == userFacingTime.seconds)
-                        {
-                            retVal = CYBLE_TIME_EQUAL;
-                        }
-                        else if(glmtTime.seconds > userFacingTime.seconds)
-                        {
-                            retVal = CYBLE_TIME_GREAT;
-                        }
-                        else
-                        {
-                            /* CYBLE_TIME_LESS */
-                        }
-                    }
-                    else if(glmtTime.minutes > userFacingTime.minutes)
+                    if((CYBLE_ERROR_OK == result) && (0u != (rptRec.glmt.flags & CYBLE_GLS_GLMT_FLG_CIF)))
                     {
-                        retVal = CYBLE_TIME_GREAT;
+                        rptGlmcPending = 1u;
                     }
                     else
                     {
-                        /* CYBLE_TIME_LESS */
+                        GlsRptFetch();
                     }
                 }
-                else if(glmtTime.hours > userFacingTime.hours)
-                {
-                    retVal = CYBLE_TIME_GREAT;
-                }
-                else
-                {
-                    /* CYBLE_TIME_LESS */
-                }
-            }
-            else if(glmtTime.day > userFacingTime.day)
-            {
-                retVal = CYBLE_TIME_GREAT;
             }
             else
             {
-                /* CYBLE_TIME_LESS */
+                result = GlsNtfCont(&rptRec.glmc);
+                if(CYBLE_ERROR_MEMORY_ALLOCATION_FAILED != result)
+                {
+                    rptGlmcPending = 0u;
+                    GlsRptFetch();
+                }
             }
         }
-        else if(glmtTime.month > userFacingTime.month)
-        {
-            retVal = CYBLE_TIME_GREAT;
-        }
         else
         {
-            /* CYBLE_TIME_LESS */
+            result = GlsInd();
+            if(CYBLE_ERROR_MEMORY_ALLOCATION_FAILED != result)
+            {
+                GlsRptReset();
+            }
         }
     }
-    else if(glmtTime.year > userFacingTime.year)
-    {
-        retVal = CYBLE_TIME_GREAT;
-    }
-    else
+
+    if(0u != racpIndPending)
     {
-        /* CYBLE_TIME_LESS */
+        NTF_STAT_BUSY_POLL();
     }
-
-    return (retVal);
 }
 
+
 /*******************************************************************************
 * Function Name: OpCodeOperation
 ********************************************************************************
 *
 * Summary:
-*   Doing operation in accordance to opcode and status or current record.
+*   Doing operation in accordance to opcode for the selected records. The
+*   report is only started here, GlsRptSend() reads and sends the records.
 *
 * Parameters:
-*   uint8 i - index of record.
+*   None
 *
 * Return:
 *   None
 *
 *******************************************************************************/
-void OpCodeOperation(uint8 i)
+void OpCodeOperation(void)
 {
-    if(CYBLE_GLS_REC_STAT_OK == recStat[i])
+    uint32 pos = GlsRptNext();
+
+    if(GLS_REC_INVALID != pos)
     {
         switch(racpOpCode)
         {
             case CYBLE_GLS_RACP_OPC_REPORT_REC:
-                GlsNtf(i);
+                rptCur = pos;
+                RecLogRead(rptCur, &rptRec);
+                racpInd[3] = CYBLE_GLS_RACP_RSP_SUCCESS;
                 break;
 
             case CYBLE_GLS_RACP_OPC_DELETE_REC:
-                recStat[i] = CYBLE_GLS_REC_STAT_DELETED;
+                while(GLS_REC_INVALID != pos)
+                {
+                    GlsRecDelete(pos);
+                    pos = GlsRptNext();
+                }
                 racpInd[3] = CYBLE_GLS_RACP_RSP_SUCCESS;
                 break;
 
             case CYBLE_GLS_RACP_OPC_REPORT_NUM_REC:
-                recCnt++;
+                while(GLS_REC_INVALID != pos)
+                {
+                    recCnt++;
+                    pos = GlsRptNext();
+                }
                 break;
 
             default:
@@ -740,12 +760,89 @@ void OpCodeOperation(uint8 i)
     }
 }
 
+/*******************************************************************************
+* Function Name: OpCodeOperationPos
+********************************************************************************
+*
+* Summary:
+*   Doing operation for the records at the positions within the range.
+*
+* Parameters:
+*   uint32 first - the first position.
+*   uint32 end - the position following the last one.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void OpCodeOperationPos(uint32 first, uint32 end)
+{
+    rptByTime = 0u;
+    rptPos = first;
+    rptEnd = end;
+    OpCodeOperation();
+}
+
+/*******************************************************************************
+* Function Name: OpCodeOperationSeq
+********************************************************************************
+*
+* Summary:
+*   Doing operation for the records with the sequence numbers within
+*   the range (inclusive).
+*
+* Parameters:
+*   uint16 minSeqNum - the lowest sequence number.
+*   uint16 maxSeqNum - the highest sequence number.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void OpCodeOperationSeq(uint16 minSeqNum, uint16 maxSeqNum)
+{
+    uint32 last;
+    uint32 first = GlsRecFindSeq(minSeqNum, maxSeqNum, &last);
+
+    if(GLS_REC_INVALID != first)
+    {
+        OpCodeOperationPos(first, last + 1u);
+    }
+}
+
+/*******************************************************************************
+* Function Name: OpCodeOperationTime
+********************************************************************************
+*
+* Summary:
+*   Doing operation for the records with the base time within the range
+*   (inclusive), in the chronological order.
+*
+* Parameters:
+*   uint32 minKey - the time key of the earliest time.
+*   uint32 maxKey - the time key of the latest time.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void OpCodeOperationTime(uint32 minKey, uint32 maxKey)
+{
+    rptByTime = 1u;
+    rptKey = minKey;
+    rptPos = 0u;
+    rptKeyMax = maxKey;
+    OpCodeOperation();
+}
+
 /*******************************************************************************
 * Function Name: GlsProcess
 ********************************************************************************
 *
 * Summary:
-*   Processes the GLS RACP request.
+*   Processes the GLS RACP request. All the records of the flash record log
+*   are subject to it. The matching records are sent by GlsRptSend() along
+*   with the RACP indication.
 *
 * Parameters:
 *   None
@@ -756,12 +853,22 @@ void OpCodeOperation(uint8 i)
 *******************************************************************************/
 void GlsProcess(void)
 {
-    if(0u != racpCommand)
+    if((0u != racpIndPending) && (CYBLE_GLS_RACP_OPC_ABORT_OPN == racpOpCode))
     {
-        uint8 i;
-        CyDelay(7);
-        CyBle_ProcessEvents();
+        /* Abort of the records report in progress */
+        rptCur = GLS_REC_INVALID;
+        rptGlmcPending = 0u;
+        racpIndPending = 0u;
+    }
+
+    if((0u != racpCommand) && (0u == racpIndPending))
+    {
+        uint32 pos;
+        uint32 key1;
+        uint32 key2;
 
+        rptCur = GLS_REC_INVALID;
+        rptGlmcPending = 0u;
         recCnt = 0u;
         racpInd[3] = CYBLE_GLS_RACP_RSP_NO_REC;
 
@@ -778,8 +885,6 @@ void GlsProcess(void)
                         racpInd[3] = CYBLE_GLS_RACP_RSP_INV_OPR;
                         break;
                 }
-
-                GlsInd();
                 break;
 
             case CYBLE_GLS_RACP_OPR_LAST:
@@ -789,10 +894,14 @@ void GlsProcess(void)
                 }
                 else
                 {
-                    OpCodeOperation(CYBLE_GLS_REC_NUM - 1);
+                    /* The most recent record that is not deleted */
+                    pos = recLogHead;
+                    while((pos > recLogTail) && (0u == GlsRecIsValid(pos - 1u)))
+                    {
+                        pos--;
+                    }
+                    OpCodeOperationPos(pos - 1u, pos);
                 }
-
-                GlsInd();
                 break;
 
             case CYBLE_GLS_RACP_OPR_FIRST:
@@ -802,10 +911,14 @@ void GlsProcess(void)
                 }
                 else
                 {
-                    OpCodeOperation(0);
+                    /* The oldest record that is not deleted */
+                    pos = recLogTail;
+                    while((pos < recLogHead) && (0u == GlsRecIsValid(pos)))
+                    {
+                        pos++;
+                    }
+                    OpCodeOperationPos(pos, pos + 1u);
                 }
-
-                GlsInd();
                 break;
 
             case CYBLE_GLS_RACP_OPR_ALL:
@@ -815,136 +928,137 @@ void GlsProcess(void)
                 }
                 else
                 {
-                    for(i = 0; i < CYBLE_GLS_REC_NUM; i++)
-                    {
-                        OpCodeOperation(i);
-                    }
+                    OpCodeOperationPos(recLogTail, recLogHead);
                 }
-
-                GlsInd();
                 break;
 
             case CYBLE_GLS_RACP_OPR_LESS:
                 if(CYBLE_GLS_RACP_OPD_1 == racpFilterType)
                 {
-                    if(CYBLE_GLS_REC_NUM > seqNum1)
-                    {
-                        for(i = 0; i <= seqNum1; i++)
-                        {
-                            OpCodeOperation(i);
-                        }
-                    }
+                    OpCodeOperationSeq(GLS_REC_SEQ_NUM(recLogTail), seqNum1);
                 }
                 else if(CYBLE_GLS_RACP_OPD_2 == racpFilterType)
                 {
-                    if(CYBLE_TIME_GREAT == TimeComparison(glsGlucose[CYBLE_GLS_REC_NUM - 1].baseTime, userFacingTime1))
-                    {
-                        for(i = 0; i < CYBLE_GLS_REC_NUM; i++)
-                        {
-                            if(CYBLE_TIME_GREAT != TimeComparison(glsGlucose[i].baseTime, userFacingTime1))
-                            {
-                                OpCodeOperation(i);
-                            }
-                        }
-                    }
+                    OpCodeOperationTime(0u, GlsRecTimeToKey(&userFacingTime1));
                 }
                 else
                 {
                     racpInd[3] = CYBLE_GLS_RACP_RSP_UNSPRT_OPD;
                 }
-                GlsInd();
                 break;
 
             case CYBLE_GLS_RACP_OPR_GREAT:
                 if(CYBLE_GLS_RACP_OPD_1 == racpFilterType)
                 {
-                    if(CYBLE_GLS_REC_NUM > seqNum1)
-                    {
-                        for(i = seqNum1; i < CYBLE_GLS_REC_NUM; i++)
-                        {
-                            OpCodeOperation(i);
-                        }
-                    }
+                    OpCodeOperationSeq(seqNum1, GLS_REC_SEQ_NUM(recLogHead - 1u));
                 }
                 else if(CYBLE_GLS_RACP_OPD_2 == racpFilterType)
                 {
-                    if(CYBLE_TIME_GREAT == TimeComparison(glsGlucose[CYBLE_GLS_REC_NUM - 1].baseTime, userFacingTime1))
-                    {
-                        for(i = 0; i < CYBLE_GLS_REC_NUM; i++)
-                        {
-                            if(CYBLE_TIME_LESS != TimeComparison(glsGlucose[i].baseTime, userFacingTime1))
-                            {
-                                OpCodeOperation(i);
-                            }
-                        }
-                    }
+                    OpCodeOperationTime(GlsRecTimeToKey(&userFacingTime1), 0xFFFFFFFFu);
                 }
                 else
                 {
                     racpInd[3] = CYBLE_GLS_RACP_RSP_UNSPRT_OPD;
                 }
-
-                GlsInd();
                 break;
 
             case CYBLE_GLS_RACP_OPR_WITHIN:
                 if(CYBLE_GLS_RACP_OPD_1 == racpFilterType)
                 {
-                    if(seqNum2 >= CYBLE_GLS_REC_NUM)
-                    {
-                        seqNum2 = CYBLE_GLS_REC_NUM - 1;
-                    }
-
-                    if(seqNum1 > seqNum2)
+                    if(GLS_REC_SEQ_OFFSET(seqNum1) > GLS_REC_SEQ_OFFSET(seqNum2))
                     {
                         racpInd[3] = CYBLE_GLS_RACP_RSP_INV_OPD;
                     }
                     else
                     {
-                        for(i = seqNum1; i <= seqNum2; i++)
-                        {
-                            OpCodeOperation(i);
-                        }
+                        OpCodeOperationSeq(seqNum1, seqNum2);
                     }
                 }
                 else if(CYBLE_GLS_RACP_OPD_2 == racpFilterType)
                 {
-                    if(CYBLE_TIME_GREAT != TimeComparison(glsGlucose[CYBLE_GLS_REC_NUM - 1].baseTime, userFacingTime2))
-                    {
-                        userFacingTime2 = glsGlucose[CYBLE_GLS_REC_NUM - 1].baseTime;
-                    }
+                    key1 = GlsRecTimeToKey(&userFacingTime1);
+                    key2 = GlsRecTimeToKey(&userFacingTime2);
 
-                    if(CYBLE_TIME_GREAT == TimeComparison(userFacingTime1, userFacingTime2))
+                    if(key1 > key2)
                     {
                         racpInd[3] = CYBLE_GLS_RACP_RSP_INV_OPD;
                     }
                     else
                     {
-                        for(i = 0; i < CYBLE_GLS_REC_NUM; i++)
-                        {
-                            if((CYBLE_TIME_LESS != TimeComparison(glsGlucose[i].baseTime, userFacingTime1)) &&
-                               (CYBLE_TIME_GREAT != TimeComparison(glsGlucose[i].baseTime, userFacingTime2)))
-                            {
-                                OpCodeOperation(i);
-                            }
-                        }
+                        OpCodeOperationTime(key1, key2);
                     }
                 }
                 else
                 {
                     racpInd[3] = CYBLE_GLS_RACP_RSP_UNSPRT_OPD;
                 }
-
-                GlsInd();
                 break;
 
             default:
                 racpInd[3] = CYBLE_GLS_RACP_RSP_UNSPRT_OPR;
-                GlsInd();
                 break;
         }
 
-        racpCommand = 0u;
+        racpIndPending = 1u;
     }
+
+    GlsRptSend();
 }
+
+
+/*******************************************************************************
+* Function Name: GlsMeasure
+********************************************************************************
+*
+* Summary:
+*   Simulates a glucose measurement every CYBLE_GLS_MEAS_PERIOD calls and
+*   adds it to the record store. The values are taken from the simulated
+*   records in turn, the base time follows the one of the most recent record
+*   by CYBLE_GLS_MEAS_PERIOD seconds. Should be called once a second.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void GlsMeasure(void)
+{
+    static uint16 measTimer = 0u;
+    static uint8 measSim = 0u;
+    CYBLE_GLS_GLMT_T glmt;
+    uint32 key = 0u;
+
+    measTimer++;
+    if(measTimer >= CYBLE_GLS_MEAS_PERIOD)
+    {
+        measTimer = 0u;
+
+        if(recLogHead != recLogTail)
+        {
+            key = glsRecKey[GLS_REC_KEY_SLOT(recLogHead - 1u)];
+        }
+
+        glmt = glsSimGlucose[measSim];
+        GlsRecKeyToTime(key + CYBLE_GLS_MEAS_PERIOD, &glmt.baseTime);
+
+        if(GLS_REC_INVALID == GlsRecAdd(&glmt, &glsSimGluCont[measSim]))
+        {
+            DBG_PRINTF("Glucose measurement is not stored \r\n");
+        }
+        else
+        {
+            DBG_PRINTF("Glucose measurement: %d \r\n", GLS_REC_SEQ_NUM(recLogHead - 1u));
+        }
+
+        measSim++;
+        if(measSim >= CYBLE_GLS_REC_NUM)
+        {
+            measSim = 0u;
+        }
+    }
+}
+
+
 /* [] END OF FILE */
@@ -21,7 +21,8 @@
 
 #include "main.h"
 
-#define CYBLE_GLS_REC_NUM           (11u) /* Number of records */
+#define CYBLE_GLS_REC_NUM           (11u) /* Number of simulated records */
+#define CYBLE_GLS_MEAS_PERIOD       (60u) /* Seconds between the simulated measurements */
 #define CYBLE_GLS_REC_STAT_OK       (0u)
 #define CYBLE_GLS_REC_STAT_DELETED  (1u)
 
@@ -70,14 +71,6 @@ typedef struct
     uint8  seconds;
 }CYBLE_DATE_TIME_T;
 
-typedef enum
-{
-    CYBLE_TIME_EQUAL,
-    CYBLE_TIME_LESS,
-    CYBLE_TIME_GREAT
-}CYBLE_DATE_TIME_COMP_T;
-
-
 
 typedef enum
 {
@@ -117,6 +110,16 @@ typedef struct
     uint16 ssa;         /* Sensor Status Annunciation */
 }CYBLE_GLS_GLMT_T;
 
+/* Fields of the Glucose Measurement, see pdu.h */
+#define GLS_GLMT_FIELDS(FIELD) \
+    FIELD(0u,                       0u,                     FLAGS8, flags) \
+    FIELD(0u,                       0u,                     U16,    seqNum) \
+    FIELD(0u,                       0u,                     DT,     baseTime) \
+    FIELD(CYBLE_GLS_GLMT_FLG_TOP,   CYBLE_GLS_GLMT_FLG_TOP, U16,    timeOffset) \
+    FIELD(CYBLE_GLS_GLMT_FLG_GLC,   CYBLE_GLS_GLMT_FLG_GLC, U16,    gluConc) \
+    FIELD(CYBLE_GLS_GLMT_FLG_GLC,   CYBLE_GLS_GLMT_FLG_GLC, U8,     tnsl) \
+    FIELD(CYBLE_GLS_GLMT_FLG_SSA,   CYBLE_GLS_GLMT_FLG_SSA, U16,    ssa)
+
 #define CYBLE_GLS_GLMC_FLG_CBID (0x01u) /* Carbohydrate ID And Carbohydrate Present */
 #define CYBLE_GLS_GLMC_FLG_MEAL (0x02u) /* Meal Present */
 #define CYBLE_GLS_GLMC_FLG_TNH  (0x04u) /* Tester-Health Present */
@@ -195,6 +198,21 @@ typedef struct
     sfloat hba1c;   /* HbA1c (glycated hemoglobin) */
 }CYBLE_GLS_GLMC_T;
 
+/* Fields of the Glucose Measurement Context, see pdu.h */
+#define GLS_GLMC_FIELDS(FIELD) \
+    FIELD(0u,                       0u,                         FLAGS8, flags) \
+    FIELD(0u,                       0u,                         U16,    seqNum) \
+    FIELD(CYBLE_GLS_GLMC_FLG_EXT,   CYBLE_GLS_GLMC_FLG_EXT,     U8,     exFlags) \
+    FIELD(CYBLE_GLS_GLMC_FLG_CBID,  CYBLE_GLS_GLMC_FLG_CBID,    U8,     cbId) \
+    FIELD(CYBLE_GLS_GLMC_FLG_CBID,  CYBLE_GLS_GLMC_FLG_CBID,    U16,    cbhdr) \
+    FIELD(CYBLE_GLS_GLMC_FLG_MEAL,  CYBLE_GLS_GLMC_FLG_MEAL,    U8,     meal) \
+    FIELD(CYBLE_GLS_GLMC_FLG_TNH,   CYBLE_GLS_GLMC_FLG_TNH,     U8,     tnh) \
+    FIELD(CYBLE_GLS_GLMC_FLG_EXR,   CYBLE_GLS_GLMC_FLG_EXR,     U16,    exDur) \
+    FIELD(CYBLE_GLS_GLMC_FLG_EXR,   CYBLE_GLS_GLMC_FLG_EXR,     U8,     exInt) \
+    FIELD(CYBLE_GLS_GLMC_FLG_MED,   CYBLE_GLS_GLMC_FLG_MED,     U8,     medId) \
+    FIELD(CYBLE_GLS_GLMC_FLG_MED,   CYBLE_GLS_GLMC_FLG_MED,     U16,    medic) \
+    FIELD(CYBLE_GLS_GLMC_FLG_A1C,   CYBLE_GLS_GLMC_FLG_A1C,     U16,    hba1c)
+
 /* Glucose Feature characteristic value type */
 typedef enum
 {
@@ -280,18 +298,23 @@ typedef enum
 void GlsInit(void);
 void GlsCallBack(uint32 event, void* eventParam);
 void GlsProcess(void);
+void GlsRptReset(void);
+void GlsMeasure(void);
 
 /* Internal functions */
-void GlsNtf(uint8 num);
-void GlsInd(void);
-CYBLE_DATE_TIME_COMP_T TimeComparison(CYBLE_DATE_TIME_T glmtTime, CYBLE_DATE_TIME_T userFacingTime);
+CYBLE_API_RESULT_T GlsNtf(const CYBLE_GLS_GLMT_T *glmt);
+CYBLE_API_RESULT_T GlsNtfCont(const CYBLE_GLS_GLMC_T *glmc);
+CYBLE_API_RESULT_T GlsInd(void);
+uint32 GlsRptNext(void);
+void GlsRptFetch(void);
+void GlsRptSend(void);
 
 /***************************************
 *      External data references
 ***************************************/
 
-extern CYBLE_GLS_GLMT_T glsGlucose[CYBLE_GLS_REC_NUM];
-extern CYBLE_GLS_GLMC_T glsGluCont[CYBLE_GLS_REC_NUM];
+extern const CYBLE_GLS_GLMT_T glsSimGlucose[CYBLE_GLS_REC_NUM];
+extern const CYBLE_GLS_GLMC_T glsSimGluCont[CYBLE_GLS_REC_NUM];
 
 
 #endif /* GLSS_H  */
@@ -122,6 +122,8 @@ void AppCallBack(uint32 event, void* eventParam)
         case CYBLE_EVT_GAP_DEVICE_DISCONNECTED:
             DBG_PRINTF("CYBLE_EVT_GAP_DEVICE_DISCONNECTED \r\n");
             batteryMeasureNotify = DISABLED;
+            /* Drop the RACP request in progress */
+            GlsRptReset();
             /* Put the device into discoverable mode so that remote can search it. */
             StartAdvertisement();
             break;
@@ -281,6 +283,7 @@ CY_ISR(Timer_Interrupt)
     
     /* Indicate that timer is raised to the main loop */
     mainTimer++;
+    NTF_STAT_TICK();
 }
 
 
@@ -426,6 +429,7 @@ int main()
             *  Process GLS RACP requests
             *******************************************************************/
             GlsProcess();
+            NTF_STAT_PROCESS();
             
             
             /*******************************************************************
@@ -437,6 +441,7 @@ int main()
                 mainTimer = 0u;                
 
                 MeasureBattery();
+                GlsMeasure();
             }
             
             
@@ -452,6 +457,12 @@ int main()
                 DBG_PRINTF("Store bonding data, status: %x \r\n", apiResult);
             }
         }
+        
+        /* Write the deleted record marks to flash one row at a time */
+        if(CyBle_GattGetBusyStatus() == CYBLE_STACK_STATE_FREE)
+        {
+            (void)RecLogSync();
+        }
     }
 }
 
@@ -21,10 +21,14 @@
 #include <stdio.h>
 
 #include "debug.h"
+#include "pdu.h"
 
 /* Profile specific includes */
 #include "bas.h"
 #include "glss.h"
+#include "glsrec.h"
+#include "reclog.h"
+#include "ntfstat.h"
 
 
 #define LED_ON                      (0u)
@@ -0,0 +1,338 @@
+/*******************************************************************************
+* File Name: reclog.c
+*
+* Version 1.0
+*
+* Description:
+*  This file contains the flash record log. Records of REC_LOG_REC_SIZE bytes
+*  are appended to a ring of REC_LOG_ROWS flash rows. Every row starts with
+*  a header holding the row sequence number, the number of programmed records
+*  and a deletion bitmap. The rows are always programmed in the ring order,
+*  so all the rows wear evenly, and the most recent row is found by its
+*  sequence number after a reset.
+*
+*  A record is addressed by its position: the number of records appended
+*  before it. Valid positions are [recLogTail, recLogHead).
+*
+*  Deletion only updates the bitmap copy in RAM. The flash copy is updated
+*  by RecLogSync() or together with the next append to the same row.
+*
+* Hardware Dependency:
+*  CY8CKIT-042 BLE
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include "main.h"
+
+
+uint32 recLogTail = 0u;
+uint32 recLogHead = 0u;
+
+/* The log storage. A row without REC_LOG_ROW_MAGIC in its header is empty. */
+const uint8 CYCODE recLogFlash[REC_LOG_ROWS * CY_FLASH_SIZEOF_ROW] CYBLE_FLASH_ROW_ALIGNED = {0u};
+
+static uint32 recLogRowBuf[CY_FLASH_SIZEOF_ROW / sizeof(uint32)];  /* Image of the most recent row */
+static uint8 recLogDeleted[REC_LOG_ROWS];                           /* Deletion bitmaps of all rows */
+static uint8 recLogDirty[(REC_LOG_ROWS + 7u) / 8u];                 /* Rows with unsaved bitmaps */
+
+
+/*******************************************************************************
+* Function Name: RecLogFlashRead
+********************************************************************************
+*
+* Summary:
+*   Reads data from a log row.
+*
+* Parameters:
+*   row    - the row index in the log.
+*   offset - the offset in the row.
+*   data   - the destination buffer.
+*   length - the number of bytes to read.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+static void RecLogFlashRead(uint32 row, uint32 offset, uint8 *data, uint32 length)
+{
+    uint32 addr = (uint32)recLogFlash + (row * CY_FLASH_SIZEOF_ROW) + offset;
+    uint32 i;
+
+    for(i = 0u; i < length; i++)
+    {
+        data[i] = CY_GET_XTND_REG8(addr + i);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: RecLogFlashWrite
+********************************************************************************
+*
+* Summary:
+*   Programs a log row.
+*
+* Parameters:
+*   row  - the row index in the log.
+*   data - CY_FLASH_SIZEOF_ROW bytes to program.
+*
+* Return:
+*   The same as CySysFlashWriteRow().
+*
+*******************************************************************************/
+static cystatus RecLogFlashWrite(uint32 row, const uint8 *data)
+{
+    uint32 rowNum = (((uint32)recLogFlash - CYDEV_FLASH_BASE) / CY_FLASH_SIZEOF_ROW) + row;
+
+    return(CySysFlashWriteRow(rowNum, data));
+}
+
+
+/*******************************************************************************
+* Function Name: RecLogInit
+********************************************************************************
+*
+* Summary:
+*   Scans the row headers and restores the log state after a reset.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void RecLogInit(void)
+{
+    REC_LOG_ROW_HDR_T hdr;
+    uint32 row;
+    uint32 headSeq = 0u;
+    uint32 tailSeq = 0u;
+    uint8 headUsed = 0u;
+    uint8 found = 0u;
+
+    (void)memset(recLogDirty, 0, sizeof(recLogDirty));
+
+    for(row = 0u; row < REC_LOG_ROWS; row++)
+    {
+        RecLogFlashRead(row, 0u, (uint8 *)&hdr, sizeof(hdr));
+
+        if((REC_LOG_ROW_MAGIC == hdr.magic) && (row == (hdr.seq % REC_LOG_ROWS)) &&
+           (hdr.used <= REC_LOG_REC_PER_ROW))
+        {
+            recLogDeleted[row] = hdr.deleted;
+
+            if((0u == found) || (hdr.seq > headSeq))
+            {
+                headSeq = hdr.seq;
+                headUsed = hdr.used;
+            }
+            if((0u == found) || (hdr.seq < tailSeq))
+            {
+                tailSeq = hdr.seq;
+            }
+            found = 1u;
+        }
+        else
+        {
+            /* A row that was never programmed or whose programming was interrupted */
+            recLogDeleted[row] = 0xFFu;
+        }
+    }
+
+    if(0u != found)
+    {
+        RecLogFlashRead(headSeq % REC_LOG_ROWS, 0u, (uint8 *)recLogRowBuf, CY_FLASH_SIZEOF_ROW);
+        recLogTail = tailSeq * REC_LOG_REC_PER_ROW;
+        recLogHead = (headSeq * REC_LOG_REC_PER_ROW) + headUsed;
+    }
+    else
+    {
+        (void)memset(recLogRowBuf, 0, sizeof(recLogRowBuf));
+        recLogTail = 0u;
+        recLogHead = 0u;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: RecLogAppend
+********************************************************************************
+*
+* Summary:
+*   Appends a record to the log. When the log is full, the oldest row is
+*   reused and its records are lost. Only the most recent row is programmed,
+*   so the call takes one flash row write regardless of the log size.
+*
+* Parameters:
+*   rec - REC_LOG_REC_SIZE bytes of the record.
+*
+* Return:
+*   The same as CySysFlashWriteRow().
+*
+*******************************************************************************/
+cystatus RecLogAppend(const void *rec)
+{
+    REC_LOG_ROW_HDR_T *hdr = (REC_LOG_ROW_HDR_T *)recLogRowBuf;
+    uint32 seq = recLogHead / REC_LOG_REC_PER_ROW;
+    uint32 slot = recLogHead % REC_LOG_REC_PER_ROW;
+    uint32 row = seq % REC_LOG_ROWS;
+    cystatus status;
+
+    if(0u == slot)
+    {
+        /* The new row replaces the oldest one once the ring has wrapped */
+        if((seq >= REC_LOG_ROWS) && (recLogTail < ((seq - REC_LOG_ROWS + 1u) * REC_LOG_REC_PER_ROW)))
+        {
+            recLogTail = (seq - REC_LOG_ROWS + 1u) * REC_LOG_REC_PER_ROW;
+        }
+
+        (void)memset(recLogRowBuf, 0, sizeof(recLogRowBuf));
+        hdr->magic = REC_LOG_ROW_MAGIC;
+        hdr->seq = seq;
+        recLogDeleted[row] = 0u;
+    }
+
+    (void)memcpy((uint8 *)recLogRowBuf + REC_LOG_ROW_HDR_SIZE + (slot * REC_LOG_REC_SIZE), rec, REC_LOG_REC_SIZE);
+    hdr->used = (uint8)(slot + 1u);
+    hdr->deleted = recLogDeleted[row];
+
+    status = RecLogFlashWrite(row, (const uint8 *)recLogRowBuf);
+    if(CYRET_SUCCESS == status)
+    {
+        recLogHead++;
+        recLogDirty[row >> 3u] &= (uint8)~(1u << (row & 0x07u));
+    }
+
+    return(status);
+}
+
+
+/*******************************************************************************
+* Function Name: RecLogRead
+********************************************************************************
+*
+* Summary:
+*   Reads a record.
+*
+* Parameters:
+*   pos - the record position, recLogTail <= pos < recLogHead.
+*   rec - the destination of REC_LOG_REC_SIZE bytes.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void RecLogRead(uint32 pos, void *rec)
+{
+    uint32 offset = REC_LOG_ROW_HDR_SIZE + ((pos % REC_LOG_REC_PER_ROW) * REC_LOG_REC_SIZE);
+
+    if((pos / REC_LOG_REC_PER_ROW) == ((REC_LOG_ROW_HDR_T *)recLogRowBuf)->seq)
+    {
+        (void)memcpy(rec, (uint8 *)recLogRowBuf + offset, REC_LOG_REC_SIZE);
+    }
+    else
+    {
+        RecLogFlashRead((pos / REC_LOG_REC_PER_ROW) % REC_LOG_ROWS, offset, (uint8 *)rec, REC_LOG_REC_SIZE);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: RecLogDelete
+********************************************************************************
+*
+* Summary:
+*   Marks a record as deleted. The flash is not written here.
+*
+* Parameters:
+*   pos - the record position, recLogTail <= pos < recLogHead.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void RecLogDelete(uint32 pos)
+{
+    uint32 row = (pos / REC_LOG_REC_PER_ROW) % REC_LOG_ROWS;
+
+    recLogDeleted[row] |= (uint8)(1u << (pos % REC_LOG_REC_PER_ROW));
+    recLogDirty[row >> 3u] |= (uint8)(1u << (row & 0x07u));
+}
+
+
+/*******************************************************************************
+* Function Name: RecLogIsDeleted
+********************************************************************************
+*
+* Summary:
+*   Checks whether a record is deleted.
+*
+* Parameters:
+*   pos - the record position, recLogTail <= pos < recLogHead.
+*
+* Return:
+*   Non-zero if the record is deleted.
+*
+*******************************************************************************/
+uint8 RecLogIsDeleted(uint32 pos)
+{
+    uint32 row = (pos / REC_LOG_REC_PER_ROW) % REC_LOG_ROWS;
+
+    return(recLogDeleted[row] & (uint8)(1u << (pos % REC_LOG_REC_PER_ROW)));
+}
+
+
+/*******************************************************************************
+* Function Name: RecLogSync
+********************************************************************************
+*
+* Summary:
+*   Writes the deletion bitmap of one row to flash. Should be called from the
+*   main loop when the BLE stack is idle until it returns zero.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   Non-zero if a row was written.
+*
+*******************************************************************************/
+uint8 RecLogSync(void)
+{
+    REC_LOG_ROW_HDR_T *hdr = (REC_LOG_ROW_HDR_T *)recLogRowBuf;
+    uint32 rowData[CY_FLASH_SIZEOF_ROW / sizeof(uint32)];
+    uint32 row;
+    uint8 written = 0u;
+
+    for(row = 0u; (row < REC_LOG_ROWS) && (0u == written); row++)
+    {
+        if(0u != (recLogDirty[row >> 3u] & (uint8)(1u << (row & 0x07u))))
+        {
+            if((REC_LOG_ROW_MAGIC == hdr->magic) && (row == (hdr->seq % REC_LOG_ROWS)))
+            {
+                hdr->deleted = recLogDeleted[row];
+                (void)RecLogFlashWrite(row, (const uint8 *)recLogRowBuf);
+            }
+            else
+            {
+                RecLogFlashRead(row, 0u, (uint8 *)rowData, CY_FLASH_SIZEOF_ROW);
+                ((REC_LOG_ROW_HDR_T *)rowData)->deleted = recLogDeleted[row];
+                (void)RecLogFlashWrite(row, (const uint8 *)rowData);
+            }
+
+            recLogDirty[row >> 3u] &= (uint8)~(1u << (row & 0x07u));
+            written = 1u;
+        }
+    }
+
+    return(written);
+}
+
+
+/* [] END OF FILE */
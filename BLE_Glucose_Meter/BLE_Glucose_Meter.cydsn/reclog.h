@@ -0,0 +1,78 @@
+/*******************************************************************************
+* File Name: reclog.h
+*
+* Version 1.0
+*
+* Description:
+*  Contains the function prototypes and constants of the flash record log.
+*
+* Hardware Dependency:
+*  CY8CKIT-042 BLE
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(RECLOG_H)
+#define RECLOG_H
+
+#include "main.h"
+
+
+/***************************************
+*        Constants
+***************************************/
+/* Flash rows reserved for the log, up to 256. A row holds 3 records, so the
+*  log keeps 381 records in 16 KB. Thousands of records would take most of
+*  the 128 KB flash of the CY8C4247, which mostly holds the BLE stack, and
+*  4 bytes of RAM per record for the time index, see GLS_REC_KEYS.
+*/
+#define REC_LOG_ROWS                (128u)
+#define REC_LOG_REC_SIZE            (sizeof(GLS_REC_LOG_T))      /* A Glucose Measurement with its context */
+#define REC_LOG_ROW_HDR_SIZE        (8u)
+#define REC_LOG_ROW_MAGIC           (0x4C52u)   /* Marks a programmed log row */
+
+/* Records per row. The deletion bitmap of a row is one byte, so no more than 8. */
+#define REC_LOG_REC_PER_ROW_MAX     ((CY_FLASH_SIZEOF_ROW - REC_LOG_ROW_HDR_SIZE) / REC_LOG_REC_SIZE)
+#define REC_LOG_REC_PER_ROW         ((REC_LOG_REC_PER_ROW_MAX > 8u) ? 8u : REC_LOG_REC_PER_ROW_MAX)
+
+/* The oldest row is overwritten when the head enters it, so one row is not counted */
+#define REC_LOG_CAPACITY            ((REC_LOG_ROWS - 1u) * REC_LOG_REC_PER_ROW)
+
+
+/***************************************
+*        Data Struct Definition
+***************************************/
+typedef struct
+{
+    uint16 magic;           /* REC_LOG_ROW_MAGIC */
+    uint8  used;            /* Number of programmed records */
+    uint8  deleted;         /* Bitmap of the deleted records */
+    uint32 seq;             /* Row sequence number, the row index is seq % REC_LOG_ROWS */
+} REC_LOG_ROW_HDR_T;
+
+
+/***************************************
+*      API Function Prototypes
+***************************************/
+void RecLogInit(void);
+cystatus RecLogAppend(const void *rec);
+void RecLogRead(uint32 pos, void *rec);
+void RecLogDelete(uint32 pos);
+uint8 RecLogIsDeleted(uint32 pos);
+uint8 RecLogSync(void);
+
+
+/***************************************
+*      External data references
+***************************************/
+extern uint32 recLogTail;       /* Position of the oldest record */
+extern uint32 recLogHead;       /* Position of the next record to be appended */
+
+
+#endif /* RECLOG_H */
+
+/* [] END OF FILE */
@@ -25,12 +25,16 @@ uint8 hrsNotification = 0;
 /* Heart Rate Measurement characteristic data structure */
 CYBLE_HRS_HRM_T hrsHeartRate;
 
+/* Heart rate variability of the received RR-Intervals */
+HRV_T hrscHrv;
+
 /* Heart Rate Service callback */
 void HeartRateCallBack(uint32 event, void* eventParam)
 {
     uint16 rrInt;
     uint16 i;
     uint16 attrValue;
+    HRV_METRICS_T hrv;
 
     switch(event)
     {
@@ -97,11 +101,17 @@ void HeartRateCallBack(uint32 event, void* eventParam)
                     rrInt = HrscGetRRInterval(i);
                     if(0u != rrInt)
                     {
+                        HrvAddRr(&hrscHrv, rrInt);
                         DBG_PRINTF("    RR-Interval %d: %d", i, HrscGetRRInterval(i));
                     }
                 }
 
                 DBG_PRINTF("\r\n");
+
+                HrvGetMetrics(&hrscHrv, &hrv);
+                DBG_PRINTF("HRV: mean HR %d.%d bpm, RMSSD %d ms, pNN50 %d.%d %%, SDNN %d ms (%lu RR, %lu rejected) \r\n",
+                    hrv.meanHr / 10u, hrv.meanHr % 10u, hrv.rmssd, hrv.pnn50 / 10u, hrv.pnn50 % 10u, hrv.sdnn,
+                    hrv.n, hrv.rejectCnt);
             }
             else
             {
@@ -203,6 +213,8 @@ void HrsInit(void)
     {
         hrsHeartRate.rrInterval[i] = 0u;
     }
+
+    HrvInit(&hrscHrv);
     
     CyBle_HrsRegisterAttrCallback(HeartRateCallBack);
 }
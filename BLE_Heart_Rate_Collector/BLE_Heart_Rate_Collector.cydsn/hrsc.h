@@ -195,6 +195,7 @@ CYBLE_API_RESULT_T HrscResetEnergyExpendedCounter(void);
 *      External data references
 ***************************************/
 extern CYBLE_HRS_HRM_T hrsHeartRate;     
+extern HRV_T hrscHrv;
 extern uint8 hrsNotification;
 
 
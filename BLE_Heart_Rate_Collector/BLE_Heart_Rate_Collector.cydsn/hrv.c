@@ -0,0 +1,261 @@
+/*******************************************************************************
+* File Name: hrv.c
+*
+* Version 1.0
+*
+* Description:
+*  This file contains the heart rate variability engine. Every RR-Interval
+*  updates the metrics in constant time with integer arithmetic only:
+*
+*   - the mean heart rate, RMSSD and pNN50 of the last HRV_WINDOW intervals
+*     are kept as running sums, the interval leaving the window is
+*     subtracted from them;
+*   - SDNN of all the intervals is kept by the 64-bit sums of the intervals
+*     and of their squares around the first interval, so the variance is
+*     exact and none of the intervals fades out.
+*
+*  The square roots and divisions of the results are only taken in
+*  HrvGetMetrics(). Intervals out of the physiological range are rejected as
+*  artifacts, and the interval after a rejected one has no successive
+*  difference. The engine only depends on cytypes.h, so it is also built on
+*  the host.
+*
+* Hardware Dependency:
+*  CY8CKIT-042 BLE
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include "hrv.h"
+
+
+/*******************************************************************************
+* Function Name: HrvSqrt
+********************************************************************************
+*
+* Summary:
+*   Calculates the integer square root.
+*
+* Parameters:
+*   x - the value.
+*
+* Return:
+*   The largest integer whose square does not exceed x.
+*
+*******************************************************************************/
+static uint32 HrvSqrt(uint32 x)
+{
+    uint32 root = 0u;
+    uint32 bit = 1uL << 30u;
+
+    while(bit > x)
+    {
+        bit >>= 2u;
+    }
+
+    while(0u != bit)
+    {
+        if(x >= (root + bit))
+        {
+            x -= root + bit;
+            root = (root >> 1u) + bit;
+        }
+        else
+        {
+            root >>= 1u;
+        }
+        bit >>= 2u;
+    }
+
+    return(root);
+}
+
+
+/*******************************************************************************
+* Function Name: HrvDiffAbs
+********************************************************************************
+*
+* Summary:
+*   Returns the absolute value of a successive difference.
+*
+* Parameters:
+*   diff - the difference, ms.
+*
+* Return:
+*   The absolute value, ms.
+*
+*******************************************************************************/
+static uint32 HrvDiffAbs(int16 diff)
+{
+    return((diff < 0) ? (uint32)(-(int32)diff) : (uint32)diff);
+}
+
+
+/*******************************************************************************
+* Function Name: HrvInit
+********************************************************************************
+*
+* Summary:
+*   Clears the engine, for example, when a new sensor is connected.
+*
+* Parameters:
+*   hrv - the engine.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void HrvInit(HRV_T *hrv)
+{
+    hrv->head = 0u;
+    hrv->num = 0u;
+    hrv->diffNum = 0u;
+    hrv->nn50Num = 0u;
+    hrv->rrSum = 0u;
+    hrv->diffSqSum = 0u;
+    hrv->prevRr = 0u;
+    hrv->n = 0u;
+    hrv->offset = 0u;
+    hrv->devSum = 0;
+    hrv->devSqSum = 0u;
+    hrv->rejectCnt = 0u;
+}
+
+
+/*******************************************************************************
+* Function Name: HrvAddRr
+********************************************************************************
+*
+* Summary:
+*   Adds the next RR-Interval to the metrics.
+*
+* Parameters:
+*   hrv        - the engine.
+*   rrInterval - the RR-Interval as received, 1/1024 s.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void HrvAddRr(HRV_T *hrv, uint16 rrInterval)
+{
+    uint16 rr = (uint16)((((uint32)rrInterval * 1000u) + 512u) >> 10u);
+    int16 diff = HRV_DIFF_NONE;
+    int32 dev;
+    uint32 diffAbs;
+
+    if((rr < HRV_RR_MIN) || (rr > HRV_RR_MAX))
+    {
+        hrv->rejectCnt++;
+        hrv->prevRr = 0u;
+    }
+    else
+    {
+        /* The oldest interval leaves the full window */
+        if(HRV_WINDOW == hrv->num)
+        {
+            hrv->rrSum -= hrv->rr[hrv->head];
+            if(HRV_DIFF_NONE != hrv->diff[hrv->head])
+            {
+                diffAbs = HrvDiffAbs(hrv->diff[hrv->head]);
+                hrv->diffSqSum -= diffAbs * diffAbs;
+                hrv->diffNum--;
+                if(diffAbs > HRV_NN50)
+                {
+                    hrv->nn50Num--;
+                }
+            }
+        }
+        else
+        {
+            hrv->num++;
+        }
+
+        if(0u != hrv->prevRr)
+        {
+            diff = (int16)rr - (int16)hrv->prevRr;
+            diffAbs = HrvDiffAbs(diff);
+            hrv->diffSqSum += diffAbs * diffAbs;
+            hrv->diffNum++;
+            if(diffAbs > HRV_NN50)
+            {
+                hrv->nn50Num++;
+            }
+        }
+
+        hrv->rr[hrv->head] = rr;
+        hrv->diff[hrv->head] = diff;
+        hrv->rrSum += rr;
+        hrv->head = (uint8)((hrv->head + 1u) % HRV_WINDOW);
+        hrv->prevRr = rr;
+
+        /* The deviations from the first interval keep the square sum small and exact */
+        if(0u == hrv->n)
+        {
+            hrv->offset = rr;
+        }
+        hrv->n++;
+        dev = (int32)rr - (int32)hrv->offset;
+        hrv->devSum += dev;
+        hrv->devSqSum += (uint64)((uint32)(dev * dev));
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: HrvGetMetrics
+********************************************************************************
+*
+* Summary:
+*   Calculates the metrics from the running sums. The metrics that have no
+*   intervals yet are 0.
+*
+* Parameters:
+*   hrv     - the engine.
+*   metrics - returns the metrics.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void HrvGetMetrics(const HRV_T *hrv, HRV_METRICS_T *metrics)
+{
+    int64 q;
+    int64 r;
+    uint64 dev2;
+
+    metrics->meanHr = 0u;
+    metrics->rmssd = 0u;
+    metrics->pnn50 = 0u;
+    metrics->sdnn = 0u;
+    metrics->n = hrv->n;
+    metrics->rejectCnt = hrv->rejectCnt;
+
+    if(0u != hrv->num)
+    {
+        metrics->meanHr = (uint16)((600000u * hrv->num) / hrv->rrSum);
+    }
+
+    if(0u != hrv->diffNum)
+    {
+        metrics->rmssd = (uint16)HrvSqrt((hrv->diffSqSum + (hrv->diffNum / 2u)) / hrv->diffNum);
+        metrics->pnn50 = (uint16)(((uint32)hrv->nn50Num * 1000u) / hrv->diffNum);
+    }
+
+    if(hrv->n > 1u)
+    {
+        /* devSqSum - devSum^2 / n with devSum = q * n + r, so no product exceeds 64 bits */
+        q = hrv->devSum / (int64)hrv->n;
+        r = hrv->devSum - (q * (int64)hrv->n);
+        dev2 = hrv->devSqSum - (uint64)(q * hrv->devSum) - (uint64)(q * r) -
+            (((uint64)(r * r) + (hrv->n / 2u)) / hrv->n);
+        metrics->sdnn = (uint16)HrvSqrt((uint32)((dev2 + ((hrv->n - 1u) / 2u)) / (hrv->n - 1u)));
+    }
+}
+
+
+/* [] END OF FILE */
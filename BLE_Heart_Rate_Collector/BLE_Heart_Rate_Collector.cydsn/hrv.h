@@ -0,0 +1,82 @@
+/*******************************************************************************
+* File Name: hrv.h
+*
+* Version 1.0
+*
+* Description:
+*  Contains the function prototypes and constants of the heart rate
+*  variability engine.
+*
+* Hardware Dependency:
+*  CY8CKIT-042 BLE
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(HRV_H)
+#define HRV_H
+
+#include "cytypes.h"
+
+
+/***************************************
+*        Constants
+***************************************/
+#define HRV_WINDOW                  (64u)       /* RR-Intervals in the window of the mean HR, RMSSD and pNN50 */
+#define HRV_RR_MIN                  (250u)      /* Shortest accepted RR-Interval, ms (240 bpm) */
+#define HRV_RR_MAX                  (2000u)     /* Longest accepted RR-Interval, ms (30 bpm) */
+#define HRV_NN50                    (50u)       /* Successive difference counted by pNN50, ms */
+#define HRV_DIFF_NONE               (0x7FFF)    /* The interval does not follow an accepted one */
+
+
+/***************************************
+*        Data Struct Definition
+***************************************/
+typedef struct
+{
+    /* Window of the last HRV_WINDOW accepted intervals */
+    uint16 rr[HRV_WINDOW];      /* RR-Interval, ms */
+    int16  diff[HRV_WINDOW];    /* Difference from the previous interval, ms, or HRV_DIFF_NONE */
+    uint8  head;                /* Position of the next interval */
+    uint8  num;                 /* Intervals in the window */
+    uint8  diffNum;             /* Successive differences in the window */
+    uint8  nn50Num;             /* Successive differences above HRV_NN50 in the window */
+    uint32 rrSum;               /* Sum of the intervals in the window, ms */
+    uint32 diffSqSum;           /* Sum of the squared differences in the window, ms^2 */
+    uint16 prevRr;              /* The last accepted interval, ms, or 0 after a rejected one */
+
+    /* Exact sums of all the accepted intervals around the first one */
+    uint32 n;
+    uint16 offset;              /* The first accepted interval, ms */
+    int64  devSum;              /* Sum of the deviations from offset, ms */
+    uint64 devSqSum;            /* Sum of the squared deviations from offset, ms^2 */
+
+    uint32 rejectCnt;           /* Intervals out of [HRV_RR_MIN, HRV_RR_MAX] */
+} HRV_T;
+
+typedef struct
+{
+    uint16 meanHr;              /* Mean heart rate in the window, 0.1 bpm */
+    uint16 rmssd;               /* RMSSD in the window, ms */
+    uint16 pnn50;               /* pNN50 in the window, 0.1 % */
+    uint16 sdnn;                /* SDNN of all the accepted intervals, ms */
+    uint32 n;                   /* Intervals behind the SDNN */
+    uint32 rejectCnt;           /* Rejected intervals */
+} HRV_METRICS_T;
+
+
+/***************************************
+*      API Function Prototypes
+***************************************/
+void HrvInit(HRV_T *hrv);
+void HrvAddRr(HRV_T *hrv, uint16 rrInterval);
+void HrvGetMetrics(const HRV_T *hrv, HRV_METRICS_T *metrics);
+
+
+#endif /* HRV_H */
+
+/* [] END OF FILE */
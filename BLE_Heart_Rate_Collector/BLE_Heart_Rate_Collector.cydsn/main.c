@@ -111,6 +111,8 @@ void AppCallBack(uint32 event, void* eventParam)
         case CYBLE_EVT_GAP_DEVICE_CONNECTED:
             DBG_PRINTF("CYBLE_EVT_GAP_DEVICE_CONNECTED: %x \r\n", cyBle_connHandle.bdHandle);
             CyBle_GapAddDeviceToWhiteList(&peerAddr[deviceN]);
+            /* The metrics of the previous sensor do not apply */
+            HrvInit(&hrscHrv);
             /* Send authorization request. */
             apiResult = CyBle_GapAuthReq(cyBle_connHandle.bdHandle, &cyBle_authInfo);
             
@@ -352,7 +354,11 @@ void AppCallBack(uint32 event, void* eventParam)
 *******************************************************************************/
 void StartScan(CYBLE_UUID16 uuid)
 {
+    SCAN_FILTER_T filter;
+
     serviceUuid = uuid;
+    ScanFilterUuid16(&filter, uuid);
+    ScanStart(&filter);
     apiResult = CyBle_GapcStartScan(CYBLE_SCANNING_FAST);
 	if(apiResult != CYBLE_ERROR_OK)
     {
@@ -402,9 +408,17 @@ void ScanProgressEventHandler(CYBLE_GAPC_ADV_REPORT_T* eventParam)
 {
     uint8 newDevice = 0u, device = 0u;
     uint8 i;
-    uint8 adStructPtr = 0u;
-    uint8 adTypePtr = 0u;
-    uint8 nextPtr = 0u;
+    uint8 result;
+    SCAN_ENTRY_T *entry;
+    AD_INFO_T adInfo;
+
+    /* A report that repeats the cached one is not parsed and printed again */
+    entry = ScanReport(eventParam->peerBdAddr, SCAN_TYPE(eventParam->eventType, eventParam->peerAddrType),
+                       eventParam->rssi, eventParam->data, eventParam->dataLen, &result);
+    if(SCAN_REPORT_DUPLICATE == result)
+    {
+        return;
+    }
 
     DBG_PRINTF("SCAN_PROGRESS_RESULT: peerAddrType - %d, ", eventParam->peerAddrType);
     DBG_PRINTF("peerBdAddr - ");
@@ -434,46 +448,30 @@ void ScanProgressEventHandler(CYBLE_GAPC_ADV_REPORT_T* eventParam)
     {
         DBG_PRINTF("%2.2x", eventParam->peerBdAddr[i-1]);
     }
-    DBG_PRINTF(", rssi - %d dBm, data - ", eventParam->rssi);
+    DBG_PRINTF(", rssi - %d dBm (%d average), data - ", eventParam->rssi, SCAN_RSSI(entry));
 
-    /* Print and parse advertisement data and connect to device which has HRM */
-    adStructPtr = 0u;
+    /* Print advertisement data and connect to device which has HRM */
     for(i = 0; i < eventParam->dataLen; i++)
     {
         DBG_PRINTF("%2.2x ", eventParam->data[i]);
+    }
 
-        if(i == adStructPtr)
-        {
-            adTypePtr = i + 1;
-            adStructPtr += eventParam->data[i] + 1;
-            nextPtr = 1;
-        }
-        else if(i == (adTypePtr + nextPtr))
-        {
-            switch(eventParam->data[adTypePtr])
-            {
-                case CYBLE_GAP_ADV_FLAGS:
-                    break;
-
-                case CYBLE_GAP_ADV_INCOMPL_16UUID:
-                case CYBLE_GAP_ADV_COMPL_16UUID:
-                    if(serviceUuid == CyBle_Get16ByPtr(&(eventParam->data[i])))
-                    {
-                        newDevice = 2; /* temporary use newDevice as a flag */
-                    }
-                    else
-                    {
-                        nextPtr += 2;
-                    }
-                    break;
-
-                default:
-                    break;
-            }
-        }
+    /* Print the name and the TX power level of the device */
+    if(0u == AdParse(eventParam->data, eventParam->dataLen, &adInfo))
+    {
+        DBG_PRINTF("(malformed) ");
+    }
+    if(0u != adInfo.nameLen)
+    {
+        DBG_PRINTF("name - %.*s ", (int)adInfo.nameLen, (const char *)adInfo.name);
+    }
+    if(AD_TX_POWER_NONE != adInfo.txPower)
+    {
+        DBG_PRINTF("tx power - %d dBm ", adInfo.txPower);
     }
 
-    if(2 == newDevice)
+    /* The filter of the scan has passed the service UUID */
+    if(SCAN_NO_MATCH != entry->match)
     {
         deviceN = device;
         DBG_PRINTF("       This device contains ");
@@ -522,6 +520,7 @@ CY_ISR(Timer_Interrupt)
             led ^= LED_OFF;
             Scanning_LED_Write(led);
         }
+        ScanTick();
     }
     /* Blink blue LED to indicate that device has received a notification */
     else if(CyBle_GetState() == CYBLE_STATE_CONNECTED)
@@ -21,9 +21,11 @@
 #include <stdio.h>
 
 #include "debug.h"
+#include "scan.h"
 
 /* Profile specific includes */
 #include "basc.h"
+#include "hrv.h"
 #include "hrsc.h"
 
 
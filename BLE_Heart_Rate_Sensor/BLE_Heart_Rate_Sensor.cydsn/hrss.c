@@ -23,9 +23,18 @@ uint16 energyExpended = 0u;
 /* Heart Rate Measurement characteristic data structure */
 CYBLE_HRS_HRM_T hrsHeartRate;
 
-/* Pointer and counter for RR-Interval data */
-uint8 hrssRrIntPtr;
-uint8 hrssRrIntCnt;
+/* RR-Interval ring. HrssAddRrInterval() is the only writer of the head and
+*  HrssSendHeartRateNtf() is the only writer of the tail, so the intervals may
+*  be added from an interrupt without a critical section. The indexes run
+*  freely and are masked on access.
+*/
+volatile uint16 hrssRrRing[HRS_RR_RING_SIZE];
+volatile uint8 hrssRrHead;
+volatile uint8 hrssRrTail;
+volatile uint32 hrssRrDropCnt;  /* RR-Intervals dropped because the ring was full */
+
+/* uint8 HrssPackHrm(uint8 pdu[], const CYBLE_HRS_HRM_T *value, uint32 flags) */
+PDU_DEFINE_PACK(HrssPackHrm, CYBLE_HRS_HRM_T, HRS_HRM_FIELDS)
 
 /* Heart Rate Service callback */
 void HeartRateCallBack(uint32 event, void* eventParam)
@@ -75,18 +84,15 @@ void HeartRateCallBack(uint32 event, void* eventParam)
 
 void HrsInit(void)
 {
-    uint16 i;
-    
     CyBle_HrsRegisterAttrCallback(HeartRateCallBack);
 
     hrsHeartRate.flags = 0u;
     hrsHeartRate.heartRateValue = 0u;
     hrsHeartRate.energyExpendedValue = 0u;
 
-    for(i = 0; i < CYBLE_HRS_HRM_RRSIZE; i++)
-    {
-        hrsHeartRate.rrInterval[i] = 0u;
-    }
+    hrssRrHead = 0u;
+    hrssRrTail = 0u;
+    hrssRrDropCnt = 0u;
 }
 
 /***************************************
@@ -185,8 +191,9 @@ uint16 HrssGetHrmDescriptor(void)
 ********************************************************************************
 *
 * Summary:
-*  Adds the next RR-Interval into the
-*  Heart Rate Measurument characteristic structure.
+*  Adds the next RR-Interval into the RR-Interval ring. When the ring is full,
+*  the interval is dropped and counted in hrssRrDropCnt. May be called from
+*  an interrupt.
 *
 * Parameters:
 *  uint16 rrIntervalValue: RR-Interval value to be set.
@@ -197,23 +204,18 @@ uint16 HrssGetHrmDescriptor(void)
 *******************************************************************************/
 void HrssAddRrInterval(uint16 rrIntervalValue)
 {
-    hrsHeartRate.flags |= CYBLE_HRS_HRM_RRINT;
+    uint8 head = hrssRrHead;
 
-    if(hrssRrIntPtr == CYBLE_HRS_HRM_RRSIZE - 1)
+    if((uint8)(head - hrssRrTail) < HRS_RR_RING_SIZE)
     {
-        hrssRrIntPtr = 0;
+        hrssRrRing[head & HRS_RR_RING_MASK] = rrIntervalValue;
+        /* Publish the interval only after it is written */
+        hrssRrHead = head + 1u;
     }
     else
     {
-        hrssRrIntPtr++;
+        hrssRrDropCnt++;
     }
-
-    if(hrssRrIntCnt <= CYBLE_HRS_HRM_RRSIZE)
-    {
-        hrssRrIntCnt++;
-    }
-
-    hrsHeartRate.rrInterval[hrssRrIntPtr] = rrIntervalValue;
 }
 
 
@@ -224,7 +226,8 @@ void HrssAddRrInterval(uint16 rrIntervalValue)
 * Summary:
 *  Packs the Heart Rate Measurement characteristic structure into the
 *  uint8 array prior to sending it to the collector. Also clears the
-*  CYBLE_HRS_HRM_HRVAL16, CYBLE_HRS_HRM_ENEXP and CYBLE_HRS_HRM_RRINT flags.
+*  CYBLE_HRS_HRM_ENEXP flag. The RR-Intervals are removed from the ring
+*  only when the notification is sent.
 *
 * Parameters:
 *  attHandle:  Pointer to the handle which consists of device ID and ATT
@@ -248,84 +251,65 @@ void HrssSendHeartRateNtf(void)
         uint8 pdu[CYBLE_HRS_HRM_CHAR_LEN];
         uint8 nextPtr;
         uint8 length;
-        uint8 rrInt;
-        
-        /* Flags field is always the first byte */
-        pdu[0u] = hrsHeartRate.flags & (uint8) ~CYBLE_HRS_HRM_HRVAL16;
+        uint8 rrTail = hrssRrTail;
+        uint8 rrHead = hrssRrHead;
+        uint32 flags;
+        static uint32 rrDropCnt = 0u;
+
+        NTF_STAT_BUILD_START();
 
-        /* If the Heart Rate value exceeds one byte */
+        /* The Heart Rate value takes 2 bytes only if it exceeds one byte */
+        flags = hrsHeartRate.flags & (uint8) ~(CYBLE_HRS_HRM_HRVAL16 | CYBLE_HRS_HRM_RRINT);
         if(hrsHeartRate.heartRateValue > 0x00FFu)
         {
-            /* then set the CYBLE_HRS_HRM_HRVAL16 flag */
-            pdu[0u] |= CYBLE_HRS_HRM_HRVAL16;
-            /* and set the full 2-bytes Heart Rate value */
-            CyBle_Set16ByPtr(&pdu[1u], hrsHeartRate.heartRateValue);
-            /* The next data will be located beginning from 3rd byte */
-            nextPtr = 3u;
-        }
-        else
-        {
-            /* Else leave the CYBLE_HRS_HRM_HRVAL16 flag remains being cleared */
-            /* and set only LSB of the  Heart Rate value */
-            pdu[1u] = (uint8) hrsHeartRate.heartRateValue;
-            /* The next data will be located beginning from 2nd byte */
-            nextPtr = 2u;
+            flags |= CYBLE_HRS_HRM_HRVAL16;
         }
 
-        /* If the Energy Expended flag is set */
-        if(0u != (hrsHeartRate.flags & CYBLE_HRS_HRM_ENEXP))
+        if(rrTail != rrHead)
         {
-            /* clear the CYBLE_HRS_HRM_ENEXP flag */
-            hrsHeartRate.flags &= (uint8) ~CYBLE_HRS_HRM_ENEXP;
-            /* and set the 2-bytes Energy Expended value */
-            CyBle_Set16ByPtr(&pdu[nextPtr], hrsHeartRate.energyExpendedValue);
-            /* add 2 bytes: Energy Expended value is uint16 */
-            nextPtr += 2u;
+            flags |= CYBLE_HRS_HRM_RRINT;
         }
 
-        if(HrssAreThereRrIntervals())
-        {
-            /* Calculate the actual length of pdu: the RR-interval block length should be an even number */
-            length = ((CYBLE_HRS_HRM_CHAR_LEN - nextPtr) & ~0x01) + nextPtr;
+        /* Flags, Heart Rate and Energy Expended values */
+        nextPtr = HrssPackHrm(pdu, &hrsHeartRate, flags);
 
-            rrInt = hrssRrIntPtr;
+        /* The Energy Expended value is sent once */
+        hrsHeartRate.flags &= (uint8) ~CYBLE_HRS_HRM_ENEXP;
 
-            while(nextPtr < length)
+        if(0u != (flags & CYBLE_HRS_HRM_RRINT))
+        {
+            /* All the buffered RR-Intervals that fit the exchanged MTU go in one notification,
+            *  the rest are carried to the next one.
+            */
+            length = CYBLE_HRS_HRM_CHAR_LEN;
+            if(length > (attMtu - 3u))
             {
-                /* Increment the rrInterval array pointer in RR-Interval buffer size loop */
-                rrInt++;
-                if(rrInt >= CYBLE_HRS_HRM_RRSIZE)
-                {
-                    rrInt = 0;
-                }
-
-                if(hrsHeartRate.rrInterval[rrInt] != 0)
-                {
-                    /* Copy the non-zero RR-Interval into the pdu */
-                    CyBle_Set16ByPtr(&pdu[nextPtr], hrsHeartRate.rrInterval[rrInt]);
-                    /* Clear the current RR-Interval in the buffer */
-                    hrsHeartRate.rrInterval[rrInt] = 0;
-                    /* Add 2 bytes: RR-Interval value is uint16 */
-                    nextPtr += 2u;
-                }
-
-                if(rrInt == hrssRrIntPtr)
-                {
-                    hrsHeartRate.flags &= (uint8) ~CYBLE_HRS_HRM_RRINT;
-                    break;
-                }
+                length = (uint8)(attMtu - 3u);
             }
 
-            hrssRrIntCnt = 0;
+            /* Calculate the actual length of pdu: the RR-interval block length should be an even number */
+            length = ((length - nextPtr) & ~0x01) + nextPtr;
+
+            while((nextPtr < length) && (rrTail != rrHead))
+            {
+                CyBle_Set16ByPtr(&pdu[nextPtr], hrssRrRing[rrTail & HRS_RR_RING_MASK]);
+                /* Add 2 bytes: RR-Interval value is uint16 */
+                nextPtr += 2u;
+                rrTail++;
+            }
         }
 
+        NTF_STAT_BUILD_END();
+
         do
         {
             CyBle_ProcessEvents();
+            NTF_STAT_BUSY_POLL();
         }
         while(CyBle_GattGetBusyStatus() == CYBLE_STACK_STATE_BUSY);
 
         apiResult = CyBle_HrssSendNotification(cyBle_connHandle, CYBLE_HRS_HRM, nextPtr, pdu);
+        NTF_STAT_SENT(apiResult, nextPtr);
         
         if(apiResult != CYBLE_ERROR_OK)
         {
@@ -334,8 +318,16 @@ void HrssSendHeartRateNtf(void)
         }
         else
         {
+            /* The sent RR-Intervals leave the ring, a failed notification retries them */
+            hrssRrTail = rrTail;
             DBG_PRINTF("Heart Rate Notification is sent successfully, Heart Rate = %d \r\n", hrsHeartRate.heartRateValue);
         }
+
+        if(rrDropCnt != hrssRrDropCnt)
+        {
+            rrDropCnt = hrssRrDropCnt;
+            DBG_PRINTF("RR-Intervals dropped: %lu \r\n", rrDropCnt);
+        }
     }
 }
 
@@ -387,10 +379,7 @@ void SimulateHeartRate(void)
 
         while(rrIntCnt > 0u)
         {
-            if(!HrssIsRrIntervalBufferFull())
-            {
-                HrssAddRrInterval(rrInterval);
-            }
+            HrssAddRrInterval(rrInterval);
             rrInterval++;
             rrIntCnt--;
         }
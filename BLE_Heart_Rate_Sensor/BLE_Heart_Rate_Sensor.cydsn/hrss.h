@@ -28,12 +28,27 @@
 #define CYBLE_HRS_HRM_ENEXP             (0x08u)
 #define CYBLE_HRS_HRM_RRINT             (0x10u)
 
-#define CYBLE_HRS_HRM_CHAR_LEN          (20u)        /* for default 23-byte MTU */
-/* RR-Interval buffer size = ((char size)-(flags: 1 byte)-(Heart Rate: min 1 byte))/(RR-Interval size: 2 bytes) */
-#define CYBLE_HRS_HRM_RRSIZE            ((CYBLE_HRS_HRM_CHAR_LEN - 2u) / 2u)
+/* The largest Heart Rate Measurement sent when the client exchanges a bigger MTU.
+*  It holds the RR-Intervals of several seconds, a larger one would only cost RAM.
+*/
+#if (CYBLE_GATT_MTU > 67u)
+    #define CYBLE_HRS_HRM_CHAR_LEN      (64u)
+#else
+    #define CYBLE_HRS_HRM_CHAR_LEN      (CYBLE_GATT_MTU - 3u)
+#endif /* (CYBLE_GATT_MTU > 67u) */
+/* RR-Intervals buffered between the notifications, a power of two up to 128 */
+#define HRS_RR_RING_SIZE                (32u)
+#define HRS_RR_RING_MASK                (HRS_RR_RING_SIZE - 1u)
 #define CYBLE_ENERGY_EXPENDED_MAX_VALUE (0xFFFFu)   /* kilo Joules */
 #define CYBLE_HRS_RRCNT_OL              (0x80u)
 
+/* Fields of the Heart Rate Measurement ahead of the RR-Intervals, see pdu.h */
+#define HRS_HRM_FIELDS(FIELD) \
+    FIELD(0u,                       0u,                     FLAGS8, flags) \
+    FIELD(CYBLE_HRS_HRM_HRVAL16,    0u,                     U8,     heartRateValue) \
+    FIELD(CYBLE_HRS_HRM_HRVAL16,    CYBLE_HRS_HRM_HRVAL16,  U16,    heartRateValue) \
+    FIELD(CYBLE_HRS_HRM_ENEXP,      CYBLE_HRS_HRM_ENEXP,    U16,    energyExpendedValue)
+
 /* Energy expended is typically only included in the Heart Rate Measurement characteristic
 *  once every 10 measurements at a regular interval.
 */
@@ -57,7 +72,6 @@ typedef struct
     uint8 flags;
     uint16 heartRateValue;
     uint16 energyExpendedValue;
-    uint16 rrInterval[CYBLE_HRS_HRM_RRSIZE];
 }CYBLE_HRS_HRM_T;
 
 /* Body Sensor Location characteristic value type */
@@ -183,7 +197,7 @@ uint16 HrssGetHrmDescriptor(void);
 ********************************************************************************
 *
 * Summary:
-*  Checks if the RR-Interval buffer is full.
+*  Checks if the RR-Interval ring is full.
 *
 * Parameters:
 *  None.
@@ -194,14 +208,14 @@ uint16 HrssGetHrmDescriptor(void);
 *
 *******************************************************************************/
 #define HrssIsRrIntervalBufferFull()\
-            (hrssRrIntCnt >= CYBLE_HRS_HRM_RRSIZE)
+            ((uint8)(hrssRrHead - hrssRrTail) >= HRS_RR_RING_SIZE)
 
 /*******************************************************************************
 * Function Name: CyBle_HrssAreThereRrIntervals
 ********************************************************************************
 *
 * Summary:
-*  Checks if there are any RR-Intervals in the buffer.
+*  Checks if there are any RR-Intervals in the ring.
 *
 * Parameters:
 *  None.
@@ -212,7 +226,7 @@ uint16 HrssGetHrmDescriptor(void);
 *
 *******************************************************************************/
 #define HrssAreThereRrIntervals()\
-            ((hrsHeartRate.flags & CYBLE_HRS_HRM_RRINT) != 0u)
+            (hrssRrHead != hrssRrTail)
 
 
 /***************************************
@@ -220,8 +234,10 @@ uint16 HrssGetHrmDescriptor(void);
 ***************************************/
 /* Heart Rate Measurement characteristic data structure */
 extern CYBLE_HRS_HRM_T hrsHeartRate;
-extern uint8 hrssRrIntPtr;
-extern uint8 hrssRrIntCnt;
+extern volatile uint16 hrssRrRing[HRS_RR_RING_SIZE];
+extern volatile uint8 hrssRrHead;
+extern volatile uint8 hrssRrTail;
+extern volatile uint32 hrssRrDropCnt;
 
 
 #endif /* HRSS_H */
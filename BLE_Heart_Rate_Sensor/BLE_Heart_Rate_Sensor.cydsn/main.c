@@ -22,8 +22,8 @@
 #include "main.h"
 
 
-volatile uint32 mainTimer = 0;
 CYBLE_API_RESULT_T apiResult;
+uint16 attMtu = CYBLE_GATT_DEFAULT_MTU;     /* ATT MTU of the connection */
 
 
 /*******************************************************************************
@@ -201,6 +201,8 @@ void AppCallBack(uint32 event, void* eventParam)
         case CYBLE_EVT_GATT_CONNECT_IND:
             DBG_PRINTF("CYBLE_EVT_GATT_CONNECT_IND: attId %x, bdHandle %x \r\n", 
                 ((CYBLE_CONN_HANDLE_T *)eventParam)->attId, ((CYBLE_CONN_HANDLE_T *)eventParam)->bdHandle);
+            /* Every connection starts with the default MTU until the client exchanges it */
+            attMtu = CYBLE_GATT_DEFAULT_MTU;
             break;
 
         case CYBLE_EVT_GATT_DISCONNECT_IND:
@@ -217,7 +219,12 @@ void AppCallBack(uint32 event, void* eventParam)
             break;
 
         case CYBLE_EVT_GATTS_XCNHG_MTU_REQ:
-            DBG_PRINTF("CYBLE_EVT_GATTS_XCNHG_MTU_REQ \r\n");
+            /* The stack has responded with the MTU of the component, the smaller one is used */
+            if(CYBLE_ERROR_OK != CyBle_GattGetMtuSize(&attMtu))
+            {
+                attMtu = CYBLE_GATT_DEFAULT_MTU;
+            }
+            DBG_PRINTF("CYBLE_EVT_GATTS_XCNHG_MTU_REQ, mtu: %d \r\n", attMtu);
             break;
 
         case CYBLE_EVT_GATTS_HANDLE_VALUE_CNF:
@@ -261,14 +268,16 @@ void AppCallBack(uint32 event, void* eventParam)
 
 
 /*******************************************************************************
-* Function Name: Timer_Interrupt
+* Function Name: Timer_CallBack
 ********************************************************************************
 *
 * Summary:
-*  Handles the Interrupt Service Routine for the WDT timer.
+*  Handles the one second timer of the power manager in the main loop.
+*  Blinks the advertising LED, simulates the heart rate and measures the
+*  battery level.
 *
 *******************************************************************************/
-CY_ISR(Timer_Interrupt)
+static void Timer_CallBack(void)
 {
     static uint8 led = LED_OFF;
     
@@ -279,79 +288,58 @@ CY_ISR(Timer_Interrupt)
         Advertising_LED_Write(led);
     }
     
-    /* Indicate that timer is raised to the main loop */
-    mainTimer++;
+    NTF_STAT_TICK();
+    PM_STAT_TICK();
+
+    /* Periodically simulate heart rate and measure a battery level 
+    *  and send results to the Client
+    */
+    if(CyBle_GetState() == CYBLE_STATE_CONNECTED)
+    {
+        SimulateHeartRate();
+        MeasureBattery();
+        NTF_STAT_PROCESS();
+    }
 }
 
 
+#if (DEBUG_UART_ENABLED == ENABLED)
 /*******************************************************************************
-* Function Name: LowPowerImplementation()
+* Function Name: DebugUartBusy
 ********************************************************************************
-* Summary:
-* Implements low power in the project.
 *
-* Parameters:
-* None
+* Summary:
+*  Busy holder of the debug UART. The CPU sleeps instead of entering
+*  Deep-Sleep until all debug information has been sent.
 *
 * Return:
-* None
+*  The deepest power mode allowed.
 *
-* Theory:
-* The function tries to enter deep sleep as much as possible - whenever the 
-* BLE is idle and the UART transmission/reception is not happening. At all other
-* times, the function tries to enter CPU sleep.
+*******************************************************************************/
+static uint8 DebugUartBusy(void)
+{
+    return(((UART_DEB_SpiUartGetTxBufferSize() + UART_DEB_GET_TX_FIFO_SR_VALID) == 0u) ?
+        PWR_MODE_DEEPSLEEP : PWR_MODE_SLEEP);
+}
+#endif /* (DEBUG_UART_ENABLED == ENABLED) */
+
+
+/*******************************************************************************
+* Function Name: FlashWriteBusy
+********************************************************************************
+*
+* Summary:
+*  Busy holder of the bonding data. Keeps the main loop running until the
+*  pending bonding data is stored to flash.
+*
+* Return:
+*  The deepest power mode allowed.
 *
 *******************************************************************************/
-static void LowPowerImplementation(void)
+static uint8 FlashWriteBusy(void)
 {
-    CYBLE_LP_MODE_T bleMode;
-    uint8 interruptStatus;
-    
-    /* For advertising and connected states, implement deep sleep 
-     * functionality to achieve low power in the system. For more details
-     * on the low power implementation, refer to the Low Power Application 
-     * Note.
-     */
-    if((CyBle_GetState() == CYBLE_STATE_ADVERTISING) || 
-       (CyBle_GetState() == CYBLE_STATE_CONNECTED))
-    {
-        /* Request BLE subsystem to enter into Deep-Sleep mode between connection and advertising intervals */
-        bleMode = CyBle_EnterLPM(CYBLE_BLESS_DEEPSLEEP);
-        /* Disable global interrupts */
-        interruptStatus = CyEnterCriticalSection();
-        /* When BLE subsystem has been put into Deep-Sleep mode */
-        if(bleMode == CYBLE_BLESS_DEEPSLEEP)
-        {
-            /* And it is still there or ECO is on */
-            if((CyBle_GetBleSsState() == CYBLE_BLESS_STATE_ECO_ON) || 
-               (CyBle_GetBleSsState() == CYBLE_BLESS_STATE_DEEPSLEEP))
-            {
-            #if (DEBUG_UART_ENABLED == ENABLED)
-                /* Put the CPU into the Deep-Sleep mode when all debug information has been sent */
-                if((UART_DEB_SpiUartGetTxBufferSize() + UART_DEB_GET_TX_FIFO_SR_VALID) == 0u)
-                {
-                    CySysPmDeepSleep();
-                }
-                else /* Put the CPU into Sleep mode and let SCB to continue sending debug data */
-                {
-                    CySysPmSleep();
-                }
-            #else
-                CySysPmDeepSleep();
-            #endif /* (DEBUG_UART_ENABLED == ENABLED) */
-            }
-        }
-        else /* When BLE subsystem has been put into Sleep mode or is active */
-        {
-            /* And hardware doesn't finish Tx/Rx opeation - put the CPU into Sleep mode */
-            if(CyBle_GetBleSsState() != CYBLE_BLESS_STATE_EVENT_CLOSE)
-            {
-                CySysPmSleep();
-            }
-        }
-        /* Enable global interrupt */
-        CyExitCriticalSection(interruptStatus);
-    }
+    return(((cyBle_pendingFlashWrite != 0u) && (CyBle_GetState() == CYBLE_STATE_CONNECTED)) ?
+        PWR_MODE_ACTIVE : PWR_MODE_DEEPSLEEP);
 }
 
 
@@ -401,10 +389,17 @@ int main()
     
     ADC_Start();
     
-    /* Register Timer_Interrupt() by the WDT COUNTER2 to generate interrupt every second */
-    CySysWdtSetInterruptCallback(CY_SYS_WDT_COUNTER2, Timer_Interrupt);
-    /* Enable the COUNTER2 ISR handler. */
-    CySysWdtEnableCounterIsr(CY_SYS_WDT_COUNTER2);
+    /* Start the power manager and route its WDT counter interrupt */
+    PwrMgrStart();
+    CySysWdtSetInterruptCallback(PWR_MGR_WDT_COUNTER, PwrMgrTimerInterrupt);
+    CySysWdtEnableCounterIsr(PWR_MGR_WDT_COUNTER);
+#if (DEBUG_UART_ENABLED == ENABLED)
+    (void)PwrMgrRegisterBusy(DebugUartBusy);
+#endif /* (DEBUG_UART_ENABLED == ENABLED) */
+    (void)PwrMgrRegisterBusy(FlashWriteBusy);
+    
+    /* Call Timer_CallBack() every second */
+    PwrMgrTimerStart(PwrMgrTimerCreate(Timer_CallBack), MAIN_TIMER_PERIOD, 1u);
     
     /***************************************************************************
     * Main polling loop
@@ -414,25 +409,13 @@ int main()
         /* CyBle_ProcessEvents() allows BLE stack to process pending events */
         CyBle_ProcessEvents();
 
-        /* To achieve low power in the device */
-        LowPowerImplementation();
+        /* Handle the timers and put the device into the lowest possible power mode */
+        PwrMgrProcess();
+        PM_STAT_PROCESS();
 
-        /***********************************************************************
-        * Wait for connection established with Central device
-        ***********************************************************************/
+        /* Store bonding data to flash only when all debug information has been sent */
         if(CyBle_GetState() == CYBLE_STATE_CONNECTED)
         {
-            /*******************************************************************
-            *  Periodically simulate heart rate and measure a battery level 
-            *  and send results to the Client
-            *******************************************************************/        
-            if(mainTimer != 0u)
-            {
-                mainTimer = 0u;
-                SimulateHeartRate();
-                MeasureBattery();
-            }
-            else 
         #if (DEBUG_UART_ENABLED == ENABLED)
             if((cyBle_pendingFlashWrite != 0u) &&
                ((UART_DEB_SpiUartGetTxBufferSize() + UART_DEB_GET_TX_FIFO_SR_VALID) == 0u))
@@ -440,14 +423,9 @@ int main()
             if(cyBle_pendingFlashWrite != 0u)
         #endif /* (DEBUG_UART_ENABLED == ENABLED) */
             {
-                /* Store bounding data to flash only when all debug information has been sent */
                 apiResult = CyBle_StoreBondingData(0u);
                 DBG_PRINTF("Store bonding data, status: %x \r\n", apiResult);
             }
-            else
-            {
-                /* nothing else */ 
-            }
         }
     }
 }
@@ -21,10 +21,14 @@
 #include <stdio.h>
 
 #include "debug.h"
+#include "pdu.h"
 
 /* Profile specific includes */
 #include "bass.h"
 #include "hrss.h"
+#include "ntfstat.h"
+#include "pwrmgr.h"
+#include "pmstat.h"
 
 
 #define LED_ON                      (0u)
@@ -32,6 +36,8 @@
     
 #define PASSKEY                     (0x04u)
 
+#define MAIN_TIMER_PERIOD           (1000u)     /* Period of Timer_CallBack(), ms */
+
 
 /***************************************
 *      API Function Prototypes
@@ -43,6 +49,7 @@ void StartAdvertisement(void);
 *      External data references
 ***************************************/
 extern CYBLE_API_RESULT_T apiResult;
+extern uint16 attMtu;
 extern uint16 i;
 extern uint8 flag;
     
@@ -0,0 +1,232 @@
+/*******************************************************************************
+* File Name: pmstat.c
+*
+* Version 1.0
+*
+* Description:
+*  This file contains the low power statistics: how often PwrMgrProcess()
+*  chooses each CPU power mode, the time spent in the modes, why Deep-Sleep was
+*  not entered and a histogram of the sleep durations. The time is measured by
+*  the free running WDT counter, which keeps counting in Deep-Sleep.
+*
+*  The report is printed over the debug UART, so its own transmission shows up
+*  as PWR_REASON_HOLDER refusals in the next period.
+*
+* Hardware Dependency:
+*  CY8CKIT-042 BLE
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include "main.h"
+
+
+PM_STAT_T pmStat;
+
+static volatile uint32 pmStatSeconds = 0u;
+static uint32 pmStatPeriodStart = 0u;   /* Timer value at the beginning of the period */
+static uint32 pmStatSleepStart = 0u;    /* Timer value before the last sleep */
+static uint8 pmStatMode = PM_STAT_ACTIVE;
+
+
+/*******************************************************************************
+* Function Name: PmStatReset
+********************************************************************************
+*
+* Summary:
+*   Clears all the accumulated counters and starts a new period.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void PmStatReset(void)
+{
+    (void)memset(&pmStat, 0, sizeof(pmStat));
+    pmStatPeriodStart = CySysWdtReadCount(PM_STAT_TIMER);
+}
+
+
+/*******************************************************************************
+* Function Name: PmStatEnter
+********************************************************************************
+*
+* Summary:
+*   Accounts a PwrMgrProcess() decision. For the sleep modes it is
+*   called right before the CPU enters the mode and PmStatExit() is called
+*   after the wakeup.
+*
+* Parameters:
+*   mode   - PM_STAT_DEEPSLEEP, PM_STAT_SLEEP or PM_STAT_ACTIVE.
+*   reason - why Deep-Sleep was not entered, PWR_REASON_NONE for
+*            PM_STAT_DEEPSLEEP.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void PmStatEnter(uint8 mode, uint8 reason)
+{
+    pmStat.entries[mode]++;
+    if(PWR_REASON_NONE != reason)
+    {
+        pmStat.refused[reason]++;
+    }
+
+    pmStatMode = mode;
+    pmStatSleepStart = CySysWdtReadCount(PM_STAT_TIMER);
+}
+
+
+/*******************************************************************************
+* Function Name: PmStatExit
+********************************************************************************
+*
+* Summary:
+*   Accumulates the duration of the sleep that has just ended.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void PmStatExit(void)
+{
+    uint32 ticks = CySysWdtReadCount(PM_STAT_TIMER) - pmStatSleepStart;
+    uint32 ms = ticks >> PM_STAT_HIST_SHIFT;
+    uint8 bin = 0u;
+
+    while((0u != ms) && (bin < (PM_STAT_HIST_BINS - 1u)))
+    {
+        ms >>= 1u;
+        bin++;
+    }
+
+    pmStat.ticks[pmStatMode] += ticks;
+    pmStat.hist[pmStatMode][bin]++;
+}
+
+
+/*******************************************************************************
+* Function Name: PmStatTick
+********************************************************************************
+*
+* Summary:
+*   Advances the report period. Must be called every second from the WDT
+*   interrupt.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void PmStatTick(void)
+{
+    pmStatSeconds++;
+}
+
+
+/*******************************************************************************
+* Function Name: PmStatPermille
+********************************************************************************
+*
+* Summary:
+*   Calculates the share of the period without overflowing 32 bits.
+*
+* Parameters:
+*   ticks - the time spent in a mode.
+*   total - the period length.
+*
+* Return:
+*   uint32 - the share in tenths of a percent.
+*
+*******************************************************************************/
+static uint32 PmStatPermille(uint32 ticks, uint32 total)
+{
+    return((total >= 1000u) ? (ticks / (total / 1000u)) : 0u);
+}
+
+
+/*******************************************************************************
+* Function Name: PmStatProcess
+********************************************************************************
+*
+* Summary:
+*   Prints the duty cycle of the CPU power modes, the Deep-Sleep refusals and
+*   the sleep duration histograms every PM_STAT_REPORT_PERIOD seconds and
+*   restarts the accumulation. Called from the main loop.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void PmStatProcess(void)
+{
+    static const char8 * const pmStatModeName[PM_STAT_MODES - 1u] = {"Deep-Sleep", "Sleep"};
+    uint32 seconds;
+    uint32 total;
+    uint32 active;
+    uint8 interruptStatus;
+    uint8 mode;
+    uint8 bin;
+
+    interruptStatus = CyEnterCriticalSection();
+    seconds = pmStatSeconds;
+    if(seconds >= PM_STAT_REPORT_PERIOD)
+    {
+        pmStatSeconds = 0u;
+    }
+    CyExitCriticalSection(interruptStatus);
+
+    if(seconds >= PM_STAT_REPORT_PERIOD)
+    {
+        total = CySysWdtReadCount(PM_STAT_TIMER) - pmStatPeriodStart;
+        active = total - pmStat.ticks[PM_STAT_DEEPSLEEP] - pmStat.ticks[PM_STAT_SLEEP];
+        if(active > total)
+        {
+            active = 0u;
+        }
+        pmStat.ticks[PM_STAT_ACTIVE] = active;
+
+        DBG_PRINTF("PM stat: Deep-Sleep %ld.%ld%% (%ld), Sleep %ld.%ld%% (%ld), Active %ld.%ld%% (%ld) \r\n",
+            PmStatPermille(pmStat.ticks[PM_STAT_DEEPSLEEP], total) / 10u,
+            PmStatPermille(pmStat.ticks[PM_STAT_DEEPSLEEP], total) % 10u, pmStat.entries[PM_STAT_DEEPSLEEP],
+            PmStatPermille(pmStat.ticks[PM_STAT_SLEEP], total) / 10u,
+            PmStatPermille(pmStat.ticks[PM_STAT_SLEEP], total) % 10u, pmStat.entries[PM_STAT_SLEEP],
+            PmStatPermille(active, total) / 10u,
+            PmStatPermille(active, total) % 10u, pmStat.entries[PM_STAT_ACTIVE]);
+        DBG_PRINTF("Deep-Sleep refused: busy %ld, BLE active %ld, BLESS %ld, event close %ld, state %ld, event %ld \r\n",
+            pmStat.refused[PWR_REASON_HOLDER], pmStat.refused[PWR_REASON_BLE_ACTIVE],
+            pmStat.refused[PWR_REASON_BLESS], pmStat.refused[PWR_REASON_EVENT_CLOSE],
+            pmStat.refused[PWR_REASON_STATE], pmStat.refused[PWR_REASON_EVENT]);
+
+        for(mode = 0u; mode < (PM_STAT_MODES - 1u); mode++)
+        {
+            DBG_PRINTF("%s ms:", pmStatModeName[mode]);
+            for(bin = 0u; bin < (PM_STAT_HIST_BINS - 1u); bin++)
+            {
+                DBG_PRINTF(" <%d: %ld", 1u << bin, pmStat.hist[mode][bin]);
+            }
+            DBG_PRINTF(" more: %ld \r\n", pmStat.hist[mode][PM_STAT_HIST_BINS - 1u]);
+        }
+
+        PmStatReset();
+    }
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,100 @@
+/*******************************************************************************
+* File Name: pmstat.h
+*
+* Version 1.0
+*
+* Description:
+*  Contains the function prototypes and constants of the low power
+*  statistics.
+*
+* Hardware Dependency:
+*  CY8CKIT-042 BLE
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(PMSTAT_H)
+#define PMSTAT_H
+
+#include "main.h"
+
+
+/***************************************
+* Conditional Compilation Parameters
+***************************************/
+#define PM_STAT_ENABLED                     DISABLED
+
+
+/***************************************
+*        Constants
+***************************************/
+#define PM_STAT_REPORT_PERIOD               (10u)   /* Seconds between two reports */
+#define PM_STAT_TIMER                       (CY_SYS_WDT_COUNTER2)   /* Free running LFCLK counter */
+
+/* CPU power modes and the reasons for not entering Deep-Sleep are the ones
+*  of the power manager policy.
+*/
+#define PM_STAT_DEEPSLEEP                   (PWR_MODE_DEEPSLEEP)
+#define PM_STAT_SLEEP                       (PWR_MODE_SLEEP)
+#define PM_STAT_ACTIVE                      (PWR_MODE_ACTIVE)   /* PwrMgrProcess() returned without sleep */
+#define PM_STAT_MODES                       (PWR_MODES)
+#define PM_STAT_REASONS                     (PWR_REASONS)
+
+/* Sleep duration histogram. Bin 0 holds sleeps shorter than 1 ms, bin n
+*  the ones of 2^(n-1) to 2^n ms, the last bin all the longer ones.
+*/
+#define PM_STAT_HIST_BINS                   (11u)
+#define PM_STAT_HIST_SHIFT                  (5u)    /* 32 LFCLK ticks are about 1 ms */
+
+
+/***************************************
+*        Data Struct Definition
+***************************************/
+typedef struct
+{
+    uint32 entries[PM_STAT_MODES];      /* Number of PwrMgrProcess() decisions per mode */
+    uint32 ticks[PM_STAT_MODES];        /* LFCLK ticks spent in each mode */
+    uint32 refused[PM_STAT_REASONS];    /* Deep-Sleep refusals per reason */
+    uint32 hist[PM_STAT_MODES - 1u][PM_STAT_HIST_BINS];    /* Sleep durations per sleep mode */
+} PM_STAT_T;
+
+
+/***************************************
+*      API Function Prototypes
+***************************************/
+void PmStatReset(void);
+void PmStatEnter(uint8 mode, uint8 reason);
+void PmStatExit(void);
+void PmStatTick(void);
+void PmStatProcess(void);
+
+
+/***************************************
+*        Macros
+***************************************/
+#if (PM_STAT_ENABLED == ENABLED)
+    #define PM_STAT_TICK()                  PmStatTick()
+    #define PM_STAT_PROCESS()               PmStatProcess()
+
+    /* Observe the decisions of the power manager */
+    #define PWR_MGR_ENTER_HOOK(mode, reason) PmStatEnter((mode), (reason))
+    #define PWR_MGR_EXIT_HOOK()             PmStatExit()
+#else
+    #define PM_STAT_TICK()
+    #define PM_STAT_PROCESS()
+#endif /* (PM_STAT_ENABLED == ENABLED) */
+
+
+/***************************************
+*      External data references
+***************************************/
+extern PM_STAT_T pmStat;
+
+
+#endif /* PMSTAT_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,92 @@
+/*******************************************************************************
+* File Name: pwrmgr.h
+*
+* Version 1.0
+*
+* Description:
+*  Contains the function prototypes and constants of the power manager.
+*
+* Hardware Dependency:
+*  CY8CKIT-042 BLE
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(PWRMGR_H)
+#define PWRMGR_H
+
+#include <project.h>
+#include "pwrpolicy.h"
+
+
+/***************************************
+*        Constants
+***************************************/
+/* The WDT counter of the timer scheduler, COUNTER0 or COUNTER1 */
+#define PWR_MGR_WDT_COUNTER                 (CY_SYS_WDT_COUNTER0)
+#define PWR_MGR_WDT_COUNTER_MASK            (CY_SYS_WDT_COUNTER0_MASK)
+#define PWR_MGR_WDT_INT                     (CY_SYS_WDT_COUNTER0_INT)
+
+#define PWR_MGR_LFCLK_HZ                    (32768u)
+
+/* Table sizes */
+#define PWR_MGR_BUSY_MAX                    (4u)
+#define PWR_MGR_WAKE_MAX                    (4u)
+#define PWR_MGR_TIMER_MAX                   (4u)
+
+/* The nearest match is a few LFCLK periods ahead for the WDT to see it. The
+*  farthest one is half the 16-bit counter range, so the counter never wraps
+*  twice between two reads.
+*/
+#define PWR_MGR_MATCH_MIN                   (8u)
+#define PWR_MGR_MATCH_MAX                   (0x8000u)
+
+#define PWR_MGR_WAKE_TIMER                  (0u)    /* Wake reason of the timer scheduler */
+#define PWR_MGR_INVALID                     (0xFFu)
+
+
+/***************************************
+*        Data Types
+***************************************/
+/* Returns the deepest power mode its owner allows now: PWR_MODE_xxx */
+typedef uint8 (*PWR_MGR_BUSY_FUNC)(void);
+
+/* Handles a wake reason or an expired timer in the main loop */
+typedef void (*PWR_MGR_EVENT_FUNC)(void);
+
+typedef struct
+{
+    PWR_MGR_EVENT_FUNC func;
+    uint32 expire;          /* Expiration time in LFCLK ticks */
+    uint32 period;          /* Reload value, 0 for a one-shot timer */
+    uint8 active;
+} PWR_MGR_TIMER_T;
+
+
+/***************************************
+*      API Function Prototypes
+***************************************/
+void PwrMgrStart(void);
+cystatus PwrMgrRegisterBusy(PWR_MGR_BUSY_FUNC func);
+uint8 PwrMgrRegisterWake(PWR_MGR_EVENT_FUNC func);
+void PwrMgrWake(uint8 reason);
+uint8 PwrMgrTimerCreate(PWR_MGR_EVENT_FUNC func);
+void PwrMgrTimerStart(uint8 timer, uint32 ms, uint8 periodic);
+void PwrMgrTimerStop(uint8 timer);
+void PwrMgrTimerInterrupt(void);
+void PwrMgrProcess(void);
+
+
+/***************************************
+*        Macros
+***************************************/
+#define PWR_MGR_MS_TO_TICKS(ms)             ((((uint32)(ms) * (PWR_MGR_LFCLK_HZ / 8u)) + 62u) / 125u)
+
+
+#endif /* PWRMGR_H */
+
+/* [] END OF FILE */
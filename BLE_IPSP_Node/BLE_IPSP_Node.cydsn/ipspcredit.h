@@ -0,0 +1,68 @@
+/*******************************************************************************
+* File Name: ipspcredit.h
+*
+* Version 1.0
+*
+* Description:
+*  Contains the function prototypes and constants of the IPSP receive credit
+*  controller.
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(IPSPCREDIT_H)
+#define IPSPCREDIT_H
+
+#include <project.h>
+
+
+/***************************************
+*        Constants
+***************************************/
+/* Credits taken by an SDU of L2CAP_MAX_LEN bytes: one per K-frame of the local MPS */
+#define IPSP_CREDIT_SDU             ((L2CAP_MAX_LEN + 2u + CYBLE_L2CAP_MPS - 1u) / CYBLE_L2CAP_MPS)
+
+#define IPSP_CREDIT_MIN             (IPSP_CREDIT_SDU)
+#define IPSP_CREDIT_MAX             (LE_DATA_CREDITS_IPSP)
+#define IPSP_CREDIT_INIT            (4u * IPSP_CREDIT_SDU)  /* Initial window and credits */
+#define IPSP_CREDIT_HORIZON         (250u)  /* Milliseconds of traffic covered by the window */
+#define IPSP_CREDIT_BATCH           ((IPSP_CREDIT_SDU + 1u) / 2u)   /* Smallest top-up sent */
+
+#define IPSP_CREDIT_CLOCK_HZ        (32768u)    /* LFCLK, the clock of WDT counter 2 */
+
+
+/***************************************
+*        Data Struct Definition
+***************************************/
+typedef struct
+{
+    uint16 window;          /* Credits the peer should hold */
+    uint16 peerCredit;      /* Credits the peer holds */
+    uint32 granted;         /* Credits sent to the peer since connection */
+    uint32 consumed;        /* Credits used by the received SDUs since connection */
+    uint32 stalls;          /* Times the peer ran out of credits for an SDU */
+    uint32 zeroTicks;       /* LFCLK ticks the peer spent out of credits */
+    uint32 zeroStart;       /* WDT counter 2 value when the peer ran out of credits */
+    uint32 rate;            /* Credits consumed in the current second */
+    uint8  stalled;         /* The peer has run out of credits in the current second */
+} IPSP_CREDIT_T;
+
+
+/***************************************
+*      API Function Prototypes
+***************************************/
+void IpspCreditInit(IPSP_CREDIT_T *ctrl, uint16 credit);
+void IpspCreditConsume(IPSP_CREDIT_T *ctrl, uint16 length);
+void IpspCreditSync(IPSP_CREDIT_T *ctrl, uint16 credit);
+void IpspCreditProcess(IPSP_CREDIT_T *ctrl, uint16 lCid, uint16 freeCredit);
+void IpspCreditTick(IPSP_CREDIT_T *ctrl);
+uint32 IpspCreditZeroTime(const IPSP_CREDIT_T *ctrl);
+
+
+#endif /* IPSPCREDIT_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,87 @@
+/*******************************************************************************
+* File Name: lowpan.h
+*
+* Version 1.0
+*
+* Description:
+*  Contains the function prototypes and constants of the 6LoWPAN header
+*  compression (RFC 6282, RFC 7668).
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(LOWPAN_H)
+#define LOWPAN_H
+
+#include "cytypes.h"
+
+
+/***************************************
+*        Constants
+***************************************/
+#define LOWPAN_BD_ADDR_SIZE         (6u)        /* Bluetooth device address, LSB first */
+#define LOWPAN_IID_SIZE             (8u)
+#define LOWPAN_IPV6_ADDR_SIZE       (16u)
+
+/* Dispatch values of the first SDU byte */
+#define LOWPAN_DISPATCH_NALP        (0x00u)     /* 00xxxxxx: not a LoWPAN frame */
+#define LOWPAN_DISPATCH_NALP_MASK   (0xC0u)
+#define LOWPAN_DISPATCH_IPV6        (0x41u)     /* Uncompressed IPv6 header */
+#define LOWPAN_DISPATCH_IPHC        (0x60u)     /* 011xxxxx: IPHC compressed header */
+#define LOWPAN_DISPATCH_IPHC_MASK   (0xE0u)
+
+/* The largest compressed IPv6 and UDP header */
+#define LOWPAN_IPHC_HDR_MAX         (2u + 4u + 1u + 1u + (2u * LOWPAN_IPV6_ADDR_SIZE) + 1u + 4u + 2u)
+
+/* IPHC encoding, the first byte */
+#define LOWPAN_IPHC_TF_SHIFT        (3u)
+#define LOWPAN_IPHC_TF_MASK         (0x18u)
+#define LOWPAN_IPHC_NH              (0x04u)
+#define LOWPAN_IPHC_HLIM_MASK       (0x03u)
+/* IPHC encoding, the second byte */
+#define LOWPAN_IPHC_CID             (0x80u)
+#define LOWPAN_IPHC_SAC             (0x40u)
+#define LOWPAN_IPHC_SAM_SHIFT       (4u)
+#define LOWPAN_IPHC_M               (0x08u)
+#define LOWPAN_IPHC_DAC             (0x04u)
+#define LOWPAN_IPHC_DAM_SHIFT       (0u)
+#define LOWPAN_IPHC_AM_MASK         (0x03u)
+
+/* Traffic Class and Flow Label encodings */
+#define LOWPAN_TF_INLINE            (0u)        /* ECN, DSCP and Flow Label inline */
+#define LOWPAN_TF_NO_DSCP           (1u)        /* ECN and Flow Label inline */
+#define LOWPAN_TF_NO_FL             (2u)        /* ECN and DSCP inline */
+#define LOWPAN_TF_ELIDED            (3u)
+
+/* Address modes without a context */
+#define LOWPAN_AM_128               (0u)
+#define LOWPAN_AM_64                (1u)
+#define LOWPAN_AM_16                (2u)
+#define LOWPAN_AM_0                 (3u)
+
+/* UDP next header compression */
+#define LOWPAN_NHC_UDP              (0xF0u)
+#define LOWPAN_NHC_UDP_MASK         (0xF8u)
+#define LOWPAN_NHC_UDP_C            (0x04u)     /* Checksum elided */
+#define LOWPAN_NHC_UDP_P_MASK       (0x03u)
+#define LOWPAN_NHC_PORT_8           (0xF000u)   /* Ports 0xF000 - 0xF0FF */
+#define LOWPAN_NHC_PORT_4           (0xF0B0u)   /* Ports 0xF0B0 - 0xF0BF */
+
+
+/***************************************
+*      API Function Prototypes
+***************************************/
+void LowpanLinkLocal(const uint8 bdAddr[], uint8 addr[]);
+uint16 LowpanCompress(const uint8 ipv6[], uint16 length, const uint8 srcBdAddr[], const uint8 dstBdAddr[],
+                      uint8 frame[], uint16 size);
+uint16 LowpanDecompress(const uint8 frame[], uint16 length, const uint8 srcBdAddr[], const uint8 dstBdAddr[],
+                        uint8 ipv6[], uint16 size);
+
+
+#endif /* LOWPAN_H */
+
+/* [] END OF FILE */
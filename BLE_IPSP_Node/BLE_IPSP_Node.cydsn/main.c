@@ -5,8 +5,9 @@
 *
 * Description:
 *  This example demonstrates how to setup an IPv6 communication infrastructure 
-*  between two devices over a BLE transport using L2CAP channel. Creation 
-*  and transmission of IPv6 packets over BLE is not part of this example.
+*  between two devices over a BLE transport using L2CAP channel. IPv6 packets
+*  are sent with the 6LoWPAN header compression. Node answers ICMPv6 echo 
+*  requests and UDP datagrams sent to the echo port.
 *
 *  Router sends generated packets with different content to Node in the loop 
 *  and validate them with the afterwards received data packet. Node simply wraps
@@ -31,14 +32,75 @@ uint16 connIntv = CYBLE_GAPP_CONNECTION_INTERVAL_MIN;   /* in milliseconds / 1.2
 bool l2capConnected = false;
 bool l2capReadReceived = false;
 
-uint8 ipv6LoopbackBuffer[L2CAP_MAX_LEN];
-uint16 ipv6LoopbackLength = L2CAP_MAX_LEN; 
+IPSP_SDU_CHANNEL_T ipspSdu;          /* SDUs sent over the L2CAP channel */
+IPSP_CREDIT_T ipspCredit;            /* Receive credits of the L2CAP channel */
+uint32 ipv6LoopbackDropped = 0u;     /* SDUs dropped because the SDU pool was full */
+volatile uint8 timerTick = 0u;       /* Set every second by Timer_Interrupt */
+
+/* IPv6 over the L2CAP channel */
+CYBLE_GAP_BD_ADDR_T ipv6LocalBdAddr;
+CYBLE_GAP_BD_ADDR_T ipv6PeerBdAddr;
+uint8 ipv6Address[IPV6_ADDR_SIZE];   /* Link-local address of Node */
+static uint8 ipv6Buffer[IPV6_MTU];   /* Decompressed IPv6 packet */
 
 
 /* L2CAP Channel ID and parameters for the peer device */
 CYBLE_L2CAP_CBFC_CONN_IND_PARAM_T l2capParameters;
 
 
+/*******************************************************************************
+* Function Name: Ipv6Receive
+********************************************************************************
+*
+* Summary:
+*  Decompresses an IPv6 packet received from Router. The reply to an echo 
+*  request is compressed directly to an SDU buffer and queued for sending.
+*
+* Parameters:
+*  data   - the LoWPAN frame.
+*  length - the frame length.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void Ipv6Receive(const uint8 data[], uint16 length)
+{
+    uint16 ipv6Length;
+    uint8 *sdu;
+
+    ipv6Length = LowpanDecompress(data, length, ipv6PeerBdAddr.bdAddr, ipv6LocalBdAddr.bdAddr, 
+                                  ipv6Buffer, IPV6_MTU);
+    if(ipv6Length == 0u)
+    {
+        DBG_PRINTF("Unsupported LoWPAN frame, dispatch: %x \r\n", data[0u]);
+    }
+    else
+    {
+        ipv6Length = Ipv6Process(ipv6Buffer, ipv6Length, ipv6Address);
+        if(ipv6Length != 0u)
+        {
+            sdu = IpspSduAlloc(&ipspSdu);
+            if(sdu != NULL)
+            {
+                length = LowpanCompress(ipv6Buffer, ipv6Length, ipv6LocalBdAddr.bdAddr, ipv6PeerBdAddr.bdAddr, 
+                                        sdu, L2CAP_MAX_LEN);
+                if(length != 0u)
+                {
+                    IpspSduCommit(&ipspSdu, length);
+                    l2capReadReceived = true;
+                }
+            }
+            else
+            {
+                ipv6LoopbackDropped++;
+                DBG_PRINTF("SDU pool is full, dropped: %ld \r\n", ipv6LoopbackDropped);
+            }
+        }
+    }
+}
+
+
 /*******************************************************************************
 * Function Name: AppCallBack()
 ********************************************************************************
@@ -211,11 +273,23 @@ void AppCallBack(uint32 event, void* eventParam)
                 CYBLE_L2CAP_CBFC_CONNECT_PARAM_T connParam;
                 connParam.mtu    = CYBLE_L2CAP_MTU;
                 connParam.mps    = CYBLE_L2CAP_MPS;
-                connParam.credit = LE_DATA_CREDITS_IPSP;
+                connParam.credit = IPSP_CREDIT_INIT;
                 apiResult = CyBle_L2capCbfcConnectRsp(l2capParameters.lCid,
                                 CYBLE_L2CAP_CONNECTION_SUCCESSFUL, &connParam);
                 DBG_PRINTF("SUCCESSFUL \r\n"); 
                 l2capConnected = true;
+                IpspSduOpen(&ipspSdu, l2capParameters.connParam.credit, l2capParameters.connParam.mps);
+                IpspCreditInit(&ipspCredit, IPSP_CREDIT_INIT);
+                
+                /* The link-layer addresses are used to compress the IPv6 addresses */
+                ipv6LocalBdAddr.type = 0u;
+                CyBle_GetDeviceAddress(&ipv6LocalBdAddr);
+                apiResult = CyBle_GapGetPeerBdAddr(l2capParameters.bdHandle, &ipv6PeerBdAddr);
+                if(apiResult != CYBLE_ERROR_OK)
+                {
+                    DBG_PRINTF("CyBle_GapGetPeerBdAddr API Error: %d \r\n", apiResult);
+                }
+                LowpanLinkLocal(ipv6LocalBdAddr.bdAddr, ipv6Address);
             }
             else
             {
@@ -232,35 +306,52 @@ void AppCallBack(uint32 event, void* eventParam)
         case CYBLE_EVT_L2CAP_CBFC_DISCONN_IND:
             DBG_PRINTF("CYBLE_EVT_L2CAP_CBFC_DISCONN_IND: lCid=%d \r\n", *(uint16 *)eventParam);
             l2capConnected = false;
+            l2capReadReceived = false;
+            IpspSduClose(&ipspSdu);
             break;
 
         /* Following two events are required to receive data */        
         case CYBLE_EVT_L2CAP_CBFC_DATA_READ:
             {
                 CYBLE_L2CAP_CBFC_RX_PARAM_T *rxDataParam = (CYBLE_L2CAP_CBFC_RX_PARAM_T *)eventParam;
+                uint8 *sdu;
+                uint16 length;
+            #if(DEBUG_UART_FULL)  
                 DBG_PRINTF("<- EVT_L2CAP_CBFC_DATA_READ: lCid=%d, result=%d, len=%d", 
                     rxDataParam->lCid,
                     rxDataParam->result,
                     rxDataParam->rxDataLength);
-            #if(DEBUG_UART_FULL)  
                 DBG_PRINTF(", data:");
                 for(i = 0; i < rxDataParam->rxDataLength; i++)
                 {
                     DBG_PRINTF("%2.2x", rxDataParam->rxData[i]);
                 }
-            #endif /* DEBUG_UART_FULL */
                 DBG_PRINTF("\r\n");
-                /* Data is received from Router. Copy the data to a memory buffer */
-                if(rxDataParam->rxDataLength <= L2CAP_MAX_LEN)
+            #endif /* DEBUG_UART_FULL */
+                IpspCreditConsume(&ipspCredit, rxDataParam->rxDataLength);
+                if(rxDataParam->rxDataLength == 0u)
+                {
+                    /* Nothing to wrap */
+                }
+                else if((rxDataParam->rxData[0u] & LOWPAN_DISPATCH_NALP_MASK) != LOWPAN_DISPATCH_NALP)
+                {
+                    Ipv6Receive(rxDataParam->rxData, rxDataParam->rxDataLength);
+                }
+                else if((sdu = IpspSduAlloc(&ipspSdu)) != NULL)
                 {
-                    ipv6LoopbackLength = rxDataParam->rxDataLength;
+                    /* Not a LoWPAN frame is received from Router. Copy the data to an SDU buffer, 
+                     * it is sent back from the same buffer.
+                     */
+                    length = (rxDataParam->rxDataLength <= L2CAP_MAX_LEN) ? rxDataParam->rxDataLength : L2CAP_MAX_LEN;
+                    memcpy(sdu, rxDataParam->rxData, length);
+                    IpspSduCommit(&ipspSdu, length);
+                    l2capReadReceived = true;
                 }
                 else
                 {
-                    ipv6LoopbackLength = L2CAP_MAX_LEN;
+                    ipv6LoopbackDropped++;
+                    DBG_PRINTF("SDU pool is full, dropped: %ld \r\n", ipv6LoopbackDropped);
                 }
-                memcpy(ipv6LoopbackBuffer, rxDataParam->rxData, ipv6LoopbackLength);
-                l2capReadReceived = true;
             }
             break;
 
@@ -272,13 +363,9 @@ void AppCallBack(uint32 event, void* eventParam)
                     rxCreditParam->credit);
 
                 /* This event informs that receive credits reached the low mark. 
-                 * If the device expects more data to receive, send more credits back to the peer device.
+                 * The credits are sent back to the peer device from the main loop.
                  */
-                apiResult = CyBle_L2capCbfcSendFlowControlCredit(rxCreditParam->lCid, LE_DATA_CREDITS_IPSP);
-                if(apiResult != CYBLE_ERROR_OK)
-                {
-                    DBG_PRINTF("CyBle_L2capCbfcSendFlowControlCredit API Error: %d \r\n", apiResult);
-                }
+                IpspCreditSync(&ipspCredit, rxCreditParam->credit);
             }
             break;
 
@@ -288,9 +375,12 @@ void AppCallBack(uint32 event, void* eventParam)
                 ((CYBLE_L2CAP_CBFC_LOW_TX_CREDIT_PARAM_T *)eventParam)->lCid,
                 ((CYBLE_L2CAP_CBFC_LOW_TX_CREDIT_PARAM_T *)eventParam)->result,
                 ((CYBLE_L2CAP_CBFC_LOW_TX_CREDIT_PARAM_T *)eventParam)->credit);
+            IpspSduAddCredit(&ipspSdu, ((CYBLE_L2CAP_CBFC_LOW_TX_CREDIT_PARAM_T *)eventParam)->credit);
             break;
         
         case CYBLE_EVT_L2CAP_CBFC_DATA_WRITE_IND:
+            /* The stack does not use the SDU buffer anymore */
+            IpspSduWriteComplete(&ipspSdu);
             #if(DEBUG_UART_FULL)
             {
                 CYBLE_L2CAP_CBFC_DATA_WRITE_PARAM_T *writeDataParam = (CYBLE_L2CAP_CBFC_DATA_WRITE_PARAM_T*)eventParam;
@@ -336,6 +426,8 @@ CY_ISR(Timer_Interrupt)
         led ^= LED_OFF;
         Advertising_LED_Write(led);
     }
+
+    timerTick = 1u;
 }
 
 
@@ -524,16 +616,38 @@ int main()
 
         if((CyBle_GetState() == CYBLE_STATE_CONNECTED) && (l2capConnected == true))
         {
-            /* Keep sending the data to the router, until TX credits are over */
+            /* Keep sending the queued SDUs to the router, until TX credits are over. 
+             * An SDU takes at least one credit, so the credit window of the router is the limit.
+             */
             if((cyBle_busyStatus == 0u) && (l2capReadReceived == true))
             {
                 UpdateLedState();
-                l2capReadReceived = false;
-                apiResult = CyBle_L2capChannelDataWrite(l2capParameters.bdHandle,
-                                l2capParameters.lCid, ipv6LoopbackBuffer, ipv6LoopbackLength);
-                DBG_PRINTF("-> CyBle_L2capChannelDataWrite API result: %d \r\n", apiResult);
+                apiResult = IpspSduSend(&ipspSdu, l2capParameters.bdHandle, l2capParameters.lCid, ipspSdu.txCredit);
+                if(apiResult != CYBLE_ERROR_OK)
+                {
+                    DBG_PRINTF("-> CyBle_L2capChannelDataWrite API Error: %d \r\n", apiResult);
+                }
+                l2capReadReceived = (ipspSdu.queued != 0u);
                 UpdateLedState();
             }
+
+            /* Return the credits as the SDU buffers become free */
+            IpspCreditProcess(&ipspCredit, l2capParameters.lCid, 
+                (uint16)(IpspSduAvailable(&ipspSdu) * IPSP_CREDIT_SDU));
+        }
+
+        if(timerTick != 0u)
+        {
+            static uint32 consumed = 0u;
+            
+            timerTick = 0u;
+            IpspCreditTick(&ipspCredit);
+            if(ipspCredit.consumed != consumed)
+            {
+                consumed = ipspCredit.consumed;
+                DBG_PRINTF("RX credit: window=%d, granted=%ld, stalls=%ld, zero credit=%ld ms \r\n", 
+                    ipspCredit.window, ipspCredit.granted, ipspCredit.stalls, IpspCreditZeroTime(&ipspCredit));
+            }
         }
         
         /* Store bonding data to flash only when all debug information has been sent */
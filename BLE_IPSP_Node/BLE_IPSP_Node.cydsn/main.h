@@ -16,6 +16,10 @@
 
 #include <project.h>
 #include <stdio.h>
+#include "ipspsdu.h"
+#include "ipspcredit.h"
+#include "lowpan.h"
+#include "ipv6.h"
 
 #define ENABLED                     (1u)
 #define DISABLED                    (0u)
@@ -36,8 +40,10 @@
 
 /* IPSP defines */
 #define LE_DATA_CREDITS_IPSP         (1000u)
-/* Set the watermark to half of the total credits to be used */
-#define LE_WATER_MARK_IPSP           (LE_DATA_CREDITS_IPSP/2u)
+/* Credits are returned by the credit controller before the peer runs out of
+*  them, the watermark only reports the peer that cannot send a full SDU.
+*/
+#define LE_WATER_MARK_IPSP           (IPSP_CREDIT_SDU)
 
 #define L2CAP_MAX_LEN                (CYBLE_L2CAP_MTU - 2u)
 
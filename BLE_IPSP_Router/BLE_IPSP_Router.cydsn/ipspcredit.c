@@ -0,0 +1,253 @@
+/*******************************************************************************
+* File Name: ipspcredit.c
+*
+* Version 1.0
+*
+* Description:
+*  This file contains the IPSP receive credit controller. It replaces the
+*  fixed top-up of LE_DATA_CREDITS_IPSP at the receive credit low mark.
+*
+*  The controller tracks the credits held by the peer and returns the
+*  consumed ones from the main loop as soon as they amount to
+*  IPSP_CREDIT_BATCH, so the peer does not have to drain its credits before
+*  it gets new ones. The number of credits the peer may hold (the window) is
+*  sized every second to cover IPSP_CREDIT_HORIZON milliseconds of the
+*  measured receive rate, and is doubled when the peer has run out of
+*  credits. The caller also limits the window by the free receive buffers.
+*  Every L2CAP channel has its own controller.
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include "main.h"
+
+
+/*******************************************************************************
+* Function Name: IpspCreditInit
+********************************************************************************
+*
+* Summary:
+*   Resets the controller. Called when the L2CAP channel is connected.
+*
+* Parameters:
+*   ctrl   - the controller of the channel.
+*   credit - the initial credits given to the peer in the connection request
+*            or response.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void IpspCreditInit(IPSP_CREDIT_T *ctrl, uint16 credit)
+{
+    (void)memset(ctrl, 0, sizeof(*ctrl));
+    ctrl->window = credit;
+    ctrl->peerCredit = credit;
+    ctrl->granted = credit;
+    ctrl->zeroStart = CySysWdtReadCount(CY_SYS_WDT_COUNTER2);
+}
+
+
+/*******************************************************************************
+* Function Name: IpspCreditZero
+********************************************************************************
+*
+* Summary:
+*   Updates the zero credit statistics when the peer credits change. The peer
+*   is considered out of credits when it cannot send an SDU of L2CAP_MAX_LEN:
+*   the SDUs are only seen here when they are complete.
+*
+* Parameters:
+*   ctrl   - the controller of the channel.
+*   credit - the new number of credits held by the peer.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+static void IpspCreditZero(IPSP_CREDIT_T *ctrl, uint16 credit)
+{
+    if((ctrl->peerCredit >= IPSP_CREDIT_SDU) && (credit < IPSP_CREDIT_SDU))
+    {
+        ctrl->stalls++;
+        ctrl->stalled = 1u;
+        ctrl->zeroStart = CySysWdtReadCount(CY_SYS_WDT_COUNTER2);
+    }
+    else if((ctrl->peerCredit < IPSP_CREDIT_SDU) && (credit >= IPSP_CREDIT_SDU))
+    {
+        ctrl->zeroTicks += CySysWdtReadCount(CY_SYS_WDT_COUNTER2) - ctrl->zeroStart;
+    }
+    else
+    {
+        /* No change of the zero credit state */
+    }
+
+    ctrl->peerCredit = credit;
+}
+
+
+/*******************************************************************************
+* Function Name: IpspCreditConsume
+********************************************************************************
+*
+* Summary:
+*   Accounts the credits used by a received SDU. Called on
+*   CYBLE_EVT_L2CAP_CBFC_DATA_READ.
+*
+* Parameters:
+*   ctrl   - the controller of the channel.
+*   length - the SDU length.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void IpspCreditConsume(IPSP_CREDIT_T *ctrl, uint16 length)
+{
+    uint16 cost = (uint16)((length + 2u + CYBLE_L2CAP_MPS - 1u) / CYBLE_L2CAP_MPS);
+
+    ctrl->consumed += cost;
+    ctrl->rate += cost;
+    IpspCreditZero(ctrl, (ctrl->peerCredit > cost) ? (uint16)(ctrl->peerCredit - cost) : 0u);
+}
+
+
+/*******************************************************************************
+* Function Name: IpspCreditSync
+********************************************************************************
+*
+* Summary:
+*   Corrects the credits held by the peer with the value reported by the
+*   stack. Called on CYBLE_EVT_L2CAP_CBFC_RX_CREDIT_IND.
+*
+* Parameters:
+*   ctrl   - the controller of the channel.
+*   credit - the credits held by the peer.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void IpspCreditSync(IPSP_CREDIT_T *ctrl, uint16 credit)
+{
+    IpspCreditZero(ctrl, credit);
+}
+
+
+/*******************************************************************************
+* Function Name: IpspCreditProcess
+********************************************************************************
+*
+* Summary:
+*   Returns the consumed credits to the peer. Must be called from the main
+*   loop. Credits are sent when the stack is free and the peer is short of
+*   the window by IPSP_CREDIT_BATCH or is out of credits.
+*
+* Parameters:
+*   ctrl       - the controller of the channel.
+*   lCid       - the local CID of the L2CAP channel.
+*   freeCredit - the credits the free receive buffers can take.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void IpspCreditProcess(IPSP_CREDIT_T *ctrl, uint16 lCid, uint16 freeCredit)
+{
+    CYBLE_API_RESULT_T apiResult;
+    uint16 target = (ctrl->window < freeCredit) ? ctrl->window : freeCredit;
+    uint16 credit;
+
+    if((target > ctrl->peerCredit) && (CyBle_GattGetBusyStatus() == CYBLE_STACK_STATE_FREE))
+    {
+        credit = target - ctrl->peerCredit;
+        if((credit >= IPSP_CREDIT_BATCH) || (ctrl->peerCredit < IPSP_CREDIT_SDU))
+        {
+            apiResult = CyBle_L2capCbfcSendFlowControlCredit(lCid, credit);
+            if(apiResult == CYBLE_ERROR_OK)
+            {
+                ctrl->granted += credit;
+                IpspCreditZero(ctrl, target);
+            }
+            else
+            {
+                DBG_PRINTF("CyBle_L2capCbfcSendFlowControlCredit API Error: %d \r\n", apiResult);
+            }
+        }
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: IpspCreditTick
+********************************************************************************
+*
+* Summary:
+*   Sizes the window from the credits consumed in the last second. Must be
+*   called every second.
+*
+* Parameters:
+*   ctrl - the controller of the channel.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void IpspCreditTick(IPSP_CREDIT_T *ctrl)
+{
+    uint32 window = ((ctrl->rate * IPSP_CREDIT_HORIZON) / 1000u) + IPSP_CREDIT_SDU;
+
+    /* The peer was limited by the credits, so the rate does not show the demand */
+    if((ctrl->stalled != 0u) && (window < (2u * (uint32)ctrl->window)))
+    {
+        window = 2u * (uint32)ctrl->window;
+    }
+
+    if(window < IPSP_CREDIT_MIN)
+    {
+        window = IPSP_CREDIT_MIN;
+    }
+    if(window > IPSP_CREDIT_MAX)
+    {
+        window = IPSP_CREDIT_MAX;
+    }
+
+    ctrl->window = (uint16)window;
+    ctrl->rate = 0u;
+    ctrl->stalled = 0u;
+}
+
+
+/*******************************************************************************
+* Function Name: IpspCreditZeroTime
+********************************************************************************
+*
+* Summary:
+*   Returns the time the peer spent out of credits, including the current
+*   period.
+*
+* Parameters:
+*   ctrl - the controller of the channel.
+*
+* Return:
+*   The time in milliseconds.
+*
+*******************************************************************************/
+uint32 IpspCreditZeroTime(const IPSP_CREDIT_T *ctrl)
+{
+    uint32 ticks = ctrl->zeroTicks;
+
+    if(ctrl->peerCredit < IPSP_CREDIT_SDU)
+    {
+        ticks += CySysWdtReadCount(CY_SYS_WDT_COUNTER2) - ctrl->zeroStart;
+    }
+
+    return(((ticks / IPSP_CREDIT_CLOCK_HZ) * 1000u) + (((ticks % IPSP_CREDIT_CLOCK_HZ) * 1000u) / IPSP_CREDIT_CLOCK_HZ));
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,288 @@
+/*******************************************************************************
+* File Name: ipspnode.c
+*
+* Version 1.0
+*
+* Description:
+*  This file contains the table of the Nodes connected to Router. Every Node
+*  has its own L2CAP channel with its own SDU queue and receive credit
+*  controller, so a Node that runs out of credits does not hold the others.
+*
+*  The SDU buffers are shared by all the Nodes. IpspNodeProcess() passes the
+*  queued SDUs to the stack in a round-robin order, one SDU per Node and
+*  turn, starting after the Node served last. A Node with a long queue thus
+*  gets no more than its share of the stack when the others have data too.
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include "main.h"
+
+
+IPSP_NODE_T ipspNode[IPSP_NODE_MAX];
+uint8 ipspNodeCount = 0u;
+
+static uint8 ipspNodeNext = 0u;     /* Node to be served first by IpspNodeProcess() */
+
+
+/*******************************************************************************
+* Function Name: IpspNodeOpen
+********************************************************************************
+*
+* Summary:
+*   Adds a Node to the table. Called when the L2CAP channel to the Node is
+*   connected.
+*
+* Parameters:
+*   bdHandle - the peer device handle.
+*   lCid     - the local CID of the L2CAP channel.
+*   credit   - the initial TX credits granted by the Node.
+*   mps      - the MPS of the Node.
+*
+* Return:
+*   The Node or NULL if the table is full.
+*
+*******************************************************************************/
+IPSP_NODE_T *IpspNodeOpen(uint8 bdHandle, uint16 lCid, uint16 credit, uint16 mps)
+{
+    CYBLE_API_RESULT_T apiResult;
+    IPSP_NODE_T *node = NULL;
+    uint8 i;
+
+    for(i = 0u; (i < IPSP_NODE_MAX) && (node == NULL); i++)
+    {
+        if(ipspNode[i].connected == 0u)
+        {
+            node = &ipspNode[i];
+        }
+    }
+
+    if(node != NULL)
+    {
+        (void)memset(node, 0, sizeof(*node));
+        node->connected = 1u;
+        node->bdHandle = bdHandle;
+        node->lCid = lCid;
+        IpspSduOpen(&node->sdu, credit, mps);
+        IpspCreditInit(&node->credit, IPSP_CREDIT_INIT);
+
+        /* The link-layer address is used to compress the IPv6 address of Node */
+        apiResult = CyBle_GapGetPeerBdAddr(bdHandle, &node->bdAddr);
+        if(apiResult != CYBLE_ERROR_OK)
+        {
+            DBG_PRINTF("CyBle_GapGetPeerBdAddr API Error: %d \r\n", apiResult);
+        }
+        LowpanLinkLocal(node->bdAddr.bdAddr, node->ipv6Address);
+        ipspNodeCount++;
+    }
+
+    return(node);
+}
+
+
+/*******************************************************************************
+* Function Name: IpspNodeClose
+********************************************************************************
+*
+* Summary:
+*   Removes a Node from the table and returns its SDU buffers to the pool.
+*
+* Parameters:
+*   node - the Node.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void IpspNodeClose(IPSP_NODE_T *node)
+{
+    if(node->connected != 0u)
+    {
+        IpspSduClose(&node->sdu);
+        node->connected = 0u;
+        ipspNodeCount--;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: IpspNodePurge
+********************************************************************************
+*
+* Summary:
+*   Removes the Nodes whose link is disconnected. The L2CAP channels are
+*   closed together with the link without CYBLE_EVT_L2CAP_CBFC_DISCONN_IND,
+*   so this is called on CYBLE_EVT_GAP_DEVICE_DISCONNECTED.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void IpspNodePurge(void)
+{
+    CYBLE_GAP_BD_ADDR_T bdAddr;
+    uint8 i;
+
+    for(i = 0u; i < IPSP_NODE_MAX; i++)
+    {
+        if((ipspNode[i].connected != 0u) &&
+           (CyBle_GapGetPeerBdAddr(ipspNode[i].bdHandle, &bdAddr) != CYBLE_ERROR_OK))
+        {
+            IpspNodeClose(&ipspNode[i]);
+        }
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: IpspNodeFind
+********************************************************************************
+*
+* Summary:
+*   Finds the Node by its L2CAP channel.
+*
+* Parameters:
+*   lCid - the local CID of the L2CAP channel.
+*
+* Return:
+*   The Node or NULL if no Node uses the channel.
+*
+*******************************************************************************/
+IPSP_NODE_T *IpspNodeFind(uint16 lCid)
+{
+    IPSP_NODE_T *node = NULL;
+    uint8 i;
+
+    for(i = 0u; (i < IPSP_NODE_MAX) && (node == NULL); i++)
+    {
+        if((ipspNode[i].connected != 0u) && (ipspNode[i].lCid == lCid))
+        {
+            node = &ipspNode[i];
+        }
+    }
+
+    return(node);
+}
+
+
+/*******************************************************************************
+* Function Name: IpspNodeFindAddress
+********************************************************************************
+*
+* Summary:
+*   Finds the Node by its IPv6 address.
+*
+* Parameters:
+*   addr - the IPv6 address.
+*
+* Return:
+*   The Node or NULL if no Node has the address.
+*
+*******************************************************************************/
+IPSP_NODE_T *IpspNodeFindAddress(const uint8 addr[])
+{
+    IPSP_NODE_T *node = NULL;
+    uint8 i;
+
+    for(i = 0u; (i < IPSP_NODE_MAX) && (node == NULL); i++)
+    {
+        if((ipspNode[i].connected != 0u) && (memcmp(ipspNode[i].ipv6Address, addr, IPV6_ADDR_SIZE) == 0))
+        {
+            node = &ipspNode[i];
+        }
+    }
+
+    return(node);
+}
+
+
+/*******************************************************************************
+* Function Name: IpspNodeProcess
+********************************************************************************
+*
+* Summary:
+*   Returns the receive credits to the Nodes and passes the queued SDUs to
+*   the stack, one SDU per Node and turn. Stops when the stack is busy or a
+*   whole turn sent nothing. Must be called from the main loop.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void IpspNodeProcess(void)
+{
+    CYBLE_API_RESULT_T apiResult;
+    IPSP_NODE_T *node;
+    uint8 queued;
+    uint8 idle = 0u;
+    uint8 i;
+
+    /* Received data is consumed in AppCallback(), so receive buffers never limit the credits */
+    for(i = 0u; i < IPSP_NODE_MAX; i++)
+    {
+        if(ipspNode[i].connected != 0u)
+        {
+            IpspCreditProcess(&ipspNode[i].credit, ipspNode[i].lCid, IPSP_CREDIT_MAX);
+        }
+    }
+
+    while((idle < IPSP_NODE_MAX) && (CyBle_GattGetBusyStatus() == CYBLE_STACK_STATE_FREE))
+    {
+        node = &ipspNode[ipspNodeNext];
+        ipspNodeNext = (uint8)((ipspNodeNext + 1u) % IPSP_NODE_MAX);
+        queued = node->sdu.queued;
+
+        if((node->connected != 0u) && (queued != 0u))
+        {
+            apiResult = IpspSduSend(&node->sdu, node->bdHandle, node->lCid, 1u);
+            if(apiResult != CYBLE_ERROR_OK)
+            {
+                DBG_PRINTF("CyBle_L2capChannelDataWrite API Error: %x, lCid=%d \r\n", apiResult, node->lCid);
+            }
+        }
+
+        idle = (node->sdu.queued != queued) ? 0u : (uint8)(idle + 1u);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: IpspNodeTick
+********************************************************************************
+*
+* Summary:
+*   Sizes the receive credit windows of the Nodes. Must be called every
+*   second.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void IpspNodeTick(void)
+{
+    uint8 i;
+
+    for(i = 0u; i < IPSP_NODE_MAX; i++)
+    {
+        if(ipspNode[i].connected != 0u)
+        {
+            IpspCreditTick(&ipspNode[i].credit);
+        }
+    }
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,75 @@
+/*******************************************************************************
+* File Name: ipspnode.h
+*
+* Version 1.0
+*
+* Description:
+*  Contains the function prototypes and constants of the IPSP Node table.
+*
+*  The PSoC 4 BLE component holds one link, so one Node is connected to
+*  Router at a time. The table, its round-robin and the shared SDU pool
+*  keep their state per Node and are tested with IPSP_NODE_MAX Nodes on
+*  the host, see host/bench/ipspnodetest.c.
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(IPSPNODE_H)
+#define IPSPNODE_H
+
+#include "main.h"
+
+
+/***************************************
+*        Constants
+***************************************/
+#define IPSP_NODE_MAX               (3u)        /* Node entries, one is in use on PSoC 4 BLE */
+
+
+/***************************************
+*        Data Struct Definition
+***************************************/
+typedef struct
+{
+    uint8  connected;                   /* The L2CAP channel is connected */
+    uint8  bdHandle;                    /* Peer device handle */
+    uint16 lCid;                        /* Local CID of the L2CAP channel */
+    CYBLE_GAP_BD_ADDR_T bdAddr;         /* Link-layer address of Node */
+    uint8  ipv6Address[IPV6_ADDR_SIZE]; /* Link-local address of Node */
+    IPSP_SDU_CHANNEL_T sdu;             /* SDUs queued for Node */
+    IPSP_CREDIT_T credit;               /* Receive credits of the channel */
+    uint16 streamTxSeq;                 /* Sequence number of the next SDU to send */
+    uint16 streamRxSeq;                 /* Sequence number of the next SDU expected back */
+    uint32 streamRxBytes;               /* Bytes validated since the last report */
+    uint32 streamErrors;
+    uint32 forwarded;                   /* IPv6 packets forwarded to Node */
+    uint32 dropped;                     /* IPv6 packets to Node dropped for no SDU buffer */
+} IPSP_NODE_T;
+
+
+/***************************************
+*      API Function Prototypes
+***************************************/
+IPSP_NODE_T *IpspNodeOpen(uint8 bdHandle, uint16 lCid, uint16 credit, uint16 mps);
+void IpspNodeClose(IPSP_NODE_T *node);
+void IpspNodePurge(void);
+IPSP_NODE_T *IpspNodeFind(uint16 lCid);
+IPSP_NODE_T *IpspNodeFindAddress(const uint8 addr[]);
+void IpspNodeProcess(void);
+void IpspNodeTick(void);
+
+
+/***************************************
+*      External data references
+***************************************/
+extern IPSP_NODE_T ipspNode[IPSP_NODE_MAX];
+extern uint8 ipspNodeCount;     /* Number of connected Nodes */
+
+
+#endif /* IPSPNODE_H */
+
+/* [] END OF FILE */
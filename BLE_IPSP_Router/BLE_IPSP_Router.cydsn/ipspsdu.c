@@ -0,0 +1,302 @@
+/*******************************************************************************
+* File Name: ipspsdu.c
+*
+* Version 1.0
+*
+* Description:
+*  This file contains the IPSP SDU pool. SDUs are built in place in one of
+*  IPSP_SDU_POOL_SIZE pre-allocated buffers and are passed to
+*  CyBle_L2capChannelDataWrite() without copying. The buffers are shared by
+*  all the L2CAP channels. Every channel keeps the buffers it holds in a ring,
+*  in the order they are sent, and may hold up to IPSP_SDU_CHANNEL_MAX of them.
+*  The stack owns a buffer until CYBLE_EVT_L2CAP_CBFC_DATA_WRITE_IND for the
+*  channel, so the buffers of a channel are released in the order they were
+*  sent.
+*
+*  Every SDU costs one credit per K-frame. SDUs are only passed to the stack
+*  while the TX credits granted by the peer cover them, so several SDUs may
+*  be in flight without the stack running out of credits.
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include "main.h"
+
+
+static uint8 ipspSduBuf[IPSP_SDU_POOL_SIZE][L2CAP_MAX_LEN];
+static uint16 ipspSduLen[IPSP_SDU_POOL_SIZE];
+static uint8 ipspSduUsed = 0u;      /* Bitmap of the buffers held by the channels */
+static uint8 ipspSduNext = 0u;      /* Buffer returned by the last IpspSduAlloc() */
+
+
+/*******************************************************************************
+* Function Name: IpspSduOpen
+********************************************************************************
+*
+* Summary:
+*   Prepares the channel for sending. Called when the L2CAP channel is
+*   connected.
+*
+* Parameters:
+*   channel - the channel.
+*   credit  - the initial TX credits granted by the peer.
+*   mps     - the MPS of the peer.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void IpspSduOpen(IPSP_SDU_CHANNEL_T *channel, uint16 credit, uint16 mps)
+{
+    IpspSduClose(channel);
+    channel->txCredit = credit;
+    channel->mps = (mps != 0u) ? mps : CYBLE_L2CAP_MPS;
+}
+
+
+/*******************************************************************************
+* Function Name: IpspSduClose
+********************************************************************************
+*
+* Summary:
+*   Returns all the buffers held by the channel to the pool. Called when the
+*   L2CAP channel is disconnected, the stack does not use the buffers anymore.
+*
+* Parameters:
+*   channel - the channel.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void IpspSduClose(IPSP_SDU_CHANNEL_T *channel)
+{
+    while((channel->inFlight + channel->queued) != 0u)
+    {
+        ipspSduUsed &= (uint8)~(1u << channel->buf[channel->first]);
+        channel->first = (uint8)((channel->first + 1u) % IPSP_SDU_CHANNEL_MAX);
+        if(channel->inFlight != 0u)
+        {
+            channel->inFlight--;
+        }
+        else
+        {
+            channel->queued--;
+        }
+    }
+    channel->first = 0u;
+    channel->txCredit = 0u;
+}
+
+
+/*******************************************************************************
+* Function Name: IpspSduAvailable
+********************************************************************************
+*
+* Summary:
+*   Returns the number of buffers the channel can still take.
+*
+* Parameters:
+*   channel - the channel.
+*
+* Return:
+*   The number of buffers.
+*
+*******************************************************************************/
+uint8 IpspSduAvailable(const IPSP_SDU_CHANNEL_T *channel)
+{
+    uint8 freeBufs = 0u;
+    uint8 i;
+
+    for(i = 0u; i < IPSP_SDU_POOL_SIZE; i++)
+    {
+        if((ipspSduUsed & (uint8)(1u << i)) == 0u)
+        {
+            freeBufs++;
+        }
+    }
+
+    if(freeBufs > (IPSP_SDU_CHANNEL_MAX - (channel->inFlight + channel->queued)))
+    {
+        freeBufs = (uint8)(IPSP_SDU_CHANNEL_MAX - (channel->inFlight + channel->queued));
+    }
+
+    return(freeBufs);
+}
+
+
+/*******************************************************************************
+* Function Name: IpspSduAlloc
+********************************************************************************
+*
+* Summary:
+*   Returns a free buffer for the channel. The SDU is built in the buffer and
+*   queued for sending by IpspSduCommit(), no other buffer may be allocated
+*   in between.
+*
+* Parameters:
+*   channel - the channel.
+*
+* Return:
+*   The buffer of L2CAP_MAX_LEN bytes or NULL if all the buffers are in use
+*   or the channel already holds IPSP_SDU_CHANNEL_MAX of them.
+*
+*******************************************************************************/
+uint8 *IpspSduAlloc(const IPSP_SDU_CHANNEL_T *channel)
+{
+    uint8 *buf = NULL;
+    uint8 i;
+
+    if((channel->inFlight + channel->queued) < IPSP_SDU_CHANNEL_MAX)
+    {
+        for(i = 0u; (i < IPSP_SDU_POOL_SIZE) && (buf == NULL); i++)
+        {
+            if((ipspSduUsed & (uint8)(1u << i)) == 0u)
+            {
+                ipspSduNext = i;
+                buf = ipspSduBuf[i];
+            }
+        }
+    }
+
+    return(buf);
+}
+
+
+/*******************************************************************************
+* Function Name: IpspSduCommit
+********************************************************************************
+*
+* Summary:
+*   Queues the buffer returned by IpspSduAlloc() for sending over the channel.
+*
+* Parameters:
+*   channel - the channel the buffer was allocated for.
+*   length  - the SDU length, up to L2CAP_MAX_LEN.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void IpspSduCommit(IPSP_SDU_CHANNEL_T *channel, uint16 length)
+{
+    ipspSduLen[ipspSduNext] = length;
+    ipspSduUsed |= (uint8)(1u << ipspSduNext);
+    channel->buf[(channel->first + channel->inFlight + channel->queued) % IPSP_SDU_CHANNEL_MAX] = ipspSduNext;
+    channel->queued++;
+}
+
+
+/*******************************************************************************
+* Function Name: IpspSduSend
+********************************************************************************
+*
+* Summary:
+*   Passes the queued SDUs of the channel to the stack while the stack is
+*   free and the TX credits cover the next SDU.
+*
+* Parameters:
+*   channel  - the channel.
+*   bdHandle - the peer device handle.
+*   lCid     - the local CID of the L2CAP channel.
+*   count    - the maximum number of SDUs to pass. The TX credits of the
+*              channel only limit the SDUs when count is not below them.
+*
+* Return:
+*   The result of the last CyBle_L2capChannelDataWrite() call or
+*   CYBLE_ERROR_OK if nothing was sent.
+*
+*******************************************************************************/
+CYBLE_API_RESULT_T IpspSduSend(IPSP_SDU_CHANNEL_T *channel, uint8 bdHandle, uint16 lCid, uint16 count)
+{
+    CYBLE_API_RESULT_T apiResult = CYBLE_ERROR_OK;
+    uint8 buf;
+    uint16 cost;
+
+    while((channel->queued != 0u) && (count != 0u) && (CyBle_GattGetBusyStatus() == CYBLE_STACK_STATE_FREE))
+    {
+        buf = channel->buf[(channel->first + channel->inFlight) % IPSP_SDU_CHANNEL_MAX];
+
+        /* One K-frame per MPS bytes, the first one also carries the SDU length */
+        cost = (uint16)((ipspSduLen[buf] + 2u + channel->mps - 1u) / channel->mps);
+        if(cost > channel->txCredit)
+        {
+            break;
+        }
+
+        apiResult = CyBle_L2capChannelDataWrite(bdHandle, lCid, ipspSduBuf[buf], ipspSduLen[buf]);
+        if(apiResult != CYBLE_ERROR_OK)
+        {
+            break;
+        }
+
+        channel->txCredit -= cost;
+        channel->queued--;
+        channel->inFlight++;
+        count--;
+    }
+
+    return(apiResult);
+}
+
+
+/*******************************************************************************
+* Function Name: IpspSduWriteComplete
+********************************************************************************
+*
+* Summary:
+*   Releases the oldest buffer of the channel owned by the stack. Called on
+*   CYBLE_EVT_L2CAP_CBFC_DATA_WRITE_IND.
+*
+* Parameters:
+*   channel - the channel.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void IpspSduWriteComplete(IPSP_SDU_CHANNEL_T *channel)
+{
+    if(channel->inFlight != 0u)
+    {
+        ipspSduUsed &= (uint8)~(1u << channel->buf[channel->first]);
+        channel->first = (uint8)((channel->first + 1u) % IPSP_SDU_CHANNEL_MAX);
+        channel->inFlight--;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: IpspSduAddCredit
+********************************************************************************
+*
+* Summary:
+*   Adds the TX credits granted by the peer. Called on
+*   CYBLE_EVT_L2CAP_CBFC_TX_CREDIT_IND.
+*
+* Parameters:
+*   channel - the channel.
+*   credit  - the number of credits granted.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void IpspSduAddCredit(IPSP_SDU_CHANNEL_T *channel, uint16 credit)
+{
+    if(((uint32)channel->txCredit + credit) > 0xFFFFu)
+    {
+        channel->txCredit = 0xFFFFu;
+    }
+    else
+    {
+        channel->txCredit += credit;
+    }
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,58 @@
+/*******************************************************************************
+* File Name: ipspsdu.h
+*
+* Version 1.0
+*
+* Description:
+*  Contains the function prototypes and constants of the IPSP SDU pool.
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(IPSPSDU_H)
+#define IPSPSDU_H
+
+#include <project.h>
+
+
+/***************************************
+*        Constants
+***************************************/
+#define IPSP_SDU_POOL_SIZE          (4u)        /* SDU buffers of L2CAP_MAX_LEN bytes, up to 8 */
+#define IPSP_SDU_CHANNEL_MAX        (2u)        /* Buffers a channel may hold */
+
+
+/***************************************
+*        Data Struct Definition
+***************************************/
+typedef struct
+{
+    uint8  buf[IPSP_SDU_CHANNEL_MAX];   /* Held buffers in the sending order */
+    uint8  first;           /* Position of the oldest held buffer in buf[] */
+    uint8  inFlight;        /* SDUs passed to the stack and not yet released */
+    uint8  queued;          /* SDUs committed but not passed to the stack */
+    uint16 txCredit;        /* Remaining TX credits of the channel */
+    uint16 mps;             /* MPS of the peer */
+} IPSP_SDU_CHANNEL_T;
+
+
+/***************************************
+*      API Function Prototypes
+***************************************/
+void IpspSduOpen(IPSP_SDU_CHANNEL_T *channel, uint16 credit, uint16 mps);
+void IpspSduClose(IPSP_SDU_CHANNEL_T *channel);
+uint8 IpspSduAvailable(const IPSP_SDU_CHANNEL_T *channel);
+uint8 *IpspSduAlloc(const IPSP_SDU_CHANNEL_T *channel);
+void IpspSduCommit(IPSP_SDU_CHANNEL_T *channel, uint16 length);
+CYBLE_API_RESULT_T IpspSduSend(IPSP_SDU_CHANNEL_T *channel, uint8 bdHandle, uint16 lCid, uint16 count);
+void IpspSduWriteComplete(IPSP_SDU_CHANNEL_T *channel);
+void IpspSduAddCredit(IPSP_SDU_CHANNEL_T *channel, uint16 credit);
+
+
+#endif /* IPSPSDU_H */
+
+/* [] END OF FILE */
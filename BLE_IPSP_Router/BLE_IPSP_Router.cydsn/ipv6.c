@@ -0,0 +1,322 @@
+/*******************************************************************************
+* File Name: ipv6.c
+*
+* Version 1.0
+*
+* Description:
+*  This file contains a minimal IPv6 host on top of the 6LoWPAN layer. It
+*  builds ICMPv6 echo requests and UDP datagrams, and answers the ICMPv6
+*  echo requests and the datagrams sent to the UDP echo port. Extension
+*  headers and fragmentation are not supported.
+*
+*  The module only depends on cytypes.h, so it is also built on the host.
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <string.h>
+#include "ipv6.h"
+
+
+/* ff02::1, all nodes on the link */
+static const uint8 ipv6AllNodes[IPV6_ADDR_SIZE] =
+{
+    0xFFu, 0x02u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u,
+    0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x01u
+};
+
+
+/*******************************************************************************
+* Function Name: Ipv6Sum
+********************************************************************************
+*
+* Summary:
+*   Adds the bytes to the Internet checksum as 16-bit big-endian words.
+*
+* Parameters:
+*   sum    - the sum so far.
+*   data   - the bytes to add.
+*   length - the number of bytes. An odd byte is padded with zero.
+*
+* Return:
+*   The new sum, not folded.
+*
+*******************************************************************************/
+static uint32 Ipv6Sum(uint32 sum, const uint8 data[], uint16 length)
+{
+    uint16 i;
+
+    for(i = 0u; (i + 1u) < length; i += 2u)
+    {
+        sum += IPV6_GET16(&data[i]);
+    }
+    if((length & 0x01u) != 0u)
+    {
+        sum += (uint32)data[length - 1u] << 8u;
+    }
+
+    return(sum);
+}
+
+
+/*******************************************************************************
+* Function Name: Ipv6Checksum
+********************************************************************************
+*
+* Summary:
+*   Calculates the checksum of the upper-layer packet including the IPv6
+*   pseudo-header. Returns 0 for a packet with a valid checksum.
+*
+* Parameters:
+*   pkt    - the IPv6 packet.
+*   length - the packet length.
+*
+* Return:
+*   The checksum to store in the upper-layer header, which must be zero
+*   during the calculation.
+*
+*******************************************************************************/
+uint16 Ipv6Checksum(const uint8 pkt[], uint16 length)
+{
+    uint16 upperLength = length - IPV6_HDR_LEN;
+    uint32 sum;
+
+    sum = Ipv6Sum(0u, &pkt[IPV6_SRC_OFFSET], 2u * IPV6_ADDR_SIZE);
+    sum += (uint32)upperLength + pkt[IPV6_NH_OFFSET];
+    sum = Ipv6Sum(sum, &pkt[IPV6_HDR_LEN], upperLength);
+
+    while((sum >> 16u) != 0u)
+    {
+        sum = (sum & 0xFFFFu) + (sum >> 16u);
+    }
+
+    return((uint16)~sum);
+}
+
+
+/*******************************************************************************
+* Function Name: Ipv6Header
+********************************************************************************
+*
+* Summary:
+*   Builds the IPv6 header.
+*
+* Parameters:
+*   pkt           - the IPv6 packet.
+*   src           - the source address.
+*   dst           - the destination address.
+*   nextHeader    - the upper-layer protocol.
+*   payloadLength - the upper-layer packet length.
+*
+* Return:
+*   The packet length.
+*
+*******************************************************************************/
+uint16 Ipv6Header(uint8 pkt[], const uint8 src[], const uint8 dst[], uint8 nextHeader, uint16 payloadLength)
+{
+    (void)memset(pkt, 0, IPV6_PLEN_OFFSET);
+    pkt[IPV6_VTF_OFFSET] = IPV6_VERSION;
+    IPV6_SET16(&pkt[IPV6_PLEN_OFFSET], payloadLength);
+    pkt[IPV6_NH_OFFSET] = nextHeader;
+    pkt[IPV6_HLIM_OFFSET] = IPV6_HOP_LIMIT;
+    (void)memcpy(&pkt[IPV6_SRC_OFFSET], src, IPV6_ADDR_SIZE);
+    (void)memcpy(&pkt[IPV6_DST_OFFSET], dst, IPV6_ADDR_SIZE);
+
+    return(IPV6_HDR_LEN + payloadLength);
+}
+
+
+/*******************************************************************************
+* Function Name: Ipv6EchoRequest
+********************************************************************************
+*
+* Summary:
+*   Builds an ICMPv6 echo request with data generated from the sequence
+*   number.
+*
+* Parameters:
+*   pkt        - the buffer of IPV6_MTU bytes.
+*   src        - the source address.
+*   dst        - the destination address.
+*   id         - the echo identifier.
+*   seq        - the echo sequence number.
+*   dataLength - the echo data length, limited to fit IPV6_MTU.
+*
+* Return:
+*   The packet length.
+*
+*******************************************************************************/
+uint16 Ipv6EchoRequest(uint8 pkt[], const uint8 src[], const uint8 dst[], uint16 id, uint16 seq, uint16 dataLength)
+{
+    uint8 *icmp = &pkt[IPV6_HDR_LEN];
+    uint16 length;
+    uint16 i;
+
+    if(dataLength > (IPV6_MTU - IPV6_HDR_LEN - ICMPV6_HDR_LEN))
+    {
+        dataLength = IPV6_MTU - IPV6_HDR_LEN - ICMPV6_HDR_LEN;
+    }
+
+    length = Ipv6Header(pkt, src, dst, IPV6_NH_ICMPV6, ICMPV6_HDR_LEN + dataLength);
+    icmp[ICMPV6_TYPE_OFFSET] = ICMPV6_ECHO_REQUEST;
+    icmp[ICMPV6_TYPE_OFFSET + 1u] = 0u;
+    IPV6_SET16(&icmp[ICMPV6_CHECKSUM_OFFSET], 0u);
+    IPV6_SET16(&icmp[ICMPV6_ID_OFFSET], id);
+    IPV6_SET16(&icmp[ICMPV6_SEQ_OFFSET], seq);
+    for(i = 0u; i < dataLength; i++)
+    {
+        icmp[ICMPV6_HDR_LEN + i] = (uint8)(seq + i);
+    }
+    IPV6_SET16(&icmp[ICMPV6_CHECKSUM_OFFSET], Ipv6Checksum(pkt, length));
+
+    return(length);
+}
+
+
+/*******************************************************************************
+* Function Name: Ipv6UdpChecksum
+********************************************************************************
+*
+* Summary:
+*   Stores the UDP checksum. A zero checksum is sent as 0xFFFF.
+*
+* Parameters:
+*   pkt    - the IPv6 packet.
+*   length - the packet length.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+static void Ipv6UdpChecksum(uint8 pkt[], uint16 length)
+{
+    uint16 checksum;
+
+    IPV6_SET16(&pkt[IPV6_HDR_LEN + UDP_CHECKSUM_OFFSET], 0u);
+    checksum = Ipv6Checksum(pkt, length);
+    if(checksum == 0u)
+    {
+        checksum = 0xFFFFu;
+    }
+    IPV6_SET16(&pkt[IPV6_HDR_LEN + UDP_CHECKSUM_OFFSET], checksum);
+}
+
+
+/*******************************************************************************
+* Function Name: Ipv6Udp
+********************************************************************************
+*
+* Summary:
+*   Builds a UDP datagram.
+*
+* Parameters:
+*   pkt        - the buffer of IPV6_MTU bytes.
+*   src        - the source address.
+*   dst        - the destination address.
+*   srcPort    - the source port.
+*   dstPort    - the destination port.
+*   data       - the datagram data.
+*   dataLength - the data length, limited to fit IPV6_MTU.
+*
+* Return:
+*   The packet length.
+*
+*******************************************************************************/
+uint16 Ipv6Udp(uint8 pkt[], const uint8 src[], const uint8 dst[], uint16 srcPort, uint16 dstPort,
+               const uint8 data[], uint16 dataLength)
+{
+    uint8 *udp = &pkt[IPV6_HDR_LEN];
+    uint16 length;
+
+    if(dataLength > (IPV6_MTU - IPV6_HDR_LEN - UDP_HDR_LEN))
+    {
+        dataLength = IPV6_MTU - IPV6_HDR_LEN - UDP_HDR_LEN;
+    }
+
+    length = Ipv6Header(pkt, src, dst, IPV6_NH_UDP, UDP_HDR_LEN + dataLength);
+    IPV6_SET16(&udp[UDP_SRC_PORT_OFFSET], srcPort);
+    IPV6_SET16(&udp[UDP_DST_PORT_OFFSET], dstPort);
+    IPV6_SET16(&udp[UDP_LEN_OFFSET], UDP_HDR_LEN + dataLength);
+    (void)memcpy(&udp[UDP_HDR_LEN], data, dataLength);
+    Ipv6UdpChecksum(pkt, length);
+
+    return(length);
+}
+
+
+/*******************************************************************************
+* Function Name: Ipv6Process
+********************************************************************************
+*
+* Summary:
+*   Processes a received IPv6 packet. An ICMPv6 echo request and a datagram
+*   sent to the UDP echo port are turned into the reply in place.
+*
+* Parameters:
+*   pkt    - the IPv6 packet.
+*   length - the packet length.
+*   self   - the address of this device.
+*
+* Return:
+*   The reply length or 0 if there is nothing to reply.
+*
+*******************************************************************************/
+uint16 Ipv6Process(uint8 pkt[], uint16 length, const uint8 self[])
+{
+    uint8 *upper = &pkt[IPV6_HDR_LEN];
+    uint16 port;
+    uint16 reply = 0u;
+
+    if((length >= IPV6_HDR_LEN) && ((pkt[IPV6_VTF_OFFSET] & 0xF0u) == IPV6_VERSION) &&
+       ((IPV6_GET16(&pkt[IPV6_PLEN_OFFSET]) + IPV6_HDR_LEN) == length) &&
+       ((memcmp(&pkt[IPV6_DST_OFFSET], self, IPV6_ADDR_SIZE) == 0) ||
+        (memcmp(&pkt[IPV6_DST_OFFSET], ipv6AllNodes, IPV6_ADDR_SIZE) == 0)))
+    {
+        if((pkt[IPV6_NH_OFFSET] == IPV6_NH_ICMPV6) && (length >= (IPV6_HDR_LEN + ICMPV6_HDR_LEN)) &&
+           (upper[ICMPV6_TYPE_OFFSET] == ICMPV6_ECHO_REQUEST) && (Ipv6Checksum(pkt, length) == 0u))
+        {
+            upper[ICMPV6_TYPE_OFFSET] = ICMPV6_ECHO_REPLY;
+            reply = length;
+        }
+        else if((pkt[IPV6_NH_OFFSET] == IPV6_NH_UDP) && (length >= (IPV6_HDR_LEN + UDP_HDR_LEN)) &&
+                (IPV6_GET16(&upper[UDP_DST_PORT_OFFSET]) == UDP_PORT_ECHO) &&
+                (IPV6_GET16(&upper[UDP_CHECKSUM_OFFSET]) != 0u) && (Ipv6Checksum(pkt, length) == 0u))
+        {
+            port = IPV6_GET16(&upper[UDP_SRC_PORT_OFFSET]);
+            IPV6_SET16(&upper[UDP_DST_PORT_OFFSET], port);
+            IPV6_SET16(&upper[UDP_SRC_PORT_OFFSET], UDP_PORT_ECHO);
+            reply = length;
+        }
+        else
+        {
+            /* Not an echo request */
+        }
+    }
+
+    if(reply != 0u)
+    {
+        /* Reply from the own address even to a multicast request */
+        (void)memcpy(&pkt[IPV6_DST_OFFSET], &pkt[IPV6_SRC_OFFSET], IPV6_ADDR_SIZE);
+        (void)memcpy(&pkt[IPV6_SRC_OFFSET], self, IPV6_ADDR_SIZE);
+        pkt[IPV6_HLIM_OFFSET] = IPV6_HOP_LIMIT;
+
+        if(pkt[IPV6_NH_OFFSET] == IPV6_NH_ICMPV6)
+        {
+            IPV6_SET16(&upper[ICMPV6_CHECKSUM_OFFSET], 0u);
+            IPV6_SET16(&upper[ICMPV6_CHECKSUM_OFFSET], Ipv6Checksum(pkt, reply));
+        }
+        else
+        {
+            Ipv6UdpChecksum(pkt, reply);
+        }
+    }
+
+    return(reply);
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,81 @@
+/*******************************************************************************
+* File Name: ipv6.h
+*
+* Version 1.0
+*
+* Description:
+*  Contains the function prototypes and constants of the minimal IPv6 host:
+*  ICMPv6 and UDP echo.
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(IPV6_H)
+#define IPV6_H
+
+#include "cytypes.h"
+
+
+/***************************************
+*        Constants
+***************************************/
+#define IPV6_MTU                    (1280u)
+#define IPV6_ADDR_SIZE              (16u)
+#define IPV6_HDR_LEN                (40u)
+#define IPV6_VERSION                (0x60u)
+#define IPV6_HOP_LIMIT              (64u)
+
+/* IPv6 header field offsets */
+#define IPV6_VTF_OFFSET             (0u)
+#define IPV6_PLEN_OFFSET            (4u)
+#define IPV6_NH_OFFSET              (6u)
+#define IPV6_HLIM_OFFSET            (7u)
+#define IPV6_SRC_OFFSET             (8u)
+#define IPV6_DST_OFFSET             (24u)
+
+#define IPV6_NH_UDP                 (17u)
+#define IPV6_NH_ICMPV6              (58u)
+
+/* UDP header */
+#define UDP_HDR_LEN                 (8u)
+#define UDP_SRC_PORT_OFFSET         (0u)
+#define UDP_DST_PORT_OFFSET         (2u)
+#define UDP_LEN_OFFSET              (4u)
+#define UDP_CHECKSUM_OFFSET         (6u)
+#define UDP_PORT_ECHO               (7u)
+
+/* ICMPv6 echo header */
+#define ICMPV6_HDR_LEN              (8u)
+#define ICMPV6_TYPE_OFFSET          (0u)
+#define ICMPV6_CHECKSUM_OFFSET      (2u)
+#define ICMPV6_ID_OFFSET            (4u)
+#define ICMPV6_SEQ_OFFSET           (6u)
+#define ICMPV6_ECHO_REQUEST         (128u)
+#define ICMPV6_ECHO_REPLY           (129u)
+
+
+/***************************************
+*        Macros
+***************************************/
+#define IPV6_GET16(ptr)             ((uint16)(((uint16)(ptr)[0u] << 8u) | (ptr)[1u]))
+#define IPV6_SET16(ptr, value)      do { (ptr)[0u] = HI8(value); (ptr)[1u] = LO8(value); } while(0)
+
+
+/***************************************
+*      API Function Prototypes
+***************************************/
+uint16 Ipv6Checksum(const uint8 pkt[], uint16 length);
+uint16 Ipv6Header(uint8 pkt[], const uint8 src[], const uint8 dst[], uint8 nextHeader, uint16 payloadLength);
+uint16 Ipv6EchoRequest(uint8 pkt[], const uint8 src[], const uint8 dst[], uint16 id, uint16 seq, uint16 dataLength);
+uint16 Ipv6Udp(uint8 pkt[], const uint8 src[], const uint8 dst[], uint16 srcPort, uint16 dstPort,
+               const uint8 data[], uint16 dataLength);
+uint16 Ipv6Process(uint8 pkt[], uint16 length, const uint8 self[]);
+
+
+#endif /* IPV6_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,616 @@
+/*******************************************************************************
+* File Name: lowpan.c
+*
+* Version 1.0
+*
+* Description:
+*  This file contains the 6LoWPAN IPHC header compression for IPv6 over
+*  BLE (RFC 6282, RFC 7668). Only the stateless modes are used: no contexts,
+*  link-local unicast and multicast addresses are compressed. The Traffic
+*  Class, Flow Label, Next Header and Hop Limit are compressed when possible.
+*  UDP headers are compressed with the NHC, the checksum is always inline.
+*
+*  A link-local address whose IID is derived from the Bluetooth device address
+*  is elided completely, so the IPv6 and UDP headers of the link-local traffic
+*  between the Router and the Node take 6 to 8 bytes instead of 48.
+*
+*  The module only depends on cytypes.h, so it is also built on the host.
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <string.h>
+#include "lowpan.h"
+#include "ipv6.h"
+
+
+/*******************************************************************************
+* Function Name: LowpanIid
+********************************************************************************
+*
+* Summary:
+*   Forms the interface identifier from the Bluetooth device address by
+*   inserting 0xFFFE in the middle. The Universal/Local bit is set to 0 as
+*   required by RFC 7668.
+*
+* Parameters:
+*   bdAddr - the Bluetooth device address, LSB first.
+*   iid    - the LOWPAN_IID_SIZE bytes of the interface identifier.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+static void LowpanIid(const uint8 bdAddr[], uint8 iid[])
+{
+    iid[0u] = bdAddr[5u] & (uint8)~0x02u;
+    iid[1u] = bdAddr[4u];
+    iid[2u] = bdAddr[3u];
+    iid[3u] = 0xFFu;
+    iid[4u] = 0xFEu;
+    iid[5u] = bdAddr[2u];
+    iid[6u] = bdAddr[1u];
+    iid[7u] = bdAddr[0u];
+}
+
+
+/*******************************************************************************
+* Function Name: LowpanLinkLocal
+********************************************************************************
+*
+* Summary:
+*   Forms the link-local address of a device from its Bluetooth device
+*   address.
+*
+* Parameters:
+*   bdAddr - the Bluetooth device address, LSB first.
+*   addr   - the LOWPAN_IPV6_ADDR_SIZE bytes of the IPv6 address.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void LowpanLinkLocal(const uint8 bdAddr[], uint8 addr[])
+{
+    (void)memset(addr, 0, LOWPAN_IPV6_ADDR_SIZE);
+    addr[0u] = 0xFEu;
+    addr[1u] = 0x80u;
+    LowpanIid(bdAddr, &addr[LOWPAN_IPV6_ADDR_SIZE - LOWPAN_IID_SIZE]);
+}
+
+
+/*******************************************************************************
+* Function Name: LowpanIsZero
+********************************************************************************
+*
+* Summary:
+*   Checks that all the bytes are zero.
+*
+* Parameters:
+*   data   - the bytes to check.
+*   length - the number of bytes.
+*
+* Return:
+*   Non-zero if all the bytes are zero.
+*
+*******************************************************************************/
+static uint8 LowpanIsZero(const uint8 data[], uint16 length)
+{
+    uint8 acc = 0u;
+    uint16 i;
+
+    for(i = 0u; i < length; i++)
+    {
+        acc |= data[i];
+    }
+
+    return((acc == 0u) ? 1u : 0u);
+}
+
+
+/*******************************************************************************
+* Function Name: LowpanCompressAddr
+********************************************************************************
+*
+* Summary:
+*   Writes the inline part of an address and returns its address mode.
+*
+* Parameters:
+*   addr   - the IPv6 address.
+*   bdAddr - the link-layer address of the device that owns the address.
+*   frame  - the destination of the inline part.
+*   pos    - the position in the frame, advanced by the inline part.
+*
+* Return:
+*   The SAM/DAM value, with LOWPAN_IPHC_M set for a multicast address.
+*
+*******************************************************************************/
+static uint8 LowpanCompressAddr(const uint8 addr[], const uint8 bdAddr[], uint8 frame[], uint16 *pos)
+{
+    uint8 iid[LOWPAN_IID_SIZE];
+    uint8 mode;
+
+    if(addr[0u] == 0xFFu)
+    {
+        if((addr[1u] == 0x02u) && (LowpanIsZero(&addr[2u], 13u) != 0u))
+        {
+            /* ff02::00XX */
+            frame[(*pos)++] = addr[15u];
+            mode = LOWPAN_AM_0;
+        }
+        else if(LowpanIsZero(&addr[2u], 11u) != 0u)
+        {
+            /* ffXX::00XX:XXXX */
+            frame[(*pos)++] = addr[1u];
+            (void)memcpy(&frame[*pos], &addr[13u], 3u);
+            *pos += 3u;
+            mode = LOWPAN_AM_16;
+        }
+        else if(LowpanIsZero(&addr[2u], 9u) != 0u)
+        {
+            /* ffXX::00XX:XXXX:XXXX */
+            frame[(*pos)++] = addr[1u];
+            (void)memcpy(&frame[*pos], &addr[11u], 5u);
+            *pos += 5u;
+            mode = LOWPAN_AM_64;
+        }
+        else
+        {
+            (void)memcpy(&frame[*pos], addr, LOWPAN_IPV6_ADDR_SIZE);
+            *pos += LOWPAN_IPV6_ADDR_SIZE;
+            mode = LOWPAN_AM_128;
+        }
+        mode |= LOWPAN_IPHC_M;
+    }
+    else if((addr[0u] == 0xFEu) && (addr[1u] == 0x80u) && (LowpanIsZero(&addr[2u], 6u) != 0u))
+    {
+        LowpanIid(bdAddr, iid);
+        if(memcmp(&addr[8u], iid, LOWPAN_IID_SIZE) == 0)
+        {
+            mode = LOWPAN_AM_0;
+        }
+        else if((LowpanIsZero(&addr[8u], 3u) != 0u) && (addr[11u] == 0xFFu) && 
+                (addr[12u] == 0xFEu) && (addr[13u] == 0x00u))
+        {
+            /* fe80::0000:00ff:fe00:XXXX */
+            (void)memcpy(&frame[*pos], &addr[14u], 2u);
+            *pos += 2u;
+            mode = LOWPAN_AM_16;
+        }
+        else
+        {
+            (void)memcpy(&frame[*pos], &addr[8u], LOWPAN_IID_SIZE);
+            *pos += LOWPAN_IID_SIZE;
+            mode = LOWPAN_AM_64;
+        }
+    }
+    else
+    {
+        (void)memcpy(&frame[*pos], addr, LOWPAN_IPV6_ADDR_SIZE);
+        *pos += LOWPAN_IPV6_ADDR_SIZE;
+        mode = LOWPAN_AM_128;
+    }
+
+    return(mode);
+}
+
+
+/*******************************************************************************
+* Function Name: LowpanCompress
+********************************************************************************
+*
+* Summary:
+*   Compresses an IPv6 packet to a LoWPAN frame with the IPHC dispatch.
+*
+* Parameters:
+*   ipv6      - the IPv6 packet.
+*   length    - the packet length.
+*   srcBdAddr - the link-layer address of the sender.
+*   dstBdAddr - the link-layer address of the receiver.
+*   frame     - the destination of the frame.
+*   size      - the size of the frame buffer.
+*
+* Return:
+*   The frame length or 0 if the packet is invalid or does not fit.
+*
+*******************************************************************************/
+uint16 LowpanCompress(const uint8 ipv6[], uint16 length, const uint8 srcBdAddr[], const uint8 dstBdAddr[],
+                      uint8 frame[], uint16 size)
+{
+    uint16 pos = 2u;
+    uint16 hdrLen = IPV6_HDR_LEN;
+    uint8 iphc0 = LOWPAN_DISPATCH_IPHC;
+    uint8 iphc1;
+    uint8 tc;
+    uint32 fl;
+    uint8 nhc = 0u;
+    uint16 srcPort;
+    uint16 dstPort;
+    uint16 result = 0u;
+
+    if((length >= IPV6_HDR_LEN) && (size >= LOWPAN_IPHC_HDR_MAX) &&
+       ((ipv6[IPV6_VTF_OFFSET] & 0xF0u) == IPV6_VERSION) &&
+       ((IPV6_GET16(&ipv6[IPV6_PLEN_OFFSET]) + IPV6_HDR_LEN) == length))
+    {
+        /* Traffic Class is DSCP:ECN in IPv6 and ECN:DSCP in IPHC */
+        tc = (uint8)((uint8)(ipv6[0u] << 4u) | (ipv6[1u] >> 4u));
+        tc = (uint8)((uint8)(tc << 6u) | (tc >> 2u));
+        fl = ((uint32)(ipv6[1u] & 0x0Fu) << 16u) | ((uint32)ipv6[2u] << 8u) | ipv6[3u];
+
+        if((fl == 0u) && (tc == 0u))
+        {
+            iphc0 |= (uint8)(LOWPAN_TF_ELIDED << LOWPAN_IPHC_TF_SHIFT);
+        }
+        else if(fl == 0u)
+        {
+            iphc0 |= (uint8)(LOWPAN_TF_NO_FL << LOWPAN_IPHC_TF_SHIFT);
+            frame[pos++] = tc;
+        }
+        else if((tc & 0x3Fu) == 0u)
+        {
+            iphc0 |= (uint8)(LOWPAN_TF_NO_DSCP << LOWPAN_IPHC_TF_SHIFT);
+            frame[pos++] = (uint8)(tc | (uint8)(fl >> 16u));
+            frame[pos++] = (uint8)(fl >> 8u);
+            frame[pos++] = (uint8)fl;
+        }
+        else
+        {
+            frame[pos++] = tc;
+            frame[pos++] = (uint8)(fl >> 16u);
+            frame[pos++] = (uint8)(fl >> 8u);
+            frame[pos++] = (uint8)fl;
+        }
+
+        if((ipv6[IPV6_NH_OFFSET] == IPV6_NH_UDP) && (length >= (IPV6_HDR_LEN + UDP_HDR_LEN)))
+        {
+            iphc0 |= LOWPAN_IPHC_NH;
+            nhc = 1u;
+        }
+        else
+        {
+            frame[pos++] = ipv6[IPV6_NH_OFFSET];
+        }
+
+        switch(ipv6[IPV6_HLIM_OFFSET])
+        {
+            case 1u:
+                iphc0 |= 0x01u;
+                break;
+            case 64u:
+                iphc0 |= 0x02u;
+                break;
+            case 255u:
+                iphc0 |= 0x03u;
+                break;
+            default:
+                frame[pos++] = ipv6[IPV6_HLIM_OFFSET];
+                break;
+        }
+
+        /* A multicast source is not valid, so the M flag is not used for it */
+        iphc1 = (uint8)((LowpanCompressAddr(&ipv6[IPV6_SRC_OFFSET], srcBdAddr, frame, &pos) & 
+                         LOWPAN_IPHC_AM_MASK) << LOWPAN_IPHC_SAM_SHIFT);
+        iphc1 |= LowpanCompressAddr(&ipv6[IPV6_DST_OFFSET], dstBdAddr, frame, &pos);
+
+        if(nhc != 0u)
+        {
+            srcPort = IPV6_GET16(&ipv6[IPV6_HDR_LEN + UDP_SRC_PORT_OFFSET]);
+            dstPort = IPV6_GET16(&ipv6[IPV6_HDR_LEN + UDP_DST_PORT_OFFSET]);
+
+            if(((srcPort & 0xFFF0u) == LOWPAN_NHC_PORT_4) && ((dstPort & 0xFFF0u) == LOWPAN_NHC_PORT_4))
+            {
+                frame[pos++] = LOWPAN_NHC_UDP | 0x03u;
+                frame[pos++] = (uint8)((uint8)(srcPort << 4u) | (dstPort & 0x0Fu));
+            }
+            else if((dstPort & 0xFF00u) == LOWPAN_NHC_PORT_8)
+            {
+                frame[pos++] = LOWPAN_NHC_UDP | 0x01u;
+                IPV6_SET16(&frame[pos], srcPort);
+                frame[pos + 2u] = LO8(dstPort);
+                pos += 3u;
+            }
+            else if((srcPort & 0xFF00u) == LOWPAN_NHC_PORT_8)
+            {
+                frame[pos++] = LOWPAN_NHC_UDP | 0x02u;
+                frame[pos] = LO8(srcPort);
+                IPV6_SET16(&frame[pos + 1u], dstPort);
+                pos += 3u;
+            }
+            else
+            {
+                frame[pos++] = LOWPAN_NHC_UDP;
+                (void)memcpy(&frame[pos], &ipv6[IPV6_HDR_LEN], 4u);
+                pos += 4u;
+            }
+
+            /* The UDP length is elided, it follows from the frame length */
+            frame[pos++] = ipv6[IPV6_HDR_LEN + UDP_CHECKSUM_OFFSET];
+            frame[pos++] = ipv6[IPV6_HDR_LEN + UDP_CHECKSUM_OFFSET + 1u];
+            hdrLen += UDP_HDR_LEN;
+        }
+
+        if(((uint32)pos + length - hdrLen) <= size)
+        {
+            frame[0u] = iphc0;
+            frame[1u] = iphc1;
+            (void)memcpy(&frame[pos], &ipv6[hdrLen], length - hdrLen);
+            result = pos + length - hdrLen;
+        }
+    }
+
+    return(result);
+}
+
+
+/*******************************************************************************
+* Function Name: LowpanInline
+********************************************************************************
+*
+* Summary:
+*   Copies the inline part of a field from the frame.
+*
+* Parameters:
+*   frame  - the frame.
+*   length - the frame length.
+*   pos    - the position in the frame, advanced by the inline part.
+*   data   - the destination of the inline part.
+*   count  - the number of bytes to copy.
+*
+* Return:
+*   Non-zero if the frame holds the inline part.
+*
+*******************************************************************************/
+static uint8 LowpanInline(const uint8 frame[], uint16 length, uint16 *pos, uint8 data[], uint16 count)
+{
+    uint8 valid = 0u;
+
+    if(((uint32)*pos + count) <= length)
+    {
+        (void)memcpy(data, &frame[*pos], count);
+        *pos += count;
+        valid = 1u;
+    }
+
+    return(valid);
+}
+
+
+/*******************************************************************************
+* Function Name: LowpanDecompressAddr
+********************************************************************************
+*
+* Summary:
+*   Restores an address from its address mode and the inline part.
+*
+* Parameters:
+*   mode   - the SAM/DAM value, with LOWPAN_IPHC_M set for a multicast address.
+*   bdAddr - the link-layer address of the device that owns the address.
+*   frame  - the frame.
+*   length - the frame length.
+*   pos    - the position in the frame, advanced by the inline part.
+*   addr   - the restored IPv6 address.
+*
+* Return:
+*   Non-zero if the frame holds the inline part.
+*
+*******************************************************************************/
+static uint8 LowpanDecompressAddr(uint8 mode, const uint8 bdAddr[], const uint8 frame[], uint16 length,
+                                  uint16 *pos, uint8 addr[])
+{
+    uint8 valid;
+
+    (void)memset(addr, 0, LOWPAN_IPV6_ADDR_SIZE);
+
+    switch(mode)
+    {
+        case LOWPAN_AM_128:
+        case (LOWPAN_IPHC_M | LOWPAN_AM_128):
+            valid = LowpanInline(frame, length, pos, addr, LOWPAN_IPV6_ADDR_SIZE);
+            break;
+        case LOWPAN_AM_64:
+            addr[0u] = 0xFEu;
+            addr[1u] = 0x80u;
+            valid = LowpanInline(frame, length, pos, &addr[8u], LOWPAN_IID_SIZE);
+            break;
+        case LOWPAN_AM_16:
+            addr[0u] = 0xFEu;
+            addr[1u] = 0x80u;
+            addr[11u] = 0xFFu;
+            addr[12u] = 0xFEu;
+            valid = LowpanInline(frame, length, pos, &addr[14u], 2u);
+            break;
+        case LOWPAN_AM_0:
+            LowpanLinkLocal(bdAddr, addr);
+            valid = 1u;
+            break;
+        case (LOWPAN_IPHC_M | LOWPAN_AM_64):
+            addr[0u] = 0xFFu;
+            valid = LowpanInline(frame, length, pos, &addr[1u], 1u);
+            valid &= LowpanInline(frame, length, pos, &addr[11u], 5u);
+            break;
+        case (LOWPAN_IPHC_M | LOWPAN_AM_16):
+            addr[0u] = 0xFFu;
+            valid = LowpanInline(frame, length, pos, &addr[1u], 1u);
+            valid &= LowpanInline(frame, length, pos, &addr[13u], 3u);
+            break;
+        default:    /* LOWPAN_IPHC_M | LOWPAN_AM_0 */
+            addr[0u] = 0xFFu;
+            addr[1u] = 0x02u;
+            valid = LowpanInline(frame, length, pos, &addr[15u], 1u);
+            break;
+    }
+
+    return(valid);
+}
+
+
+/*******************************************************************************
+* Function Name: LowpanDecompress
+********************************************************************************
+*
+* Summary:
+*   Restores an IPv6 packet from a LoWPAN frame with the IPHC or the IPv6
+*   dispatch. Context based compression is not supported.
+*
+* Parameters:
+*   frame     - the frame.
+*   length    - the frame length.
+*   srcBdAddr - the link-layer address of the sender.
+*   dstBdAddr - the link-layer address of the receiver.
+*   ipv6      - the destination of the IPv6 packet.
+*   size      - the size of the packet buffer.
+*
+* Return:
+*   The packet length or 0 if the frame is invalid or does not fit.
+*
+*******************************************************************************/
+uint16 LowpanDecompress(const uint8 frame[], uint16 length, const uint8 srcBdAddr[], const uint8 dstBdAddr[],
+                        uint8 ipv6[], uint16 size)
+{
+    uint16 pos = 2u;
+    uint16 hdrLen = IPV6_HDR_LEN;
+    uint16 result = 0u;
+    uint8 valid = 1u;
+    uint8 iphc0;
+    uint8 iphc1;
+    uint8 tf[4u] = {0u, 0u, 0u, 0u};
+    uint8 tc = 0u;
+    uint32 fl = 0u;
+    uint8 nhc = 0u;
+    uint8 port[4u];
+
+    if((length > 1u) && (frame[0u] == LOWPAN_DISPATCH_IPV6))
+    {
+        if(((uint32)length - 1u) <= size)
+        {
+            (void)memcpy(ipv6, &frame[1u], length - 1u);
+            result = length - 1u;
+        }
+    }
+    else if((length >= 2u) && (size >= (IPV6_HDR_LEN + UDP_HDR_LEN)) &&
+            ((frame[0u] & LOWPAN_DISPATCH_IPHC_MASK) == LOWPAN_DISPATCH_IPHC) &&
+            ((frame[1u] & (LOWPAN_IPHC_CID | LOWPAN_IPHC_SAC | LOWPAN_IPHC_DAC)) == 0u))
+    {
+        iphc0 = frame[0u];
+        iphc1 = frame[1u];
+
+        switch((iphc0 & LOWPAN_IPHC_TF_MASK) >> LOWPAN_IPHC_TF_SHIFT)
+        {
+            case LOWPAN_TF_INLINE:
+                valid = LowpanInline(frame, length, &pos, tf, 4u);
+                tc = tf[0u];
+                fl = ((uint32)(tf[1u] & 0x0Fu) << 16u) | ((uint32)tf[2u] << 8u) | tf[3u];
+                break;
+            case LOWPAN_TF_NO_DSCP:
+                valid = LowpanInline(frame, length, &pos, tf, 3u);
+                tc = tf[0u] & 0xC0u;
+                fl = ((uint32)(tf[0u] & 0x0Fu) << 16u) | ((uint32)tf[1u] << 8u) | tf[2u];
+                break;
+            case LOWPAN_TF_NO_FL:
+                valid = LowpanInline(frame, length, &pos, tf, 1u);
+                tc = tf[0u];
+                break;
+            default:
+                break;
+        }
+
+        /* ECN:DSCP back to DSCP:ECN */
+        tc = (uint8)((uint8)(tc << 2u) | (tc >> 6u));
+        ipv6[0u] = (uint8)(IPV6_VERSION | (tc >> 4u));
+        ipv6[1u] = (uint8)((uint8)(tc << 4u) | (uint8)(fl >> 16u));
+        ipv6[2u] = (uint8)(fl >> 8u);
+        ipv6[3u] = (uint8)fl;
+
+        if((iphc0 & LOWPAN_IPHC_NH) != 0u)
+        {
+            ipv6[IPV6_NH_OFFSET] = IPV6_NH_UDP;
+            nhc = 1u;
+        }
+        else
+        {
+            valid &= LowpanInline(frame, length, &pos, &ipv6[IPV6_NH_OFFSET], 1u);
+        }
+
+        switch(iphc0 & LOWPAN_IPHC_HLIM_MASK)
+        {
+            case 0x01u:
+                ipv6[IPV6_HLIM_OFFSET] = 1u;
+                break;
+            case 0x02u:
+                ipv6[IPV6_HLIM_OFFSET] = 64u;
+                break;
+            case 0x03u:
+                ipv6[IPV6_HLIM_OFFSET] = 255u;
+                break;
+            default:
+                valid &= LowpanInline(frame, length, &pos, &ipv6[IPV6_HLIM_OFFSET], 1u);
+                break;
+        }
+
+        valid &= LowpanDecompressAddr((iphc1 >> LOWPAN_IPHC_SAM_SHIFT) & LOWPAN_IPHC_AM_MASK, 
+                                      srcBdAddr, frame, length, &pos, &ipv6[IPV6_SRC_OFFSET]);
+        valid &= LowpanDecompressAddr(iphc1 & (LOWPAN_IPHC_M | LOWPAN_IPHC_AM_MASK), 
+                                      dstBdAddr, frame, length, &pos, &ipv6[IPV6_DST_OFFSET]);
+
+        if((valid != 0u) && (nhc != 0u))
+        {
+            /* Only the UDP NHC with the inline checksum is supported */
+            if((pos < length) && ((frame[pos] & (LOWPAN_NHC_UDP_MASK | LOWPAN_NHC_UDP_C)) == LOWPAN_NHC_UDP))
+            {
+                switch(frame[pos++] & LOWPAN_NHC_UDP_P_MASK)
+                {
+                    case 0x00u:
+                        valid = LowpanInline(frame, length, &pos, port, 4u);
+                        break;
+                    case 0x01u:
+                        valid = LowpanInline(frame, length, &pos, port, 3u);
+                        port[3u] = port[2u];
+                        port[2u] = HI8(LOWPAN_NHC_PORT_8);
+                        break;
+                    case 0x02u:
+                        valid = LowpanInline(frame, length, &pos, &port[1u], 3u);
+                        port[0u] = HI8(LOWPAN_NHC_PORT_8);
+                        break;
+                    default:
+                        valid = LowpanInline(frame, length, &pos, &port[3u], 1u);
+                        port[0u] = HI8(LOWPAN_NHC_PORT_4);
+                        port[1u] = (uint8)(LO8(LOWPAN_NHC_PORT_4) | (port[3u] >> 4u));
+                        port[2u] = HI8(LOWPAN_NHC_PORT_4);
+                        port[3u] = (uint8)(LO8(LOWPAN_NHC_PORT_4) | (port[3u] & 0x0Fu));
+                        break;
+                }
+                (void)memcpy(&ipv6[IPV6_HDR_LEN], port, 4u);
+                valid &= LowpanInline(frame, length, &pos, &ipv6[IPV6_HDR_LEN + UDP_CHECKSUM_OFFSET], 2u);
+                hdrLen += UDP_HDR_LEN;
+            }
+            else
+            {
+                valid = 0u;
+            }
+        }
+
+        if((valid != 0u) && (((uint32)hdrLen + length - pos) <= size))
+        {
+            result = hdrLen + length - pos;
+            (void)memcpy(&ipv6[hdrLen], &frame[pos], length - pos);
+            IPV6_SET16(&ipv6[IPV6_PLEN_OFFSET], result - IPV6_HDR_LEN);
+            if(nhc != 0u)
+            {
+                IPV6_SET16(&ipv6[IPV6_HDR_LEN + UDP_LEN_OFFSET], result - IPV6_HDR_LEN);
+            }
+        }
+    }
+    else
+    {
+        /* Not a LoWPAN frame or context based compression */
+    }
+
+    return(result);
+}
+
+
+/* [] END OF FILE */
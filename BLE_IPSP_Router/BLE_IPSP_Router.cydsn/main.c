@@ -4,12 +4,18 @@
 * Version: 1.0
 *
 *  This example demonstrates how to setup an IPv6 communication infrastructure 
-*  between two devices over a BLE transport using L2CAP channel. Creation 
-*  and transmission of IPv6 packets over BLE is not part of this example.
+*  between two devices over a BLE transport using L2CAP channel. IPv6 packets
+*  are sent with the 6LoWPAN header compression. Router sends ICMPv6 and UDP
+*  echo requests to the link-local address of Node.
 *
-*  Router sends generated packets with different content to Node in the loop 
-*  and validate them with the afterwards received data packet. Node simply wraps
-*  received data coming from the Node, back to the Router.
+*  Router keeps a table of up to IPSP_NODE_MAX connected Nodes, each with its
+*  own L2CAP channel, and forwards IPv6 packets between them. The SDUs queued
+*  for the Nodes are sent in a round-robin order. The PSoC 4 BLE component
+*  holds one link, so one Node is connected at a time on this part.
+*
+*  Router streams generated packets with different content to Node and
+*  validates the wrapped packets by their sequence number and CRC. Node simply
+*  wraps received data coming from the Router, back to the Router.
 *
 * Note:
 *
@@ -28,7 +34,6 @@
 #include <stdbool.h>
 
 uint16 connIntv;                    /* in milliseconds / 1.25ms */
-bool l2capConnected = false;
 CYBLE_L2CAP_CBFC_CONN_CNF_PARAM_T l2capParameters;
 
 CYBLE_GAP_BD_ADDR_T peerAddr[CYBLE_MAX_ADV_DEVICES];
@@ -37,52 +42,312 @@ uint8 deviceN = 0u;
 
 uint8 state = STATE_INIT;
 
-static uint16 ipv6LoopbackBuffer[L2CAP_MAX_LEN/2];
+bool streamEnabled = false;
+volatile uint8 timerTick = 0u;      /* Set every second by Timer_Interrupt */
 
-uint8 custom_command = 0u;
+/* IPv6 over the L2CAP channels, the Node addresses are kept in ipspNode[] */
+CYBLE_GAP_BD_ADDR_T ipv6LocalBdAddr;
+uint8 ipv6Address[IPV6_ADDR_SIZE];      /* Link-local address of Router */
+uint16 ipv6EchoSeq = 0u;
+static uint8 ipv6Buffer[IPV6_MTU];      /* Decompressed IPv6 packet */
 
+/* Scan filter of the Nodes that advertise IPSS, compiled once */
+static SCAN_FILTER_T ipssFilter;
 
-/****************************************************************************** 
-##Function Name: CheckAdvPacketForServiceUuid
-*******************************************************************************
 
-Summary:
- This function parses advertising packet and returns not zero value 
- when packet contains service UUID equal to input parameter.
+/*******************************************************************************
+* Function Name: StreamFill
+********************************************************************************
+*
+* Summary:
+*  Builds a stream SDU: the NALP dispatch, the sequence number, the payload
+*  generated from it and the CRC-16 of the preceding bytes.
+*
+* Parameters:
+*  sdu - the buffer of STREAM_SDU_LEN bytes.
+*  seq - the sequence number.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void StreamFill(uint8 sdu[], uint16 seq)
+{
+    uint16 i;
 
-Parameters:
- *eventParam: the pointer to a data structure specified by the event.
- uuid: 16-bit UUID of the service.
+    sdu[0u] = LOWPAN_DISPATCH_NALP;
+    CyBle_Set16ByPtr(&sdu[STREAM_SEQ_OFFSET], seq);
+    for(i = STREAM_HDR_LEN; i < (STREAM_SDU_LEN - STREAM_CRC_LEN); i++)
+    {
+        sdu[i] = (uint8)(seq + i);
+    }
+    CyBle_Set16ByPtr(&sdu[STREAM_SDU_LEN - STREAM_CRC_LEN], Crc16(sdu, STREAM_SDU_LEN - STREAM_CRC_LEN));
+}
 
-Return:
- Not zero value when the advertising packet contains service UUID.
 
-******************************************************************************/
-uint32 CheckAdvPacketForServiceUuid(CYBLE_GAPC_ADV_REPORT_T *eventParam, uint16 uuid)
+/*******************************************************************************
+* Function Name: StreamCheck
+********************************************************************************
+*
+* Summary:
+*  Validates an SDU received back from Node. The sequence number must be the
+*  expected one and the CRC must match, so the whole payload does not have to
+*  be compared. After a lost SDU, the sequence follows the received one.
+*
+* Parameters:
+*  node   - the Node the SDU is received from.
+*  sdu    - the received SDU.
+*  length - the SDU length.
+*
+* Return:
+*  Not zero value when the SDU is valid.
+*
+*******************************************************************************/
+static uint8 StreamCheck(IPSP_NODE_T *node, const uint8 sdu[], uint16 length)
 {
-    uint32 servicePresent = 0u; 
-    uint32 advIndex = 0u;
-    uint32 i;
-    
-    do
+    uint8 valid = 0u;
+    uint16 seq;
+
+    if((length == STREAM_SDU_LEN) &&
+       (CyBle_Get16ByPtr(&sdu[length - STREAM_CRC_LEN]) == Crc16(sdu, length - STREAM_CRC_LEN)))
+    {
+        seq = CyBle_Get16ByPtr(&sdu[STREAM_SEQ_OFFSET]);
+        if(seq == node->streamRxSeq)
+        {
+            node->streamRxBytes += length;
+            valid = 1u;
+        }
+        node->streamRxSeq = seq + 1u;
+    }
+
+    return(valid);
+}
+
+
+/*******************************************************************************
+* Function Name: StreamProcess
+********************************************************************************
+*
+* Summary:
+*  Builds new SDUs for every Node in the free SDU buffers. No more than
+*  STREAM_WINDOW SDUs are waiting to be wrapped by a Node, so the Node always
+*  has a free buffer for them.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void StreamProcess(void)
+{
+    IPSP_NODE_T *node;
+    uint8 *sdu;
+    uint8 i;
+
+    if(streamEnabled == true)
     {
-        /* Find complete or incomplete Service UUID list field type. */
-        if((eventParam->data[advIndex + 1u] == (uint8)CYBLE_GAP_ADV_INCOMPL_16UUID) || 
-           (eventParam->data[advIndex + 1u] == (uint8)CYBLE_GAP_ADV_COMPL_16UUID))
+        for(i = 0u; i < IPSP_NODE_MAX; i++)
         {
-            /* Compare uuid values with input parameter */
-            for(i = 0u; (i < (eventParam->data[advIndex] - 1u)) && (servicePresent == 0u); i += sizeof(uint16))
+            node = &ipspNode[i];
+            while((node->connected != 0u) && ((uint16)(node->streamTxSeq - node->streamRxSeq) < STREAM_WINDOW) && 
+                  ((sdu = IpspSduAlloc(&node->sdu)) != NULL))
             {
-                if(CyBle_Get16ByPtr(&eventParam->data[advIndex + 2u + i]) == uuid)
-                {
-                    servicePresent = 1u;
-                }
+                StreamFill(sdu, node->streamTxSeq);
+                IpspSduCommit(&node->sdu, STREAM_SDU_LEN);
+                node->streamTxSeq++;
             }
         }
-        advIndex += eventParam->data[advIndex] + 1u;
-    }while((advIndex < eventParam->dataLen) && (servicePresent == 0u));    
-    
-    return(servicePresent);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: Ipv6Send
+********************************************************************************
+*
+* Summary:
+*  Compresses the IPv6 packet in ipv6Buffer directly to an SDU buffer and 
+*  queues it for sending to the Node.
+*
+* Parameters:
+*  node   - the destination Node.
+*  length - the IPv6 packet length.
+*
+* Return:
+*  The SDU length or 0 if the packet is not queued.
+*
+*******************************************************************************/
+static uint16 Ipv6Send(IPSP_NODE_T *node, uint16 length)
+{
+    uint8 *sdu = IpspSduAlloc(&node->sdu);
+    uint16 sduLength = 0u;
+
+    if(sdu != NULL)
+    {
+        sduLength = LowpanCompress(ipv6Buffer, length, ipv6LocalBdAddr.bdAddr, node->bdAddr.bdAddr, 
+                                   sdu, L2CAP_MAX_LEN);
+    }
+
+    if(sduLength != 0u)
+    {
+        IpspSduCommit(&node->sdu, sduLength);
+    }
+    else
+    {
+        node->dropped++;
+    }
+
+    return(sduLength);
+}
+
+
+/*******************************************************************************
+* Function Name: Ipv6Receive
+********************************************************************************
+*
+* Summary:
+*  Decompresses an IPv6 packet received from a Node. The packets addressed
+*  to another Node are forwarded to it: all the Nodes are the neighbours of
+*  Router only, so Router relays the traffic between them. The echo replies
+*  addressed to Router are reported.
+*
+* Parameters:
+*  node   - the Node the frame is received from.
+*  data   - the LoWPAN frame.
+*  length - the frame length.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void Ipv6Receive(IPSP_NODE_T *node, const uint8 data[], uint16 length)
+{
+    uint16 ipv6Length;
+    uint8 *upper = &ipv6Buffer[IPV6_HDR_LEN];
+    IPSP_NODE_T *dest;
+
+    ipv6Length = LowpanDecompress(data, length, node->bdAddr.bdAddr, ipv6LocalBdAddr.bdAddr, 
+                                  ipv6Buffer, IPV6_MTU);
+    if((ipv6Length == 0u) || (Ipv6Checksum(ipv6Buffer, ipv6Length) != 0u))
+    {
+        DBG_PRINTF("<- Invalid LoWPAN frame, dispatch: %x \r\n", data[0u]);
+    }
+    else if((dest = IpspNodeFindAddress(&ipv6Buffer[IPV6_DST_OFFSET])) != NULL)
+    {
+        /* The hop limit is not covered by the checksum */
+        if((dest != node) && (ipv6Buffer[IPV6_HLIM_OFFSET] > 1u))
+        {
+            ipv6Buffer[IPV6_HLIM_OFFSET]--;
+            if(Ipv6Send(dest, ipv6Length) != 0u)
+            {
+                dest->forwarded++;
+            }
+        }
+    }
+    else if((ipv6Buffer[IPV6_NH_OFFSET] == IPV6_NH_ICMPV6) && (upper[ICMPV6_TYPE_OFFSET] == ICMPV6_ECHO_REPLY))
+    {
+        DBG_PRINTF("<- ICMPv6 echo reply: seq=%d, %d bytes in %d bytes SDU \r\n", 
+            IPV6_GET16(&upper[ICMPV6_SEQ_OFFSET]), ipv6Length, length);
+    }
+    else if((ipv6Buffer[IPV6_NH_OFFSET] == IPV6_NH_UDP) && 
+            (IPV6_GET16(&upper[UDP_SRC_PORT_OFFSET]) == UDP_PORT_ECHO))
+    {
+        DBG_PRINTF("<- UDP echo reply: %d bytes in %d bytes SDU \r\n", ipv6Length, length);
+    }
+    else
+    {
+        DBG_PRINTF("<- IPv6 packet: next header=%d, %d bytes \r\n", ipv6Buffer[IPV6_NH_OFFSET], ipv6Length);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: StreamReport
+********************************************************************************
+*
+* Summary:
+*  Prints the goodput and the credit counters of the stream of every Node.
+*  Must be called every second.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void StreamReport(void)
+{
+    IPSP_NODE_T *node;
+    uint8 i;
+
+    for(i = 0u; i < IPSP_NODE_MAX; i++)
+    {
+        node = &ipspNode[i];
+        if((streamEnabled == true) && (node->connected != 0u))
+        {
+            DBG_PRINTF("Node %d: goodput: %ld B/s, errors: %ld, TX credit: %d, forwarded: %ld, dropped: %ld \r\n", 
+                i, node->streamRxBytes, node->streamErrors, node->sdu.txCredit, node->forwarded, node->dropped);
+            DBG_PRINTF("Node %d: RX credit: window=%d, granted=%ld, stalls=%ld, zero credit=%ld ms \r\n", 
+                i, node->credit.window, node->credit.granted, node->credit.stalls, IpspCreditZeroTime(&node->credit));
+        }
+        node->streamRxBytes = 0u;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: Ipv6SendAll
+********************************************************************************
+*
+* Summary:
+*  Sends an ICMPv6 echo request or a UDP datagram to every Node.
+*
+* Parameters:
+*  udp - send a UDP datagram to the echo port instead of an echo request.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void Ipv6SendAll(uint8 udp)
+{
+    static const uint8 udpData[] = "IPv6 over BLE";
+    IPSP_NODE_T *node;
+    uint16 length;
+    uint16 sduLength;
+    uint8 i;
+
+    for(i = 0u; i < IPSP_NODE_MAX; i++)
+    {
+        node = &ipspNode[i];
+        if(node->connected != 0u)
+        {
+            if(udp != 0u)
+            {
+                length = Ipv6Udp(ipv6Buffer, ipv6Address, node->ipv6Address, IPV6_UDP_PORT, 
+                                 UDP_PORT_ECHO, udpData, sizeof(udpData) - 1u);
+            }
+            else
+            {
+                length = Ipv6EchoRequest(ipv6Buffer, ipv6Address, node->ipv6Address, 
+                                         IPV6_ECHO_ID, ipv6EchoSeq, IPV6_ECHO_DATA_LEN);
+            }
+
+            sduLength = Ipv6Send(node, length);
+            if(sduLength != 0u)
+            {
+                DBG_PRINTF("-> Node %d: IPv6 packet: %d bytes in %d bytes SDU \r\n", i, length, sduLength);
+            }
+            else
+            {
+                DBG_PRINTF("-> Node %d: IPv6 packet is not sent \r\n", i);
+            }
+        }
+    }
+    ipv6EchoSeq++;
 }
 
 
@@ -107,12 +372,15 @@ uint32 CheckAdvPacketForServiceUuid(CYBLE_GAPC_ADV_REPORT_T *eventParam, uint16
 * event.
 * When GAP connection is established, after CYBLE_EVT_GATT_CONNECT_IND event, 
 * Router automatically initiates an L2CAP LE credit based connection with a PSM
-* set to LE_PSM_IPSP.
-* Use '1' command to generate and send first Data packet to Node though IPSP 
-* channel. Sent data will be compared with the received data in response packed 
-* after CYBLE_EVT_L2CAP_CBFC_DATA_READ event. When no failure observed, new 
-* packed will be generated and send to Node. Otherwise transfer will be stopped
-* and "Wraparound failed" message will indicate failure.
+* set to LE_PSM_IPSP. Every connected channel gets an entry in the Node table.
+* The BLE component holds one link, so one entry is in use and the next Node
+* is connected after the current one is disconnected. The L2CAP events are
+* dispatched to the Node by the local CID of the channel.
+* Use '1' command to start or stop streaming Data packets to all Nodes though
+* IPSP channels. Up to STREAM_WINDOW packets per Node are in flight. Every 
+* packet received back after CYBLE_EVT_L2CAP_CBFC_DATA_READ event is validated
+* by its sequence number and CRC, and "Wraparound failed" message indicates 
+* failure.
 *
 *******************************************************************************/
 void AppCallback(uint32 event, void* eventParam)
@@ -120,6 +388,9 @@ void AppCallback(uint32 event, void* eventParam)
     CYBLE_API_RESULT_T apiResult;
     CYBLE_GAP_BD_ADDR_T localAddr;
     CYBLE_GAPC_ADV_REPORT_T *advReport;
+    SCAN_ENTRY_T *scanEntry;
+    uint8 scanResult;
+    IPSP_NODE_T *node;
     uint8 newDevice = 0u;
     uint16 i;
     
@@ -139,6 +410,8 @@ void AppCallback(uint32 event, void* eventParam)
             }
             
             /* Start Limited Discovery */
+            ScanFilterUuid16(&ipssFilter, CYBLE_UUID_INTERNET_PROTOCOL_SUPPORT_SERVICE);
+            ScanStart(&ipssFilter);
             apiResult = CyBle_GapcStartScan(CYBLE_SCANNING_FAST);                   
             if(apiResult != CYBLE_ERROR_OK)
             {
@@ -177,8 +450,12 @@ void AppCallback(uint32 event, void* eventParam)
         /* This event provides the remote device lists during discovery process. */
         case CYBLE_EVT_GAPC_SCAN_PROGRESS_RESULT:
             advReport = (CYBLE_GAPC_ADV_REPORT_T *)eventParam;
-            /* Filter and connect only to nodes that advertise IPSS in ADV payload */
-            if(CheckAdvPacketForServiceUuid(advReport, CYBLE_UUID_INTERNET_PROTOCOL_SUPPORT_SERVICE) != 0u)
+            /* Filter and connect only to nodes that advertise IPSS in ADV payload,
+            *  the reports that repeat the cached ones are skipped without parsing.
+            */
+            scanEntry = ScanReport(advReport->peerBdAddr, SCAN_TYPE(advReport->eventType, advReport->peerAddrType),
+                                   advReport->rssi, advReport->data, advReport->dataLen, &scanResult);
+            if((SCAN_REPORT_DUPLICATE != scanResult) && (SCAN_NO_MATCH != scanEntry->match))
             {
                 DBG_PRINTF("Advertisement report: eventType = %x, peerAddrType - %x, ", 
                     advReport->eventType, advReport->peerAddrType);
@@ -207,7 +484,7 @@ void AppCallback(uint32 event, void* eventParam)
                 {
                     DBG_PRINTF("%2.2x", advReport->peerBdAddr[i-1]);
                 }
-                DBG_PRINTF(", rssi - %d dBm", advReport->rssi);
+                DBG_PRINTF(", rssi - %d dBm (%d average)", advReport->rssi, SCAN_RSSI(scanEntry));
             #if(DEBUG_UART_FULL)  
                 DBG_PRINTF(", data - ");
                 for( i = 0; i < advReport->dataLen; i++)
@@ -290,6 +567,12 @@ void AppCallback(uint32 event, void* eventParam)
             break;
         case CYBLE_EVT_GAP_DEVICE_DISCONNECTED:
             DBG_PRINTF("CYBLE_EVT_GAP_DEVICE_DISCONNECTED: %x\r\n", *(uint8 *)eventParam);
+            IpspNodePurge();
+            if(ipspNodeCount == 0u)
+            {
+                streamEnabled = false;
+            }
+            ScanStart(&ipssFilter);
             apiResult = CyBle_GapcStartScan(CYBLE_SCANNING_FAST);                   /* Start Limited Discovery */
             if(apiResult != CYBLE_ERROR_OK)
             {
@@ -304,7 +587,8 @@ void AppCallback(uint32 event, void* eventParam)
         *                       GATT Events
         ***********************************************************/
         case CYBLE_EVT_GATT_CONNECT_IND:
-            DBG_PRINTF("CYBLE_EVT_GATT_CONNECT_IND: %x, %x \r\n", cyBle_connHandle.attId, cyBle_connHandle.bdHandle);
+            DBG_PRINTF("CYBLE_EVT_GATT_CONNECT_IND: %x, %x \r\n", 
+                ((CYBLE_CONN_HANDLE_T *)eventParam)->attId, ((CYBLE_CONN_HANDLE_T *)eventParam)->bdHandle);
             /* Send an L2CAP LE credit based connection request with a PSM set to LE_PSM_IPSP.
              * Once the peer responds, CYBLE_EVT_L2CAP_CBFC_CONN_CNF 
              * event will come up on this device.
@@ -316,9 +600,9 @@ void AppCallback(uint32 event, void* eventParam)
                 {
                     CYBLE_L2CAP_MTU,         /* MTU size of this device */
                     CYBLE_L2CAP_MPS,         /* MPS size of this device */
-                    LE_DATA_CREDITS_IPSP     /* Initial Credits given to peer device for Tx */
+                    IPSP_CREDIT_INIT         /* Initial Credits given to peer device for Tx */
                 };
-                apiResult = CyBle_L2capCbfcConnectReq(cyBle_connHandle.bdHandle, CYBLE_L2CAP_PSM_LE_PSM_IPSP, 
+                apiResult = CyBle_L2capCbfcConnectReq(((CYBLE_CONN_HANDLE_T *)eventParam)->bdHandle, CYBLE_L2CAP_PSM_LE_PSM_IPSP, 
                                       CYBLE_L2CAP_PSM_LE_PSM_IPSP, &cbfcConnParameters);
                 if(apiResult != CYBLE_ERROR_OK)
                 {
@@ -353,39 +637,71 @@ void AppCallback(uint32 event, void* eventParam)
                 l2capParameters.connParam.mtu,
                 l2capParameters.connParam.mps,
                 l2capParameters.connParam.credit);
-            l2capConnected = true;
+            if(l2capParameters.response == CYBLE_L2CAP_CONNECTION_SUCCESSFUL)
+            {
+                /* The link-layer addresses are used to compress the IPv6 addresses */
+                ipv6LocalBdAddr.type = 0u;
+                CyBle_GetDeviceAddress(&ipv6LocalBdAddr);
+                LowpanLinkLocal(ipv6LocalBdAddr.bdAddr, ipv6Address);
+                
+                node = IpspNodeOpen(l2capParameters.bdHandle, l2capParameters.lCid, 
+                                    l2capParameters.connParam.credit, l2capParameters.connParam.mps);
+                if(node != NULL)
+                {
+                    DBG_PRINTF("Node %d connected, Nodes: %d \r\n", (int)(node - ipspNode), ipspNodeCount);
+                }
+                else
+                {
+                    apiResult = CyBle_L2capCbfcDisconnectReq(l2capParameters.lCid);
+                    DBG_PRINTF("Node table is full, CyBle_L2capCbfcDisconnectReq: %d \r\n", apiResult);
+                }
+            }
             break;
 
         case CYBLE_EVT_L2CAP_CBFC_DISCONN_IND:
             DBG_PRINTF("CYBLE_EVT_L2CAP_CBFC_DISCONN_IND: %d \r\n", *(uint16 *)eventParam);
-            l2capConnected = false;
+            node = IpspNodeFind(*(uint16 *)eventParam);
+            if(node != NULL)
+            {
+                IpspNodeClose(node);
+            }
+            if(ipspNodeCount == 0u)
+            {
+                streamEnabled = false;
+            }
             break;
 
         /* Following two events are required, to receive data */        
         case CYBLE_EVT_L2CAP_CBFC_DATA_READ:
             {
                 CYBLE_L2CAP_CBFC_RX_PARAM_T *rxDataParam = (CYBLE_L2CAP_CBFC_RX_PARAM_T *)eventParam;
+            #if(DEBUG_UART_FULL)  
                 DBG_PRINTF("<- EVT_L2CAP_CBFC_DATA_READ: lCid=%d, result=%d, len=%d", 
                     rxDataParam->lCid,
                     rxDataParam->result,
                     rxDataParam->rxDataLength);
-            #if(DEBUG_UART_FULL)  
                 DBG_PRINTF(", data:");
                 for(i = 0; i < rxDataParam->rxDataLength; i++)
                 {
                     DBG_PRINTF("%2.2x", rxDataParam->rxData[i]);
                 }
-            #endif /* DEBUG_UART_FULL */
                 DBG_PRINTF("\r\n");
-                /* Data is received from Node, validate the content */
-                if(memcmp(((uint8 *)ipv6LoopbackBuffer), rxDataParam->rxData, L2CAP_MAX_LEN) != 0u)
-                {
-                    DBG_PRINTF("Wraparound failed \r\n");
-                }
-                else
+            #endif /* DEBUG_UART_FULL */
+                node = IpspNodeFind(rxDataParam->lCid);
+                if(node != NULL)
                 {
-                    /* Send new Data packet to Node though IPSP channel  */
-                    custom_command = '1';
+                    IpspCreditConsume(&node->credit, rxDataParam->rxDataLength);
+                    /* Data is received from Node: an IPv6 packet or the stream data to validate */
+                    if((rxDataParam->rxDataLength != 0u) &&
+                       ((rxDataParam->rxData[0u] & LOWPAN_DISPATCH_NALP_MASK) != LOWPAN_DISPATCH_NALP))
+                    {
+                        Ipv6Receive(node, rxDataParam->rxData, rxDataParam->rxDataLength);
+                    }
+                    else if(StreamCheck(node, rxDataParam->rxData, rxDataParam->rxDataLength) == 0u)
+                    {
+                        node->streamErrors++;
+                        DBG_PRINTF("Node %d: Wraparound failed \r\n", (int)(node - ipspNode));
+                    }
                 }
             }
             break;
@@ -398,12 +714,12 @@ void AppCallback(uint32 event, void* eventParam)
                     rxCreditParam->credit);
 
                 /* This event informs that receive credits reached low mark. 
-                 * If the device expects more data to receive, send more credits back to the peer device.
+                 * The credits are sent back to the peer device from the main loop.
                  */
-                apiResult = CyBle_L2capCbfcSendFlowControlCredit(rxCreditParam->lCid, LE_DATA_CREDITS_IPSP);
-                if(apiResult != CYBLE_ERROR_OK)
+                node = IpspNodeFind(rxCreditParam->lCid);
+                if(node != NULL)
                 {
-                    DBG_PRINTF("CyBle_L2capCbfcSendFlowControlCredit API Error: %d \r\n", apiResult);
+                    IpspCreditSync(&node->credit, rxCreditParam->credit);
                 }
             }
             break;
@@ -414,9 +730,20 @@ void AppCallback(uint32 event, void* eventParam)
                 ((CYBLE_L2CAP_CBFC_LOW_TX_CREDIT_PARAM_T *)eventParam)->lCid,
                 ((CYBLE_L2CAP_CBFC_LOW_TX_CREDIT_PARAM_T *)eventParam)->result,
                 ((CYBLE_L2CAP_CBFC_LOW_TX_CREDIT_PARAM_T *)eventParam)->credit);
+            node = IpspNodeFind(((CYBLE_L2CAP_CBFC_LOW_TX_CREDIT_PARAM_T *)eventParam)->lCid);
+            if(node != NULL)
+            {
+                IpspSduAddCredit(&node->sdu, ((CYBLE_L2CAP_CBFC_LOW_TX_CREDIT_PARAM_T *)eventParam)->credit);
+            }
             break;
         
         case CYBLE_EVT_L2CAP_CBFC_DATA_WRITE_IND:
+            /* The stack does not use the SDU buffer anymore */
+            node = IpspNodeFind(((CYBLE_L2CAP_CBFC_DATA_WRITE_PARAM_T *)eventParam)->lCid);
+            if(node != NULL)
+            {
+                IpspSduWriteComplete(&node->sdu);
+            }
             #if(DEBUG_UART_FULL)
             {
                 CYBLE_L2CAP_CBFC_DATA_WRITE_PARAM_T *writeDataParam = (CYBLE_L2CAP_CBFC_DATA_WRITE_PARAM_T*)eventParam;
@@ -500,7 +827,10 @@ CY_ISR(Timer_Interrupt)
     {
         led ^= LED_ON;
         Scanning_LED_Write(led);
+        ScanTick();
     }
+
+    timerTick = 1u;
 }
 
 
@@ -620,6 +950,7 @@ int main()
     CYBLE_API_RESULT_T apiResult;
     CYBLE_STACK_LIB_VERSION_T stackVersion;
     char8 command;
+    uint8 i;
     
     CyGlobalIntEnable;              /* Enable interrupts */
     UART_DEB_Start();               /* Start communication component */
@@ -652,18 +983,32 @@ int main()
         /* To achieve low power in the device */
         LowPowerImplementation();
         
-        if(((command = UART_DEB_UartGetChar()) != 0) || ((custom_command != 0) && (cyBle_busyStatus == 0u)))
+        if(ipspNodeCount != 0u)
+        {
+            StreamProcess();
+            IpspNodeProcess();
+        }
+        if(timerTick != 0u)
+        {
+            timerTick = 0u;
+            IpspNodeTick();
+            StreamReport();
+        }
+        
+        if((command = UART_DEB_UartGetChar()) != 0)
         {
-            if(custom_command != 0u)
-            {
-                command = custom_command;
-                custom_command = 0u;
-            }
             switch(command)
             {
                 case 'c':                   /* Send connect request to selected peer device.  */
-                    CyBle_GapcStopScan(); 
-                    state = STATE_CONNECTING;
+                    /* The BLE component holds one link, a Node is only 
+                    *  connected from the scanning state 
+                    */
+                    if(CyBle_GetState() == CYBLE_STATE_SCANNING)
+                    {
+                        /* Connect when the scanning is stopped */
+                        CyBle_GapcStopScan(); 
+                        state = STATE_CONNECTING;
+                    }
                     break;
                 case 'v':                   /* Cancel connection request. */
                     apiResult = CyBle_GapcCancelDeviceConnection();
@@ -701,33 +1046,30 @@ int main()
                     /**********************************************************
                     *               L2Cap Commands (WrapAround)
                     ***********************************************************/
-                case '1':                   /* Send Data packet to node though IPSP channel */
+                case '1':                   /* Start or stop streaming Data packets to node though IPSP channel */
+                    if(streamEnabled == false)
                     {
-                        static uint16 counter = 0;
-                        static uint16 repeats = 0;
-                        uint16 i;
-                        
-                        DBG_PRINTF("-> CyBle_L2capChannelDataWrite #%d \r\n", repeats++);
-                        (void)repeats;
-                    #if(DEBUG_UART_FULL)  
-                        DBG_PRINTF(", Data:");
-                    #endif /* DEBUG_UART_FULL */
-                        /* Fill output buffer by counter */
-                        for(i = 0u; i < L2CAP_MAX_LEN / 2u; i++)
+                        for(i = 0u; i < IPSP_NODE_MAX; i++)
                         {
-                            ipv6LoopbackBuffer[i] = counter++;
-                        #if(DEBUG_UART_FULL)  
-                            DBG_PRINTF("%4.4x", ipv6LoopbackBuffer[i]);
-                        #endif /* DEBUG_UART_FULL */
-                        }
-                        apiResult = CyBle_L2capChannelDataWrite(cyBle_connHandle.bdHandle,
-                                        l2capParameters.lCid, (uint8 *)ipv6LoopbackBuffer, L2CAP_MAX_LEN);
-                        if(apiResult != CYBLE_ERROR_OK)
-                        {
-                            DBG_PRINTF("CyBle_L2capChannelDataWrite API Error: %x \r\n", apiResult);
+                            ipspNode[i].streamRxBytes = 0u;
+                            ipspNode[i].streamErrors = 0u;
                         }
+                        timerTick = 0u;
+                        streamEnabled = true;
+                        DBG_PRINTF("Stream started \r\n");
+                    }
+                    else
+                    {
+                        streamEnabled = false;
+                        DBG_PRINTF("Stream stopped \r\n");
                     }
                     break;
+                case '2':                   /* Send ICMPv6 echo request to every node */
+                    Ipv6SendAll(0u);
+                    break;
+                case '3':                   /* Send UDP datagram to the echo port of every node */
+                    Ipv6SendAll(1u);
+                    break;
                 case 'h':                   /* Help menu */
                     DBG_PRINTF("\r\n");
                     DBG_PRINTF("Available commands:\r\n");
@@ -737,7 +1079,9 @@ int main()
                     DBG_PRINTF(" \'d\' - Send disconnect request to peer device.\r\n");
                     DBG_PRINTF(" \'v\' - Cancel connection request.\r\n");
                     DBG_PRINTF(" \'s\' - Start discovery procedure.\r\n");
-                    DBG_PRINTF(" \'1\' - Send Data packet to Node though IPSP channel.\r\n");
+                    DBG_PRINTF(" \'1\' - Start/stop streaming Data packets to all Nodes though IPSP channels.\r\n");
+                    DBG_PRINTF(" \'2\' - Send ICMPv6 echo request to all Nodes.\r\n");
+                    DBG_PRINTF(" \'3\' - Send UDP datagram to the echo port of all Nodes.\r\n");
                     break;
             }
         }
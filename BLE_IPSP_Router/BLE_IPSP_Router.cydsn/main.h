@@ -16,6 +16,13 @@
 
 #include <project.h>
 #include <stdio.h>
+#include "ipspsdu.h"
+#include "ipspcredit.h"
+#include "lowpan.h"
+#include "ipv6.h"
+#include "ipspnode.h"
+#include "crc16.h"
+#include "scan.h"
 
 #define ENABLED                     (1u)
 #define DISABLED                    (0u)
@@ -44,11 +51,30 @@
 
 /* IPSP defines */
 #define LE_DATA_CREDITS_IPSP         (1000u)
-/* Set the watermark to half of the total credits to be used */
-#define LE_WATER_MARK_IPSP           (LE_DATA_CREDITS_IPSP/2u)
+/* Credits are returned by the credit controller before the peer runs out of
+*  them, the watermark only reports the peer that cannot send a full SDU.
+*/
+#define LE_WATER_MARK_IPSP           (IPSP_CREDIT_SDU)
 
 #define L2CAP_MAX_LEN                (CYBLE_L2CAP_MTU - 2u)
 
+/* Stream SDU: NALP dispatch, sequence number, payload and CRC-16 of the 
+*  preceding bytes. The dispatch tells Node that the SDU is not an IPv6 packet.
+*/
+#define STREAM_SEQ_OFFSET            (1u)
+#define STREAM_HDR_LEN               (3u)
+#define STREAM_CRC_LEN               (2u)
+#define STREAM_SDU_LEN               (L2CAP_MAX_LEN)
+/* SDUs waiting to be wrapped by each Node. Node has 3 SDU buffers and one of
+*  them may still be owned by its stack when the wrapped SDU arrives here, so
+*  one buffer is left spare.
+*/
+#define STREAM_WINDOW                (2u)
+
+#define IPV6_ECHO_ID                 (0x4950u)  /* ICMPv6 echo identifier */
+#define IPV6_ECHO_DATA_LEN           (64u)
+#define IPV6_UDP_PORT                (0xF0B0u)  /* Source port, compressed to 4 bits */
+
 
 /***************************************
 *        External Function Prototypes
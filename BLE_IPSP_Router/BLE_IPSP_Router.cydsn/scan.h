@@ -0,0 +1,88 @@
+/*******************************************************************************
+* File Name: scan.h
+*
+* Version 1.0
+*
+* Description:
+*  Contains the function prototypes and constants of the scan engine: the
+*  cache of the recently seen advertisers and the advertising data filter.
+*
+* Hardware Dependency:
+*  CY8CKIT-042 BLE
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(SCAN_H)
+#define SCAN_H
+
+#include "cytypes.h"
+#include "adparse.h"
+
+
+/***************************************
+*        Constants
+***************************************/
+#define SCAN_CACHE_SIZE             (16u)       /* Cached reports, a power of two */
+#define SCAN_CACHE_MASK             (SCAN_CACHE_SIZE - 1u)
+#define SCAN_AGE_OUT                (8u)        /* ScanTick() periods a report stays cached */
+#define SCAN_BD_ADDR_SIZE           (6u)
+#define SCAN_NO_MATCH               (0xFFu)     /* The data does not pass the filter */
+
+#define SCAN_AD_UUID16_MIN_LEN      (1u + AD_UUID16_SIZE)  /* AD length of the type and one UUID */
+
+/* Results of ScanReport() */
+#define SCAN_REPORT_NEW             (0u)        /* The first report or the cached one aged out */
+#define SCAN_REPORT_CHANGED         (1u)        /* The advertising data differs from the cached one */
+#define SCAN_REPORT_DUPLICATE       (2u)        /* The same data as the cached report */
+
+/* Distinguishes the advertising and scan response reports of one address */
+#define SCAN_TYPE(eventType, addrType)  ((uint8)(((uint32)(eventType) << 1u) | ((uint32)(addrType) & 1u)))
+
+/* Smoothed RSSI of the entry, dBm */
+#define SCAN_RSSI(entry)            ((int8)((entry)->rssi / 16))
+
+
+/***************************************
+*        Data Struct Definition
+***************************************/
+typedef struct
+{
+    uint32 adTypes;             /* Bit n is set when AD type n is inspected */
+    uint16 uuid;                /* 16-bit UUID to match */
+    uint8  minLen;              /* Shortest AD structure that is inspected, its length byte */
+    uint8  list;                /* Non-zero: every UUID of the structure is compared, else the first one */
+} SCAN_FILTER_T;
+
+typedef struct
+{
+    uint8  bdAddr[SCAN_BD_ADDR_SIZE];
+    uint8  type;                /* SCAN_TYPE() of the report */
+    uint8  used;                /* Non-zero once the entry has been taken */
+    uint32 seen;                /* Scan clock of the last report */
+    int16  rssi;                /* Smoothed RSSI, 1/16 dBm */
+    uint16 dataHash;            /* Hash of the advertising data */
+    uint8  dataLen;
+    uint8  match;               /* Offset of the AD structure that passed the filter or SCAN_NO_MATCH */
+    uint16 reports;             /* Reports since the entry has been taken */
+} SCAN_ENTRY_T;
+
+
+/***************************************
+*      API Function Prototypes
+***************************************/
+void ScanFilterUuid16(SCAN_FILTER_T *filter, uint16 uuid);
+void ScanFilterServiceData16(SCAN_FILTER_T *filter, uint16 uuid, uint8 minLen);
+void ScanStart(const SCAN_FILTER_T *filter);
+void ScanTick(void);
+SCAN_ENTRY_T *ScanReport(const uint8 bdAddr[], uint8 type, int8 rssi, const uint8 data[], uint8 dataLen,
+                         uint8 *result);
+
+
+#endif /* SCAN_H */
+
+/* [] END OF FILE */
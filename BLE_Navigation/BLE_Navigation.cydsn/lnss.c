@@ -28,6 +28,12 @@ CYBLE_LNS_LS_T ls;
 CYBLE_LNS_NV_T nv;
 CYBLE_DATE_TIME_T time = {2015u, 5u, 21u, 14u, 14u, 41u};
 
+/* uint8 LnsPackLs(uint8 pdu[], const CYBLE_LNS_LS_T *value, uint32 flags) */
+PDU_DEFINE_PACK(LnsPackLs, CYBLE_LNS_LS_T, LNS_LS_FIELDS)
+
+/* uint8 LnsPackNv(uint8 pdu[], const CYBLE_LNS_NV_T *value, uint32 flags) */
+PDU_DEFINE_PACK(LnsPackNv, CYBLE_LNS_NV_T, LNS_NV_FIELDS)
+
 
 /* Location and Speed characteristic data */
 const CYBLE_LNS_LS_T cls[LNS_COUNT] =
@@ -365,83 +371,28 @@ void LnsNtf(void)
         {
             uint8 pdu[sizeof(CYBLE_LNS_LS_T)];
             uint8 ptr;
-            
-            /* Flags field is always first two bytes */
-        	CyBle_Set16ByPtr(&pdu[0u], ls.flags);
 
-            /* Next possible value is at 2nd byte */
-            ptr = 2u;
-                
-            /* If Instantaneous Speed Present flag is set */
-            if(0u != (ls.flags & CYBLE_LNS_LS_FLG_IS))
-            {
-                /* And set 2-byte Instantaneous Speed value */
-                CyBle_Set16ByPtr(&pdu[ptr], ls.instSpd);
-                /* Next data will be located beginning from 3rd byte */
-                ptr += sizeof(ls.instSpd);
-            }
-            
-            if(0u != (ls.flags & CYBLE_LNS_LS_FLG_TD))
-            {
-                pdu[ptr] = (uint8) (ls.totalDst & 0x000000FFu);
-                pdu[ptr + 1] = (uint8) ((ls.totalDst & 0x0000FF00u) >> 8u);
-                pdu[ptr + 2] = (uint8) ((ls.totalDst & 0x00FF0000u) >> 16u);
-                ptr += 3; /* Total Distance size is actually 3 bytes */
-            }
+            NTF_STAT_BUILD_START();
 
-            if(0u != (ls.flags & CYBLE_LNS_LS_FLG_LC))
-            {
-                pdu[ptr] = (uint8) (ls.latitude & 0x000000FFu);
-                pdu[ptr + 1] = (uint8) ((ls.latitude & 0x0000FF00u) >> 8u);
-                pdu[ptr + 2] = (uint8) ((ls.latitude & 0x00FF0000u) >> 16u);
-                pdu[ptr + 3] = (uint8) ((ls.latitude & 0xFF000000u) >> 24u);
-                ptr += sizeof(ls.latitude);
-                pdu[ptr] = (uint8) (ls.longitude & 0x000000FFu);
-                pdu[ptr + 1] = (uint8) ((ls.longitude & 0x0000FF00u) >> 8u);
-                pdu[ptr + 2] = (uint8) ((ls.longitude & 0x00FF0000u) >> 16u);
-                pdu[ptr + 3] = (uint8) ((ls.longitude & 0xFF000000u) >> 24u);
-                ptr += sizeof(ls.longitude);
-            }
-            
-            if(0u != (ls.flags & CYBLE_LNS_LS_FLG_EL))
-            {
-                pdu[ptr] = (uint8) (ls.elevation & 0x000000FFu);
-                pdu[ptr + 1] = (uint8) ((ls.elevation & 0x0000FF00u) >> 8u);
-                pdu[ptr + 2] = (uint8) ((ls.elevation & 0x00FF0000u) >> 16u);
-                ptr += 3; /* Elevation size is actually 3 bytes */
-            }
-            
-            if(0u != (ls.flags & CYBLE_LNS_LS_FLG_HD))
-            {
-                CyBle_Set16ByPtr(&pdu[ptr], ls.heading);
-                ptr += sizeof(ls.heading);
-            }
-            
+            /* The Rolling Time is incremented once more when it is sent */
             if(0u != (ls.flags & CYBLE_LNS_LS_FLG_RT))
             {
                 ls.rollTime++;
-                pdu[ptr] = ls.rollTime;
-                ptr += sizeof(ls.rollTime);
-            }
-            
-            if(0u != (ls.flags & CYBLE_LNS_LS_FLG_UTC))
-            {
-                CyBle_Set16ByPtr(&pdu[ptr], ls.utcTime.year);
-                pdu[ptr + 2u] = ls.utcTime.month;
-                pdu[ptr + 3u] = ls.utcTime.day;
-                pdu[ptr + 4u] = ls.utcTime.hours;
-                pdu[ptr + 5u] = ls.utcTime.minutes;
-                pdu[ptr + 6u] = ls.utcTime.seconds;
-                ptr += 7u;
             }
-            
+
+            ptr = LnsPackLs(pdu, &ls, ls.flags);
+
+            NTF_STAT_BUILD_END();
+
             do
             {
                 CyBle_ProcessEvents();
+                NTF_STAT_BUSY_POLL();
             }
             while(CyBle_GattGetBusyStatus() == CYBLE_STACK_STATE_BUSY);
 
             apiResult = CyBle_LnssSendNotification(cyBle_connHandle, CYBLE_LNS_LS, ptr, pdu);
+            NTF_STAT_SENT(apiResult, ptr);
             
         	if(apiResult != CYBLE_ERROR_OK)
         	{
@@ -484,55 +435,22 @@ void LnsNtf(void)
         {
             uint8 pdu[sizeof(CYBLE_LNS_NV_T)];
             uint8 ptr;
-            
-            /* Flags field is always first two bytes */
-        	CyBle_Set16ByPtr(&pdu[0u], nv.flags);
-            
-            /* Bearing mandatory field is next */
-        	CyBle_Set16ByPtr(&pdu[2u], nv.bearing);
-            
-            /* Heading mandatory field is next */
-        	CyBle_Set16ByPtr(&pdu[4u], nv.heading);
 
-            /* Next possible value is at 6th byte */
-            ptr = 6u;
-                
-            /* If Remaining Distance Present flag is set */
-            if(0u != (nv.flags & CYBLE_LNS_NV_FLG_RD))
-            {
-                /* And set 2-byte Instantaneous Speed value */
-                pdu[ptr] = (uint8) (nv.rDst & 0x000000FFu);
-                pdu[ptr + 1] = (uint8) ((nv.rDst & 0x0000FF00u) >> 8u);
-                pdu[ptr + 2] = (uint8) ((nv.rDst & 0x00FF0000u) >> 16u);
-                ptr += 3; /* Remaining Distance size is actually 3 bytes */
-            }
-            
-            if(0u != (nv.flags & CYBLE_LNS_NV_FLG_RVD))
-            {
-                pdu[ptr] = (uint8) (nv.rvDst & 0x000000FFu);
-                pdu[ptr + 1] = (uint8) ((nv.rvDst & 0x0000FF00u) >> 8u);
-                pdu[ptr + 2] = (uint8) ((nv.rvDst & 0x00FF0000u) >> 16u);
-                ptr += 3; /* Remaining Vertical Distance size is actually 3 bytes */
-            }
+            NTF_STAT_BUILD_START();
+
+            ptr = LnsPackNv(pdu, &nv, nv.flags);
+
+            NTF_STAT_BUILD_END();
 
-            if(0u != (nv.flags & CYBLE_LNS_NV_FLG_EAT))
-            {
-                CyBle_Set16ByPtr(&pdu[ptr], nv.eaTime.year);
-                pdu[ptr + 2u] = nv.eaTime.month;
-                pdu[ptr + 3u] = nv.eaTime.day;
-                pdu[ptr + 4u] = nv.eaTime.hours;
-                pdu[ptr + 5u] = nv.eaTime.minutes;
-                pdu[ptr + 6u] = nv.eaTime.seconds;
-                ptr += 7u;
-            }
-            
             do
             {
                 CyBle_ProcessEvents();
+                NTF_STAT_BUSY_POLL();
             }
             while(CyBle_GattGetBusyStatus() == CYBLE_STACK_STATE_BUSY);
 
             apiResult = CyBle_LnssSendNotification(cyBle_connHandle, CYBLE_LNS_NV, ptr, pdu);
+            NTF_STAT_SENT(apiResult, ptr);
             
         	if(apiResult != CYBLE_ERROR_OK)
         	{
@@ -615,10 +533,14 @@ void LnsProcess(void)
         do
         {
             CyBle_ProcessEvents();
+            NTF_STAT_BUSY_POLL();
         }
         while(CyBle_GattGetBusyStatus() == CYBLE_STACK_STATE_BUSY);
 
-        if(CYBLE_ERROR_OK != (apiResult = CyBle_LnssSendIndication(cyBle_connHandle, CYBLE_LNS_CP, cpSize, cp)))
+        apiResult = CyBle_LnssSendIndication(cyBle_connHandle, CYBLE_LNS_CP, cpSize, cp);
+        NTF_STAT_SENT(apiResult, cpSize);
+
+        if(CYBLE_ERROR_OK != apiResult)
         {
             DBG_PRINTF("CyBle_LnssSendIndication API Error: %x \r\n", apiResult);
         }
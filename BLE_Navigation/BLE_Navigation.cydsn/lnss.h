@@ -90,6 +90,18 @@ typedef struct
     CYBLE_DATE_TIME_T utcTime; /* UTC Time */
 }CYBLE_LNS_LS_T;
 
+/* Fields of the Location and Speed, see pdu.h */
+#define LNS_LS_FIELDS(FIELD) \
+    FIELD(0u,                       0u,                     FLAGS16,    flags) \
+    FIELD(CYBLE_LNS_LS_FLG_IS,      CYBLE_LNS_LS_FLG_IS,    U16,        instSpd) \
+    FIELD(CYBLE_LNS_LS_FLG_TD,      CYBLE_LNS_LS_FLG_TD,    U24,        totalDst) \
+    FIELD(CYBLE_LNS_LS_FLG_LC,      CYBLE_LNS_LS_FLG_LC,    U32,        latitude) \
+    FIELD(CYBLE_LNS_LS_FLG_LC,      CYBLE_LNS_LS_FLG_LC,    U32,        longitude) \
+    FIELD(CYBLE_LNS_LS_FLG_EL,      CYBLE_LNS_LS_FLG_EL,    S24,        elevation) \
+    FIELD(CYBLE_LNS_LS_FLG_HD,      CYBLE_LNS_LS_FLG_HD,    U16,        heading) \
+    FIELD(CYBLE_LNS_LS_FLG_RT,      CYBLE_LNS_LS_FLG_RT,    U8,         rollTime) \
+    FIELD(CYBLE_LNS_LS_FLG_UTC,     CYBLE_LNS_LS_FLG_UTC,   DT,         utcTime)
+
 /* Opcode of Record Access Control Point characteristic value type */
 typedef enum
 {
@@ -165,6 +177,15 @@ typedef struct
     CYBLE_DATE_TIME_T eaTime; /* Estimated Time of Arrival */
 }CYBLE_LNS_NV_T;
 
+/* Fields of the Navigation, see pdu.h */
+#define LNS_NV_FIELDS(FIELD) \
+    FIELD(0u,                       0u,                     FLAGS16,    flags) \
+    FIELD(0u,                       0u,                     U16,        bearing) \
+    FIELD(0u,                       0u,                     U16,        heading) \
+    FIELD(CYBLE_LNS_NV_FLG_RD,      CYBLE_LNS_NV_FLG_RD,    U24,        rDst) \
+    FIELD(CYBLE_LNS_NV_FLG_RVD,     CYBLE_LNS_NV_FLG_RVD,   S24,        rvDst) \
+    FIELD(CYBLE_LNS_NV_FLG_EAT,     CYBLE_LNS_NV_FLG_EAT,   DT,         eaTime)
+
 
 /***************************************
 *      Function prototypes
@@ -329,6 +329,7 @@ CY_ISR(Timer_Interrupt)
     
     /* Indicate that timer is raised to main loop */
     mainTimer++;
+    NTF_STAT_TICK();
 
     /* Blink green LED to indicate that device advertises */
     if(CyBle_GetState() == CYBLE_STATE_ADVERTISING)
@@ -505,6 +506,7 @@ int main()
                 *  Periodically sends LNS notifications to the Client.		?
                 *******************************************************************/
                 LnsNtf();
+                NTF_STAT_PROCESS();
                 
 				
                 /*******************************************************************
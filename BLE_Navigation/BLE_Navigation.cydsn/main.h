@@ -21,10 +21,12 @@
 #include <stdio.h>
     
 #include "debug.h"
+#include "pdu.h"
     
 /* Profile specific includes */
 #include "bas.h"
 #include "lnss.h"
+#include "ntfstat.h"
 
 
 #define LED_ON                      (0u)
@@ -0,0 +1,119 @@
+/*******************************************************************************
+* File Name: pdu.h
+*
+* Version 1.0
+*
+* Description:
+*  Contains the field table serializer of the characteristic values.
+*
+*  A characteristic value is described by a field table: an X-macro that
+*  lists its fields in the PDU order, each as
+*
+*      FIELD(mask, set, kind, member)
+*
+*  The field is present in the PDU when (flags & mask) == set, so 0u, 0u is
+*  used for the mandatory fields. The kind is the field format in the PDU,
+*  the member is the field of the value structure. PDU_DEFINE_PACK() expands
+*  a table into a function that has one straight-line store per field, with
+*  the field offsets and sizes resolved at compile time. Adding a field is
+*  adding a table entry.
+*
+*  The serializer only depends on cytypes.h, so it is also built on the host.
+*
+* Hardware Dependency:
+*  CY8CKIT-042 BLE
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(PDU_H)
+#define PDU_H
+
+#include "cytypes.h"
+
+
+/***************************************
+*        Field Kinds
+***************************************/
+/* Sizes of the field kinds in the PDU */
+#define PDU_SIZE_FLAGS8                     (1u)    /* The flags argument, 1 byte */
+#define PDU_SIZE_FLAGS16                    (2u)    /* The flags argument, 2 bytes */
+#define PDU_SIZE_U8                         (1u)
+#define PDU_SIZE_U16                        (2u)    /* Also sint16 and SFLOAT */
+#define PDU_SIZE_U24                        (3u)    /* Low 3 bytes of a uint32 */
+#define PDU_SIZE_S24                        (3u)    /* Low 3 bytes of an int32 */
+#define PDU_SIZE_U32                        (4u)
+#define PDU_SIZE_DT                         (7u)    /* CYBLE_DATE_TIME_T */
+
+/* Little-endian stores: p - the PDU position, v - the value, f - the flags */
+#define PDU_PUT_FLAGS8(p, v, f)             PDU_PUT_U8((p), (f), (f))
+#define PDU_PUT_FLAGS16(p, v, f)            PDU_PUT_U16((p), (f), (f))
+#define PDU_PUT_U8(p, v, f) \
+    do { \
+        (p)[0u] = (uint8)(v); \
+    } while(0)
+#define PDU_PUT_U16(p, v, f) \
+    do { \
+        (p)[0u] = (uint8)(v); \
+        (p)[1u] = (uint8)((uint32)(v) >> 8u); \
+    } while(0)
+#define PDU_PUT_U24(p, v, f) \
+    do { \
+        (p)[0u] = (uint8)(v); \
+        (p)[1u] = (uint8)((uint32)(v) >> 8u); \
+        (p)[2u] = (uint8)((uint32)(v) >> 16u); \
+    } while(0)
+#define PDU_PUT_S24(p, v, f)                PDU_PUT_U24((p), (v), (f))
+#define PDU_PUT_U32(p, v, f) \
+    do { \
+        (p)[0u] = (uint8)(v); \
+        (p)[1u] = (uint8)((uint32)(v) >> 8u); \
+        (p)[2u] = (uint8)((uint32)(v) >> 16u); \
+        (p)[3u] = (uint8)((uint32)(v) >> 24u); \
+    } while(0)
+#define PDU_PUT_DT(p, v, f) \
+    do { \
+        PDU_PUT_U16((p), (v).year, (f)); \
+        (p)[2u] = (v).month; \
+        (p)[3u] = (v).day; \
+        (p)[4u] = (v).hours; \
+        (p)[5u] = (v).minutes; \
+        (p)[6u] = (v).seconds; \
+    } while(0)
+
+
+/***************************************
+*        Generators
+***************************************/
+#define PDU_PACK_FIELD(mask, set, kind, member) \
+    if((flags & (mask)) == (set)) \
+    { \
+        PDU_PUT_##kind(ptr, value->member, flags); \
+        ptr += PDU_SIZE_##kind; \
+    }
+
+/*******************************************************************************
+* PDU_DEFINE_PACK(name, type, FIELDS) defines:
+*
+*   static uint8 name(uint8 pdu[], const type *value, uint32 flags)
+*
+* Packs the fields of the value selected by the flags, the flags are also
+* the value of the FLAGS8 or FLAGS16 field. Returns the PDU length. The PDU
+* buffer must fit all the fields of the table.
+*******************************************************************************/
+#define PDU_DEFINE_PACK(name, type, FIELDS) \
+    static uint8 name(uint8 pdu[], const type *value, uint32 flags) \
+    { \
+        uint8 *ptr = pdu; \
+        FIELDS(PDU_PACK_FIELD) \
+        return((uint8)(ptr - pdu)); \
+    }
+
+
+#endif /* PDU_H */
+
+/* [] END OF FILE */
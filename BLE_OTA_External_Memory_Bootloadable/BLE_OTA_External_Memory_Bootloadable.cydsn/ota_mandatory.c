@@ -54,6 +54,13 @@ uint16 appExtMemChecksum = 0u;
 
 uint8 emiWriteBuffer[EMI_SIZE_OF_WRITE_BUFFER];
 
+static EMI_PAGE_SLOT_T emiSlot[EMI_PAGE_SLOTS];
+static uint8 emiSlotHead = 0u;                  /* Slot of the page being written */
+static uint8 emiSlotCount = 0u;                 /* Number of queued pages */
+static uint8 emiState = EMI_STATE_IDLE;
+static uint16 emiPollCount = 0u;
+static cystatus emiWriteStatus = CYRET_SUCCESS; /* Failure of any page since the last flush */
+
 
 /*******************************************************************************
 * Function Name: EMI_Start
@@ -74,12 +81,79 @@ void EMI_Start(void)
 }
 
 
+/*******************************************************************************
+* Function Name: EMI_Transfer
+********************************************************************************
+*
+* Summary:
+*  Writes a buffer to the external memory and waits until the transfer is
+*  complete.
+*
+* Parameters:
+*  uint8 i2cAddr: The slave address of the memory block.
+*  uint8 *buf:    Address bytes followed by the data.
+*  uint32 size:   Number of bytes to transfer.
+*
+* Return:
+*  Status
+*     Value               Description
+*    CYRET_SUCCESS           Successful
+*    Other non-zero          Failure
+*******************************************************************************/
+static cystatus EMI_Transfer(uint8 i2cAddr, uint8 *buf, uint32 size)
+{
+    cystatus status = CYRET_UNKNOWN;
+
+    (void) EMI_I2CM_I2CMasterWriteBuf(i2cAddr, buf, size, EMI_I2CM_I2C_MODE_COMPLETE_XFER);
+
+    while(0u == (EMI_I2CM_I2CMasterStatus() & EMI_I2CM_I2C_MSTAT_WR_CMPLT))
+    {
+        /* Wait until master complete write */
+    }
+
+    if (0u == (EMI_I2CM_I2C_MSTAT_ERR_XFER & EMI_I2CM_I2CMasterStatus()))
+    {
+        status = CYRET_SUCCESS;
+    }
+
+    /* Clear I2C master status */
+    (void) EMI_I2CM_I2CMasterClearStatus();
+
+    return (status);
+}
+
+
+/*******************************************************************************
+* Function Name: EMI_Drain
+********************************************************************************
+*
+* Summary:
+*  Waits until all queued pages are programmed. The failures stay in
+*  emiWriteStatus for EMI_Flush().
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*******************************************************************************/
+static void EMI_Drain(void)
+{
+    while (0u != emiSlotCount)
+    {
+        EMI_Process();
+    }
+}
+
+
 /*******************************************************************************
 * Function Name: EMI_SetPointer
 ********************************************************************************
 *
 * Summary:
-*  Sets the internal pointer of the external memory.
+*  Sets the internal pointer of the external memory. Waits until all queued
+*  pages are programmed first, their failures are still reported by
+*  EMI_Flush().
 *
 * Parameters:
 *  uint32 dataAddr:
@@ -93,17 +167,213 @@ void EMI_Start(void)
 *******************************************************************************/
 cystatus EMI_SetPointer(uint32 dataAddr)
 {
-    uint32 status = CYRET_UNKNOWN;
-    status =  EMI_WriteData(dataAddr, EMI_NO_DATA_SIZE, NULL);
+    uint8 i2cAddr = (dataAddr > EMI_HIGHEST_ADDR_OF_LOW_BLOCK) ?
+                        EMI_I2C_SLAVE_ADDR_HIGH_64K :
+                        EMI_I2C_SLAVE_ADDR_LOW_64K;
+
+    EMI_Drain();
+
+    emiWriteBuffer[EMI_DATA_ADDR_MSB_INDX] = (uint8) (dataAddr >> 8u);
+    emiWriteBuffer[EMI_DATA_ADDR_LSB_INDX] = (uint8) dataAddr;
+
+    return (EMI_Transfer(i2cAddr, emiWriteBuffer, EMI_ADDR_SIZE));
+}
+
+
+/*******************************************************************************
+* Function Name: EMI_StartPage
+********************************************************************************
+*
+* Summary:
+*  Starts the transfer of the oldest queued page. Once its data is sent, the
+*  memory starts the internal write cycle.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*******************************************************************************/
+static void EMI_StartPage(void)
+{
+    EMI_PAGE_SLOT_T *slot = &emiSlot[emiSlotHead];
+
+    (void) EMI_I2CM_I2CMasterClearStatus();
+    (void) EMI_I2CM_I2CMasterWriteBuf(slot->i2cAddr,
+                                      slot->buf,
+                                      (uint32) slot->size + EMI_DATA_INDX,
+                                      EMI_I2CM_I2C_MODE_COMPLETE_XFER);
+    emiState = EMI_STATE_WRITE;
+    emiPollCount = 0u;
+}
+
+
+/*******************************************************************************
+* Function Name: EMI_Process
+********************************************************************************
+*
+* Summary:
+*  Advances the page write pipeline without blocking. While a page is
+*  programmed, the memory does not acknowledge its address, so the address
+*  bytes are written repeatedly until it does. Then the page slot is released
+*  and the next queued page is started. Should be called while waiting for
+*  the host.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*******************************************************************************/
+void EMI_Process(void)
+{
+    EMI_PAGE_SLOT_T *slot = &emiSlot[emiSlotHead];
+    uint32 mstat;
+    uint8 done = 0u;
+
+    if (EMI_STATE_IDLE == emiState)
+    {
+        if (0u != emiSlotCount)
+        {
+            EMI_StartPage();
+        }
+    }
+    else
+    {
+        mstat = EMI_I2CM_I2CMasterStatus();
+
+        if (0u != (mstat & EMI_I2CM_I2C_MSTAT_WR_CMPLT))
+        {
+            (void) EMI_I2CM_I2CMasterClearStatus();
+
+            if ((EMI_STATE_WRITE == emiState) && (0u != (mstat & EMI_I2CM_I2C_MSTAT_ERR_XFER)))
+            {
+                emiWriteStatus = CYRET_UNKNOWN;
+                done = 1u;
+            }
+            else if ((EMI_STATE_POLL == emiState) &&
+                     (0u == (mstat & EMI_I2CM_I2C_MSTAT_ERR_ADDR_NAK)))
+            {
+                /* Write cycle is complete */
+                if (0u != (mstat & EMI_I2CM_I2C_MSTAT_ERR_XFER))
+                {
+                    emiWriteStatus = CYRET_UNKNOWN;
+                }
+                done = 1u;
+            }
+            else if (emiPollCount >= EMI_ACK_POLL_MAX)
+            {
+                emiWriteStatus = CYRET_TIMEOUT;
+                done = 1u;
+            }
+            else
+            {
+                /* Poll with the address bytes only */
+                emiState = EMI_STATE_POLL;
+                emiPollCount++;
+                (void) EMI_I2CM_I2CMasterWriteBuf(slot->i2cAddr,
+                                                  slot->buf,
+                                                  EMI_ADDR_SIZE,
+                                                  EMI_I2CM_I2C_MODE_COMPLETE_XFER);
+            }
+        }
+
+        if (0u != done)
+        {
+            emiSlotHead = (emiSlotHead + 1u) % EMI_PAGE_SLOTS;
+            emiSlotCount--;
+            emiState = EMI_STATE_IDLE;
+
+            if (0u != emiSlotCount)
+            {
+                EMI_StartPage();
+            }
+        }
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: EMI_Flush
+********************************************************************************
+*
+* Summary:
+*  Waits until all queued pages are programmed.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  Status
+*     Value               Description
+*    CYRET_SUCCESS           All pages written since the last flush are
+*                            programmed
+*    Other non-zero          Failure
+*******************************************************************************/
+cystatus EMI_Flush(void)
+{
+    cystatus status;
+
+    EMI_Drain();
+
+    status = emiWriteStatus;
+    emiWriteStatus = CYRET_SUCCESS;
+
     return (status);
 }
 
+
+/*******************************************************************************
+* Function Name: EMI_IsBusy
+********************************************************************************
+*
+* Summary:
+*  Checks whether there are pages that are not programmed yet.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  Non-zero if EMI_Process() has work to do.
+*******************************************************************************/
+uint8 EMI_IsBusy(void)
+{
+    return (emiSlotCount);
+}
+
+
+/*******************************************************************************
+* Function Name: EMI_GetWriteStatus
+********************************************************************************
+*
+* Summary:
+*  Returns the failure of the writes since the last flush without waiting for
+*  the queued pages.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  Status
+*     Value               Description
+*    CYRET_SUCCESS           No page has failed so far
+*    Other non-zero          Failure
+*******************************************************************************/
+cystatus EMI_GetWriteStatus(void)
+{
+    return (emiWriteStatus);
+}
+
+
 /*******************************************************************************
 * Function Name: EMI_WriteData
 ********************************************************************************
 *
 * Summary:
-*  Write data to the external memory.
+*  Write data to the external memory. The data is split into memory pages,
+*  which are queued for programming, so the function only waits when both
+*  page slots are in use. Use EMI_Flush() to wait for the data to be
+*  programmed.
 *
 * Parameters:
 *  uint32 dataAddr:
@@ -117,35 +387,32 @@ cystatus EMI_SetPointer(uint32 dataAddr)
 *  Status
 *     Value               Description
 *    CYRET_SUCCESS           Successful
-*    Other non-zero          Failure
+*    Other non-zero          Failure of this or a previously queued page, also
+*                            reported by EMI_Flush()
 *******************************************************************************/
 cystatus EMI_WriteData(uint32 dataAddr, uint32 dataSize, uint8 *data)
 {
-    uint32 i;
-    uint32 status = CYRET_UNKNOWN;
-    uint8 i2cAddr = (dataAddr > EMI_HIGHEST_ADDR_OF_LOW_BLOCK) ?
-                        EMI_I2C_SLAVE_ADDR_HIGH_64K :
-                        EMI_I2C_SLAVE_ADDR_LOW_64K;
+    EMI_PAGE_SLOT_T *slot;
+    const uint8 *src = data;
+    uint32 chunk;
 
-	emiWriteBuffer[EMI_DATA_ADDR_MSB_INDX] = (uint8) (dataAddr >> 8u);
-	emiWriteBuffer[EMI_DATA_ADDR_LSB_INDX] = (uint8) dataAddr;
-    
     #if (ENCRYPTION_ENABLED == YES)
         if (dataAddr >= (META_DATA_ADDR + META_DATA_SIZE) && (dataSize>0))
         {
             uint8 key[KEY_LENGTH] = {0};
             uint8 nonce[NONCE_LENGTH] = {0};
-            uint8 encrypted[ENC_BUFFER_SIZE] = {0};
             uint8 out_mic[MIC_DATA_LENGTH];
             CYBLE_API_RESULT_T result;
             
             CR_ReadKey(key);
             CR_ReadNonce(nonce);
-            result = CR_Encrypt(data, dataSize, key, nonce, encrypted, out_mic);
+
+            /* The staging buffer is free: the pages keep their own copies */
+            result = CR_Encrypt(data, dataSize, key, nonce, emiWriteBuffer, out_mic);
             
             if (result == CYBLE_ERROR_OK)
             {
-                memcpy(data, encrypted, dataSize);
+                src = emiWriteBuffer;
             }
             else
             {
@@ -163,37 +430,47 @@ cystatus EMI_WriteData(uint32 dataAddr, uint32 dataSize, uint8 *data)
                     DBG_PRINT_TEXT("=\r\n");
                     DBG_PRINT_TEXT("===============================================================================\r\n");                    
                 }
+                emiWriteStatus = CYRET_BAD_DATA;
                 return (result);
             }
             
         }
     #endif /* (ENCRYPTION_ENABLED == YES) */
     
-    for (i = 0; i < dataSize; i++)
-    {        
-        emiWriteBuffer[EMI_DATA_INDX + i] = data[i];   
-    }
-
-	/* Write memory address bytes alone to initialize the pointer */
-	(void) EMI_I2CM_I2CMasterWriteBuf( i2cAddr,
-							    (uint8 *) emiWriteBuffer,
-	                            dataSize + EMI_DATA_INDX,
-	                            EMI_I2CM_I2C_MODE_COMPLETE_XFER);
+    while (dataSize > 0u)
+    {
+        /* A page write must not cross the page boundary */
+        chunk = EMI_EXTERNAL_MEMORY_PAGE_SIZE - (dataAddr % EMI_EXTERNAL_MEMORY_PAGE_SIZE);
+        if (chunk > dataSize)
+        {
+            chunk = dataSize;
+        }
 
-	while(0u == (EMI_I2CM_I2CMasterStatus() & EMI_I2CM_I2C_MSTAT_WR_CMPLT))
-	{
-	    /* Wait until master complete write */
-	}
+        while (EMI_PAGE_SLOTS == emiSlotCount)
+        {
+            /* Wait until the oldest page is programmed */
+            EMI_Process();
+        }
 
-    if (0u == (EMI_I2CM_I2C_MSTAT_ERR_XFER & EMI_I2CM_I2CMasterStatus()))
-    {
-        status = CYRET_SUCCESS;
+        slot = &emiSlot[(emiSlotHead + emiSlotCount) % EMI_PAGE_SLOTS];
+        slot->i2cAddr = (dataAddr > EMI_HIGHEST_ADDR_OF_LOW_BLOCK) ?
+                            EMI_I2C_SLAVE_ADDR_HIGH_64K :
+                            EMI_I2C_SLAVE_ADDR_LOW_64K;
+        slot->size = (uint8) chunk;
+        slot->buf[EMI_DATA_ADDR_MSB_INDX] = (uint8) (dataAddr >> 8u);
+        slot->buf[EMI_DATA_ADDR_LSB_INDX] = (uint8) dataAddr;
+        (void) memcpy(&slot->buf[EMI_DATA_INDX], src, chunk);
+        emiSlotCount++;
+
+        /* Start the page at once if the memory is idle */
+        EMI_Process();
+
+        dataAddr += chunk;
+        dataSize -= chunk;
+        src += chunk;
     }
 
-	/* Clear I2C master status */
-	(void) EMI_I2CM_I2CMasterClearStatus();
-
-    return (status);
+    return (emiWriteStatus);
 }
 
 
@@ -256,13 +533,14 @@ cystatus EMI_ReadData(uint32 dataAddr, uint32 dataSize, uint8 *data)
         {
             uint8 key[KEY_LENGTH] = {0};
             uint8 nonce[NONCE_LENGTH] = {0};
-            uint8 decrypted[ENC_BUFFER_SIZE] = {0};
             uint8 out_mic[MIC_DATA_LENGTH]={0};
             CYBLE_API_RESULT_T result;
             
             CR_ReadKey(key);
             CR_ReadNonce(nonce);
-            result = CR_Decrypt(data, dataSize, key, nonce, decrypted, out_mic);
+
+            /* No pages are queued after EMI_SetPointer(), so the staging buffer is free */
+            result = CR_Decrypt(data, dataSize, key, nonce, emiWriteBuffer, out_mic);
             /* Invalid MIC_AUTH not checked  as it will consume additional memory and 
                was not required.*/
             if (result == CYBLE_ERROR_INVALID_PARAMETER)
@@ -272,7 +550,7 @@ cystatus EMI_ReadData(uint32 dataAddr, uint32 dataSize, uint8 *data)
             }
             else
             {
-                memcpy(data, decrypted, dataSize);
+                memcpy(data, emiWriteBuffer, dataSize);
             }                                            
         }
     #endif /* (ENCRYPTION_ENABLED == YES) */
@@ -316,12 +594,12 @@ cystatus EMI_ReadData(uint32 dataAddr, uint32 dataSize, uint8 *data)
 cystatus EMI_EraseAll(void)
 {
     /* Ersase content of the external memory */
-    cystatus status;
+    cystatus status = CYRET_SUCCESS;
     uint8  erase[CY_FLASH_SIZEOF_ROW] = {0u};
     uint8  tmp[CY_FLASH_SIZEOF_ROW];
     uint16 row;
 
-    for (row = 0; row < CY_FLASH_NUMBER_ROWS; row++)
+    for (row = 0; (row < CY_FLASH_NUMBER_ROWS) && (CYRET_SUCCESS == status); row++)
     {
         /* Read flash row data from external memory */
         
@@ -330,7 +608,8 @@ cystatus EMI_EraseAll(void)
         DBG_PRINT_ARRAY(tmp, CY_FLASH_SIZEOF_ROW);
         DBG_PRINT_TEXT("\r\n");               
 
-        status = EMI_WriteData(EMI_APP_ABS_ADDR(row) , CY_FLASH_SIZEOF_ROW, erase);
+        (void) EMI_WriteData(EMI_APP_ABS_ADDR(row) , CY_FLASH_SIZEOF_ROW, erase);
+        status = EMI_Flush();
 
         (void) EMI_ReadData(EMI_APP_ABS_ADDR(row) , CY_FLASH_SIZEOF_ROW, tmp);                                
         DBG_PRINT_TEXT("\t\t After Erase: ");
@@ -365,43 +644,10 @@ static uint16 BootloaderEmulator_CalcPacketChecksum(const uint8 buffer[], uint16
 {
     #if(0u != BootloaderEmulator_PACKET_CHECKSUM_CRC)
 
-        uint16 CYDATA crc = BootloaderEmulator_CRC_CCITT_INITIAL_VALUE;
-        uint16 CYDATA tmp;
-        uint8  CYDATA i;
-        uint16 CYDATA tmpIndex = size;
-
-        if(0u == size)
-        {
-            crc = ~crc;
-        }
-        else
-        {
-            do
-            {
-                tmp = buffer[tmpIndex - size];
-
-                for (i = 0u; i < 8u; i++)
-                {
-                    if (0u != ((crc & 0x0001u) ^ (tmp & 0x0001u)))
-                    {
-                        crc = (crc >> 1u) ^ BootloaderEmulator_CRC_CCITT_POLYNOMIAL;
-                    }
-                    else
-                    {
-                        crc >>= 1u;
-                    }
-
-                    tmp >>= 1u;
-                }
-
-                size--;
-            }
-            while(0u != size);
+        uint16 CYDATA crc;
 
-            crc = ~crc;
-            tmp = crc;
-            crc = ( uint16 )(crc << 8u) | (tmp >> 8u);
-        }
+        crc = (uint16)~Crc16Update(BootloaderEmulator_CRC_CCITT_INITIAL_VALUE, buffer, size);
+        crc = ( uint16 )(crc << 8u) | (crc >> 8u);
 
         return(crc);
 
@@ -421,57 +667,6 @@ static uint16 BootloaderEmulator_CalcPacketChecksum(const uint8 buffer[], uint16
 }
 
 
-/*******************************************************************************
-* Function Name: BootloaderEmulator_Calc8BitSum
-********************************************************************************
-*
-* Summary:
-*  This computes the 8 bit sum for the provided number of bytes contained in
-*  FRAM.
-*
-* Parameters:
-* rowNum :
-*   Flash row number as located in the external memory.
-*
-* Returns:
-*   The 8 bit sum for the provided data.
-*
-*******************************************************************************/
-uint32 BootloaderEmulator_Calc8BitSum(uint32 rowNum)
-{
-    uint32 sum = 0u;
-    uint8 flashRowFromExtMem[CY_FLASH_SIZEOF_ROW];
-    uint32 size = CY_FLASH_SIZEOF_ROW;
-
-    (void) EMI_ReadData(EMI_APP_ABS_ADDR(rowNum), CY_FLASH_SIZEOF_ROW, flashRowFromExtMem);
-
-    DBG_PRINT_TEXT("\r\n");
-    DBG_PRINT_TEXT("BootloaderEmulator:\r\n");
-    DBG_PRINT_TEXT("\tBootloaderEmulator_Calc8BitSum():\r\n");
-
-    DBG_PRINT_TEXT("\t\trowNum  = ");
-    DBG_PRINT_DEC( (uint16) rowNum);
-    DBG_PRINT_TEXT("\r\n");
-
-    DBG_PRINT_TEXT("\t\tEMI_APP_ABS_ADDR(rowNum)  = ");
-    DBG_PRINT_HEX(EMI_APP_ABS_ADDR((uint16)rowNum));
-    DBG_PRINT_TEXT("\r\n");
-
-    DBG_PRINT_TEXT("\t\tEMI_ReadData():\r\n");
-    DBG_PRINT_ARRAY(flashRowFromExtMem, size);
-    DBG_PRINT_TEXT("\r\n");
-
-
-    while (size > 0u)
-    {
-        size--;
-        sum += flashRowFromExtMem[size];
-    }
-
-    return(sum);
-}
-
-
 /*******************************************************************************
 * Function Name: BootloaderEmulator_Start
 ********************************************************************************
@@ -555,7 +750,15 @@ cystatus BootloaderEmulator_ValidateBootloadable(void)
 
     cystatus status = CYRET_SUCCESS;
 
-    if (0u != appSizeInRows)
+    /* The reads flush the queue and drop its status, so a failed page is taken here */
+    if (CYRET_SUCCESS != EMI_Flush())
+    {
+        status = CYRET_BAD_DATA;
+        DBG_PRINT_TEXT("\r\n");
+        DBG_PRINT_TEXT("Error: External memory write failed.");
+        DBG_PRINT_TEXT("\r\n");
+    }
+    else if (0u != appSizeInRows)
     {
         /* Get bootloadable application checksum from external memory */
         (void) EMI_ReadData(EMI_APP_ABS_ADDR(appSizeInRows - 1u), CY_FLASH_SIZEOF_ROW, appFlashRow);
@@ -646,6 +849,8 @@ static void BootloaderEmulator_HostLink(uint8 timeOut)
     uint16    CYDATA pktSize    = 0u;
     uint16    CYDATA dataOffset = 0u;
     uint8     CYDATA timeOutCnt = 10u;
+    uint8     CYDATA rowChecksum = 0u;
+    cystatus  CYDATA rowStatus = CYRET_SUCCESS;    /* Status of the last programmed row */
 
     #if(0u != BootloaderEmulator_FAST_APP_VALIDATION)
         uint8 CYDATA clearedMetaData = 0u;
@@ -668,13 +873,25 @@ static void BootloaderEmulator_HostLink(uint8 timeOut)
 
         do
         {
-            readStat = CyBtldrCommRead(packetBuffer,
-                                        BootloaderEmulator_SIZEOF_COMMAND_BUFFER,
-                                        &numberRead,
-                                        (0u == timeOut) ? 0xFFu : timeOut);
-            if (0u != timeOut)
+            if (0u != EMI_IsBusy())
+            {
+                /* Program the queued pages while waiting for the next packet */
+                EMI_Process();
+                readStat = CyBtldrCommRead(packetBuffer,
+                                            BootloaderEmulator_SIZEOF_COMMAND_BUFFER,
+                                            &numberRead,
+                                            EMI_BUSY_READ_TIMEOUT);
+            }
+            else
             {
-                timeOutCnt--;
+                readStat = CyBtldrCommRead(packetBuffer,
+                                            BootloaderEmulator_SIZEOF_COMMAND_BUFFER,
+                                            &numberRead,
+                                            (0u == timeOut) ? 0xFFu : timeOut);
+                if (0u != timeOut)
+                {
+                    timeOutCnt--;
+                }
             }
 
         } while ( (0u != timeOutCnt) && (readStat != CYRET_SUCCESS) );
@@ -837,6 +1054,8 @@ static void BootloaderEmulator_HostLink(uint8 timeOut)
                         uint16 row;
                         uint32 size = CY_FLASH_SIZEOF_ROW;
 
+                        rowStatus = CYRET_SUCCESS;
+
                         /* Save 1st bootloadable application flash row number to the metadata in external memory */
                         if (appSizeInRows == 0u)
                         {
@@ -868,7 +1087,7 @@ static void BootloaderEmulator_HostLink(uint8 timeOut)
                             DBG_PRINT_ARRAY(tmp, CY_FLASH_SIZEOF_ROW);
                             DBG_PRINT_TEXT("\r\n");
 
-                            (void) EMI_WriteData(EMI_MD_BASE_ADDR , CY_FLASH_SIZEOF_ROW, erase);
+                            rowStatus = EMI_WriteData(EMI_MD_BASE_ADDR , CY_FLASH_SIZEOF_ROW, erase);
 
                             #if (DEBUG_UART_ENABLED == YES)
                                 (void) EMI_ReadData(EMI_MD_BASE_ADDR, CY_FLASH_SIZEOF_ROW, tmp);
@@ -880,15 +1099,22 @@ static void BootloaderEmulator_HostLink(uint8 timeOut)
 
 
                         /* External memory application checksum calculation */
+                        rowChecksum = 0u;
                         while (size > 0u)
                         {
                             size--;
                             appExtMemChecksum += dataBuffer[size];
+                            rowChecksum += dataBuffer[size];
                         }
 
 
-                        /* Write row to the external memory */
-                        (void) EMI_WriteData(EMI_APP_ABS_ADDR(appSizeInRows), CY_FLASH_SIZEOF_ROW, dataBuffer);
+                        /* Write row to the external memory. The row is queued, a failure of
+                           its pages is reported by the next Program Row or Verify Row. */
+                        if (CYRET_SUCCESS == rowStatus)
+                        {
+                            rowStatus = EMI_WriteData(EMI_APP_ABS_ADDR(appSizeInRows), CY_FLASH_SIZEOF_ROW,
+                                                      dataBuffer);
+                        }
                         appSizeInRows++;
 
 
@@ -903,7 +1129,7 @@ static void BootloaderEmulator_HostLink(uint8 timeOut)
                         DBG_PRINT_HEX(appSizeInRows - 1u);
                         DBG_PRINT_TEXT("\r\n");
 
-                        ackCode = CYRET_SUCCESS;
+                        ackCode = (CYRET_SUCCESS == rowStatus) ? CYRET_SUCCESS : BootloaderEmulator_ERR_ROW;
 
                     }
                     else
@@ -1034,13 +1260,20 @@ static void BootloaderEmulator_HostLink(uint8 timeOut)
 
                 if((BootloaderEmulator_COMMUNICATION_STATE_ACTIVE == communicationState) && (pktSize == 3u))
                 {
-                    uint8 CYDATA checksum;
-
-                    checksum = BootloaderEmulator_Calc8BitSum(appSizeInRows - 1u);
-
-                    packetBuffer[BootloaderEmulator_DATA_ADDR] = (uint8)1u + (uint8)(~checksum);
-                    ackCode = CYRET_SUCCESS;
-                    rspSize = 1u;
+                    /* The row may still be programmed, so its checksum is taken from
+                       the received data rather than read back, and the pages failed so
+                       far are reported. The whole image is read back by
+                       BootloaderEmulator_ValidateBootloadable(). */
+                    if ((CYRET_SUCCESS == rowStatus) && (CYRET_SUCCESS == EMI_GetWriteStatus()))
+                    {
+                        packetBuffer[BootloaderEmulator_DATA_ADDR] = (uint8)1u + (uint8)(~rowChecksum);
+                        ackCode = CYRET_SUCCESS;
+                        rspSize = 1u;
+                    }
+                    else
+                    {
+                        ackCode = BootloaderEmulator_ERR_VERIFY;
+                    }
 
                     DBG_PRINT_TEXT("\r\n");
                     DBG_PRINT_TEXT("BootloaderEmulator:\r\n");
@@ -1093,6 +1326,13 @@ static void BootloaderEmulator_HostLink(uint8 timeOut)
 
 
                 (void) EMI_WriteData(EMI_MD_BASE_ADDR, CY_FLASH_SIZEOF_ROW, metadata);
+                if (CYRET_SUCCESS != EMI_Flush())
+                {
+                    /* Keep the application running, the host may retry the exit */
+                    DBG_PRINT_TEXT("\t\tMetadata write failed.\r\n");
+                    ackCode = BootloaderEmulator_ERR_UNK;
+                    break;
+                }
 
 
                 DBG_PRINT_TEXT("\t\tApplication Status: 0x");
@@ -270,6 +270,11 @@ cystatus CyBtldrCommRead(uint8* buffer, uint16 size, uint16* count, uint8 timeOu
                 (void) EMI_ReadData(EMI_MD_BASE_ADDR, CY_FLASH_SIZEOF_ROW , metadata);
                 metadata[EMI_MD_APP_STATUS_ADDR] = EMI_MD_APP_STATUS_LOADED;
                 (void) EMI_WriteData(EMI_MD_BASE_ADDR, CY_FLASH_SIZEOF_ROW , metadata);
+                if (CYRET_SUCCESS != EMI_Flush())
+                {
+                    /* The application is programmed, it is copied again after the next reset */
+                    DBG_PRINT_TEXT("\t\tMetadata write failed.\r\n");
+                }
 
                 /* Generate Exit Bootloader Command */
                 buffer[CI_CMD_ADDR] = CI_COMMAND_EXIT;
@@ -419,43 +424,10 @@ static uint16 CI_CalcPacketChecksum(const uint8 buffer[], uint16 size)
 {
     #if(0u != CI_PACKET_CHECKSUM_CRC)
 
-        uint16 crc = CI_CRC_CCITT_INITIAL_VALUE;
-        uint16 tmp;
-        uint8  i;
-        uint16 tmpIndex = size;
-
-        if(0u == size)
-        {
-            crc = ~crc;
-        }
-        else
-        {
-            do
-            {
-                tmp = buffer[tmpIndex - size];
-
-                for (i = 0u; i < 8u; i++)
-                {
-                    if (0u != ((crc & 0x0001u) ^ (tmp & 0x0001u)))
-                    {
-                        crc = (crc >> 1u) ^ CI_CRC_CCITT_POLYNOMIAL;
-                    }
-                    else
-                    {
-                        crc >>= 1u;
-                    }
-
-                    tmp >>= 1u;
-                }
+        uint16 crc;
 
-                size--;
-            }
-            while(0u != size);
-
-            crc = ~crc;
-            tmp = crc;
-            crc = ( uint16 )(crc << 8u) | (tmp >> 8u);
-        }
+        crc = (uint16)~Crc16Update(CI_CRC_CCITT_INITIAL_VALUE, buffer, size);
+        crc = ( uint16 )(crc << 8u) | (crc >> 8u);
 
         return(crc);
 
@@ -26,6 +26,7 @@
 #include "cytypes.h"
 #include "CyFlash.h"
 #include "ota_optional.h"
+#include "crc16.h"
 
 #define BootloaderEmulator_activeApp      (BootloaderEmulator_MD_BTLDB_ACTIVE_0)
 
@@ -38,6 +39,10 @@ cystatus EMI_SetPointer(uint32 dataAddr);
 cystatus EMI_EraseAll(void);
 cystatus EMI_WriteData(uint32 dataAddr, uint32 dataSize, uint8 *data);
 cystatus EMI_ReadData (uint32 dataAddr, uint32 dataSize, uint8 *data);
+void EMI_Process(void);
+cystatus EMI_Flush(void);
+uint8 EMI_IsBusy(void);
+cystatus EMI_GetWriteStatus(void);
 
 
 #define ENC_BUFFER_SIZE (300)
@@ -64,6 +69,26 @@ cystatus EMI_ReadData (uint32 dataAddr, uint32 dataSize, uint8 *data);
 #define EMI_NO_DATA_SIZE                    (0u)
 #define EMI_EXTERNAL_MEMORY_PAGE_SIZE       (64u)
 
+/* Page write pipeline. One page is filled while the other is programmed. */
+#define EMI_PAGE_SLOTS                      (2u)
+#define EMI_ACK_POLL_MAX                    (1000u) /* Polls before a write cycle is considered failed */
+#define EMI_BUSY_READ_TIMEOUT               (1u)    /* Host read timeout while pages are programmed, 10s of ms */
+
+#define EMI_STATE_IDLE                      (0u)    /* No page is being written */
+#define EMI_STATE_WRITE                     (1u)    /* Page data transfer is in progress */
+#define EMI_STATE_POLL                      (2u)    /* Page is programmed, polled for ACK */
+
+
+/*******************************************************************************
+* Data Struct Definition
+*******************************************************************************/
+typedef struct
+{
+    uint8 i2cAddr;                                  /* EEPROM block slave address */
+    uint8 size;                                     /* Data bytes in the page */
+    uint8 buf[EMI_DATA_INDX + EMI_EXTERNAL_MEMORY_PAGE_SIZE];   /* Address bytes and data */
+} EMI_PAGE_SLOT_T;
+
 
 /*******************************************************************************
 * External Memory Layout
@@ -149,7 +174,6 @@ cystatus EMI_ReadData (uint32 dataAddr, uint32 dataSize, uint8 *data);
 *******************************************************************************/
 void     BootloaderEmulator_Start(void);
 cystatus BootloaderEmulator_ValidateBootloadable(void);
-uint32   BootloaderEmulator_Calc8BitSum(uint32 addr);
 
 
 #endif /* BootloaderEmulator_H */
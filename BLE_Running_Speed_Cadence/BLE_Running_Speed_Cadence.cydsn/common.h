@@ -15,6 +15,7 @@
 
 #include <project.h>
 #include <stdio.h>
+#include "pwrmgr.h"
 
 #define ENABLED                             (1u)
 #define DISABLED                            (0u)
@@ -41,23 +42,12 @@
 /* Delay value to produce blinking LED */
 #define BLINK_DELAY                         (2000u)
 
-#define PACE_TIMER_VALUE                    (333u)
-
-#define NOTIFICATION_TIMER_VALUE            (150u)
-
-
-#define WALKING_PROFILE_TIMER_VALUE         (33u)
-#define RUNNING_PROFILE_TIMER_VALUE         (17u)
-
-
-#define WDT_COUNTER                 (CY_SYS_WDT_COUNTER1)
-#define WDT_COUNTER_MASK            (CY_SYS_WDT_COUNTER1_MASK)
-#define WDT_INTERRUPT_SOURCE        (CY_SYS_WDT_COUNTER1_INT) 
-#define WDT_COUNTER_ENABLE          (1u)
-#define WDT_1SEC                    (32767u)
-#define WDT_500MSEC                 (16383u)
-#define WDT_250MSEC                 (8191u)
-#define WDT_100MSEC                 (3277u)
+/* Timer periods, ms */
+#define LED_TIMER_PERIOD                    (500u)
+#define PACE_TIMER_PERIOD                   (10000u)
+#define NOTIFICATION_TIMER_PERIOD           (3000u)
+#define WALKING_PROFILE_TIMER_PERIOD        (1000u)
+#define RUNNING_PROFILE_TIMER_PERIOD        (500u)
 
 #define ONE_BYTE_SHIFT              (8u)
 #define TWO_BYTES_SHIFT             (16u)
@@ -27,6 +27,7 @@
 ***************************************/
 void HandleLeds(void);
 void AppCallBack(uint32 event, void * eventParam);
+static void StartProfileTimer(void);
 
 
 /***************************************
@@ -36,11 +37,11 @@ CYBLE_CONN_HANDLE_T  connectionHandle;
 uint8                state = DISCONNECTED;
 uint16               advBlinkDelayCount;
 uint8                advLedState = LED_OFF;
-uint16               justWakeFromDeepSleep = 0u;
-uint16               profileTimer = WALKING_PROFILE_TIMER_VALUE;
-uint16               paceTimer = PACE_TIMER_VALUE;
-uint16               notificationTimer = NOTIFICATION_TIMER_VALUE;
-volatile uint32      mainTimer = 0u;
+uint8                ledTimer;
+uint8                profileTimer;
+uint8                paceTimer;
+uint8                notificationTimer;
+uint8                buttonWake;
 
 
 /*******************************************************************************
@@ -169,6 +170,7 @@ void AppCallBack(uint32 event, void *eventParam)
                 DBG_PRINTF("Advertisement is enabled \r\n");
                 /* Device now is in Advertising state */
                 state = ADVERTISING;
+                PwrMgrTimerStart(ledTimer, LED_TIMER_PERIOD, 1u);
             }
         }
         else
@@ -187,10 +189,18 @@ void AppCallBack(uint32 event, void *eventParam)
     case CYBLE_EVT_GAP_DEVICE_CONNECTED:
         DBG_PRINTF("CYBLE_EVT_DEVICE_CONNECTED: %d \r\n", connectionHandle.bdHandle);
         state = CONNECTED;
+
+        /* Start simulating the sensor */
+        PwrMgrTimerStart(notificationTimer, NOTIFICATION_TIMER_PERIOD, 1u);
+        PwrMgrTimerStart(paceTimer, PACE_TIMER_PERIOD, 1u);
+        StartProfileTimer();
         break;
     case CYBLE_EVT_GAP_DEVICE_DISCONNECTED:
         connectionHandle.bdHandle = 0u;
         DBG_PRINTF("CYBLE_EVT_DEVICE_DISCONNECTED\r\n");
+        PwrMgrTimerStop(notificationTimer);
+        PwrMgrTimerStop(paceTimer);
+        PwrMgrTimerStop(profileTimer);
         /* Put the device to discoverable mode so that remote can search it. */
         state = CONNECTED;
 
@@ -268,13 +278,13 @@ void AppCallBack(uint32 event, void *eventParam)
 *******************************************************************************/
 CY_ISR(WDT_Interrupt)
 {
-    if(CySysWdtGetInterruptSource() & WDT_INTERRUPT_SOURCE)
+    if(CySysWdtGetInterruptSource() & PWR_MGR_WDT_INT)
     {
-        /* Indicate that timer is raised to the main loop */
-        mainTimer++;
+        /* Indicate that timer is raised to the power manager */
+        PwrMgrTimerInterrupt();
 
         /* Clears interrupt request  */
-        CySysWdtClearInterrupt(WDT_INTERRUPT_SOURCE);
+        CySysWdtClearInterrupt(PWR_MGR_WDT_INT);
     }
 }
 
@@ -284,27 +294,149 @@ CY_ISR(WDT_Interrupt)
 ********************************************************************************
 *
 * Summary:
-*  Configures WDT to trigger an interrupt every second.
+*  Starts the WDT counter of the power manager timers.
 *
 *******************************************************************************/
 void WDT_Start(void)
 {
-    /* Unlock the WDT registers for modification */
-    CySysWdtUnlock();
     /* Setup ISR */
     WDT_Interrupt_StartEx(&WDT_Interrupt);
-    /* Write the mode to generate interrupt on match */
-    CySysWdtWriteMode(WDT_COUNTER, CY_SYS_WDT_MODE_INT);
-    /* Configure the WDT counter clear on a match setting */
-    CySysWdtWriteClearOnMatch(WDT_COUNTER, WDT_COUNTER_ENABLE);
-    /* Configure the WDT counter match comparison value */
-    CySysWdtWriteMatch(WDT_COUNTER, WDT_500MSEC);
-    /* Reset WDT counter */
-    CySysWdtResetCounters(WDT_COUNTER);
-    /* Enable the specified WDT counter */
-    CySysWdtEnable(WDT_COUNTER_MASK);
-    /* Lock out configuration changes to the Watchdog timer registers */
-    CySysWdtLock();
+    /* Start the free running counter, its interrupt is enabled by the timers */
+    PwrMgrStart();
+}
+
+
+/*******************************************************************************
+* Function Name: LedTimerCallBack
+********************************************************************************
+*
+* Summary:
+*  Toggles the advertising LED state every LED_TIMER_PERIOD. The timer is
+*  stopped when the advertising is over.
+*
+*******************************************************************************/
+static void LedTimerCallBack(void)
+{
+    if(ADVERTISING == state)
+    {
+        advLedState ^= LED_OFF;
+    }
+    else
+    {
+        PwrMgrTimerStop(ledTimer);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: NotificationTimerCallBack
+********************************************************************************
+*
+* Summary:
+*  Sends the RSC Measurement notification every NOTIFICATION_TIMER_PERIOD.
+*
+*******************************************************************************/
+static void NotificationTimerCallBack(void)
+{
+    if(rscNotificationState == ENABLED)
+    {
+        HandleRscNotifications();
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: PaceTimerCallBack
+********************************************************************************
+*
+* Summary:
+*  Updates the walking/running pace every PACE_TIMER_PERIOD.
+*
+*******************************************************************************/
+static void PaceTimerCallBack(void)
+{
+    UpdatePace();
+}
+
+
+/*******************************************************************************
+* Function Name: StartProfileTimer
+********************************************************************************
+*
+* Summary:
+*  Starts the profile simulation timer with the period of the current
+*  profile.
+*
+*******************************************************************************/
+static void StartProfileTimer(void)
+{
+    PwrMgrTimerStart(profileTimer, (WALKING == profile) ?
+        WALKING_PROFILE_TIMER_PERIOD : RUNNING_PROFILE_TIMER_PERIOD, 0u);
+}
+
+
+/*******************************************************************************
+* Function Name: ProfileTimerCallBack
+********************************************************************************
+*
+* Summary:
+*  Simulates walking/running once in a second/half of a second.
+*
+*******************************************************************************/
+static void ProfileTimerCallBack(void)
+{
+    SimulateProfile();
+    StartProfileTimer();
+}
+
+
+#if (DEBUG_UART_ENABLED == ENABLED)
+/*******************************************************************************
+* Function Name: DebugUartBusy
+********************************************************************************
+*
+* Summary:
+*  Busy holder of the debug UART. The CPU sleeps instead of entering
+*  Deep-Sleep until all debug information has been sent.
+*
+*******************************************************************************/
+static uint8 DebugUartBusy(void)
+{
+    return(((UART_DEB_SpiUartGetTxBufferSize() + UART_DEB_GET_TX_FIFO_SR_VALID) == 0u) ?
+        PWR_MODE_DEEPSLEEP : PWR_MODE_SLEEP);
+}
+#endif /* (DEBUG_UART_ENABLED == ENABLED) */
+
+
+/*******************************************************************************
+* Function Name: FlashWriteBusy
+********************************************************************************
+*
+* Summary:
+*  Busy holder of the bonding data. Keeps the main loop running until the
+*  pending bonding data is stored to flash.
+*
+*******************************************************************************/
+static uint8 FlashWriteBusy(void)
+{
+    return(((cyBle_pendingFlashWrite != 0u) && (CyBle_GetState() == CYBLE_STATE_CONNECTED)) ?
+        PWR_MODE_ACTIVE : PWR_MODE_DEEPSLEEP);
+}
+
+
+/*******************************************************************************
+* Function Name: IndicationBusy
+********************************************************************************
+*
+* Summary:
+*  Busy holder of the SC Control Point indication. Keeps the main loop
+*  running until the pending indication is sent.
+*
+*******************************************************************************/
+static uint8 IndicationBusy(void)
+{
+    return(((rscIndicationState == ENABLED) && (YES == rscIndicationPending)) ?
+        PWR_MODE_ACTIVE : PWR_MODE_DEEPSLEEP);
 }
 
 
@@ -340,13 +472,6 @@ void HandleLeds(void)
         Running_LED_Write(LED_OFF);
         
         /* ... blink advertising indication LED. */
-        
-        if(0u != mainTimer)
-        {            
-            mainTimer = 0u;
-            advLedState ^= LED_OFF;    
-        }
-        
         Advertising_LED_Write(advLedState);
     }
     /* In connected State ... */
@@ -373,7 +498,8 @@ void HandleLeds(void)
 ********************************************************************************
 *
 * Summary:
-*   Handles the mechanical button press.
+*   Handles the mechanical button press. The profile is switched by
+*   ButtonPressCallBack() in the main loop.
 *
 * Parameters:
 *   None
@@ -384,101 +510,46 @@ void HandleLeds(void)
 *******************************************************************************/
 CY_ISR(ButtonPressInt)
 {
-    if(CyBle_GetState() == CYBLE_STATE_CONNECTED)
-    {
-        if(WALKING == profile)
-        {
-            /* Update device with running simulation data */
-            profile = RUNNING;
-            rscMeasurement.flags |= RSC_FLAGS_WALK_RUN_STATUS_MASK;
-        }
-        else
-        {
-            /* Update device with walking simulation data */
-            profile = WALKING;
-            rscMeasurement.flags &= ~RSC_FLAGS_WALK_RUN_STATUS_MASK;
-        }
-
-        rscMeasurement.instStridelen = strideLenRanges[profile].min;
-        rscMeasurement.instCadence = cadenceRanges[profile].min;
-    }
+    PwrMgrWake(buttonWake);
 
     SW2_ClearInterrupt();
 }
 
 
 /*******************************************************************************
-* Function Name: LowPowerImplementation()
+* Function Name: ButtonPressCallBack
 ********************************************************************************
+*
 * Summary:
-* Implements low power in the project.
+*   Switches between the walking and running profiles.
 *
 * Parameters:
-* None
+*   None
 *
 * Return:
-* None
-*
-* Theory:
-* The function tries to enter deep sleep as much as possible - whenever the 
-* BLE is idle and the UART transmission/reception is not happening. At all other
-* times, the function tries to enter CPU sleep.
+*   None
 *
 *******************************************************************************/
-static void LowPowerImplementation(void)
+static void ButtonPressCallBack(void)
 {
-    CYBLE_LP_MODE_T bleMode;
-    uint8 interruptStatus;
-    
-    /* For advertising and connected states, implement deep sleep 
-     * functionality to achieve low power in the system. For more details
-     * on the low power implementation, refer to the Low Power Application 
-     * Note.
-     */
-    if((CyBle_GetState() == CYBLE_STATE_ADVERTISING) || 
-       (CyBle_GetState() == CYBLE_STATE_CONNECTED))
+    if(CyBle_GetState() == CYBLE_STATE_CONNECTED)
     {
-        /* Request BLE subsystem to enter into Deep-Sleep mode between connection and advertising intervals */
-        bleMode = CyBle_EnterLPM(CYBLE_BLESS_DEEPSLEEP);
-        /* Disable global interrupts */
-        interruptStatus = CyEnterCriticalSection();
-        /* When BLE subsystem has been put into Deep-Sleep mode */
-        if(bleMode == CYBLE_BLESS_DEEPSLEEP)
+        if(WALKING == profile)
         {
-            /* And it is still there or ECO is on */
-            if((CyBle_GetBleSsState() == CYBLE_BLESS_STATE_ECO_ON) || 
-               (CyBle_GetBleSsState() == CYBLE_BLESS_STATE_DEEPSLEEP))
-            {
-            #if (DEBUG_UART_ENABLED == ENABLED)
-                /* Put the CPU into the Deep-Sleep mode when all debug information has been sent */
-                if((UART_DEB_SpiUartGetTxBufferSize() + UART_DEB_GET_TX_FIFO_SR_VALID) == 0u)
-                {
-                    CySysPmDeepSleep();
-                    
-                    /* This variable will set only once per connection interval. This is required
-                    * to implement SW timers. Connection interval depends on Client settings.
-                    */
-                    justWakeFromDeepSleep = 1u;
-                }
-                else /* Put the CPU into Sleep mode and let SCB to continue sending debug data */
-                {
-                    CySysPmSleep();
-                }
-            #else
-                CySysPmDeepSleep();
-            #endif /* (DEBUG_UART_ENABLED == ENABLED) */
-            }
+            /* Update device with running simulation data */
+            profile = RUNNING;
+            rscMeasurement.flags |= RSC_FLAGS_WALK_RUN_STATUS_MASK;
         }
-        else /* When BLE subsystem has been put into Sleep mode or is active */
+        else
         {
-            /* And hardware doesn't finish Tx/Rx opeation - put the CPU into Sleep mode */
-            if(CyBle_GetBleSsState() != CYBLE_BLESS_STATE_EVENT_CLOSE)
-            {
-                CySysPmSleep();
-            }
+            /* Update device with walking simulation data */
+            profile = WALKING;
+            rscMeasurement.flags &= ~RSC_FLAGS_WALK_RUN_STATUS_MASK;
         }
-        /* Enable global interrupt */
-        CyExitCriticalSection(interruptStatus);
+
+        rscMeasurement.instStridelen = strideLenRanges[profile].min;
+        rscMeasurement.instCadence = cadenceRanges[profile].min;
+        StartProfileTimer();
     }
 }
 
@@ -520,6 +591,16 @@ int main()
     
     /* Global Resources initialization */
     WDT_Start();
+#if (DEBUG_UART_ENABLED == ENABLED)
+    (void)PwrMgrRegisterBusy(DebugUartBusy);
+#endif /* (DEBUG_UART_ENABLED == ENABLED) */
+    (void)PwrMgrRegisterBusy(FlashWriteBusy);
+    (void)PwrMgrRegisterBusy(IndicationBusy);
+    buttonWake = PwrMgrRegisterWake(ButtonPressCallBack);
+    ledTimer = PwrMgrTimerCreate(LedTimerCallBack);
+    notificationTimer = PwrMgrTimerCreate(NotificationTimerCallBack);
+    paceTimer = PwrMgrTimerCreate(PaceTimerCallBack);
+    profileTimer = PwrMgrTimerCreate(ProfileTimerCallBack);
     
     InitProfile();
     
@@ -528,61 +609,14 @@ int main()
         /* CyBle_ProcessEvents() allows BLE stack to process pending events */
         CyBle_ProcessEvents();
 
-        /* To achieve low power in the device */
-        LowPowerImplementation();
+        /* Handle the timers and put the device into the lowest possible power mode */
+        PwrMgrProcess();
 
         /* Handle advertising LED blinking */
         HandleLeds();
 
         if(CyBle_GetState() == CYBLE_STATE_CONNECTED)
         {
-            if(0u != justWakeFromDeepSleep)
-            {
-                if(0u == notificationTimer)
-                {
-                    /* Send notification once in 3 seconds in case of 30 ms connection interval */
-                    if(rscNotificationState == ENABLED)
-                    {
-                        HandleRscNotifications();
-                    }
-                    notificationTimer = NOTIFICATION_TIMER_VALUE;
-                }
-
-                notificationTimer--;
-                
-                if(0u == paceTimer)
-                {
-                    /* Update walking/running pace once in 10 seconds in case of 30 ms connection
-                    * interval.
-                    */
-                    UpdatePace();
-                    paceTimer = PACE_TIMER_VALUE;
-                }
-
-                paceTimer--;
-
-                if(0u == profileTimer)
-                {
-                    /* Simulate walking/running once in a second/half of a second
-                    * in case of 30 ms connection interval.
-                    */
-                    SimulateProfile();
-                    
-                    if(WALKING == profile)
-                    {
-                        profileTimer = WALKING_PROFILE_TIMER_VALUE;
-                    }
-                    else
-                    {
-                        profileTimer = RUNNING_PROFILE_TIMER_VALUE;
-                    }
-                }
-
-                profileTimer--;
-                
-                justWakeFromDeepSleep = 0u;
-            }
-
             /* Send indication if one is pending */
             if((rscIndicationState == ENABLED) && (YES == rscIndicationPending))
             {
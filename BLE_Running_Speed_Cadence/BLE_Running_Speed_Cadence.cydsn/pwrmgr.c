@@ -0,0 +1,515 @@
+/*******************************************************************************
+* File Name: pwrmgr.c
+*
+* Version 1.0
+*
+* Description:
+*  This file contains the power manager. It replaces the low power code of
+*  the main loop:
+*   - busy holders are polled before sleep and limit the CPU power mode,
+*     e.g. the debug UART keeps the HFCLK running while it sends;
+*   - wake reasons are signaled by interrupts and handled in the main loop,
+*     a reason signaled just before sleep keeps the CPU awake;
+*   - application timers run on one WDT counter without a periodic tick.
+*     The counter match is set to the nearest expiration, so the CPU only
+*     wakes up when a timer expires.
+*
+*  PwrMgrProcess() is called from the main loop after CyBle_ProcessEvents().
+*  The mode is chosen by PwrPolicyDecide(). PWR_MGR_ENTER_HOOK() and
+*  PWR_MGR_EXIT_HOOK() may be defined by the project to observe the choice.
+*
+* Hardware Dependency:
+*  CY8CKIT-042 BLE
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include "common.h"
+
+#if !defined(PWR_MGR_ENTER_HOOK)
+    #define PWR_MGR_ENTER_HOOK(mode, reason)
+    #define PWR_MGR_EXIT_HOOK()
+#endif /* !defined(PWR_MGR_ENTER_HOOK) */
+
+
+static PWR_MGR_BUSY_FUNC pwrMgrBusy[PWR_MGR_BUSY_MAX];
+static uint8 pwrMgrBusyNum = 0u;
+
+static PWR_MGR_EVENT_FUNC pwrMgrWakeFunc[PWR_MGR_WAKE_MAX];
+static uint8 pwrMgrWakeNum = 0u;
+static volatile uint32 pwrMgrWake = 0u;     /* Signaled wake reasons, bit per reason */
+
+static PWR_MGR_TIMER_T pwrMgrTimer[PWR_MGR_TIMER_MAX];
+static uint8 pwrMgrTimerNum = 0u;
+static uint32 pwrMgrTime = 0u;              /* The WDT counter extended to 32 bits */
+static uint16 pwrMgrCount = 0u;             /* The WDT counter at the last read */
+static uint8 pwrMgrArmed = 0u;              /* The match interrupt is enabled */
+
+
+/*******************************************************************************
+* Function Name: PwrMgrNow
+********************************************************************************
+*
+* Summary:
+*   Returns the current time. Called from the main loop only.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   uint32 - the time in LFCLK ticks.
+*
+*******************************************************************************/
+static uint32 PwrMgrNow(void)
+{
+    uint16 count = (uint16)CySysWdtReadCount(PWR_MGR_WDT_COUNTER);
+
+    pwrMgrTime += (uint16)(count - pwrMgrCount);
+    pwrMgrCount = count;
+
+    return(pwrMgrTime);
+}
+
+
+/*******************************************************************************
+* Function Name: PwrMgrStart
+********************************************************************************
+*
+* Summary:
+*   Starts the WDT counter of the timer scheduler. The counter runs freely and
+*   its interrupt stays disabled until a timer is started. The interrupt
+*   must be routed to PwrMgrTimerInterrupt() by the project.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void PwrMgrStart(void)
+{
+    CySysWdtUnlock();
+    CySysWdtWriteMode(PWR_MGR_WDT_COUNTER, CY_SYS_WDT_MODE_NONE);
+    CySysWdtWriteClearOnMatch(PWR_MGR_WDT_COUNTER, 0u);
+    CySysWdtEnable(PWR_MGR_WDT_COUNTER_MASK);
+    CySysWdtLock();
+
+    pwrMgrCount = (uint16)CySysWdtReadCount(PWR_MGR_WDT_COUNTER);
+}
+
+
+/*******************************************************************************
+* Function Name: PwrMgrRegisterBusy
+********************************************************************************
+*
+* Summary:
+*   Registers a busy holder. The holder is called with interrupts disabled
+*   before every sleep and returns the deepest mode it allows.
+*
+* Parameters:
+*   func - the holder.
+*
+* Return:
+*   CYRET_SUCCESS or CYRET_MEMORY if PWR_MGR_BUSY_MAX holders are registered.
+*
+*******************************************************************************/
+cystatus PwrMgrRegisterBusy(PWR_MGR_BUSY_FUNC func)
+{
+    cystatus status = CYRET_MEMORY;
+
+    if(pwrMgrBusyNum < PWR_MGR_BUSY_MAX)
+    {
+        pwrMgrBusy[pwrMgrBusyNum] = func;
+        pwrMgrBusyNum++;
+        status = CYRET_SUCCESS;
+    }
+
+    return(status);
+}
+
+
+/*******************************************************************************
+* Function Name: PwrMgrRegisterWake
+********************************************************************************
+*
+* Summary:
+*   Registers a wake reason. An interrupt signals it with PwrMgrWake(), then
+*   the handler is called from the main loop.
+*
+* Parameters:
+*   func - the handler.
+*
+* Return:
+*   uint8 - the wake reason or PWR_MGR_INVALID if PWR_MGR_WAKE_MAX reasons
+*           are registered.
+*
+*******************************************************************************/
+uint8 PwrMgrRegisterWake(PWR_MGR_EVENT_FUNC func)
+{
+    uint8 reason = PWR_MGR_INVALID;
+
+    if(pwrMgrWakeNum < PWR_MGR_WAKE_MAX)
+    {
+        pwrMgrWakeFunc[pwrMgrWakeNum] = func;
+        pwrMgrWakeNum++;
+        reason = pwrMgrWakeNum;     /* Reason 0 is PWR_MGR_WAKE_TIMER */
+    }
+
+    return(reason);
+}
+
+
+/*******************************************************************************
+* Function Name: PwrMgrWake
+********************************************************************************
+*
+* Summary:
+*   Signals a wake reason. May be called from an interrupt.
+*
+* Parameters:
+*   reason - the value returned by PwrMgrRegisterWake().
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void PwrMgrWake(uint8 reason)
+{
+    uint8 interruptStatus;
+
+    interruptStatus = CyEnterCriticalSection();
+    pwrMgrWake |= (uint32)1u << reason;
+    CyExitCriticalSection(interruptStatus);
+}
+
+
+/*******************************************************************************
+* Function Name: PwrMgrTimerCreate
+********************************************************************************
+*
+* Summary:
+*   Allocates an application timer. The timer is stopped.
+*
+* Parameters:
+*   func - the handler called from the main loop when the timer expires.
+*
+* Return:
+*   uint8 - the timer or PWR_MGR_INVALID if PWR_MGR_TIMER_MAX timers are
+*           allocated.
+*
+*******************************************************************************/
+uint8 PwrMgrTimerCreate(PWR_MGR_EVENT_FUNC func)
+{
+    uint8 timer = PWR_MGR_INVALID;
+
+    if(pwrMgrTimerNum < PWR_MGR_TIMER_MAX)
+    {
+        timer = pwrMgrTimerNum;
+        pwrMgrTimer[timer].func = func;
+        pwrMgrTimer[timer].active = 0u;
+        pwrMgrTimerNum++;
+    }
+
+    return(timer);
+}
+
+
+/*******************************************************************************
+* Function Name: PwrMgrTimerStart
+********************************************************************************
+*
+* Summary:
+*   Starts or restarts a timer. The WDT match is updated by the next
+*   PwrMgrProcess() call.
+*
+* Parameters:
+*   timer    - the value returned by PwrMgrTimerCreate().
+*   ms       - the timeout in milliseconds.
+*   periodic - non-zero to restart the timer on every expiration.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void PwrMgrTimerStart(uint8 timer, uint32 ms, uint8 periodic)
+{
+    uint32 ticks = PWR_MGR_MS_TO_TICKS(ms);
+    uint8 running = 0u;
+    uint8 i;
+
+    if(0u == ticks)
+    {
+        ticks = 1u;
+    }
+
+    /* The counter is not followed while no timer runs, so the time is stale */
+    for(i = 0u; i < pwrMgrTimerNum; i++)
+    {
+        running |= pwrMgrTimer[i].active;
+    }
+    if(0u == running)
+    {
+        pwrMgrCount = (uint16)CySysWdtReadCount(PWR_MGR_WDT_COUNTER);
+    }
+
+    pwrMgrTimer[timer].expire = PwrMgrNow() + ticks;
+    pwrMgrTimer[timer].period = (0u != periodic) ? ticks : 0u;
+    pwrMgrTimer[timer].active = 1u;
+}
+
+
+/*******************************************************************************
+* Function Name: PwrMgrTimerStop
+********************************************************************************
+*
+* Summary:
+*   Stops a timer.
+*
+* Parameters:
+*   timer - the value returned by PwrMgrTimerCreate().
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void PwrMgrTimerStop(uint8 timer)
+{
+    pwrMgrTimer[timer].active = 0u;
+}
+
+
+/*******************************************************************************
+* Function Name: PwrMgrTimerInterrupt
+********************************************************************************
+*
+* Summary:
+*   Handles the WDT match of the timer scheduler. Called from the WDT
+*   interrupt, which clears the interrupt request.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void PwrMgrTimerInterrupt(void)
+{
+    /* A higher priority interrupt may signal its reason in between */
+    PwrMgrWake(PWR_MGR_WAKE_TIMER);
+}
+
+
+/*******************************************************************************
+* Function Name: PwrMgrTimerDispatch
+********************************************************************************
+*
+* Summary:
+*   Calls the handlers of the expired timers and sets the WDT match to the
+*   nearest expiration. The interrupt is disabled when no timer is running.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   uint8 - the number of handlers called.
+*
+*******************************************************************************/
+static uint8 PwrMgrTimerDispatch(void)
+{
+    PWR_MGR_TIMER_T *t;
+    uint32 now = PwrMgrNow();
+    uint32 next = PWR_MGR_MATCH_MAX;
+    uint8 active = 0u;
+    uint8 called = 0u;
+    uint8 i;
+
+    for(i = 0u; i < pwrMgrTimerNum; i++)
+    {
+        t = &pwrMgrTimer[i];
+        if((0u != t->active) && ((int32)(now - t->expire) >= 0))
+        {
+            if(0u != t->period)
+            {
+                /* Keep the period, but skip the expirations that were missed */
+                t->expire += t->period;
+                if((int32)(now - t->expire) >= 0)
+                {
+                    t->expire = now + t->period;
+                }
+            }
+            else
+            {
+                t->active = 0u;
+            }
+
+            t->func();
+            called++;
+        }
+    }
+
+    /* The handlers may have started or stopped timers */
+    now = PwrMgrNow();
+    for(i = 0u; i < pwrMgrTimerNum; i++)
+    {
+        t = &pwrMgrTimer[i];
+        if(0u != t->active)
+        {
+            active = 1u;
+            if((int32)(t->expire - now) <= 0)
+            {
+                next = 0u;
+            }
+            else if((t->expire - now) < next)
+            {
+                next = t->expire - now;
+            }
+            else
+            {
+                /* The nearest expiration is already found */
+            }
+        }
+    }
+
+    if(0u == active)
+    {
+        if(0u != pwrMgrArmed)
+        {
+            CySysWdtUnlock();
+            CySysWdtWriteMode(PWR_MGR_WDT_COUNTER, CY_SYS_WDT_MODE_NONE);
+            CySysWdtLock();
+            CySysWdtClearInterrupt(PWR_MGR_WDT_INT);
+            pwrMgrArmed = 0u;
+        }
+    }
+    else if(next < PWR_MGR_MATCH_MIN)
+    {
+        /* Too close for the WDT, handle it on the next pass of the main loop */
+        PwrMgrTimerInterrupt();
+    }
+    else
+    {
+        CySysWdtUnlock();
+        CySysWdtWriteMatch(PWR_MGR_WDT_COUNTER, (uint16)(pwrMgrCount + next));
+        if(0u == pwrMgrArmed)
+        {
+            CySysWdtWriteMode(PWR_MGR_WDT_COUNTER, CY_SYS_WDT_MODE_INT);
+            pwrMgrArmed = 1u;
+        }
+        CySysWdtLock();
+    }
+
+    return(called);
+}
+
+
+/*******************************************************************************
+* Function Name: PwrMgrProcess
+********************************************************************************
+*
+* Summary:
+*   Handles the signaled wake reasons and the expired timers, then puts the
+*   CPU into the power mode chosen by PwrPolicyDecide(). The CPU does not
+*   sleep on a pass that had work to do, so the BLE stack processes the
+*   events the handlers have generated first.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void PwrMgrProcess(void)
+{
+    PWR_POLICY_INPUT_T input;
+    CYBLE_LP_MODE_T bleMode = CYBLE_BLESS_ACTIVE;
+    CYBLE_BLESS_STATE_T blessState;
+    CYBLE_STATE_T bleState;
+    uint32 wake;
+    uint8 interruptStatus;
+    uint8 called;
+    uint8 mode;
+    uint8 reason;
+    uint8 i;
+
+    interruptStatus = CyEnterCriticalSection();
+    wake = pwrMgrWake;
+    pwrMgrWake = 0u;
+    CyExitCriticalSection(interruptStatus);
+
+    called = PwrMgrTimerDispatch();
+    for(i = 0u; i < pwrMgrWakeNum; i++)
+    {
+        if(0u != (wake & ((uint32)1u << (i + 1u))))
+        {
+            pwrMgrWakeFunc[i]();
+            called++;
+        }
+    }
+
+    /* For advertising and connected states, request BLE subsystem to enter
+    * into Deep-Sleep mode between connection and advertising intervals.
+    */
+    bleState = CyBle_GetState();
+    input.bleLinked = ((CYBLE_STATE_ADVERTISING == bleState) || (CYBLE_STATE_CONNECTED == bleState)) ? 1u : 0u;
+    if(0u != input.bleLinked)
+    {
+        bleMode = CyBle_EnterLPM(CYBLE_BLESS_DEEPSLEEP);
+    }
+
+    interruptStatus = CyEnterCriticalSection();
+
+    blessState = CyBle_GetBleSsState();
+    if((CYBLE_BLESS_STATE_ECO_ON == blessState) || (CYBLE_BLESS_STATE_DEEPSLEEP == blessState))
+    {
+        input.blessState = PWR_BLESS_SLEEPING;
+    }
+    else if(CYBLE_BLESS_STATE_EVENT_CLOSE == blessState)
+    {
+        input.blessState = PWR_BLESS_EVENT_CLOSE;
+    }
+    else
+    {
+        input.blessState = PWR_BLESS_ACTIVE;
+    }
+    input.blessDeepSleep = (CYBLE_BLESS_DEEPSLEEP == bleMode) ? 1u : 0u;
+    input.eventPending = ((0u != called) || (0u != pwrMgrWake)) ? 1u : 0u;
+
+    input.holderMode = PWR_MODE_DEEPSLEEP;
+    for(i = 0u; i < pwrMgrBusyNum; i++)
+    {
+        mode = pwrMgrBusy[i]();
+        if(mode > input.holderMode)
+        {
+            input.holderMode = mode;
+        }
+    }
+
+    mode = PwrPolicyDecide(&input, &reason);
+    PWR_MGR_ENTER_HOOK(mode, reason);
+    if(PWR_MODE_DEEPSLEEP == mode)
+    {
+        CySysPmDeepSleep();
+        PWR_MGR_EXIT_HOOK();
+    }
+    else if(PWR_MODE_SLEEP == mode)
+    {
+        CySysPmSleep();
+        PWR_MGR_EXIT_HOOK();
+    }
+    else
+    {
+        /* Stay active and return to the main loop */
+    }
+
+    CyExitCriticalSection(interruptStatus);
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,98 @@
+/*******************************************************************************
+* File Name: pwrpolicy.c
+*
+* Version 1.0
+*
+* Description:
+*  This file contains the low power policy: the choice of the CPU power mode
+*  from the state of the BLE subsystem and the application. The policy is
+*  kept apart from the power manager and only depends on cytypes.h, so it is
+*  also built on the host.
+*
+* Hardware Dependency:
+*  CY8CKIT-042 BLE
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include "pwrpolicy.h"
+
+
+/*******************************************************************************
+* Function Name: PwrPolicyDecide
+********************************************************************************
+*
+* Summary:
+*   Chooses the deepest CPU power mode that is safe to enter now. The CPU
+*   only enters Deep-Sleep when the BLE subsystem is in Deep-Sleep (or its
+*   ECO is on) and no busy holder needs the CPU or a peripheral clock. When
+*   the BLE subsystem is active, the CPU sleeps until its interrupt, unless
+*   the connection event is being closed.
+*
+* Parameters:
+*   input  - the state of the BLE subsystem and the application.
+*   reason - returns why Deep-Sleep was not chosen or PWR_REASON_NONE.
+*
+* Return:
+*   uint8 - PWR_MODE_DEEPSLEEP, PWR_MODE_SLEEP or PWR_MODE_ACTIVE.
+*
+*******************************************************************************/
+uint8 PwrPolicyDecide(const PWR_POLICY_INPUT_T *input, uint8 *reason)
+{
+    uint8 mode = PWR_MODE_ACTIVE;
+
+    *reason = PWR_REASON_NONE;
+
+    if(0u != input->eventPending)
+    {
+        /* Let the main loop handle the events first */
+        *reason = PWR_REASON_EVENT;
+    }
+    else if(PWR_MODE_ACTIVE <= input->holderMode)
+    {
+        *reason = PWR_REASON_HOLDER;
+    }
+    else if(0u == input->bleLinked)
+    {
+        /* The stack may have events to process that no interrupt will signal */
+        *reason = PWR_REASON_STATE;
+    }
+    else if(0u != input->blessDeepSleep)
+    {
+        if(PWR_BLESS_SLEEPING == input->blessState)
+        {
+            if(PWR_MODE_DEEPSLEEP == input->holderMode)
+            {
+                mode = PWR_MODE_DEEPSLEEP;
+            }
+            else
+            {
+                mode = PWR_MODE_SLEEP;
+                *reason = PWR_REASON_HOLDER;
+            }
+        }
+        else
+        {
+            /* BLESS has already woken up for its next event */
+            *reason = PWR_REASON_BLESS;
+        }
+    }
+    else if(PWR_BLESS_EVENT_CLOSE != input->blessState)
+    {
+        mode = PWR_MODE_SLEEP;
+        *reason = PWR_REASON_BLE_ACTIVE;
+    }
+    else
+    {
+        *reason = PWR_REASON_EVENT_CLOSE;
+    }
+
+    return(mode);
+}
+
+
+/* [] END OF FILE */
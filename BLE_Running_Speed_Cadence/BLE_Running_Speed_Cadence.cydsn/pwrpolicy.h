@@ -0,0 +1,71 @@
+/*******************************************************************************
+* File Name: pwrpolicy.h
+*
+* Version 1.0
+*
+* Description:
+*  Contains the function prototypes and constants of the low power policy.
+*
+* Hardware Dependency:
+*  CY8CKIT-042 BLE
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(PWRPOLICY_H)
+#define PWRPOLICY_H
+
+#include "cytypes.h"
+
+
+/***************************************
+*        Constants
+***************************************/
+/* CPU power modes, from the deepest one */
+#define PWR_MODE_DEEPSLEEP                  (0u)
+#define PWR_MODE_SLEEP                      (1u)
+#define PWR_MODE_ACTIVE                     (2u)    /* Return to the main loop without sleep */
+#define PWR_MODES                           (3u)
+
+/* State of the BLE subsystem after CyBle_EnterLPM() */
+#define PWR_BLESS_SLEEPING                  (0u)    /* ECO on or Deep-Sleep */
+#define PWR_BLESS_EVENT_CLOSE               (1u)    /* Closing a connection or advertising event */
+#define PWR_BLESS_ACTIVE                    (2u)    /* Any other state */
+
+/* Reasons for not entering Deep-Sleep */
+#define PWR_REASON_HOLDER                   (0u)    /* A busy holder limits the mode */
+#define PWR_REASON_BLE_ACTIVE               (1u)    /* CyBle_EnterLPM() refused Deep-Sleep, CPU sleeps */
+#define PWR_REASON_BLESS                    (2u)    /* BLESS left Deep-Sleep before the CPU, no sleep */
+#define PWR_REASON_EVENT_CLOSE              (3u)    /* BLESS closes a connection event, no sleep */
+#define PWR_REASON_STATE                    (4u)    /* Neither advertising nor connected, no sleep */
+#define PWR_REASON_EVENT                    (5u)    /* Wake reasons or timers were handled, no sleep */
+#define PWR_REASONS                         (6u)
+#define PWR_REASON_NONE                     (0xFFu)
+
+
+/***************************************
+*        Data Struct Definition
+***************************************/
+typedef struct
+{
+    uint8 bleLinked;        /* Non-zero when advertising or connected */
+    uint8 blessDeepSleep;   /* Non-zero when CyBle_EnterLPM() returned CYBLE_BLESS_DEEPSLEEP */
+    uint8 blessState;       /* PWR_BLESS_xxx */
+    uint8 holderMode;       /* The deepest mode allowed by all busy holders */
+    uint8 eventPending;     /* Non-zero when the main loop has work to do */
+} PWR_POLICY_INPUT_T;
+
+
+/***************************************
+*      API Function Prototypes
+***************************************/
+uint8 PwrPolicyDecide(const PWR_POLICY_INPUT_T *input, uint8 *reason);
+
+
+#endif /* PWRPOLICY_H */
+
+/* [] END OF FILE */
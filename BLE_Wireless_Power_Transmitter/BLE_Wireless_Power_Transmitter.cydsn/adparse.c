@@ -0,0 +1,259 @@
+/*******************************************************************************
+* File Name: adparse.c
+*
+* Version 1.0
+*
+* Description:
+*  This file contains the advertising data parser. The AD structures are
+*  walked by one iterator that checks every structure against the end of
+*  the data before its value is exposed, so the callers never index past
+*  the report:
+*
+*   - AdIterNext() steps through the structures, a zero length ends the
+*     significant part of the data and a structure that overruns the data
+*     ends the walk with the error set;
+*   - AdParse() collects the flags, the UUID lists, the 16-bit UUID service
+*     data, the local name and the TX power level in one pass.
+*
+*  The parser only depends on cytypes.h, so it is also built on the host.
+*
+* Hardware Dependency:
+*  CY8CKIT-042 BLE
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include "adparse.h"
+
+
+/*******************************************************************************
+* Function Name: AdIterInit
+********************************************************************************
+*
+* Summary:
+*   Starts the walk of the advertising data.
+*
+* Parameters:
+*   iter - the iterator.
+*   data - the advertising data.
+*   dataLen - the length of the data.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void AdIterInit(AD_ITER_T *iter, const uint8 data[], uint8 dataLen)
+{
+    iter->data = data;
+    iter->dataLen = dataLen;
+    iter->next = 0u;
+    iter->offset = 0u;
+    iter->type = 0u;
+    iter->len = 0u;
+    iter->error = 0u;
+    iter->value = data;
+}
+
+
+/*******************************************************************************
+* Function Name: AdIterNext
+********************************************************************************
+*
+* Summary:
+*   Moves the iterator to the next AD structure.
+*
+* Parameters:
+*   iter - the iterator.
+*
+* Return:
+*   Non-zero when the iterator is at the next structure, 0 at the end of the
+*   data.
+*
+*******************************************************************************/
+uint8 AdIterNext(AD_ITER_T *iter)
+{
+    uint32 pos = iter->next;
+    uint32 length = 0u;
+    uint8 valid = 0u;
+
+    if(pos < iter->dataLen)
+    {
+        length = iter->data[pos];
+        if((pos + 1u + length) > iter->dataLen)
+        {
+            iter->error = 1u;
+        }
+        else if(0u != length)
+        {
+            iter->offset = (uint8)pos;
+            iter->type = iter->data[pos + 1u];
+            iter->len = (uint8)(length - 1u);
+            iter->value = &iter->data[pos + 2u];
+            valid = 1u;
+        }
+        else
+        {
+            /* The rest of the data is not significant */
+        }
+    }
+
+    /* The end of the data is not revisited */
+    iter->next = (0u != valid) ? (uint8)(pos + 1u + length) : iter->dataLen;
+
+    return(valid);
+}
+
+
+/*******************************************************************************
+* Function Name: AdParse
+********************************************************************************
+*
+* Summary:
+*   Parses the advertising data in one pass. The first structure of every
+*   kind is taken, the following ones are ignored.
+*
+* Parameters:
+*   data - the advertising data.
+*   dataLen - the length of the data.
+*   info - returns the parsed data, its pointers refer to the data.
+*
+* Return:
+*   Non-zero when the data is well formed, 0 when a structure overruns it.
+*   The structures before the malformed one are parsed in both cases.
+*
+*******************************************************************************/
+uint8 AdParse(const uint8 data[], uint8 dataLen, AD_INFO_T *info)
+{
+    AD_ITER_T iter;
+    uint8 seen = 0u;
+
+    info->flags = 0u;
+    info->txPower = AD_TX_POWER_NONE;
+    info->complete = 0u;
+    info->uuid16Len = 0u;
+    info->uuid128Len = 0u;
+    info->serviceData16Len = 0u;
+    info->nameLen = 0u;
+    info->uuid16 = data;
+    info->uuid128 = data;
+    info->serviceData16 = data;
+    info->name = data;
+
+    AdIterInit(&iter, data, dataLen);
+    while(0u != AdIterNext(&iter))
+    {
+        switch(iter.type)
+        {
+            case AD_TYPE_FLAGS:
+                if(0u != iter.len)
+                {
+                    info->flags = iter.value[0u];
+                }
+                break;
+
+            case AD_TYPE_COMPL_16UUID:
+            case AD_TYPE_INCOMPL_16UUID:
+                if(0u == (seen & AD_COMPLETE_UUID16))
+                {
+                    seen |= AD_COMPLETE_UUID16;
+                    info->uuid16 = iter.value;
+                    info->uuid16Len = iter.len & (uint8)~(AD_UUID16_SIZE - 1u);
+                    if(AD_TYPE_COMPL_16UUID == iter.type)
+                    {
+                        info->complete |= AD_COMPLETE_UUID16;
+                    }
+                }
+                break;
+
+            case AD_TYPE_COMPL_128UUID:
+            case AD_TYPE_INCOMPL_128UUID:
+                if(0u == (seen & AD_COMPLETE_UUID128))
+                {
+                    seen |= AD_COMPLETE_UUID128;
+                    info->uuid128 = iter.value;
+                    info->uuid128Len = iter.len & (uint8)~(AD_UUID128_SIZE - 1u);
+                    if(AD_TYPE_COMPL_128UUID == iter.type)
+                    {
+                        info->complete |= AD_COMPLETE_UUID128;
+                    }
+                }
+                break;
+
+            case AD_TYPE_COMPL_NAME:
+            case AD_TYPE_SHORT_NAME:
+                if(0u == (seen & AD_COMPLETE_NAME))
+                {
+                    seen |= AD_COMPLETE_NAME;
+                    info->name = iter.value;
+                    info->nameLen = iter.len;
+                    if(AD_TYPE_COMPL_NAME == iter.type)
+                    {
+                        info->complete |= AD_COMPLETE_NAME;
+                    }
+                }
+                break;
+
+            case AD_TYPE_TX_POWER:
+                if((0u != iter.len) && (AD_TX_POWER_NONE == info->txPower))
+                {
+                    info->txPower = (int8)iter.value[0u];
+                }
+                break;
+
+            case AD_TYPE_SRVC_DATA_16UUID:
+                if((iter.len >= AD_UUID16_SIZE) && (0u == info->serviceData16Len))
+                {
+                    info->serviceData16 = iter.value;
+                    info->serviceData16Len = iter.len;
+                }
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    return((0u == iter.error) ? 1u : 0u);
+}
+
+
+/*******************************************************************************
+* Function Name: AdFindUuid16
+********************************************************************************
+*
+* Summary:
+*   Looks the 16-bit UUID up in the UUID list.
+*
+* Parameters:
+*   list - the 16-bit UUID list, little-endian.
+*   len - the bytes in the list, an odd last byte is ignored.
+*   uuid - the UUID.
+*
+* Return:
+*   Non-zero when the list contains the UUID.
+*
+*******************************************************************************/
+uint8 AdFindUuid16(const uint8 list[], uint8 len, uint16 uuid)
+{
+    uint8 uuidLo = (uint8)uuid;
+    uint8 uuidHi = (uint8)(uuid >> 8u);
+    uint32 i;
+    uint8 found = 0u;
+
+    for(i = 0u; ((i + 1u) < len) && (0u == found); i += AD_UUID16_SIZE)
+    {
+        if((list[i] == uuidLo) && (list[i + 1u] == uuidHi))
+        {
+            found = 1u;
+        }
+    }
+
+    return(found);
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,93 @@
+/*******************************************************************************
+* File Name: adparse.h
+*
+* Version 1.0
+*
+* Description:
+*  Contains the function prototypes and constants of the advertising data
+*  parser.
+*
+* Hardware Dependency:
+*  CY8CKIT-042 BLE
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(ADPARSE_H)
+#define ADPARSE_H
+
+#include "cytypes.h"
+
+
+/***************************************
+*        Constants
+***************************************/
+/* AD types */
+#define AD_TYPE_FLAGS               (0x01u)
+#define AD_TYPE_INCOMPL_16UUID      (0x02u)
+#define AD_TYPE_COMPL_16UUID        (0x03u)
+#define AD_TYPE_INCOMPL_128UUID     (0x06u)
+#define AD_TYPE_COMPL_128UUID       (0x07u)
+#define AD_TYPE_SHORT_NAME          (0x08u)
+#define AD_TYPE_COMPL_NAME          (0x09u)
+#define AD_TYPE_TX_POWER            (0x0Au)
+#define AD_TYPE_SRVC_DATA_16UUID    (0x16u)
+
+#define AD_UUID16_SIZE              (2u)
+#define AD_UUID128_SIZE             (16u)
+
+/* AD_INFO_T complete bits */
+#define AD_COMPLETE_UUID16          (0x01u)
+#define AD_COMPLETE_UUID128         (0x02u)
+#define AD_COMPLETE_NAME            (0x04u)
+
+#define AD_TX_POWER_NONE            (-128)      /* txPower of the data without the TX Power Level */
+
+
+/***************************************
+*        Data Struct Definition
+***************************************/
+typedef struct
+{
+    const uint8 *data;          /* Advertising data */
+    uint8  dataLen;
+    uint8  next;                /* Offset of the next AD structure */
+    uint8  offset;              /* Offset of the current AD structure, its length byte */
+    uint8  type;                /* AD type of the current structure */
+    uint8  len;                 /* Length of its value */
+    uint8  error;               /* Non-zero when a structure overruns the data */
+    const uint8 *value;         /* Value of the current structure */
+} AD_ITER_T;
+
+typedef struct
+{
+    uint8  flags;               /* Flags, 0 when absent */
+    int8   txPower;             /* TX Power Level, dBm, or AD_TX_POWER_NONE */
+    uint8  complete;            /* AD_COMPLETE_ bits of the lists and the name */
+    uint8  uuid16Len;           /* Bytes in the 16-bit UUID list, 0 when absent */
+    uint8  uuid128Len;          /* Bytes in the 128-bit UUID list, 0 when absent */
+    uint8  serviceData16Len;    /* Bytes in the first 16-bit UUID service data, with the UUID */
+    uint8  nameLen;             /* Bytes in the local name, 0 when absent */
+    const uint8 *uuid16;
+    const uint8 *uuid128;
+    const uint8 *serviceData16;
+    const uint8 *name;          /* Local name, not terminated */
+} AD_INFO_T;
+
+
+/***************************************
+*      API Function Prototypes
+***************************************/
+void AdIterInit(AD_ITER_T *iter, const uint8 data[], uint8 dataLen);
+uint8 AdIterNext(AD_ITER_T *iter);
+uint8 AdParse(const uint8 data[], uint8 dataLen, AD_INFO_T *info);
+uint8 AdFindUuid16(const uint8 list[], uint8 len, uint16 uuid);
+
+
+#endif /* ADPARSE_H */
+
+/* [] END OF FILE */
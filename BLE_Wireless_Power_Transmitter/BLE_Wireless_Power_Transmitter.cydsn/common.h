@@ -15,6 +15,7 @@
 
 #include <project.h>
 #include <stdio.h>
+#include "scan.h"
 
 #if defined (__GNUC__)
     /* Add an explicit reference to the floating point printf library */
@@ -29,16 +29,20 @@ CYBLE_PEER_DEVICE_INFO_T peedDeviceInfo[CYBLE_MAX_ADV_DEVICES];
 uint8 advDevices = 0u;
 uint8 deviceN = 0u;
 
-uint8 state = STATE_INIT;
 uint8 readingDynChar = 0u;
 
 uint8 customCommand = 0u;
-uint16 alertCCCD = 0u;
 bool requestResponce = true;
 
+/* Scanning and connecting, the PRUs keep their own state in wptsPru */
+static uint8 state = STATE_INIT;
+
 
 CYBLE_GAP_CONN_PARAM_UPDATED_IN_CONTROLLER_T connParameters;
 
+/* Scan filter of the PRUs that advertise the WPT service data, compiled once */
+static SCAN_FILTER_T wptsFilter;
+
 
 /*******************************************************************************
 * Function Name: AppCallBack()
@@ -68,11 +72,16 @@ void AppCallback(uint32 event, void* eventParam)
     uint16 i;
     uint16 length;
     uint8 *locHndlUuidList;
+    CYBLE_CONN_HANDLE_T connHandle;
+    CYBLE_GAP_BD_ADDR_T bdAddr;
+    uint8 device;
     
 	switch (event)
 	{
 		case CYBLE_EVT_STACK_ON: /* This event received when BLE stack is ON. */
             DBG_PRINTF("Bluetooth On \r\n");
+            ScanFilterServiceData16(&wptsFilter, CYBLE_UUID_WIRELESS_POWER_TRANSFER_SERVICE, PRU_ADV_SERV_DATA_LEN);
+            ScanStart(&wptsFilter);
             apiResult = CyBle_GapcStartScan(CYBLE_SCANNING_FAST);                   /* Start Limited Discovery */
             if(apiResult != CYBLE_ERROR_OK)
             {
@@ -99,9 +108,15 @@ void AppCallback(uint32 event, void* eventParam)
         case CYBLE_EVT_GAPC_SCAN_PROGRESS_RESULT:
             {    
                 CYBLE_PRU_ADV_SERVICE_DATA_T serviceData;
+                SCAN_ENTRY_T *scanEntry;
+                uint8 scanResult;
                 advReport = (CYBLE_GAPC_ADV_REPORT_T *)eventParam;
                 
-                if(WptsScanProcessEventHandler(advReport, &serviceData) != 0u)
+                /* Only the new reports that pass the filter are parsed */
+                scanEntry = ScanReport(advReport->peerBdAddr, SCAN_TYPE(advReport->eventType, advReport->peerAddrType),
+                                       advReport->rssi, advReport->data, advReport->dataLen, &scanResult);
+                if((SCAN_REPORT_DUPLICATE != scanResult) && (SCAN_NO_MATCH != scanEntry->match) &&
+                   (WptsScanProcessEventHandler(advReport, &serviceData) != 0u))
                 {
                     DBG_PRINTF("Advertisement report: eventType = %x, peerAddrType - %x, ", 
                         advReport->eventType, advReport->peerAddrType);
@@ -131,7 +146,7 @@ void AppCallback(uint32 event, void* eventParam)
                     {
                         DBG_PRINTF("%2.2x", advReport->peerBdAddr[i-1]);
                     }
-                    DBG_PRINTF(", rssi - %d dBm,\r\n data - ", advReport->rssi);
+                    DBG_PRINTF(", rssi - %d dBm (%d average),\r\n data - ", advReport->rssi, SCAN_RSSI(scanEntry));
                     for( i = 0; i < advReport->dataLen; i++)
                     {
                         DBG_PRINTF("%2.2x ", advReport->data[i]);
@@ -191,37 +206,23 @@ void AppCallback(uint32 event, void* eventParam)
                 connParameters.supervisionTO);
             state = STATE_CONNECTED;
             UpdateLedState();
-            
-            if(peedDeviceInfo[deviceN].peerAdvServData.wptsServiceHandle != 0u)
-            {
-                /* Use quick discovery method based on WPT service handle received in the advertising packet */
-                CyBle_WptscDiscovery(peedDeviceInfo[deviceN].peerAdvServData.wptsServiceHandle);
-                
-                DBG_PRINTF("WPTS %x: ",  cyBle_wptsc.serviceHandle);
-                for(i = 0u; i < CYBLE_WPTS_CHAR_COUNT; i++)
-                {
-                    DBG_PRINTF("Char %x=%x, CCCD=%x ", i, CyBle_WptscGetCharacteristicValueHandle(i),
-                                                          CyBle_WptscGetCharacteristicDescriptorHandle(i,0u));
-                }
-                DBG_PRINTF("\r\n");
-                /* Initiate to read PRU Static Parameter characteristic value */
-                customCommand = '4';
-            }
-            else
-            {
-                /* When the service handle is unknown, use the standard discovery procedure */
-                customCommand = 's';
-            }
             break;
         case CYBLE_EVT_GAP_DEVICE_DISCONNECTED:
             DBG_PRINTF("DEVICE_DISCONNECTED: \r\n");
-            apiResult = CyBle_GapcStartScan(CYBLE_SCANNING_FAST);                   /* Start Limited Discovery */
-            if(apiResult != CYBLE_ERROR_OK)
+            WptsPurge();
+            DBG_PRINTF("%d PRUs are served \r\n", pruSchedCount);
+            /* Scan for the PRU again when it is gone */
+            if(pruSchedCount == 0u)
             {
-                DBG_PRINTF("StartScan API Error: %xd \r\n", apiResult);
+                ScanStart(&wptsFilter);
+                apiResult = CyBle_GapcStartScan(CYBLE_SCANNING_FAST);                   /* Start Limited Discovery */
+                if(apiResult != CYBLE_ERROR_OK)
+                {
+                    DBG_PRINTF("StartScan API Error: %xd \r\n", apiResult);
+                }
+                requestResponce = true;
+                state = STATE_DISCONNECTED;
             }
-            requestResponce = true;
-            state = STATE_DISCONNECTED;
             break;
         case CYBLE_EVT_GAP_ENCRYPT_CHANGE:
             DBG_PRINTF("ENCRYPT_CHANGE: %d \r\n", *(uint8 *)eventParam);
@@ -250,8 +251,29 @@ void AppCallback(uint32 event, void* eventParam)
                 ((CYBLE_GATTC_ERR_RSP_PARAM_T *)eventParam)->errorCode);
             break;
         case CYBLE_EVT_GATT_CONNECT_IND:
-            DBG_PRINTF("CYBLE_EVT_GATT_CONNECT_IND: %x, %x \r\n", 
-                (*(CYBLE_CONN_HANDLE_T *)eventParam).attId, (*(CYBLE_CONN_HANDLE_T *)eventParam).bdHandle);
+            connHandle = *(CYBLE_CONN_HANDLE_T *)eventParam;
+            DBG_PRINTF("CYBLE_EVT_GATT_CONNECT_IND: %x, %x \r\n", connHandle.attId, connHandle.bdHandle);
+            
+            /* The advertiser with the address of the peer, the selected one when it is not found */
+            device = deviceN;
+            if(CyBle_GapGetPeerBdAddr(connHandle.bdHandle, &bdAddr) == CYBLE_ERROR_OK)
+            {
+                for(i = 0u; i < advDevices; i++)
+                {
+                    if(memcmp(peedDeviceInfo[i].peerAddr.bdAddr, bdAddr.bdAddr, CYBLE_GAP_BD_ADDR_SIZE) == 0)
+                    {
+                        device = (uint8)i;
+                    }
+                }
+            }
+            
+            /* Every PRU gets an entry of the scheduler keyed by its connection, its power is granted after 
+            *  the PRU Static Parameter.
+            */
+            if(WptsOpen(connHandle, &peedDeviceInfo[device], device) == PRU_SCHED_NONE)
+            {
+                DBG_PRINTF("No PRU entry left, %d PRUs are served \r\n", pruSchedCount);
+            }
             break;
         case CYBLE_EVT_GATT_DISCONNECT_IND:
             DBG_PRINTF("GATT_DISCONNECT_IND \r\n");
@@ -259,10 +281,13 @@ void AppCallback(uint32 event, void* eventParam)
         case CYBLE_EVT_GATTC_HANDLE_VALUE_NTF:
             DBG_PRINTF("CYBLE_EVT_GATT_HANDLE_VALUE_NTF: handle: %x, Value:", ((CYBLE_GATTC_HANDLE_VALUE_IND_PARAM_T *)eventParam)->handleValPair.attrHandle );
             ShowValue(&((CYBLE_GATTC_HANDLE_VALUE_IND_PARAM_T *)eventParam)->handleValPair.value, 0u);
+            /* The PRU Alert of a PRU with other handles than the loaded ones */
+            WptsHandleValueNtf((CYBLE_GATTC_HANDLE_VALUE_NTF_PARAM_T *)eventParam);
             break;  
         case CYBLE_EVT_GATTC_HANDLE_VALUE_IND:
             DBG_PRINTF("CYBLE_EVT_GATTC_HANDLE_VALUE_IND: handle: %x, Value:", ((CYBLE_GATTC_HANDLE_VALUE_IND_PARAM_T *)eventParam)->handleValPair.attrHandle );
             ShowValue(&((CYBLE_GATTC_HANDLE_VALUE_IND_PARAM_T *)eventParam)->handleValPair.value, 0u);
+            WptsHandleValueNtf((CYBLE_GATTC_HANDLE_VALUE_NTF_PARAM_T *)eventParam);
             break;
         case CYBLE_EVT_GATTC_INDICATION:
             DBG_PRINTF("CYBLE_EVT_GATTC_INDICATION: handle: %x, Value:", ((CYBLE_GATTC_HANDLE_VALUE_IND_PARAM_T *)eventParam)->handleValPair.attrHandle );
@@ -350,12 +375,8 @@ void AppCallback(uint32 event, void* eventParam)
             }
             DBG_PRINTF("\r\n");
             DBG_PRINTF("\r\n");
-            /* Statrt configuration procedure */
-            if(state == STATE_CONNECTED) 
-            {
-                /* Initiate reading the PRU Static Parameter characteristic value */
-                customCommand = '4';
-            }
+            /* Keep the discovery data of the PRU, its configuration continues in WptsSchedule() */
+            WptsDiscoveryComplete();
         break;
 
         /**********************************************************
@@ -394,14 +415,7 @@ CY_ISR(Timer_Interrupt)
         {
             led ^= LED_ON;
             Scanning_LED_Write(led);
-        }
-        else if(CyBle_GetState() == CYBLE_STATE_CONNECTED)
-        {
-            if(readingDynChar != 0u)
-            {
-                /* Send Read request for PRU Dynamic Parameter characteristic */
-                customCommand = '5';
-            }
+            ScanTick();
         }
         else
         {
@@ -564,6 +578,7 @@ int main()
 {
     CYBLE_API_RESULT_T apiResult;
     char8 command = 0u;
+    uint8 pru;
     
     CyGlobalIntEnable;              /* Enable interrupts */
     UART_DEB_Start();               /* Start communication component */
@@ -603,18 +618,29 @@ int main()
             switch(command)
             {
                 case 'c':                   /* connect  */
-                    CyBle_GapcStopScan(); 
-                    state = STATE_CONNECTING;
+                    /* The BLE component holds one connection, a PRU is only 
+                    *  connected from the scanning state 
+                    */
+                    if(CyBle_GetState() == CYBLE_STATE_SCANNING)
+                    {
+                        /* Connect when the scanning is stopped */
+                        CyBle_GapcStopScan(); 
+                        state = STATE_CONNECTING;
+                    }
                     break;
                 case 'v':
                     apiResult = CyBle_GapcCancelDeviceConnection();
                     DBG_PRINTF("CyBle_GapcCancelDeviceConnection: %x\r\n" , apiResult);
                     break;
                 case 'd':                   /* disconnect */
-                    apiResult = CyBle_GapDisconnect(cyBle_connHandle.bdHandle); 
-                    if(apiResult != CYBLE_ERROR_OK)
+                    pru = WptsSelect(deviceN);
+                    if(pru != PRU_SCHED_NONE)
                     {
-                        DBG_PRINTF("DisconnectDevice API Error: %x \r\n", apiResult);
+                        apiResult = CyBle_GapDisconnect(wptsPru[pru].connHandle.bdHandle); 
+                        if(apiResult != CYBLE_ERROR_OK)
+                        {
+                            DBG_PRINTF("DisconnectDevice API Error: %x \r\n", apiResult);
+                        }
                     }
                     break;
                 case 's':
@@ -622,11 +648,20 @@ int main()
                     readingDynChar = 0u;
                     /* And clean pending command */
                     customCommand = 0u;
-                    apiResult = CyBle_GattcStartDiscovery(cyBle_connHandle);
-                    DBG_PRINTF("StartDiscovery \r\n");
-                    if(apiResult != CYBLE_ERROR_OK)
+                    pru = WptsSelect(deviceN);
+                    if(pru != PRU_SCHED_NONE)
                     {
-                        DBG_PRINTF("StartDiscovery API Error: %x \r\n", apiResult);
+                        apiResult = CyBle_GattcStartDiscovery(wptsPru[pru].connHandle);
+                        DBG_PRINTF("StartDiscovery \r\n");
+                        if(apiResult == CYBLE_ERROR_OK)
+                        {
+                            /* Until CYBLE_EVT_GATTC_DISCOVERY_COMPLETE */
+                            requestResponce = false;
+                        }
+                        else
+                        {
+                            DBG_PRINTF("StartDiscovery API Error: %x \r\n", apiResult);
+                        }
                     }
                     break;
                 case 'z':                   /* select peer device  */
@@ -644,72 +679,72 @@ int main()
                     }
                     break;
                 case '1':                   /* Enable Notification */
-                    alertCCCD |= CYBLE_CCCD_NOTIFICATION;
-                    apiResult = CyBle_WptscSetCharacteristicDescriptor(cyBle_connHandle, CYBLE_WPTS_PRU_ALERT,  
-                        CYBLE_WPTS_CCCD, sizeof(alertCCCD), (uint8 *)&alertCCCD);
-                    DBG_PRINTF("Enable Alert Notification, apiResult: %x \r\n", apiResult);
-                    if(apiResult == CYBLE_ERROR_OK)
-                    {
-                        requestResponce = false;
-                    }
-                    break;
                 case '2':                   /* Enable Indication */
-                    alertCCCD |= CYBLE_CCCD_INDICATION;
-                    apiResult = CyBle_WptscSetCharacteristicDescriptor(cyBle_connHandle, CYBLE_WPTS_PRU_ALERT,  
-                        CYBLE_WPTS_CCCD, sizeof(alertCCCD), (uint8 *)&alertCCCD);
-                    DBG_PRINTF("Enable Alert Indication, apiResult: %x \r\n", apiResult);
-                    if(apiResult == CYBLE_ERROR_OK)
-                    {
-                        requestResponce = false;
-                    }
-                    break;
                 case '3':                   /* Disable Notification and Indication */
-                    alertCCCD = 0u;
-                    apiResult = CyBle_WptscSetCharacteristicDescriptor(cyBle_connHandle, CYBLE_WPTS_PRU_ALERT,  
-                        CYBLE_WPTS_CCCD, sizeof(alertCCCD), (uint8 *)&alertCCCD);
-                    DBG_PRINTF("Disable Alert Notification and Indication, apiResult: %x \r\n", apiResult);
-                    if(apiResult == CYBLE_ERROR_OK)
+                    pru = WptsSelect(deviceN);
+                    if(pru != PRU_SCHED_NONE)
                     {
-                        requestResponce = false;
+                        if(command == '1')
+                        {
+                            wptsPru[pru].alertCCCD |= CYBLE_CCCD_NOTIFICATION;
+                        }
+                        else if(command == '2')
+                        {
+                            wptsPru[pru].alertCCCD |= CYBLE_CCCD_INDICATION;
+                        }
+                        else
+                        {
+                            wptsPru[pru].alertCCCD = 0u;
+                        }
+                        apiResult = CyBle_WptscSetCharacteristicDescriptor(wptsPru[pru].connHandle, CYBLE_WPTS_PRU_ALERT,  
+                            CYBLE_WPTS_CCCD, sizeof(wptsPru[pru].alertCCCD), (uint8 *)&wptsPru[pru].alertCCCD);
+                        DBG_PRINTF("Set Alert CCCD %x, apiResult: %x \r\n", wptsPru[pru].alertCCCD, apiResult);
+                        if(apiResult == CYBLE_ERROR_OK)
+                        {
+                            requestResponce = false;
+                        }
                     }
                     break;
                 case '4':                   /* Send Read request for PRU Static Parameter characteristic */
-                    apiResult = CyBle_WptscGetCharacteristicValue(cyBle_connHandle, CYBLE_WPTS_PRU_STATIC_PAR);
-                    DBG_PRINTF("Get PRU Static Parameter char value, apiResult: %x \r\n", apiResult);
-                    if(apiResult == CYBLE_ERROR_OK)
-                    {
-                        requestResponce = false;
-                    }
-                    break;
                 case '5':                   /* Send Read request for PRU Dynamic Parameter characteristic */
-                    apiResult = CyBle_WptscGetCharacteristicValue(cyBle_connHandle, CYBLE_WPTS_PRU_DYNAMIC_PAR);
-                    DBG_PRINTF("Get PRU Dynamic Parameter char value, apiResult: %x \r\n", apiResult);
-                    if(apiResult == CYBLE_ERROR_OK)
+                    pru = WptsSelect(deviceN);
+                    if(pru != PRU_SCHED_NONE)
                     {
-                        requestResponce = false;
-                    }
-                    break;
-                case '6':                   /* Enable Charging */
-                    peedDeviceInfo[deviceN].pruControl.enables = PRU_CONTROL_ENABLES_ENABLE_CHARGE_INDICATOR;
-                    apiResult = CyBle_WptscSetCharacteristicValue(cyBle_connHandle, CYBLE_WPTS_PRU_CONTROL,
-                        sizeof(peedDeviceInfo[deviceN].pruControl), (uint8 *)&peedDeviceInfo[deviceN].pruControl);
-                    DBG_PRINTF("Set PRU Control char (enable charging), apiResult: %x \r\n", apiResult);
-                    if(apiResult == CYBLE_ERROR_OK)
-                    {
-                        requestResponce = false;
+                        apiResult = CyBle_WptscGetCharacteristicValue(wptsPru[pru].connHandle, 
+                            (command == '4') ? CYBLE_WPTS_PRU_STATIC_PAR : CYBLE_WPTS_PRU_DYNAMIC_PAR);
+                        DBG_PRINTF("Get PRU %s Parameter char value, apiResult: %x \r\n", 
+                            (command == '4') ? "Static" : "Dynamic", apiResult);
+                        if(apiResult == CYBLE_ERROR_OK)
+                        {
+                            requestResponce = false;
+                        }
                     }
                     break;
+                case '6':                   /* Enable Charging at the power level granted to the PRU */
                 case '7':                   /* Disable Charging */
-                    peedDeviceInfo[deviceN].pruControl.enables &= ~PRU_CONTROL_ENABLES_ENABLE_CHARGE_INDICATOR;
-                    apiResult = CyBle_WptscSetCharacteristicValue(cyBle_connHandle, CYBLE_WPTS_PRU_CONTROL,
-                        sizeof(peedDeviceInfo[deviceN].pruControl), (uint8 *)&peedDeviceInfo[deviceN].pruControl);
-                    DBG_PRINTF("Set PRU Control char (disable charging), apiResult: %x \r\n", apiResult);
-                    if(apiResult == CYBLE_ERROR_OK)
+                    pru = WptsSelect(deviceN);
+                    if(pru != PRU_SCHED_NONE)
                     {
-                        requestResponce = false;
+                        if(command == '6')
+                        {
+                            wptsPru[pru].info.pruControl.enables &= PRU_CONTROL_ENABLES_ADJUST_POWER_MASK;
+                            wptsPru[pru].info.pruControl.enables |= PRU_CONTROL_ENABLES_ENABLE_CHARGE_INDICATOR;
+                        }
+                        else
+                        {
+                            wptsPru[pru].info.pruControl.enables &= ~PRU_CONTROL_ENABLES_ENABLE_CHARGE_INDICATOR;
+                        }
+                        apiResult = CyBle_WptscSetCharacteristicValue(wptsPru[pru].connHandle, CYBLE_WPTS_PRU_CONTROL,
+                            sizeof(wptsPru[pru].info.pruControl), (uint8 *)&wptsPru[pru].info.pruControl);
+                        DBG_PRINTF("Set PRU Control char (%s charging), apiResult: %x \r\n", 
+                            (command == '6') ? "enable" : "disable", apiResult);
+                        if(apiResult == CYBLE_ERROR_OK)
+                        {
+                            requestResponce = false;
+                        }
                     }
                     break;
-                case '8':                   /* Enable sequential read of PRU Dynamic Parameter characteristic */
+                case '8':                   /* Enable scheduled read of PRU Dynamic Parameter characteristic of all PRUs */
                     readingDynChar = 1u;
                     break;
                 case '9':                   /* Disable sequential read of PRU Dynamic Parameter characteristic */
@@ -731,12 +766,18 @@ int main()
                     DBG_PRINTF(" \'5\' - Send Read request for PRU Dynamic Parameter characteristic.\r\n");
                     DBG_PRINTF(" \'6\' - Send Enable Charging command to PRU control characteristic.\r\n");
                     DBG_PRINTF(" \'7\' - Send Disable Charging command to PRU control characteristic.\r\n");
-                    DBG_PRINTF(" \'8\' - Enable sequential read of PRU Dynamic Parameter characteristic.\r\n");
+                    DBG_PRINTF(" \'8\' - Enable scheduled read of PRU Dynamic Parameter characteristic of all PRUs.\r\n");
                     DBG_PRINTF(" \'9\' - Disable sequential read of PRU Dynamic Parameter characteristic.\r\n");
                     break;
             }
             command = 0u;
         }
+        
+        /* Configure the new PRUs, then poll the PRU Dynamic Parameter of the PRU that is due first */
+        if((command == 0u) && (customCommand == 0u) && (requestResponce != false))
+        {
+            WptsSchedule(readingDynChar);
+        }
     }
 }
 
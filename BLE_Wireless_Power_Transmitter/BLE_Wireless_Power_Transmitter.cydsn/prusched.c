@@ -0,0 +1,409 @@
+/*******************************************************************************
+* File Name: prusched.c
+*
+* Version 1.0
+*
+* Description:
+*  This file contains the PRU scheduler of the Power Transmitter Unit. Every
+*  connected PRU has an entry in the table that keeps its advertising data,
+*  its last Dynamic Parameter and its share of the PTU power:
+*
+*   - a PRU is admitted with the highest PRU Control power level that fits
+*     in the power left of the PTU budget, or denied when even the lowest
+*     level does not fit;
+*   - the Dynamic Parameter of the admitted PRUs is polled with a period
+*     that depends on how close the PRU is to its alert thresholds, so a
+*     PRU that raised an alert or whose VRECT is near the edges of its
+*     window is read every tick;
+*   - PruSchedNext() returns the PRU that is due with the shortest period,
+*     and among those the one that has waited longest, so the PRUs near
+*     their thresholds are served first and the others within a bounded
+*     delay.
+*
+*  The scheduler only depends on cytypes.h, so it is also built on the host.
+*
+* Hardware Dependency:
+*  CY8CKIT-042 BLE
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include "prusched.h"
+
+
+PRU_SCHED_T pruSched[PRU_SCHED_MAX];
+uint8 pruSchedCount = 0u;
+uint16 pruSchedBudget = 0u;
+uint16 pruSchedGranted = 0u;
+
+/* Share of PRECT_MAX of the power levels, 1/1000 */
+static const uint16 pruSchedLevelShare[PRU_SCHED_LEVEL_NUM] = {1000u, 660u, 330u, 25u};
+
+
+/*******************************************************************************
+* Function Name: PruSchedInit
+********************************************************************************
+*
+* Summary:
+*   Empties the PRU table.
+*
+* Parameters:
+*   budget - the power the PTU shares among the PRUs, mW.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void PruSchedInit(uint16 budget)
+{
+    uint8 i;
+
+    for(i = 0u; i < PRU_SCHED_MAX; i++)
+    {
+        pruSched[i].state = PRU_SCHED_FREE;
+    }
+    pruSchedCount = 0u;
+    pruSchedBudget = budget;
+    pruSchedGranted = 0u;
+}
+
+
+/*******************************************************************************
+* Function Name: PruSchedOpen
+********************************************************************************
+*
+* Summary:
+*   Takes an entry for the connected PRU.
+*
+* Parameters:
+*   bdHandle - the peer device handle.
+*   serviceHandle - the WPTS handle from the advertising data.
+*   advRssi - the RSSI parameter of the advertising data.
+*   advFlags - the flags of the advertising data.
+*
+* Return:
+*   The index of the PRU or PRU_SCHED_NONE when the table is full.
+*
+*******************************************************************************/
+uint8 PruSchedOpen(uint8 bdHandle, uint16 serviceHandle, uint8 advRssi, uint8 advFlags)
+{
+    PRU_SCHED_T *pru;
+    uint8 index = PruSchedFind(bdHandle);
+
+    if(PRU_SCHED_NONE != index)
+    {
+        /* The link has been replaced without the disconnect */
+        PruSchedClose(index);
+    }
+
+    index = 0u;
+    while((index < PRU_SCHED_MAX) && (PRU_SCHED_FREE != pruSched[index].state))
+    {
+        index++;
+    }
+
+    if(index < PRU_SCHED_MAX)
+    {
+        pru = &pruSched[index];
+        pru->state = PRU_SCHED_CONNECTED;
+        pru->bdHandle = bdHandle;
+        pru->serviceHandle = serviceHandle;
+        pru->advRssi = advRssi;
+        pru->advFlags = advFlags;
+        pru->alert = 0u;
+        pru->level = PRU_SCHED_LEVEL_MAX;
+        pru->temperature = PRU_SCHED_TEMP_NONE;
+        pru->vRect = 0u;
+        pru->iRect = 0u;
+        pru->vRectMin = 0u;
+        pru->vRectHigh = 0u;
+        pru->power = 0u;
+        pru->granted = 0u;
+        pru->period = PRU_SCHED_PERIOD_ALERT;
+        pru->due = 0u;
+        pru->polls = 0u;
+        pru->lateMax = 0u;
+        pruSchedCount++;
+    }
+    else
+    {
+        index = PRU_SCHED_NONE;
+    }
+
+    return(index);
+}
+
+
+/*******************************************************************************
+* Function Name: PruSchedClose
+********************************************************************************
+*
+* Summary:
+*   Frees the entry of the disconnected PRU and returns its power to the
+*   budget.
+*
+* Parameters:
+*   index - the index of the PRU.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void PruSchedClose(uint8 index)
+{
+    if((index < PRU_SCHED_MAX) && (PRU_SCHED_FREE != pruSched[index].state))
+    {
+        pruSchedGranted -= pruSched[index].granted;
+        pruSched[index].granted = 0u;
+        pruSched[index].state = PRU_SCHED_FREE;
+        pruSchedCount--;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: PruSchedFind
+********************************************************************************
+*
+* Summary:
+*   Finds the PRU by its link.
+*
+* Parameters:
+*   bdHandle - the peer device handle.
+*
+* Return:
+*   The index of the PRU or PRU_SCHED_NONE.
+*
+*******************************************************************************/
+uint8 PruSchedFind(uint8 bdHandle)
+{
+    uint8 i;
+    uint8 index = PRU_SCHED_NONE;
+
+    for(i = 0u; (i < PRU_SCHED_MAX) && (PRU_SCHED_NONE == index); i++)
+    {
+        if((PRU_SCHED_FREE != pruSched[i].state) && (pruSched[i].bdHandle == bdHandle))
+        {
+            index = i;
+        }
+    }
+
+    return(index);
+}
+
+
+/*******************************************************************************
+* Function Name: PruSchedAdmit
+********************************************************************************
+*
+* Summary:
+*   Grants the PRU the highest power level that fits in the power left of
+*   the budget. The admitted PRU is polled from the next tick.
+*
+* Parameters:
+*   index - the index of the PRU.
+*   power - PRECT_MAX of the PRU Static Parameter, mW.
+*   vRectMin - VRECT_MIN_STATIC of the PRU Static Parameter, mV.
+*   vRectHigh - VRECT_HIGH_STATIC of the PRU Static Parameter, mV.
+*   now - the scheduler tick.
+*
+* Return:
+*   The granted power level or PRU_SCHED_NONE when the PRU is denied.
+*
+*******************************************************************************/
+uint8 PruSchedAdmit(uint8 index, uint16 power, uint16 vRectMin, uint16 vRectHigh, uint32 now)
+{
+    PRU_SCHED_T *pru = &pruSched[index];
+    uint32 left;
+    uint32 share = 0u;
+    uint8 level;
+
+    /* The power of a repeated admission is granted again */
+    pruSchedGranted -= pru->granted;
+    pru->granted = 0u;
+    left = (uint32)pruSchedBudget - pruSchedGranted;
+
+    for(level = PRU_SCHED_LEVEL_MAX; level < PRU_SCHED_LEVEL_NUM; level++)
+    {
+        share = ((uint32)power * pruSchedLevelShare[level]) / 1000u;
+        if(share <= left)
+        {
+            break;
+        }
+    }
+
+    pru->power = power;
+    pru->vRectMin = vRectMin;
+    pru->vRectHigh = vRectHigh;
+    if(level < PRU_SCHED_LEVEL_NUM)
+    {
+        pru->state = PRU_SCHED_ADMITTED;
+        pru->level = level;
+        pru->granted = (uint16)share;
+        pruSchedGranted += pru->granted;
+        pru->period = PRU_SCHED_PERIOD_ALERT;
+        pru->due = now + 1u;
+    }
+    else
+    {
+        pru->state = PRU_SCHED_DENIED;
+        level = PRU_SCHED_NONE;
+    }
+
+    return(level);
+}
+
+
+/*******************************************************************************
+* Function Name: PruSchedUpdate
+********************************************************************************
+*
+* Summary:
+*   Stores the PRU Dynamic Parameter and sets the poll period from the
+*   distance of the PRU to its alert thresholds.
+*
+* Parameters:
+*   index - the index of the PRU.
+*   sample - the PRU Dynamic Parameter.
+*   now - the scheduler tick.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void PruSchedUpdate(uint8 index, const PRU_SCHED_SAMPLE_T *sample, uint32 now)
+{
+    PRU_SCHED_T *pru = &pruSched[index];
+    uint32 window;
+    uint32 margin;
+
+    pru->vRect = sample->vRect;
+    pru->iRect = sample->iRect;
+    pru->temperature = sample->temperature;
+    pru->alert = sample->alert;
+    if(0u != sample->vRectMin)
+    {
+        pru->vRectMin = sample->vRectMin;
+    }
+    if(0u != sample->vRectHigh)
+    {
+        pru->vRectHigh = sample->vRectHigh;
+    }
+
+    if((0u != (pru->alert & PRU_SCHED_ALERT_MASK)) || (pru->temperature >= PRU_SCHED_TEMP_WARN))
+    {
+        pru->period = PRU_SCHED_PERIOD_ALERT;
+    }
+    else if(pru->vRectHigh <= pru->vRectMin)
+    {
+        /* The PRU has not reported its VRECT window */
+        pru->period = PRU_SCHED_PERIOD_NOMINAL;
+    }
+    else if((pru->vRect < pru->vRectMin) || (pru->vRect > pru->vRectHigh))
+    {
+        pru->period = PRU_SCHED_PERIOD_ALERT;
+    }
+    else
+    {
+        window = (uint32)pru->vRectHigh - pru->vRectMin;
+        margin = (uint32)pru->vRect - pru->vRectMin;
+        if(((uint32)pru->vRectHigh - pru->vRect) < margin)
+        {
+            margin = (uint32)pru->vRectHigh - pru->vRect;
+        }
+        pru->period = ((margin * 100u) < (window * PRU_SCHED_MARGIN)) ? PRU_SCHED_PERIOD_NEAR :
+                                                                         PRU_SCHED_PERIOD_NOMINAL;
+    }
+    pru->due = now + pru->period;
+}
+
+
+/*******************************************************************************
+* Function Name: PruSchedAlert
+********************************************************************************
+*
+* Summary:
+*   Stores the PRU Alert notification. An alert of PRU_SCHED_ALERT_MASK
+*   makes the PRU due at once.
+*
+* Parameters:
+*   index - the index of the PRU.
+*   alert - the PRU Alert bits.
+*   now - the scheduler tick.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void PruSchedAlert(uint8 index, uint8 alert, uint32 now)
+{
+    PRU_SCHED_T *pru = &pruSched[index];
+
+    pru->alert = alert;
+    if(0u != (alert & PRU_SCHED_ALERT_MASK))
+    {
+        pru->period = PRU_SCHED_PERIOD_ALERT;
+        pru->due = now;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: PruSchedNext
+********************************************************************************
+*
+* Summary:
+*   Selects the PRU to poll: the due PRU with the shortest period, and among
+*   those the one that has waited longest. Its next poll is scheduled one
+*   period later, the Dynamic Parameter reschedules it from the response.
+*
+* Parameters:
+*   now - the scheduler tick.
+*
+* Return:
+*   The index of the PRU or PRU_SCHED_NONE when no PRU is due.
+*
+*******************************************************************************/
+uint8 PruSchedNext(uint32 now)
+{
+    PRU_SCHED_T *pru;
+    uint32 late;
+    uint32 bestLate = 0u;
+    uint8 i;
+    uint8 index = PRU_SCHED_NONE;
+
+    for(i = 0u; i < PRU_SCHED_MAX; i++)
+    {
+        pru = &pruSched[i];
+        late = now - pru->due;
+        if((PRU_SCHED_ADMITTED == pru->state) && ((int32)late >= 0))
+        {
+            if((PRU_SCHED_NONE == index) || (pru->period < pruSched[index].period) ||
+               ((pru->period == pruSched[index].period) && (late > bestLate)))
+            {
+                index = i;
+                bestLate = late;
+            }
+        }
+    }
+
+    if(PRU_SCHED_NONE != index)
+    {
+        pru = &pruSched[index];
+        if(bestLate > pru->lateMax)
+        {
+            pru->lateMax = bestLate;
+        }
+        pru->polls++;
+        pru->due = now + pru->period;
+    }
+
+    return(index);
+}
+
+
+/* [] END OF FILE */
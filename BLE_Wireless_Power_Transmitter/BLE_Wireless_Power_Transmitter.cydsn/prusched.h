@@ -0,0 +1,124 @@
+/*******************************************************************************
+* File Name: prusched.h
+*
+* Version 1.0
+*
+* Description:
+*  Contains the function prototypes and constants of the PRU scheduler of
+*  the Power Transmitter Unit.
+*
+*  The scheduler and the power budget keep their state per PRU, but the
+*  PSoC 4 BLE component holds one connection, so on this part one PRU is
+*  served at a time and only one entry of pruSched[] is in use.
+*
+* Hardware Dependency:
+*  CY8CKIT-042 BLE
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(PRUSCHED_H)
+#define PRUSCHED_H
+
+#include "cytypes.h"
+
+
+/***************************************
+*        Constants
+***************************************/
+#define PRU_SCHED_MAX               (3u)        /* PRU entries, one is in use on PSoC 4 BLE */
+#define PRU_SCHED_NONE              (0xFFu)     /* No PRU index */
+
+/* Poll periods of the PRU Dynamic Parameter, scheduler ticks */
+#define PRU_SCHED_PERIOD_ALERT      (1u)        /* Alert raised or VRECT out of its window */
+#define PRU_SCHED_PERIOD_NEAR       (2u)        /* VRECT within PRU_SCHED_MARGIN of the window edges */
+#define PRU_SCHED_PERIOD_NOMINAL    (4u)
+
+#define PRU_SCHED_MARGIN            (15u)       /* Margin to the VRECT window edges, % of the window */
+#define PRU_SCHED_TEMP_WARN         (60)        /* Temperature polled as an alert, deg C */
+#define PRU_SCHED_TEMP_NONE         (-128)      /* The temperature is not reported */
+
+/* Alert bits polled at PRU_SCHED_PERIOD_ALERT: over voltage, over current,
+*  over temperature and self protection.
+*/
+#define PRU_SCHED_ALERT_MASK        (0xF0u)
+
+/* PRU states */
+#define PRU_SCHED_FREE              (0u)
+#define PRU_SCHED_CONNECTED         (1u)        /* Waits for the PRU Static Parameter */
+#define PRU_SCHED_ADMITTED          (2u)        /* Power granted, the PRU is polled */
+#define PRU_SCHED_DENIED            (3u)        /* No power left for the PRU */
+
+/* Power levels of PruSchedAdmit(), the PRU Control adjust power steps */
+#define PRU_SCHED_LEVEL_MAX         (0u)        /* 100 % of PRECT_MAX */
+#define PRU_SCHED_LEVEL_66          (1u)
+#define PRU_SCHED_LEVEL_33          (2u)
+#define PRU_SCHED_LEVEL_2_5         (3u)
+#define PRU_SCHED_LEVEL_NUM         (4u)
+
+
+/***************************************
+*        Data Struct Definition
+***************************************/
+typedef struct
+{
+    uint16 vRect;               /* mV */
+    uint16 iRect;               /* mA */
+    uint16 vRectMin;            /* Dynamic VRECT_MIN, mV, 0 when not reported */
+    uint16 vRectHigh;           /* Dynamic VRECT_HIGH, mV, 0 when not reported */
+    int16  temperature;         /* deg C or PRU_SCHED_TEMP_NONE */
+    uint8  alert;               /* PRU Alert bits */
+} PRU_SCHED_SAMPLE_T;
+
+typedef struct
+{
+    uint8  state;
+    uint8  bdHandle;            /* Peer device handle */
+    uint16 serviceHandle;       /* WPTS handle from the advertising data */
+    uint8  advRssi;             /* RSSI parameter of the advertising data */
+    uint8  advFlags;            /* Flags of the advertising data */
+    uint8  alert;               /* The last PRU Alert bits */
+    uint8  level;               /* Granted power level, PRU_SCHED_LEVEL_ */
+    int16  temperature;         /* deg C or PRU_SCHED_TEMP_NONE */
+    uint16 vRect;               /* mV */
+    uint16 iRect;               /* mA */
+    uint16 vRectMin;            /* The alert window of VRECT, mV */
+    uint16 vRectHigh;
+    uint16 power;               /* Requested power, PRECT_MAX, mW */
+    uint16 granted;             /* Granted power, mW */
+    uint8  period;              /* Poll period, ticks */
+    uint32 due;                 /* Tick of the next poll */
+    uint32 polls;               /* Dynamic Parameter reads */
+    uint32 lateMax;             /* Longest delay of a poll past its due tick, ticks */
+} PRU_SCHED_T;
+
+
+/***************************************
+*      API Function Prototypes
+***************************************/
+void PruSchedInit(uint16 budget);
+uint8 PruSchedOpen(uint8 bdHandle, uint16 serviceHandle, uint8 advRssi, uint8 advFlags);
+void PruSchedClose(uint8 index);
+uint8 PruSchedFind(uint8 bdHandle);
+uint8 PruSchedAdmit(uint8 index, uint16 power, uint16 vRectMin, uint16 vRectHigh, uint32 now);
+void PruSchedUpdate(uint8 index, const PRU_SCHED_SAMPLE_T *sample, uint32 now);
+void PruSchedAlert(uint8 index, uint8 alert, uint32 now);
+uint8 PruSchedNext(uint32 now);
+
+
+/***************************************
+*      External data references
+***************************************/
+extern PRU_SCHED_T pruSched[PRU_SCHED_MAX];
+extern uint8 pruSchedCount;         /* Connected PRUs */
+extern uint16 pruSchedBudget;       /* Power budget of the PTU, mW */
+extern uint16 pruSchedGranted;      /* Power granted to the PRUs, mW */
+
+
+#endif /* PRUSCHED_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,336 @@
+/*******************************************************************************
+* File Name: scan.c
+*
+* Version 1.0
+*
+* Description:
+*  This file contains the scan engine of the central role. The advertising
+*  reports are kept in a small cache hashed by the address, so a report that
+*  repeats the cached data is rejected after the hash of its data, without
+*  walking the AD structures again:
+*
+*   - a new or changed report is matched against the filter, which is
+*     compiled once per scan into the bitmap of the AD types to inspect;
+*   - every report updates the smoothed RSSI of its entry;
+*   - an entry that is not reported for SCAN_AGE_OUT ticks is reused, and
+*     the address is reported as new again. When no entry is free, the
+*     oldest one is reused.
+*
+*  The engine only depends on cytypes.h, so it is also built on the host.
+*
+* Hardware Dependency:
+*  CY8CKIT-042 BLE
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include "scan.h"
+
+
+static SCAN_ENTRY_T scanCache[SCAN_CACHE_SIZE];
+static SCAN_FILTER_T scanFilter;
+static volatile uint32 scanClock = 0u;
+
+
+/*******************************************************************************
+* Function Name: ScanFilterUuid16
+********************************************************************************
+*
+* Summary:
+*   Compiles the filter that passes the data with the 16-bit UUID in the
+*   complete or incomplete service UUID list.
+*
+* Parameters:
+*   filter - the filter.
+*   uuid - the 16-bit UUID of the service.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void ScanFilterUuid16(SCAN_FILTER_T *filter, uint16 uuid)
+{
+    filter->adTypes = (1uL << AD_TYPE_INCOMPL_16UUID) | (1uL << AD_TYPE_COMPL_16UUID);
+    filter->uuid = uuid;
+    filter->minLen = SCAN_AD_UUID16_MIN_LEN;
+    filter->list = 1u;
+}
+
+
+/*******************************************************************************
+* Function Name: ScanFilterServiceData16
+********************************************************************************
+*
+* Summary:
+*   Compiles the filter that passes the data with the 16-bit UUID service
+*   data of the service.
+*
+* Parameters:
+*   filter - the filter.
+*   uuid - the 16-bit UUID of the service.
+*   minLen - the shortest service data AD structure, its length byte.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void ScanFilterServiceData16(SCAN_FILTER_T *filter, uint16 uuid, uint8 minLen)
+{
+    filter->adTypes = 1uL << AD_TYPE_SRVC_DATA_16UUID;
+    filter->uuid = uuid;
+    filter->minLen = (minLen > SCAN_AD_UUID16_MIN_LEN) ? minLen : SCAN_AD_UUID16_MIN_LEN;
+    filter->list = 0u;
+}
+
+
+/*******************************************************************************
+* Function Name: ScanStart
+********************************************************************************
+*
+* Summary:
+*   Empties the cache and sets the filter of the new scan, so the devices
+*   seen by the previous scan are reported again.
+*
+* Parameters:
+*   filter - the filter.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void ScanStart(const SCAN_FILTER_T *filter)
+{
+    uint32 i;
+
+    for(i = 0u; i < SCAN_CACHE_SIZE; i++)
+    {
+        scanCache[i].used = 0u;
+    }
+    scanFilter = *filter;
+}
+
+
+/*******************************************************************************
+* Function Name: ScanTick
+********************************************************************************
+*
+* Summary:
+*   Advances the scan clock that ages the cache out. Is called by the
+*   periodic timer interrupt.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void ScanTick(void)
+{
+    scanClock++;
+}
+
+
+/*******************************************************************************
+* Function Name: ScanMatch
+********************************************************************************
+*
+* Summary:
+*   Matches the advertising data against the filter. A structure that
+*   overruns the data ends the walk, the structures before it are matched.
+*
+* Parameters:
+*   data - the advertising data.
+*   dataLen - the length of the data.
+*
+* Return:
+*   The offset of the first AD structure that passes the filter or
+*   SCAN_NO_MATCH.
+*
+*******************************************************************************/
+static uint8 ScanMatch(const uint8 data[], uint8 dataLen)
+{
+    AD_ITER_T iter;
+    uint8 match = SCAN_NO_MATCH;
+
+    AdIterInit(&iter, data, dataLen);
+    while((SCAN_NO_MATCH == match) && (0u != AdIterNext(&iter)))
+    {
+        if(((iter.len + 1u) >= scanFilter.minLen) && (iter.type < 32u) &&
+           (0u != (scanFilter.adTypes & (1uL << iter.type))))
+        {
+            /* A list is searched, the service data starts with the UUID */
+            if(0u != AdFindUuid16(iter.value, (0u != scanFilter.list) ? iter.len : AD_UUID16_SIZE, scanFilter.uuid))
+            {
+                match = iter.offset;
+            }
+        }
+    }
+
+    return(match);
+}
+
+
+/*******************************************************************************
+* Function Name: ScanHash
+********************************************************************************
+*
+* Summary:
+*   Calculates the hash of the advertising data.
+*
+* Parameters:
+*   data - the advertising data.
+*   dataLen - the length of the data.
+*
+* Return:
+*   The hash.
+*
+*******************************************************************************/
+static uint16 ScanHash(const uint8 data[], uint8 dataLen)
+{
+    uint32 hash = dataLen;
+    uint32 i;
+
+    for(i = 0u; i < dataLen; i++)
+    {
+        hash = ((hash << 5u) | (hash >> 11u)) & 0xFFFFu;
+        hash ^= data[i];
+    }
+
+    return((uint16)hash);
+}
+
+
+/*******************************************************************************
+* Function Name: ScanReport
+********************************************************************************
+*
+* Summary:
+*   Looks the report up in the cache. The entry of the address is probed
+*   from its hash up to the first entry that has never been taken. A new or
+*   changed report is matched against the filter, a duplicate one keeps the
+*   cached match.
+*
+* Parameters:
+*   bdAddr - the address of the advertiser.
+*   type - SCAN_TYPE() of the report.
+*   rssi - the RSSI of the report, dBm.
+*   data - the advertising data.
+*   dataLen - the length of the data.
+*   result - returns SCAN_REPORT_NEW, SCAN_REPORT_CHANGED or
+*            SCAN_REPORT_DUPLICATE.
+*
+* Return:
+*   The entry of the report, its match is the offset of the AD structure
+*   that passed the filter or SCAN_NO_MATCH.
+*
+*******************************************************************************/
+SCAN_ENTRY_T *ScanReport(const uint8 bdAddr[], uint8 type, int8 rssi, const uint8 data[], uint8 dataLen,
+                         uint8 *result)
+{
+    uint32 now = scanClock;
+    uint32 hash = type;
+    uint32 found = SCAN_CACHE_SIZE;
+    uint32 spare = SCAN_CACHE_SIZE;
+    uint32 oldest = SCAN_CACHE_SIZE;
+    uint32 index;
+    uint32 i;
+    SCAN_ENTRY_T *entry;
+    uint16 dataHash;
+
+    for(i = 0u; i < SCAN_BD_ADDR_SIZE; i++)
+    {
+        hash ^= bdAddr[i];
+    }
+    hash ^= hash >> 4u;
+
+    for(i = 0u; (i < SCAN_CACHE_SIZE) && (SCAN_CACHE_SIZE == found); i++)
+    {
+        index = (hash + i) & SCAN_CACHE_MASK;
+        entry = &scanCache[index];
+        if(0u == entry->used)
+        {
+            if(SCAN_CACHE_SIZE == spare)
+            {
+                spare = index;
+            }
+            break;
+        }
+
+        if((entry->bdAddr[0u] == bdAddr[0u]) && (entry->type == type) &&
+           (entry->bdAddr[1u] == bdAddr[1u]) && (entry->bdAddr[2u] == bdAddr[2u]) &&
+           (entry->bdAddr[3u] == bdAddr[3u]) && (entry->bdAddr[4u] == bdAddr[4u]) &&
+           (entry->bdAddr[5u] == bdAddr[5u]))
+        {
+            found = index;
+        }
+        else if((now - entry->seen) >= SCAN_AGE_OUT)
+        {
+            if(SCAN_CACHE_SIZE == spare)
+            {
+                spare = index;
+            }
+        }
+        else if((SCAN_CACHE_SIZE == oldest) || ((now - entry->seen) > (now - scanCache[oldest].seen)))
+        {
+            oldest = index;
+        }
+        else
+        {
+            /* The entry of another live report */
+        }
+    }
+
+    dataHash = ScanHash(data, dataLen);
+    if((SCAN_CACHE_SIZE != found) && ((now - scanCache[found].seen) < SCAN_AGE_OUT))
+    {
+        entry = &scanCache[found];
+        if((entry->dataLen == dataLen) && (entry->dataHash == dataHash))
+        {
+            *result = SCAN_REPORT_DUPLICATE;
+        }
+        else
+        {
+            *result = SCAN_REPORT_CHANGED;
+        }
+        entry->rssi += (int16)((((int16)rssi * 16) - entry->rssi) / 4);
+        if(entry->reports < 0xFFFFu)
+        {
+            entry->reports++;
+        }
+    }
+    else
+    {
+        if(SCAN_CACHE_SIZE == found)
+        {
+            found = (SCAN_CACHE_SIZE != spare) ? spare : oldest;
+        }
+        entry = &scanCache[found];
+        for(i = 0u; i < SCAN_BD_ADDR_SIZE; i++)
+        {
+            entry->bdAddr[i] = bdAddr[i];
+        }
+        entry->type = type;
+        entry->used = 1u;
+        entry->rssi = (int16)rssi * 16;
+        entry->reports = 1u;
+        *result = SCAN_REPORT_NEW;
+    }
+
+    entry->seen = now;
+    if(SCAN_REPORT_DUPLICATE != *result)
+    {
+        entry->dataLen = dataLen;
+        entry->dataHash = dataHash;
+        entry->match = ScanMatch(data, dataLen);
+    }
+
+    return(entry);
+}
+
+
+/* [] END OF FILE */
@@ -26,13 +26,26 @@ uint16 powerSimulation;
 uint16 powerCPResponce;
 
 extern CYBLE_PEER_DEVICE_INFO_T peedDeviceInfo[CYBLE_MAX_ADV_DEVICES];
-extern uint8 deviceN;
 extern uint8 customCommand;
 extern bool requestResponce;
-extern uint8 state;
 
 CYBLE_PTU_STATIC_PAR_T ptuStaticPar;
 
+/* WPTS client data of the PRUs, indexed as pruSched */
+WPTS_PRU_T wptsPru[PRU_SCHED_MAX];
+
+/* The PRU of the last request, its discovery data is loaded in cyBle_wptsc */
+static uint8 wptsReqPru = PRU_SCHED_NONE;
+
+/* PRU Control adjust power bits of the PRU_SCHED_LEVEL_ power levels */
+static const uint8 wptsAdjustPower[PRU_SCHED_LEVEL_NUM] =
+{
+    PRU_CONTROL_ENABLES_ADJUST_POWER_MAX,
+    PRU_CONTROL_ENABLES_ADJUST_POWER_66,
+    PRU_CONTROL_ENABLES_ADJUST_POWER_33,
+    PRU_CONTROL_ENABLES_ADJUST_POWER_2_5
+};
+
 
 /*******************************************************************************
 * Function Name: WptsCallBack()
@@ -54,36 +67,50 @@ void WptsCallBack (uint32 event, void *eventParam)
 {
     CYBLE_WPTS_CHAR_VALUE_T *eventPar = (CYBLE_WPTS_CHAR_VALUE_T *)eventParam;
     CYBLE_WPTS_DESCR_VALUE_T *descrValue = (CYBLE_WPTS_DESCR_VALUE_T *)eventParam;
-    CYBLE_API_RESULT_T apiResult = CYBLE_ERROR_OK;
+    uint8 pru;
+    uint8 level;
     
     switch(event)
     {
         case CYBLE_EVT_WPTSC_NOTIFICATION:
             DBG_PRINTF("CYBLE_EVT_WPTSC_NOTIFICATION charIndex= #%d Value= ", eventPar->charIndex);
             ShowValue(eventPar->value, 0u);
+            pru = PruSchedFind(eventPar->connHandle.bdHandle);
+            if((eventPar->charIndex == CYBLE_WPTS_PRU_ALERT) && (pru != PRU_SCHED_NONE))
+            {
+                /* The alerting PRU is polled first */
+                PruSchedAlert(pru, eventPar->value->val[0u], mainTimer);
+            }
             break;
         case CYBLE_EVT_WPTSC_INDICATION:
             DBG_PRINTF("CYBLE_EVT_WPTSC_INDICATION charIndex= #%d Value= ", eventPar->charIndex);
             ShowValue(eventPar->value, 0u);
+            pru = PruSchedFind(eventPar->connHandle.bdHandle);
+            if((eventPar->charIndex == CYBLE_WPTS_PRU_ALERT) && (pru != PRU_SCHED_NONE))
+            {
+                PruSchedAlert(pru, eventPar->value->val[0u], mainTimer);
+            }
             break;
         case CYBLE_EVT_WPTSC_WRITE_CHAR_RESPONSE:
             requestResponce = true;
             DBG_PRINTF("CYBLE_EVT_WPTSC_WRITE_CHAR_RESPONSE: charIndex =%x \r\n", eventPar->charIndex);
-            if((state == STATE_CONNECTED) && (eventPar->charIndex == CYBLE_WPTS_PTU_STATIC_PAR))
+            pru = PruSchedFind(eventPar->connHandle.bdHandle);
+            if((pru != PRU_SCHED_NONE) && (wptsPru[pru].step == WPTS_STEP_WRITE_STATIC) &&
+               (eventPar->charIndex == CYBLE_WPTS_PTU_STATIC_PAR))
             {
                 /* Enable Notification */
-                customCommand = '1';
+                wptsPru[pru].step = WPTS_STEP_ENABLE_ALERT;
             }
             break;
         case CYBLE_EVT_WPTSC_READ_CHAR_RESPONSE:
             requestResponce = true;
+            pru = PruSchedFind(eventPar->connHandle.bdHandle);
             /* Parse static characteristic value */
             if(eventPar->charIndex == CYBLE_WPTS_PRU_STATIC_PAR)
             {
                 CYBLE_PRU_STATIC_PAR_T pruStaticPar;
                 
                 pruStaticPar = *(CYBLE_PRU_STATIC_PAR_T *)(((CYBLE_WPTS_CHAR_VALUE_T *)eventParam)->value->val);
-                peedDeviceInfo[deviceN].pruStaticPar = pruStaticPar;
                 DBG_PRINTF("PRU_STATIC_PARAMETER: flags: %x, protocol rev: %d, ", 
                     pruStaticPar.flags, pruStaticPar.protocolRev);
                 DBG_PRINTF("category: Category %d , ", pruStaticPar.pruCategory);
@@ -98,12 +125,31 @@ void WptsCallBack (uint32 event, void *eventParam)
                 {
                     DBG_PRINTF("deltaR1: %.2f ohms\r\n", (float)pruStaticPar.deltaR1 * PRU_STATIC_PAR_DELTA_R1_MULT);
                 }
-                if(state == STATE_CONNECTED)
+                if(pru != PRU_SCHED_NONE)
                 {
-                    apiResult = CyBle_WptscSetCharacteristicValue(cyBle_connHandle, CYBLE_WPTS_PTU_STATIC_PAR, 
-                        sizeof(ptuStaticPar), (uint8 *)&ptuStaticPar);
-                    (void)apiResult;
-                    DBG_PRINTF("Set PTU Static Parameter char value, apiResult: %x \r\n", apiResult);
+                    wptsPru[pru].info.pruStaticPar = pruStaticPar;
+                    
+                    /* Share the PTU power: grant the highest level that fits in the power left */
+                    level = PruSchedAdmit(pru, (uint16)(pruStaticPar.pRectMax * PRU_STATIC_PAR_PREACT_MAX_MULT),
+                        pruStaticPar.vRectMinStatic, pruStaticPar.vRectHighStatic, mainTimer);
+                    if(level != PRU_SCHED_NONE)
+                    {
+                        wptsPru[pru].info.pruControl.permission = PRU_CONTROL_PERMISSION_PERMITTED;
+                        wptsPru[pru].info.pruControl.enables = wptsAdjustPower[level];
+                    }
+                    else
+                    {
+                        wptsPru[pru].info.pruControl.permission = PRU_CONTROL_PERMISSION_DENIED_LIMITED_POWER;
+                        wptsPru[pru].info.pruControl.enables = 0u;
+                    }
+                    DBG_PRINTF("PRU %d power: granted %d mW, PTU granted %d of %d mW \r\n", pru,
+                        pruSched[pru].granted, pruSchedGranted, pruSchedBudget);
+                    
+                    if(wptsPru[pru].step == WPTS_STEP_READ_STATIC)
+                    {
+                        /* Write the PTU Static Parameter next */
+                        wptsPru[pru].step = WPTS_STEP_WRITE_STATIC;
+                    }
                 }
             }
             else if(eventPar->charIndex == CYBLE_WPTS_PRU_DYNAMIC_PAR)
@@ -138,10 +184,21 @@ void WptsCallBack (uint32 event, void *eventParam)
                     DBG_PRINTF("VrectHighDyn: %d mV, ", pruDynamicPar.vRectHighDyn);
                 }
                 DBG_PRINTF("Alert: %x.\r\n", pruDynamicPar.alert);
-                /* Congifuration is done */
-                if(state == STATE_CONNECTED) 
+                if(pru != PRU_SCHED_NONE)
                 {
-                    state = STATE_CONFIGURED;
+                    PRU_SCHED_SAMPLE_T sample;
+                    
+                    sample.vRect = pruDynamicPar.vRect;
+                    sample.iRect = pruDynamicPar.iRect;
+                    sample.vRectMin = ((pruDynamicPar.flags & PRU_DYNAMIC_PAR_FLAGS_VREACT_MIN_EN) != 0u) ?
+                        pruDynamicPar.vRectMinDyn : 0u;
+                    sample.vRectHigh = ((pruDynamicPar.flags & PRU_DYNAMIC_PAR_FLAGS_VREACT_HIGH_EN) != 0u) ?
+                        pruDynamicPar.vRectHighDyn : 0u;
+                    sample.temperature = ((pruDynamicPar.flags & PRU_DYNAMIC_PAR_FLAGS_TEMPERATURE_EN) != 0u) ?
+                        ((int16)pruDynamicPar.temperature - PRU_DYNAMIC_PAR_TEMPERATURE_OFFSET) : PRU_SCHED_TEMP_NONE;
+                    sample.alert = pruDynamicPar.alert;
+                    /* The poll period follows the distance to the alert thresholds */
+                    PruSchedUpdate(pru, &sample, mainTimer);
                 }
             }
             else
@@ -161,9 +218,13 @@ void WptsCallBack (uint32 event, void *eventParam)
         case CYBLE_EVT_WPTSC_WRITE_DESCR_RESPONSE:
             requestResponce = true;
             DBG_PRINTF("CYBLE_EVT_WPTSC_WRITE_DESCR_RESPONSE charIndex =%x \r\n", eventPar->charIndex);
-            if((state == STATE_CONNECTED) && (eventPar->charIndex == CYBLE_WPTS_PRU_ALERT))
+            pru = PruSchedFind(eventPar->connHandle.bdHandle);
+            if((pru != PRU_SCHED_NONE) && (wptsPru[pru].step == WPTS_STEP_ENABLE_ALERT) &&
+               (eventPar->charIndex == CYBLE_WPTS_PRU_ALERT))
             {
-                /* Enable reading of PRU dynamic characteristic */
+                /* Configuration is done, enable reading of PRU dynamic characteristic */
+                wptsPru[pru].step = WPTS_STEP_DONE;
+                wptsPru[pru].state = STATE_CONFIGURED;
                 customCommand = '8';
             }
             break;
@@ -190,7 +251,10 @@ void WptsInit(void)
     /* Register service specific callback function */
     CyBle_WptsRegisterAttrCallback(WptsCallBack);
     
+    PruSchedInit(PTU_POWER_BUDGET);
+    
     (void)memset(&peedDeviceInfo, 0, sizeof(peedDeviceInfo));
+    (void)memset(&wptsPru, 0, sizeof(wptsPru));
     
     /* Init PTU static parameters */
     ptuStaticPar.flags = PTU_STATIC_PAR_FLAGS_MAX_IMPEDANCE_EN | PTU_STATIC_PAR_FLAGS_MAX_RESISTANCE_EN;
@@ -201,7 +265,7 @@ void WptsInit(void)
     ptuStaticPar.hardwareRev = PRU_STATIC_PAR_HARDW_REV_DEF;
     ptuStaticPar.firmwareRev = PRU_STATIC_PAR_FW_REV_DEF;
     ptuStaticPar.protocolRev = PRU_STATIC_PAR_PROTOCOL_REV_DEF;
-    ptuStaticPar.ptuDevNumber = 1u - PTU_STATIC_PAR_NUMBER_OF_DEVICES_OFFSET;
+    ptuStaticPar.ptuDevNumber = PTU_STATIC_PAR_NUMBER_OF_DEVICES - PTU_STATIC_PAR_NUMBER_OF_DEVICES_OFFSET;
     
 }
 
@@ -224,28 +288,315 @@ Return:
 uint32 WptsScanProcessEventHandler(CYBLE_GAPC_ADV_REPORT_T *eventParam, CYBLE_PRU_ADV_SERVICE_DATA_T *serviceData)
 {
     uint32 servicePresent = 0u; 
-    uint32 advIndex = 0u;
+    AD_ITER_T iter;
+    const uint8 *adStruct;
     
-    do
+    AdIterInit(&iter, eventParam->data, eventParam->dataLen);
+    while((servicePresent == 0u) && (AdIterNext(&iter) != 0u))
     {
-        /* Find Service Data AD type with WPT service UUID. */
-        if((eventParam->data[advIndex] >= PRU_ADV_SERV_DATA_LEN) &&
-           (eventParam->data[advIndex + PRU_ADV_SERV_DATA_TYPE_OFFSET] == (uint8)CYBLE_GAP_ADV_SRVC_DATA_16UUID) &&
-           (CyBle_Get16ByPtr(&eventParam->data[advIndex + PRU_ADV_SERV_DATA_SERV_OFFSET]) == 
-                CYBLE_UUID_WIRELESS_POWER_TRANSFER_SERVICE)
-           )
+        /* Find Service Data AD type with WPT service UUID. The iterator has checked the structure 
+        *  against the data length, so the offsets are relative to its length byte.
+        */
+        adStruct = &eventParam->data[iter.offset];
+        if(((iter.len + 1u) >= PRU_ADV_SERV_DATA_LEN) &&
+           (iter.type == (uint8)CYBLE_GAP_ADV_SRVC_DATA_16UUID) &&
+           (CyBle_Get16ByPtr(&adStruct[PRU_ADV_SERV_DATA_SERV_OFFSET]) == CYBLE_UUID_WIRELESS_POWER_TRANSFER_SERVICE))
         {
-            serviceData->wptsServiceHandle = CyBle_Get16ByPtr(&eventParam->data[advIndex + PRU_ADV_SERV_DATA_HANDLE_OFFSET]);
-            serviceData->rssi = eventParam->data[advIndex + PRU_ADV_SERV_DATA_RSSI_OFFSET];
-            serviceData->flags = eventParam->data[advIndex + PRU_ADV_SERV_DATA_FLAGS_OFFSET];
+            serviceData->wptsServiceHandle = CyBle_Get16ByPtr(&adStruct[PRU_ADV_SERV_DATA_HANDLE_OFFSET]);
+            serviceData->rssi = adStruct[PRU_ADV_SERV_DATA_RSSI_OFFSET];
+            serviceData->flags = adStruct[PRU_ADV_SERV_DATA_FLAGS_OFFSET];
             servicePresent = 1u;
-            break;
         }
-        advIndex += eventParam->data[advIndex] + 1u;
-    }while(advIndex < eventParam->dataLen);    
+    }
     
     return(servicePresent);
 }
 
+
+/*******************************************************************************
+* Function Name: WptsLoad
+********************************************************************************
+*
+* Summary:
+*  Loads the WPTS discovery data of the PRU into the one of the stack before a
+*  request to the PRU. The requests go one at a time, so the response is
+*  matched against the discovery data of the PRU that sent it.
+*
+* Parameters:
+*  pru - the index of the PRU in pruSched.
+*
+*******************************************************************************/
+static void WptsLoad(uint8 pru)
+{
+    cyBle_wptsc = wptsPru[pru].wptsc;
+    wptsReqPru = pru;
+}
+
+
+/*******************************************************************************
+* Function Name: WptsOpen
+********************************************************************************
+*
+* Summary:
+*  Opens the scheduler entry of a connected PRU and keeps its connection
+*  handle and the data of its advertising. The WPTS discovery data of the PRU
+*  is taken from the WPTS handle of the advertising data when there is one,
+*  otherwise the standard discovery is the first configuration step. Is
+*  called on CYBLE_EVT_GATT_CONNECT_IND.
+*
+* Parameters:
+*  connHandle - the connection handle of the PRU.
+*  peer - the data of the PRU collected from its advertising.
+*  device - the index of the PRU in the list of the advertisers.
+*
+* Return:
+*  The index of the PRU in pruSched or PRU_SCHED_NONE when all the entries are
+*  taken.
+*
+*******************************************************************************/
+uint8 WptsOpen(CYBLE_CONN_HANDLE_T connHandle, const CYBLE_PEER_DEVICE_INFO_T *peer, uint8 device)
+{
+    CYBLE_WPTSC_T loaded;
+    uint8 pru;
+    uint8 i;
+    
+    pru = PruSchedOpen(connHandle.bdHandle, peer->peerAdvServData.wptsServiceHandle, peer->peerAdvServData.rssi, 
+        peer->peerAdvServData.flags);
+    if(pru != PRU_SCHED_NONE)
+    {
+        (void)memset(&wptsPru[pru], 0, sizeof(wptsPru[pru]));
+        wptsPru[pru].connHandle = connHandle;
+        wptsPru[pru].state = STATE_CONNECTED;
+        wptsPru[pru].device = device;
+        wptsPru[pru].info = *peer;
+        
+        if(peer->peerAdvServData.wptsServiceHandle != 0u)
+        {
+            /* Use quick discovery method based on WPT service handle received in the advertising packet, 
+            *  the discovery data of the PRU that waits for a response is kept.
+            */
+            loaded = cyBle_wptsc;
+            CyBle_WptscDiscovery(peer->peerAdvServData.wptsServiceHandle);
+            wptsPru[pru].wptsc = cyBle_wptsc;
+            cyBle_wptsc = loaded;
+            
+            DBG_PRINTF("PRU %d WPTS %x: ", pru, wptsPru[pru].wptsc.serviceHandle);
+            for(i = 0u; i < CYBLE_WPTS_CHAR_COUNT; i++)
+            {
+                DBG_PRINTF("Char %x=%x ", i, wptsPru[pru].wptsc.charInfo[i].valueHandle);
+            }
+            DBG_PRINTF("\r\n");
+            /* Initiate to read PRU Static Parameter characteristic value */
+            wptsPru[pru].step = WPTS_STEP_READ_STATIC;
+        }
+        else
+        {
+            /* When the service handle is unknown, use the standard discovery procedure */
+            wptsPru[pru].step = WPTS_STEP_DISCOVER;
+        }
+    }
+    
+    return(pru);
+}
+
+
+/*******************************************************************************
+* Function Name: WptsDiscoveryComplete
+********************************************************************************
+*
+* Summary:
+*  Keeps the WPTS discovery data of the PRU that was discovered. Is called on
+*  CYBLE_EVT_GATTC_DISCOVERY_COMPLETE.
+*
+*******************************************************************************/
+void WptsDiscoveryComplete(void)
+{
+    requestResponce = true;
+    if((wptsReqPru != PRU_SCHED_NONE) && (pruSched[wptsReqPru].state != PRU_SCHED_FREE))
+    {
+        wptsPru[wptsReqPru].wptsc = cyBle_wptsc;
+        
+        /* Start configuration procedure */
+        if(wptsPru[wptsReqPru].step == WPTS_STEP_DISCOVER)
+        {
+            wptsPru[wptsReqPru].step = WPTS_STEP_READ_STATIC;
+        }
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: WptsHandleValueNtf
+********************************************************************************
+*
+* Summary:
+*  Handles the PRU Alert notification or indication of a PRU whose handles
+*  differ from the discovery data loaded in the stack, which passes it to the
+*  application as CYBLE_EVT_GATTC_HANDLE_VALUE_NTF or _IND.
+*
+* Parameters:
+*  ntfParam - the parameter of the event.
+*
+*******************************************************************************/
+void WptsHandleValueNtf(const CYBLE_GATTC_HANDLE_VALUE_NTF_PARAM_T *ntfParam)
+{
+    uint8 pru = PruSchedFind(ntfParam->connHandle.bdHandle);
+    
+    if((pru != PRU_SCHED_NONE) && (ntfParam->handleValPair.value.len != 0u) &&
+       (ntfParam->handleValPair.attrHandle == wptsPru[pru].wptsc.charInfo[CYBLE_WPTS_PRU_ALERT].valueHandle))
+    {
+        PruSchedAlert(pru, ntfParam->handleValPair.value.val[0u], mainTimer);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: WptsSelect
+********************************************************************************
+*
+* Summary:
+*  Finds the PRU of an advertiser for a command and loads its WPTS discovery
+*  data.
+*
+* Parameters:
+*  device - the index of the advertiser.
+*
+* Return:
+*  The index of the PRU in pruSched or PRU_SCHED_NONE when the advertiser is
+*  not connected.
+*
+*******************************************************************************/
+uint8 WptsSelect(uint8 device)
+{
+    uint8 pru = 0u;
+    
+    while((pru < PRU_SCHED_MAX) && ((pruSched[pru].state == PRU_SCHED_FREE) || (wptsPru[pru].device != device)))
+    {
+        pru++;
+    }
+    
+    if(pru < PRU_SCHED_MAX)
+    {
+        WptsLoad(pru);
+    }
+    else
+    {
+        DBG_PRINTF("Device %d is not connected \r\n", device);
+        pru = PRU_SCHED_NONE;
+    }
+    
+    return(pru);
+}
+
+
+/*******************************************************************************
+* Function Name: WptsSchedule
+********************************************************************************
+*
+* Summary:
+*  Sends the next configuration request of a connected PRU. When all the PRUs
+*  are configured, sends the Read request for the PRU Dynamic Parameter
+*  characteristic of the PRU that is due first. Is called when no other
+*  request is pending.
+*
+* Parameters:
+*  poll - non-zero when the PRU Dynamic Parameter is read.
+*
+*******************************************************************************/
+void WptsSchedule(uint8 poll)
+{
+    CYBLE_API_RESULT_T apiResult = CYBLE_ERROR_OK;
+    uint8 pru = 0u;
+    
+    while((pru < PRU_SCHED_MAX) && ((pruSched[pru].state == PRU_SCHED_FREE) || (wptsPru[pru].step == WPTS_STEP_DONE)))
+    {
+        pru++;
+    }
+    
+    if(pru < PRU_SCHED_MAX)
+    {
+        WptsLoad(pru);
+        switch(wptsPru[pru].step)
+        {
+            case WPTS_STEP_DISCOVER:
+                /* The stack discovers into its own data, it is kept by WptsDiscoveryComplete() */
+                apiResult = CyBle_GattcStartDiscovery(wptsPru[pru].connHandle);
+                DBG_PRINTF("PRU %d StartDiscovery, apiResult: %x \r\n", pru, apiResult);
+                break;
+            case WPTS_STEP_READ_STATIC:
+                apiResult = CyBle_WptscGetCharacteristicValue(wptsPru[pru].connHandle, CYBLE_WPTS_PRU_STATIC_PAR);
+                DBG_PRINTF("Get PRU %d Static Parameter char value, apiResult: %x \r\n", pru, apiResult);
+                break;
+            case WPTS_STEP_WRITE_STATIC:
+                apiResult = CyBle_WptscSetCharacteristicValue(wptsPru[pru].connHandle, CYBLE_WPTS_PTU_STATIC_PAR, 
+                    sizeof(ptuStaticPar), (uint8 *)&ptuStaticPar);
+                DBG_PRINTF("Set PRU %d PTU Static Parameter char value, apiResult: %x \r\n", pru, apiResult);
+                break;
+            default:
+                wptsPru[pru].alertCCCD |= CYBLE_CCCD_NOTIFICATION;
+                apiResult = CyBle_WptscSetCharacteristicDescriptor(wptsPru[pru].connHandle, CYBLE_WPTS_PRU_ALERT,  
+                    CYBLE_WPTS_CCCD, sizeof(wptsPru[pru].alertCCCD), (uint8 *)&wptsPru[pru].alertCCCD);
+                DBG_PRINTF("Enable PRU %d Alert Notification, apiResult: %x \r\n", pru, apiResult);
+                break;
+        }
+    }
+    else if(poll != 0u)
+    {
+        pru = PruSchedNext(mainTimer);
+        if(pru != PRU_SCHED_NONE)
+        {
+            WptsLoad(pru);
+            apiResult = CyBle_WptscGetCharacteristicValue(wptsPru[pru].connHandle, CYBLE_WPTS_PRU_DYNAMIC_PAR);
+            if(apiResult != CYBLE_ERROR_OK)
+            {
+                DBG_PRINTF("Get PRU %d Dynamic Parameter char value, apiResult: %x \r\n", pru, apiResult);
+            }
+        }
+    }
+    else
+    {
+        pru = PRU_SCHED_NONE;
+    }
+    
+    if((pru != PRU_SCHED_NONE) && (apiResult == CYBLE_ERROR_OK))
+    {
+        requestResponce = false;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: WptsPurge
+********************************************************************************
+*
+* Summary:
+*  Removes the PRUs whose link is disconnected and returns their power to the
+*  PTU budget. A request pending to a removed PRU is dropped. Is called on
+*  CYBLE_EVT_GAP_DEVICE_DISCONNECTED.
+*
+*******************************************************************************/
+void WptsPurge(void)
+{
+    CYBLE_GAP_BD_ADDR_T bdAddr;
+    uint8 i;
+    
+    for(i = 0u; i < PRU_SCHED_MAX; i++)
+    {
+        if((pruSched[i].state != PRU_SCHED_FREE) &&
+           (CyBle_GapGetPeerBdAddr(pruSched[i].bdHandle, &bdAddr) != CYBLE_ERROR_OK))
+        {
+            DBG_PRINTF("PRU %d removed, polls: %ld, max delay: %ld s \r\n", i, pruSched[i].polls, pruSched[i].lateMax);
+            PruSchedClose(i);
+            wptsPru[i].state = STATE_DISCONNECTED;
+            if(i == wptsReqPru)
+            {
+                /* Its response will not come */
+                requestResponce = true;
+                wptsReqPru = PRU_SCHED_NONE;
+            }
+        }
+    }
+}
+
 /* [] END OF FILE */
 
@@ -19,6 +19,7 @@
     
 #include <project.h>
 #include "common.h"
+#include "prusched.h"
 
 
 /***************************************
@@ -99,6 +100,18 @@ typedef struct
     CYBLE_PRU_STATIC_PAR_T pruStaticPar;
 }CYBLE_PEER_DEVICE_INFO_T;
 
+/* WPTS client data of a connected PRU, kept for every entry of pruSched */
+typedef struct
+{
+    CYBLE_CONN_HANDLE_T connHandle;
+    uint8 state;                                    /* STATE_CONNECTED until the configuration is done */
+    uint8 step;                                     /* Next configuration request, WPTS_STEP_ */
+    uint8 device;                                   /* Index of the PRU in the list of the advertisers */
+    uint16 alertCCCD;
+    CYBLE_PEER_DEVICE_INFO_T info;
+    CYBLE_WPTSC_T wptsc;                            /* WPTS client discovery data of the PRU */
+}WPTS_PRU_T;
+
 /***************************************
 *          Constants
 ***************************************/
@@ -107,6 +120,13 @@ typedef struct
 #define PRU_ALERT_NOTIFICATION_ENABLE                       (1u)
 #define PRU_ALERT_INDICATION_ENABLE                         (2u)
 
+/* Configuration steps of a connected PRU, the requests are sent by WptsSchedule() */
+#define WPTS_STEP_DISCOVER                                  (0u)        /* The WPTS handle was not advertised */
+#define WPTS_STEP_READ_STATIC                               (1u)        /* Read the PRU Static Parameter */
+#define WPTS_STEP_WRITE_STATIC                              (2u)        /* Write the PTU Static Parameter */
+#define WPTS_STEP_ENABLE_ALERT                              (3u)        /* Enable the PRU Alert notifications */
+#define WPTS_STEP_DONE                                      (4u)
+
 #define PRU_CONTROL_ENABLES_ENABLE_PRU_OUTPUT               (0x80u)
 #define PRU_CONTROL_ENABLES_ENABLE_CHARGE_INDICATOR         (0x40u)
 #define PRU_CONTROL_ENABLES_ADJUST_POWER_MASK               (0x30u)
@@ -142,6 +162,7 @@ typedef struct
 #define PTU_STATIC_PAR_MAX_LOAD_RESISTANCE_STEP             (5u)
 
 #define PTU_STATIC_PAR_NUMBER_OF_DEVICES_OFFSET             (1u)
+#define PTU_STATIC_PAR_NUMBER_OF_DEVICES                    (1u)        /* The PSoC 4 BLE component holds one connection */
 
 #define PTU_STATIC_PAR_CLASS_OFFSET                         (1u)
 
@@ -185,12 +206,26 @@ typedef struct
 #define PRU_STATIC_PAR_FW_REV_DEF                           (32u)      
 #define PRU_STATIC_PAR_PROTOCOL_REV_DEF                     (0u)      
 
+#define PTU_POWER_BUDGET                                    (22000u)    /* Power shared among the PRUs, mW (Class 4) */
+
 /***************************************
 *       Function Prototypes
 ***************************************/
 void WptsInit(void);
 void WptsCallBack(uint32 event, void *eventParam);
 uint32 WptsScanProcessEventHandler(CYBLE_GAPC_ADV_REPORT_T *eventParam, CYBLE_PRU_ADV_SERVICE_DATA_T *serviceData);
+uint8 WptsOpen(CYBLE_CONN_HANDLE_T connHandle, const CYBLE_PEER_DEVICE_INFO_T *peer, uint8 device);
+void WptsDiscoveryComplete(void);
+void WptsHandleValueNtf(const CYBLE_GATTC_HANDLE_VALUE_NTF_PARAM_T *ntfParam);
+uint8 WptsSelect(uint8 device);
+void WptsSchedule(uint8 poll);
+void WptsPurge(void);
+
+
+/***************************************
+*      External data references
+***************************************/
+extern WPTS_PRU_T wptsPru[PRU_SCHED_MAX];
 
 
 #endif /* CY_BLE_WPTU_H  */
@@ -0,0 +1,266 @@
+/*******************************************************************************
+* File Name: adfuzz.c
+*
+* Version 1.0
+*
+* Description:
+*  This file contains the host fuzz test of the advertising data parser of
+*  the scanning projects. Random reports go through AdIterNext(), AdParse()
+*  and AdFindUuid16(), and every result is checked against a plain reference
+*  walker of the AD structures.
+*
+*  Every report is copied into a heap block of exactly its length, so with
+*  the sanitizers of the build (see CMakeLists.txt) a read past the report
+*  fails the test even when the results are right.
+*
+*  The reports are a mix of random bytes and of AD structures of the types
+*  that AdParse() collects, with zero length padding and with a last
+*  structure cut short.
+*
+*  Arguments: adfuzz [count [seed]]
+*  count - the reports, 200000 by default;
+*  seed - the seed of the reports, 1 by default.
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "adparse.h"
+
+
+/***************************************
+*        Constants
+***************************************/
+#define AD_FUZZ_DATA_MAX            (31u)       /* Advertising or scan response data */
+#define AD_FUZZ_STRUCT_MAX          (16u)       /* AD structures of at least 2 bytes in the data */
+
+
+/***************************************
+*        Data Struct Definition
+***************************************/
+typedef struct
+{
+    uint8 offset;
+    uint8 type;
+    uint8 len;
+} AD_FUZZ_STRUCT_T;
+
+typedef struct
+{
+    AD_FUZZ_STRUCT_T ad[AD_FUZZ_STRUCT_MAX];
+    uint8 num;
+    uint8 error;
+} AD_FUZZ_WALK_T;
+
+
+/*******************************************************************************
+* Function Name: AdFuzzWalk
+********************************************************************************
+*
+* Summary:
+*   The reference walker of the AD structures.
+*
+*******************************************************************************/
+static void AdFuzzWalk(const uint8 data[], uint32 dataLen, AD_FUZZ_WALK_T *walk)
+{
+    uint32 pos = 0u;
+    uint32 end = 0u;
+
+    walk->num = 0u;
+    walk->error = 0u;
+
+    while((0u == end) && (pos < dataLen))
+    {
+        if(0u == data[pos])
+        {
+            end = 1u;
+        }
+        else if((pos + 1u + data[pos]) > dataLen)
+        {
+            walk->error = 1u;
+            end = 1u;
+        }
+        else
+        {
+            walk->ad[walk->num].offset = (uint8)pos;
+            walk->ad[walk->num].type = data[pos + 1u];
+            walk->ad[walk->num].len = (uint8)(data[pos] - 1u);
+            walk->num++;
+            pos += 1u + data[pos];
+        }
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: AdFuzzReport
+********************************************************************************
+*
+* Summary:
+*   Generates a random report.
+*
+* Return:
+*   The length of the report.
+*
+*******************************************************************************/
+static uint32 AdFuzzReport(uint8 data[])
+{
+    static const uint8 types[] = {AD_TYPE_FLAGS, AD_TYPE_INCOMPL_16UUID, AD_TYPE_COMPL_16UUID,
+        AD_TYPE_INCOMPL_128UUID, AD_TYPE_COMPL_128UUID, AD_TYPE_SHORT_NAME, AD_TYPE_COMPL_NAME,
+        AD_TYPE_TX_POWER, AD_TYPE_SRVC_DATA_16UUID, 0xFFu};
+    uint32 dataLen = (uint32)rand() % (AD_FUZZ_DATA_MAX + 1u);
+    uint32 pos = 0u;
+    uint32 len;
+    uint32 i;
+
+    for(i = 0u; i < dataLen; i++)
+    {
+        data[i] = (uint8)rand();
+    }
+
+    /* Most reports are well formed up to a random point */
+    if(0u != ((uint32)rand() % 4u))
+    {
+        while((pos + 2u) <= dataLen)
+        {
+            len = 1u + ((uint32)rand() % 18u);
+            if((0u == ((uint32)rand() % 16u)) || ((pos + 1u + len) > dataLen))
+            {
+                /* Zero length padding or a structure cut short */
+                data[pos] = (0u != ((uint32)rand() % 2u)) ? 0u : (uint8)len;
+                pos = dataLen;
+            }
+            else
+            {
+                data[pos] = (uint8)len;
+                data[pos + 1u] = types[(uint32)rand() % sizeof(types)];
+                pos += 1u + len;
+            }
+        }
+    }
+
+    return(dataLen);
+}
+
+
+/*******************************************************************************
+* Function Name: AdFuzzCheck
+********************************************************************************
+*
+* Summary:
+*   Checks the parser on a report.
+*
+* Return:
+*   The number of the failed checks.
+*
+*******************************************************************************/
+static uint32 AdFuzzCheck(const uint8 data[], uint32 dataLen)
+{
+    AD_FUZZ_WALK_T walk;
+    AD_ITER_T iter;
+    AD_INFO_T info;
+    const uint8 *end = data + dataLen;
+    uint32 errors = 0u;
+    uint32 n = 0u;
+    uint32 i;
+    uint32 found;
+    uint16 uuid;
+    uint8 wellFormed;
+
+    AdFuzzWalk(data, dataLen, &walk);
+
+    AdIterInit(&iter, data, (uint8)dataLen);
+    while(0u != AdIterNext(&iter))
+    {
+        if((n >= walk.num) || (iter.offset != walk.ad[n].offset) || (iter.type != walk.ad[n].type) ||
+           (iter.len != walk.ad[n].len) || (iter.value != &data[walk.ad[n].offset + 2u]) ||
+           ((iter.value + iter.len) > end))
+        {
+            errors++;
+        }
+        n++;
+    }
+    if((n != walk.num) || (iter.error != walk.error) || (0u != AdIterNext(&iter)))
+    {
+        errors++;
+    }
+
+    wellFormed = AdParse(data, (uint8)dataLen, &info);
+    if((wellFormed == walk.error) ||
+       ((info.uuid16 + info.uuid16Len) > end) || (0u != (info.uuid16Len % AD_UUID16_SIZE)) ||
+       ((info.uuid128 + info.uuid128Len) > end) || (0u != (info.uuid128Len % AD_UUID128_SIZE)) ||
+       ((info.serviceData16 + info.serviceData16Len) > end) || ((info.name + info.nameLen) > end))
+    {
+        errors++;
+    }
+
+    /* The 16-bit UUID list against a plain search of its even bytes */
+    uuid = (uint16)rand();
+    if((0u != info.uuid16Len) && (0u != ((uint32)rand() % 2u)))
+    {
+        i = ((uint32)rand() % info.uuid16Len) & ~(AD_UUID16_SIZE - 1u);
+        uuid = (uint16)(info.uuid16[i] | ((uint16)info.uuid16[i + 1u] << 8u));
+    }
+    found = 0u;
+    for(i = 0u; (i + 1u) < info.uuid16Len; i += AD_UUID16_SIZE)
+    {
+        if(uuid == (uint16)(info.uuid16[i] | ((uint16)info.uuid16[i + 1u] << 8u)))
+        {
+            found = 1u;
+        }
+    }
+    if(found != AdFindUuid16(info.uuid16, info.uuid16Len, uuid))
+    {
+        errors++;
+    }
+
+    return(errors);
+}
+
+
+int main(int argc, char *argv[])
+{
+    uint32 count = (argc > 1) ? (uint32)strtoul(argv[1], NULL, 0) : 200000u;
+    uint32 seed = (argc > 2) ? (uint32)strtoul(argv[2], NULL, 0) : 1u;
+    uint8 report[AD_FUZZ_DATA_MAX];
+    uint8 *data;
+    uint32 dataLen;
+    uint32 errors = 0u;
+    uint32 malformed = 0u;
+    uint32 n;
+    AD_FUZZ_WALK_T walk;
+
+    srand(seed);
+    printf("adfuzz: %u reports, seed %u\n", (unsigned)count, (unsigned)seed);
+
+    for(n = 0u; n < count; n++)
+    {
+        dataLen = AdFuzzReport(report);
+
+        /* A block of exactly the report, an empty one still gets a valid pointer */
+        data = (uint8 *)malloc((0u != dataLen) ? dataLen : 1u);
+        if(NULL == data)
+        {
+            return(1);
+        }
+        (void)memcpy(data, report, dataLen);
+
+        errors += AdFuzzCheck(data, dataLen);
+        AdFuzzWalk(data, dataLen, &walk);
+        malformed += walk.error;
+        free(data);
+    }
+
+    printf("  %u malformed reports, %u errors\n", (unsigned)malformed, (unsigned)errors);
+
+    return((0u == errors) ? 0 : 1);
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,104 @@
+/*******************************************************************************
+* File Name: bench.c
+*
+* Version 1.0
+*
+* Description:
+*  This file contains the helpers shared by the host benchmarks of the
+*  profiles. A benchmark is run as
+*
+*      <bench> [interval [mtu [buffers [packets [count]]]]]
+*
+*  interval - the connection interval, 1.25 ms units, 6 by default;
+*  mtu - the exchanged ATT MTU, 23 by default;
+*  buffers - the stack TX buffers, 4 by default;
+*  packets - the LL packets of a connection event, 0 (as many as fit) by
+*            default;
+*  count - the notifications to send, 10000 by default.
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "bench.h"
+
+
+/*******************************************************************************
+* Function Name: BenchParse
+********************************************************************************
+*
+* Summary:
+*   Reads the configuration of the benchmark from the command line.
+*
+* Parameters:
+*   argc - the number of the arguments.
+*   argv - the arguments.
+*   cfg - returns the configuration.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void BenchParse(int argc, char *argv[], BENCH_CFG_T *cfg)
+{
+    cfg->link.connInterval = (argc > 1) ? (uint16)strtoul(argv[1], NULL, 0) : 6u;
+    cfg->link.attMtu = (argc > 2) ? (uint16)strtoul(argv[2], NULL, 0) : CYBLE_GATT_DEFAULT_MTU;
+    cfg->link.txBufNum = (argc > 3) ? (uint8)strtoul(argv[3], NULL, 0) : 4u;
+    cfg->link.pktPerEvt = (argc > 4) ? (uint8)strtoul(argv[4], NULL, 0) : 0u;
+    cfg->count = (argc > 5) ? (uint32)strtoul(argv[5], NULL, 0) : 10000u;
+}
+
+
+/*******************************************************************************
+* Function Name: BenchReport
+********************************************************************************
+*
+* Summary:
+*   Prints the throughput of the simulated link and the PDU build cost
+*   measured by the notification statistics of the profile.
+*
+* Parameters:
+*   name - the name of the benchmark.
+*   buildCount - the number of the measured PDU builds.
+*   buildCycles - the SysTick cycles of the builds.
+*   buildCyclesMax - the longest build.
+*   busyPolls - the CyBle_ProcessEvents() calls spent waiting for a TX buffer.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void BenchReport(const char *name, uint32 buildCount, uint32 buildCycles, uint32 buildCyclesMax,
+    uint32 busyPolls)
+{
+    double seconds = (double)CyBleSim_Time() / 1000000.0;
+    double nsPerCycle = 1000000000.0 / (double)CYBLE_SIM_SYSCLK_HZ;
+
+    if(seconds <= 0.0)
+    {
+        seconds = 1.0;
+    }
+
+    printf("%s: interval %.2f ms, MTU %u, %u TX buffers, %u packets/event\n", name,
+        (double)cyBleSimCfg.connInterval * 1.25, (unsigned)cyBleSimCfg.attMtu,
+        (unsigned)cyBleSimCfg.txBufNum, (unsigned)cyBleSimCfg.pktPerEvt);
+    printf("  %.1f ntf/s, %.1f ind/s, %.0f B/s of values, %.2f LL packets/event, %u rejected\n",
+        (double)cyBleSimStat.ntfCount / seconds, (double)cyBleSimStat.indCount / seconds,
+        (double)cyBleSimStat.attBytes / seconds,
+        (double)cyBleSimStat.llPackets / (double)((0u != cyBleSimStat.connEvents) ? cyBleSimStat.connEvents : 1u),
+        (unsigned)cyBleSimStat.rejected);
+    if(0u != buildCount)
+    {
+        printf("  PDU build: avg %.1f ns, max %.1f ns (host), busy polls %u\n",
+            ((double)buildCycles * nsPerCycle) / (double)buildCount, (double)buildCyclesMax * nsPerCycle,
+            (unsigned)busyPolls);
+    }
+}
+
+
+/* [] END OF FILE */
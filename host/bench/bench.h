@@ -0,0 +1,43 @@
+/*******************************************************************************
+* File Name: bench.h
+*
+* Version 1.0
+*
+* Description:
+*  Contains the function prototypes of the helpers shared by the host
+*  benchmarks of the profiles.
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(BENCH_H)
+#define BENCH_H
+
+#include "cyble_sim.h"
+
+
+/***************************************
+*        Data Struct Definition
+***************************************/
+typedef struct
+{
+    CYBLE_SIM_CFG_T link;       /* Simulated link */
+    uint32 count;               /* Notifications to send */
+} BENCH_CFG_T;
+
+
+/***************************************
+*      API Function Prototypes
+***************************************/
+void BenchParse(int argc, char *argv[], BENCH_CFG_T *cfg);
+void BenchReport(const char *name, uint32 buildCount, uint32 buildCycles, uint32 buildCyclesMax,
+    uint32 busyPolls);
+
+
+#endif /* BENCH_H */
+
+/* [] END OF FILE */
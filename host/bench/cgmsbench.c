@@ -0,0 +1,493 @@
+/*******************************************************************************
+* File Name: cgmsbench.c
+*
+* Version 1.0
+*
+* Description:
+*  This file contains the host test and benchmark of the Continuous Glucose
+*  Monitoring profile: the CGM Measurement packing with the E2E-CRC, the
+*  record log on the simulated flash and the RACP requests. The simulated
+*  records seed the erased flash, then the measurements, one a minute,
+*  wrap the record log. The client runs RACP requests of all, the first
+*  and the last records and checks every reported measurement against the
+*  one it packs itself, with a bitwise CRC-CCITT. Then records are deleted,
+*  the deletions are synchronized, the device is reset and the restored log
+*  is checked. At last, a control point write with the E2E-CRC is checked.
+*
+*  The count argument is the number of measurements, see bench.c. The
+*  filters by the Time Offset are not run: the firmware reads an 8-bit
+*  operand, so they only select the first 255 minutes of a session.
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "main.h"
+#include "bench.h"
+
+
+/***************************************
+*        Constants
+***************************************/
+#define CGMS_BENCH_NONE             (0xFFFFFFFFu)
+
+/* Features of the bench: trend, quality and the E2E-CRC */
+#define CGMS_BENCH_FEATURE          (CYBLE_CGMS_CGFT_FTR_TI | CYBLE_CGMS_CGFT_FTR_QA | CYBLE_CGMS_CGFT_FTR_EC)
+
+
+/* Globals of main.c used by the profile */
+CYBLE_API_RESULT_T apiResult;
+uint16 i;
+uint8 flag;
+
+/* Of cgmss.c */
+extern uint8 cgmsFlag;
+extern uint8 commInterval;
+
+static uint8 *benchDeleted;     /* Positions deleted by the client */
+static uint32 *benchExpect;     /* Positions a request is expected to report */
+static uint32 benchExpectNum;
+
+static uint32 rxNum;            /* Measurements received */
+static uint8 rxInd[8u];         /* The control point response */
+static uint8 rxIndLength;
+static uint32 rxIndNum;
+
+static uint32 errors;
+
+
+/*******************************************************************************
+* Function Name: PrintApiResult
+********************************************************************************
+*
+* Summary:
+*   Replaces the one of debug.c.
+*
+*******************************************************************************/
+void PrintApiResult(void)
+{
+    printf("0x%x \n", (unsigned)apiResult);
+}
+
+
+/*******************************************************************************
+* Function Name: CgmsBenchCrc
+********************************************************************************
+*
+* Summary:
+*   Computes the E2E-CRC bit by bit: CRC-CCITT, reflected, seed 0xFFFF.
+*
+*******************************************************************************/
+static uint16 CgmsBenchCrc(const uint8 data[], uint32 length)
+{
+    uint16 crc = 0xFFFFu;
+    uint32 n;
+    uint32 bit;
+
+    for(n = 0u; n < length; n++)
+    {
+        crc ^= data[n];
+        for(bit = 0u; bit < 8u; bit++)
+        {
+            crc = (0u != (crc & 1u)) ? (uint16)((crc >> 1u) ^ 0x8408u) : (uint16)(crc >> 1u);
+        }
+    }
+
+    return(crc);
+}
+
+
+/*******************************************************************************
+* Function Name: CgmsBenchPack
+********************************************************************************
+*
+* Summary:
+*   Packs the CGM Measurement of a position of the log as the client expects
+*   it: the simulated record of the position with the Time Offset of the
+*   position, the optional fields of the flags, all supported with
+*   CGMS_BENCH_FEATURE, and the E2E-CRC.
+*
+* Return:
+*   The length of the value.
+*
+*******************************************************************************/
+static uint8 CgmsBenchPack(uint32 pos, uint8 pdu[])
+{
+    const CYBLE_CGMS_CGMT_T *rec = &cgmt[pos % REC_NUM];
+    uint8 ptr = 6u;
+
+    pdu[1u] = rec->flags;
+    CyBle_Set16ByPtr(&pdu[2u], rec->gluConc);
+    CyBle_Set16ByPtr(&pdu[4u], (uint16)(pos + 1u));
+    if(0u != (rec->flags & CYBLE_CGMS_GLMT_FLG_WG))
+    {
+        pdu[ptr] = (uint8)(rec->ssa & CYBLE_CGMS_GLMT_SSA_WGM);
+        ptr++;
+    }
+    if(0u != (rec->flags & CYBLE_CGMS_GLMT_FLG_CT))
+    {
+        pdu[ptr] = (uint8)((rec->ssa & CYBLE_CGMS_GLMT_SSA_CTM) >> CYBLE_CGMS_GLMT_SSA_CTS);
+        ptr++;
+    }
+    if(0u != (rec->flags & CYBLE_CGMS_GLMT_FLG_ST))
+    {
+        pdu[ptr] = (uint8)((rec->ssa & CYBLE_CGMS_GLMT_SSA_STM) >> CYBLE_CGMS_GLMT_SSA_STS);
+        ptr++;
+    }
+    if(0u != (rec->flags & CYBLE_CGMS_GLMT_FLG_TI))
+    {
+        CyBle_Set16ByPtr(&pdu[ptr], rec->trend);
+        ptr += 2u;
+    }
+    if(0u != (rec->flags & CYBLE_CGMS_GLMT_FLG_QA))
+    {
+        CyBle_Set16ByPtr(&pdu[ptr], rec->quality);
+        ptr += 2u;
+    }
+    pdu[0u] = ptr + 2u;
+    CyBle_Set16ByPtr(&pdu[ptr], CgmsBenchCrc(pdu, ptr));
+
+    return(ptr + 2u);
+}
+
+
+/*******************************************************************************
+* Function Name: CgmsBenchRx
+********************************************************************************
+*
+* Summary:
+*   Checks every CGM Measurement against the next position the request is
+*   expected to report and collects the control point responses.
+*
+*******************************************************************************/
+static void CgmsBenchRx(uint16 attrHandle, uint16 length, const uint8 value[], uint8 isIndication)
+{
+    uint8 pdu[CYBLE_SIM_CGMS_VALUE_MAX];
+
+    if((CYBLE_SIM_CGMS_HANDLE(CYBLE_CGMS_CGMT) == attrHandle) && (0u == isIndication))
+    {
+        if((rxNum >= benchExpectNum) || (CgmsBenchPack(benchExpect[rxNum], pdu) != length) ||
+           (0 != memcmp(pdu, value, length)))
+        {
+            errors++;
+        }
+        rxNum++;
+    }
+    else if(((CYBLE_SIM_CGMS_HANDLE(CYBLE_CGMS_RACP) == attrHandle) ||
+             (CYBLE_SIM_CGMS_HANDLE(CYBLE_CGMS_SOCP) == attrHandle)) &&
+            (0u != isIndication) && (length <= sizeof(rxInd)))
+    {
+        (void)memcpy(rxInd, value, length);
+        rxIndLength = (uint8)length;
+        rxIndNum++;
+    }
+    else
+    {
+        errors++;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: CgmsBenchExpect
+********************************************************************************
+*
+* Summary:
+*   Lists the valid positions of the model, from the oldest one.
+*
+*******************************************************************************/
+static void CgmsBenchExpect(void)
+{
+    uint32 pos;
+
+    benchExpectNum = 0u;
+    for(pos = recLogTail; pos < recLogHead; pos++)
+    {
+        if(0u == benchDeleted[pos])
+        {
+            benchExpect[benchExpectNum] = pos;
+            benchExpectNum++;
+        }
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: CgmsBenchRacp
+********************************************************************************
+*
+* Summary:
+*   Writes a RACP request, runs the profile until the response is sent and
+*   delivered, and checks the number of the reported records and the
+*   response.
+*
+*******************************************************************************/
+static void CgmsBenchRacp(const char *name, uint8 opCode, uint8 opr, uint32 num)
+{
+    uint8 req[2u] = {opCode, opr};
+    uint8 rsp[4u] = {CYBLE_CGMS_RACP_OPC_RSP_CODE, CYBLE_CGMS_RACP_OPR_NULL, opCode, CYBLE_CGMS_RACP_RSP_SUCCESS};
+    uint32 mismatch = 0u;
+
+    if(CYBLE_CGMS_RACP_OPC_REPORT_NUM_REC == opCode)
+    {
+        rsp[0u] = CYBLE_CGMS_RACP_OPC_NUM_REC_RSP;
+        CyBle_Set16ByPtr(&rsp[2u], (uint16)num);
+    }
+    else if(0u == num)
+    {
+        rsp[3u] = CYBLE_CGMS_RACP_RSP_NO_REC;
+    }
+
+    rxNum = 0u;
+    rxIndNum = 0u;
+    if(CYBLE_GATT_ERR_NONE != CyBleSim_CgmssWriteChar(CYBLE_CGMS_RACP, sizeof(req), req))
+    {
+        mismatch++;
+    }
+    do
+    {
+        CgmsProcess();
+        CyBle_ProcessEvents();
+    }
+    while(0u != cgmsFlag);
+    CyBleSim_Flush();
+
+    if((((CYBLE_CGMS_RACP_OPC_REPORT_REC == opCode) ? num : 0u) != rxNum) || (1u != rxIndNum) ||
+       (sizeof(rsp) != rxIndLength) || (0 != memcmp(rsp, rxInd, sizeof(rsp))))
+    {
+        mismatch++;
+    }
+
+    printf("  %s: %u records%s\n", name, (unsigned)((CYBLE_CGMS_RACP_OPC_REPORT_REC == opCode) ? rxNum : num),
+        (0u != mismatch) ? ", FAILED" : "");
+    errors += mismatch;
+}
+
+
+/*******************************************************************************
+* Function Name: CgmsBenchEnd
+********************************************************************************
+*
+* Summary:
+*   Runs a request of the First Record or the Last Record: the report must
+*   be the oldest or the most recent valid record, the deletion removes it
+*   from the model.
+*
+*******************************************************************************/
+static void CgmsBenchEnd(const char *name, uint8 opCode, uint8 opr)
+{
+    uint32 pos;
+
+    CgmsBenchExpect();
+    if(0u == benchExpectNum)
+    {
+        CgmsBenchRacp(name, opCode, opr, 0u);
+    }
+    else
+    {
+        pos = (CYBLE_CGMS_RACP_OPR_FIRST == opr) ? benchExpect[0u] : benchExpect[benchExpectNum - 1u];
+        benchExpect[0u] = pos;
+        benchExpectNum = 1u;
+        CgmsBenchRacp(name, opCode, opr, 1u);
+        if(CYBLE_CGMS_RACP_OPC_DELETE_REC == opCode)
+        {
+            benchDeleted[pos] = 1u;
+        }
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: CgmsBenchAll
+********************************************************************************
+*
+* Summary:
+*   Runs a request of all the records: the reports of the records, their
+*   number or their deletion.
+*
+*******************************************************************************/
+static void CgmsBenchAll(const char *name, uint8 opCode)
+{
+    uint32 n;
+
+    CgmsBenchExpect();
+    CgmsBenchRacp(name, opCode, CYBLE_CGMS_RACP_OPR_ALL, benchExpectNum);
+    if(CYBLE_CGMS_RACP_OPC_DELETE_REC == opCode)
+    {
+        for(n = 0u; n < benchExpectNum; n++)
+        {
+            benchDeleted[benchExpect[n]] = 1u;
+        }
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: CgmsBenchSocp
+********************************************************************************
+*
+* Summary:
+*   Writes the Set CGM Communication Interval with a good, a bad and no
+*   E2E-CRC: only the first one is accepted and indicated, the response
+*   carries its CRC.
+*
+*******************************************************************************/
+static void CgmsBenchSocp(void)
+{
+    uint8 req[4u] = {CYBLE_CGMS_SOCP_OPC_SINT, 10u};
+    uint8 rsp[5u] = {CYBLE_CGMS_SOCP_OPC_RSPC, CYBLE_CGMS_SOCP_OPC_SINT, CYBLE_CGMS_SOCP_RSP_SUCCESS};
+    uint32 mismatch = 0u;
+
+    CyBle_Set16ByPtr(&req[2u], (uint16)(CgmsBenchCrc(req, 2u) ^ 1u));
+    rxIndNum = 0u;
+    if((CYBLE_GATT_ERR_INVALID_CRC != CyBleSim_CgmssWriteChar(CYBLE_CGMS_SOCP, 4u, req)) ||
+       (CYBLE_GATT_ERR_MISSING_CRC != CyBleSim_CgmssWriteChar(CYBLE_CGMS_SOCP, 2u, req)) || (0u != cgmsFlag))
+    {
+        mismatch++;
+    }
+
+    CyBle_Set16ByPtr(&req[2u], CgmsBenchCrc(req, 2u));
+    CyBle_Set16ByPtr(&rsp[3u], CgmsBenchCrc(rsp, 3u));
+    if(CYBLE_GATT_ERR_NONE != CyBleSim_CgmssWriteChar(CYBLE_CGMS_SOCP, 4u, req))
+    {
+        mismatch++;
+    }
+    do
+    {
+        CgmsProcess();
+        CyBle_ProcessEvents();
+    }
+    while(0u != cgmsFlag);
+    CyBleSim_Flush();
+
+    if((1u != rxIndNum) || (sizeof(rsp) != rxIndLength) || (0 != memcmp(rsp, rxInd, sizeof(rsp))) ||
+       (10u != commInterval))
+    {
+        mismatch++;
+    }
+
+    printf("  SOCP with the E2E-CRC: %s\n", (0u != mismatch) ? "FAILED" : "ok");
+    errors += mismatch;
+}
+
+
+/*******************************************************************************
+* Function Name: CgmsBenchReset
+********************************************************************************
+*
+* Summary:
+*   Restarts the profile as after a device reset: only the flash contents
+*   and the GATT database are kept.
+*
+*******************************************************************************/
+static void CgmsBenchReset(void)
+{
+    recLogTail = 0u;
+    recLogHead = 0u;
+    CgmsInit();
+}
+
+
+int main(int argc, char *argv[])
+{
+    uint8 feature[6u] = {LO8(LO16(CGMS_BENCH_FEATURE)), HI8(LO16(CGMS_BENCH_FEATURE)), LO8(HI16(CGMS_BENCH_FEATURE)),
+        CYBLE_CGMS_GLMT_TYPE_ISF | (CYBLE_CGMS_GLMT_SL_AST << CYBLE_CGMS_CGFT_SL_SHIFT)};
+    BENCH_CFG_T cfg;
+    CYBLE_CGMS_CGMT_T rec;
+    uint32 size;
+    uint32 tail;
+    uint32 head;
+    uint32 n;
+
+    BenchParse(argc, argv, &cfg);
+    size = cfg.count + REC_NUM;
+    benchDeleted = calloc(size, sizeof(uint8));
+    benchExpect = calloc(size, sizeof(uint32));
+    if((NULL == benchDeleted) || (NULL == benchExpect))
+    {
+        return(1);
+    }
+
+    CyBleSim_Start(&cfg.link);
+    CyBleSim_SetRxHandler(&CgmsBenchRx);
+
+    /* The erased flash is seeded with the simulated records */
+    CyBle_Set16ByPtr(&feature[4u], CgmsBenchCrc(feature, 4u));
+    (void)CyBle_CgmssSetCharacteristicValue(CYBLE_CGMS_CGFT, sizeof(feature), feature);
+    CgmsInit();
+    if((0u != recLogTail) || (REC_NUM != recLogHead) || (CGMS_BENCH_FEATURE != cgft.feature))
+    {
+        errors++;
+    }
+    CyBleSim_CgmssWriteCccd(CYBLE_CGMS_CGMT, CYBLE_CCCD_NOTIFICATION);
+    CyBleSim_CgmssWriteCccd(CYBLE_CGMS_RACP, CYBLE_CCCD_INDICATION);
+    CyBleSim_CgmssWriteCccd(CYBLE_CGMS_SOCP, CYBLE_CCCD_INDICATION);
+
+    /* One measurement a minute, the Time Offset is the minute of the session */
+    for(n = 0u; n < cfg.count; n++)
+    {
+        head = recLogHead;
+        rec = cgmt[head % REC_NUM];
+        rec.timeOffset = (uint16)(head + 1u);
+        if((CYRET_SUCCESS != RecLogAppend(&rec)) || ((head + 1u) != recLogHead))
+        {
+            errors++;
+        }
+    }
+    if(((recLogHead - recLogTail) < REC_LOG_CAPACITY) ||
+       ((recLogHead - recLogTail) > (REC_LOG_ROWS * REC_LOG_REC_PER_ROW)))
+    {
+        errors++;
+    }
+    printf("cgms: %u measurements, records [%u, %u) in the log\n", (unsigned)recLogHead,
+        (unsigned)recLogTail, (unsigned)recLogHead);
+
+    NtfStatReset();
+    CgmsBenchAll("all", CYBLE_CGMS_RACP_OPC_REPORT_REC);
+    BenchReport("cgms", ntfStat.buildCount, ntfStat.buildCycles, ntfStat.buildCyclesMax, ntfStat.busyPolls);
+
+    CgmsBenchAll("number of records", CYBLE_CGMS_RACP_OPC_REPORT_NUM_REC);
+    CgmsBenchEnd("first", CYBLE_CGMS_RACP_OPC_REPORT_REC, CYBLE_CGMS_RACP_OPR_FIRST);
+    CgmsBenchEnd("last", CYBLE_CGMS_RACP_OPC_REPORT_REC, CYBLE_CGMS_RACP_OPR_LAST);
+
+    /* Deletions at both ends */
+    CgmsBenchEnd("delete first", CYBLE_CGMS_RACP_OPC_DELETE_REC, CYBLE_CGMS_RACP_OPR_FIRST);
+    CgmsBenchEnd("delete first", CYBLE_CGMS_RACP_OPC_DELETE_REC, CYBLE_CGMS_RACP_OPR_FIRST);
+    CgmsBenchEnd("delete last", CYBLE_CGMS_RACP_OPC_DELETE_REC, CYBLE_CGMS_RACP_OPR_LAST);
+    CgmsBenchEnd("first", CYBLE_CGMS_RACP_OPC_REPORT_REC, CYBLE_CGMS_RACP_OPR_FIRST);
+    CgmsBenchEnd("last", CYBLE_CGMS_RACP_OPC_REPORT_REC, CYBLE_CGMS_RACP_OPR_LAST);
+    CgmsBenchAll("number of records", CYBLE_CGMS_RACP_OPC_REPORT_NUM_REC);
+
+    /* The deletions are written to flash, then the log is restored from it */
+    while(0u != RecLogSync())
+    {
+    }
+    tail = recLogTail;
+    head = recLogHead;
+    CgmsBenchReset();
+    printf("reset: records [%u, %u) restored\n", (unsigned)recLogTail, (unsigned)recLogHead);
+    if((tail != recLogTail) || (head != recLogHead))
+    {
+        errors++;
+    }
+    CgmsBenchAll("all", CYBLE_CGMS_RACP_OPC_REPORT_REC);
+
+    CgmsBenchAll("delete all", CYBLE_CGMS_RACP_OPC_DELETE_REC);
+    CgmsBenchAll("all", CYBLE_CGMS_RACP_OPC_REPORT_REC);
+    CgmsBenchAll("number of records", CYBLE_CGMS_RACP_OPC_REPORT_NUM_REC);
+    CgmsBenchEnd("first", CYBLE_CGMS_RACP_OPC_REPORT_REC, CYBLE_CGMS_RACP_OPR_FIRST);
+
+    CgmsBenchSocp();
+
+    printf("  %u errors\n", (unsigned)errors);
+
+    return((0u == errors) ? 0 : 1);
+}
+
+
+/* [] END OF FILE */
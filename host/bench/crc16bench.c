@@ -0,0 +1,232 @@
+/*******************************************************************************
+* File Name: crc16bench.c
+*
+* Version 1.0
+*
+* Description:
+*  This file contains the host benchmark of the CRC-CCITT module. crc16.c is
+*  built once per CRC16_METHOD with the functions renamed, see
+*  CMakeLists.txt. Every method is checked against the bitwise loop that it
+*  replaced, on random messages calculated whole and in random parts, then
+*  the speed of all of them is measured on the host.
+*
+*  Arguments: crc16bench [size [count]]
+*  size - the bytes of the measured message, 256 by default;
+*  count - the messages of a measurement, 20000 by default.
+*
+*  The host speed only ranks the methods: the Cortex-M0 has no data cache
+*  and takes 2 cycles per load, so the gain of the tables there is closer
+*  to the ratio of the loop iterations.
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "cytypes.h"
+
+
+/***************************************
+*        Constants
+***************************************/
+#define CRC16_BENCH_SEED            (0xffffu)
+#define CRC16_BENCH_POLY            (0x8408u)
+#define CRC16_BENCH_CHECK           (0x906eu)   /* CRC-16/X-25 of "123456789", the inverted CRC */
+#define CRC16_BENCH_MSG_MAX         (4096u)
+#define CRC16_BENCH_RANDOM_MSGS     (2000u)
+
+
+/***************************************
+*        Data Struct Definition
+***************************************/
+typedef uint16 (*CRC16_BENCH_FUNC)(uint16 crc, const uint8 buffer[], uint32 size);
+
+typedef struct
+{
+    const char *name;
+    CRC16_BENCH_FUNC func;
+} CRC16_BENCH_METHOD_T;
+
+
+/* crc16.c built with CRC16_METHOD of each method */
+uint16 Crc16UpdateNibble(uint16 crc, const uint8 buffer[], uint32 size);
+uint16 Crc16UpdateByte(uint16 crc, const uint8 buffer[], uint32 size);
+uint16 Crc16UpdateSlice4(uint16 crc, const uint8 buffer[], uint32 size);
+
+static uint16 Crc16BenchBitwise(uint16 crc, const uint8 buffer[], uint32 size);
+
+static const CRC16_BENCH_METHOD_T crc16BenchMethods[] =
+{
+    {"bitwise", &Crc16BenchBitwise},
+    {"nibble", &Crc16UpdateNibble},
+    {"byte", &Crc16UpdateByte},
+    {"slice-by-4", &Crc16UpdateSlice4}
+};
+
+#define CRC16_BENCH_METHODS         (sizeof(crc16BenchMethods) / sizeof(crc16BenchMethods[0u]))
+
+static uint8 crc16BenchMsg[CRC16_BENCH_MSG_MAX];
+static volatile uint16 crc16BenchSink;  /* Keeps the measured calls */
+
+
+/*******************************************************************************
+* Function Name: Crc16BenchBitwise
+********************************************************************************
+*
+* Summary:
+*   The bit-by-bit loop of CgmsCrc() and of the bootloader packet checksum
+*   before the table driven module.
+*
+*******************************************************************************/
+static uint16 Crc16BenchBitwise(uint16 crc, const uint8 buffer[], uint32 size)
+{
+    uint32 i;
+    uint8 bit;
+    uint8 tmp;
+
+    for(i = 0u; i < size; i++)
+    {
+        tmp = buffer[i];
+
+        for(bit = 0u; bit < 8u; bit++)
+        {
+            if(0u != ((crc & 0x0001u) ^ (tmp & 0x0001u)))
+            {
+                crc = (crc >> 1u) ^ CRC16_BENCH_POLY;
+            }
+            else
+            {
+                crc >>= 1u;
+            }
+
+            tmp >>= 1u;
+        }
+    }
+
+    return(crc);
+}
+
+
+/*******************************************************************************
+* Function Name: Crc16BenchNs
+********************************************************************************
+*
+* Summary:
+*   Returns the host monotonic time.
+*
+*******************************************************************************/
+static uint64 Crc16BenchNs(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return(((uint64)ts.tv_sec * 1000000000u) + (uint64)ts.tv_nsec);
+}
+
+
+/*******************************************************************************
+* Function Name: Crc16BenchCheck
+********************************************************************************
+*
+* Summary:
+*   Checks a method against the bitwise loop.
+*
+* Return:
+*   The number of the mismatches.
+*
+*******************************************************************************/
+static uint32 Crc16BenchCheck(const CRC16_BENCH_METHOD_T *method)
+{
+    static const uint8 check[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+    uint32 errors = 0u;
+    uint32 n;
+    uint32 size;
+    uint32 split;
+    uint16 crc;
+
+    crc = (uint16)~method->func(CRC16_BENCH_SEED, check, sizeof(check));
+    if(CRC16_BENCH_CHECK != crc)
+    {
+        errors++;
+    }
+
+    for(n = 0u; n < CRC16_BENCH_RANDOM_MSGS; n++)
+    {
+        size = (uint32)rand() % 300u;
+        split = (0u != size) ? ((uint32)rand() % size) : 0u;
+
+        crc = Crc16BenchBitwise(CRC16_BENCH_SEED, crc16BenchMsg, size);
+        if(crc != method->func(CRC16_BENCH_SEED, crc16BenchMsg, size))
+        {
+            errors++;
+        }
+
+        /* A message calculated in two parts, as it arrives */
+        if(crc != method->func(method->func(CRC16_BENCH_SEED, crc16BenchMsg, split), &crc16BenchMsg[split],
+            size - split))
+        {
+            errors++;
+        }
+    }
+
+    return(errors);
+}
+
+
+int main(int argc, char *argv[])
+{
+    uint32 size = (argc > 1) ? (uint32)strtoul(argv[1], NULL, 0) : 256u;
+    uint32 count = (argc > 2) ? (uint32)strtoul(argv[2], NULL, 0) : 20000u;
+    uint32 errors = 0u;
+    uint32 mismatch;
+    uint32 m;
+    uint32 n;
+    uint64 start;
+    double ns;
+    double nsBitwise = 0.0;
+
+    if((0u == size) || (size > CRC16_BENCH_MSG_MAX))
+    {
+        size = CRC16_BENCH_MSG_MAX;
+    }
+
+    srand(1u);
+    for(n = 0u; n < CRC16_BENCH_MSG_MAX; n++)
+    {
+        crc16BenchMsg[n] = (uint8)rand();
+    }
+
+    printf("crc16: %u-byte messages\n", (unsigned)size);
+    for(m = 0u; m < CRC16_BENCH_METHODS; m++)
+    {
+        mismatch = Crc16BenchCheck(&crc16BenchMethods[m]);
+        errors += mismatch;
+
+        start = Crc16BenchNs();
+        for(n = 0u; n < count; n++)
+        {
+            crc16BenchSink = crc16BenchMethods[m].func(CRC16_BENCH_SEED, crc16BenchMsg, size);
+        }
+        ns = (double)(Crc16BenchNs() - start) / ((double)count * (double)size);
+        if(0u == m)
+        {
+            nsBitwise = ns;
+        }
+
+        printf("  %-10s %6.3f ns/byte, %7.1f MB/s, x%.1f of bitwise%s\n", crc16BenchMethods[m].name, ns,
+            1000.0 / ns, nsBitwise / ns, (0u != mismatch) ? ", FAILED" : "");
+    }
+
+    return((0u == errors) ? 0 : 1);
+}
+
+
+/* [] END OF FILE */
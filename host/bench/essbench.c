@@ -0,0 +1,516 @@
+/*******************************************************************************
+* File Name: essbench.c
+*
+* Version 1.0
+*
+* Description:
+*  This file contains the host test and benchmark of the Environmental Sensing
+*  profile: the sensor deadlines of the timer wheel, the notification
+*  triggers and the records of the ESS History service. The main loop of
+*  main.c is run once a simulated second. The client keeps its own model of
+*  the simulated sensors and checks:
+*
+*   - the updates of every sensor against the measurement period and the
+*     update interval, late by no more than the slack of the wheel;
+*   - every notification against the value of the model, the notifications
+*     of the AND sensor against its notification interval and the ones of
+*     the OR sensor against its updates, none once they are disabled;
+*   - the Descriptor Value Changed indication of a write of the client;
+*   - the History chunks, read and notified, of every sensor against the
+*     records of the model, downsampled by the sampling function, and the
+*     error responses of bad requests.
+*
+*  The count argument is the number of simulated seconds, see bench.c. The
+*  descriptors are the ones of the simulated GATT database, see
+*  sim/ess/cyble_ess.c.
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "common.h"
+#include "bench.h"
+
+
+/***************************************
+*        Data Struct Definition
+***************************************/
+/* A sensor as the client knows it from the descriptors */
+typedef struct
+{
+    uint16 init;                /* Value before the first update */
+    uint16 max;                 /* The value rises by step below max ... */
+    uint16 min;                 /* ... then falls to min, or holds when not wrap */
+    uint16 step;
+    uint8  wrap;
+    uint8  fn;                  /* Sampling function */
+    uint8  ratio;               /* Updates of a record */
+    uint8  isAnd;               /* ES Configuration */
+    uint32 period;              /* Measurement period, s */
+    uint32 interval;            /* Update interval, s */
+    uint32 ntfInterval;         /* Operand of the interval trigger, s */
+} ESS_BENCH_SENSOR_T;
+
+
+/***************************************
+*        Constants
+***************************************/
+static const ESS_BENCH_SENSOR_T essBenchSensor[ESS_SENSOR_NUM] =
+{
+    {INIT_WIND_SPEED, WIND_SPEED_MAX1, WIND_SPEED_MIN1, WIND_UPDATE_STEP_1, 1u, ESS_HIST_FN_INSTANTANEOUS, 1u, 0u,
+        15u, 15u, 30u},
+    {INIT_WIND_SPEED, WIND_SPEED_MAX2, WIND_SPEED_MIN2, WIND_UPDATE_STEP_2, 0u, ESS_HIST_FN_INSTANTANEOUS, 1u, 1u,
+        20u, 20u, 30u},
+    {INIT_HUMIDITY, HUMIDITY_MAX, HUMIDITY_MIN, HUMIDITY_UPDATE_STEP, 1u, ESS_HIST_FN_MAXIMUM, 2u, 0u,
+        20u, 10u, 30u},
+};
+
+
+/* Globals of main.c used by the profile */
+CYBLE_CONN_HANDLE_T connectionHandle;
+volatile uint32 mainTimer = 0u;
+uint32 prevMainTimer;
+uint16 essChangeIndex = 0u;
+CYBLE_ESS_CHARACTERISTIC_DATA_T humidity;
+CYBLE_ESS_CHARACTERISTIC_DATA_T windSpeed[SIZE_2_BYTES];
+
+static uint16 *benchModel[ESS_SENSOR_NUM];  /* Values of the sensors, after n updates */
+static uint8 benchNtfEnabled[ESS_SENSOR_NUM];
+
+static uint32 rxNum[ESS_SENSOR_NUM];        /* Notifications received */
+static uint32 rxTime[ESS_SENSOR_NUM];       /* mainTimer of the last one */
+static uint8 rxDvc[SIZE_4_BYTES];           /* The Descriptor Value Changed indication */
+static uint32 rxDvcNum;
+static uint8 rxChunkSensor;                 /* Sensor of the History chunks expected */
+static uint32 rxChunkNext;                  /* Sequence of the next record expected */
+static uint32 rxChunkNum;
+
+static uint32 errors;
+
+
+/*******************************************************************************
+* Function Name: EssBenchUpdates
+********************************************************************************
+*
+* Summary:
+*   Counts the updates of a sensor from its history.
+*
+*******************************************************************************/
+static uint32 EssBenchUpdates(uint8 sensor)
+{
+    const ESS_HIST_T *hist = &essSensor[sensor]->hist;
+
+    return((hist->seq * hist->ratio) + hist->samples);
+}
+
+
+/*******************************************************************************
+* Function Name: EssBenchDue
+********************************************************************************
+*
+* Summary:
+*   Counts the updates of a sensor due at a second: the first at the end of
+*   the measurement period, then one every update interval.
+*
+*******************************************************************************/
+static uint32 EssBenchDue(uint8 sensor, uint32 now)
+{
+    const ESS_BENCH_SENSOR_T *model = &essBenchSensor[sensor];
+
+    return((now >= model->period) ? (((now - model->period) / model->interval) + 1u) : 0u);
+}
+
+
+/*******************************************************************************
+* Function Name: EssBenchRecord
+********************************************************************************
+*
+* Summary:
+*   Computes a History record of a sensor from the model: the last or the
+*   maximum of the updates of the record.
+*
+*******************************************************************************/
+static uint16 EssBenchRecord(uint8 sensor, uint32 seq)
+{
+    const ESS_BENCH_SENSOR_T *model = &essBenchSensor[sensor];
+    uint32 n = (seq * model->ratio) + 1u;
+    uint16 value = benchModel[sensor][n];
+
+    for(n++; n <= ((seq + 1u) * model->ratio); n++)
+    {
+        if((ESS_HIST_FN_INSTANTANEOUS == model->fn) || (benchModel[sensor][n] > value))
+        {
+            value = benchModel[sensor][n];
+        }
+    }
+
+    return(value);
+}
+
+
+/*******************************************************************************
+* Function Name: EssBenchCheckChunk
+********************************************************************************
+*
+* Summary:
+*   Checks a History chunk: the sensor, the length of the records, the
+*   sequence of the first one that follows the previous chunk and the
+*   records against the model.
+*
+* Return:
+*   The number of the records in the chunk.
+*
+*******************************************************************************/
+static uint8 EssBenchCheckChunk(uint16 length, const uint8 chunk[])
+{
+    uint32 seq = ((uint32)CyBle_Get16ByPtr(&chunk[ESS_HIST_CHUNK_SEQ_OFFSET + SIZE_2_BYTES]) << 16u) |
+        CyBle_Get16ByPtr(&chunk[ESS_HIST_CHUNK_SEQ_OFFSET]);
+    uint8 count = chunk[ESS_HIST_CHUNK_COUNT_OFFSET];
+    uint8 n;
+
+    if((rxChunkSensor != chunk[ESS_HIST_CHUNK_SENSOR_OFFSET]) || (0u == count) ||
+       (length < (ESS_HIST_CHUNK_HDR_LEN + ((uint16)count * SIZE_2_BYTES))) || (rxChunkNext != seq))
+    {
+        printf("  chunk of sensor %u: %u records from %u, expected from %u\n",
+            (unsigned)chunk[ESS_HIST_CHUNK_SENSOR_OFFSET], (unsigned)count, (unsigned)seq, (unsigned)rxChunkNext);
+        errors++;
+    }
+    else
+    {
+        for(n = 0u; n < count; n++)
+        {
+            if(CyBle_Get16ByPtr(&chunk[ESS_HIST_CHUNK_HDR_LEN + (n * SIZE_2_BYTES)]) !=
+               EssBenchRecord(rxChunkSensor, seq + n))
+            {
+                errors++;
+            }
+        }
+    }
+
+    return(count);
+}
+
+
+/*******************************************************************************
+* Function Name: EssBenchRx
+********************************************************************************
+*
+* Summary:
+*   Client side of the link: checks the notified values against the model,
+*   keeps the Descriptor Value Changed indication and checks the History
+*   chunks.
+*
+*******************************************************************************/
+static void EssBenchRx(uint16 attrHandle, uint16 length, const uint8 value[], uint8 isIndication)
+{
+    const ESS_BENCH_SENSOR_T *model;
+    uint32 updates;
+    uint8 sensor = (uint8)(attrHandle - CYBLE_SIM_ESS_HANDLE(0u));
+    uint16 mtu = CYBLE_GATT_DEFAULT_MTU;
+
+    if(sensor < ESS_SENSOR_NUM)
+    {
+        model = &essBenchSensor[sensor];
+        updates = EssBenchUpdates(sensor);
+        if((0u != isIndication) || (0u == benchNtfEnabled[sensor]) || (SIZE_2_BYTES != length) ||
+           (CyBle_Get16ByPtr(value) != benchModel[sensor][updates]) ||
+           ((0u != model->isAnd) && (0u != rxNum[sensor]) && ((mainTimer - rxTime[sensor]) < model->ntfInterval)))
+        {
+            printf("  sensor %u at %u s: %u after %u updates, expected %u\n", (unsigned)sensor, (unsigned)mainTimer,
+                (unsigned)CyBle_Get16ByPtr(value), (unsigned)updates, (unsigned)benchModel[sensor][updates]);
+            errors++;
+        }
+        rxNum[sensor]++;
+        rxTime[sensor] = mainTimer;
+    }
+    else if((CYBLE_SIM_ESS_DVC_HANDLE == attrHandle) && (0u != isIndication) && (SIZE_4_BYTES == length))
+    {
+        (void)memcpy(rxDvc, value, SIZE_4_BYTES);
+        rxDvcNum++;
+    }
+    else if((ESS_HIST_CHAR_HANDLE == attrHandle) && (0u == isIndication))
+    {
+        /* A chunk is sized to the MTU, no longer than the records it has */
+        (void)CyBle_GattGetMtuSize(&mtu);
+        if((length > (mtu - ESS_HIST_NTF_HDR_LEN)) || (length > ESS_HIST_CHUNK_MAX) ||
+           (length != (ESS_HIST_CHUNK_HDR_LEN + ((uint16)value[ESS_HIST_CHUNK_COUNT_OFFSET] * SIZE_2_BYTES))))
+        {
+            errors++;
+        }
+        rxChunkNext += EssBenchCheckChunk(length, value);
+        rxChunkNum++;
+    }
+    else
+    {
+        errors++;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: EssBenchModel
+********************************************************************************
+*
+* Summary:
+*   Computes the values of a sensor after 0 to updates updates.
+*
+*******************************************************************************/
+static uint16 *EssBenchModel(uint8 sensor, uint32 updates)
+{
+    const ESS_BENCH_SENSOR_T *model = &essBenchSensor[sensor];
+    uint16 *values = calloc(updates + 1u, sizeof(uint16));
+    uint32 n;
+
+    if(NULL != values)
+    {
+        values[0u] = model->init;
+        for(n = 1u; n <= updates; n++)
+        {
+            if(model->max > values[n - 1u])
+            {
+                values[n] = values[n - 1u] + model->step;
+            }
+            else
+            {
+                values[n] = (0u != model->wrap) ? model->min : values[n - 1u];
+            }
+        }
+    }
+
+    return(values);
+}
+
+
+/*******************************************************************************
+* Function Name: EssBenchWrite
+********************************************************************************
+*
+* Summary:
+*   Sends a Write Request of the ESS History service and checks the response.
+*
+*******************************************************************************/
+static void EssBenchWrite(const char *name, uint16 attrHandle, uint16 length, uint8 value[], uint16 rspExpected)
+{
+    CYBLE_GATTS_WRITE_REQ_PARAM_T wrReqParam;
+    uint16 rsp;
+
+    wrReqParam.handleValPair.attrHandle = attrHandle;
+    wrReqParam.handleValPair.value.val = value;
+    wrReqParam.handleValPair.value.len = length;
+    wrReqParam.handleValPair.value.actualLen = length;
+    wrReqParam.connHandle = cyBle_connHandle;
+    EssHistWriteReq(&wrReqParam);
+
+    rsp = CyBleSim_GattsTakeRsp();
+    if(rsp != rspExpected)
+    {
+        printf("  %s: response 0x%x, expected 0x%x\n", name, (unsigned)rsp, (unsigned)rspExpected);
+        errors++;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: EssBenchHist
+********************************************************************************
+*
+* Summary:
+*   Requests the History of a sensor from its first record, checks the chunk
+*   read, then streams the records to the newest one.
+*
+*******************************************************************************/
+static void EssBenchHist(uint8 sensor)
+{
+    const ESS_HIST_T *hist = &essSensor[sensor]->hist;
+    uint8 req[ESS_HIST_REQ_LEN] = {0u};
+    uint8 chunk[CYBLE_SIM_ESS_HIST_VALUE_MAX];
+    uint8 count;
+    uint32 n;
+
+    req[ESS_HIST_REQ_SENSOR_OFFSET] = sensor;
+    rxChunkSensor = sensor;
+    rxChunkNext = hist->seq - hist->count;
+    rxChunkNum = 0u;
+    EssBenchWrite("history", ESS_HIST_CHAR_HANDLE, ESS_HIST_REQ_LEN, req, CYBLE_GATT_ERR_NONE);
+
+    /* The chunk read holds all the records that fit, from the oldest one kept */
+    CyBleSim_EssHistRead(chunk);
+    count = (hist->count < ((ESS_HIST_CHUNK_MAX - ESS_HIST_CHUNK_HDR_LEN) / SIZE_2_BYTES)) ?
+        (uint8)hist->count : (uint8)((ESS_HIST_CHUNK_MAX - ESS_HIST_CHUNK_HDR_LEN) / SIZE_2_BYTES);
+    if(count != EssBenchCheckChunk(ESS_HIST_CHUNK_MAX, chunk))
+    {
+        errors++;
+    }
+
+    for(n = 0u; (n <= hist->count) && (rxChunkNext != hist->seq); n++)
+    {
+        EssHistStream();
+        CyBleSim_Flush();
+    }
+    printf("history of sensor %u: records [%u, %u) in %u chunks\n", (unsigned)sensor,
+        (unsigned)(hist->seq - hist->count), (unsigned)rxChunkNext, (unsigned)rxChunkNum);
+    if(rxChunkNext != hist->seq)
+    {
+        errors++;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: EssBenchSecond
+********************************************************************************
+*
+* Summary:
+*   Runs the main loop of main.c for one simulated second and checks the
+*   updates of the sensors against their deadlines.
+*
+*******************************************************************************/
+static void EssBenchSecond(void)
+{
+    uint32 updates;
+    uint32 slack;
+    uint8 sensor;
+
+    mainTimer++;
+    CyBleSim_Run(1000000u);
+    CyBle_ProcessEvents();
+    EssProcessTimers(mainTimer);
+    EssHistStream();
+
+    if(prevMainTimer != mainTimer)
+    {
+        if(isNtfCheckPending == YES)
+        {
+            isNtfCheckPending = NO;
+            for(sensor = 0u; sensor < ESS_SENSOR_NUM; sensor++)
+            {
+                ChkNtfAndSendData(essSensor[sensor]);
+            }
+        }
+        if((isIndicationEnabled == YES) && (isIndicationPending == YES))
+        {
+            HandleIndication(indicationValue);
+            isIndicationPending = NO;
+            CyBle_ProcessEvents();
+        }
+    }
+    prevMainTimer = mainTimer;
+
+    /* The client takes the notifications of the second */
+    CyBleSim_Flush();
+
+    for(sensor = 0u; sensor < ESS_SENSOR_NUM; sensor++)
+    {
+        updates = EssBenchUpdates(sensor);
+        slack = ESS_SCHED_SLACK(essBenchSensor[sensor].interval);
+        if((updates > EssBenchDue(sensor, mainTimer)) ||
+           ((mainTimer > slack) && (updates < EssBenchDue(sensor, mainTimer - slack))))
+        {
+            printf("  sensor %u at %u s: %u updates, %u due\n", (unsigned)sensor, (unsigned)mainTimer,
+                (unsigned)updates, (unsigned)EssBenchDue(sensor, mainTimer));
+            errors++;
+        }
+    }
+}
+
+
+int main(int argc, char *argv[])
+{
+    uint8 config = CYBLE_ESS_CONF_BOOLEAN_OR;
+    uint8 val[ESS_HIST_REQ_LEN] = {0u};
+    BENCH_CFG_T cfg;
+    uint32 n;
+    uint8 sensor;
+
+    BenchParse(argc, argv, &cfg);
+    for(sensor = 0u; sensor < ESS_SENSOR_NUM; sensor++)
+    {
+        benchModel[sensor] = EssBenchModel(sensor, EssBenchDue(sensor, cfg.count));
+        if(NULL == benchModel[sensor])
+        {
+            return(1);
+        }
+    }
+
+    CyBleSim_Start(&cfg.link);
+    CyBleSim_SetRxHandler(&EssBenchRx);
+    connectionHandle = cyBle_connHandle;
+
+    EssInit();
+    for(sensor = 0u; sensor < ESS_SENSOR_NUM; sensor++)
+    {
+        if((essBenchSensor[sensor].fn != essSensor[sensor]->hist.fn) ||
+           (essBenchSensor[sensor].ratio != essSensor[sensor]->hist.ratio))
+        {
+            errors++;
+        }
+        benchNtfEnabled[sensor] = 1u;
+        CyBleSim_EsssWriteCccd(essSensor[sensor]->EssChrIndex, essSensor[sensor]->chrInstance,
+            CYBLE_CCCD_NOTIFICATION);
+    }
+    CyBleSim_EsssWriteCccd(CYBLE_ESS_DESCRIPTOR_VALUE_CHANGED, 0u, CYBLE_CCCD_INDICATION);
+
+    NtfStatReset();
+    for(n = 0u; n < cfg.count; n++)
+    {
+        /* Half way, the client rewrites an ES Configuration and stops the
+        * notifications of the humidity.
+        */
+        if((cfg.count / 2u) == n)
+        {
+            CyBleSim_EsssWriteDescr(CYBLE_ESS_TRUE_WIND_SPEED, CHARACTERISTIC_INSTANCE_1, CYBLE_ESS_ES_CONFIG_DESCR,
+                SIZE_1_BYTE, &config);
+            benchNtfEnabled[ESS_SENSOR_NUM - 1u] = 0u;
+            CyBleSim_EsssWriteCccd(CYBLE_ESS_HUMIDITY, CHARACTERISTIC_INSTANCE_1, CYBLE_CCCD_DEFAULT);
+        }
+        EssBenchSecond();
+    }
+    BenchReport("ess", ntfStat.buildCount, ntfStat.buildCycles, ntfStat.buildCyclesMax, ntfStat.busyPolls);
+
+    for(sensor = 0u; sensor < ESS_SENSOR_NUM; sensor++)
+    {
+        printf("sensor %u: %u updates, %u notifications\n", (unsigned)sensor, (unsigned)EssBenchUpdates(sensor),
+            (unsigned)rxNum[sensor]);
+    }
+
+    /* The OR sensor changes at every update, the AND one waits for its interval */
+    if((rxNum[0u] != EssBenchUpdates(0u)) || (0u == rxNum[1u]) || (rxNum[1u] >= EssBenchUpdates(1u)) ||
+       (rxNum[2u] >= EssBenchUpdates(2u)))
+    {
+        errors++;
+    }
+    if((1u != rxDvcNum) ||
+       ((CYBLE_ESS_VALUE_CHANGE_SOURCE_CLIENT | CYBLE_ESS_VALUE_CHANGE_ES_CONFIG) != CyBle_Get16ByPtr(&rxDvc[0u])) ||
+       (CYBLE_UUID_CHAR_TRUE_WIND_SPEED != CyBle_Get16ByPtr(&rxDvc[SIZE_2_BYTES])))
+    {
+        printf("  descriptor value changed: %u indications\n", (unsigned)rxDvcNum);
+        errors++;
+    }
+
+    /* History */
+    CyBle_Set16ByPtr(val, CYBLE_CCCD_NOTIFICATION);
+    EssBenchWrite("cccd length", ESS_HIST_CCCD_HANDLE, SIZE_1_BYTE, val, CYBLE_GATT_ERR_INVALID_ATTRIBUTE_LEN);
+    EssBenchWrite("cccd", ESS_HIST_CCCD_HANDLE, CYBLE_CCCD_LEN, val, CYBLE_GATT_ERR_NONE);
+    for(sensor = 0u; sensor < ESS_SENSOR_NUM; sensor++)
+    {
+        EssBenchHist(sensor);
+    }
+    val[ESS_HIST_REQ_SENSOR_OFFSET] = 0u;
+    EssBenchWrite("request length", ESS_HIST_CHAR_HANDLE, ESS_HIST_REQ_LEN - 1u, val,
+        CYBLE_GATT_ERR_INVALID_ATTRIBUTE_LEN);
+    val[ESS_HIST_REQ_SENSOR_OFFSET] = ESS_SENSOR_NUM;
+    EssBenchWrite("request sensor", ESS_HIST_CHAR_HANDLE, ESS_HIST_REQ_LEN, val, CYBLE_GATT_ERR_OUT_OF_RANGE);
+    EssBenchWrite("other attribute", CYBLE_SIM_ESS_HANDLE(0u), SIZE_2_BYTES, val, CYBLE_SIM_GATTS_NO_RSP);
+
+    printf("  %u errors\n", (unsigned)errors);
+
+    return((0u == errors) ? 0 : 1);
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,667 @@
+/*******************************************************************************
+* File Name: glsbench.c
+*
+* Version 1.0
+*
+* Description:
+*  This file contains the host test and benchmark of the Glucose profile
+*  record store on the simulated flash. The store is seeded on the erased
+*  flash, then the measurements, one a minute with every 7th one entered an
+*  hour late, wrap the flash record log many times. The client runs RACP
+*  requests by the sequence number and by the time and checks every
+*  reported record against a model of the log. The model orders the
+*  sequence numbers by the positions of the records, so with more than
+*  65535 measurements the requests also cross the wrap of the sequence
+*  numbers. Then the deletions are
+*  synchronized, the device is reset, and the flash contents and the
+*  restored store are checked. At last, an interrupted flash write is
+*  recovered after a reset.
+*
+*  The count argument is the number of measurements, see bench.c.
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "main.h"
+#include "bench.h"
+
+
+/***************************************
+*        Constants
+***************************************/
+#define GLS_BENCH_NONE              (0xFFFFFFFFu)
+
+
+/* Globals of main.c used by the profile */
+CYBLE_API_RESULT_T apiResult;
+uint16 i;
+uint8 flag;
+
+/* Of glss.c and reclog.c */
+extern uint8 racpCommand;
+extern const uint8 recLogFlash[];
+
+static uint32 *benchKey;        /* Time key of every position of the log */
+static uint8 *benchDeleted;     /* Positions deleted by the client */
+static uint32 benchNum;         /* Positions appended */
+static uint32 *benchExpect;     /* Positions a request is expected to report */
+
+static uint32 *rxPos;           /* Positions of the reported records */
+static uint32 rxNum;
+static uint32 rxCtxPos = GLS_BENCH_NONE;    /* Position of the expected Glucose Measurement Context */
+static uint8 rxRacp[4u];        /* The RACP response */
+static uint32 rxRacpNum;
+
+static uint32 errors;
+
+
+/*******************************************************************************
+* Function Name: PrintApiResult
+********************************************************************************
+*
+* Summary:
+*   Replaces the one of debug.c.
+*
+*******************************************************************************/
+void PrintApiResult(void)
+{
+    printf("0x%x \n", (unsigned)apiResult);
+}
+
+
+/*******************************************************************************
+* Function Name: GlsBenchRx
+********************************************************************************
+*
+* Summary:
+*   Collects the reported records and the RACP response. The sequence
+*   number of every Glucose Measurement is mapped to the latest position
+*   with it and the time is checked against the model, and every Glucose
+*   Measurement with the Context Information Follows flag must be followed
+*   by its context.
+*
+*******************************************************************************/
+static void GlsBenchRx(uint16 attrHandle, uint16 length, const uint8 value[], uint8 isIndication)
+{
+    CYBLE_DATE_TIME_T time;
+    uint32 pos;
+
+    if((CYBLE_SIM_GLS_HANDLE(CYBLE_GLS_GLMT) == attrHandle) && (0u == isIndication) && (length >= 10u))
+    {
+        pos = (benchNum - 1u) - (uint16)(GLS_REC_SEQ_NUM(benchNum - 1u) - CyBle_Get16ByPtr(&value[1u]));
+        time.year = CyBle_Get16ByPtr(&value[3u]);
+        time.month = value[5u];
+        time.day = value[6u];
+        time.hours = value[7u];
+        time.minutes = value[8u];
+        time.seconds = value[9u];
+
+        if((GLS_BENCH_NONE != rxCtxPos) || (pos >= benchNum) || (GlsRecTimeToKey(&time) != benchKey[pos]))
+        {
+            errors++;
+        }
+        rxCtxPos = (0u != (value[0u] & CYBLE_GLS_GLMT_FLG_CIF)) ? pos : GLS_BENCH_NONE;
+        rxPos[rxNum] = pos;
+        rxNum++;
+    }
+    else if((CYBLE_SIM_GLS_HANDLE(CYBLE_GLS_GLMC) == attrHandle) && (0u == isIndication) && (length >= 3u))
+    {
+        if((GLS_BENCH_NONE == rxCtxPos) || (GLS_REC_SEQ_NUM(rxCtxPos) != CyBle_Get16ByPtr(&value[1u])))
+        {
+            errors++;
+        }
+        rxCtxPos = GLS_BENCH_NONE;
+    }
+    else if((CYBLE_SIM_GLS_HANDLE(CYBLE_GLS_RACP) == attrHandle) && (0u != isIndication) && (4u == length))
+    {
+        (void)memcpy(rxRacp, value, sizeof(rxRacp));
+        rxRacpNum++;
+    }
+    else
+    {
+        errors++;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: GlsBenchRacp
+********************************************************************************
+*
+* Summary:
+*   Writes a RACP request and runs the profile until the response is sent
+*   and delivered.
+*
+*******************************************************************************/
+static void GlsBenchRacp(uint8 length, const uint8 value[])
+{
+    rxNum = 0u;
+    rxRacpNum = 0u;
+
+    CyBleSim_GlssWriteRacp(length, value);
+    do
+    {
+        GlsProcess();
+        CyBle_ProcessEvents();
+    }
+    while(0u != racpCommand);
+    CyBleSim_Flush();
+
+    if((1u != rxRacpNum) || (GLS_BENCH_NONE != rxCtxPos))
+    {
+        errors++;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: GlsBenchPutTime
+********************************************************************************
+*
+* Summary:
+*   Writes the User Facing Time operand of the time key.
+*
+*******************************************************************************/
+static void GlsBenchPutTime(uint8 ptr[], uint32 key)
+{
+    CYBLE_DATE_TIME_T time;
+
+    GlsRecKeyToTime(key, &time);
+    CyBle_Set16ByPtr(ptr, time.year);
+    ptr[2u] = time.month;
+    ptr[3u] = time.day;
+    ptr[4u] = time.hours;
+    ptr[5u] = time.minutes;
+    ptr[6u] = time.seconds;
+}
+
+
+/*******************************************************************************
+* Function Name: GlsBenchCompare
+********************************************************************************
+*
+* Summary:
+*   Orders the positions by the time key, the positions with equal keys by
+*   the position.
+*
+*******************************************************************************/
+static int GlsBenchCompare(const void *a, const void *b)
+{
+    uint32 posA = *(const uint32 *)a;
+    uint32 posB = *(const uint32 *)b;
+    int result;
+
+    if(benchKey[posA] != benchKey[posB])
+    {
+        result = (benchKey[posA] < benchKey[posB]) ? -1 : 1;
+    }
+    else
+    {
+        result = (posA < posB) ? -1 : 1;
+    }
+
+    return(result);
+}
+
+
+/*******************************************************************************
+* Function Name: GlsBenchExpect
+********************************************************************************
+*
+* Summary:
+*   Lists the records of the model a request selects: the valid positions
+*   within [min, max] for a request by the sequence number, or with the
+*   time key within [min, max], in the order of the positions or
+*   chronologically.
+*
+* Return:
+*   The number of the records.
+*
+*******************************************************************************/
+static uint32 GlsBenchExpect(uint8 byTime, uint32 min, uint32 max)
+{
+    uint32 pos;
+    uint32 num = 0u;
+    uint32 value;
+
+    for(pos = recLogTail; pos < recLogHead; pos++)
+    {
+        value = (0u != byTime) ? benchKey[pos] : pos;
+        if((0u == benchDeleted[pos]) && (value >= min) && (value <= max))
+        {
+            benchExpect[num] = pos;
+            num++;
+        }
+    }
+
+    if(0u != byTime)
+    {
+        qsort(benchExpect, num, sizeof(benchExpect[0u]), &GlsBenchCompare);
+    }
+
+    return(num);
+}
+
+
+/*******************************************************************************
+* Function Name: GlsBenchCheck
+********************************************************************************
+*
+* Summary:
+*   Checks the records reported by a Report Stored Records request and the
+*   response code against the model.
+*
+*******************************************************************************/
+static void GlsBenchCheck(const char *name, uint8 byTime, uint32 min, uint32 max)
+{
+    uint32 num = GlsBenchExpect(byTime, min, max);
+    uint8 rsp = (0u != num) ? CYBLE_GLS_RACP_RSP_SUCCESS : CYBLE_GLS_RACP_RSP_NO_REC;
+    uint32 mismatch = 0u;
+    uint32 n;
+
+    if(num != rxNum)
+    {
+        mismatch++;
+    }
+    for(n = 0u; (n < num) && (n < rxNum); n++)
+    {
+        if(benchExpect[n] != rxPos[n])
+        {
+            mismatch++;
+        }
+    }
+    if((CYBLE_GLS_RACP_OPC_RSP_CODE != rxRacp[0u]) || (CYBLE_GLS_RACP_OPC_REPORT_REC != rxRacp[2u]) ||
+       (rsp != rxRacp[3u]))
+    {
+        mismatch++;
+    }
+
+    printf("  %s: %u of %u records%s\n", name, (unsigned)rxNum, (unsigned)num, (0u != mismatch) ? ", FAILED" : "");
+    errors += mismatch;
+}
+
+
+/*******************************************************************************
+* Function Name: GlsBenchCount
+********************************************************************************
+*
+* Summary:
+*   Runs a Report Number of Stored Records request of all the records.
+*
+*******************************************************************************/
+static void GlsBenchCount(void)
+{
+    static const uint8 req[] = {CYBLE_GLS_RACP_OPC_REPORT_NUM_REC, CYBLE_GLS_RACP_OPR_ALL};
+    uint32 num = GlsBenchExpect(0u, 0u, GLS_BENCH_NONE);
+
+    GlsBenchRacp(sizeof(req), req);
+    if((CYBLE_GLS_RACP_OPC_NUM_REC_RSP != rxRacp[0u]) || (num != CyBle_Get16ByPtr(&rxRacp[2u])))
+    {
+        errors++;
+    }
+    printf("  number of records: %u\n", (unsigned)CyBle_Get16ByPtr(&rxRacp[2u]));
+}
+
+
+/*******************************************************************************
+* Function Name: GlsBenchSeq
+********************************************************************************
+*
+* Summary:
+*   Runs a request by the sequence number, the operator selects which of
+*   the sequence numbers of the minPos and maxPos positions are sent. The
+*   deletions are applied to the model, the reports are checked.
+*
+*******************************************************************************/
+static void GlsBenchSeq(const char *name, uint8 opCode, uint8 opr, uint32 minPos, uint32 maxPos)
+{
+    uint8 req[7u] = {opCode, opr, CYBLE_GLS_RACP_OPD_1};
+    uint8 length = 5u;
+    uint32 num;
+    uint32 n;
+
+    if(CYBLE_GLS_RACP_OPR_LESS == opr)
+    {
+        CyBle_Set16ByPtr(&req[3u], GLS_REC_SEQ_NUM(maxPos));
+        minPos = 0u;
+    }
+    else if(CYBLE_GLS_RACP_OPR_GREAT == opr)
+    {
+        CyBle_Set16ByPtr(&req[3u], GLS_REC_SEQ_NUM(minPos));
+        maxPos = GLS_BENCH_NONE;
+    }
+    else
+    {
+        CyBle_Set16ByPtr(&req[3u], GLS_REC_SEQ_NUM(minPos));
+        CyBle_Set16ByPtr(&req[5u], GLS_REC_SEQ_NUM(maxPos));
+        length = 7u;
+    }
+
+    if(CYBLE_GLS_RACP_OPC_DELETE_REC == opCode)
+    {
+        num = GlsBenchExpect(0u, minPos, maxPos);
+        GlsBenchRacp(length, req);
+        if((0u != rxNum) || (CYBLE_GLS_RACP_OPC_DELETE_REC != rxRacp[2u]) ||
+           (((0u != num) ? CYBLE_GLS_RACP_RSP_SUCCESS : CYBLE_GLS_RACP_RSP_NO_REC) != rxRacp[3u]))
+        {
+            errors++;
+        }
+        for(n = 0u; n < num; n++)
+        {
+            benchDeleted[benchExpect[n]] = 1u;
+        }
+        printf("  %s: %u records deleted\n", name, (unsigned)num);
+    }
+    else
+    {
+        GlsBenchRacp(length, req);
+        GlsBenchCheck(name, 0u, minPos, maxPos);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: GlsBenchTime
+********************************************************************************
+*
+* Summary:
+*   Runs a Report Stored Records request by the User Facing Time within
+*   [minKey, maxKey] and checks the chronological report.
+*
+*******************************************************************************/
+static void GlsBenchTime(const char *name, uint32 minKey, uint32 maxKey)
+{
+    uint8 req[17u] = {CYBLE_GLS_RACP_OPC_REPORT_REC, CYBLE_GLS_RACP_OPR_WITHIN, CYBLE_GLS_RACP_OPD_2};
+
+    GlsBenchPutTime(&req[3u], minKey);
+    GlsBenchPutTime(&req[10u], maxKey);
+    GlsBenchRacp(sizeof(req), req);
+    GlsBenchCheck(name, 1u, minKey, maxKey);
+}
+
+
+/*******************************************************************************
+* Function Name: GlsBenchEnd
+********************************************************************************
+*
+* Summary:
+*   Runs a First Record or Last Record request, which must report the
+*   oldest or the most recent valid record.
+*
+*******************************************************************************/
+static void GlsBenchEnd(const char *name, uint8 opr)
+{
+    uint8 req[2u] = {CYBLE_GLS_RACP_OPC_REPORT_REC, opr};
+    uint32 num = GlsBenchExpect(0u, 0u, GLS_BENCH_NONE);
+    uint32 pos;
+
+    GlsBenchRacp(sizeof(req), req);
+    if(0u != num)
+    {
+        pos = (CYBLE_GLS_RACP_OPR_FIRST == opr) ? benchExpect[0u] : benchExpect[num - 1u];
+        GlsBenchCheck(name, 0u, pos, pos);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: GlsBenchAdd
+********************************************************************************
+*
+* Summary:
+*   Stores a measurement with the time key and adds it to the model.
+*
+* Return:
+*   The position of the record or GLS_REC_INVALID.
+*
+*******************************************************************************/
+static uint32 GlsBenchAdd(uint32 key)
+{
+    CYBLE_GLS_GLMT_T glmt = glsSimGlucose[benchNum % CYBLE_GLS_REC_NUM];
+    uint32 pos;
+
+    GlsRecKeyToTime(key, &glmt.baseTime);
+    pos = GlsRecAdd(&glmt, &glsSimGluCont[benchNum % CYBLE_GLS_REC_NUM]);
+    if(GLS_REC_INVALID != pos)
+    {
+        benchKey[pos] = key;
+        benchDeleted[pos] = 0u;
+        benchNum = pos + 1u;
+    }
+
+    return(pos);
+}
+
+
+/*******************************************************************************
+* Function Name: GlsBenchReset
+********************************************************************************
+*
+* Summary:
+*   Restarts the profile as after a device reset: only the flash contents
+*   are kept.
+*
+*******************************************************************************/
+static void GlsBenchReset(void)
+{
+    GlsRptReset();
+    (void)memset(glsRecKey, 0, sizeof(glsRecKey));
+    recLogTail = 0u;
+    recLogHead = 0u;
+    GlsInit();
+}
+
+
+/*******************************************************************************
+* Function Name: GlsBenchFlash
+********************************************************************************
+*
+* Summary:
+*   Checks the flash contents of the log against the model: the row
+*   headers, the deletion bitmaps and the sequence numbers of the records.
+*   Also checks that all the rows wear evenly.
+*
+*******************************************************************************/
+static void GlsBenchFlash(void)
+{
+    uint32 firstRow = (((uint32)(uintptr_t)recLogFlash) - CYDEV_FLASH_BASE) / CY_FLASH_SIZEOF_ROW;
+    uint32 writesMin = GLS_BENCH_NONE;
+    uint32 writesMax = 0u;
+    uint32 mismatch = 0u;
+    uint32 writes;
+    uint32 pos;
+    uint32 row;
+    const uint8 *data;
+    REC_LOG_ROW_HDR_T hdr;
+    GLS_REC_LOG_T rec;
+
+    for(pos = recLogTail; pos < recLogHead; pos++)
+    {
+        data = CyFlashSim_Row(firstRow + ((pos / REC_LOG_REC_PER_ROW) % REC_LOG_ROWS));
+        if(NULL == data)
+        {
+            mismatch++;
+        }
+        else
+        {
+            (void)memcpy(&hdr, data, sizeof(hdr));
+            (void)memcpy(&rec, data + REC_LOG_ROW_HDR_SIZE + ((pos % REC_LOG_REC_PER_ROW) * REC_LOG_REC_SIZE),
+                sizeof(rec));
+            if((REC_LOG_ROW_MAGIC != hdr.magic) || ((pos / REC_LOG_REC_PER_ROW) != hdr.seq) ||
+               (benchDeleted[pos] != ((hdr.deleted >> (pos % REC_LOG_REC_PER_ROW)) & 1u)) ||
+               (GLS_REC_SEQ_NUM(pos) != rec.glmt.seqNum))
+            {
+                mismatch++;
+            }
+        }
+    }
+
+    for(row = 0u; row < REC_LOG_ROWS; row++)
+    {
+        writes = CyFlashSim_RowWrites(firstRow + row);
+        writesMin = (writes < writesMin) ? writes : writesMin;
+        writesMax = (writes > writesMax) ? writes : writesMax;
+    }
+
+    /* The appends of a row differ by no more than the records of a row, a sync adds one write */
+    if((writesMax - writesMin) > (2u * REC_LOG_REC_PER_ROW))
+    {
+        mismatch++;
+    }
+
+    printf("  flash: %u rows of %u records, %u to %u writes per row%s\n", (unsigned)REC_LOG_ROWS,
+        (unsigned)REC_LOG_REC_PER_ROW, (unsigned)writesMin, (unsigned)writesMax, (0u != mismatch) ? ", FAILED" : "");
+    errors += mismatch;
+}
+
+
+int main(int argc, char *argv[])
+{
+    static const uint8 reportAll[] = {CYBLE_GLS_RACP_OPC_REPORT_REC, CYBLE_GLS_RACP_OPR_ALL};
+    BENCH_CFG_T cfg;
+    uint32 size;
+    uint32 key;
+    uint32 head;
+    uint32 tail;
+    uint32 n;
+
+    BenchParse(argc, argv, &cfg);
+    size = cfg.count + CYBLE_GLS_REC_NUM + REC_LOG_REC_PER_ROW;
+    benchKey = calloc(size, sizeof(uint32));
+    benchDeleted = calloc(size, sizeof(uint8));
+    benchExpect = calloc(size, sizeof(uint32));
+    rxPos = calloc(size, sizeof(uint32));
+    if((NULL == benchKey) || (NULL == benchDeleted) || (NULL == benchExpect) || (NULL == rxPos))
+    {
+        return(1);
+    }
+
+    CyBleSim_Start(&cfg.link);
+    CyBleSim_SetRxHandler(&GlsBenchRx);
+
+    /* The erased flash is seeded with the simulated records */
+    GlsInit();
+    for(n = 0u; n < CYBLE_GLS_REC_NUM; n++)
+    {
+        benchKey[n] = GlsRecTimeToKey(&glsSimGlucose[n].baseTime);
+    }
+    benchNum = CYBLE_GLS_REC_NUM;
+    if((0u != recLogTail) || (benchNum != recLogHead))
+    {
+        errors++;
+    }
+    CyBleSim_GlssWriteCccd(CYBLE_GLS_GLMT, CYBLE_CCCD_NOTIFICATION);
+    CyBleSim_GlssWriteCccd(CYBLE_GLS_GLMC, CYBLE_CCCD_NOTIFICATION);
+    CyBleSim_GlssWriteCccd(CYBLE_GLS_RACP, CYBLE_CCCD_INDICATION);
+
+    /* One measurement a minute, every 7th one is entered an hour late */
+    key = benchKey[CYBLE_GLS_REC_NUM - 1u];
+    for(n = 0u; n < cfg.count; n++)
+    {
+        key += 60u;
+        head = benchNum;
+        if(head != GlsBenchAdd(((n % 7u) == 3u) ? (key - 3600u) : key))
+        {
+            errors++;
+        }
+    }
+    if((benchNum != recLogHead) || ((recLogHead - recLogTail) < REC_LOG_CAPACITY) ||
+       ((recLogHead - recLogTail) > (REC_LOG_ROWS * REC_LOG_REC_PER_ROW)))
+    {
+        errors++;
+    }
+    printf("gls: %u measurements, records [%u, %u) in the log, sequence numbers %u - %u\n", (unsigned)benchNum,
+        (unsigned)recLogTail, (unsigned)recLogHead, (unsigned)GLS_REC_SEQ_NUM(recLogTail),
+        (unsigned)GLS_REC_SEQ_NUM(recLogHead - 1u));
+
+    NtfStatReset();
+    GlsBenchRacp(sizeof(reportAll), reportAll);
+    GlsBenchCheck("all", 0u, 0u, GLS_BENCH_NONE);
+    BenchReport("gls", ntfStat.buildCount, ntfStat.buildCycles, ntfStat.buildCyclesMax, ntfStat.busyPolls);
+
+    tail = recLogTail;
+    head = recLogHead;
+    GlsBenchCount();
+    GlsBenchSeq("seq within", CYBLE_GLS_RACP_OPC_REPORT_REC, CYBLE_GLS_RACP_OPR_WITHIN, tail + 10u, tail + 50u);
+    GlsBenchSeq("seq greater", CYBLE_GLS_RACP_OPC_REPORT_REC, CYBLE_GLS_RACP_OPR_GREAT, head - 20u, 0u);
+    GlsBenchSeq("seq less", CYBLE_GLS_RACP_OPC_REPORT_REC, CYBLE_GLS_RACP_OPR_LESS, 0u, tail + 5u);
+    GlsBenchSeq("seq across the log", CYBLE_GLS_RACP_OPC_REPORT_REC, CYBLE_GLS_RACP_OPR_WITHIN, tail + 5u, head - 5u);
+    GlsBenchSeq("seq greater, dropped", CYBLE_GLS_RACP_OPC_REPORT_REC, CYBLE_GLS_RACP_OPR_GREAT, tail - 5u, 0u);
+    GlsBenchSeq("seq less, not yet added", CYBLE_GLS_RACP_OPC_REPORT_REC, CYBLE_GLS_RACP_OPR_LESS, 0u, head + 5u);
+    if(((tail ^ (head - 1u)) >> 16u) != 0u)
+    {
+        /* The log holds sequence number 65535 and the 0 that follows it */
+        n = (head - 1u) & 0xFFFF0000u;
+        GlsBenchSeq("seq across the wrap", CYBLE_GLS_RACP_OPC_REPORT_REC, CYBLE_GLS_RACP_OPR_WITHIN, n - 10u, n + 10u);
+        GlsBenchSeq("seq less, wrapped", CYBLE_GLS_RACP_OPC_REPORT_REC, CYBLE_GLS_RACP_OPR_LESS, 0u, n + 3u);
+        GlsBenchSeq("seq greater, wrapped", CYBLE_GLS_RACP_OPC_REPORT_REC, CYBLE_GLS_RACP_OPR_GREAT, n - 3u, 0u);
+    }
+    GlsBenchTime("time within", benchKey[head - 200u], benchKey[head - 200u] + 3000u);
+    GlsBenchTime("time of the log", 0u, 0xFFFFFFFFu);
+
+    /* Deletions at both ends and in the middle */
+    GlsBenchSeq("delete seq less", CYBLE_GLS_RACP_OPC_DELETE_REC, CYBLE_GLS_RACP_OPR_LESS, 0u, tail + 1u);
+    GlsBenchSeq("delete seq greater", CYBLE_GLS_RACP_OPC_DELETE_REC, CYBLE_GLS_RACP_OPR_GREAT, head - 1u, 0u);
+    GlsBenchSeq("delete seq within", CYBLE_GLS_RACP_OPC_DELETE_REC, CYBLE_GLS_RACP_OPR_WITHIN, tail + 20u, tail + 40u);
+    GlsBenchSeq("seq within", CYBLE_GLS_RACP_OPC_REPORT_REC, CYBLE_GLS_RACP_OPR_WITHIN, tail + 10u, tail + 50u);
+    GlsBenchEnd("first", CYBLE_GLS_RACP_OPR_FIRST);
+    GlsBenchEnd("last", CYBLE_GLS_RACP_OPR_LAST);
+    GlsBenchCount();
+
+    /* The deletions are written to flash, then the store is restored from it */
+    while(0u != RecLogSync())
+    {
+    }
+    GlsBenchReset();
+    printf("reset: records [%u, %u) restored\n", (unsigned)recLogTail, (unsigned)recLogHead);
+    if((tail != recLogTail) || (head != recLogHead))
+    {
+        errors++;
+    }
+    GlsBenchFlash();
+    GlsBenchRacp(sizeof(reportAll), reportAll);
+    GlsBenchCheck("all", 0u, 0u, GLS_BENCH_NONE);
+    GlsBenchTime("time within", benchKey[head - 200u], benchKey[head - 200u] + 3000u);
+    GlsBenchEnd("first", CYBLE_GLS_RACP_OPR_FIRST);
+
+    /* A power loss in the second write of a row erases it, its first record is lost */
+    while((recLogHead % REC_LOG_REC_PER_ROW) != 1u)
+    {
+        key += 60u;
+        (void)GlsBenchAdd(key);
+    }
+    head = recLogHead;
+    CyFlashSim_Interrupt(0u);
+    if(GLS_REC_INVALID != GlsBenchAdd(key + 60u))
+    {
+        errors++;
+    }
+    GlsBenchReset();
+    printf("interrupted write: records [%u, %u) restored\n", (unsigned)recLogTail, (unsigned)recLogHead);
+    if((head - 1u) != recLogHead)
+    {
+        errors++;
+    }
+    benchNum = recLogHead;
+    GlsBenchRacp(sizeof(reportAll), reportAll);
+    GlsBenchCheck("all", 0u, 0u, GLS_BENCH_NONE);
+    key += 120u;
+    if(head != (GlsBenchAdd(key) + 1u))
+    {
+        errors++;
+    }
+    GlsBenchEnd("last", CYBLE_GLS_RACP_OPR_LAST);
+
+    printf("  %u errors\n", (unsigned)errors);
+
+    return((0u == errors) ? 0 : 1);
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,142 @@
+/*******************************************************************************
+* File Name: hrsbench.c
+*
+* Version 1.0
+*
+* Description:
+*  This file contains the host benchmark of the Heart Rate Sensor profile.
+*  The RR-Intervals of one full notification are added before every
+*  HrssSendHeartRateNtf() call, so the link is saturated. The peer checks
+*  that every RR-Interval arrives once and in order and that no notification
+*  exceeds the ATT MTU.
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stdio.h>
+#include "main.h"
+#include "bench.h"
+
+
+/* Globals of main.c used by the profile */
+CYBLE_API_RESULT_T apiResult;
+uint16 attMtu;
+uint16 i;
+uint8 flag;
+
+static uint16 rrNext;           /* Next RR-Interval expected by the peer */
+static uint32 errors;
+
+
+/*******************************************************************************
+* Function Name: PrintApiResult
+********************************************************************************
+*
+* Summary:
+*   Replaces the one of debug.c.
+*
+*******************************************************************************/
+void PrintApiResult(void)
+{
+    printf("0x%x \n", (unsigned)apiResult);
+}
+
+
+/*******************************************************************************
+* Function Name: HrsBenchRx
+********************************************************************************
+*
+* Summary:
+*   Checks a Heart Rate Measurement received by the peer.
+*
+*******************************************************************************/
+static void HrsBenchRx(uint16 attrHandle, uint16 length, const uint8 value[], uint8 isIndication)
+{
+    uint16 pos;
+
+    if((CYBLE_SIM_HRS_HANDLE(CYBLE_HRS_HRM) != attrHandle) || (0u != isIndication) ||
+       ((length + 3u) > attMtu) || (0u == length))
+    {
+        errors++;
+    }
+    else if(0u != (value[0u] & CYBLE_HRS_HRM_RRINT))
+    {
+        pos = 1u + ((0u != (value[0u] & CYBLE_HRS_HRM_HRVAL16)) ? 2u : 1u) +
+            ((0u != (value[0u] & CYBLE_HRS_HRM_ENEXP)) ? 2u : 0u);
+        while((pos + 1u) < length)
+        {
+            if(CyBle_Get16ByPtr(&value[pos]) != rrNext)
+            {
+                errors++;
+            }
+            rrNext++;
+            pos += 2u;
+        }
+        if(pos != length)
+        {
+            errors++;
+        }
+    }
+    else
+    {
+    }
+}
+
+
+int main(int argc, char *argv[])
+{
+    BENCH_CFG_T cfg;
+    uint16 rr = 0u;
+    uint32 n;
+    uint8 perNtf;
+    uint8 length;
+
+    BenchParse(argc, argv, &cfg);
+    CyBleSim_Start(&cfg.link);
+    CyBleSim_SetRxHandler(&HrsBenchRx);
+    attMtu = cyBleSimCfg.attMtu;
+
+    HrsInit();
+    CyBleSim_HrssWriteCccd(CYBLE_CCCD_NOTIFICATION);
+    HrssSetHeartRate(75u);
+    NtfStatReset();
+
+    /* Value bytes of a notification */
+    length = ((attMtu - 3u) < CYBLE_HRS_HRM_CHAR_LEN) ? (uint8)(attMtu - 3u) : CYBLE_HRS_HRM_CHAR_LEN;
+
+    for(n = 0u; n < cfg.count; n++)
+    {
+        /* The RR-Intervals that fit after the flags, an 8-bit Heart Rate and
+        *  the Energy Expended sent every 10th notification.
+        */
+        perNtf = (uint8)((length - 2u) / 2u);
+        if(0u == (n % 10u))
+        {
+            HrssSetEnergyExpended((uint16)n);
+            perNtf = (uint8)((length - 4u) / 2u);
+        }
+        for(i = 0u; i < perNtf; i++)
+        {
+            HrssAddRrInterval(rr++);
+        }
+        HrssSendHeartRateNtf();
+    }
+    CyBleSim_Flush();
+
+    BenchReport("hrs", ntfStat.buildCount, ntfStat.buildCycles, ntfStat.buildCyclesMax, ntfStat.busyPolls);
+
+    if((rrNext != rr) || (0u != hrssRrDropCnt) || (0u != ntfStat.ntfErrors) || (cfg.count != cyBleSimStat.ntfCount))
+    {
+        errors++;
+    }
+    printf("  %u RR-Intervals, %u errors\n", (unsigned)rr, (unsigned)errors);
+
+    return((0u == errors) ? 0 : 1);
+}
+
+
+/* [] END OF FILE */
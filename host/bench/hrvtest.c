@@ -0,0 +1,357 @@
+/*******************************************************************************
+* File Name: hrvtest.c
+*
+* Version 1.0
+*
+* Description:
+*  This file contains the host test of the heart rate variability engine of
+*  the Heart Rate Collector. RR-Interval streams go through HrvAddRr() as the
+*  collector receives them, and after every interval the metrics of
+*  HrvGetMetrics() are checked against a floating point reference of the
+*  same definitions: the same conversion to ms, artifact rejection and
+*  window.
+*
+*  Arguments: hrvtest [count] | hrvtest -r file...
+*  count - the intervals of each generated stream, 10000 by default. The
+*          generated streams are a random walk, a step from 800 to 1000 ms
+*          and a random walk with 1 % artifacts;
+*  -r    - feeds the recorded streams instead: text files of one RR-Interval
+*          per line in 1/1024 s, as in the Heart Rate Measurement, the lines
+*          starting with '#' are skipped.
+*
+*  The integer metrics are truncated, so they may be 1 below the reference.
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "hrv.h"
+
+
+/***************************************
+*        Constants
+***************************************/
+#define HRV_TEST_TOLERANCE          (1.0)       /* Of the truncated metrics */
+#define HRV_TEST_STEP_BEFORE        (819u)      /* 800 ms, 1/1024 s */
+#define HRV_TEST_STEP_AFTER         (1024u)     /* 1000 ms, 1/1024 s */
+#define HRV_TEST_WALK_START         (1024u)
+#define HRV_TEST_WALK_MIN           (410u)      /* 400 ms */
+#define HRV_TEST_WALK_MAX           (1843u)     /* 1800 ms */
+
+#define HRV_TEST_STREAM_WALK        (0u)
+#define HRV_TEST_STREAM_STEP        (1u)
+#define HRV_TEST_STREAM_ARTIFACTS   (2u)
+#define HRV_TEST_STREAMS            (3u)
+
+
+/***************************************
+*        Data Struct Definition
+***************************************/
+typedef struct
+{
+    uint16 rr[HRV_WINDOW];
+    int16  diff[HRV_WINDOW];
+    uint32 head;
+    uint32 num;
+    uint16 prevRr;
+    uint32 n;
+    double mean;                /* Welford's running mean and M2 in double */
+    double m2;
+    uint32 rejectCnt;
+} HRV_TEST_REF_T;
+
+typedef struct
+{
+    uint32 errors;
+    double sdnnErrMax;
+    HRV_METRICS_T metrics;
+    double sdnnRef;
+} HRV_TEST_RESULT_T;
+
+
+static HRV_T hrvTest;
+static HRV_TEST_REF_T hrvTestRef;
+
+
+/*******************************************************************************
+* Function Name: HrvTestRefAdd
+********************************************************************************
+*
+* Summary:
+*   Adds an interval to the reference.
+*
+*******************************************************************************/
+static void HrvTestRefAdd(HRV_TEST_REF_T *ref, uint16 rrInterval)
+{
+    uint16 rr = (uint16)((((uint32)rrInterval * 1000u) + 512u) >> 10u);
+    double delta;
+
+    if((rr < HRV_RR_MIN) || (rr > HRV_RR_MAX))
+    {
+        ref->rejectCnt++;
+        ref->prevRr = 0u;
+    }
+    else
+    {
+        ref->diff[ref->head] = (0u != ref->prevRr) ? (int16)((int32)rr - (int32)ref->prevRr) : HRV_DIFF_NONE;
+        ref->rr[ref->head] = rr;
+        ref->head = (ref->head + 1u) % HRV_WINDOW;
+        if(ref->num < HRV_WINDOW)
+        {
+            ref->num++;
+        }
+        ref->prevRr = rr;
+
+        ref->n++;
+        delta = (double)rr - ref->mean;
+        ref->mean += delta / (double)ref->n;
+        ref->m2 += delta * ((double)rr - ref->mean);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: HrvTestCheck
+********************************************************************************
+*
+* Summary:
+*   Checks the metrics of the engine against the reference.
+*
+* Return:
+*   Nonzero if a metric differs by more than HRV_TEST_TOLERANCE.
+*
+*******************************************************************************/
+static uint32 HrvTestCheck(const HRV_TEST_REF_T *ref, HRV_TEST_RESULT_T *result)
+{
+    const HRV_METRICS_T *metrics = &result->metrics;
+    double rrSum = 0.0;
+    double diffSqSum = 0.0;
+    double meanHr = 0.0;
+    double rmssd = 0.0;
+    double pnn50 = 0.0;
+    double err;
+    uint32 diffNum = 0u;
+    uint32 nn50Num = 0u;
+    uint32 k;
+
+    HrvGetMetrics(&hrvTest, &result->metrics);
+
+    for(k = 0u; k < ref->num; k++)
+    {
+        rrSum += (double)ref->rr[k];
+        if(HRV_DIFF_NONE != ref->diff[k])
+        {
+            diffSqSum += (double)ref->diff[k] * (double)ref->diff[k];
+            diffNum++;
+            if(abs(ref->diff[k]) > (int)HRV_NN50)
+            {
+                nn50Num++;
+            }
+        }
+    }
+    if(0u != ref->num)
+    {
+        meanHr = (600000.0 * (double)ref->num) / rrSum;
+    }
+    if(0u != diffNum)
+    {
+        rmssd = sqrt(diffSqSum / (double)diffNum);
+        pnn50 = ((double)nn50Num * 1000.0) / (double)diffNum;
+    }
+    result->sdnnRef = (ref->n > 1u) ? sqrt(ref->m2 / (double)(ref->n - 1u)) : 0.0;
+
+    err = fabs((double)metrics->sdnn - result->sdnnRef);
+    if(err > result->sdnnErrMax)
+    {
+        result->sdnnErrMax = err;
+    }
+
+    return(((err > HRV_TEST_TOLERANCE) ||
+            (fabs((double)metrics->meanHr - meanHr) > HRV_TEST_TOLERANCE) ||
+            (fabs((double)metrics->rmssd - rmssd) > HRV_TEST_TOLERANCE) ||
+            (fabs((double)metrics->pnn50 - pnn50) > HRV_TEST_TOLERANCE) ||
+            (metrics->n != ref->n) || (metrics->rejectCnt != ref->rejectCnt)) ? 1u : 0u);
+}
+
+
+/*******************************************************************************
+* Function Name: HrvTestStart
+********************************************************************************
+*
+* Summary:
+*   Clears the engine, the reference and the result of a stream.
+*
+*******************************************************************************/
+static void HrvTestStart(HRV_TEST_RESULT_T *result)
+{
+    HrvInit(&hrvTest);
+    (void)memset(&hrvTestRef, 0, sizeof(hrvTestRef));
+    (void)memset(result, 0, sizeof(*result));
+}
+
+
+/*******************************************************************************
+* Function Name: HrvTestAdd
+********************************************************************************
+*
+* Summary:
+*   Feeds an interval to the engine and to the reference and checks them.
+*
+*******************************************************************************/
+static void HrvTestAdd(uint16 rrInterval, HRV_TEST_RESULT_T *result)
+{
+    HrvAddRr(&hrvTest, rrInterval);
+    HrvTestRefAdd(&hrvTestRef, rrInterval);
+    result->errors += HrvTestCheck(&hrvTestRef, result);
+}
+
+
+/*******************************************************************************
+* Function Name: HrvTestReport
+********************************************************************************
+*
+* Summary:
+*   Prints the final metrics of a stream.
+*
+*******************************************************************************/
+static void HrvTestReport(const char *name, const HRV_TEST_RESULT_T *result)
+{
+    const HRV_METRICS_T *metrics = &result->metrics;
+
+    printf("  %-12s %7u RR %5u rejected, SDNN %4u ms (reference %6.1f, max error %.2f), RMSSD %3u ms, "
+        "HR %3u.%u bpm, pNN50 %3u.%u %%, %u errors\n", name, (unsigned)metrics->n, (unsigned)metrics->rejectCnt,
+        (unsigned)metrics->sdnn, result->sdnnRef, result->sdnnErrMax, (unsigned)metrics->rmssd,
+        (unsigned)(metrics->meanHr / 10u), (unsigned)(metrics->meanHr % 10u), (unsigned)(metrics->pnn50 / 10u),
+        (unsigned)(metrics->pnn50 % 10u), (unsigned)result->errors);
+}
+
+
+/*******************************************************************************
+* Function Name: HrvTestGenerated
+********************************************************************************
+*
+* Summary:
+*   Feeds a generated stream.
+*
+* Return:
+*   The number of the failed checks.
+*
+*******************************************************************************/
+static uint32 HrvTestGenerated(uint32 stream, uint32 count)
+{
+    static const char *names[HRV_TEST_STREAMS] = {"random walk", "step", "artifacts"};
+    HRV_TEST_RESULT_T result;
+    uint32 rr = HRV_TEST_WALK_START;
+    uint32 n;
+
+    HrvTestStart(&result);
+    srand(1u);
+
+    for(n = 0u; n < count; n++)
+    {
+        if(HRV_TEST_STREAM_STEP == stream)
+        {
+            rr = (n < (count / 2u)) ? HRV_TEST_STEP_BEFORE : HRV_TEST_STEP_AFTER;
+        }
+        else
+        {
+            /* Beat to beat noise drawn back to HRV_TEST_WALK_START */
+            rr = (uint32)((int32)rr + ((int32)((uint32)rand() % 121u) - 60) + (((int32)HRV_TEST_WALK_START - (int32)rr) / 16));
+            rr = (rr < HRV_TEST_WALK_MIN) ? HRV_TEST_WALK_MIN : ((rr > HRV_TEST_WALK_MAX) ? HRV_TEST_WALK_MAX : rr);
+        }
+
+        if((HRV_TEST_STREAM_ARTIFACTS == stream) && (0u == ((uint32)rand() % 100u)))
+        {
+            /* A missed beat or a noise spike */
+            HrvTestAdd((0u != (n & 1u)) ? (uint16)(rr * 3u) : (uint16)(rr / 8u), &result);
+        }
+        else
+        {
+            HrvTestAdd((uint16)rr, &result);
+        }
+    }
+
+    HrvTestReport(names[stream], &result);
+
+    return(result.errors);
+}
+
+
+/*******************************************************************************
+* Function Name: HrvTestRecorded
+********************************************************************************
+*
+* Summary:
+*   Feeds a recorded stream from a file.
+*
+* Return:
+*   The number of the failed checks, 1 if the file cannot be read.
+*
+*******************************************************************************/
+static uint32 HrvTestRecorded(const char *path)
+{
+    HRV_TEST_RESULT_T result;
+    char line[64u];
+    unsigned long value;
+    char *end;
+    FILE *file = fopen(path, "r");
+
+    if(NULL == file)
+    {
+        printf("  %s: cannot open\n", path);
+        return(1u);
+    }
+
+    HrvTestStart(&result);
+    while(NULL != fgets(line, (int)sizeof(line), file))
+    {
+        value = strtoul(line, &end, 0);
+        if(('#' != line[0u]) && (end != line) && (value <= 0xFFFFu))
+        {
+            HrvTestAdd((uint16)value, &result);
+        }
+    }
+    (void)fclose(file);
+
+    HrvTestReport(path, &result);
+
+    return(result.errors);
+}
+
+
+int main(int argc, char *argv[])
+{
+    uint32 errors = 0u;
+    uint32 count;
+    int arg;
+
+    if((argc > 1) && (0 == strcmp(argv[1], "-r")))
+    {
+        printf("hrv: recorded streams\n");
+        for(arg = 2; arg < argc; arg++)
+        {
+            errors += HrvTestRecorded(argv[arg]);
+        }
+    }
+    else
+    {
+        count = (argc > 1) ? (uint32)strtoul(argv[1], NULL, 0) : 10000u;
+        printf("hrv: %u intervals per stream\n", (unsigned)count);
+        for(arg = 0; arg < (int)HRV_TEST_STREAMS; arg++)
+        {
+            errors += HrvTestGenerated((uint32)arg, count);
+        }
+    }
+
+    return((0u == errors) ? 0 : 1);
+}
+
+
+/* [] END OF FILE */
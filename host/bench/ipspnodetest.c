@@ -0,0 +1,450 @@
+/*******************************************************************************
+* File Name: ipspnodetest.c
+*
+* Version 1.0
+*
+* Description:
+*  This file contains the host test of the Node table, the SDU pool and the
+*  receive credit controller of the IPSP Router. The PSoC 4 BLE component
+*  holds one link, so the firmware serves one Node at a time; the test opens
+*  IPSP_NODE_MAX Nodes to check the per Node state:
+*
+*   - the SDU buffers are shared by the Nodes and a Node holds no more than
+*     IPSP_SDU_CHANNEL_MAX of them;
+*   - IpspNodeProcess() passes one SDU per Node and turn to the stack and
+*     the next call starts after the Node served last;
+*   - a Node without the TX credits for its next SDU is skipped and does
+*     not hold the others;
+*   - the receive credits consumed by a Node are returned to it;
+*   - IpspNodePurge() closes the Nodes whose link is gone and returns their
+*     buffers to the pool.
+*
+*  The L2CAP, GAP and WDT calls of the modules are implemented here, the
+*  stack is busy after a given number of CyBle_L2capChannelDataWrite() calls.
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include "main.h"
+
+
+/***************************************
+*        Constants
+***************************************/
+#define IPSP_TEST_LOG_MAX           (32u)
+#define IPSP_TEST_CID               (0x0040u)   /* Local CID of the first Node */
+#define IPSP_TEST_CREDIT            (100u)      /* Initial TX credits of a Node */
+#define IPSP_TEST_MPS               (23u)       /* MPS of the Nodes */
+#define IPSP_TEST_SDU_LEN           (100u)      /* 5 K-frames of IPSP_TEST_MPS */
+#define IPSP_TEST_SDU_COST          ((IPSP_TEST_SDU_LEN + 2u + IPSP_TEST_MPS - 1u) / IPSP_TEST_MPS)
+#define IPSP_TEST_UNLIMITED         (0xFFFFFFFFu)
+
+
+/***************************************
+*        Data Struct Definition
+***************************************/
+typedef struct
+{
+    uint16 lCid;
+    uint16 length;
+    const uint8 *buf;
+} IPSP_TEST_WRITE_T;
+
+
+static IPSP_TEST_WRITE_T ipspTestWrite[IPSP_TEST_LOG_MAX];
+static uint32 ipspTestWrites;               /* CyBle_L2capChannelDataWrite() calls */
+static uint32 ipspTestBusyAt = IPSP_TEST_UNLIMITED;  /* Writes after which the stack is busy */
+static uint8 ipspTestLinked[IPSP_NODE_MAX + 1u];
+static uint16 ipspTestCreditCid;            /* Last CyBle_L2capCbfcSendFlowControlCredit() */
+static uint16 ipspTestCredit;
+static uint32 ipspTestCredits;
+static uint32 errors;
+
+
+/*******************************************************************************
+* Stack calls of the modules
+*******************************************************************************/
+uint8 CyBle_GattGetBusyStatus(void)
+{
+    return((ipspTestWrites >= ipspTestBusyAt) ? CYBLE_STACK_STATE_BUSY : CYBLE_STACK_STATE_FREE);
+}
+
+
+CYBLE_API_RESULT_T CyBle_GapGetPeerBdAddr(uint8 bdHandle, CYBLE_GAP_BD_ADDR_T *peerBdAddr)
+{
+    CYBLE_API_RESULT_T apiResult = CYBLE_ERROR_NO_DEVICE_ENTITY;
+
+    if((bdHandle <= IPSP_NODE_MAX) && (ipspTestLinked[bdHandle] != 0u))
+    {
+        (void)memset(peerBdAddr, 0, sizeof(*peerBdAddr));
+        peerBdAddr->bdAddr[0u] = (uint8)(bdHandle + 1u);
+        peerBdAddr->bdAddr[3u] = 0x50u;
+        peerBdAddr->bdAddr[4u] = 0xA0u;
+        apiResult = CYBLE_ERROR_OK;
+    }
+
+    return(apiResult);
+}
+
+
+CYBLE_API_RESULT_T CyBle_L2capChannelDataWrite(uint8 bdHandle, uint16 localCid, uint8 *buffer, uint16 bufferLen)
+{
+    (void)bdHandle;
+    if(ipspTestWrites < IPSP_TEST_LOG_MAX)
+    {
+        ipspTestWrite[ipspTestWrites].lCid = localCid;
+        ipspTestWrite[ipspTestWrites].length = bufferLen;
+        ipspTestWrite[ipspTestWrites].buf = buffer;
+    }
+    ipspTestWrites++;
+
+    return(CYBLE_ERROR_OK);
+}
+
+
+CYBLE_API_RESULT_T CyBle_L2capCbfcSendFlowControlCredit(uint16 localCid, uint16 credit)
+{
+    ipspTestCreditCid = localCid;
+    ipspTestCredit = credit;
+    ipspTestCredits++;
+
+    return(CYBLE_ERROR_OK);
+}
+
+
+uint32 CySysWdtReadCount(uint32 counterNum)
+{
+    (void)counterNum;
+    return(0u);
+}
+
+
+/*******************************************************************************
+* Function Name: IpspTestCheck
+********************************************************************************
+*
+* Summary:
+*   Counts and reports a failed check.
+*
+*******************************************************************************/
+static void IpspTestCheck(uint8 ok, const char *what)
+{
+    if(ok == 0u)
+    {
+        printf("  failed: %s\n", what);
+        errors++;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: IpspTestQueue
+********************************************************************************
+*
+* Summary:
+*   Queues an SDU for the Node.
+*
+* Return:
+*   The buffer of the SDU or NULL if no buffer was given to the Node.
+*
+*******************************************************************************/
+static const uint8 *IpspTestQueue(IPSP_NODE_T *node, uint16 length)
+{
+    uint8 *buf = IpspSduAlloc(&node->sdu);
+
+    if(buf != NULL)
+    {
+        (void)memset(buf, (int)node->lCid, length);
+        IpspSduCommit(&node->sdu, length);
+    }
+
+    return(buf);
+}
+
+
+/*******************************************************************************
+* Function Name: IpspTestPoolFree
+********************************************************************************
+*
+* Summary:
+*   Counts the free buffers of the SDU pool by taking them on spare channels.
+*
+*******************************************************************************/
+static uint8 IpspTestPoolFree(void)
+{
+    IPSP_SDU_CHANNEL_T spare[IPSP_SDU_POOL_SIZE];
+    uint8 freeBufs = 0u;
+    uint8 i;
+
+    (void)memset(spare, 0, sizeof(spare));
+    for(i = 0u; i < IPSP_SDU_POOL_SIZE; i++)
+    {
+        while(IpspSduAlloc(&spare[i]) != NULL)
+        {
+            IpspSduCommit(&spare[i], 1u);
+            freeBufs++;
+        }
+    }
+    for(i = 0u; i < IPSP_SDU_POOL_SIZE; i++)
+    {
+        IpspSduClose(&spare[i]);
+    }
+
+    return(freeBufs);
+}
+
+
+/*******************************************************************************
+* Function Name: IpspTestRelease
+********************************************************************************
+*
+* Summary:
+*   Completes the writes of all the SDUs in flight.
+*
+*******************************************************************************/
+static void IpspTestRelease(void)
+{
+    uint8 i;
+
+    for(i = 0u; i < IPSP_NODE_MAX; i++)
+    {
+        while(ipspNode[i].sdu.inFlight != 0u)
+        {
+            IpspSduWriteComplete(&ipspNode[i].sdu);
+        }
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: IpspTestSharing
+********************************************************************************
+*
+* Summary:
+*   Fills the pool from two Nodes, checks that the third one gets nothing,
+*   then that a buffer released by a Node goes to another one.
+*
+*******************************************************************************/
+static void IpspTestSharing(void)
+{
+    const uint8 *first;
+    uint8 i;
+
+    first = IpspTestQueue(&ipspNode[0u], IPSP_TEST_SDU_LEN);
+    (void)IpspTestQueue(&ipspNode[0u], IPSP_TEST_SDU_LEN);
+    IpspTestCheck((uint8)(IpspTestQueue(&ipspNode[0u], IPSP_TEST_SDU_LEN) == NULL), "channel limit");
+    for(i = 0u; i < IPSP_SDU_CHANNEL_MAX; i++)
+    {
+        IpspTestCheck((uint8)(IpspTestQueue(&ipspNode[1u], IPSP_TEST_SDU_LEN) != NULL), "second Node buffer");
+    }
+    IpspTestCheck((uint8)(IpspTestPoolFree() == (IPSP_SDU_POOL_SIZE - (2u * IPSP_SDU_CHANNEL_MAX))), "pool use");
+    IpspTestCheck((uint8)(IpspSduAvailable(&ipspNode[2u].sdu) == 0u), "available, pool full");
+    IpspTestCheck((uint8)(IpspTestQueue(&ipspNode[2u], IPSP_TEST_SDU_LEN) == NULL), "pool full");
+
+    /* One SDU per Node and turn, the third Node has nothing to send */
+    IpspNodeProcess();
+    IpspTestCheck((uint8)(ipspTestWrites == 4u), "SDUs sent");
+    IpspTestCheck((uint8)((ipspTestWrite[0u].lCid == IPSP_TEST_CID) &&
+                          (ipspTestWrite[1u].lCid == (IPSP_TEST_CID + 1u)) &&
+                          (ipspTestWrite[2u].lCid == IPSP_TEST_CID) &&
+                          (ipspTestWrite[3u].lCid == (IPSP_TEST_CID + 1u))), "round-robin order");
+    IpspTestCheck((uint8)((ipspTestWrite[0u].buf == first) && (ipspTestWrite[0u].length == IPSP_TEST_SDU_LEN)),
+                  "sending order");
+    IpspTestCheck((uint8)(ipspNode[0u].sdu.txCredit == (IPSP_TEST_CREDIT - (2u * IPSP_TEST_SDU_COST))),
+                  "TX credits taken");
+
+    /* The stack still owns the buffers until the writes complete */
+    IpspTestCheck((uint8)(IpspTestQueue(&ipspNode[2u], IPSP_TEST_SDU_LEN) == NULL), "buffers in flight");
+    IpspSduWriteComplete(&ipspNode[0u].sdu);
+    IpspTestCheck((uint8)(IpspSduAvailable(&ipspNode[2u].sdu) == 1u), "available after the release");
+    IpspTestCheck((uint8)(IpspTestQueue(&ipspNode[2u], IPSP_TEST_SDU_LEN) == first), "released buffer reused");
+    IpspNodeProcess();
+    IpspTestCheck((uint8)((ipspTestWrites == 5u) && (ipspTestWrite[4u].lCid == (IPSP_TEST_CID + 2u))),
+                  "third Node sent");
+
+    IpspTestRelease();
+    IpspTestCheck((uint8)(IpspTestPoolFree() == IPSP_SDU_POOL_SIZE), "pool released");
+}
+
+
+/*******************************************************************************
+* Function Name: IpspTestRotation
+********************************************************************************
+*
+* Summary:
+*   Lets the stack take one SDU per IpspNodeProcess() call, a different Node
+*   holding two SDUs in every turn, and checks every call against a
+*   round-robin that starts after the Node served last and skips the Nodes
+*   with nothing queued.
+*
+*******************************************************************************/
+static void IpspTestRotation(void)
+{
+    uint8 queued[IPSP_NODE_MAX];
+    uint8 next = IPSP_NODE_MAX;     /* Unknown until the first SDU */
+    uint8 served;
+    uint8 turn;
+    uint8 i;
+
+    for(turn = 0u; turn < IPSP_NODE_MAX; turn++)
+    {
+        for(i = 0u; i < IPSP_NODE_MAX; i++)
+        {
+            (void)IpspTestQueue(&ipspNode[i], IPSP_TEST_SDU_LEN);
+            queued[i] = 1u;
+        }
+        (void)IpspTestQueue(&ipspNode[turn], IPSP_TEST_SDU_LEN);
+        queued[turn]++;
+
+        for(i = 0u; i < (IPSP_NODE_MAX + 1u); i++)
+        {
+            ipspTestBusyAt = ipspTestWrites + 1u;
+            IpspNodeProcess();
+            served = (uint8)(ipspTestWrite[ipspTestWrites - 1u].lCid - IPSP_TEST_CID);
+            if(next < IPSP_NODE_MAX)
+            {
+                while(queued[next] == 0u)
+                {
+                    next = (uint8)((next + 1u) % IPSP_NODE_MAX);
+                }
+                IpspTestCheck((uint8)(served == next), "next Node served");
+            }
+            queued[served]--;
+            next = (uint8)((served + 1u) % IPSP_NODE_MAX);
+        }
+        ipspTestBusyAt = IPSP_TEST_UNLIMITED;
+        IpspTestCheck((uint8)((ipspNode[0u].sdu.queued + ipspNode[1u].sdu.queued + ipspNode[2u].sdu.queued) == 0u),
+                      "one SDU per call");
+        IpspTestRelease();
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: IpspTestCredit
+********************************************************************************
+*
+* Summary:
+*   Checks that a Node without the TX credits for its SDU is skipped until
+*   the credits arrive, and that the receive credits consumed by a Node are
+*   returned to it.
+*
+*******************************************************************************/
+static void IpspTestCredit(void)
+{
+    uint32 start = ipspTestWrites;
+    uint8 i;
+
+    ipspNode[0u].sdu.txCredit = IPSP_TEST_SDU_COST - 1u;
+    for(i = 0u; i < IPSP_NODE_MAX; i++)
+    {
+        (void)IpspTestQueue(&ipspNode[i], IPSP_TEST_SDU_LEN);
+    }
+    IpspNodeProcess();
+    IpspTestCheck((uint8)(ipspTestWrites == (start + IPSP_NODE_MAX - 1u)), "the others sent");
+    IpspTestCheck((uint8)((ipspNode[0u].sdu.queued == 1u) && (ipspNode[0u].sdu.txCredit == (IPSP_TEST_SDU_COST - 1u))),
+                  "Node without credits skipped");
+
+    IpspSduAddCredit(&ipspNode[0u].sdu, 1u);
+    IpspNodeProcess();
+    IpspTestCheck((uint8)((ipspTestWrites == (start + IPSP_NODE_MAX)) &&
+                          (ipspTestWrite[start + IPSP_NODE_MAX - 1u].lCid == IPSP_TEST_CID) &&
+                          (ipspNode[0u].sdu.txCredit == 0u)), "sent after the credits");
+    IpspTestRelease();
+
+    IpspSduAddCredit(&ipspNode[0u].sdu, 0xFFFFu);
+    IpspSduAddCredit(&ipspNode[0u].sdu, 1u);
+    IpspTestCheck((uint8)(ipspNode[0u].sdu.txCredit == 0xFFFFu), "TX credits saturate");
+
+    /* A received SDU takes IPSP_CREDIT_SDU credits, the window is refilled */
+    ipspTestCredits = 0u;
+    IpspCreditConsume(&ipspNode[1u].credit, L2CAP_MAX_LEN);
+    IpspNodeProcess();
+    IpspTestCheck((uint8)((ipspTestCredits == 1u) && (ipspTestCreditCid == (IPSP_TEST_CID + 1u)) &&
+                          (ipspTestCredit == IPSP_CREDIT_SDU)), "receive credits returned");
+    IpspNodeProcess();
+    IpspTestCheck((uint8)(ipspTestCredits == 1u), "no credits while the window is full");
+}
+
+
+/*******************************************************************************
+* Function Name: IpspTestPurge
+********************************************************************************
+*
+* Summary:
+*   Drops the link of a Node with SDUs in flight and queued, and checks that
+*   IpspNodePurge() closes it alone and returns its buffers.
+*
+*******************************************************************************/
+static void IpspTestPurge(void)
+{
+    IPSP_NODE_T *node;
+    uint8 i;
+
+    (void)IpspTestQueue(&ipspNode[1u], IPSP_TEST_SDU_LEN);
+    IpspNodeProcess();
+    (void)IpspTestQueue(&ipspNode[1u], IPSP_TEST_SDU_LEN);
+    (void)IpspTestQueue(&ipspNode[2u], IPSP_TEST_SDU_LEN);
+    ipspTestBusyAt = ipspTestWrites;
+    IpspTestCheck((uint8)(IpspTestPoolFree() == (IPSP_SDU_POOL_SIZE - 3u)), "buffers before the purge");
+
+    ipspTestLinked[1u] = 0u;
+    IpspNodePurge();
+    IpspTestCheck((uint8)(ipspNodeCount == (IPSP_NODE_MAX - 1u)), "Node count after the purge");
+    IpspTestCheck((uint8)((IpspNodeFind(IPSP_TEST_CID + 1u) == NULL) && (IpspNodeFind(IPSP_TEST_CID) != NULL) &&
+                          (IpspNodeFind(IPSP_TEST_CID + 2u) != NULL)), "only the lost Node closed");
+    IpspTestCheck((uint8)(IpspTestPoolFree() == (IPSP_SDU_POOL_SIZE - 1u)), "buffers after the purge");
+    IpspTestCheck((uint8)(ipspNode[2u].sdu.queued == 1u), "queue of the others kept");
+
+    /* The entry is taken by the next Node */
+    ipspTestLinked[IPSP_NODE_MAX] = 1u;
+    node = IpspNodeOpen(IPSP_NODE_MAX, IPSP_TEST_CID + IPSP_NODE_MAX, IPSP_TEST_CREDIT, IPSP_TEST_MPS);
+    IpspTestCheck((uint8)((node == &ipspNode[1u]) && (ipspNodeCount == IPSP_NODE_MAX)), "entry reused");
+    ipspTestBusyAt = IPSP_TEST_UNLIMITED;
+    IpspNodeProcess();
+    IpspTestRelease();
+
+    for(i = 0u; i <= IPSP_NODE_MAX; i++)
+    {
+        ipspTestLinked[i] = 0u;
+    }
+    IpspNodePurge();
+    IpspTestCheck((uint8)((ipspNodeCount == 0u) && (IpspTestPoolFree() == IPSP_SDU_POOL_SIZE)), "all closed");
+}
+
+
+int main(void)
+{
+    IPSP_NODE_T *node;
+    uint8 i;
+
+    printf("ipspnode: %u Nodes, %u SDU buffers, %u per Node\n", (unsigned)IPSP_NODE_MAX,
+        (unsigned)IPSP_SDU_POOL_SIZE, (unsigned)IPSP_SDU_CHANNEL_MAX);
+
+    for(i = 0u; i <= IPSP_NODE_MAX; i++)
+    {
+        ipspTestLinked[i] = 1u;
+        node = IpspNodeOpen(i, (uint16)(IPSP_TEST_CID + i), IPSP_TEST_CREDIT, IPSP_TEST_MPS);
+        IpspTestCheck((uint8)((i < IPSP_NODE_MAX) ? (node == &ipspNode[i]) : (node == NULL)), "open");
+    }
+    ipspTestLinked[IPSP_NODE_MAX] = 0u;
+    IpspTestCheck((uint8)(ipspNodeCount == IPSP_NODE_MAX), "Node count");
+    IpspTestCheck((uint8)(IpspNodeFind(IPSP_TEST_CID + 1u) == &ipspNode[1u]), "find by CID");
+    IpspTestCheck((uint8)(IpspNodeFindAddress(ipspNode[2u].ipv6Address) == &ipspNode[2u]), "find by address");
+
+    IpspTestSharing();
+    IpspTestRotation();
+    IpspTestCredit();
+    IpspTestPurge();
+
+    printf("  %u SDUs written, %u errors\n", (unsigned)ipspTestWrites, (unsigned)errors);
+
+    return((0u == errors) ? 0 : 1);
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,174 @@
+/*******************************************************************************
+* File Name: lnsbench.c
+*
+* Version 1.0
+*
+* Description:
+*  This file contains the host benchmark of the Location and Navigation
+*  profile. The client enables the Location and Speed and the Navigation
+*  notifications and starts the navigation, then LnsNtf() sends both
+*  characteristics in every round and a Request Number of Routes goes
+*  through the LN Control Point every 50 rounds. The peer checks the length
+*  of every PDU against its flags and the Control Point responses.
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stdio.h>
+#include "main.h"
+#include "bench.h"
+
+
+/* Globals of main.c used by the profile */
+volatile uint32 mainTimer;
+CYBLE_API_RESULT_T apiResult;
+uint16 i;
+uint8 flag;
+uint8 led;
+
+static uint32 cpResponses;
+static uint32 errors;
+
+
+/*******************************************************************************
+* Function Name: PrintApiResult
+********************************************************************************
+*
+* Summary:
+*   Replaces the one of debug.c.
+*
+*******************************************************************************/
+void PrintApiResult(void)
+{
+    printf("0x%x \n", (unsigned)apiResult);
+}
+
+
+/*******************************************************************************
+* Function Name: LnsBenchLength
+********************************************************************************
+*
+* Summary:
+*   Returns the length of a PDU by the field sizes of the flags.
+*
+*******************************************************************************/
+static uint16 LnsBenchLength(uint16 flags, uint16 length, const uint16 mask[], const uint8 size[], uint8 num)
+{
+    uint8 n;
+
+    for(n = 0u; n < num; n++)
+    {
+        if(0u != (flags & mask[n]))
+        {
+            length += size[n];
+        }
+    }
+
+    return(length);
+}
+
+
+/*******************************************************************************
+* Function Name: LnsBenchRx
+********************************************************************************
+*
+* Summary:
+*   Checks a notification or an indication received by the peer.
+*
+*******************************************************************************/
+static void LnsBenchRx(uint16 attrHandle, uint16 length, const uint8 value[], uint8 isIndication)
+{
+    static const uint16 lsMask[] = {CYBLE_LNS_LS_FLG_IS, CYBLE_LNS_LS_FLG_TD, CYBLE_LNS_LS_FLG_LC,
+        CYBLE_LNS_LS_FLG_EL, CYBLE_LNS_LS_FLG_HD, CYBLE_LNS_LS_FLG_RT, CYBLE_LNS_LS_FLG_UTC};
+    static const uint8 lsSize[] = {2u, 3u, 8u, 3u, 2u, 1u, 7u};
+    static const uint16 nvMask[] = {CYBLE_LNS_NV_FLG_RD, CYBLE_LNS_NV_FLG_RVD, CYBLE_LNS_NV_FLG_EAT};
+    static const uint8 nvSize[] = {3u, 3u, 7u};
+    uint16 expected = 0u;
+
+    if(length < 2u)
+    {
+        errors++;
+    }
+    else if((CYBLE_SIM_LNS_HANDLE(CYBLE_LNS_LS) == attrHandle) && (0u == isIndication))
+    {
+        expected = LnsBenchLength(CyBle_Get16ByPtr(value), 2u, lsMask, lsSize, 3u + 4u);
+    }
+    else if((CYBLE_SIM_LNS_HANDLE(CYBLE_LNS_NV) == attrHandle) && (0u == isIndication))
+    {
+        expected = LnsBenchLength(CyBle_Get16ByPtr(value), 6u, nvMask, nvSize, 3u);
+    }
+    else if((CYBLE_SIM_LNS_HANDLE(CYBLE_LNS_CP) == attrHandle) && (0u != isIndication))
+    {
+        /* Response Code, Request Number of Routes, Success, 2 bytes of the number */
+        if((CYBLE_LNS_CP_OPC_RC == value[0u]) && (CYBLE_LNS_CP_RSP_SUCCESS == value[2u]))
+        {
+            expected = (CYBLE_LNS_CP_OPC_NRS == value[1u]) ? 5u : 3u;
+        }
+        cpResponses++;
+    }
+    else
+    {
+    }
+
+    if(expected != length)
+    {
+        errors++;
+    }
+}
+
+
+int main(int argc, char *argv[])
+{
+    static const uint8 cpStart[] = {CYBLE_LNS_CP_OPC_NC, CYBLE_LNS_CP_OPC_NC_START};
+    static const uint8 cpRoutes[] = {CYBLE_LNS_CP_OPC_NRS};
+    BENCH_CFG_T cfg;
+    uint32 rounds;
+    uint32 n;
+    uint32 k;
+
+    BenchParse(argc, argv, &cfg);
+    CyBleSim_Start(&cfg.link);
+    CyBleSim_SetRxHandler(&LnsBenchRx);
+
+    LnsInit();
+    CyBleSim_LnssWriteCccd(CYBLE_LNS_LS, CYBLE_CCCD_NOTIFICATION);
+    CyBleSim_LnssWriteCccd(CYBLE_LNS_NV, CYBLE_CCCD_NOTIFICATION);
+    CyBleSim_LnssWriteCccd(CYBLE_LNS_CP, CYBLE_CCCD_INDICATION);
+    CyBleSim_LnssWriteCp(sizeof(cpStart), cpStart);
+    LnsProcess();
+    NtfStatReset();
+
+    /* Every round sends a Location and Speed and a Navigation notification */
+    rounds = cfg.count / 2u;
+    for(n = 0u; n < rounds; n++)
+    {
+        for(k = 0u; k < LNS_TIME; k++)
+        {
+            LnsNtf();
+        }
+        if(0u == (n % 50u))
+        {
+            CyBleSim_LnssWriteCp(sizeof(cpRoutes), cpRoutes);
+            LnsProcess();
+        }
+    }
+    CyBleSim_Flush();
+
+    BenchReport("lns", ntfStat.buildCount, ntfStat.buildCycles, ntfStat.buildCyclesMax, ntfStat.busyPolls);
+
+    if(((2u * rounds) != cyBleSimStat.ntfCount) || (cyBleSimStat.indCount != cpResponses) ||
+       ((1u + ((rounds + 49u) / 50u)) != cpResponses) || (0u != ntfStat.ntfErrors))
+    {
+        errors++;
+    }
+    printf("  %u Control Point responses, %u errors\n", (unsigned)cpResponses, (unsigned)errors);
+
+    return((0u == errors) ? 0 : 1);
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,455 @@
+/*******************************************************************************
+* File Name: lowpantest.c
+*
+* Version 1.0
+*
+* Description:
+*  This file contains the host test of the 6LoWPAN header compression and
+*  the IPv6 echo of the IPSP Node, with the LE credit based channel looped
+*  back in-process.
+*
+*  First every combination of the Traffic Class, Flow Label, Hop Limit,
+*  address and UDP port forms goes through LowpanCompress() and
+*  LowpanDecompress(), which must restore the packet. Then the Router side
+*  sends ICMPv6 and UDP echo requests to the Node over the loopback channel,
+*  the Node answers them with Ipv6Process(), and the Router checks the
+*  replies. The requests are sent both compressed and with the uncompressed
+*  IPv6 dispatch, and the LL packets of both are compared.
+*
+*  The channel carries an SDU as the stack does: the SDU length and the SDU
+*  are split in K-frames of MPS bytes, a K-frame with its L2CAP header in LL
+*  packets of 27 bytes.
+*
+*  Arguments: lowpantest [mps [count]]
+*  mps - the MPS of the channel, 23 by default;
+*  count - the echo requests of each kind, 200 by default.
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "lowpan.h"
+#include "ipv6.h"
+
+
+/***************************************
+*        Constants
+***************************************/
+#define LOWPAN_TEST_FRAME_MAX       (IPV6_MTU + 1u)     /* The IPv6 dispatch and the packet */
+#define LOWPAN_TEST_LL_PAYLOAD      (27u)
+#define LOWPAN_TEST_L2CAP_HDR       (4u)
+#define LOWPAN_TEST_SDU_LEN_SIZE    (2u)
+#define LOWPAN_TEST_ECHO_ID         (0x1234u)
+#define LOWPAN_TEST_NH_NONE         (59u)       /* No Next Header */
+
+/* Address forms of the round trip test */
+#define LOWPAN_TEST_ADDR_BD         (0u)        /* Link-local, the IID from the device address */
+#define LOWPAN_TEST_ADDR_16         (1u)        /* Link-local, 16-bit short IID */
+#define LOWPAN_TEST_ADDR_64         (2u)        /* Link-local, any IID */
+#define LOWPAN_TEST_ADDR_GLOBAL     (3u)
+#define LOWPAN_TEST_ADDR_MCAST_8    (4u)        /* ff02::1 */
+#define LOWPAN_TEST_ADDR_MCAST_32   (5u)        /* ff05::1:3 */
+#define LOWPAN_TEST_ADDR_MCAST_48   (6u)        /* ff0e::12:3456 */
+#define LOWPAN_TEST_ADDR_MCAST      (7u)        /* Any multicast */
+#define LOWPAN_TEST_ADDR_FORMS      (8u)
+
+
+/***************************************
+*        Data Struct Definition
+***************************************/
+typedef struct
+{
+    uint32 sdus;                /* SDUs sent over the channel */
+    uint32 bytes;               /* SDU bytes */
+    uint32 kFrames;             /* K-frames */
+    uint32 llPackets;           /* LL data packets */
+} LOWPAN_TEST_STAT_T;
+
+
+static const uint8 lowpanTestRouterBdAddr[LOWPAN_BD_ADDR_SIZE] = {0x01u, 0x00u, 0x00u, 0x50u, 0xA0u, 0x00u};
+static const uint8 lowpanTestNodeBdAddr[LOWPAN_BD_ADDR_SIZE] = {0x02u, 0x00u, 0x00u, 0x50u, 0xA0u, 0x00u};
+
+static uint16 lowpanTestMps;
+static uint8 lowpanTestChannelBuf[LOWPAN_TEST_SDU_LEN_SIZE + LOWPAN_TEST_FRAME_MAX];
+static uint32 errors;
+
+
+/*******************************************************************************
+* Function Name: LowpanTestChannel
+********************************************************************************
+*
+* Summary:
+*   Carries an SDU over the loopback channel and accounts its K-frames and
+*   LL packets.
+*
+* Return:
+*   The length of the received SDU.
+*
+*******************************************************************************/
+static uint16 LowpanTestChannel(const uint8 sdu[], uint16 length, uint8 rx[], LOWPAN_TEST_STAT_T *stat)
+{
+    uint32 sent = 0u;
+    uint32 total = LOWPAN_TEST_SDU_LEN_SIZE + (uint32)length;
+    uint32 kFrame;
+
+    /* The first K-frame starts with the SDU length */
+    lowpanTestChannelBuf[0u] = LO8(length);
+    lowpanTestChannelBuf[1u] = HI8(length);
+    (void)memcpy(&lowpanTestChannelBuf[LOWPAN_TEST_SDU_LEN_SIZE], sdu, length);
+
+    while(sent < total)
+    {
+        kFrame = ((total - sent) > lowpanTestMps) ? lowpanTestMps : (total - sent);
+        stat->kFrames++;
+        stat->llPackets += (LOWPAN_TEST_L2CAP_HDR + kFrame + LOWPAN_TEST_LL_PAYLOAD - 1u) / LOWPAN_TEST_LL_PAYLOAD;
+        sent += kFrame;
+    }
+    stat->sdus++;
+    stat->bytes += length;
+
+    length = (uint16)(lowpanTestChannelBuf[0u] | ((uint16)lowpanTestChannelBuf[1u] << 8u));
+    (void)memcpy(rx, &lowpanTestChannelBuf[LOWPAN_TEST_SDU_LEN_SIZE], length);
+
+    return(length);
+}
+
+
+/*******************************************************************************
+* Function Name: LowpanTestAddr
+********************************************************************************
+*
+* Summary:
+*   Builds an address of the form for the device.
+*
+*******************************************************************************/
+static void LowpanTestAddr(uint8 form, const uint8 bdAddr[], uint8 addr[])
+{
+    uint8 n;
+
+    (void)memset(addr, 0, IPV6_ADDR_SIZE);
+    switch(form)
+    {
+        case LOWPAN_TEST_ADDR_BD:
+            LowpanLinkLocal(bdAddr, addr);
+            break;
+        case LOWPAN_TEST_ADDR_16:
+            addr[0u] = 0xFEu;
+            addr[1u] = 0x80u;
+            addr[11u] = 0xFFu;
+            addr[12u] = 0xFEu;
+            addr[14u] = 0x12u;
+            addr[15u] = bdAddr[0u];
+            break;
+        case LOWPAN_TEST_ADDR_64:
+            addr[0u] = 0xFEu;
+            addr[1u] = 0x80u;
+            for(n = 8u; n < IPV6_ADDR_SIZE; n++)
+            {
+                addr[n] = (uint8)(0x11u * n) ^ bdAddr[0u];
+            }
+            break;
+        case LOWPAN_TEST_ADDR_GLOBAL:
+            addr[0u] = 0x20u;
+            addr[1u] = 0x01u;
+            addr[2u] = 0x0Du;
+            addr[3u] = 0xB8u;
+            for(n = 8u; n < IPV6_ADDR_SIZE; n++)
+            {
+                addr[n] = (uint8)(0x21u * n) ^ bdAddr[0u];
+            }
+            break;
+        case LOWPAN_TEST_ADDR_MCAST_8:
+            addr[0u] = 0xFFu;
+            addr[1u] = 0x02u;
+            addr[15u] = 0x01u;
+            break;
+        case LOWPAN_TEST_ADDR_MCAST_32:
+            addr[0u] = 0xFFu;
+            addr[1u] = 0x05u;
+            addr[13u] = 0x01u;
+            addr[15u] = 0x03u;
+            break;
+        case LOWPAN_TEST_ADDR_MCAST_48:
+            addr[0u] = 0xFFu;
+            addr[1u] = 0x0Eu;
+            addr[12u] = 0x12u;
+            addr[13u] = 0x34u;
+            addr[15u] = 0x56u;
+            break;
+        default:
+            addr[0u] = 0xFFu;
+            addr[1u] = 0x12u;
+            addr[2u] = 0x34u;
+            addr[15u] = 0x77u;
+            break;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LowpanTestRoundTrip
+********************************************************************************
+*
+* Summary:
+*   Compresses and restores a packet of every combination of the header
+*   forms, with random payloads.
+*
+*******************************************************************************/
+static void LowpanTestRoundTrip(void)
+{
+    static const uint8 tcs[] = {0x00u, 0x01u, 0xB8u, 0xB9u};
+    static const uint32 fls[] = {0u, 0x12345u};
+    static const uint8 hlims[] = {1u, 64u, 255u, 17u};
+    static const uint16 ports[][2u] =
+    {
+        {0xF0B1u, 0xF0B2u}, {0x1234u, 0xF012u}, {0xF034u, 0x1234u}, {0xC000u, UDP_PORT_ECHO}
+    };
+    static const uint8 nhs[] = {IPV6_NH_UDP, IPV6_NH_ICMPV6, LOWPAN_TEST_NH_NONE};
+    static uint8 pkt[IPV6_MTU];
+    static uint8 data[IPV6_MTU];
+    static uint8 frame[LOWPAN_TEST_FRAME_MAX];
+    static uint8 restored[IPV6_MTU];
+    uint8 src[IPV6_ADDR_SIZE];
+    uint8 dst[IPV6_ADDR_SIZE];
+    uint32 packets = 0u;
+    uint32 mismatch = 0u;
+    uint32 hdrMin = 0xFFFFFFFFu;
+    uint32 hdrMax = 0u;
+    uint32 hdr;
+    uint16 length;
+    uint16 dataLength;
+    uint16 frameLength;
+    uint8 tc;
+    uint8 fl;
+    uint8 hl;
+    uint8 sf;
+    uint8 df;
+    uint8 nh;
+    uint8 pt;
+    uint16 n;
+
+    for(tc = 0u; tc < sizeof(tcs); tc++)
+    for(fl = 0u; fl < (sizeof(fls) / sizeof(fls[0u])); fl++)
+    for(hl = 0u; hl < sizeof(hlims); hl++)
+    for(sf = 0u; sf < LOWPAN_TEST_ADDR_MCAST_8; sf++)
+    for(df = 0u; df < LOWPAN_TEST_ADDR_FORMS; df++)
+    for(nh = 0u; nh < sizeof(nhs); nh++)
+    for(pt = 0u; pt < (sizeof(ports) / sizeof(ports[0u])); pt++)
+    {
+        /* The ports only matter for UDP */
+        if((IPV6_NH_UDP == nhs[nh]) || (0u == pt))
+        {
+            dataLength = (uint16)((uint32)rand() % 200u);
+            for(n = 0u; n < dataLength; n++)
+            {
+                data[n] = (uint8)rand();
+            }
+            LowpanTestAddr(sf, lowpanTestRouterBdAddr, src);
+            LowpanTestAddr(df, lowpanTestNodeBdAddr, dst);
+
+            if(IPV6_NH_UDP == nhs[nh])
+            {
+                length = Ipv6Udp(pkt, src, dst, ports[pt][0u], ports[pt][1u], data, dataLength);
+            }
+            else
+            {
+                length = Ipv6Header(pkt, src, dst, nhs[nh], dataLength);
+                (void)memcpy(&pkt[IPV6_HDR_LEN], data, dataLength);
+            }
+            pkt[0u] = (uint8)(IPV6_VERSION | (tcs[tc] >> 4u));
+            pkt[1u] = (uint8)((uint8)(tcs[tc] << 4u) | (uint8)(fls[fl] >> 16u));
+            pkt[2u] = (uint8)(fls[fl] >> 8u);
+            pkt[3u] = (uint8)fls[fl];
+            pkt[IPV6_HLIM_OFFSET] = hlims[hl];
+
+            frameLength = LowpanCompress(pkt, length, lowpanTestRouterBdAddr, lowpanTestNodeBdAddr, frame,
+                                         sizeof(frame));
+            if((0u == frameLength) ||
+               (length != LowpanDecompress(frame, frameLength, lowpanTestRouterBdAddr, lowpanTestNodeBdAddr,
+                                           restored, sizeof(restored))) ||
+               (0 != memcmp(pkt, restored, length)))
+            {
+                mismatch++;
+            }
+            else
+            {
+                /* The header bytes the compression left */
+                hdr = (uint32)frameLength + IPV6_HDR_LEN + ((IPV6_NH_UDP == nhs[nh]) ? UDP_HDR_LEN : 0u) - length;
+                hdrMin = (hdr < hdrMin) ? hdr : hdrMin;
+                hdrMax = (hdr > hdrMax) ? hdr : hdrMax;
+            }
+            packets++;
+        }
+    }
+
+    printf("  round trip: %u packets, %u to %u header bytes%s\n", (unsigned)packets, (unsigned)hdrMin,
+        (unsigned)hdrMax, (0u != mismatch) ? ", FAILED" : "");
+    errors += mismatch;
+}
+
+
+/*******************************************************************************
+* Function Name: LowpanTestEcho
+********************************************************************************
+*
+* Summary:
+*   Sends an echo request from the Router to the Node over the loopback
+*   channel and checks the reply the Node sends back. The stat accounts the
+*   request, the reply is always compressed.
+*
+*******************************************************************************/
+static void LowpanTestEcho(const uint8 request[], uint16 length, const uint8 routerAddr[], const uint8 nodeAddr[],
+                           uint8 compress, LOWPAN_TEST_STAT_T *stat)
+{
+    static uint8 frame[LOWPAN_TEST_FRAME_MAX];
+    static uint8 rxFrame[LOWPAN_TEST_FRAME_MAX];
+    static uint8 pkt[IPV6_MTU];
+    LOWPAN_TEST_STAT_T replyStat;
+    uint8 *upper = &pkt[IPV6_HDR_LEN];
+    uint16 frameLength;
+    uint16 pktLength;
+    uint8 ok = 0u;
+
+    (void)memset(&replyStat, 0, sizeof(replyStat));
+
+    /* Router: the request */
+    if(0u != compress)
+    {
+        frameLength = LowpanCompress(request, length, lowpanTestRouterBdAddr, lowpanTestNodeBdAddr, frame,
+                                     sizeof(frame));
+    }
+    else
+    {
+        frame[0u] = LOWPAN_DISPATCH_IPV6;
+        (void)memcpy(&frame[1u], request, length);
+        frameLength = length + 1u;
+    }
+    frameLength = LowpanTestChannel(frame, frameLength, rxFrame, stat);
+
+    /* Node: the reply, always compressed */
+    pktLength = LowpanDecompress(rxFrame, frameLength, lowpanTestRouterBdAddr, lowpanTestNodeBdAddr, pkt,
+                                 sizeof(pkt));
+    pktLength = Ipv6Process(pkt, pktLength, nodeAddr);
+    frameLength = LowpanCompress(pkt, pktLength, lowpanTestNodeBdAddr, lowpanTestRouterBdAddr, frame,
+                                 sizeof(frame));
+    if(0u != frameLength)
+    {
+        frameLength = LowpanTestChannel(frame, frameLength, rxFrame, &replyStat);
+
+        /* Router: the reply must be the request with the addresses swapped */
+        pktLength = LowpanDecompress(rxFrame, frameLength, lowpanTestNodeBdAddr, lowpanTestRouterBdAddr, pkt,
+                                     sizeof(pkt));
+        if((length == pktLength) && (0u == Ipv6Checksum(pkt, pktLength)) &&
+           (0 == memcmp(&pkt[IPV6_SRC_OFFSET], nodeAddr, IPV6_ADDR_SIZE)) &&
+           (0 == memcmp(&pkt[IPV6_DST_OFFSET], routerAddr, IPV6_ADDR_SIZE)))
+        {
+            if(IPV6_NH_ICMPV6 == pkt[IPV6_NH_OFFSET])
+            {
+                ok = (uint8)((ICMPV6_ECHO_REPLY == upper[ICMPV6_TYPE_OFFSET]) &&
+                    (0 == memcmp(&upper[ICMPV6_ID_OFFSET], &request[IPV6_HDR_LEN + ICMPV6_ID_OFFSET],
+                                 length - IPV6_HDR_LEN - ICMPV6_ID_OFFSET)));
+            }
+            else
+            {
+                ok = (uint8)((IPV6_GET16(&upper[UDP_SRC_PORT_OFFSET]) == UDP_PORT_ECHO) &&
+                    (0 == memcmp(&upper[UDP_DST_PORT_OFFSET], &request[IPV6_HDR_LEN + UDP_SRC_PORT_OFFSET], 2u)) &&
+                    (0 == memcmp(&upper[UDP_HDR_LEN], &request[IPV6_HDR_LEN + UDP_HDR_LEN],
+                                 length - IPV6_HDR_LEN - UDP_HDR_LEN)));
+            }
+        }
+    }
+
+    if(0u == ok)
+    {
+        errors++;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LowpanTestReport
+********************************************************************************
+*
+* Summary:
+*   Prints the channel use of the echo requests.
+*
+*******************************************************************************/
+static void LowpanTestReport(const char *name, const LOWPAN_TEST_STAT_T *stat)
+{
+    printf("  %-12s %u SDUs, %.1f bytes, %.2f K-frames, %.2f LL packets per SDU\n", name, (unsigned)stat->sdus,
+        (double)stat->bytes / (double)stat->sdus, (double)stat->kFrames / (double)stat->sdus,
+        (double)stat->llPackets / (double)stat->sdus);
+}
+
+
+int main(int argc, char *argv[])
+{
+    static uint8 request[IPV6_MTU];
+    static uint8 data[IPV6_MTU];
+    LOWPAN_TEST_STAT_T stat[2u];
+    uint8 routerAddr[IPV6_ADDR_SIZE];
+    uint8 nodeAddr[IPV6_ADDR_SIZE];
+    uint8 allNodes[IPV6_ADDR_SIZE];
+    uint32 count;
+    uint32 n;
+    uint16 length;
+    uint16 dataLength;
+    uint16 k;
+    uint8 compress;
+
+    lowpanTestMps = (argc > 1) ? (uint16)strtoul(argv[1], NULL, 0) : 23u;
+    count = (argc > 2) ? (uint32)strtoul(argv[2], NULL, 0) : 200u;
+    if(lowpanTestMps < 23u)
+    {
+        lowpanTestMps = 23u;
+    }
+    srand(1u);
+
+    printf("lowpan: MPS %u\n", (unsigned)lowpanTestMps);
+    LowpanTestRoundTrip();
+
+    LowpanLinkLocal(lowpanTestRouterBdAddr, routerAddr);
+    LowpanLinkLocal(lowpanTestNodeBdAddr, nodeAddr);
+    LowpanTestAddr(LOWPAN_TEST_ADDR_MCAST_8, lowpanTestNodeBdAddr, allNodes);
+    (void)memset(stat, 0, sizeof(stat));
+
+    /* The same requests uncompressed, then compressed */
+    for(compress = 0u; compress < 2u; compress++)
+    {
+        srand(2u);
+        for(n = 0u; n < count; n++)
+        {
+            dataLength = (uint16)((uint32)rand() % 64u);
+            length = Ipv6EchoRequest(request, routerAddr, ((n % 4u) == 3u) ? allNodes : nodeAddr,
+                                     LOWPAN_TEST_ECHO_ID, (uint16)n, dataLength);
+            LowpanTestEcho(request, length, routerAddr, nodeAddr, compress, &stat[compress]);
+
+            for(k = 0u; k < dataLength; k++)
+            {
+                data[k] = (uint8)rand();
+            }
+            length = Ipv6Udp(request, routerAddr, nodeAddr, (uint16)(LOWPAN_NHC_PORT_4 + (n % 16u)), UDP_PORT_ECHO,
+                             data, dataLength);
+            LowpanTestEcho(request, length, routerAddr, nodeAddr, compress, &stat[compress]);
+        }
+    }
+
+    LowpanTestReport("uncompressed", &stat[0u]);
+    LowpanTestReport("IPHC", &stat[1u]);
+    if(stat[1u].llPackets >= stat[0u].llPackets)
+    {
+        errors++;
+    }
+    printf("  %u errors\n", (unsigned)errors);
+
+    return((0u == errors) ? 0 : 1);
+}
+
+
+/* [] END OF FILE */
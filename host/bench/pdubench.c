@@ -0,0 +1,379 @@
+/*******************************************************************************
+* File Name: pdubench.c
+*
+* Version 1.0
+*
+* Description:
+*  This file contains the host microbenchmark of the field table serializer
+*  of pdu.h. The Location and Speed and the Navigation packers generated from
+*  the tables of lnss.h are checked against the hand-written packing of
+*  LnsNtf() that they replaced, over every flag combination with random
+*  values, then the speed of both is measured on the host.
+*
+*  Arguments: pdubench [count]
+*  count - the PDUs of a measurement, 1000000 by default.
+*
+*  The host speed only compares the two forms: both are straight-line byte
+*  stores, the Cortex-M0 time follows the number of the stores and branches.
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "main.h"
+
+
+/***************************************
+*        Constants
+***************************************/
+#define PDU_BENCH_PDU_MAX           (32u)
+#define PDU_BENCH_LS_FLAGS          (0x0FFFu)   /* All the defined Location and Speed flags */
+#define PDU_BENCH_NV_FLAGS          (0x01FFu)   /* All the defined Navigation flags */
+#define PDU_BENCH_VALUES            (64u)       /* Random values of every flag combination */
+
+
+/***************************************
+*        Data Struct Definition
+***************************************/
+typedef uint8 (*PDU_BENCH_LS_FUNC)(uint8 pdu[], const CYBLE_LNS_LS_T *value, uint32 flags);
+typedef uint8 (*PDU_BENCH_NV_FUNC)(uint8 pdu[], const CYBLE_LNS_NV_T *value, uint32 flags);
+
+
+/* uint8 PduBenchPackLs(uint8 pdu[], const CYBLE_LNS_LS_T *value, uint32 flags) */
+PDU_DEFINE_PACK(PduBenchPackLs, CYBLE_LNS_LS_T, LNS_LS_FIELDS)
+
+/* uint8 PduBenchPackNv(uint8 pdu[], const CYBLE_LNS_NV_T *value, uint32 flags) */
+PDU_DEFINE_PACK(PduBenchPackNv, CYBLE_LNS_NV_T, LNS_NV_FIELDS)
+
+static uint8 pduBenchPdu[PDU_BENCH_PDU_MAX];
+static volatile uint8 pduBenchSink;         /* Keeps the measured calls */
+
+
+/*******************************************************************************
+* Function Name: PduBenchPackLsRef
+********************************************************************************
+*
+* Summary:
+*   The Location and Speed packing of LnsNtf() before the field tables.
+*
+*******************************************************************************/
+static uint8 PduBenchPackLsRef(uint8 pdu[], const CYBLE_LNS_LS_T *value, uint32 flags)
+{
+    uint8 ptr;
+
+    CyBle_Set16ByPtr(&pdu[0u], (uint16)flags);
+    ptr = 2u;
+
+    if(0u != (flags & CYBLE_LNS_LS_FLG_IS))
+    {
+        CyBle_Set16ByPtr(&pdu[ptr], value->instSpd);
+        ptr += sizeof(value->instSpd);
+    }
+
+    if(0u != (flags & CYBLE_LNS_LS_FLG_TD))
+    {
+        pdu[ptr] = (uint8) (value->totalDst & 0x000000FFu);
+        pdu[ptr + 1] = (uint8) ((value->totalDst & 0x0000FF00u) >> 8u);
+        pdu[ptr + 2] = (uint8) ((value->totalDst & 0x00FF0000u) >> 16u);
+        ptr += 3;
+    }
+
+    if(0u != (flags & CYBLE_LNS_LS_FLG_LC))
+    {
+        pdu[ptr] = (uint8) (value->latitude & 0x000000FFu);
+        pdu[ptr + 1] = (uint8) ((value->latitude & 0x0000FF00u) >> 8u);
+        pdu[ptr + 2] = (uint8) ((value->latitude & 0x00FF0000u) >> 16u);
+        pdu[ptr + 3] = (uint8) ((value->latitude & 0xFF000000u) >> 24u);
+        ptr += sizeof(value->latitude);
+        pdu[ptr] = (uint8) (value->longitude & 0x000000FFu);
+        pdu[ptr + 1] = (uint8) ((value->longitude & 0x0000FF00u) >> 8u);
+        pdu[ptr + 2] = (uint8) ((value->longitude & 0x00FF0000u) >> 16u);
+        pdu[ptr + 3] = (uint8) ((value->longitude & 0xFF000000u) >> 24u);
+        ptr += sizeof(value->longitude);
+    }
+
+    if(0u != (flags & CYBLE_LNS_LS_FLG_EL))
+    {
+        pdu[ptr] = (uint8) (value->elevation & 0x000000FFu);
+        pdu[ptr + 1] = (uint8) ((value->elevation & 0x0000FF00u) >> 8u);
+        pdu[ptr + 2] = (uint8) ((value->elevation & 0x00FF0000u) >> 16u);
+        ptr += 3;
+    }
+
+    if(0u != (flags & CYBLE_LNS_LS_FLG_HD))
+    {
+        CyBle_Set16ByPtr(&pdu[ptr], value->heading);
+        ptr += sizeof(value->heading);
+    }
+
+    if(0u != (flags & CYBLE_LNS_LS_FLG_RT))
+    {
+        pdu[ptr] = value->rollTime;
+        ptr += sizeof(value->rollTime);
+    }
+
+    if(0u != (flags & CYBLE_LNS_LS_FLG_UTC))
+    {
+        CyBle_Set16ByPtr(&pdu[ptr], value->utcTime.year);
+        pdu[ptr + 2u] = value->utcTime.month;
+        pdu[ptr + 3u] = value->utcTime.day;
+        pdu[ptr + 4u] = value->utcTime.hours;
+        pdu[ptr + 5u] = value->utcTime.minutes;
+        pdu[ptr + 6u] = value->utcTime.seconds;
+        ptr += 7u;
+    }
+
+    return(ptr);
+}
+
+
+/*******************************************************************************
+* Function Name: PduBenchPackNvRef
+********************************************************************************
+*
+* Summary:
+*   The Navigation packing of LnsNtf() before the field tables.
+*
+*******************************************************************************/
+static uint8 PduBenchPackNvRef(uint8 pdu[], const CYBLE_LNS_NV_T *value, uint32 flags)
+{
+    uint8 ptr;
+
+    CyBle_Set16ByPtr(&pdu[0u], (uint16)flags);
+    CyBle_Set16ByPtr(&pdu[2u], value->bearing);
+    CyBle_Set16ByPtr(&pdu[4u], value->heading);
+    ptr = 6u;
+
+    if(0u != (flags & CYBLE_LNS_NV_FLG_RD))
+    {
+        pdu[ptr] = (uint8) (value->rDst & 0x000000FFu);
+        pdu[ptr + 1] = (uint8) ((value->rDst & 0x0000FF00u) >> 8u);
+        pdu[ptr + 2] = (uint8) ((value->rDst & 0x00FF0000u) >> 16u);
+        ptr += 3;
+    }
+
+    if(0u != (flags & CYBLE_LNS_NV_FLG_RVD))
+    {
+        pdu[ptr] = (uint8) (value->rvDst & 0x000000FFu);
+        pdu[ptr + 1] = (uint8) ((value->rvDst & 0x0000FF00u) >> 8u);
+        pdu[ptr + 2] = (uint8) ((value->rvDst & 0x00FF0000u) >> 16u);
+        ptr += 3;
+    }
+
+    if(0u != (flags & CYBLE_LNS_NV_FLG_EAT))
+    {
+        CyBle_Set16ByPtr(&pdu[ptr], value->eaTime.year);
+        pdu[ptr + 2u] = value->eaTime.month;
+        pdu[ptr + 3u] = value->eaTime.day;
+        pdu[ptr + 4u] = value->eaTime.hours;
+        pdu[ptr + 5u] = value->eaTime.minutes;
+        pdu[ptr + 6u] = value->eaTime.seconds;
+        ptr += 7u;
+    }
+
+    return(ptr);
+}
+
+
+/*******************************************************************************
+* Function Name: PduBenchNs
+********************************************************************************
+*
+* Summary:
+*   Returns the host monotonic time.
+*
+*******************************************************************************/
+static uint64 PduBenchNs(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return(((uint64)ts.tv_sec * 1000000000u) + (uint64)ts.tv_nsec);
+}
+
+
+/*******************************************************************************
+* Function Name: PduBenchRandom
+********************************************************************************
+*
+* Summary:
+*   Returns a random 32-bit value.
+*
+*******************************************************************************/
+static uint32 PduBenchRandom(void)
+{
+    return(((uint32)rand() << 16u) ^ (uint32)rand());
+}
+
+
+/*******************************************************************************
+* Function Name: PduBenchDateTime
+********************************************************************************
+*
+* Summary:
+*   Fills a date and time with random values.
+*
+*******************************************************************************/
+static void PduBenchDateTime(CYBLE_DATE_TIME_T *dt)
+{
+    dt->year = (uint16)PduBenchRandom();
+    dt->month = (uint8)PduBenchRandom();
+    dt->day = (uint8)PduBenchRandom();
+    dt->hours = (uint8)PduBenchRandom();
+    dt->minutes = (uint8)PduBenchRandom();
+    dt->seconds = (uint8)PduBenchRandom();
+}
+
+
+/*******************************************************************************
+* Function Name: PduBenchCheck
+********************************************************************************
+*
+* Summary:
+*   Checks the generated packers against the hand-written ones.
+*
+* Return:
+*   The number of the mismatches.
+*
+*******************************************************************************/
+static uint32 PduBenchCheck(void)
+{
+    uint8 ref[PDU_BENCH_PDU_MAX];
+    CYBLE_LNS_LS_T ls;
+    CYBLE_LNS_NV_T nv;
+    uint32 errors = 0u;
+    uint32 flags;
+    uint32 n;
+    uint8 length;
+
+    for(flags = 0u; flags <= PDU_BENCH_LS_FLAGS; flags++)
+    {
+        for(n = 0u; n < PDU_BENCH_VALUES; n++)
+        {
+            ls.instSpd = (uint16)PduBenchRandom();
+            ls.totalDst = PduBenchRandom();
+            ls.latitude = (int32)PduBenchRandom();
+            ls.longitude = (int32)PduBenchRandom();
+            ls.elevation = (int32)PduBenchRandom();
+            ls.heading = (uint16)PduBenchRandom();
+            ls.rollTime = (uint8)PduBenchRandom();
+            PduBenchDateTime(&ls.utcTime);
+
+            length = PduBenchPackLsRef(ref, &ls, flags);
+            if((length != PduBenchPackLs(pduBenchPdu, &ls, flags)) || (0 != memcmp(ref, pduBenchPdu, length)))
+            {
+                errors++;
+            }
+        }
+    }
+
+    for(flags = 0u; flags <= PDU_BENCH_NV_FLAGS; flags++)
+    {
+        for(n = 0u; n < PDU_BENCH_VALUES; n++)
+        {
+            nv.bearing = (uint16)PduBenchRandom();
+            nv.heading = (uint16)PduBenchRandom();
+            nv.rDst = PduBenchRandom();
+            nv.rvDst = (int32)PduBenchRandom();
+            PduBenchDateTime(&nv.eaTime);
+
+            length = PduBenchPackNvRef(ref, &nv, flags);
+            if((length != PduBenchPackNv(pduBenchPdu, &nv, flags)) || (0 != memcmp(ref, pduBenchPdu, length)))
+            {
+                errors++;
+            }
+        }
+    }
+
+    return(errors);
+}
+
+
+/*******************************************************************************
+* Function Name: PduBenchMeasureLs
+********************************************************************************
+*
+* Summary:
+*   Returns the nanoseconds per Location and Speed PDU, the flags cycle over
+*   all the combinations.
+*
+*******************************************************************************/
+static double PduBenchMeasureLs(PDU_BENCH_LS_FUNC func, const CYBLE_LNS_LS_T *ls, uint32 count)
+{
+    uint64 start = PduBenchNs();
+    uint32 n;
+
+    for(n = 0u; n < count; n++)
+    {
+        pduBenchSink = func(pduBenchPdu, ls, n & PDU_BENCH_LS_FLAGS);
+    }
+
+    return((double)(PduBenchNs() - start) / (double)count);
+}
+
+
+/*******************************************************************************
+* Function Name: PduBenchMeasureNv
+********************************************************************************
+*
+* Summary:
+*   Returns the nanoseconds per Navigation PDU, the flags cycle over all the
+*   combinations.
+*
+*******************************************************************************/
+static double PduBenchMeasureNv(PDU_BENCH_NV_FUNC func, const CYBLE_LNS_NV_T *nv, uint32 count)
+{
+    uint64 start = PduBenchNs();
+    uint32 n;
+
+    for(n = 0u; n < count; n++)
+    {
+        pduBenchSink = func(pduBenchPdu, nv, n & PDU_BENCH_NV_FLAGS);
+    }
+
+    return((double)(PduBenchNs() - start) / (double)count);
+}
+
+
+int main(int argc, char *argv[])
+{
+    static const CYBLE_LNS_LS_T ls = {0u, 1234u, 56789u, 525000000, 134000000, 12345, 9000u, 17u,
+        {2016u, 5u, 21u, 14u, 14u, 41u}};
+    static const CYBLE_LNS_NV_T nv = {0u, 4500u, 9000u, 123456u, -1234, {2016u, 5u, 21u, 15u, 0u, 0u}};
+    uint32 count = (argc > 1) ? (uint32)strtoul(argv[1], NULL, 0) : 1000000u;
+    uint32 errors;
+    double nsRef;
+    double ns;
+
+    if(0u == count)
+    {
+        count = 1u;
+    }
+
+    srand(1u);
+    errors = PduBenchCheck();
+
+    printf("pdu: %u PDUs\n", (unsigned)count);
+    nsRef = PduBenchMeasureLs(&PduBenchPackLsRef, &ls, count);
+    ns = PduBenchMeasureLs(&PduBenchPackLs, &ls, count);
+    printf("  %-18s %6.2f ns/PDU hand-written, %6.2f ns/PDU table\n", "Location and Speed", nsRef, ns);
+    nsRef = PduBenchMeasureNv(&PduBenchPackNvRef, &nv, count);
+    ns = PduBenchMeasureNv(&PduBenchPackNv, &nv, count);
+    printf("  %-18s %6.2f ns/PDU hand-written, %6.2f ns/PDU table\n", "Navigation", nsRef, ns);
+    printf("  %u mismatches\n", (unsigned)errors);
+
+    return((0u == errors) ? 0 : 1);
+}
+
+
+/* [] END OF FILE */
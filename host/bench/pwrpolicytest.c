@@ -0,0 +1,143 @@
+/*******************************************************************************
+* File Name: pwrpolicytest.c
+*
+* Version 1.0
+*
+* Description:
+*  This file contains the host test of the low power policy of the Heart Rate
+*  Sensor and Running Speed and Cadence projects. PwrPolicyDecide() is
+*  checked against a table of the busy holder, BLESS, event close and
+*  pending event inputs, then every input combination is checked against
+*  the rules the power manager relies on:
+*
+*   - the CPU only enters Deep-Sleep when the BLE subsystem is in Deep-Sleep,
+*     the holders allow it and no event is pending;
+*   - the mode is never deeper than the busy holders allow;
+*   - a reason is given exactly when Deep-Sleep is not chosen.
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stdio.h>
+#include "pwrpolicy.h"
+
+
+/***************************************
+*        Data Struct Definition
+***************************************/
+typedef struct
+{
+    PWR_POLICY_INPUT_T input;
+    uint8 mode;
+    uint8 reason;
+} PWR_POLICY_TEST_T;
+
+
+/* bleLinked, blessDeepSleep, blessState, holderMode, eventPending -> mode, reason */
+static const PWR_POLICY_TEST_T pwrPolicyTests[] =
+{
+    /* Pending events are handled before anything else */
+    {{1u, 1u, PWR_BLESS_SLEEPING, PWR_MODE_DEEPSLEEP, 1u}, PWR_MODE_ACTIVE, PWR_REASON_EVENT},
+    {{0u, 0u, PWR_BLESS_ACTIVE, PWR_MODE_ACTIVE, 1u}, PWR_MODE_ACTIVE, PWR_REASON_EVENT},
+
+    /* Busy holders */
+    {{1u, 1u, PWR_BLESS_SLEEPING, PWR_MODE_ACTIVE, 0u}, PWR_MODE_ACTIVE, PWR_REASON_HOLDER},
+    {{1u, 1u, PWR_BLESS_SLEEPING, PWR_MODE_SLEEP, 0u}, PWR_MODE_SLEEP, PWR_REASON_HOLDER},
+    {{1u, 0u, PWR_BLESS_ACTIVE, PWR_MODE_SLEEP, 0u}, PWR_MODE_SLEEP, PWR_REASON_BLE_ACTIVE},
+
+    /* Neither advertising nor connected */
+    {{0u, 1u, PWR_BLESS_SLEEPING, PWR_MODE_DEEPSLEEP, 0u}, PWR_MODE_ACTIVE, PWR_REASON_STATE},
+
+    /* BLESS in Deep-Sleep */
+    {{1u, 1u, PWR_BLESS_SLEEPING, PWR_MODE_DEEPSLEEP, 0u}, PWR_MODE_DEEPSLEEP, PWR_REASON_NONE},
+    {{1u, 1u, PWR_BLESS_ACTIVE, PWR_MODE_DEEPSLEEP, 0u}, PWR_MODE_ACTIVE, PWR_REASON_BLESS},
+    {{1u, 1u, PWR_BLESS_EVENT_CLOSE, PWR_MODE_DEEPSLEEP, 0u}, PWR_MODE_ACTIVE, PWR_REASON_BLESS},
+
+    /* BLESS refused Deep-Sleep */
+    {{1u, 0u, PWR_BLESS_ACTIVE, PWR_MODE_DEEPSLEEP, 0u}, PWR_MODE_SLEEP, PWR_REASON_BLE_ACTIVE},
+    {{1u, 0u, PWR_BLESS_SLEEPING, PWR_MODE_DEEPSLEEP, 0u}, PWR_MODE_SLEEP, PWR_REASON_BLE_ACTIVE},
+    {{1u, 0u, PWR_BLESS_EVENT_CLOSE, PWR_MODE_DEEPSLEEP, 0u}, PWR_MODE_ACTIVE, PWR_REASON_EVENT_CLOSE},
+    {{1u, 0u, PWR_BLESS_EVENT_CLOSE, PWR_MODE_SLEEP, 0u}, PWR_MODE_ACTIVE, PWR_REASON_EVENT_CLOSE},
+};
+
+
+/*******************************************************************************
+* Function Name: PwrPolicyTestRules
+********************************************************************************
+*
+* Summary:
+*   Checks every input combination against the rules of the policy.
+*
+* Return:
+*   The number of the failed combinations.
+*
+*******************************************************************************/
+static uint32 PwrPolicyTestRules(void)
+{
+    PWR_POLICY_INPUT_T input;
+    uint32 errors = 0u;
+    uint32 n;
+    uint8 mode;
+    uint8 reason;
+
+    for(n = 0u; n < (2u * 2u * 3u * PWR_MODES * 2u); n++)
+    {
+        input.bleLinked = (uint8)(n % 2u);
+        input.blessDeepSleep = (uint8)((n / 2u) % 2u);
+        input.blessState = (uint8)((n / 4u) % 3u);
+        input.holderMode = (uint8)((n / 12u) % PWR_MODES);
+        input.eventPending = (uint8)((n / (12u * PWR_MODES)) % 2u);
+
+        mode = PwrPolicyDecide(&input, &reason);
+
+        if((mode >= PWR_MODES) || (mode < input.holderMode) ||
+           ((PWR_MODE_DEEPSLEEP == mode) &&
+            ((0u == input.bleLinked) || (0u == input.blessDeepSleep) ||
+             (PWR_BLESS_SLEEPING != input.blessState) || (0u != input.eventPending))) ||
+           ((PWR_MODE_DEEPSLEEP == mode) != (PWR_REASON_NONE == reason)) ||
+           ((PWR_REASON_NONE != reason) && (reason >= PWR_REASONS)))
+        {
+            printf("  rules: linked %u, deep-sleep %u, BLESS %u, holder %u, event %u -> mode %u, reason %u\n",
+                (unsigned)input.bleLinked, (unsigned)input.blessDeepSleep, (unsigned)input.blessState,
+                (unsigned)input.holderMode, (unsigned)input.eventPending, (unsigned)mode, (unsigned)reason);
+            errors++;
+        }
+    }
+
+    return(errors);
+}
+
+
+int main(void)
+{
+    const PWR_POLICY_TEST_T *test;
+    uint32 errors = 0u;
+    uint32 n;
+    uint8 mode;
+    uint8 reason;
+
+    for(n = 0u; n < (sizeof(pwrPolicyTests) / sizeof(pwrPolicyTests[0u])); n++)
+    {
+        test = &pwrPolicyTests[n];
+        mode = PwrPolicyDecide(&test->input, &reason);
+        if((mode != test->mode) || (reason != test->reason))
+        {
+            printf("  case %u: mode %u, reason %u, expected %u, %u\n", (unsigned)n,
+                (unsigned)mode, (unsigned)reason, (unsigned)test->mode, (unsigned)test->reason);
+            errors++;
+        }
+    }
+    printf("pwrpolicy: %u cases\n", (unsigned)n);
+
+    errors += PwrPolicyTestRules();
+    printf("  %u errors\n", (unsigned)errors);
+
+    return((0u == errors) ? 0 : 1);
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,313 @@
+/*******************************************************************************
+* File Name: cyble_cgmss.c
+*
+* Version 1.0
+*
+* Description:
+*  This file contains the simulated Continuous Glucose Monitoring Service
+*  server API of the host build. The CCCDs and the readable characteristic
+*  values are kept in RAM, the notifications and indications go to the
+*  simulated link.
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <project.h>
+
+
+static CYBLE_CALLBACK_T cyBleCgmsCallback;
+static uint16 cyBleCgmssCccd[CYBLE_CGMS_CHAR_COUNT];
+static uint8 cyBleCgmssValue[CYBLE_CGMS_CHAR_COUNT][CYBLE_SIM_CGMS_VALUE_MAX];
+
+
+/*******************************************************************************
+* Function Name: CyBle_CgmssConfirm
+********************************************************************************
+*
+* Summary:
+*   Reports the confirmation of a control point indication.
+*
+* Parameters:
+*   attrHandle - the attribute of the indication.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+static void CyBle_CgmssConfirm(uint16 attrHandle)
+{
+    CYBLE_CGMS_CHAR_VALUE_T param;
+
+    if((NULL != cyBleCgmsCallback) && ((CYBLE_SIM_CGMS_HANDLE(CYBLE_CGMS_RACP) == attrHandle) ||
+       (CYBLE_SIM_CGMS_HANDLE(CYBLE_CGMS_SOCP) == attrHandle)))
+    {
+        param.connHandle = cyBle_connHandle;
+        param.charIndex = (CYBLE_SIM_CGMS_HANDLE(CYBLE_CGMS_RACP) == attrHandle) ? CYBLE_CGMS_RACP : CYBLE_CGMS_SOCP;
+        param.value = NULL;
+        param.gattErrorCode = CYBLE_GATT_ERR_NONE;
+        cyBleCgmsCallback((uint32)CYBLE_EVT_CGMSS_INDICATION_CONFIRMED, &param);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: CyBle_CgmsRegisterAttrCallback
+********************************************************************************
+*
+* Summary:
+*   Registers the callback of the Continuous Glucose Monitoring Service
+*   events.
+*
+* Parameters:
+*   callbackFunc - the callback.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void CyBle_CgmsRegisterAttrCallback(CYBLE_CALLBACK_T callbackFunc)
+{
+    cyBleCgmsCallback = callbackFunc;
+    CyBleSim_SetCnfHandler(&CyBle_CgmssConfirm);
+}
+
+
+/*******************************************************************************
+* Function Name: CyBle_CgmssSetCharacteristicValue
+********************************************************************************
+*
+* Summary:
+*   Sets the value of a characteristic in the GATT database.
+*
+* Parameters:
+*   charIndex - the characteristic.
+*   attrSize - the size of the value.
+*   attrValue - the value.
+*
+* Return:
+*   CYBLE_ERROR_INVALID_PARAMETER for too long a value, else CYBLE_ERROR_OK.
+*
+*******************************************************************************/
+CYBLE_API_RESULT_T CyBle_CgmssSetCharacteristicValue(CYBLE_CGMS_CHAR_INDEX_T charIndex, uint8 attrSize,
+    uint8 *attrValue)
+{
+    CYBLE_API_RESULT_T result = CYBLE_ERROR_OK;
+
+    if((charIndex >= CYBLE_CGMS_CHAR_COUNT) || (attrSize > CYBLE_SIM_CGMS_VALUE_MAX))
+    {
+        result = CYBLE_ERROR_INVALID_PARAMETER;
+    }
+    else
+    {
+        (void)memcpy(cyBleCgmssValue[charIndex], attrValue, attrSize);
+    }
+
+    return(result);
+}
+
+
+/*******************************************************************************
+* Function Name: CyBle_CgmssGetCharacteristicValue
+********************************************************************************
+*
+* Summary:
+*   Reads the value of a characteristic from the GATT database.
+*
+* Parameters:
+*   charIndex - the characteristic.
+*   attrSize - the size of the value.
+*   attrValue - returns the value.
+*
+* Return:
+*   CYBLE_ERROR_INVALID_PARAMETER for too long a value, else CYBLE_ERROR_OK.
+*
+*******************************************************************************/
+CYBLE_API_RESULT_T CyBle_CgmssGetCharacteristicValue(CYBLE_CGMS_CHAR_INDEX_T charIndex, uint8 attrSize,
+    uint8 *attrValue)
+{
+    CYBLE_API_RESULT_T result = CYBLE_ERROR_OK;
+
+    if((charIndex >= CYBLE_CGMS_CHAR_COUNT) || (attrSize > CYBLE_SIM_CGMS_VALUE_MAX))
+    {
+        result = CYBLE_ERROR_INVALID_PARAMETER;
+    }
+    else
+    {
+        (void)memcpy(attrValue, cyBleCgmssValue[charIndex], attrSize);
+    }
+
+    return(result);
+}
+
+
+/*******************************************************************************
+* Function Name: CyBle_CgmssSendNotification
+********************************************************************************
+*
+* Summary:
+*   Sends a CGM Measurement notification.
+*
+* Parameters:
+*   connHandle - the connection handle.
+*   charIndex - the characteristic.
+*   attrSize - the size of the value.
+*   attrValue - the value.
+*
+* Return:
+*   CYBLE_ERROR_NTF_DISABLED when the client has not enabled the
+*   notifications, else the result of CyBleSim_Send().
+*
+*******************************************************************************/
+CYBLE_API_RESULT_T CyBle_CgmssSendNotification(CYBLE_CONN_HANDLE_T connHandle, CYBLE_CGMS_CHAR_INDEX_T charIndex,
+    uint8 attrSize, uint8 *attrValue)
+{
+    CYBLE_API_RESULT_T result;
+
+    if(CYBLE_CGMS_CGMT != charIndex)
+    {
+        result = CYBLE_ERROR_INVALID_PARAMETER;
+    }
+    else if(0u == (cyBleCgmssCccd[charIndex] & CYBLE_CCCD_NOTIFICATION))
+    {
+        result = CYBLE_ERROR_NTF_DISABLED;
+    }
+    else
+    {
+        result = CyBleSim_Send(connHandle, CYBLE_SIM_CGMS_HANDLE(charIndex), attrSize, attrValue, 0u);
+    }
+
+    return(result);
+}
+
+
+/*******************************************************************************
+* Function Name: CyBle_CgmssSendIndication
+********************************************************************************
+*
+* Summary:
+*   Sends a Record Access Control Point or a CGM Specific Ops Control Point
+*   indication.
+*
+* Parameters:
+*   connHandle - the connection handle.
+*   charIndex - the characteristic.
+*   attrSize - the size of the value.
+*   attrValue - the value.
+*
+* Return:
+*   CYBLE_ERROR_IND_DISABLED when the client has not enabled the
+*   indications, else the result of CyBleSim_Send().
+*
+*******************************************************************************/
+CYBLE_API_RESULT_T CyBle_CgmssSendIndication(CYBLE_CONN_HANDLE_T connHandle, CYBLE_CGMS_CHAR_INDEX_T charIndex,
+    uint8 attrSize, uint8 *attrValue)
+{
+    CYBLE_API_RESULT_T result;
+
+    if((CYBLE_CGMS_RACP != charIndex) && (CYBLE_CGMS_SOCP != charIndex))
+    {
+        result = CYBLE_ERROR_INVALID_PARAMETER;
+    }
+    else if(0u == (cyBleCgmssCccd[charIndex] & CYBLE_CCCD_INDICATION))
+    {
+        result = CYBLE_ERROR_IND_DISABLED;
+    }
+    else
+    {
+        result = CyBleSim_Send(connHandle, CYBLE_SIM_CGMS_HANDLE(charIndex), attrSize, attrValue, 1u);
+    }
+
+    return(result);
+}
+
+
+/*******************************************************************************
+* Function Name: CyBleSim_CgmssWriteCccd
+********************************************************************************
+*
+* Summary:
+*   Writes the CCCD of a characteristic as the client does and raises the
+*   event of the change.
+*
+* Parameters:
+*   charIndex - the characteristic.
+*   cccd - the value of the CCCD.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void CyBleSim_CgmssWriteCccd(CYBLE_CGMS_CHAR_INDEX_T charIndex, uint16 cccd)
+{
+    CYBLE_CGMS_CHAR_VALUE_T param;
+    uint32 event;
+
+    cyBleCgmssCccd[charIndex] = cccd;
+
+    if((CYBLE_CGMS_RACP == charIndex) || (CYBLE_CGMS_SOCP == charIndex))
+    {
+        event = (0u != (cccd & CYBLE_CCCD_INDICATION)) ?
+            (uint32)CYBLE_EVT_CGMSS_INDICATION_ENABLED : (uint32)CYBLE_EVT_CGMSS_INDICATION_DISABLED;
+    }
+    else
+    {
+        event = (0u != (cccd & CYBLE_CCCD_NOTIFICATION)) ?
+            (uint32)CYBLE_EVT_CGMSS_NOTIFICATION_ENABLED : (uint32)CYBLE_EVT_CGMSS_NOTIFICATION_DISABLED;
+    }
+
+    if(NULL != cyBleCgmsCallback)
+    {
+        param.connHandle = cyBle_connHandle;
+        param.charIndex = charIndex;
+        param.value = NULL;
+        param.gattErrorCode = CYBLE_GATT_ERR_NONE;
+        cyBleCgmsCallback(event, &param);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: CyBleSim_CgmssWriteChar
+********************************************************************************
+*
+* Summary:
+*   Writes a characteristic as the client does.
+*
+* Parameters:
+*   charIndex - the characteristic.
+*   length - the length of the value.
+*   value - the value.
+*
+* Return:
+*   The error code the profile sets to the write response.
+*
+*******************************************************************************/
+CYBLE_GATT_ERR_CODE_T CyBleSim_CgmssWriteChar(CYBLE_CGMS_CHAR_INDEX_T charIndex, uint8 length, const uint8 value[])
+{
+    CYBLE_CGMS_CHAR_VALUE_T param;
+    CYBLE_GATT_VALUE_T gattValue;
+    uint8 buf[CYBLE_SIM_MTU_MAX];
+
+    (void)memcpy(buf, value, length);
+    gattValue.val = buf;
+    gattValue.len = length;
+    gattValue.actualLen = length;
+
+    param.connHandle = cyBle_connHandle;
+    param.charIndex = charIndex;
+    param.value = &gattValue;
+    param.gattErrorCode = CYBLE_GATT_ERR_NONE;
+    if(NULL != cyBleCgmsCallback)
+    {
+        cyBleCgmsCallback((uint32)CYBLE_EVT_CGMSS_WRITE_CHAR, &param);
+    }
+
+    return(param.gattErrorCode);
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,107 @@
+/*******************************************************************************
+* File Name: project.h
+*
+* Version 1.0
+*
+* Description:
+*  Host replacement of the project.h generated for
+*  BLE_Continuous_Glucose_Monitoring_Sensor: the simulated stack and flash
+*  and the Continuous Glucose Monitoring Service server API. The Bond
+*  Management Service types are only the ones bmss.h declares its data with.
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(CY_PROJECT_H)
+#define CY_PROJECT_H
+
+#define CYBLE_GATT_MTU                      (23u)       /* MtuSize of TopDesign.cysch */
+
+#include "cyble_sim.h"
+#include "cyflash_sim.h"
+
+
+/***************************************
+*        Constants
+***************************************/
+/* Attribute handle of the value of a characteristic in the simulation */
+#define CYBLE_SIM_CGMS_HANDLE(charIndex)    ((uint16)(0x0040u + (uint16)(charIndex)))
+
+/* Longest value of a characteristic the simulation keeps */
+#define CYBLE_SIM_CGMS_VALUE_MAX            (16u)
+
+#define CYBLE_GAP_BD_ADDR_SIZE              (6u)
+#define CYBLE_GAP_MAX_BONDED_DEVICE         (4u)
+
+
+/***************************************
+*        Data Struct Definition
+***************************************/
+typedef enum
+{
+    CYBLE_CGMS_CGMT,                        /* CGM Measurement */
+    CYBLE_CGMS_CGFT,                        /* CGM Feature */
+    CYBLE_CGMS_CGST,                        /* CGM Status */
+    CYBLE_CGMS_SSTM,                        /* CGM Session Start Time */
+    CYBLE_CGMS_SRTM,                        /* CGM Session Run Time */
+    CYBLE_CGMS_RACP,                        /* Record Access Control Point */
+    CYBLE_CGMS_SOCP,                        /* CGM Specific Ops Control Point */
+    CYBLE_CGMS_CHAR_COUNT
+} CYBLE_CGMS_CHAR_INDEX_T;
+
+typedef struct
+{
+    CYBLE_CONN_HANDLE_T connHandle;
+    CYBLE_CGMS_CHAR_INDEX_T charIndex;
+    CYBLE_GATT_VALUE_T *value;
+    CYBLE_GATT_ERR_CODE_T gattErrorCode;
+} CYBLE_CGMS_CHAR_VALUE_T;
+
+typedef enum
+{
+    CYBLE_EVT_CGMSS_INDICATION_ENABLED = 0x3300u,
+    CYBLE_EVT_CGMSS_INDICATION_DISABLED,
+    CYBLE_EVT_CGMSS_INDICATION_CONFIRMED,
+    CYBLE_EVT_CGMSS_NOTIFICATION_ENABLED,
+    CYBLE_EVT_CGMSS_NOTIFICATION_DISABLED,
+    CYBLE_EVT_CGMSS_WRITE_CHAR
+} CYBLE_CGMS_EVT_T;
+
+typedef struct
+{
+    uint8 bdAddr[CYBLE_GAP_BD_ADDR_SIZE];   /* Device address */
+    uint8 type;                             /* public = 0, Random = 1 */
+} CYBLE_GAP_BD_ADDR_T;
+
+typedef struct
+{
+    uint8 count;                            /* Number of bonded devices */
+    CYBLE_GAP_BD_ADDR_T bdAddrList[CYBLE_GAP_MAX_BONDED_DEVICE];
+} CYBLE_GAP_BONDED_DEV_ADDR_LIST_T;
+
+
+/***************************************
+*      API Function Prototypes
+***************************************/
+void CyBle_CgmsRegisterAttrCallback(CYBLE_CALLBACK_T callbackFunc);
+CYBLE_API_RESULT_T CyBle_CgmssSetCharacteristicValue(CYBLE_CGMS_CHAR_INDEX_T charIndex, uint8 attrSize,
+    uint8 *attrValue);
+CYBLE_API_RESULT_T CyBle_CgmssGetCharacteristicValue(CYBLE_CGMS_CHAR_INDEX_T charIndex, uint8 attrSize,
+    uint8 *attrValue);
+CYBLE_API_RESULT_T CyBle_CgmssSendNotification(CYBLE_CONN_HANDLE_T connHandle, CYBLE_CGMS_CHAR_INDEX_T charIndex,
+    uint8 attrSize, uint8 *attrValue);
+CYBLE_API_RESULT_T CyBle_CgmssSendIndication(CYBLE_CONN_HANDLE_T connHandle, CYBLE_CGMS_CHAR_INDEX_T charIndex,
+    uint8 attrSize, uint8 *attrValue);
+
+/* Client side of the simulation */
+void CyBleSim_CgmssWriteCccd(CYBLE_CGMS_CHAR_INDEX_T charIndex, uint16 cccd);
+CYBLE_GATT_ERR_CODE_T CyBleSim_CgmssWriteChar(CYBLE_CGMS_CHAR_INDEX_T charIndex, uint8 length, const uint8 value[]);
+
+
+#endif /* CY_PROJECT_H */
+
+/* [] END OF FILE */
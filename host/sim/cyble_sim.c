@@ -0,0 +1,686 @@
+/*******************************************************************************
+* File Name: cyble_sim.c
+*
+* Version 1.0
+*
+* Description:
+*  This file contains the simulated CyBle stack and cy_boot APIs of the host
+*  build, see cyble_sim.h for the link model.
+*
+*  The SysTick counter runs from the host monotonic clock scaled to
+*  CYBLE_SIM_SYSCLK_HZ, so the cycles measured by the profile code are host
+*  time, not Cortex-M0 cycles.
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <time.h>
+#include "cyble_sim.h"
+
+
+/***************************************
+*        Constants
+***************************************/
+#define CYBLE_SIM_US_PER_INTERVAL   (1250u)     /* Connection interval unit */
+#define CYBLE_SIM_INTERVAL_MIN      (6u)        /* 7.5 ms */
+#define CYBLE_SIM_T_IFS             (150u)      /* Inter frame space, us */
+#define CYBLE_SIM_EMPTY_PDU_TIME    (80u)       /* Empty packet of the master, us */
+#define CYBLE_SIM_PKT_OVERHEAD      (10u)       /* Preamble, access address, header and CRC bytes */
+#define CYBLE_SIM_ATT_HDR_SIZE      (3u)        /* Opcode and attribute handle */
+#define CYBLE_SIM_L2CAP_HDR_SIZE    (4u)        /* Length and channel ID */
+
+/* States of the indication */
+#define CYBLE_SIM_IND_NONE          (0u)        /* No indication in progress */
+#define CYBLE_SIM_IND_QUEUED        (1u)        /* In a TX buffer */
+#define CYBLE_SIM_IND_SENT          (2u)        /* Delivered, confirmed in the next connection event */
+
+
+/***************************************
+*        Data Struct Definition
+***************************************/
+typedef struct
+{
+    uint16 attrHandle;
+    uint16 length;              /* Length of the attribute value */
+    uint16 remain;              /* L2CAP PDU bytes not sent yet */
+    uint8  isIndication;
+    uint8  value[CYBLE_SIM_MTU_MAX];
+} CYBLE_SIM_TX_T;
+
+
+CYBLE_CONN_HANDLE_T cyBle_connHandle;
+CYBLE_SIM_CFG_T cyBleSimCfg;
+CYBLE_SIM_STAT_T cyBleSimStat;
+
+static CYBLE_SIM_TX_T cyBleSimTx[CYBLE_SIM_TX_BUF_MAX];
+static uint8 cyBleSimTxHead;                /* Oldest TX buffer */
+static uint8 cyBleSimTxCount;               /* Taken TX buffers */
+static uint8 cyBleSimInd;                   /* CYBLE_SIM_IND_ */
+static uint16 cyBleSimIndHandle;            /* Attribute of the indication in progress */
+static uint64 cyBleSimTime;                 /* Simulated time, us */
+static uint64 cyBleSimEvtTime;              /* Time of the next connection event */
+static CYBLE_STATE_T cyBleSimState = CYBLE_STATE_STOPPED;
+static CYBLE_SIM_RX_FUNC cyBleSimRx;
+static CYBLE_SIM_CNF_FUNC cyBleSimCnf;
+
+static uint64 cyBleSimTickStart;            /* Host time of the SysTick clear, ns */
+static uint32 cyBleSimTickReload = CY_SYS_SYST_RVR_CNT_MASK;
+
+
+/*******************************************************************************
+* Function Name: CyBleSim_HostNs
+********************************************************************************
+*
+* Summary:
+*   Reads the host monotonic clock.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   The host time, ns.
+*
+*******************************************************************************/
+static uint64 CyBleSim_HostNs(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return(((uint64)ts.tv_sec * 1000000000u) + (uint64)ts.tv_nsec);
+}
+
+
+/*******************************************************************************
+* Function Name: CyBleSim_ConnEvent
+********************************************************************************
+*
+* Summary:
+*   Runs the next connection event: the indication delivered in the previous
+*   event is confirmed, then the LL packets of the TX buffers are sent in
+*   their order while they fit in the interval. A notification or an
+*   indication frees its TX buffer and reaches the peer with its last packet.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+static void CyBleSim_ConnEvent(void)
+{
+    CYBLE_SIM_TX_T *tx;
+    uint32 budget = (uint32)cyBleSimCfg.connInterval * CYBLE_SIM_US_PER_INTERVAL;
+    uint32 airTime;
+    uint16 size;
+    uint8 packets = 0u;
+    uint8 room = 1u;
+
+    cyBleSimTime = cyBleSimEvtTime;
+    cyBleSimEvtTime += budget;
+    cyBleSimStat.connEvents++;
+
+    if(CYBLE_SIM_IND_SENT == cyBleSimInd)
+    {
+        cyBleSimInd = CYBLE_SIM_IND_NONE;
+        if(NULL != cyBleSimCnf)
+        {
+            cyBleSimCnf(cyBleSimIndHandle);
+        }
+    }
+
+    while((0u != room) && (0u != cyBleSimTxCount) &&
+          ((0u == cyBleSimCfg.pktPerEvt) || (packets < cyBleSimCfg.pktPerEvt)))
+    {
+        tx = &cyBleSimTx[cyBleSimTxHead];
+        size = (tx->remain > CYBLE_SIM_LL_PAYLOAD) ? CYBLE_SIM_LL_PAYLOAD : tx->remain;
+
+        /* Empty packet of the master and the data packet, each after an IFS */
+        airTime = CYBLE_SIM_EMPTY_PDU_TIME + CYBLE_SIM_T_IFS +
+            ((CYBLE_SIM_PKT_OVERHEAD + (uint32)size) * 8u) + CYBLE_SIM_T_IFS;
+
+        if(airTime > budget)
+        {
+            room = 0u;
+        }
+        else
+        {
+            budget -= airTime;
+            tx->remain -= size;
+            packets++;
+            cyBleSimStat.llPackets++;
+
+            if(0u == tx->remain)
+            {
+                if(0u != tx->isIndication)
+                {
+                    cyBleSimStat.indCount++;
+                    cyBleSimInd = CYBLE_SIM_IND_SENT;
+                }
+                else
+                {
+                    cyBleSimStat.ntfCount++;
+                }
+                cyBleSimStat.attBytes += tx->length;
+
+                if(NULL != cyBleSimRx)
+                {
+                    cyBleSimRx(tx->attrHandle, tx->length, tx->value, tx->isIndication);
+                }
+
+                cyBleSimTxHead = (uint8)((cyBleSimTxHead + 1u) % CYBLE_SIM_TX_BUF_MAX);
+                cyBleSimTxCount--;
+            }
+        }
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: CyBleSim_Start
+********************************************************************************
+*
+* Summary:
+*   Empties the TX buffers, clears the counters and the simulated time and
+*   opens the connection with the configuration.
+*
+* Parameters:
+*   cfg - the configuration of the link.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void CyBleSim_Start(const CYBLE_SIM_CFG_T *cfg)
+{
+    cyBleSimCfg = *cfg;
+    if(cyBleSimCfg.connInterval < CYBLE_SIM_INTERVAL_MIN)
+    {
+        cyBleSimCfg.connInterval = CYBLE_SIM_INTERVAL_MIN;
+    }
+    if(cyBleSimCfg.attMtu > CYBLE_SIM_MTU_MAX)
+    {
+        cyBleSimCfg.attMtu = CYBLE_SIM_MTU_MAX;
+    }
+    if(cyBleSimCfg.attMtu < CYBLE_GATT_DEFAULT_MTU)
+    {
+        cyBleSimCfg.attMtu = CYBLE_GATT_DEFAULT_MTU;
+    }
+    if((0u == cyBleSimCfg.txBufNum) || (cyBleSimCfg.txBufNum > CYBLE_SIM_TX_BUF_MAX))
+    {
+        cyBleSimCfg.txBufNum = CYBLE_SIM_TX_BUF_MAX;
+    }
+
+    (void)memset(&cyBleSimStat, 0, sizeof(cyBleSimStat));
+    cyBleSimTxHead = 0u;
+    cyBleSimTxCount = 0u;
+    cyBleSimInd = CYBLE_SIM_IND_NONE;
+    cyBleSimTime = 0u;
+    cyBleSimEvtTime = (uint64)cyBleSimCfg.connInterval * CYBLE_SIM_US_PER_INTERVAL;
+    cyBle_connHandle.bdHandle = 0u;
+    cyBle_connHandle.attId = 0u;
+    cyBleSimState = CYBLE_STATE_CONNECTED;
+}
+
+
+/*******************************************************************************
+* Function Name: CyBleSim_SetRxHandler
+********************************************************************************
+*
+* Summary:
+*   Sets the function that receives the notifications and indications on
+*   the peer side.
+*
+* Parameters:
+*   func - the function or NULL.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void CyBleSim_SetRxHandler(CYBLE_SIM_RX_FUNC func)
+{
+    cyBleSimRx = func;
+}
+
+
+/*******************************************************************************
+* Function Name: CyBleSim_SetCnfHandler
+********************************************************************************
+*
+* Summary:
+*   Sets the function called when the peer confirms an indication, the
+*   service simulations report it as the event of their service.
+*
+* Parameters:
+*   func - the function or NULL.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void CyBleSim_SetCnfHandler(CYBLE_SIM_CNF_FUNC func)
+{
+    cyBleSimCnf = func;
+}
+
+
+/*******************************************************************************
+* Function Name: CyBleSim_Send
+********************************************************************************
+*
+* Summary:
+*   Queues a notification or an indication in a TX buffer. Used by the
+*   Send APIs of the service simulations.
+*
+* Parameters:
+*   connHandle - the connection handle.
+*   attrHandle - the attribute the value is sent for.
+*   length - the length of the value, up to the ATT MTU - 3.
+*   value - the value.
+*   isIndication - non-zero for an indication.
+*
+* Return:
+*   CYBLE_ERROR_OK - the value is queued.
+*   CYBLE_ERROR_INVALID_PARAMETER - no such connection or too long a value.
+*   CYBLE_ERROR_INVALID_OPERATION - the previous indication is not confirmed.
+*   CYBLE_ERROR_MEMORY_ALLOCATION_FAILED - all the TX buffers are taken.
+*
+*******************************************************************************/
+CYBLE_API_RESULT_T CyBleSim_Send(CYBLE_CONN_HANDLE_T connHandle, uint16 attrHandle, uint16 length,
+    const uint8 value[], uint8 isIndication)
+{
+    CYBLE_API_RESULT_T result = CYBLE_ERROR_OK;
+    CYBLE_SIM_TX_T *tx;
+
+    if((CYBLE_STATE_CONNECTED != cyBleSimState) || (connHandle.bdHandle != cyBle_connHandle.bdHandle) ||
+       ((length + CYBLE_SIM_ATT_HDR_SIZE) > cyBleSimCfg.attMtu))
+    {
+        result = CYBLE_ERROR_INVALID_PARAMETER;
+    }
+    else if((0u != isIndication) && (CYBLE_SIM_IND_NONE != cyBleSimInd))
+    {
+        result = CYBLE_ERROR_INVALID_OPERATION;
+    }
+    else if(cyBleSimTxCount >= cyBleSimCfg.txBufNum)
+    {
+        result = CYBLE_ERROR_MEMORY_ALLOCATION_FAILED;
+    }
+    else
+    {
+        tx = &cyBleSimTx[(cyBleSimTxHead + cyBleSimTxCount) % CYBLE_SIM_TX_BUF_MAX];
+        tx->attrHandle = attrHandle;
+        tx->length = length;
+        tx->remain = length + CYBLE_SIM_ATT_HDR_SIZE + CYBLE_SIM_L2CAP_HDR_SIZE;
+        tx->isIndication = isIndication;
+        (void)memcpy(tx->value, value, length);
+        cyBleSimTxCount++;
+
+        if(0u != isIndication)
+        {
+            cyBleSimInd = CYBLE_SIM_IND_QUEUED;
+            cyBleSimIndHandle = attrHandle;
+        }
+    }
+
+    if(CYBLE_ERROR_OK != result)
+    {
+        cyBleSimStat.rejected++;
+    }
+
+    return(result);
+}
+
+
+/*******************************************************************************
+* Function Name: CyBleSim_Run
+********************************************************************************
+*
+* Summary:
+*   Advances the simulated time, running the connection events on the way.
+*
+* Parameters:
+*   us - the time, us.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void CyBleSim_Run(uint32 us)
+{
+    uint64 end = cyBleSimTime + us;
+
+    while(cyBleSimEvtTime <= end)
+    {
+        CyBleSim_ConnEvent();
+    }
+    cyBleSimTime = end;
+}
+
+
+/*******************************************************************************
+* Function Name: CyBleSim_Flush
+********************************************************************************
+*
+* Summary:
+*   Runs the connection events until all the TX buffers are sent and the
+*   last indication is confirmed.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void CyBleSim_Flush(void)
+{
+    while((0u != cyBleSimTxCount) || (CYBLE_SIM_IND_NONE != cyBleSimInd))
+    {
+        CyBleSim_ConnEvent();
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: CyBleSim_Time
+********************************************************************************
+*
+* Summary:
+*   Returns the simulated time since CyBleSim_Start().
+*
+* Parameters:
+*   None
+*
+* Return:
+*   The simulated time, us.
+*
+*******************************************************************************/
+uint64 CyBleSim_Time(void)
+{
+    return(cyBleSimTime);
+}
+
+
+/*******************************************************************************
+* Function Name: CyBle_ProcessEvents
+********************************************************************************
+*
+* Summary:
+*   Runs the next connection event when the application is blocked on the
+*   stack, that is all the TX buffers are taken or an indication waits for
+*   its confirmation. Otherwise returns at once.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void CyBle_ProcessEvents(void)
+{
+    if((cyBleSimTxCount >= cyBleSimCfg.txBufNum) || (CYBLE_SIM_IND_NONE != cyBleSimInd))
+    {
+        CyBleSim_ConnEvent();
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: CyBle_GattGetBusyStatus
+********************************************************************************
+*
+* Summary:
+*   Returns the busy status of the stack.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   CYBLE_STACK_STATE_BUSY when all the TX buffers are taken, else
+*   CYBLE_STACK_STATE_FREE.
+*
+*******************************************************************************/
+uint8 CyBle_GattGetBusyStatus(void)
+{
+    return((cyBleSimTxCount >= cyBleSimCfg.txBufNum) ? CYBLE_STACK_STATE_BUSY : CYBLE_STACK_STATE_FREE);
+}
+
+
+/*******************************************************************************
+* Function Name: CyBle_GattGetMtuSize
+********************************************************************************
+*
+* Summary:
+*   Returns the exchanged ATT MTU of the simulated link.
+*
+* Parameters:
+*   mtu - returns the ATT MTU.
+*
+* Return:
+*   CYBLE_ERROR_OK, or CYBLE_ERROR_INVALID_PARAMETER for a NULL mtu.
+*
+*******************************************************************************/
+CYBLE_API_RESULT_T CyBle_GattGetMtuSize(uint16 *mtu)
+{
+    CYBLE_API_RESULT_T result = CYBLE_ERROR_OK;
+
+    if(NULL == mtu)
+    {
+        result = CYBLE_ERROR_INVALID_PARAMETER;
+    }
+    else
+    {
+        *mtu = cyBleSimCfg.attMtu;
+    }
+
+    return(result);
+}
+
+
+/*******************************************************************************
+* Function Name: CyBle_GattsNotification
+********************************************************************************
+*
+* Summary:
+*   Sends a notification of an attribute of the GATT database. The CCCD of
+*   the attribute is not checked, as with the stack.
+*
+* Parameters:
+*   connHandle - the connection handle.
+*   ntfParam - the handle and the value of the attribute.
+*
+* Return:
+*   The result of CyBleSim_Send().
+*
+*******************************************************************************/
+CYBLE_API_RESULT_T CyBle_GattsNotification(CYBLE_CONN_HANDLE_T connHandle, CYBLE_GATTS_HANDLE_VALUE_NTF_T *ntfParam)
+{
+    return(CyBleSim_Send(connHandle, ntfParam->attrHandle, ntfParam->value.len, ntfParam->value.val, 0u));
+}
+
+
+/*******************************************************************************
+* Function Name: CyBle_GetState
+********************************************************************************
+*
+* Summary:
+*   Returns the state of the stack.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   CYBLE_STATE_CONNECTED after CyBleSim_Start(), else CYBLE_STATE_STOPPED.
+*
+*******************************************************************************/
+CYBLE_STATE_T CyBle_GetState(void)
+{
+    return(cyBleSimState);
+}
+
+
+/*******************************************************************************
+* Function Name: CyBle_Set16ByPtr
+********************************************************************************
+*
+* Summary:
+*   Stores a 16-bit value in the little-endian order.
+*
+* Parameters:
+*   ptr - the destination.
+*   value - the value.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void CyBle_Set16ByPtr(uint8 ptr[], uint16 value)
+{
+    ptr[0u] = (uint8)value;
+    ptr[1u] = (uint8)(value >> 8u);
+}
+
+
+/*******************************************************************************
+* Function Name: CyBle_Get16ByPtr
+********************************************************************************
+*
+* Summary:
+*   Loads a 16-bit value stored in the little-endian order.
+*
+* Parameters:
+*   ptr - the source.
+*
+* Return:
+*   The value.
+*
+*******************************************************************************/
+uint16 CyBle_Get16ByPtr(const uint8 ptr[])
+{
+    return((uint16)((uint16)ptr[0u] | ((uint16)ptr[1u] << 8u)));
+}
+
+
+/*******************************************************************************
+* Function Name: CyEnterCriticalSection
+********************************************************************************
+*
+* Summary:
+*   The host build has no interrupts, so there is nothing to mask.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   The interrupt status to restore, always 0.
+*
+*******************************************************************************/
+uint8 CyEnterCriticalSection(void)
+{
+    return(0u);
+}
+
+
+/*******************************************************************************
+* Function Name: CyExitCriticalSection
+********************************************************************************
+*
+* Summary:
+*   Counterpart of CyEnterCriticalSection().
+*
+* Parameters:
+*   savedIntrStatus - the interrupt status to restore.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void CyExitCriticalSection(uint8 savedIntrStatus)
+{
+    (void)savedIntrStatus;
+}
+
+
+/*******************************************************************************
+* Function Name: CyDelay
+********************************************************************************
+*
+* Summary:
+*   Blocks for the time, the connection events go on meanwhile.
+*
+* Parameters:
+*   milliseconds - the time, ms.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void CyDelay(uint32 milliseconds)
+{
+    CyBleSim_Run(milliseconds * 1000u);
+}
+
+
+/*******************************************************************************
+* Function Name: CySysTick*
+********************************************************************************
+*
+* Summary:
+*   The SysTick down counter, the reload value and CySysTickClear() are
+*   honoured, the clock source and the interrupt are not simulated.
+*
+*******************************************************************************/
+void CySysTickStart(void)
+{
+    CySysTickClear();
+}
+
+void CySysTickStop(void)
+{
+}
+
+void CySysTickEnable(void)
+{
+}
+
+void CySysTickEnableInterrupt(void)
+{
+}
+
+void CySysTickDisableInterrupt(void)
+{
+}
+
+void CySysTickSetClockSource(uint32 clockSource)
+{
+    (void)clockSource;
+}
+
+void CySysTickSetReload(uint32 value)
+{
+    cyBleSimTickReload = value & CY_SYS_SYST_RVR_CNT_MASK;
+}
+
+void CySysTickClear(void)
+{
+    cyBleSimTickStart = CyBleSim_HostNs();
+}
+
+uint32 CySysTickGetValue(void)
+{
+    uint64 ticks = ((CyBleSim_HostNs() - cyBleSimTickStart) * (CYBLE_SIM_SYSCLK_HZ / 1000000u)) / 1000u;
+
+    return(cyBleSimTickReload - (uint32)(ticks % ((uint64)cyBleSimTickReload + 1u)));
+}
+
+
+/* [] END OF FILE */
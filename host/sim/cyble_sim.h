@@ -0,0 +1,223 @@
+/*******************************************************************************
+* File Name: cyble_sim.h
+*
+* Version 1.0
+*
+* Description:
+*  Contains the subset of the CyBle stack and cy_boot APIs that the profile
+*  code uses, implemented on the host by a deterministic simulation of one
+*  connection. The per-profile project.h files include this header and add
+*  the API of their service.
+*
+*  The simulated link has a connection interval, an exchanged ATT MTU and a
+*  number of stack TX buffers. A notification or an indication takes a TX
+*  buffer until all its LL packets have been sent, 27 bytes of L2CAP PDU
+*  each, in the connection events. A connection event sends the packets that
+*  fit in the interval, or no more than the configured number of packets.
+*  The simulated time only advances:
+*
+*   - in CyBle_ProcessEvents() when the application is blocked on the stack:
+*     all the TX buffers are taken or an indication waits for its
+*     confirmation, then the time jumps to the next connection event;
+*   - in CyBleSim_Run() that stands for the idle time of the application.
+*
+*  So the throughput measured is the one of the link, whatever the speed of
+*  the host. The API result values are not the ones of the stack library.
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(CYBLE_SIM_H)
+#define CYBLE_SIM_H
+
+#include <string.h>
+#include "cytypes.h"
+
+
+/***************************************
+*        Constants
+***************************************/
+#if !defined(CYBLE_GATT_MTU)
+    #define CYBLE_GATT_MTU                  (23u)       /* MtuSize of the BLE component */
+#endif /* !defined(CYBLE_GATT_MTU) */
+#define CYBLE_GATT_DEFAULT_MTU              (23u)
+
+#define CYBLE_CCCD_LEN                      (2u)
+#define CYBLE_CCCD_DEFAULT                  (0x0000u)
+#define CYBLE_CCCD_NOTIFICATION             (0x0001u)
+#define CYBLE_CCCD_INDICATION               (0x0002u)
+
+#define CYBLE_STACK_STATE_FREE              (0x00u)
+#define CYBLE_STACK_STATE_BUSY              (0x01u)
+
+#define CYBLE_SIM_TX_BUF_MAX                (16u)       /* Largest txBufNum */
+#define CYBLE_SIM_MTU_MAX                   (512u)      /* Largest attMtu */
+#define CYBLE_SIM_LL_PAYLOAD                (27u)       /* LL data payload, no Data Length Extension */
+#define CYBLE_SIM_SYSCLK_HZ                 (48000000u) /* Clock of the SysTick counter */
+
+/* SysTick */
+#define CY_SYS_SYST_CSR_CLK_SRC_SYSCLK      (1u)
+#define CY_SYS_SYST_CSR_CLK_SRC_LFCLK       (0u)
+#define CY_SYS_SYST_RVR_CNT_MASK            (0x00FFFFFFu)
+#define CY_SYS_SYST_CVR_CNT_MASK            (0x00FFFFFFu)
+
+
+/***************************************
+*        Data Struct Definition
+***************************************/
+typedef enum
+{
+    CYBLE_ERROR_OK = 0u,
+    CYBLE_ERROR_INVALID_PARAMETER,
+    CYBLE_ERROR_INVALID_OPERATION,
+    CYBLE_ERROR_MEMORY_ALLOCATION_FAILED,
+    CYBLE_ERROR_INSUFFICIENT_RESOURCES,
+    CYBLE_ERROR_NO_CONNECTION,
+    CYBLE_ERROR_NO_DEVICE_ENTITY,
+    CYBLE_ERROR_INVALID_STATE,
+    CYBLE_ERROR_STACK_BUSY,
+    CYBLE_ERROR_GATT_DB_INVALID_ATTR_HANDLE,
+    CYBLE_ERROR_NTF_DISABLED,
+    CYBLE_ERROR_IND_DISABLED,
+    CYBLE_ERROR_CHAR_IS_NOT_DISCOVERED,
+    CYBLE_ERROR_FLASH_WRITE,
+    CYBLE_ERROR_MAX
+} CYBLE_API_RESULT_T;
+
+typedef enum
+{
+    CYBLE_STATE_STOPPED,
+    CYBLE_STATE_INITIALIZING,
+    CYBLE_STATE_CONNECTED,
+    CYBLE_STATE_ADVERTISING,
+    CYBLE_STATE_SCANNING,
+    CYBLE_STATE_CONNECTING,
+    CYBLE_STATE_DISCONNECTED
+} CYBLE_STATE_T;
+
+typedef struct
+{
+    uint8 bdHandle;             /* Peer device handle */
+    uint8 attId;                /* ATT instance */
+} CYBLE_CONN_HANDLE_T;
+
+typedef void (*CYBLE_CALLBACK_T)(uint32 eventCode, void *eventParam);
+
+typedef struct
+{
+    uint8  *val;                /* Attribute value */
+    uint16 len;                 /* Length of the value */
+    uint16 actualLen;           /* Length of the attribute */
+} CYBLE_GATT_VALUE_T;
+
+typedef struct
+{
+    CYBLE_GATT_VALUE_T value;   /* Attribute value */
+    uint16 attrHandle;          /* Attribute handle */
+} CYBLE_GATT_HANDLE_VALUE_PAIR_T;
+
+typedef CYBLE_GATT_HANDLE_VALUE_PAIR_T CYBLE_GATTS_HANDLE_VALUE_NTF_T;
+
+/* ATT error codes and the ones of the services the profiles use */
+typedef enum
+{
+    CYBLE_GATT_ERR_NONE = 0x00u,
+    CYBLE_GATT_ERR_INVALID_HANDLE = 0x01u,
+    CYBLE_GATT_ERR_READ_NOT_PERMITTED = 0x02u,
+    CYBLE_GATT_ERR_WRITE_NOT_PERMITTED = 0x03u,
+    CYBLE_GATT_ERR_INVALID_PDU = 0x04u,
+    CYBLE_GATT_ERR_REQUEST_NOT_SUPPORTED = 0x06u,
+    CYBLE_GATT_ERR_INVALID_OFFSET = 0x07u,
+    CYBLE_GATT_ERR_INVALID_ATTRIBUTE_LEN = 0x0Du,
+    CYBLE_GATT_ERR_UNLIKELY_ERROR = 0x0Eu,
+    CYBLE_GATT_ERR_MISSING_CRC = 0x80u,
+    CYBLE_GATT_ERR_INVALID_CRC = 0x81u,
+    CYBLE_GATT_ERR_CCCD_IMPROPERLY_CONFIGURED = 0xFDu,
+    CYBLE_GATT_ERR_PROCEDURE_ALREADY_IN_PROGRESS = 0xFEu,
+    CYBLE_GATT_ERR_OUT_OF_RANGE = 0xFFu
+} CYBLE_GATT_ERR_CODE_T;
+
+/* Configuration of the simulated link */
+typedef struct
+{
+    uint16 connInterval;        /* Connection interval, 1.25 ms units */
+    uint16 attMtu;              /* Exchanged ATT MTU, up to CYBLE_SIM_MTU_MAX */
+    uint8  txBufNum;            /* Stack TX buffers, up to CYBLE_SIM_TX_BUF_MAX */
+    uint8  pktPerEvt;           /* LL packets of a connection event, 0 - as many as fit */
+} CYBLE_SIM_CFG_T;
+
+/* Counters of the simulated link */
+typedef struct
+{
+    uint32 ntfCount;            /* Notifications delivered to the peer */
+    uint32 indCount;            /* Indications delivered to the peer */
+    uint32 attBytes;            /* Attribute value bytes delivered */
+    uint32 llPackets;           /* LL data packets sent */
+    uint32 connEvents;          /* Connection events */
+    uint32 rejected;            /* Send API calls that returned an error */
+} CYBLE_SIM_STAT_T;
+
+/* Called for every notification or indication the peer receives */
+typedef void (*CYBLE_SIM_RX_FUNC)(uint16 attrHandle, uint16 length, const uint8 value[], uint8 isIndication);
+
+/* Called when the peer confirms an indication */
+typedef void (*CYBLE_SIM_CNF_FUNC)(uint16 attrHandle);
+
+
+/***************************************
+*      Stack API Function Prototypes
+***************************************/
+void CyBle_ProcessEvents(void);
+uint8 CyBle_GattGetBusyStatus(void);
+CYBLE_API_RESULT_T CyBle_GattGetMtuSize(uint16 *mtu);
+CYBLE_API_RESULT_T CyBle_GattsNotification(CYBLE_CONN_HANDLE_T connHandle, CYBLE_GATTS_HANDLE_VALUE_NTF_T *ntfParam);
+CYBLE_STATE_T CyBle_GetState(void);
+void CyBle_Set16ByPtr(uint8 ptr[], uint16 value);
+uint16 CyBle_Get16ByPtr(const uint8 ptr[]);
+
+
+/***************************************
+*      cy_boot API Function Prototypes
+***************************************/
+uint8 CyEnterCriticalSection(void);
+void CyExitCriticalSection(uint8 savedIntrStatus);
+void CyDelay(uint32 milliseconds);
+void CySysTickStart(void);
+void CySysTickStop(void);
+void CySysTickEnable(void);
+void CySysTickEnableInterrupt(void);
+void CySysTickDisableInterrupt(void);
+void CySysTickSetClockSource(uint32 clockSource);
+void CySysTickSetReload(uint32 value);
+uint32 CySysTickGetValue(void);
+void CySysTickClear(void);
+
+
+/***************************************
+*      Simulation API Function Prototypes
+***************************************/
+void CyBleSim_Start(const CYBLE_SIM_CFG_T *cfg);
+void CyBleSim_SetRxHandler(CYBLE_SIM_RX_FUNC func);
+void CyBleSim_SetCnfHandler(CYBLE_SIM_CNF_FUNC func);
+CYBLE_API_RESULT_T CyBleSim_Send(CYBLE_CONN_HANDLE_T connHandle, uint16 attrHandle, uint16 length,
+    const uint8 value[], uint8 isIndication);
+void CyBleSim_Run(uint32 us);
+void CyBleSim_Flush(void);
+uint64 CyBleSim_Time(void);
+
+
+/***************************************
+*      External data references
+***************************************/
+extern CYBLE_CONN_HANDLE_T cyBle_connHandle;
+extern CYBLE_SIM_CFG_T cyBleSimCfg;
+extern CYBLE_SIM_STAT_T cyBleSimStat;
+
+
+#endif /* CYBLE_SIM_H */
+
+/* [] END OF FILE */
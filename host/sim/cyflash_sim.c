@@ -0,0 +1,238 @@
+/*******************************************************************************
+* File Name: cyflash_sim.c
+*
+* Version 1.0
+*
+* Description:
+*  This file contains the simulated flash of the host build, see
+*  cyflash_sim.h. The programmed rows are kept in a table searched by the
+*  row number, the rows of a test are few.
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <string.h>
+#include "cyflash_sim.h"
+
+
+/***************************************
+*        Constants
+***************************************/
+#define CYFLASH_SIM_NO_INTERRUPT            (0xFFFFFFFFu)
+
+
+/***************************************
+*        Data Struct Definition
+***************************************/
+typedef struct
+{
+    uint32 rowNum;
+    uint32 writes;              /* Number of programming cycles of the row */
+    uint8  data[CY_FLASH_SIZEOF_ROW];
+} CYFLASH_SIM_ROW_T;
+
+
+static CYFLASH_SIM_ROW_T cyFlashSimRows[CYFLASH_SIM_ROWS_MAX];
+static uint32 cyFlashSimRowNum;                     /* Rows of the table */
+static uint32 cyFlashSimInterrupt = CYFLASH_SIM_NO_INTERRUPT;
+
+
+/*******************************************************************************
+* Function Name: CyFlashSim_Find
+********************************************************************************
+*
+* Summary:
+*   Finds a programmed row.
+*
+* Parameters:
+*   rowNum - the row number.
+*
+* Return:
+*   The row or NULL if the row was never programmed.
+*
+*******************************************************************************/
+static CYFLASH_SIM_ROW_T *CyFlashSim_Find(uint32 rowNum)
+{
+    CYFLASH_SIM_ROW_T *row = NULL;
+    uint32 n;
+
+    for(n = 0u; (n < cyFlashSimRowNum) && (NULL == row); n++)
+    {
+        if(rowNum == cyFlashSimRows[n].rowNum)
+        {
+            row = &cyFlashSimRows[n];
+        }
+    }
+
+    return(row);
+}
+
+
+/*******************************************************************************
+* Function Name: CySysFlashWriteRow
+********************************************************************************
+*
+* Summary:
+*   Erases and programs a flash row. An interrupted write leaves the row
+*   erased and fails.
+*
+* Parameters:
+*   rowNum  - the row number.
+*   rowData - CY_FLASH_SIZEOF_ROW bytes to program.
+*
+* Return:
+*   CY_SYS_FLASH_SUCCESS, CY_SYS_FLASH_INVALID_ADDR when the simulation has
+*   no free row or CY_SYS_FLASH_PROTECTED when the write was interrupted.
+*
+*******************************************************************************/
+cystatus CySysFlashWriteRow(uint32 rowNum, const uint8 rowData[])
+{
+    CYFLASH_SIM_ROW_T *row = CyFlashSim_Find(rowNum);
+    cystatus status = CY_SYS_FLASH_SUCCESS;
+
+    if((NULL == row) && (cyFlashSimRowNum < CYFLASH_SIM_ROWS_MAX))
+    {
+        row = &cyFlashSimRows[cyFlashSimRowNum];
+        row->rowNum = rowNum;
+        row->writes = 0u;
+        cyFlashSimRowNum++;
+    }
+
+    if(NULL == row)
+    {
+        status = CY_SYS_FLASH_INVALID_ADDR;
+    }
+    else if(0u == cyFlashSimInterrupt)
+    {
+        (void)memset(row->data, 0, CY_FLASH_SIZEOF_ROW);
+        row->writes++;
+        cyFlashSimInterrupt = CYFLASH_SIM_NO_INTERRUPT;
+        status = CY_SYS_FLASH_PROTECTED;
+    }
+    else
+    {
+        (void)memcpy(row->data, rowData, CY_FLASH_SIZEOF_ROW);
+        row->writes++;
+        if(CYFLASH_SIM_NO_INTERRUPT != cyFlashSimInterrupt)
+        {
+            cyFlashSimInterrupt--;
+        }
+    }
+
+    return(status);
+}
+
+
+/*******************************************************************************
+* Function Name: CyFlashSim_Read8
+********************************************************************************
+*
+* Summary:
+*   Reads a byte of the flash.
+*
+* Parameters:
+*   addr - the flash address.
+*
+* Return:
+*   The byte, zero if the row was never programmed.
+*
+*******************************************************************************/
+uint8 CyFlashSim_Read8(uint32 addr)
+{
+    const CYFLASH_SIM_ROW_T *row = CyFlashSim_Find((addr - CYDEV_FLASH_BASE) / CY_FLASH_SIZEOF_ROW);
+
+    return((NULL == row) ? 0u : row->data[addr % CY_FLASH_SIZEOF_ROW]);
+}
+
+
+/*******************************************************************************
+* Function Name: CyFlashSim_Row
+********************************************************************************
+*
+* Summary:
+*   Returns the contents of a flash row.
+*
+* Parameters:
+*   rowNum - the row number.
+*
+* Return:
+*   CY_FLASH_SIZEOF_ROW bytes or NULL if the row was never programmed.
+*
+*******************************************************************************/
+const uint8 *CyFlashSim_Row(uint32 rowNum)
+{
+    const CYFLASH_SIM_ROW_T *row = CyFlashSim_Find(rowNum);
+
+    return((NULL == row) ? NULL : row->data);
+}
+
+
+/*******************************************************************************
+* Function Name: CyFlashSim_RowWrites
+********************************************************************************
+*
+* Summary:
+*   Returns the number of programming cycles of a flash row.
+*
+* Parameters:
+*   rowNum - the row number.
+*
+* Return:
+*   The number of writes.
+*
+*******************************************************************************/
+uint32 CyFlashSim_RowWrites(uint32 rowNum)
+{
+    const CYFLASH_SIM_ROW_T *row = CyFlashSim_Find(rowNum);
+
+    return((NULL == row) ? 0u : row->writes);
+}
+
+
+/*******************************************************************************
+* Function Name: CyFlashSim_Interrupt
+********************************************************************************
+*
+* Summary:
+*   Interrupts a future row write as a power loss does: the row is left
+*   erased and CySysFlashWriteRow() fails.
+*
+* Parameters:
+*   writes - the number of writes that complete before the interrupted one.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void CyFlashSim_Interrupt(uint32 writes)
+{
+    cyFlashSimInterrupt = writes;
+}
+
+
+/*******************************************************************************
+* Function Name: CyFlashSim_Erase
+********************************************************************************
+*
+* Summary:
+*   Erases the whole flash and clears the write counters.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void CyFlashSim_Erase(void)
+{
+    cyFlashSimRowNum = 0u;
+    cyFlashSimInterrupt = CYFLASH_SIM_NO_INTERRUPT;
+}
+
+
+/* [] END OF FILE */
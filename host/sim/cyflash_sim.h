@@ -0,0 +1,72 @@
+/*******************************************************************************
+* File Name: cyflash_sim.h
+*
+* Version 1.0
+*
+* Description:
+*  Contains the cy_boot flash API of the host build, implemented by a
+*  simulated flash that keeps the image of every programmed row. The
+*  simulation API lets a test check the programmed contents, count the
+*  writes of every row and interrupt a row write as a power loss does.
+*
+*  The firmware addresses the flash by the 32-bit address of a flash array,
+*  CY_GET_XTND_REG8() reads and CySysFlashWriteRow() programs it. On the host
+*  the address is the truncated address of the array, it is only used to
+*  compute the row number and is never dereferenced. A row that was never
+*  programmed reads as zeros, the initial value of the flash arrays of the
+*  firmware.
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(CYFLASH_SIM_H)
+#define CYFLASH_SIM_H
+
+#include "cytypes.h"
+
+
+/***************************************
+*        Constants
+***************************************/
+#define CY_FLASH_SIZEOF_ROW                 (128u)
+#define CYDEV_FLASH_BASE                    (0x00000000u)
+
+#define CY_SYS_FLASH_SUCCESS                (0x00u)
+#define CY_SYS_FLASH_INVALID_ADDR           (0x04u)
+#define CY_SYS_FLASH_PROTECTED              (0x05u)
+
+#define CYFLASH_SIM_ROWS_MAX                (512u)      /* Rows the simulation can hold */
+
+/* Alignment of the flash arrays of the BLE component */
+#define CYBLE_FLASH_ROW_ALIGNED             CY_ALIGN(CY_FLASH_SIZEOF_ROW)
+
+
+/***************************************
+*        Macros
+***************************************/
+#define CY_GET_XTND_REG8(addr)              CyFlashSim_Read8((uint32)(addr))
+
+
+/***************************************
+*      cy_boot API Function Prototypes
+***************************************/
+cystatus CySysFlashWriteRow(uint32 rowNum, const uint8 rowData[]);
+
+
+/***************************************
+*      Simulation API Function Prototypes
+***************************************/
+uint8 CyFlashSim_Read8(uint32 addr);
+const uint8 *CyFlashSim_Row(uint32 rowNum);
+uint32 CyFlashSim_RowWrites(uint32 rowNum);
+void CyFlashSim_Interrupt(uint32 writes);
+void CyFlashSim_Erase(void);
+
+
+#endif /* CYFLASH_SIM_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,87 @@
+/*******************************************************************************
+* File Name: cytypes.h
+*
+* Version 1.0
+*
+* Description:
+*  Host replacement of the cy_boot cytypes.h: the base types of the PSoC
+*  Creator projects mapped to the fixed width types of the host compiler.
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(CY_BOOT_CYTYPES_H)
+#define CY_BOOT_CYTYPES_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+
+/***************************************
+*        Base Types
+***************************************/
+typedef uint8_t     uint8;
+typedef uint16_t    uint16;
+typedef uint32_t    uint32;
+typedef uint64_t    uint64;
+typedef int8_t      int8;
+typedef int16_t     int16;
+typedef int32_t     int32;
+typedef int64_t     int64;
+typedef float       float32;
+typedef double      float64;
+
+typedef volatile uint8  reg8;
+typedef volatile uint16 reg16;
+typedef volatile uint32 reg32;
+
+typedef uint32      cystatus;
+
+
+/***************************************
+*        Return Codes
+***************************************/
+#define CYRET_SUCCESS               (0x00u)     /* Successful */
+#define CYRET_BAD_PARAM             (0x01u)     /* One or more invalid parameters */
+#define CYRET_INVALID_OBJECT        (0x02u)     /* Invalid object specified */
+#define CYRET_MEMORY                (0x03u)     /* Memory related failure */
+#define CYRET_LOCKED                (0x04u)     /* Resource lock failure */
+#define CYRET_EMPTY                 (0x05u)     /* No more objects available */
+#define CYRET_BAD_DATA              (0x06u)     /* Bad data received (CRC or other error check) */
+#define CYRET_STARTED               (0x07u)     /* Operation started, but not necessarily completed yet */
+#define CYRET_FINISHED              (0x08u)     /* Operation completed */
+#define CYRET_CANCELED              (0x09u)     /* Operation canceled */
+#define CYRET_TIMEOUT               (0x10u)     /* Operation timed out */
+#define CYRET_INVALID_STATE         (0x11u)     /* Operation not setup or is in an improper state */
+#define CYRET_UNKNOWN               ((cystatus) 0xFFFFFFFFu)    /* Unknown failure */
+
+
+/***************************************
+*        Byte Access Macros
+***************************************/
+#define LO8(x)                      ((uint8) ((x) & 0xFFu))
+#define HI8(x)                      ((uint8) ((uint16)(x) >> 8))
+#define LO16(x)                     ((uint16) ((x) & 0xFFFFu))
+#define HI16(x)                     ((uint16) ((uint32)(x) >> 16))
+
+
+/***************************************
+*        Compiler Keywords
+***************************************/
+#define CY_INLINE                   inline
+#define CY_NOINIT
+#define CY_SECTION(name)
+#define CY_ALIGN(align)             __attribute__ ((aligned(align)))
+#define CYREENTRANT
+#define CYCODE
+#define CYDATA
+#define CYXDATA
+
+
+#endif /* CY_BOOT_CYTYPES_H */
+
+/* [] END OF FILE */
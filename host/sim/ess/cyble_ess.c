@@ -0,0 +1,713 @@
+/*******************************************************************************
+* File Name: cyble_ess.c
+*
+* Version 1.0
+*
+* Description:
+*  This file contains the simulated Environmental Sensing Service server API
+*  and the GATT database calls of the ESS History service of the host build.
+*  The characteristic values, the descriptors and the CCCDs are kept in RAM,
+*  the notifications and indications go to the simulated link.
+*
+*  The descriptors of the database stand for the ones of TopDesign.cysch,
+*  which is not readable on the host:
+*
+*   - True Wind Speed #1: instantaneous, measurement period and update
+*     interval of 15 s, notified when changed or every 30 s at most, OR;
+*   - True Wind Speed #2: the same triggers with 20 s, AND;
+*   - Humidity: the maximum of 20 s, updated every 10 s, the triggers of
+*     True Wind Speed #1.
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <project.h>
+
+
+/***************************************
+*        Data Struct Definition
+***************************************/
+typedef struct
+{
+    CYBLE_ESS_CHAR_INDEX_T charIndex;
+    uint8 charInstance;
+    uint8 value[CYBLE_ESS_2BYTES_LENGTH];
+    uint16 cccd;
+    uint8 measurement[CYBLE_ESS_MEASUREMENT_LENGTH];
+    uint8 trigger[CYBLE_ESS_TRIGGER_NUM][CYBLE_ESS_TRIGGER_VALUE_MAX];
+    uint8 triggerLength[CYBLE_ESS_TRIGGER_NUM];     /* 0 - the descriptor is absent */
+    uint8 config;
+} CYBLE_SIM_ESS_CHAR_T;
+
+
+/* The characteristic instances, in the order of the sensors of ess.c. The
+*  ES Measurement is the flags, the sampling function, the measurement period,
+*  the update interval, the application and the uncertainty.
+*/
+static CYBLE_SIM_ESS_CHAR_T cyBleEsssChar[CYBLE_SIM_ESS_CHAR_NUM] =
+{
+    {CYBLE_ESS_TRUE_WIND_SPEED, 0u, {0u, 0u}, CYBLE_CCCD_DEFAULT,
+        {0x00u, 0x00u, 0x01u, 15u, 0x00u, 0x00u, 15u, 0x00u, 0x00u, 0x00u, 0xFFu},
+        {{CYBLE_ESS_TRIG_NO_LESS_THEN_TIME_INTERVAL, 30u, 0x00u, 0x00u}, {CYBLE_ESS_TRIG_WHEN_CHANGED}, {0u}},
+        {4u, 1u, 0u}, CYBLE_ESS_CONF_BOOLEAN_OR},
+    {CYBLE_ESS_TRUE_WIND_SPEED, 1u, {0u, 0u}, CYBLE_CCCD_DEFAULT,
+        {0x00u, 0x00u, 0x01u, 20u, 0x00u, 0x00u, 20u, 0x00u, 0x00u, 0x00u, 0xFFu},
+        {{CYBLE_ESS_TRIG_NO_LESS_THEN_TIME_INTERVAL, 30u, 0x00u, 0x00u}, {CYBLE_ESS_TRIG_WHEN_CHANGED}, {0u}},
+        {4u, 1u, 0u}, CYBLE_ESS_CONF_BOOLEAN_AND},
+    {CYBLE_ESS_HUMIDITY, 0u, {0u, 0u}, CYBLE_CCCD_DEFAULT,
+        {0x00u, 0x00u, 0x04u, 20u, 0x00u, 0x00u, 10u, 0x00u, 0x00u, 0x00u, 0xFFu},
+        {{CYBLE_ESS_TRIG_NO_LESS_THEN_TIME_INTERVAL, 30u, 0x00u, 0x00u}, {CYBLE_ESS_TRIG_WHEN_CHANGED}, {0u}},
+        {4u, 1u, 0u}, CYBLE_ESS_CONF_BOOLEAN_OR},
+};
+
+static CYBLE_CALLBACK_T cyBleEssCallback;
+static uint16 cyBleEsssDvcCccd;
+static uint16 cyBleEsssChangeIndex;
+static uint16 cyBleEssHistCccd;
+static uint8 cyBleEssHistValue[CYBLE_SIM_ESS_HIST_VALUE_MAX];
+static uint16 cyBleSimGattsRsp = CYBLE_SIM_GATTS_NO_RSP;
+
+
+/*******************************************************************************
+* Function Name: CyBle_EsssFind
+********************************************************************************
+*
+* Summary:
+*   Finds a characteristic instance in the GATT database.
+*
+* Parameters:
+*   charIndex - the characteristic.
+*   charInstance - the instance of the characteristic.
+*
+* Return:
+*   The number of the instance in the database, CYBLE_SIM_ESS_CHAR_NUM when
+*   the database does not have it.
+*
+*******************************************************************************/
+static uint8 CyBle_EsssFind(CYBLE_ESS_CHAR_INDEX_T charIndex, uint8 charInstance)
+{
+    uint8 charNum = 0u;
+
+    while((charNum < CYBLE_SIM_ESS_CHAR_NUM) && ((cyBleEsssChar[charNum].charIndex != charIndex) ||
+          (cyBleEsssChar[charNum].charInstance != charInstance)))
+    {
+        charNum++;
+    }
+
+    return(charNum);
+}
+
+
+/*******************************************************************************
+* Function Name: CyBle_EsssConfirm
+********************************************************************************
+*
+* Summary:
+*   Reports the confirmation of a Descriptor Value Changed indication.
+*
+* Parameters:
+*   attrHandle - the attribute of the indication.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+static void CyBle_EsssConfirm(uint16 attrHandle)
+{
+    CYBLE_ESS_CHAR_VALUE_T param;
+
+    if((NULL != cyBleEssCallback) && (CYBLE_SIM_ESS_DVC_HANDLE == attrHandle))
+    {
+        param.connHandle = cyBle_connHandle;
+        param.charIndex = CYBLE_ESS_DESCRIPTOR_VALUE_CHANGED;
+        param.charInstance = 0u;
+        param.value = NULL;
+        param.gattErrorCode = CYBLE_GATT_ERR_NONE;
+        cyBleEssCallback((uint32)CYBLE_EVT_ESSS_INDICATION_CONFIRMATION, &param);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: CyBle_EssRegisterAttrCallback
+********************************************************************************
+*
+* Summary:
+*   Registers the callback of the Environmental Sensing Service events.
+*
+* Parameters:
+*   callbackFunc - the callback.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void CyBle_EssRegisterAttrCallback(CYBLE_CALLBACK_T callbackFunc)
+{
+    cyBleEssCallback = callbackFunc;
+    CyBleSim_SetCnfHandler(&CyBle_EsssConfirm);
+}
+
+
+/*******************************************************************************
+* Function Name: CyBle_EsssSetCharacteristicValue
+********************************************************************************
+*
+* Summary:
+*   Sets the value of a characteristic instance in the GATT database.
+*
+* Parameters:
+*   charIndex - the characteristic.
+*   charInstance - the instance of the characteristic.
+*   attrSize - the size of the value.
+*   attrValue - the value.
+*
+* Return:
+*   CYBLE_ERROR_INVALID_PARAMETER for an instance not in the database or too
+*   long a value, else CYBLE_ERROR_OK.
+*
+*******************************************************************************/
+CYBLE_API_RESULT_T CyBle_EsssSetCharacteristicValue(CYBLE_ESS_CHAR_INDEX_T charIndex, uint8 charInstance,
+    uint8 attrSize, uint8 *attrValue)
+{
+    CYBLE_API_RESULT_T result = CYBLE_ERROR_OK;
+    uint8 charNum = CyBle_EsssFind(charIndex, charInstance);
+
+    if((CYBLE_SIM_ESS_CHAR_NUM == charNum) || (attrSize > CYBLE_ESS_2BYTES_LENGTH))
+    {
+        result = CYBLE_ERROR_INVALID_PARAMETER;
+    }
+    else
+    {
+        (void)memcpy(cyBleEsssChar[charNum].value, attrValue, attrSize);
+    }
+
+    return(result);
+}
+
+
+/*******************************************************************************
+* Function Name: CyBle_EsssGetCharacteristicDescriptor
+********************************************************************************
+*
+* Summary:
+*   Reads a descriptor of a characteristic instance from the GATT database.
+*   An ES Trigger Setting value shorter than attrSize is padded with zeros.
+*
+* Parameters:
+*   charIndex - the characteristic.
+*   charInstance - the instance of the characteristic.
+*   descrIndex - the descriptor.
+*   attrSize - the size of the value.
+*   attrValue - returns the value.
+*
+* Return:
+*   CYBLE_ERROR_GATT_DB_INVALID_ATTR_HANDLE for an absent ES Trigger Setting,
+*   CYBLE_ERROR_INVALID_PARAMETER for another descriptor not in the database
+*   or too long a value, else CYBLE_ERROR_OK.
+*
+*******************************************************************************/
+CYBLE_API_RESULT_T CyBle_EsssGetCharacteristicDescriptor(CYBLE_ESS_CHAR_INDEX_T charIndex, uint8 charInstance,
+    CYBLE_ESS_DESCR_INDEX_T descrIndex, uint8 attrSize, uint8 *attrValue)
+{
+    CYBLE_API_RESULT_T result = CYBLE_ERROR_INVALID_PARAMETER;
+    uint8 charNum = CyBle_EsssFind(charIndex, charInstance);
+    CYBLE_SIM_ESS_CHAR_T *essChar = &cyBleEsssChar[charNum];
+    uint8 trigger;
+
+    if(CYBLE_SIM_ESS_CHAR_NUM == charNum)
+    {
+        /* Not in the database */
+    }
+    else if(CYBLE_ESS_ES_MEASUREMENT_DESCR == descrIndex)
+    {
+        if(attrSize <= CYBLE_ESS_MEASUREMENT_LENGTH)
+        {
+            (void)memcpy(attrValue, essChar->measurement, attrSize);
+            result = CYBLE_ERROR_OK;
+        }
+    }
+    else if((descrIndex >= CYBLE_ESS_ES_TRIGGER_SETTINGS_DESCR1) && (descrIndex <= CYBLE_ESS_ES_TRIGGER_SETTINGS_DESCR3))
+    {
+        trigger = (uint8)(descrIndex - CYBLE_ESS_ES_TRIGGER_SETTINGS_DESCR1);
+        if(0u == essChar->triggerLength[trigger])
+        {
+            result = CYBLE_ERROR_GATT_DB_INVALID_ATTR_HANDLE;
+        }
+        else if(attrSize <= CYBLE_ESS_TRIGGER_VALUE_MAX)
+        {
+            (void)memcpy(attrValue, essChar->trigger[trigger], attrSize);
+            result = CYBLE_ERROR_OK;
+        }
+        else
+        {
+            /* Too long a value */
+        }
+    }
+    else if((CYBLE_ESS_ES_CONFIG_DESCR == descrIndex) && (1u == attrSize))
+    {
+        *attrValue = essChar->config;
+        result = CYBLE_ERROR_OK;
+    }
+    else
+    {
+        /* Not in the database */
+    }
+
+    return(result);
+}
+
+
+/*******************************************************************************
+* Function Name: CyBle_EsssSetCharacteristicDescriptor
+********************************************************************************
+*
+* Summary:
+*   Sets an ES Trigger Setting or the ES Configuration of a characteristic
+*   instance in the GATT database.
+*
+* Parameters:
+*   charIndex - the characteristic.
+*   charInstance - the instance of the characteristic.
+*   descrIndex - the descriptor.
+*   attrSize - the size of the value.
+*   attrValue - the value.
+*
+* Return:
+*   CYBLE_ERROR_INVALID_PARAMETER for a descriptor not in the database or
+*   too long a value, else CYBLE_ERROR_OK.
+*
+*******************************************************************************/
+CYBLE_API_RESULT_T CyBle_EsssSetCharacteristicDescriptor(CYBLE_ESS_CHAR_INDEX_T charIndex, uint8 charInstance,
+    CYBLE_ESS_DESCR_INDEX_T descrIndex, uint8 attrSize, uint8 *attrValue)
+{
+    CYBLE_API_RESULT_T result = CYBLE_ERROR_INVALID_PARAMETER;
+    uint8 charNum = CyBle_EsssFind(charIndex, charInstance);
+    CYBLE_SIM_ESS_CHAR_T *essChar = &cyBleEsssChar[charNum];
+    uint8 trigger;
+
+    if(CYBLE_SIM_ESS_CHAR_NUM == charNum)
+    {
+        /* Not in the database */
+    }
+    else if((descrIndex >= CYBLE_ESS_ES_TRIGGER_SETTINGS_DESCR1) && (descrIndex <= CYBLE_ESS_ES_TRIGGER_SETTINGS_DESCR3))
+    {
+        trigger = (uint8)(descrIndex - CYBLE_ESS_ES_TRIGGER_SETTINGS_DESCR1);
+        if((0u != essChar->triggerLength[trigger]) && (0u != attrSize) && (attrSize <= CYBLE_ESS_TRIGGER_VALUE_MAX))
+        {
+            (void)memset(essChar->trigger[trigger], 0, CYBLE_ESS_TRIGGER_VALUE_MAX);
+            (void)memcpy(essChar->trigger[trigger], attrValue, attrSize);
+            essChar->triggerLength[trigger] = attrSize;
+            result = CYBLE_ERROR_OK;
+        }
+    }
+    else if((CYBLE_ESS_ES_CONFIG_DESCR == descrIndex) && (1u == attrSize))
+    {
+        essChar->config = *attrValue;
+        result = CYBLE_ERROR_OK;
+    }
+    else
+    {
+        /* Not in the database */
+    }
+
+    return(result);
+}
+
+
+/*******************************************************************************
+* Function Name: CyBle_EsssSetChangeIndex
+********************************************************************************
+*
+* Summary:
+*   Sets the Change Index of the Service Data AD field.
+*
+* Parameters:
+*   essChangeIndex - the Change Index.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void CyBle_EsssSetChangeIndex(uint16 essChangeIndex)
+{
+    cyBleEsssChangeIndex = essChangeIndex;
+}
+
+
+/*******************************************************************************
+* Function Name: CyBle_EsssSendNotification
+********************************************************************************
+*
+* Summary:
+*   Sends a notification of a characteristic instance.
+*
+* Parameters:
+*   connHandle - the connection handle.
+*   charIndex - the characteristic.
+*   charInstance - the instance of the characteristic.
+*   attrSize - the size of the value.
+*   attrValue - the value.
+*
+* Return:
+*   CYBLE_ERROR_INVALID_PARAMETER for an instance not in the database,
+*   CYBLE_ERROR_NTF_DISABLED when the client has not enabled the
+*   notifications, else the result of CyBleSim_Send().
+*
+*******************************************************************************/
+CYBLE_API_RESULT_T CyBle_EsssSendNotification(CYBLE_CONN_HANDLE_T connHandle, CYBLE_ESS_CHAR_INDEX_T charIndex,
+    uint8 charInstance, uint8 attrSize, uint8 *attrValue)
+{
+    CYBLE_API_RESULT_T result;
+    uint8 charNum = CyBle_EsssFind(charIndex, charInstance);
+
+    if(CYBLE_SIM_ESS_CHAR_NUM == charNum)
+    {
+        result = CYBLE_ERROR_INVALID_PARAMETER;
+    }
+    else if(0u == (cyBleEsssChar[charNum].cccd & CYBLE_CCCD_NOTIFICATION))
+    {
+        result = CYBLE_ERROR_NTF_DISABLED;
+    }
+    else
+    {
+        result = CyBleSim_Send(connHandle, CYBLE_SIM_ESS_HANDLE(charNum), attrSize, attrValue, 0u);
+    }
+
+    return(result);
+}
+
+
+/*******************************************************************************
+* Function Name: CyBle_EsssSendIndication
+********************************************************************************
+*
+* Summary:
+*   Sends a Descriptor Value Changed indication.
+*
+* Parameters:
+*   connHandle - the connection handle.
+*   charIndex - the characteristic.
+*   charInstance - the instance of the characteristic.
+*   attrSize - the size of the value.
+*   attrValue - the value.
+*
+* Return:
+*   CYBLE_ERROR_IND_DISABLED when the client has not enabled the
+*   indications, else the result of CyBleSim_Send().
+*
+*******************************************************************************/
+CYBLE_API_RESULT_T CyBle_EsssSendIndication(CYBLE_CONN_HANDLE_T connHandle, CYBLE_ESS_CHAR_INDEX_T charIndex,
+    uint8 charInstance, uint8 attrSize, uint8 *attrValue)
+{
+    CYBLE_API_RESULT_T result;
+
+    if((CYBLE_ESS_DESCRIPTOR_VALUE_CHANGED != charIndex) || (0u != charInstance))
+    {
+        result = CYBLE_ERROR_INVALID_PARAMETER;
+    }
+    else if(0u == (cyBleEsssDvcCccd & CYBLE_CCCD_INDICATION))
+    {
+        result = CYBLE_ERROR_IND_DISABLED;
+    }
+    else
+    {
+        result = CyBleSim_Send(connHandle, CYBLE_SIM_ESS_DVC_HANDLE, attrSize, attrValue, 1u);
+    }
+
+    return(result);
+}
+
+
+/*******************************************************************************
+* Function Name: CyBle_GattsWriteAttributeValue
+********************************************************************************
+*
+* Summary:
+*   Writes an attribute of the ESS History service to the GATT database.
+*
+* Parameters:
+*   handleValuePair - the attribute and its value.
+*   offset - the offset of the value, not used.
+*   connHandle - the connection of a write of the peer, not used.
+*   flags - CYBLE_GATT_DB_LOCALLY_INITIATED or CYBLE_GATT_DB_PEER_INITIATED.
+*
+* Return:
+*   CYBLE_GATT_ERR_INVALID_HANDLE for another attribute,
+*   CYBLE_GATT_ERR_INVALID_ATTRIBUTE_LEN for a value that does not fit or a
+*   CCCD of the peer that is not 2 bytes, else CYBLE_GATT_ERR_NONE.
+*
+*******************************************************************************/
+CYBLE_GATT_ERR_CODE_T CyBle_GattsWriteAttributeValue(CYBLE_GATT_HANDLE_VALUE_PAIR_T *handleValuePair,
+    uint16 offset, CYBLE_CONN_HANDLE_T *connHandle, uint8 flags)
+{
+    CYBLE_GATT_ERR_CODE_T result = CYBLE_GATT_ERR_NONE;
+
+    (void)offset;
+    (void)connHandle;
+
+    if(CYBLE_ESS_HISTORY_HISTORY_CHAR_HANDLE == handleValuePair->attrHandle)
+    {
+        if(handleValuePair->value.len > CYBLE_SIM_ESS_HIST_VALUE_MAX)
+        {
+            result = CYBLE_GATT_ERR_INVALID_ATTRIBUTE_LEN;
+        }
+        else
+        {
+            (void)memcpy(cyBleEssHistValue, handleValuePair->value.val, handleValuePair->value.len);
+        }
+    }
+    else if(CYBLE_ESS_HISTORY_HISTORY_CLIENT_CHARACTERISTIC_CONFIGURATION_DESC_HANDLE == handleValuePair->attrHandle)
+    {
+        if((CYBLE_GATT_DB_PEER_INITIATED == flags) && (CYBLE_CCCD_LEN != handleValuePair->value.len))
+        {
+            result = CYBLE_GATT_ERR_INVALID_ATTRIBUTE_LEN;
+        }
+        else
+        {
+            cyBleEssHistCccd = CyBle_Get16ByPtr(handleValuePair->value.val);
+        }
+    }
+    else
+    {
+        result = CYBLE_GATT_ERR_INVALID_HANDLE;
+    }
+
+    return(result);
+}
+
+
+/*******************************************************************************
+* Function Name: CyBle_GattsWriteRsp
+********************************************************************************
+*
+* Summary:
+*   Sends the Write Response, the client takes it with
+*   CyBleSim_GattsTakeRsp().
+*
+* Parameters:
+*   connHandle - the connection handle.
+*
+* Return:
+*   CYBLE_ERROR_OK
+*
+*******************************************************************************/
+CYBLE_API_RESULT_T CyBle_GattsWriteRsp(CYBLE_CONN_HANDLE_T connHandle)
+{
+    (void)connHandle;
+    cyBleSimGattsRsp = CYBLE_GATT_ERR_NONE;
+
+    return(CYBLE_ERROR_OK);
+}
+
+
+/*******************************************************************************
+* Function Name: CyBle_GattsErrorRsp
+********************************************************************************
+*
+* Summary:
+*   Sends the Error Response, the client takes its error code with
+*   CyBleSim_GattsTakeRsp().
+*
+* Parameters:
+*   connHandle - the connection handle.
+*   errRspParam - the failed request and its error code.
+*
+* Return:
+*   CYBLE_ERROR_OK
+*
+*******************************************************************************/
+CYBLE_API_RESULT_T CyBle_GattsErrorRsp(CYBLE_CONN_HANDLE_T connHandle, const CYBLE_GATTS_ERR_PARAM_T *errRspParam)
+{
+    (void)connHandle;
+    cyBleSimGattsRsp = (uint16)errRspParam->errorCode;
+
+    return(CYBLE_ERROR_OK);
+}
+
+
+/*******************************************************************************
+* Function Name: CyBleSim_GattsCccd
+********************************************************************************
+*
+* Summary:
+*   Reads a CCCD of the GATT database.
+*
+* Parameters:
+*   attrHandle - the attribute of the characteristic value or of the CCCD of
+*                the ESS History characteristic.
+*
+* Return:
+*   The value of the CCCD, CYBLE_CCCD_DEFAULT for another attribute.
+*
+*******************************************************************************/
+uint16 CyBleSim_GattsCccd(uint16 attrHandle)
+{
+    uint16 cccd = CYBLE_CCCD_DEFAULT;
+
+    if(CYBLE_ESS_HISTORY_HISTORY_CLIENT_CHARACTERISTIC_CONFIGURATION_DESC_HANDLE == attrHandle)
+    {
+        cccd = cyBleEssHistCccd;
+    }
+    else if(CYBLE_SIM_ESS_DVC_HANDLE == attrHandle)
+    {
+        cccd = cyBleEsssDvcCccd;
+    }
+    else if((attrHandle >= CYBLE_SIM_ESS_HANDLE(0u)) && (attrHandle < CYBLE_SIM_ESS_HANDLE(CYBLE_SIM_ESS_CHAR_NUM)))
+    {
+        cccd = cyBleEsssChar[attrHandle - CYBLE_SIM_ESS_HANDLE(0u)].cccd;
+    }
+    else
+    {
+        /* Not a characteristic with a CCCD */
+    }
+
+    return(cccd);
+}
+
+
+/*******************************************************************************
+* Function Name: CyBleSim_GattsTakeRsp
+********************************************************************************
+*
+* Summary:
+*   Takes the response to the last Write Request.
+*
+* Return:
+*   The ATT error code of the response, CYBLE_GATT_ERR_NONE for a Write
+*   Response, CYBLE_SIM_GATTS_NO_RSP when none has been sent.
+*
+*******************************************************************************/
+uint16 CyBleSim_GattsTakeRsp(void)
+{
+    uint16 rsp = cyBleSimGattsRsp;
+
+    cyBleSimGattsRsp = CYBLE_SIM_GATTS_NO_RSP;
+
+    return(rsp);
+}
+
+
+/*******************************************************************************
+* Function Name: CyBleSim_EssHistRead
+********************************************************************************
+*
+* Summary:
+*   Reads the ESS History characteristic as the client does.
+*
+* Parameters:
+*   value - returns the CYBLE_SIM_ESS_HIST_VALUE_MAX bytes of the value.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void CyBleSim_EssHistRead(uint8 value[])
+{
+    (void)memcpy(value, cyBleEssHistValue, CYBLE_SIM_ESS_HIST_VALUE_MAX);
+}
+
+
+/*******************************************************************************
+* Function Name: CyBleSim_EsssWriteCccd
+********************************************************************************
+*
+* Summary:
+*   Writes the CCCD of a characteristic instance as the client does and
+*   raises the event of the change.
+*
+* Parameters:
+*   charIndex - the characteristic.
+*   charInstance - the instance of the characteristic.
+*   cccd - the value of the CCCD.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void CyBleSim_EsssWriteCccd(CYBLE_ESS_CHAR_INDEX_T charIndex, uint8 charInstance, uint16 cccd)
+{
+    CYBLE_ESS_CHAR_VALUE_T param;
+    uint32 event;
+    uint8 charNum = CyBle_EsssFind(charIndex, charInstance);
+
+    if(CYBLE_ESS_DESCRIPTOR_VALUE_CHANGED == charIndex)
+    {
+        cyBleEsssDvcCccd = cccd;
+        event = (0u != (cccd & CYBLE_CCCD_INDICATION)) ?
+            (uint32)CYBLE_EVT_ESSS_INDICATION_ENABLED : (uint32)CYBLE_EVT_ESSS_INDICATION_DISABLED;
+    }
+    else if(charNum < CYBLE_SIM_ESS_CHAR_NUM)
+    {
+        cyBleEsssChar[charNum].cccd = cccd;
+        event = (0u != (cccd & CYBLE_CCCD_NOTIFICATION)) ?
+            (uint32)CYBLE_EVT_ESSS_NOTIFICATION_ENABLED : (uint32)CYBLE_EVT_ESSS_NOTIFICATION_DISABLED;
+    }
+    else
+    {
+        /* Not in the database, no event */
+        event = 0u;
+    }
+
+    if((NULL != cyBleEssCallback) && (0u != event))
+    {
+        param.connHandle = cyBle_connHandle;
+        param.charIndex = charIndex;
+        param.charInstance = charInstance;
+        param.value = NULL;
+        param.gattErrorCode = CYBLE_GATT_ERR_NONE;
+        cyBleEssCallback(event, &param);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: CyBleSim_EsssWriteDescr
+********************************************************************************
+*
+* Summary:
+*   Writes a descriptor of a characteristic instance as the client does and
+*   raises the event of the write.
+*
+* Parameters:
+*   charIndex - the characteristic.
+*   charInstance - the instance of the characteristic.
+*   descrIndex - the descriptor.
+*   length - the length of the value.
+*   value - the value.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void CyBleSim_EsssWriteDescr(CYBLE_ESS_CHAR_INDEX_T charIndex, uint8 charInstance,
+    CYBLE_ESS_DESCR_INDEX_T descrIndex, uint8 length, const uint8 value[])
+{
+    CYBLE_ESS_DESCR_VALUE_T param;
+    CYBLE_GATT_VALUE_T gattValue;
+    uint8 buf[CYBLE_SIM_MTU_MAX];
+
+    (void)memcpy(buf, value, length);
+    (void)CyBle_EsssSetCharacteristicDescriptor(charIndex, charInstance, descrIndex, length, buf);
+    gattValue.val = buf;
+    gattValue.len = length;
+    gattValue.actualLen = length;
+
+    if(NULL != cyBleEssCallback)
+    {
+        param.connHandle = cyBle_connHandle;
+        param.charIndex = charIndex;
+        param.charInstance = charInstance;
+        param.descrIndex = descrIndex;
+        param.gattErrorCode = CYBLE_GATT_ERR_NONE;
+        param.value = &gattValue;
+        cyBleEssCallback((uint32)CYBLE_EVT_ESSS_DESCR_WRITE, &param);
+    }
+}
+
+
+/* [] END OF FILE */
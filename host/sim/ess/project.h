@@ -0,0 +1,210 @@
+/*******************************************************************************
+* File Name: project.h
+*
+* Version 1.0
+*
+* Description:
+*  Host replacement of the project.h generated for BLE_Environmental_Sensing:
+*  the simulated stack, the Environmental Sensing Service server API and the
+*  GATT database calls of the ESS History service.
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(CY_PROJECT_H)
+#define CY_PROJECT_H
+
+#define CYBLE_GATT_MTU                      (23u)       /* MtuSize of TopDesign.cysch */
+
+#include "cyble_sim.h"
+
+
+/***************************************
+*        Constants
+***************************************/
+#define CYBLE_CYPACKED_ATTR                 __attribute__((packed))
+#define CY_ISR_PROTO(FuncName)              void FuncName(void)
+
+#define CY_SYS_WDT_COUNTER1                 (1u)
+#define CY_SYS_WDT_COUNTER1_MASK            (0x00000100u)
+#define CY_SYS_WDT_COUNTER1_INT             (0x00000008u)
+
+/* Attribute handles of the simulation: the value of a characteristic
+*  instance of the GATT database, the Descriptor Value Changed characteristic
+*  and the ESS History service.
+*/
+#define CYBLE_SIM_ESS_HANDLE(charNum)       ((uint16)(0x0050u + (uint16)(charNum)))
+#define CYBLE_SIM_ESS_CHAR_NUM              (3u)        /* Characteristic instances of the database */
+#define CYBLE_SIM_ESS_DVC_HANDLE            (0x0054u)
+#define CYBLE_ESS_HISTORY_HISTORY_CHAR_HANDLE                                       (0x0058u)
+#define CYBLE_ESS_HISTORY_HISTORY_CLIENT_CHARACTERISTIC_CONFIGURATION_DESC_HANDLE   (0x0059u)
+
+/* Longest value of the ESS History characteristic the simulation keeps */
+#define CYBLE_SIM_ESS_HIST_VALUE_MAX        (20u)
+
+/* Response to a Write Request not sent yet */
+#define CYBLE_SIM_GATTS_NO_RSP              (0x0100u)
+
+#define CYBLE_ESS_2BYTES_LENGTH             (2u)
+#define CYBLE_ESS_3BYTES_LENGTH             (3u)
+#define CYBLE_ESS_TRIGGER_NUM               (3u)        /* ES Trigger Setting descriptors */
+#define CYBLE_ESS_TRIGGER_VALUE_MAX         (4u)        /* Longest ES Trigger Setting value */
+#define CYBLE_ESS_MEASUREMENT_LENGTH        (11u)       /* ES Measurement descriptor value */
+
+/* ES Trigger Setting conditions */
+#define CYBLE_ESS_TRIG_TRIGGER_INACTIVE             (0x00u)
+#define CYBLE_ESS_TRIG_USE_FIXED_TIME_INTERVAL      (0x01u)
+#define CYBLE_ESS_TRIG_NO_LESS_THEN_TIME_INTERVAL   (0x02u)
+#define CYBLE_ESS_TRIG_WHEN_CHANGED                 (0x03u)
+
+/* ES Configuration values */
+#define CYBLE_ESS_CONF_BOOLEAN_AND          (0x00u)
+#define CYBLE_ESS_CONF_BOOLEAN_OR           (0x01u)
+
+/* Flags of the Descriptor Value Changed characteristic */
+#define CYBLE_ESS_VALUE_CHANGE_SOURCE_CLIENT        (0x0001u)
+#define CYBLE_ESS_VALUE_CHANGE_ES_TRIGGER           (0x0002u)
+#define CYBLE_ESS_VALUE_CHANGE_ES_CONFIG            (0x0004u)
+#define CYBLE_ESS_VALUE_CHANGE_ES_MEASUREMENT       (0x0008u)
+#define CYBLE_ESS_VALUE_CHANGE_USER_DESCRIPTION     (0x0010u)
+
+#define CYBLE_UUID_CHAR_TRUE_WIND_SPEED     (0x2A70u)
+
+#define CYBLE_GATT_WRITE_REQ                (0x12u)
+#define CYBLE_GATT_INVALID_ATTR_HANDLE_VALUE        (0x0000u)
+#define CYBLE_GATT_DB_LOCALLY_INITIATED     (0x00u)
+#define CYBLE_GATT_DB_PEER_INITIATED        (0x40u)
+
+#define CYBLE_IS_NOTIFICATION_ENABLED(attrHandle) \
+    (0u != (CyBleSim_GattsCccd(attrHandle) & CYBLE_CCCD_NOTIFICATION))
+
+
+/***************************************
+*        Data Struct Definition
+***************************************/
+typedef enum
+{
+    CYBLE_ESS_DESCRIPTOR_VALUE_CHANGED,     /* Descriptor Value Changed */
+    CYBLE_ESS_APPARENT_WIND_DIR,            /* Apparent Wind Direction */
+    CYBLE_ESS_APPARENT_WIND_SPEED,          /* Apparent Wind Speed */
+    CYBLE_ESS_DEW_POINT,                    /* Dew Point */
+    CYBLE_ESS_ELEVATION,                    /* Elevation */
+    CYBLE_ESS_GUST_FACTOR,                  /* Gust Factor */
+    CYBLE_ESS_HEAT_INDEX,                   /* Heat Index */
+    CYBLE_ESS_HUMIDITY,                     /* Humidity */
+    CYBLE_ESS_IRRADIANCE,                   /* Irradiance */
+    CYBLE_ESS_POLLEN_CONCENTRATION,         /* Pollen Concentration */
+    CYBLE_ESS_RAINFALL,                     /* Rainfall */
+    CYBLE_ESS_PRESSURE,                     /* Pressure */
+    CYBLE_ESS_TEMPERATURE,                  /* Temperature */
+    CYBLE_ESS_TRUE_WIND_DIR,                /* True Wind Direction */
+    CYBLE_ESS_TRUE_WIND_SPEED,              /* True Wind Speed */
+    CYBLE_ESS_UV_INDEX,                     /* UV Index */
+    CYBLE_ESS_WIND_CHILL,                   /* Wind Chill */
+    CYBLE_ESS_BAROMETRIC_PRESSURE_TREND,    /* Barometric Pressure Trend */
+    CYBLE_ESS_MAGNETIC_DECLINATION,         /* Magnetic Declination */
+    CYBLE_ESS_MAGNETIC_FLUX_DENSITY_2D,     /* Magnetic Flux Density - 2D */
+    CYBLE_ESS_MAGNETIC_FLUX_DENSITY_3D,     /* Magnetic Flux Density - 3D */
+    CYBLE_ESS_CHAR_COUNT
+} CYBLE_ESS_CHAR_INDEX_T;
+
+typedef enum
+{
+    CYBLE_ESS_CCCD,                         /* Client Characteristic Configuration */
+    CYBLE_ESS_CHAR_EXTENDED_PROPERTIES,     /* Characteristic Extended Properties */
+    CYBLE_ESS_ES_MEASUREMENT_DESCR,         /* ES Measurement */
+    CYBLE_ESS_ES_TRIGGER_SETTINGS_DESCR1,   /* ES Trigger Setting #1 */
+    CYBLE_ESS_ES_TRIGGER_SETTINGS_DESCR2,   /* ES Trigger Setting #2 */
+    CYBLE_ESS_ES_TRIGGER_SETTINGS_DESCR3,   /* ES Trigger Setting #3 */
+    CYBLE_ESS_ES_CONFIG_DESCR,              /* ES Configuration */
+    CYBLE_ESS_CHAR_USER_DESCRIPTION_DESCR,  /* Characteristic User Description */
+    CYBLE_ESS_VRD,                          /* Valid Range */
+    CYBLE_ESS_DESCR_COUNT
+} CYBLE_ESS_DESCR_INDEX_T;
+
+typedef struct
+{
+    CYBLE_CONN_HANDLE_T connHandle;
+    CYBLE_ESS_CHAR_INDEX_T charIndex;
+    uint8 charInstance;
+    CYBLE_GATT_VALUE_T *value;
+    CYBLE_GATT_ERR_CODE_T gattErrorCode;
+} CYBLE_ESS_CHAR_VALUE_T;
+
+typedef struct
+{
+    CYBLE_CONN_HANDLE_T connHandle;
+    CYBLE_ESS_CHAR_INDEX_T charIndex;
+    uint8 charInstance;
+    CYBLE_ESS_DESCR_INDEX_T descrIndex;
+    CYBLE_GATT_ERR_CODE_T gattErrorCode;
+    CYBLE_GATT_VALUE_T *value;
+} CYBLE_ESS_DESCR_VALUE_T;
+
+typedef enum
+{
+    CYBLE_EVT_ESSS_NOTIFICATION_ENABLED = 0x3400u,
+    CYBLE_EVT_ESSS_NOTIFICATION_DISABLED,
+    CYBLE_EVT_ESSS_INDICATION_ENABLED,
+    CYBLE_EVT_ESSS_INDICATION_DISABLED,
+    CYBLE_EVT_ESSS_INDICATION_CONFIRMATION,
+    CYBLE_EVT_ESSS_CHAR_WRITE,
+    CYBLE_EVT_ESSS_DESCR_WRITE,
+    CYBLE_EVT_ESSC_NOTIFICATION,
+    CYBLE_EVT_ESSC_INDICATION,
+    CYBLE_EVT_ESSC_READ_CHAR_RESPONSE,
+    CYBLE_EVT_ESSC_WRITE_CHAR_RESPONSE,
+    CYBLE_EVT_ESSC_READ_DESCR_RESPONSE,
+    CYBLE_EVT_ESSC_WRITE_DESCR_RESPONSE
+} CYBLE_ESS_EVT_T;
+
+typedef struct
+{
+    CYBLE_GATT_HANDLE_VALUE_PAIR_T handleValPair;
+    CYBLE_CONN_HANDLE_T connHandle;
+} CYBLE_GATTS_WRITE_REQ_PARAM_T;
+
+typedef struct
+{
+    uint16 attrHandle;                      /* Handle of the failed request */
+    uint8 opcode;                           /* Opcode of the failed request */
+    CYBLE_GATT_ERR_CODE_T errorCode;        /* ATT error code */
+} CYBLE_GATTS_ERR_PARAM_T;
+
+
+/***************************************
+*      API Function Prototypes
+***************************************/
+void CyBle_EssRegisterAttrCallback(CYBLE_CALLBACK_T callbackFunc);
+CYBLE_API_RESULT_T CyBle_EsssSetCharacteristicValue(CYBLE_ESS_CHAR_INDEX_T charIndex, uint8 charInstance,
+    uint8 attrSize, uint8 *attrValue);
+CYBLE_API_RESULT_T CyBle_EsssGetCharacteristicDescriptor(CYBLE_ESS_CHAR_INDEX_T charIndex, uint8 charInstance,
+    CYBLE_ESS_DESCR_INDEX_T descrIndex, uint8 attrSize, uint8 *attrValue);
+CYBLE_API_RESULT_T CyBle_EsssSetCharacteristicDescriptor(CYBLE_ESS_CHAR_INDEX_T charIndex, uint8 charInstance,
+    CYBLE_ESS_DESCR_INDEX_T descrIndex, uint8 attrSize, uint8 *attrValue);
+void CyBle_EsssSetChangeIndex(uint16 essChangeIndex);
+CYBLE_API_RESULT_T CyBle_EsssSendNotification(CYBLE_CONN_HANDLE_T connHandle, CYBLE_ESS_CHAR_INDEX_T charIndex,
+    uint8 charInstance, uint8 attrSize, uint8 *attrValue);
+CYBLE_API_RESULT_T CyBle_EsssSendIndication(CYBLE_CONN_HANDLE_T connHandle, CYBLE_ESS_CHAR_INDEX_T charIndex,
+    uint8 charInstance, uint8 attrSize, uint8 *attrValue);
+CYBLE_GATT_ERR_CODE_T CyBle_GattsWriteAttributeValue(CYBLE_GATT_HANDLE_VALUE_PAIR_T *handleValuePair,
+    uint16 offset, CYBLE_CONN_HANDLE_T *connHandle, uint8 flags);
+CYBLE_API_RESULT_T CyBle_GattsWriteRsp(CYBLE_CONN_HANDLE_T connHandle);
+CYBLE_API_RESULT_T CyBle_GattsErrorRsp(CYBLE_CONN_HANDLE_T connHandle, const CYBLE_GATTS_ERR_PARAM_T *errRspParam);
+
+/* Client side of the simulation */
+uint16 CyBleSim_GattsCccd(uint16 attrHandle);
+uint16 CyBleSim_GattsTakeRsp(void);
+void CyBleSim_EssHistRead(uint8 value[]);
+void CyBleSim_EsssWriteCccd(CYBLE_ESS_CHAR_INDEX_T charIndex, uint8 charInstance, uint16 cccd);
+void CyBleSim_EsssWriteDescr(CYBLE_ESS_CHAR_INDEX_T charIndex, uint8 charInstance,
+    CYBLE_ESS_DESCR_INDEX_T descrIndex, uint8 length, const uint8 value[]);
+
+
+#endif /* CY_PROJECT_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,235 @@
+/*******************************************************************************
+* File Name: cyble_glss.c
+*
+* Version 1.0
+*
+* Description:
+*  This file contains the simulated Glucose Service server API of the host
+*  build. The CCCDs are kept in RAM, the notifications and indications go
+*  to the simulated link.
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <project.h>
+
+
+static CYBLE_CALLBACK_T cyBleGlsCallback;
+static uint16 cyBleGlssCccd[CYBLE_GLS_CHAR_COUNT];
+
+
+/*******************************************************************************
+* Function Name: CyBle_GlssConfirm
+********************************************************************************
+*
+* Summary:
+*   Reports the confirmation of the Record Access Control Point indication.
+*
+* Parameters:
+*   attrHandle - the attribute of the indication.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+static void CyBle_GlssConfirm(uint16 attrHandle)
+{
+    CYBLE_GLS_CHAR_VALUE_T param;
+
+    if((NULL != cyBleGlsCallback) && (CYBLE_SIM_GLS_HANDLE(CYBLE_GLS_RACP) == attrHandle))
+    {
+        param.connHandle = cyBle_connHandle;
+        param.charIndex = CYBLE_GLS_RACP;
+        param.value = NULL;
+        cyBleGlsCallback((uint32)CYBLE_EVT_GLSS_INDICATION_CONFIRMED, &param);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: CyBle_GlsRegisterAttrCallback
+********************************************************************************
+*
+* Summary:
+*   Registers the callback of the Glucose Service events.
+*
+* Parameters:
+*   callbackFunc - the callback.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void CyBle_GlsRegisterAttrCallback(CYBLE_CALLBACK_T callbackFunc)
+{
+    cyBleGlsCallback = callbackFunc;
+    CyBleSim_SetCnfHandler(&CyBle_GlssConfirm);
+}
+
+
+/*******************************************************************************
+* Function Name: CyBle_GlssSendNotification
+********************************************************************************
+*
+* Summary:
+*   Sends a Glucose Measurement or a Glucose Measurement Context
+*   notification.
+*
+* Parameters:
+*   connHandle - the connection handle.
+*   charIndex - the characteristic.
+*   attrSize - the size of the value.
+*   attrValue - the value.
+*
+* Return:
+*   CYBLE_ERROR_NTF_DISABLED when the client has not enabled the
+*   notifications, else the result of CyBleSim_Send().
+*
+*******************************************************************************/
+CYBLE_API_RESULT_T CyBle_GlssSendNotification(CYBLE_CONN_HANDLE_T connHandle, CYBLE_GLS_CHAR_INDEX_T charIndex,
+    uint8 attrSize, uint8 *attrValue)
+{
+    CYBLE_API_RESULT_T result;
+
+    if((CYBLE_GLS_GLMT != charIndex) && (CYBLE_GLS_GLMC != charIndex))
+    {
+        result = CYBLE_ERROR_INVALID_PARAMETER;
+    }
+    else if(0u == (cyBleGlssCccd[charIndex] & CYBLE_CCCD_NOTIFICATION))
+    {
+        result = CYBLE_ERROR_NTF_DISABLED;
+    }
+    else
+    {
+        result = CyBleSim_Send(connHandle, CYBLE_SIM_GLS_HANDLE(charIndex), attrSize, attrValue, 0u);
+    }
+
+    return(result);
+}
+
+
+/*******************************************************************************
+* Function Name: CyBle_GlssSendIndication
+********************************************************************************
+*
+* Summary:
+*   Sends a Record Access Control Point indication.
+*
+* Parameters:
+*   connHandle - the connection handle.
+*   charIndex - the characteristic.
+*   attrSize - the size of the value.
+*   attrValue - the value.
+*
+* Return:
+*   CYBLE_ERROR_IND_DISABLED when the client has not enabled the
+*   indications, else the result of CyBleSim_Send().
+*
+*******************************************************************************/
+CYBLE_API_RESULT_T CyBle_GlssSendIndication(CYBLE_CONN_HANDLE_T connHandle, CYBLE_GLS_CHAR_INDEX_T charIndex,
+    uint8 attrSize, uint8 *attrValue)
+{
+    CYBLE_API_RESULT_T result;
+
+    if(CYBLE_GLS_RACP != charIndex)
+    {
+        result = CYBLE_ERROR_INVALID_PARAMETER;
+    }
+    else if(0u == (cyBleGlssCccd[charIndex] & CYBLE_CCCD_INDICATION))
+    {
+        result = CYBLE_ERROR_IND_DISABLED;
+    }
+    else
+    {
+        result = CyBleSim_Send(connHandle, CYBLE_SIM_GLS_HANDLE(charIndex), attrSize, attrValue, 1u);
+    }
+
+    return(result);
+}
+
+
+/*******************************************************************************
+* Function Name: CyBleSim_GlssWriteCccd
+********************************************************************************
+*
+* Summary:
+*   Writes the CCCD of a characteristic as the client does and raises the
+*   event of the change.
+*
+* Parameters:
+*   charIndex - the characteristic.
+*   cccd - the value of the CCCD.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void CyBleSim_GlssWriteCccd(CYBLE_GLS_CHAR_INDEX_T charIndex, uint16 cccd)
+{
+    CYBLE_GLS_CHAR_VALUE_T param;
+    uint32 event;
+
+    cyBleGlssCccd[charIndex] = cccd;
+
+    if(CYBLE_GLS_RACP == charIndex)
+    {
+        event = (0u != (cccd & CYBLE_CCCD_INDICATION)) ?
+            (uint32)CYBLE_EVT_GLSS_INDICATION_ENABLED : (uint32)CYBLE_EVT_GLSS_INDICATION_DISABLED;
+    }
+    else
+    {
+        event = (0u != (cccd & CYBLE_CCCD_NOTIFICATION)) ?
+            (uint32)CYBLE_EVT_GLSS_NOTIFICATION_ENABLED : (uint32)CYBLE_EVT_GLSS_NOTIFICATION_DISABLED;
+    }
+
+    if(NULL != cyBleGlsCallback)
+    {
+        param.connHandle = cyBle_connHandle;
+        param.charIndex = charIndex;
+        param.value = NULL;
+        cyBleGlsCallback(event, &param);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: CyBleSim_GlssWriteRacp
+********************************************************************************
+*
+* Summary:
+*   Writes the Record Access Control Point as the client does.
+*
+* Parameters:
+*   length - the length of the value.
+*   value - the value.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void CyBleSim_GlssWriteRacp(uint8 length, const uint8 value[])
+{
+    CYBLE_GLS_CHAR_VALUE_T param;
+    CYBLE_GATT_VALUE_T gattValue;
+    uint8 buf[CYBLE_SIM_MTU_MAX];
+
+    (void)memcpy(buf, value, length);
+    gattValue.val = buf;
+    gattValue.len = length;
+    gattValue.actualLen = length;
+
+    if(NULL != cyBleGlsCallback)
+    {
+        param.connHandle = cyBle_connHandle;
+        param.charIndex = CYBLE_GLS_RACP;
+        param.value = &gattValue;
+        cyBleGlsCallback((uint32)CYBLE_EVT_GLSS_WRITE_CHAR, &param);
+    }
+}
+
+
+/* [] END OF FILE */
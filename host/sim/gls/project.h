@@ -0,0 +1,79 @@
+/*******************************************************************************
+* File Name: project.h
+*
+* Version 1.0
+*
+* Description:
+*  Host replacement of the project.h generated for BLE_Glucose_Meter: the
+*  simulated stack and flash and the Glucose Service server API.
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(CY_PROJECT_H)
+#define CY_PROJECT_H
+
+#define CYBLE_GATT_MTU                      (23u)       /* MtuSize of TopDesign.cysch */
+
+#include "cyble_sim.h"
+#include "cyflash_sim.h"
+
+
+/***************************************
+*        Constants
+***************************************/
+/* Attribute handle of the value of a characteristic in the simulation */
+#define CYBLE_SIM_GLS_HANDLE(charIndex)     ((uint16)(0x0030u + (uint16)(charIndex)))
+
+
+/***************************************
+*        Data Struct Definition
+***************************************/
+typedef enum
+{
+    CYBLE_GLS_GLMT,                         /* Glucose Measurement */
+    CYBLE_GLS_GLMC,                         /* Glucose Measurement Context */
+    CYBLE_GLS_GLFT,                         /* Glucose Feature */
+    CYBLE_GLS_RACP,                         /* Record Access Control Point */
+    CYBLE_GLS_CHAR_COUNT
+} CYBLE_GLS_CHAR_INDEX_T;
+
+typedef struct
+{
+    CYBLE_CONN_HANDLE_T connHandle;
+    CYBLE_GLS_CHAR_INDEX_T charIndex;
+    CYBLE_GATT_VALUE_T *value;
+} CYBLE_GLS_CHAR_VALUE_T;
+
+typedef enum
+{
+    CYBLE_EVT_GLSS_INDICATION_ENABLED = 0x3200u,
+    CYBLE_EVT_GLSS_INDICATION_DISABLED,
+    CYBLE_EVT_GLSS_INDICATION_CONFIRMED,
+    CYBLE_EVT_GLSS_NOTIFICATION_ENABLED,
+    CYBLE_EVT_GLSS_NOTIFICATION_DISABLED,
+    CYBLE_EVT_GLSS_WRITE_CHAR
+} CYBLE_GLS_EVT_T;
+
+
+/***************************************
+*      API Function Prototypes
+***************************************/
+void CyBle_GlsRegisterAttrCallback(CYBLE_CALLBACK_T callbackFunc);
+CYBLE_API_RESULT_T CyBle_GlssSendNotification(CYBLE_CONN_HANDLE_T connHandle, CYBLE_GLS_CHAR_INDEX_T charIndex,
+    uint8 attrSize, uint8 *attrValue);
+CYBLE_API_RESULT_T CyBle_GlssSendIndication(CYBLE_CONN_HANDLE_T connHandle, CYBLE_GLS_CHAR_INDEX_T charIndex,
+    uint8 attrSize, uint8 *attrValue);
+
+/* Client side of the simulation */
+void CyBleSim_GlssWriteCccd(CYBLE_GLS_CHAR_INDEX_T charIndex, uint16 cccd);
+void CyBleSim_GlssWriteRacp(uint8 length, const uint8 value[]);
+
+
+#endif /* CY_PROJECT_H */
+
+/* [] END OF FILE */
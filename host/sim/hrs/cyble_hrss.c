@@ -0,0 +1,208 @@
+/*******************************************************************************
+* File Name: cyble_hrss.c
+*
+* Version 1.0
+*
+* Description:
+*  This file contains the simulated Heart Rate Service server API of the
+*  host build. The characteristic values and the CCCD are kept in RAM, the
+*  notifications go to the simulated link.
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <project.h>
+
+
+static CYBLE_CALLBACK_T cyBleHrsCallback;
+static uint8 cyBleHrssBsl[CYBLE_HRS_BSL_CHAR_LEN];
+static uint8 cyBleHrssHrmCccd[CYBLE_CCCD_LEN];
+
+
+/*******************************************************************************
+* Function Name: CyBle_HrsRegisterAttrCallback
+********************************************************************************
+*
+* Summary:
+*   Registers the callback of the Heart Rate Service events.
+*
+* Parameters:
+*   callbackFunc - the callback.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void CyBle_HrsRegisterAttrCallback(CYBLE_CALLBACK_T callbackFunc)
+{
+    cyBleHrsCallback = callbackFunc;
+}
+
+
+/*******************************************************************************
+* Function Name: CyBle_HrssSetCharacteristicValue
+********************************************************************************
+*
+* Summary:
+*   Sets the value of the Body Sensor Location, the only characteristic of
+*   the service kept in the GATT database.
+*
+* Parameters:
+*   charIndex - the characteristic.
+*   attrSize - the size of the value.
+*   attrValue - the value.
+*
+* Return:
+*   CYBLE_ERROR_OK or CYBLE_ERROR_INVALID_PARAMETER.
+*
+*******************************************************************************/
+CYBLE_API_RESULT_T CyBle_HrssSetCharacteristicValue(CYBLE_HRS_CHAR_INDEX_T charIndex, uint8 attrSize,
+    uint8 *attrValue)
+{
+    CYBLE_API_RESULT_T result = CYBLE_ERROR_INVALID_PARAMETER;
+
+    if((CYBLE_HRS_BSL == charIndex) && (CYBLE_HRS_BSL_CHAR_LEN == attrSize))
+    {
+        (void)memcpy(cyBleHrssBsl, attrValue, attrSize);
+        result = CYBLE_ERROR_OK;
+    }
+
+    return(result);
+}
+
+
+/*******************************************************************************
+* Function Name: CyBle_HrssGetCharacteristicValue
+********************************************************************************
+*
+* Summary:
+*   Gets the value of the Body Sensor Location.
+*
+* Parameters:
+*   charIndex - the characteristic.
+*   attrSize - the size of the value.
+*   attrValue - returns the value.
+*
+* Return:
+*   CYBLE_ERROR_OK or CYBLE_ERROR_INVALID_PARAMETER.
+*
+*******************************************************************************/
+CYBLE_API_RESULT_T CyBle_HrssGetCharacteristicValue(CYBLE_HRS_CHAR_INDEX_T charIndex, uint8 attrSize,
+    uint8 *attrValue)
+{
+    CYBLE_API_RESULT_T result = CYBLE_ERROR_INVALID_PARAMETER;
+
+    if((CYBLE_HRS_BSL == charIndex) && (CYBLE_HRS_BSL_CHAR_LEN == attrSize))
+    {
+        (void)memcpy(attrValue, cyBleHrssBsl, attrSize);
+        result = CYBLE_ERROR_OK;
+    }
+
+    return(result);
+}
+
+
+/*******************************************************************************
+* Function Name: CyBle_HrssGetCharacteristicDescriptor
+********************************************************************************
+*
+* Summary:
+*   Gets the Heart Rate Measurement CCCD.
+*
+* Parameters:
+*   charIndex - the characteristic.
+*   descrIndex - the descriptor.
+*   attrSize - the size of the descriptor.
+*   attrValue - returns the descriptor.
+*
+* Return:
+*   CYBLE_ERROR_OK or CYBLE_ERROR_INVALID_PARAMETER.
+*
+*******************************************************************************/
+CYBLE_API_RESULT_T CyBle_HrssGetCharacteristicDescriptor(CYBLE_HRS_CHAR_INDEX_T charIndex,
+    CYBLE_HRS_DESCR_INDEX_T descrIndex, uint8 attrSize, uint8 *attrValue)
+{
+    CYBLE_API_RESULT_T result = CYBLE_ERROR_INVALID_PARAMETER;
+
+    if((CYBLE_HRS_HRM == charIndex) && (CYBLE_HRS_HRM_CCCD == descrIndex) && (CYBLE_CCCD_LEN == attrSize))
+    {
+        (void)memcpy(attrValue, cyBleHrssHrmCccd, attrSize);
+        result = CYBLE_ERROR_OK;
+    }
+
+    return(result);
+}
+
+
+/*******************************************************************************
+* Function Name: CyBle_HrssSendNotification
+********************************************************************************
+*
+* Summary:
+*   Sends a Heart Rate Measurement notification.
+*
+* Parameters:
+*   connHandle - the connection handle.
+*   charIndex - the characteristic.
+*   attrSize - the size of the value.
+*   attrValue - the value.
+*
+* Return:
+*   CYBLE_ERROR_NTF_DISABLED when the client has not enabled the
+*   notifications, else the result of CyBleSim_Send().
+*
+*******************************************************************************/
+CYBLE_API_RESULT_T CyBle_HrssSendNotification(CYBLE_CONN_HANDLE_T connHandle, CYBLE_HRS_CHAR_INDEX_T charIndex,
+    uint8 attrSize, uint8 *attrValue)
+{
+    CYBLE_API_RESULT_T result;
+
+    if(CYBLE_HRS_HRM != charIndex)
+    {
+        result = CYBLE_ERROR_INVALID_PARAMETER;
+    }
+    else if(0u == (CyBle_Get16ByPtr(cyBleHrssHrmCccd) & CYBLE_CCCD_NOTIFICATION))
+    {
+        result = CYBLE_ERROR_NTF_DISABLED;
+    }
+    else
+    {
+        result = CyBleSim_Send(connHandle, CYBLE_SIM_HRS_HANDLE(charIndex), attrSize, attrValue, 0u);
+    }
+
+    return(result);
+}
+
+
+/*******************************************************************************
+* Function Name: CyBleSim_HrssWriteCccd
+********************************************************************************
+*
+* Summary:
+*   Writes the Heart Rate Measurement CCCD as the client does and raises the
+*   event of the change.
+*
+* Parameters:
+*   cccd - the value of the CCCD.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void CyBleSim_HrssWriteCccd(uint16 cccd)
+{
+    CyBle_Set16ByPtr(cyBleHrssHrmCccd, cccd);
+
+    if(NULL != cyBleHrsCallback)
+    {
+        cyBleHrsCallback((0u != (cccd & CYBLE_CCCD_NOTIFICATION)) ?
+            (uint32)CYBLE_EVT_HRSS_NOTIFICATION_ENABLED : (uint32)CYBLE_EVT_HRSS_NOTIFICATION_DISABLED, NULL);
+    }
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,79 @@
+/*******************************************************************************
+* File Name: project.h
+*
+* Version 1.0
+*
+* Description:
+*  Host replacement of the project.h generated for BLE_Heart_Rate_Sensor:
+*  the simulated stack and the Heart Rate Service server API.
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(CY_PROJECT_H)
+#define CY_PROJECT_H
+
+#define CYBLE_GATT_MTU                      (67u)       /* MtuSize of TopDesign.cysch */
+
+#include "cyble_sim.h"
+
+
+/***************************************
+*        Constants
+***************************************/
+#define CYBLE_HRS_BSL_CHAR_LEN              (1u)
+#define CYBLE_HRS_CPT_CHAR_LEN              (1u)
+
+/* Attribute handle of the value of a characteristic in the simulation */
+#define CYBLE_SIM_HRS_HANDLE(charIndex)     ((uint16)(0x0010u + (uint16)(charIndex)))
+
+
+/***************************************
+*        Data Struct Definition
+***************************************/
+typedef enum
+{
+    CYBLE_HRS_HRM,                          /* Heart Rate Measurement */
+    CYBLE_HRS_BSL,                          /* Body Sensor Location */
+    CYBLE_HRS_CPT,                          /* Heart Rate Control Point */
+    CYBLE_HRS_CHAR_COUNT
+} CYBLE_HRS_CHAR_INDEX_T;
+
+typedef enum
+{
+    CYBLE_HRS_HRM_CCCD,                     /* Heart Rate Measurement CCCD */
+    CYBLE_HRS_DESCR_COUNT
+} CYBLE_HRS_DESCR_INDEX_T;
+
+typedef enum
+{
+    CYBLE_EVT_HRSS_NOTIFICATION_ENABLED = 0x3000u,
+    CYBLE_EVT_HRSS_NOTIFICATION_DISABLED,
+    CYBLE_EVT_HRSS_ENERGY_EXPENDED_RESET
+} CYBLE_HRS_EVT_T;
+
+
+/***************************************
+*      API Function Prototypes
+***************************************/
+void CyBle_HrsRegisterAttrCallback(CYBLE_CALLBACK_T callbackFunc);
+CYBLE_API_RESULT_T CyBle_HrssSetCharacteristicValue(CYBLE_HRS_CHAR_INDEX_T charIndex, uint8 attrSize,
+    uint8 *attrValue);
+CYBLE_API_RESULT_T CyBle_HrssGetCharacteristicValue(CYBLE_HRS_CHAR_INDEX_T charIndex, uint8 attrSize,
+    uint8 *attrValue);
+CYBLE_API_RESULT_T CyBle_HrssGetCharacteristicDescriptor(CYBLE_HRS_CHAR_INDEX_T charIndex,
+    CYBLE_HRS_DESCR_INDEX_T descrIndex, uint8 attrSize, uint8 *attrValue);
+CYBLE_API_RESULT_T CyBle_HrssSendNotification(CYBLE_CONN_HANDLE_T connHandle, CYBLE_HRS_CHAR_INDEX_T charIndex,
+    uint8 attrSize, uint8 *attrValue);
+
+/* Client side of the simulation */
+void CyBleSim_HrssWriteCccd(uint16 cccd);
+
+
+#endif /* CY_PROJECT_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,57 @@
+/*******************************************************************************
+* File Name: project.h
+*
+* Version 1.0
+*
+* Description:
+*  Host replacement of the project.h generated for BLE_IPSP_Router: the types
+*  of the simulated stack and the L2CAP, GAP and WDT calls of the IPSP Node
+*  table, SDU pool and credit controller. The calls are implemented by the
+*  test, see bench/ipspnodetest.c.
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(CY_PROJECT_H)
+#define CY_PROJECT_H
+
+#include "cyble_sim.h"
+
+
+/***************************************
+*        Constants
+***************************************/
+#define CYBLE_L2CAP_MTU                     (1280u)     /* L2capMtuSize of TopDesign.cysch */
+#define CYBLE_L2CAP_MPS                     (1280u)     /* L2capMpsSize of TopDesign.cysch */
+
+#define CYBLE_GAP_BD_ADDR_SIZE              (6u)
+
+#define CY_SYS_WDT_COUNTER2                 (2u)
+
+
+/***************************************
+*        Data Struct Definition
+***************************************/
+typedef struct
+{
+    uint8 bdAddr[CYBLE_GAP_BD_ADDR_SIZE];   /* Device address */
+    uint8 type;                             /* public = 0, Random = 1 */
+} CYBLE_GAP_BD_ADDR_T;
+
+
+/***************************************
+*      API Function Prototypes
+***************************************/
+CYBLE_API_RESULT_T CyBle_GapGetPeerBdAddr(uint8 bdHandle, CYBLE_GAP_BD_ADDR_T *peerBdAddr);
+CYBLE_API_RESULT_T CyBle_L2capChannelDataWrite(uint8 bdHandle, uint16 localCid, uint8 *buffer, uint16 bufferLen);
+CYBLE_API_RESULT_T CyBle_L2capCbfcSendFlowControlCredit(uint16 localCid, uint16 credit);
+uint32 CySysWdtReadCount(uint32 counterNum);
+
+
+#endif /* CY_PROJECT_H */
+
+/* [] END OF FILE */
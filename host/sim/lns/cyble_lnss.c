@@ -0,0 +1,248 @@
+/*******************************************************************************
+* File Name: cyble_lnss.c
+*
+* Version 1.0
+*
+* Description:
+*  This file contains the simulated Location and Navigation Service server
+*  API of the host build. The CCCDs are kept in RAM, the notifications and
+*  indications go to the simulated link.
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <project.h>
+
+
+static CYBLE_CALLBACK_T cyBleLnsCallback;
+static uint16 cyBleLnssCccd[CYBLE_LNS_CHAR_COUNT];
+
+
+/*******************************************************************************
+* Function Name: CyBle_LnssConfirm
+********************************************************************************
+*
+* Summary:
+*   Reports the confirmation of the LN Control Point indication.
+*
+* Parameters:
+*   attrHandle - the attribute of the indication.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+static void CyBle_LnssConfirm(uint16 attrHandle)
+{
+    CYBLE_LNS_CHAR_VALUE_T param;
+
+    if((NULL != cyBleLnsCallback) && (CYBLE_SIM_LNS_HANDLE(CYBLE_LNS_CP) == attrHandle))
+    {
+        param.connHandle = cyBle_connHandle;
+        param.charIndex = CYBLE_LNS_CP;
+        param.value = NULL;
+        cyBleLnsCallback((uint32)CYBLE_EVT_LNSS_INDICATION_CONFIRMED, &param);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: CyBle_LnsRegisterAttrCallback
+********************************************************************************
+*
+* Summary:
+*   Registers the callback of the Location and Navigation Service events.
+*
+* Parameters:
+*   callbackFunc - the callback.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void CyBle_LnsRegisterAttrCallback(CYBLE_CALLBACK_T callbackFunc)
+{
+    cyBleLnsCallback = callbackFunc;
+    CyBleSim_SetCnfHandler(&CyBle_LnssConfirm);
+}
+
+
+/*******************************************************************************
+* Function Name: CyBle_LnssSendNotification
+********************************************************************************
+*
+* Summary:
+*   Sends a Location and Speed or a Navigation notification.
+*
+* Parameters:
+*   connHandle - the connection handle.
+*   charIndex - the characteristic.
+*   attrSize - the size of the value.
+*   attrValue - the value.
+*
+* Return:
+*   CYBLE_ERROR_NTF_DISABLED when the client has not enabled the
+*   notifications, else the result of CyBleSim_Send().
+*
+*******************************************************************************/
+CYBLE_API_RESULT_T CyBle_LnssSendNotification(CYBLE_CONN_HANDLE_T connHandle, CYBLE_LNS_CHAR_INDEX_T charIndex,
+    uint8 attrSize, uint8 *attrValue)
+{
+    CYBLE_API_RESULT_T result;
+
+    if((CYBLE_LNS_LS != charIndex) && (CYBLE_LNS_NV != charIndex))
+    {
+        result = CYBLE_ERROR_INVALID_PARAMETER;
+    }
+    else if(0u == (cyBleLnssCccd[charIndex] & CYBLE_CCCD_NOTIFICATION))
+    {
+        result = CYBLE_ERROR_NTF_DISABLED;
+    }
+    else
+    {
+        result = CyBleSim_Send(connHandle, CYBLE_SIM_LNS_HANDLE(charIndex), attrSize, attrValue, 0u);
+    }
+
+    return(result);
+}
+
+
+/*******************************************************************************
+* Function Name: CyBle_LnssSendIndication
+********************************************************************************
+*
+* Summary:
+*   Sends an LN Control Point indication.
+*
+* Parameters:
+*   connHandle - the connection handle.
+*   charIndex - the characteristic.
+*   attrSize - the size of the value.
+*   attrValue - the value.
+*
+* Return:
+*   CYBLE_ERROR_IND_DISABLED when the client has not enabled the
+*   indications, else the result of CyBleSim_Send().
+*
+*******************************************************************************/
+CYBLE_API_RESULT_T CyBle_LnssSendIndication(CYBLE_CONN_HANDLE_T connHandle, CYBLE_LNS_CHAR_INDEX_T charIndex,
+    uint8 attrSize, uint8 *attrValue)
+{
+    CYBLE_API_RESULT_T result;
+
+    if(CYBLE_LNS_CP != charIndex)
+    {
+        result = CYBLE_ERROR_INVALID_PARAMETER;
+    }
+    else if(0u == (cyBleLnssCccd[charIndex] & CYBLE_CCCD_INDICATION))
+    {
+        result = CYBLE_ERROR_IND_DISABLED;
+    }
+    else
+    {
+        result = CyBleSim_Send(connHandle, CYBLE_SIM_LNS_HANDLE(charIndex), attrSize, attrValue, 1u);
+    }
+
+    return(result);
+}
+
+
+/*******************************************************************************
+* Function Name: Navigation_LED_Write
+********************************************************************************
+*
+* Summary:
+*   The pin of the Navigation LED, not simulated.
+*
+*******************************************************************************/
+void Navigation_LED_Write(uint8 value)
+{
+    (void)value;
+}
+
+
+/*******************************************************************************
+* Function Name: CyBleSim_LnssWriteCccd
+********************************************************************************
+*
+* Summary:
+*   Writes the CCCD of a characteristic as the client does and raises the
+*   event of the change.
+*
+* Parameters:
+*   charIndex - the characteristic.
+*   cccd - the value of the CCCD.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void CyBleSim_LnssWriteCccd(CYBLE_LNS_CHAR_INDEX_T charIndex, uint16 cccd)
+{
+    CYBLE_LNS_CHAR_VALUE_T param;
+    uint32 event;
+
+    cyBleLnssCccd[charIndex] = cccd;
+
+    if(CYBLE_LNS_CP == charIndex)
+    {
+        event = (0u != (cccd & CYBLE_CCCD_INDICATION)) ?
+            (uint32)CYBLE_EVT_LNSS_INDICATION_ENABLED : (uint32)CYBLE_EVT_LNSS_INDICATION_DISABLED;
+    }
+    else
+    {
+        event = (0u != (cccd & CYBLE_CCCD_NOTIFICATION)) ?
+            (uint32)CYBLE_EVT_LNSS_NOTIFICATION_ENABLED : (uint32)CYBLE_EVT_LNSS_NOTIFICATION_DISABLED;
+    }
+
+    if(NULL != cyBleLnsCallback)
+    {
+        param.connHandle = cyBle_connHandle;
+        param.charIndex = charIndex;
+        param.value = NULL;
+        cyBleLnsCallback(event, &param);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: CyBleSim_LnssWriteCp
+********************************************************************************
+*
+* Summary:
+*   Writes the LN Control Point as the client does.
+*
+* Parameters:
+*   length - the length of the value.
+*   value - the value.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void CyBleSim_LnssWriteCp(uint8 length, const uint8 value[])
+{
+    CYBLE_LNS_CHAR_VALUE_T param;
+    CYBLE_GATT_VALUE_T gattValue;
+    uint8 buf[CYBLE_SIM_MTU_MAX];
+
+    (void)memcpy(buf, value, length);
+    gattValue.val = buf;
+    gattValue.len = length;
+    gattValue.actualLen = length;
+
+    if(NULL != cyBleLnsCallback)
+    {
+        param.connHandle = cyBle_connHandle;
+        param.charIndex = CYBLE_LNS_CP;
+        param.value = &gattValue;
+        cyBleLnsCallback((uint32)CYBLE_EVT_LNSS_WRITE_CHAR, &param);
+    }
+}
+
+
+/* [] END OF FILE */
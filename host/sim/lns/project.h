@@ -0,0 +1,81 @@
+/*******************************************************************************
+* File Name: project.h
+*
+* Version 1.0
+*
+* Description:
+*  Host replacement of the project.h generated for BLE_Navigation: the
+*  simulated stack, the Location and Navigation Service server API and the
+*  pins the profile drives.
+*
+********************************************************************************
+* Copyright 2016, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(CY_PROJECT_H)
+#define CY_PROJECT_H
+
+#define CYBLE_GATT_MTU                      (23u)       /* MtuSize of TopDesign.cysch */
+
+#include "cyble_sim.h"
+
+
+/***************************************
+*        Constants
+***************************************/
+/* Attribute handle of the value of a characteristic in the simulation */
+#define CYBLE_SIM_LNS_HANDLE(charIndex)     ((uint16)(0x0020u + (uint16)(charIndex)))
+
+
+/***************************************
+*        Data Struct Definition
+***************************************/
+typedef enum
+{
+    CYBLE_LNS_FT,                           /* LN Feature */
+    CYBLE_LNS_LS,                           /* Location and Speed */
+    CYBLE_LNS_PQ,                           /* Position Quality */
+    CYBLE_LNS_CP,                           /* LN Control Point */
+    CYBLE_LNS_NV,                           /* Navigation */
+    CYBLE_LNS_CHAR_COUNT
+} CYBLE_LNS_CHAR_INDEX_T;
+
+typedef struct
+{
+    CYBLE_CONN_HANDLE_T connHandle;
+    CYBLE_LNS_CHAR_INDEX_T charIndex;
+    CYBLE_GATT_VALUE_T *value;
+} CYBLE_LNS_CHAR_VALUE_T;
+
+typedef enum
+{
+    CYBLE_EVT_LNSS_NOTIFICATION_ENABLED = 0x3100u,
+    CYBLE_EVT_LNSS_NOTIFICATION_DISABLED,
+    CYBLE_EVT_LNSS_INDICATION_ENABLED,
+    CYBLE_EVT_LNSS_INDICATION_DISABLED,
+    CYBLE_EVT_LNSS_INDICATION_CONFIRMED,
+    CYBLE_EVT_LNSS_WRITE_CHAR
+} CYBLE_LNS_EVT_T;
+
+
+/***************************************
+*      API Function Prototypes
+***************************************/
+void CyBle_LnsRegisterAttrCallback(CYBLE_CALLBACK_T callbackFunc);
+CYBLE_API_RESULT_T CyBle_LnssSendNotification(CYBLE_CONN_HANDLE_T connHandle, CYBLE_LNS_CHAR_INDEX_T charIndex,
+    uint8 attrSize, uint8 *attrValue);
+CYBLE_API_RESULT_T CyBle_LnssSendIndication(CYBLE_CONN_HANDLE_T connHandle, CYBLE_LNS_CHAR_INDEX_T charIndex,
+    uint8 attrSize, uint8 *attrValue);
+void Navigation_LED_Write(uint8 value);
+
+/* Client side of the simulation */
+void CyBleSim_LnssWriteCccd(CYBLE_LNS_CHAR_INDEX_T charIndex, uint16 cccd);
+void CyBleSim_LnssWriteCp(uint8 length, const uint8 value[]);
+
+
+#endif /* CY_PROJECT_H */
+
+/* [] END OF FILE */